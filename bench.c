@@ -0,0 +1,1044 @@
+#include "lib.c"
+
+// Benchmarks share one long-lived arena for their fixtures, which are created
+// lazily on the first run so that the setup is not measured.
+static PgArena bench_arena = {0};
+static PgArenaAllocator bench_arena_allocator = {0};
+static PgAllocator *bench_allocator = nullptr;
+
+[[nodiscard]] static PgString bench_make_text(u64 len, u8 special_every) {
+  PgString res = pg_string_make(len, bench_allocator);
+  PgString alphabet = PG_S("the quick brown fox jumps over the lazy dog ");
+  PgString specials = PG_S("<>&\"'\n");
+
+  for (u64 i = 0; i < res.len; i++) {
+    PG_SLICE_AT(res, i) =
+        (0 == (i + 1) % special_every)
+            ? PG_SLICE_AT(specials, (i / special_every) % specials.len)
+            : PG_SLICE_AT(alphabet, i % alphabet.len);
+  }
+  return res;
+}
+
+static void bench_escape_html(PgBenchState *state) {
+  static PgString text = {0};
+  if (pg_string_is_empty(text)) {
+    text = bench_make_text(4 * PG_KiB, 64);
+  }
+  state->bytes_per_iteration = text.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&bench_arena);
+    PgString out = pg_html_sanitize(text, pg_arena_temp_allocator(&temp));
+    pg_bench_do_not_optimize(out.data);
+    pg_arena_temp_end(temp);
+  }
+}
+
+static void bench_escape_js(PgBenchState *state) {
+  static PgString text = {0};
+  if (pg_string_is_empty(text)) {
+    text = bench_make_text(4 * PG_KiB, 64);
+  }
+  state->bytes_per_iteration = text.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&bench_arena);
+    Pgu8Dyn sb = {0};
+    pg_string_builder_append_js_string_escaped(&sb, text,
+                                               pg_arena_temp_allocator(&temp));
+    pg_bench_do_not_optimize(sb.data);
+    pg_arena_temp_end(temp);
+  }
+}
+
+static void bench_write_u64_as_string(PgBenchState *state) {
+  PgWriter w = pg_writer_make_string_builder(64, bench_allocator);
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    w.u.bytes.len = 0;
+    // Cover all digit counts.
+    u64 n = (i * 0x9e3779b97f4a7c15ULL) >> (i % 64);
+    PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, n, bench_allocator));
+    pg_bench_do_not_optimize(w.u.bytes.data);
+  }
+}
+
+static void bench_parse_u64_many(PgBenchState *state) {
+  static PgString text = {0};
+  if (pg_string_is_empty(text)) {
+    PgWriter w = pg_writer_make_string_builder(64 * PG_KiB, bench_allocator);
+    for (u64 i = 0; i < 4096; i++) {
+      u64 n = (i * 0x9e3779b97f4a7c15ULL) >> (i % 64);
+      PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, n, bench_allocator));
+      PG_ASSERT(0 == pg_writer_write_u8(&w, 0 == i % 8 ? '\n' : ' ',
+                                        bench_allocator));
+    }
+    text = PG_DYN_TO_SLICE(PgString, w.u.bytes);
+  }
+  state->bytes_per_iteration = text.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&bench_arena);
+    PG_DYN(u64) nums = {0};
+    PgString remaining = pg_string_parse_u64_many(
+        text, 10, PG_S(" \n"), &nums, pg_arena_temp_allocator(&temp));
+    PG_ASSERT(pg_string_is_empty(remaining));
+    pg_bench_do_not_optimize(nums.data);
+    pg_arena_temp_end(temp);
+  }
+}
+
+[[nodiscard]] static PgString bench_make_html() {
+  static PgString html = {0};
+  if (pg_string_is_empty(html)) {
+    Pgu8Dyn sb = {0};
+    for (u64 i = 0; i < 256; i++) {
+      PG_DYN_APPEND_SLICE(&sb,
+                          PG_S("<div class=\"entry\"><a href='/x?a=1&b=2'>"
+                               "the quick brown fox jumps over the lazy "
+                               "dog</a> <!-- note --><br/></div>\n"),
+                          bench_allocator);
+    }
+    html = PG_DYN_TO_SLICE(PgString, sb);
+  }
+  return html;
+}
+
+static void bench_html_tokenize(PgBenchState *state) {
+  PgString html = bench_make_html();
+  state->bytes_per_iteration = html.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgHtmlTokenizer tokenizer = pg_html_tokenizer_make_from_string(html);
+    for (;;) {
+      PG_RESULT(PgHtmlToken, PgError) res = pg_html_tokenizer_next(&tokenizer);
+      PgHtmlToken token = PG_UNWRAP(res);
+      if (PG_HTML_TOKEN_KIND_NONE == token.kind) {
+        break;
+      }
+      pg_bench_do_not_optimize(&token);
+    }
+  }
+}
+
+static void bench_html_decode_entities(PgBenchState *state) {
+  static PgString text = {0};
+  if (pg_string_is_empty(text)) {
+    Pgu8Dyn sb = {0};
+    for (u64 i = 0; i < 64; i++) {
+      PG_DYN_APPEND_SLICE(&sb,
+                          PG_S("the quick brown fox jumps over the lazy dog "
+                               "&amp; the caf&eacute; &#x2014; &lt;b&gt; "),
+                          bench_allocator);
+    }
+    text = PG_DYN_TO_SLICE(PgString, sb);
+  }
+  state->bytes_per_iteration = text.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&bench_arena);
+    PgString out =
+        pg_html_decode_entities(text, pg_arena_temp_allocator(&temp));
+    pg_bench_do_not_optimize(out.data);
+    pg_arena_temp_end(temp);
+  }
+}
+
+static void bench_html_parse(PgBenchState *state) {
+  PgString html = bench_make_html();
+  state->bytes_per_iteration = html.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&bench_arena);
+    PG_RESULT(PgHtmlNodePtr, PgError)
+    res = pg_html_parse(html, pg_arena_temp_allocator(&temp));
+    pg_bench_do_not_optimize(PG_UNWRAP(res));
+    pg_arena_temp_end(temp);
+  }
+}
+
+static void bench_html_dom_parse(PgBenchState *state) {
+  PgString html = bench_make_html();
+  state->bytes_per_iteration = html.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&bench_arena);
+    PG_RESULT(PgHtmlDom, PgError)
+    res = pg_html_dom_parse(html, pg_arena_temp_allocator(&temp));
+    pg_bench_do_not_optimize(PG_UNWRAP(res).nodes.data);
+    pg_arena_temp_end(temp);
+  }
+}
+
+[[nodiscard]] static PgString bench_url() {
+  return PG_S("https://example.com:8443/api/v2/users/42/posts/"
+              "caf%C3%A9?sort=desc&limit=20&q=the+quick%20fox&page=3#top");
+}
+
+static void bench_url_parse(PgBenchState *state) {
+  PgString url = bench_url();
+  state->bytes_per_iteration = url.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&bench_arena);
+    PG_RESULT(PgUrl, PgError)
+    res = pg_url_parse(url, pg_arena_temp_allocator(&temp));
+    pg_bench_do_not_optimize(PG_UNWRAP(res).query_parameters.data);
+    pg_arena_temp_end(temp);
+  }
+}
+
+static void bench_url_view_parse(PgBenchState *state) {
+  PgString url = bench_url();
+  state->bytes_per_iteration = url.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PG_RESULT(PgUrlView, PgError) res = pg_url_view_parse(url);
+    PgUrlView view = PG_UNWRAP(res);
+
+    PgUrlPathIterator path_it = pg_url_path_iterator_make(view.path);
+    for (;;) {
+      PG_OPTION(PgString) component = pg_url_path_iterator_next(&path_it);
+      if (!component.has_value) {
+        break;
+      }
+      pg_bench_do_not_optimize(component.value.data);
+    }
+
+    PgUrlQueryIterator query_it = pg_url_query_iterator_make(view.query);
+    for (;;) {
+      PG_OPTION(PgStringKeyValue) kv = pg_url_query_iterator_next(&query_it);
+      if (!kv.has_value) {
+        break;
+      }
+      pg_bench_do_not_optimize(kv.value.value.data);
+    }
+  }
+}
+
+static void bench_http_headers(PgBenchState *state) {
+  PgStringKeyValue lines[] = {
+      {PG_S("Host"), PG_S("example.com")},
+      {PG_S("User-Agent"), PG_S("curl/8.5.0")},
+      {PG_S("Accept"), PG_S("*/*")},
+      {PG_S("Accept-Encoding"), PG_S("gzip, br")},
+      {PG_S("Connection"), PG_S("keep-alive")},
+      {PG_S("X-Request-Id"), PG_S("f3a1c2")},
+      {PG_S("Content-Type"), PG_S("application/json")},
+      {PG_S("Content-Length"), PG_S("1234")},
+  };
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&bench_arena);
+    PgAllocator *allocator = pg_arena_temp_allocator(&temp);
+
+    PgHttpHeaders headers = {0};
+    for (u64 j = 0; j < PG_STATIC_ARRAY_LEN(lines); j++) {
+      pg_http_push_header(&headers, lines[j].key, lines[j].value, allocator);
+    }
+    PG_RESULT(u64, PgError) res = pg_http_content_length(&headers);
+    PG_ASSERT(1234 == PG_UNWRAP(res));
+
+    pg_bench_do_not_optimize(headers.entries.data);
+    pg_arena_temp_end(temp);
+  }
+}
+
+static void bench_http_chunked_read(PgBenchState *state) {
+  static PgString encoded = {0};
+  static u64 body_len = 0;
+  if (pg_string_is_empty(encoded)) {
+    PgString text = bench_make_text(4 * PG_KiB, 64);
+    PgWriter w = pg_writer_make_string_builder(80 * PG_KiB, bench_allocator);
+    PgWriter chunked = pg_http_chunked_writer_make(&w, 0, bench_allocator);
+    for (u64 i = 0; i < 16; i++) {
+      PG_ASSERT(0 == pg_writer_write_full(&chunked, text, bench_allocator));
+      body_len += text.len;
+    }
+    PG_ASSERT(0 == pg_http_chunked_writer_finish(&chunked, (PgHttpHeaders){0},
+                                                 bench_allocator));
+    encoded = PG_DYN_TO_SLICE(PgString, w.u.bytes);
+  }
+  state->bytes_per_iteration = encoded.len;
+
+  u8 buf[16 * PG_KiB] = {0};
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgReader inner = pg_reader_make_from_bytes(encoded);
+    PgReader body = pg_http_chunked_reader_make(&inner, nullptr, nullptr);
+    u64 total = 0;
+    for (;;) {
+      PG_RESULT(u64, PgError) res = pg_reader_read(&body, buf, sizeof(buf));
+      if (PG_IS_ERR(res)) {
+        break;
+      }
+      total += PG_UNWRAP(res);
+    }
+    PG_ASSERT(body_len == total);
+    pg_bench_do_not_optimize(buf);
+  }
+}
+
+typedef struct {
+  PgArena arena;
+  PgString corpus;
+  PgString compressed; // gzip, level 6.
+} BenchCompression;
+
+static BenchCompression bench_compression = {0};
+
+// Source code compresses about as well as typical web assets. The compressor
+// state alone does not fit in the shared arena.
+static void bench_compression_init() {
+  BenchCompression *c = &bench_compression;
+  c->arena = pg_arena_make_from_virtual_mem(4 * PG_MiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&c->arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PG_RESULT(PgString, PgError)
+  res_corpus = pg_file_read_full_from_path(PG_S("lib.c"), allocator);
+  c->corpus = PG_UNWRAP(res_corpus);
+  c->corpus.len = PG_MIN(c->corpus.len, 256 * PG_KiB);
+
+  PgWriter w = pg_writer_make_string_builder(c->corpus.len, allocator);
+  PgWriter deflate =
+      pg_deflate_writer_make(&w, PG_DEFLATE_FORMAT_GZIP, 6, allocator);
+  PG_ASSERT(0 == pg_writer_write_full(&deflate, c->corpus, allocator));
+  PG_ASSERT(0 == pg_deflate_writer_finish(&deflate, allocator));
+  c->compressed = PG_DYN_TO_SLICE(PgString, w.u.bytes);
+}
+
+static void bench_crc32(PgBenchState *state) {
+  PgString s = PG_SLICE_RANGE(bench_compression.corpus, 0, 64 * PG_KiB);
+  state->bytes_per_iteration = s.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    u32 crc = pg_crc32_update(0, s);
+    pg_bench_do_not_optimize(&crc);
+  }
+}
+
+static void bench_adler32(PgBenchState *state) {
+  PgString s = PG_SLICE_RANGE(bench_compression.corpus, 0, 64 * PG_KiB);
+  state->bytes_per_iteration = s.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    u32 adler = pg_adler32_update(1, s);
+    pg_bench_do_not_optimize(&adler);
+  }
+}
+
+// A whole response, including setting up the compressor.
+static void bench_deflate(PgBenchState *state, u8 level) {
+  BenchCompression *c = &bench_compression;
+  state->bytes_per_iteration = c->corpus.len;
+
+  u64 compressed_len = 0;
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&c->arena);
+    PgAllocator *allocator = pg_arena_allocator_as_allocator(&temp.allocator);
+
+    PgWriter w = pg_writer_make_string_builder(c->corpus.len, allocator);
+    PgWriter deflate =
+        pg_deflate_writer_make(&w, PG_DEFLATE_FORMAT_GZIP, level, allocator);
+    PG_ASSERT(0 == pg_writer_write_full(&deflate, c->corpus, allocator));
+    PG_ASSERT(0 == pg_deflate_writer_finish(&deflate, allocator));
+    compressed_len = w.u.bytes.len;
+
+    pg_arena_temp_end(temp);
+  }
+  state->ratio = (f64)c->corpus.len / (f64)compressed_len;
+}
+
+static void bench_deflate_level_1(PgBenchState *state) {
+  bench_deflate(state, 1);
+}
+
+static void bench_deflate_level_6(PgBenchState *state) {
+  bench_deflate(state, 6);
+}
+
+static void bench_deflate_level_9(PgBenchState *state) {
+  bench_deflate(state, 9);
+}
+
+// Throughput of the decompressed data.
+static void bench_inflate(PgBenchState *state) {
+  BenchCompression *c = &bench_compression;
+  state->bytes_per_iteration = c->corpus.len;
+
+  u8 buf[16 * PG_KiB] = {0};
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(&c->arena);
+    PgAllocator *allocator = pg_arena_allocator_as_allocator(&temp.allocator);
+
+    PgReader inner = pg_reader_make_from_bytes(c->compressed);
+    PgReader inflate =
+        pg_inflate_reader_make(&inner, PG_DEFLATE_FORMAT_GZIP, allocator);
+    u64 total = 0;
+    for (;;) {
+      PG_RESULT(u64, PgError) res = pg_reader_read(&inflate, buf, sizeof(buf));
+      if (PG_IS_ERR(res)) {
+        PG_ASSERT(PG_ERR_EOF == PG_UNWRAP_ERR(res));
+        break;
+      }
+      total += PG_UNWRAP(res);
+    }
+    PG_ASSERT(c->corpus.len == total);
+    pg_bench_do_not_optimize(buf);
+
+    pg_arena_temp_end(temp);
+  }
+}
+
+#ifdef PG_OS_UNIX
+static void bench_http_client_handler(PgHttpServerRequest req,
+                                      PgReader *reader, PgWriter *writer,
+                                      PgLogger *logger, PgAllocator *allocator,
+                                      void *ctx) {
+  (void)req;
+  (void)reader;
+  (void)logger;
+  (void)ctx;
+
+  PgHttpResponse res = {.version_major = 1, .version_minor = 1, .status = 200};
+  pg_http_push_header(&res.headers, PG_S("Content-Length"), PG_S("5"),
+                      allocator);
+  PG_ASSERT(0 == pg_http_write_response(writer, res, allocator));
+  PG_ASSERT(0 == pg_writer_write_full(writer, PG_S("hello"), allocator));
+  PG_ASSERT(0 == pg_writer_flush(writer, allocator));
+}
+
+// Serves one connection at a time, which is enough for one client.
+static i32 bench_http_client_server_fn(void *data) {
+  PgFileDescriptor listener = *(PgFileDescriptor *)data;
+  PgHttpServerOptions options = {
+      .handler = bench_http_client_handler,
+      .keep_alive_timeout_ms = 5000,
+  };
+  PgArena arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+
+  for (;;) {
+    PgIpv4AddressAcceptResult res_accept = pg_net_tcp_accept(listener);
+    PG_ASSERT(0 == res_accept.err);
+    PgArenaTemp temp = pg_arena_temp_begin(&arena);
+    (void)pg_http_server_handler(res_accept.socket, options, nullptr, &arena);
+    (void)pg_net_socket_close(res_accept.socket);
+    pg_arena_temp_end(temp);
+  }
+  return 0;
+}
+
+// Requests per second to a local server.
+static void bench_http_client(PgBenchState *state, u64 max_idle_per_host) {
+  static PgFileDescriptor listener = {0};
+  static u16 port = 0;
+  if (!port) {
+    PG_RESULT(PgFileDescriptor, PgError)
+    res_socket = pg_net_create_tcp_socket();
+    listener = PG_UNWRAP(res_socket);
+    PG_ASSERT(0 == pg_net_tcp_bind_ipv4(listener,
+                                        (PgIpv4Address){.ip = 0x7f000001}));
+    PG_ASSERT(0 == pg_net_tcp_listen(listener, 16));
+    PG_RESULT(PgIpv4Address, PgError)
+    res_address = pg_net_socket_local_address(listener);
+    port = PG_UNWRAP(res_address).port;
+
+    PG_RESULT(PgThread, PgError)
+    res_thread = pg_thread_create(bench_http_client_server_fn, &listener);
+    PG_ASSERT(PG_IS_OK(res_thread));
+  }
+
+  // The pool outlives each request.
+  PgArena client_arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+  PgArenaAllocator client_arena_allocator =
+      pg_make_arena_allocator(&client_arena);
+  PG_RESULT(PgHttpClient, PgError)
+  res_client = pg_http_client_make(
+      (PgHttpClientOptions){
+          .connect_timeout_ms = 1000,
+          .read_timeout_ms = 1000,
+          .idle_timeout_ms = 1000,
+          .max_idle_per_host = max_idle_per_host,
+          .max_body_len = 1024,
+      },
+      pg_arena_allocator_as_allocator(&client_arena_allocator));
+  PgHttpClient client = PG_UNWRAP(res_client);
+
+  PgHttpClientRequest req = {
+      .host = PG_S("127.0.0.1"),
+      .port = port,
+      .req = {.method = PG_HTTP_METHOD_GET},
+  };
+  for (u64 i = 0; i < state->iterations; i++) {
+    PgArenaTemp temp_req = pg_arena_temp_begin(&bench_arena);
+    PgHttpClientResponse res = pg_http_client_do(&client, req, bench_allocator);
+    PG_ASSERT(0 == res.err);
+    PG_ASSERT(200 == res.res.status);
+    pg_bench_do_not_optimize(res.body.data);
+    pg_arena_temp_end(temp_req);
+  }
+
+  pg_http_client_close(&client);
+  PG_ASSERT(0 == pg_arena_release(&client_arena));
+}
+
+#define BENCH_UDP_PAYLOAD_LEN 64
+
+typedef struct {
+  PgFileDescriptor sender, receiver;
+  PgIpAddress receiver_address;
+  PG_PAD(4);
+} BenchUdp;
+
+// Over loopback, with all datagrams of a batch in flight at once.
+static BenchUdp bench_udp() {
+  static BenchUdp res = {0};
+  if (res.sender.fd) {
+    return res;
+  }
+
+  PgIpAddress loopback = {.ipv4 = 0x7f000001, .family = PG_IP_FAMILY_V4};
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_socket = pg_net_create_udp_socket_ip(PG_IP_FAMILY_V4);
+  res.sender = PG_UNWRAP(res_socket);
+  res_socket = pg_net_create_udp_socket_ip(PG_IP_FAMILY_V4);
+  res.receiver = PG_UNWRAP(res_socket);
+  PG_ASSERT(0 == pg_net_udp_bind_ip(res.receiver, loopback));
+
+  PG_RESULT(PgIpAddress, PgError)
+  res_address = pg_net_socket_local_address_ip(res.receiver);
+  res.receiver_address = PG_UNWRAP(res_address);
+  return res;
+}
+
+// One datagram per syscall.
+static void bench_udp_send_recv(PgBenchState *state) {
+  BenchUdp udp = bench_udp();
+  PgIpv4Address address = {
+      .ip = udp.receiver_address.ipv4,
+      .port = udp.receiver_address.port,
+  };
+  u8 payload_data[BENCH_UDP_PAYLOAD_LEN] = {0};
+  PgString payload = PG_SLICE_FROM_C(payload_data);
+  u8 buf_data[BENCH_UDP_PAYLOAD_LEN] = {0};
+  PgString buf = PG_SLICE_FROM_C(buf_data);
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PG_RESULT(u64, PgError)
+    res_send = pg_net_udp_send_to(udp.sender, payload, address);
+    PG_ASSERT(payload.len == PG_UNWRAP(res_send));
+
+    PgIpv4AddressRecvResult res_recv = pg_net_udp_recv_from(udp.receiver, buf);
+    PG_ASSERT(0 == res_recv.err);
+    pg_bench_do_not_optimize(buf.data);
+  }
+  state->items_per_iteration = 1;
+}
+
+// Up to `PG_NET_UDP_BATCH_MAX` datagrams per syscall. One iteration is one
+// datagram.
+static void bench_udp_send_recv_batch(PgBenchState *state) {
+  BenchUdp udp = bench_udp();
+  u8 payload_data[BENCH_UDP_PAYLOAD_LEN] = {0};
+  PgString payload = PG_SLICE_FROM_C(payload_data);
+  static u8 bufs[PG_NET_UDP_BATCH_MAX][BENCH_UDP_PAYLOAD_LEN];
+
+  PgUdpDatagram sent_data[PG_NET_UDP_BATCH_MAX] = {0};
+  PgUdpDatagram received_data[PG_NET_UDP_BATCH_MAX] = {0};
+  for (u64 i = 0; i < PG_NET_UDP_BATCH_MAX; i++) {
+    sent_data[i] = (PgUdpDatagram){
+        .data = payload,
+        .address = udp.receiver_address,
+    };
+  }
+
+  for (u64 done = 0; done < state->iterations;) {
+    u64 batch_len = PG_MIN(state->iterations - done, PG_NET_UDP_BATCH_MAX);
+    PG_SLICE(PgUdpDatagram) sent = {.data = sent_data, .len = batch_len};
+    PG_RESULT(u64, PgError) res_send = pg_net_udp_send_batch(udp.sender, sent);
+    PG_ASSERT(batch_len == PG_UNWRAP(res_send));
+
+    for (u64 received = 0; received < batch_len;) {
+      for (u64 i = 0; i < batch_len - received; i++) {
+        received_data[i].data = (PgString){bufs[i], sizeof(bufs[i])};
+      }
+      PG_SLICE(PgUdpDatagram)
+      datagrams = {.data = received_data, .len = batch_len - received};
+      PG_RESULT(u64, PgError)
+      res_recv = pg_net_udp_recv_batch(udp.receiver, datagrams);
+      received += PG_UNWRAP(res_recv);
+    }
+    pg_bench_do_not_optimize(bufs);
+    done += batch_len;
+  }
+  state->items_per_iteration = 1;
+}
+
+#ifdef PG_OS_LINUX
+// One syscall and one trip through the stack for a whole batch, segmented
+// into datagrams by the kernel on the way out. One iteration is one datagram.
+static void bench_udp_send_gso_recv_batch(PgBenchState *state) {
+  BenchUdp udp = bench_udp();
+  static u8 payload_data[PG_NET_UDP_BATCH_MAX * BENCH_UDP_PAYLOAD_LEN];
+  static u8 bufs[PG_NET_UDP_BATCH_MAX][BENCH_UDP_PAYLOAD_LEN];
+  PgUdpDatagram received_data[PG_NET_UDP_BATCH_MAX] = {0};
+
+  for (u64 done = 0; done < state->iterations;) {
+    u64 batch_len = PG_MIN(state->iterations - done, PG_NET_UDP_BATCH_MAX);
+    PgUdpDatagram sent_data[] = {{
+        .data = {payload_data, batch_len * BENCH_UDP_PAYLOAD_LEN},
+        .address = udp.receiver_address,
+        .segment_len = BENCH_UDP_PAYLOAD_LEN,
+    }};
+    PG_SLICE(PgUdpDatagram) sent = PG_SLICE_FROM_C(sent_data);
+    PG_RESULT(u64, PgError) res_send = pg_net_udp_send_batch(udp.sender, sent);
+    PG_ASSERT(1 == PG_UNWRAP(res_send));
+
+    for (u64 received = 0; received < batch_len;) {
+      for (u64 i = 0; i < batch_len - received; i++) {
+        received_data[i].data = (PgString){bufs[i], sizeof(bufs[i])};
+      }
+      PG_SLICE(PgUdpDatagram)
+      datagrams = {.data = received_data, .len = batch_len - received};
+      PG_RESULT(u64, PgError)
+      res_recv = pg_net_udp_recv_batch(udp.receiver, datagrams);
+      received += PG_UNWRAP(res_recv);
+    }
+    pg_bench_do_not_optimize(bufs);
+    done += batch_len;
+  }
+  state->items_per_iteration = 1;
+}
+#endif
+
+static void bench_http_client_pooled(PgBenchState *state) {
+  bench_http_client(state, 1);
+}
+
+static void bench_http_client_unpooled(PgBenchState *state) {
+  bench_http_client(state, 0);
+}
+#endif
+
+#define BENCH_TIMERS_LEN (1'000'000)
+#define BENCH_TIMERS_SPREAD_MS (60'000)
+
+typedef struct {
+  PgTimerWheel *wheel;
+  PgTimer *timers;
+  PgRng rng;
+  u64 now_ns;
+} BenchTimers;
+
+static BenchTimers bench_timers = {0};
+
+// 1M armed timers spread over a minute, as for the idle deadlines of as many
+// connections. Too big for the shared arena, and built up front in `main`
+// since filling it takes longer than a whole sample.
+static void bench_timers_init() {
+  static PgArena arena = {0};
+  static PgArenaAllocator arena_allocator = {0};
+  arena = pg_arena_make_from_virtual_mem(
+      BENCH_TIMERS_LEN * sizeof(PgTimer) + 1 * PG_MiB);
+  arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  bench_timers.rng = pg_rand_make();
+  bench_timers.now_ns = 1000 * PG_Seconds;
+  bench_timers.wheel =
+      pg_timer_wheel_make(PG_Milliseconds, bench_timers.now_ns, allocator);
+  bench_timers.timers = pg_alloc(allocator, sizeof(PgTimer),
+                                 _Alignof(PgTimer), BENCH_TIMERS_LEN);
+  for (u64 i = 0; i < BENCH_TIMERS_LEN; i++) {
+    u64 delay_ms = pg_rand_u32_min_incl_max_incl(&bench_timers.rng, 1,
+                                                 BENCH_TIMERS_SPREAD_MS);
+    pg_timer_wheel_insert(bench_timers.wheel, &bench_timers.timers[i],
+                          bench_timers.now_ns + delay_ms * PG_Milliseconds, i);
+  }
+}
+
+// Push back a deadline, e.g. on activity on the connection.
+static void bench_timer_wheel_rearm(PgBenchState *state) {
+  BenchTimers *timers = &bench_timers;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    u64 idx = pg_rand_u32_min_incl_max_incl(&timers->rng, 0,
+                                            BENCH_TIMERS_LEN - 1);
+    u64 delay_ms = pg_rand_u32_min_incl_max_incl(&timers->rng, 1,
+                                                 BENCH_TIMERS_SPREAD_MS);
+    pg_timer_wheel_insert(timers->wheel, &timers->timers[idx],
+                          timers->now_ns + delay_ms * PG_Milliseconds, idx);
+  }
+  PG_ASSERT(BENCH_TIMERS_LEN == timers->wheel->count);
+}
+
+// One millisecond of the clock per iteration, re-arming the expired timers
+// so that 1M stay active.
+static void bench_timer_wheel_expire(PgBenchState *state) {
+  BenchTimers *timers = &bench_timers;
+
+  PgAioEvent events_data[256] = {0};
+  PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+  for (u64 i = 0; i < state->iterations; i++) {
+    timers->now_ns += PG_Milliseconds;
+
+    u64 count = 0;
+    do {
+      count = pg_timer_wheel_expire(timers->wheel, timers->now_ns, events);
+      for (u64 j = 0; j < count; j++) {
+        u64 idx = PG_SLICE_AT(events, j).user_data;
+        u64 delay_ms = pg_rand_u32_min_incl_max_incl(&timers->rng, 1,
+                                                     BENCH_TIMERS_SPREAD_MS);
+        pg_timer_wheel_insert(timers->wheel, &timers->timers[idx],
+                              timers->now_ns + delay_ms * PG_Milliseconds,
+                              idx);
+      }
+    } while (count == events.len);
+  }
+  PG_ASSERT(BENCH_TIMERS_LEN == timers->wheel->count);
+}
+
+// 1024 clients over 4096 slots, each under its limit most of the time.
+static void bench_rate_limiter_allow(PgBenchState *state) {
+  static PgRateLimiter limiter = {0};
+  static PgRng rng = {0};
+  static u64 now_ns = PG_Seconds;
+  if (!limiter.slots) {
+    limiter = pg_rate_limiter_make(100, 10, 4096, bench_allocator);
+    rng = pg_rand_make();
+  }
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    now_ns += PG_Microseconds;
+    u64 key = pg_rand_u32_min_incl_max_incl(&rng, 0, 1023);
+    bool allowed = pg_rate_limiter_allow(&limiter, key, now_ns);
+    pg_bench_do_not_optimize(&allowed);
+  }
+}
+
+static void bench_spsc_ring(PgBenchState *state) {
+  static PgSpscRing rg = {0};
+  if (!rg.data.data) {
+    rg = pg_spsc_ring_make(4 * PG_KiB, bench_allocator);
+  }
+
+  u8 buf[64] = {0};
+  PG_SLICE(u8) slice = {.data = buf, .len = PG_STATIC_ARRAY_LEN(buf)};
+  state->bytes_per_iteration = slice.len;
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PG_ASSERT(pg_spsc_ring_write_full(&rg, slice));
+    PG_ASSERT(pg_spsc_ring_read_full(&rg, slice));
+  }
+  pg_bench_do_not_optimize(buf);
+}
+
+static void bench_mpmc_queue(PgBenchState *state) {
+  static PgMpmcQueue queue = {0};
+  if (!queue.cells) {
+    queue = PG_MPMC_QUEUE_MAKE(u64, 1024, bench_allocator);
+  }
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    u64 elem = i;
+    PG_ASSERT(pg_mpmc_queue_try_enqueue(&queue, &elem));
+    PG_ASSERT(pg_mpmc_queue_try_dequeue(&queue, &elem));
+    pg_bench_do_not_optimize(&elem);
+  }
+}
+
+static void bench_mpmc_queue_batch_8(PgBenchState *state) {
+  static PgMpmcQueue queue = {0};
+  if (!queue.cells) {
+    queue = PG_MPMC_QUEUE_MAKE(u64, 1024, bench_allocator);
+  }
+
+  u64 elems[8] = {0};
+  for (u64 i = 0; i < state->iterations; i++) {
+    PG_ASSERT(8 == pg_mpmc_queue_enqueue_batch(&queue, elems, 8));
+    PG_ASSERT(8 == pg_mpmc_queue_dequeue_batch(&queue, elems, 8));
+    pg_bench_do_not_optimize(elems);
+  }
+}
+
+#ifdef PG_OS_UNIX
+#define BENCH_THREADS_MAX 16
+
+// Fixture of the contention benchmarks. The threads are created anew for each
+// sample, which costs a few tens of microseconds out of the milliseconds of a
+// sample.
+typedef struct {
+  u64 iterations;
+  u64 threads_len;
+  _Atomic u64 threads_started;
+  void *data;
+} BenchThreads;
+
+// Wait for all the threads to be started so that they contend from the first
+// iteration. Returns the index of the calling thread.
+[[nodiscard]] static u64 bench_threads_start(BenchThreads *threads) {
+  u64 idx = atomic_fetch_add(&threads->threads_started, 1);
+  while (atomic_load(&threads->threads_started) < threads->threads_len) {
+    pg_thread_yield();
+  }
+  return idx;
+}
+
+// Split `iterations` as evenly as possible into `len` shares.
+[[nodiscard]] static u64 bench_threads_share(u64 iterations, u64 len,
+                                             u64 idx) {
+  return iterations / len + (idx < iterations % len ? 1 : 0);
+}
+
+static void bench_threads_run(PgBenchState *state, u64 threads_len,
+                              PgThreadFn fn, void *data) {
+  PG_ASSERT(threads_len <= BENCH_THREADS_MAX);
+
+  BenchThreads threads = {
+      .iterations = state->iterations,
+      .threads_len = threads_len,
+      .data = data,
+  };
+  PgThread ids[BENCH_THREADS_MAX] = {0};
+  for (u64 i = 0; i < threads_len; i++) {
+    PG_RESULT(PgThread, PgError) res_thread = pg_thread_create(fn, &threads);
+    ids[i] = PG_UNWRAP(res_thread);
+  }
+  for (u64 i = 0; i < threads_len; i++) {
+    PG_ASSERT(0 == pg_thread_join(ids[i]));
+  }
+}
+
+// Thread 0 produces all the records, thread 1 consumes them.
+static i32 bench_spsc_ring_threads_fn(void *data) {
+  BenchThreads *threads = data;
+  PgSpscRing *rg = threads->data;
+  u64 idx = bench_threads_start(threads);
+
+  u8 buf[64] = {0};
+  PG_SLICE(u8) slice = {.data = buf, .len = PG_STATIC_ARRAY_LEN(buf)};
+  for (u64 i = 0; i < threads->iterations; i++) {
+    while (!(0 == idx ? pg_spsc_ring_write_full(rg, slice)
+                      : pg_spsc_ring_read_full(rg, slice))) {
+      pg_thread_yield();
+    }
+  }
+  pg_bench_do_not_optimize(buf);
+  return 0;
+}
+
+// One iteration is one 64 bytes record handed over to the other thread.
+static void bench_spsc_ring_threads_2(PgBenchState *state) {
+  static PgSpscRing rg = {0};
+  if (!rg.data.data) {
+    rg = pg_spsc_ring_make(4 * PG_KiB, bench_allocator);
+  }
+  state->bytes_per_iteration = 64;
+
+  bench_threads_run(state, 2, bench_spsc_ring_threads_fn, &rg);
+}
+
+// Even threads produce, odd threads consume: each pair moves an equal share of
+// the elements through the queue.
+static i32 bench_mpmc_queue_threads_fn(void *data) {
+  BenchThreads *threads = data;
+  PgMpmcQueue *queue = threads->data;
+  u64 idx = bench_threads_start(threads);
+  u64 count = bench_threads_share(threads->iterations,
+                                  threads->threads_len / 2, idx / 2);
+
+  for (u64 i = 0; i < count; i++) {
+    u64 elem = i;
+    while (!(0 == idx % 2 ? pg_mpmc_queue_try_enqueue(queue, &elem)
+                          : pg_mpmc_queue_try_dequeue(queue, &elem))) {
+      pg_thread_yield();
+    }
+    pg_bench_do_not_optimize(&elem);
+  }
+  return 0;
+}
+
+// One iteration is one element handed over to another thread.
+static void bench_mpmc_queue_threads(PgBenchState *state, u64 threads_len) {
+  static PgMpmcQueue queue = {0};
+  if (!queue.cells) {
+    queue = PG_MPMC_QUEUE_MAKE(u64, 1024, bench_allocator);
+  }
+  state->items_per_iteration = 1;
+
+  bench_threads_run(state, threads_len, bench_mpmc_queue_threads_fn, &queue);
+}
+
+static void bench_mpmc_queue_threads_2(PgBenchState *state) {
+  bench_mpmc_queue_threads(state, 2);
+}
+
+static void bench_mpmc_queue_threads_4(PgBenchState *state) {
+  bench_mpmc_queue_threads(state, 4);
+}
+
+static void bench_mpmc_queue_threads_8(PgBenchState *state) {
+  bench_mpmc_queue_threads(state, 8);
+}
+#endif
+
+static void bench_mutex(PgBenchState *state) {
+  static PgMutex mtx = {0};
+  static bool init = false;
+  if (!init) {
+    PG_ASSERT(0 == pg_mtx_init(&mtx, PG_MUTEX_KIND_PLAIN));
+    init = true;
+  }
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    PG_ASSERT(0 == pg_mtx_lock(&mtx));
+    PG_ASSERT(0 == pg_mtx_unlock(&mtx));
+  }
+}
+
+#ifdef PG_OS_LINUX
+static void bench_futex_mutex(PgBenchState *state) {
+  static PgFutexMutex mtx = {0};
+
+  for (u64 i = 0; i < state->iterations; i++) {
+    pg_futex_mtx_lock(&mtx);
+    pg_futex_mtx_unlock(&mtx);
+  }
+}
+#endif
+
+#ifdef PG_OS_UNIX
+// A shared counter as the critical section.
+typedef struct {
+  pthread_mutex_t pthread_mtx;
+#ifdef PG_OS_LINUX
+  PgFutexMutex futex_mtx;
+  PG_PAD(4);
+#endif
+  u64 counter;
+} BenchMutexes;
+
+static BenchMutexes bench_mutexes = {
+    .pthread_mtx = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static i32 bench_pthread_mutex_threads_fn(void *data) {
+  BenchThreads *threads = data;
+  BenchMutexes *mutexes = threads->data;
+  u64 idx = bench_threads_start(threads);
+  u64 count =
+      bench_threads_share(threads->iterations, threads->threads_len, idx);
+
+  for (u64 i = 0; i < count; i++) {
+    PG_ASSERT(0 == pthread_mutex_lock(&mutexes->pthread_mtx));
+    mutexes->counter += 1;
+    PG_ASSERT(0 == pthread_mutex_unlock(&mutexes->pthread_mtx));
+  }
+  return 0;
+}
+
+static void bench_pthread_mutex_threads_2(PgBenchState *state) {
+  bench_threads_run(state, 2, bench_pthread_mutex_threads_fn, &bench_mutexes);
+}
+
+static void bench_pthread_mutex_threads_4(PgBenchState *state) {
+  bench_threads_run(state, 4, bench_pthread_mutex_threads_fn, &bench_mutexes);
+}
+
+static void bench_pthread_mutex_threads_8(PgBenchState *state) {
+  bench_threads_run(state, 8, bench_pthread_mutex_threads_fn, &bench_mutexes);
+}
+#endif
+
+#ifdef PG_OS_LINUX
+static i32 bench_futex_mutex_threads_fn(void *data) {
+  BenchThreads *threads = data;
+  BenchMutexes *mutexes = threads->data;
+  u64 idx = bench_threads_start(threads);
+  u64 count =
+      bench_threads_share(threads->iterations, threads->threads_len, idx);
+
+  for (u64 i = 0; i < count; i++) {
+    pg_futex_mtx_lock(&mutexes->futex_mtx);
+    mutexes->counter += 1;
+    pg_futex_mtx_unlock(&mutexes->futex_mtx);
+  }
+  return 0;
+}
+
+static void bench_futex_mutex_threads_2(PgBenchState *state) {
+  bench_threads_run(state, 2, bench_futex_mutex_threads_fn, &bench_mutexes);
+}
+
+static void bench_futex_mutex_threads_4(PgBenchState *state) {
+  bench_threads_run(state, 4, bench_futex_mutex_threads_fn, &bench_mutexes);
+}
+
+static void bench_futex_mutex_threads_8(PgBenchState *state) {
+  bench_threads_run(state, 8, bench_futex_mutex_threads_fn, &bench_mutexes);
+}
+#endif
+
+int main(int argc, char *argv[]) {
+  bench_arena = pg_arena_make_from_virtual_mem(1 * PG_MiB);
+  bench_arena_allocator = pg_make_arena_allocator(&bench_arena);
+  bench_allocator = pg_arena_allocator_as_allocator(&bench_arena_allocator);
+  bench_timers_init();
+  bench_compression_init();
+
+  PgBench benches[] = {
+      PG_BENCH(bench_escape_html),
+      PG_BENCH(bench_escape_js),
+      PG_BENCH(bench_write_u64_as_string),
+      PG_BENCH(bench_parse_u64_many),
+      PG_BENCH(bench_html_tokenize),
+      PG_BENCH(bench_html_decode_entities),
+      PG_BENCH(bench_html_parse),
+      PG_BENCH(bench_html_dom_parse),
+      PG_BENCH(bench_url_parse),
+      PG_BENCH(bench_url_view_parse),
+      PG_BENCH(bench_http_headers),
+      PG_BENCH(bench_http_chunked_read),
+      PG_BENCH(bench_crc32),
+      PG_BENCH(bench_adler32),
+      PG_BENCH(bench_deflate_level_1),
+      PG_BENCH(bench_deflate_level_6),
+      PG_BENCH(bench_deflate_level_9),
+      PG_BENCH(bench_inflate),
+#ifdef PG_OS_UNIX
+      PG_BENCH(bench_http_client_pooled),
+      PG_BENCH(bench_http_client_unpooled),
+      PG_BENCH(bench_udp_send_recv),
+      PG_BENCH(bench_udp_send_recv_batch),
+#endif
+#ifdef PG_OS_LINUX
+      PG_BENCH(bench_udp_send_gso_recv_batch),
+#endif
+      PG_BENCH(bench_timer_wheel_rearm),
+      PG_BENCH(bench_timer_wheel_expire),
+      PG_BENCH(bench_rate_limiter_allow),
+      PG_BENCH(bench_spsc_ring),
+      PG_BENCH(bench_mpmc_queue),
+      PG_BENCH(bench_mpmc_queue_batch_8),
+#ifdef PG_OS_UNIX
+      PG_BENCH(bench_spsc_ring_threads_2),
+      PG_BENCH(bench_mpmc_queue_threads_2),
+      PG_BENCH(bench_mpmc_queue_threads_4),
+      PG_BENCH(bench_mpmc_queue_threads_8),
+#endif
+      PG_BENCH(bench_mutex),
+#ifdef PG_OS_UNIX
+      PG_BENCH(bench_pthread_mutex_threads_2),
+      PG_BENCH(bench_pthread_mutex_threads_4),
+      PG_BENCH(bench_pthread_mutex_threads_8),
+#endif
+#ifdef PG_OS_LINUX
+      PG_BENCH(bench_futex_mutex),
+      PG_BENCH(bench_futex_mutex_threads_2),
+      PG_BENCH(bench_futex_mutex_threads_4),
+      PG_BENCH(bench_futex_mutex_threads_8),
+#endif
+  };
+  pg_run_benches(argc, argv, (PG_SLICE(PgBench))PG_SLICE_FROM_C(benches));
+}
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+# Generate `html_entities.c`: the HTML5 named character references and a
+# two-level perfect hash over their names, looked up by `pg_html_entity_find`.
+# Usage: ./gen_html_entities.py > html_entities.c
+
+from html.entities import html5
+
+SLOTS_LEN = 4096
+BUCKETS_LEN = 1024
+
+
+def fnv(name: bytes, seed: int) -> int:
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for b in name:
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def main():
+    names = sorted(k.encode() for k in html5)
+
+    buckets = [[] for _ in range(BUCKETS_LEN)]
+    for i, name in enumerate(names):
+        buckets[fnv(name, 0) % BUCKETS_LEN].append(i)
+
+    seeds = [0] * BUCKETS_LEN
+    slots = [0] * SLOTS_LEN
+    for b in sorted(range(BUCKETS_LEN), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            break
+        for seed in range(1, 1 << 16):
+            wanted = {fnv(names[i], seed) % SLOTS_LEN for i in buckets[b]}
+            if len(wanted) == len(buckets[b]) and all(
+                0 == slots[s] for s in wanted
+            ):
+                break
+        else:
+            raise SystemExit(f"no seed for bucket {b}")
+        seeds[b] = seed
+        for i in buckets[b]:
+            slots[fnv(names[i], seed) % SLOTS_LEN] = i + 1
+
+    print("// Code generated by gen_html_entities.py. DO NOT EDIT.")
+    print()
+    print(f"#define PG_HTML_ENTITIES_LEN {len(names)}")
+    print(f"#define PG_HTML_ENTITY_BUCKETS_LEN {BUCKETS_LEN}")
+    print(f"#define PG_HTML_ENTITY_SLOTS_LEN {SLOTS_LEN}")
+    print()
+
+    print("static const char pg_html_entity_names[] =")
+    line = ""
+    for name in names:
+        if len(line) + len(name) > 72:
+            print(f'    "{line}"')
+            line = ""
+        line += name.decode()
+    print(f'    "{line}";')
+    print()
+
+    print("static const PgHtmlEntity pg_html_entities[PG_HTML_ENTITIES_LEN] = {")
+    offset = 0
+    for name in names:
+        value = html5[name.decode()].encode()
+        value_c = ", ".join(f"0x{b:02x}" for b in value)
+        print(f"    {{{offset}, {len(name)}, {len(value)}, {{{value_c}}}}},")
+        offset += len(name)
+    print("};")
+    print()
+
+    def print_u16_table(c_name, c_len, values):
+        print(f"static const u16 {c_name}[{c_len}] = {{")
+        for i in range(0, len(values), 12):
+            print("    " + ", ".join(str(v) for v in values[i : i + 12]) + ",")
+        print("};")
+        print()
+
+    print_u16_table("pg_html_entity_seeds", "PG_HTML_ENTITY_BUCKETS_LEN", seeds)
+    print_u16_table("pg_html_entity_slots", "PG_HTML_ENTITY_SLOTS_LEN", slots)
+
+
+main()
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+# Generate `http_headers.c`: the ids of the well-known HTTP header names, their
+# canonical spelling and a perfect hash over their lowercased names, looked up
+# by `pg_http_header_id`.
+# Usage: ./gen_http_headers.py > http_headers.c
+
+NAMES = [
+    "Accept",
+    "Accept-Charset",
+    "Accept-Encoding",
+    "Accept-Language",
+    "Accept-Ranges",
+    "Access-Control-Allow-Credentials",
+    "Access-Control-Allow-Headers",
+    "Access-Control-Allow-Methods",
+    "Access-Control-Allow-Origin",
+    "Access-Control-Expose-Headers",
+    "Access-Control-Max-Age",
+    "Access-Control-Request-Headers",
+    "Access-Control-Request-Method",
+    "Age",
+    "Allow",
+    "Authorization",
+    "Cache-Control",
+    "Connection",
+    "Content-Disposition",
+    "Content-Encoding",
+    "Content-Language",
+    "Content-Length",
+    "Content-Location",
+    "Content-Range",
+    "Content-Security-Policy",
+    "Content-Type",
+    "Cookie",
+    "Date",
+    "ETag",
+    "Expect",
+    "Expires",
+    "Forwarded",
+    "From",
+    "Host",
+    "If-Match",
+    "If-Modified-Since",
+    "If-None-Match",
+    "If-Range",
+    "If-Unmodified-Since",
+    "Keep-Alive",
+    "Last-Modified",
+    "Link",
+    "Location",
+    "Max-Forwards",
+    "Origin",
+    "Pragma",
+    "Proxy-Authenticate",
+    "Proxy-Authorization",
+    "Range",
+    "Referer",
+    "Retry-After",
+    "Server",
+    "Set-Cookie",
+    "Strict-Transport-Security",
+    "TE",
+    "Trailer",
+    "Transfer-Encoding",
+    "Upgrade",
+    "User-Agent",
+    "Vary",
+    "Via",
+    "WWW-Authenticate",
+    "X-Content-Type-Options",
+    "X-Forwarded-For",
+    "X-Forwarded-Proto",
+    "X-Frame-Options",
+    "X-Requested-With",
+]
+
+SLOTS_LEN = 512
+
+
+# FNV-1a over the bytes with the ASCII case bit set, which lowercases letters
+# and leaves digits and `-` alone.
+def fnv(name: bytes, seed: int) -> int:
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for b in name:
+        h ^= b | 0x20
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def enum_name(name: str) -> str:
+    return "PG_HTTP_HEADER_ID_" + name.upper().replace("-", "_")
+
+
+def main():
+    names = [n.encode() for n in NAMES]
+    assert len(names) < SLOTS_LEN
+
+    for seed in range(1, 1 << 20):
+        slots = {fnv(name, seed) % SLOTS_LEN for name in names}
+        if len(slots) == len(names):
+            break
+    else:
+        raise SystemExit("no seed")
+
+    print("// Code generated by gen_http_headers.py. DO NOT EDIT.")
+    print()
+    print("typedef enum : u8 {")
+    print("  PG_HTTP_HEADER_ID_NONE, // Not a well-known header.")
+    for name in NAMES:
+        print(f"  {enum_name(name)},")
+    print("  PG_HTTP_HEADER_ID_COUNT,")
+    print("} PgHttpHeaderId;")
+    print()
+    print(f"#define PG_HTTP_HEADER_SEED {seed}U")
+    print(f"#define PG_HTTP_HEADER_SLOTS_LEN {SLOTS_LEN}")
+    print()
+
+    # The `: ` separator follows the name so that a header line starts with a
+    # single write.
+    print("static const char pg_http_header_prefixes[] =")
+    offset = 0
+    offsets = []
+    line = ""
+    for name in NAMES:
+        chunk = name + ": "
+        if len(line) + len(chunk) > 70:
+            print(f'    "{line}"')
+            line = ""
+        line += chunk
+        offsets.append(offset)
+        offset += len(chunk)
+    print(f'    "{line}";')
+    print()
+
+    print(
+        "static const PgString pg_http_header_names[PG_HTTP_HEADER_ID_COUNT] = {"
+    )
+    for name, offset in zip(NAMES, offsets):
+        print(
+            f"    [{enum_name(name)}] = "
+            f"{{(u8 *)pg_http_header_prefixes + {offset}, {len(name)}}},"
+        )
+    print("};")
+    print()
+
+    slots = [0] * SLOTS_LEN
+    for i, name in enumerate(names):
+        slots[fnv(name, seed) % SLOTS_LEN] = i + 1
+
+    print("static const u8 pg_http_header_slots[PG_HTTP_HEADER_SLOTS_LEN] = {")
+    for i in range(0, SLOTS_LEN, 16):
+        print("    " + ", ".join(str(v) for v in slots[i : i + 16]) + ",")
+    print("};")
+
+
+main()
@@ -0,0 +1,2923 @@
+// Code generated by gen_html_entities.py. DO NOT EDIT.
+
+#define PG_HTML_ENTITIES_LEN 2231
+#define PG_HTML_ENTITY_BUCKETS_LEN 1024
+#define PG_HTML_ENTITY_SLOTS_LEN 4096
+
+static const char pg_html_entity_names[] =
+    "AEligAElig;AMPAMP;AacuteAacute;Abreve;AcircAcirc;Acy;Afr;AgraveAgrave;"
+    "Alpha;Amacr;And;Aogon;Aopf;ApplyFunction;AringAring;Ascr;Assign;Atilde"
+    "Atilde;AumlAuml;Backslash;Barv;Barwed;Bcy;Because;Bernoullis;Beta;Bfr;"
+    "Bopf;Breve;Bscr;Bumpeq;CHcy;COPYCOPY;Cacute;Cap;CapitalDifferentialD;"
+    "Cayleys;Ccaron;CcedilCcedil;Ccirc;Cconint;Cdot;Cedilla;CenterDot;Cfr;"
+    "Chi;CircleDot;CircleMinus;CirclePlus;CircleTimes;"
+    "ClockwiseContourIntegral;CloseCurlyDoubleQuote;CloseCurlyQuote;Colon;"
+    "Colone;Congruent;Conint;ContourIntegral;Copf;Coproduct;"
+    "CounterClockwiseContourIntegral;Cross;Cscr;Cup;CupCap;DD;DDotrahd;DJcy;"
+    "DScy;DZcy;Dagger;Darr;Dashv;Dcaron;Dcy;Del;Delta;Dfr;DiacriticalAcute;"
+    "DiacriticalDot;DiacriticalDoubleAcute;DiacriticalGrave;DiacriticalTilde;"
+    "Diamond;DifferentialD;Dopf;Dot;DotDot;DotEqual;DoubleContourIntegral;"
+    "DoubleDot;DoubleDownArrow;DoubleLeftArrow;DoubleLeftRightArrow;"
+    "DoubleLeftTee;DoubleLongLeftArrow;DoubleLongLeftRightArrow;"
+    "DoubleLongRightArrow;DoubleRightArrow;DoubleRightTee;DoubleUpArrow;"
+    "DoubleUpDownArrow;DoubleVerticalBar;DownArrow;DownArrowBar;"
+    "DownArrowUpArrow;DownBreve;DownLeftRightVector;DownLeftTeeVector;"
+    "DownLeftVector;DownLeftVectorBar;DownRightTeeVector;DownRightVector;"
+    "DownRightVectorBar;DownTee;DownTeeArrow;Downarrow;Dscr;Dstrok;ENG;ETH"
+    "ETH;EacuteEacute;Ecaron;EcircEcirc;Ecy;Edot;Efr;EgraveEgrave;Element;"
+    "Emacr;EmptySmallSquare;EmptyVerySmallSquare;Eogon;Eopf;Epsilon;Equal;"
+    "EqualTilde;Equilibrium;Escr;Esim;Eta;EumlEuml;Exists;ExponentialE;Fcy;"
+    "Ffr;FilledSmallSquare;FilledVerySmallSquare;Fopf;ForAll;Fouriertrf;Fscr;"
+    "GJcy;GTGT;Gamma;Gammad;Gbreve;Gcedil;Gcirc;Gcy;Gdot;Gfr;Gg;Gopf;"
+    "GreaterEqual;GreaterEqualLess;GreaterFullEqual;GreaterGreater;"
+    "GreaterLess;GreaterSlantEqual;GreaterTilde;Gscr;Gt;HARDcy;Hacek;Hat;"
+    "Hcirc;Hfr;HilbertSpace;Hopf;HorizontalLine;Hscr;Hstrok;HumpDownHump;"
+    "HumpEqual;IEcy;IJlig;IOcy;IacuteIacute;IcircIcirc;Icy;Idot;Ifr;Igrave"
+    "Igrave;Im;Imacr;ImaginaryI;Implies;Int;Integral;Intersection;"
+    "InvisibleComma;InvisibleTimes;Iogon;Iopf;Iota;Iscr;Itilde;Iukcy;Iuml"
+    "Iuml;Jcirc;Jcy;Jfr;Jopf;Jscr;Jsercy;Jukcy;KHcy;KJcy;Kappa;Kcedil;Kcy;"
+    "Kfr;Kopf;Kscr;LJcy;LTLT;Lacute;Lambda;Lang;Laplacetrf;Larr;Lcaron;"
+    "Lcedil;Lcy;LeftAngleBracket;LeftArrow;LeftArrowBar;LeftArrowRightArrow;"
+    "LeftCeiling;LeftDoubleBracket;LeftDownTeeVector;LeftDownVector;"
+    "LeftDownVectorBar;LeftFloor;LeftRightArrow;LeftRightVector;LeftTee;"
+    "LeftTeeArrow;LeftTeeVector;LeftTriangle;LeftTriangleBar;"
+    "LeftTriangleEqual;LeftUpDownVector;LeftUpTeeVector;LeftUpVector;"
+    "LeftUpVectorBar;LeftVector;LeftVectorBar;Leftarrow;Leftrightarrow;"
+    "LessEqualGreater;LessFullEqual;LessGreater;LessLess;LessSlantEqual;"
+    "LessTilde;Lfr;Ll;Lleftarrow;Lmidot;LongLeftArrow;LongLeftRightArrow;"
+    "LongRightArrow;Longleftarrow;Longleftrightarrow;Longrightarrow;Lopf;"
+    "LowerLeftArrow;LowerRightArrow;Lscr;Lsh;Lstrok;Lt;Map;Mcy;MediumSpace;"
+    "Mellintrf;Mfr;MinusPlus;Mopf;Mscr;Mu;NJcy;Nacute;Ncaron;Ncedil;Ncy;"
+    "NegativeMediumSpace;NegativeThickSpace;NegativeThinSpace;"
+    "NegativeVeryThinSpace;NestedGreaterGreater;NestedLessLess;NewLine;Nfr;"
+    "NoBreak;NonBreakingSpace;Nopf;Not;NotCongruent;NotCupCap;"
+    "NotDoubleVerticalBar;NotElement;NotEqual;NotEqualTilde;NotExists;"
+    "NotGreater;NotGreaterEqual;NotGreaterFullEqual;NotGreaterGreater;"
+    "NotGreaterLess;NotGreaterSlantEqual;NotGreaterTilde;NotHumpDownHump;"
+    "NotHumpEqual;NotLeftTriangle;NotLeftTriangleBar;NotLeftTriangleEqual;"
+    "NotLess;NotLessEqual;NotLessGreater;NotLessLess;NotLessSlantEqual;"
+    "NotLessTilde;NotNestedGreaterGreater;NotNestedLessLess;NotPrecedes;"
+    "NotPrecedesEqual;NotPrecedesSlantEqual;NotReverseElement;"
+    "NotRightTriangle;NotRightTriangleBar;NotRightTriangleEqual;"
+    "NotSquareSubset;NotSquareSubsetEqual;NotSquareSuperset;"
+    "NotSquareSupersetEqual;NotSubset;NotSubsetEqual;NotSucceeds;"
+    "NotSucceedsEqual;NotSucceedsSlantEqual;NotSucceedsTilde;NotSuperset;"
+    "NotSupersetEqual;NotTilde;NotTildeEqual;NotTildeFullEqual;NotTildeTilde;"
+    "NotVerticalBar;Nscr;NtildeNtilde;Nu;OElig;OacuteOacute;OcircOcirc;Ocy;"
+    "Odblac;Ofr;OgraveOgrave;Omacr;Omega;Omicron;Oopf;OpenCurlyDoubleQuote;"
+    "OpenCurlyQuote;Or;Oscr;OslashOslash;OtildeOtilde;Otimes;OumlOuml;"
+    "OverBar;OverBrace;OverBracket;OverParenthesis;PartialD;Pcy;Pfr;Phi;Pi;"
+    "PlusMinus;Poincareplane;Popf;Pr;Precedes;PrecedesEqual;"
+    "PrecedesSlantEqual;PrecedesTilde;Prime;Product;Proportion;Proportional;"
+    "Pscr;Psi;QUOTQUOT;Qfr;Qopf;Qscr;RBarr;REGREG;Racute;Rang;Rarr;Rarrtl;"
+    "Rcaron;Rcedil;Rcy;Re;ReverseElement;ReverseEquilibrium;"
+    "ReverseUpEquilibrium;Rfr;Rho;RightAngleBracket;RightArrow;RightArrowBar;"
+    "RightArrowLeftArrow;RightCeiling;RightDoubleBracket;RightDownTeeVector;"
+    "RightDownVector;RightDownVectorBar;RightFloor;RightTee;RightTeeArrow;"
+    "RightTeeVector;RightTriangle;RightTriangleBar;RightTriangleEqual;"
+    "RightUpDownVector;RightUpTeeVector;RightUpVector;RightUpVectorBar;"
+    "RightVector;RightVectorBar;Rightarrow;Ropf;RoundImplies;Rrightarrow;"
+    "Rscr;Rsh;RuleDelayed;SHCHcy;SHcy;SOFTcy;Sacute;Sc;Scaron;Scedil;Scirc;"
+    "Scy;Sfr;ShortDownArrow;ShortLeftArrow;ShortRightArrow;ShortUpArrow;"
+    "Sigma;SmallCircle;Sopf;Sqrt;Square;SquareIntersection;SquareSubset;"
+    "SquareSubsetEqual;SquareSuperset;SquareSupersetEqual;SquareUnion;Sscr;"
+    "Star;Sub;Subset;SubsetEqual;Succeeds;SucceedsEqual;SucceedsSlantEqual;"
+    "SucceedsTilde;SuchThat;Sum;Sup;Superset;SupersetEqual;Supset;THORNTHORN;"
+    "TRADE;TSHcy;TScy;Tab;Tau;Tcaron;Tcedil;Tcy;Tfr;Therefore;Theta;"
+    "ThickSpace;ThinSpace;Tilde;TildeEqual;TildeFullEqual;TildeTilde;Topf;"
+    "TripleDot;Tscr;Tstrok;UacuteUacute;Uarr;Uarrocir;Ubrcy;Ubreve;Ucirc"
+    "Ucirc;Ucy;Udblac;Ufr;UgraveUgrave;Umacr;UnderBar;UnderBrace;"
+    "UnderBracket;UnderParenthesis;Union;UnionPlus;Uogon;Uopf;UpArrow;"
+    "UpArrowBar;UpArrowDownArrow;UpDownArrow;UpEquilibrium;UpTee;UpTeeArrow;"
+    "Uparrow;Updownarrow;UpperLeftArrow;UpperRightArrow;Upsi;Upsilon;Uring;"
+    "Uscr;Utilde;UumlUuml;VDash;Vbar;Vcy;Vdash;Vdashl;Vee;Verbar;Vert;"
+    "VerticalBar;VerticalLine;VerticalSeparator;VerticalTilde;VeryThinSpace;"
+    "Vfr;Vopf;Vscr;Vvdash;Wcirc;Wedge;Wfr;Wopf;Wscr;Xfr;Xi;Xopf;Xscr;YAcy;"
+    "YIcy;YUcy;YacuteYacute;Ycirc;Ycy;Yfr;Yopf;Yscr;Yuml;ZHcy;Zacute;Zcaron;"
+    "Zcy;Zdot;ZeroWidthSpace;Zeta;Zfr;Zopf;Zscr;aacuteaacute;abreve;ac;acE;"
+    "acd;acircacirc;acuteacute;acy;aeligaelig;af;afr;agraveagrave;alefsym;"
+    "aleph;alpha;amacr;amalg;ampamp;and;andand;andd;andslope;andv;ang;ange;"
+    "angle;angmsd;angmsdaa;angmsdab;angmsdac;angmsdad;angmsdae;angmsdaf;"
+    "angmsdag;angmsdah;angrt;angrtvb;angrtvbd;angsph;angst;angzarr;aogon;"
+    "aopf;ap;apE;apacir;ape;apid;apos;approx;approxeq;aringaring;ascr;ast;"
+    "asymp;asympeq;atildeatilde;aumlauml;awconint;awint;bNot;backcong;"
+    "backepsilon;backprime;backsim;backsimeq;barvee;barwed;barwedge;bbrk;"
+    "bbrktbrk;bcong;bcy;bdquo;becaus;because;bemptyv;bepsi;bernou;beta;beth;"
+    "between;bfr;bigcap;bigcirc;bigcup;bigodot;bigoplus;bigotimes;bigsqcup;"
+    "bigstar;bigtriangledown;bigtriangleup;biguplus;bigvee;bigwedge;bkarow;"
+    "blacklozenge;blacksquare;blacktriangle;blacktriangledown;"
+    "blacktriangleleft;blacktriangleright;blank;blk12;blk14;blk34;block;bne;"
+    "bnequiv;bnot;bopf;bot;bottom;bowtie;boxDL;boxDR;boxDl;boxDr;boxH;boxHD;"
+    "boxHU;boxHd;boxHu;boxUL;boxUR;boxUl;boxUr;boxV;boxVH;boxVL;boxVR;boxVh;"
+    "boxVl;boxVr;boxbox;boxdL;boxdR;boxdl;boxdr;boxh;boxhD;boxhU;boxhd;boxhu;"
+    "boxminus;boxplus;boxtimes;boxuL;boxuR;boxul;boxur;boxv;boxvH;boxvL;"
+    "boxvR;boxvh;boxvl;boxvr;bprime;breve;brvbarbrvbar;bscr;bsemi;bsim;bsime;"
+    "bsol;bsolb;bsolhsub;bull;bullet;bump;bumpE;bumpe;bumpeq;cacute;cap;"
+    "capand;capbrcup;capcap;capcup;capdot;caps;caret;caron;ccaps;ccaron;"
+    "ccedilccedil;ccirc;ccups;ccupssm;cdot;cedilcedil;cemptyv;centcent;"
+    "centerdot;cfr;chcy;check;checkmark;chi;cir;cirE;circ;circeq;"
+    "circlearrowleft;circlearrowright;circledR;circledS;circledast;"
+    "circledcirc;circleddash;cire;cirfnint;cirmid;cirscir;clubs;clubsuit;"
+    "colon;colone;coloneq;comma;commat;comp;compfn;complement;complexes;cong;"
+    "congdot;conint;copf;coprod;copycopy;copysr;crarr;cross;cscr;csub;csube;"
+    "csup;csupe;ctdot;cudarrl;cudarrr;cuepr;cuesc;cularr;cularrp;cup;"
+    "cupbrcap;cupcap;cupcup;cupdot;cupor;cups;curarr;curarrm;curlyeqprec;"
+    "curlyeqsucc;curlyvee;curlywedge;currencurren;curvearrowleft;"
+    "curvearrowright;cuvee;cuwed;cwconint;cwint;cylcty;dArr;dHar;dagger;"
+    "daleth;darr;dash;dashv;dbkarow;dblac;dcaron;dcy;dd;ddagger;ddarr;"
+    "ddotseq;degdeg;delta;demptyv;dfisht;dfr;dharl;dharr;diam;diamond;"
+    "diamondsuit;diams;die;digamma;disin;div;dividedivide;divideontimes;"
+    "divonx;djcy;dlcorn;dlcrop;dollar;dopf;dot;doteq;doteqdot;dotminus;"
+    "dotplus;dotsquare;doublebarwedge;downarrow;downdownarrows;"
+    "downharpoonleft;downharpoonright;drbkarow;drcorn;drcrop;dscr;dscy;dsol;"
+    "dstrok;dtdot;dtri;dtrif;duarr;duhar;dwangle;dzcy;dzigrarr;eDDot;eDot;"
+    "eacuteeacute;easter;ecaron;ecir;ecircecirc;ecolon;ecy;edot;ee;efDot;efr;"
+    "eg;egraveegrave;egs;egsdot;el;elinters;ell;els;elsdot;emacr;empty;"
+    "emptyset;emptyv;emsp13;emsp14;emsp;eng;ensp;eogon;eopf;epar;eparsl;"
+    "eplus;epsi;epsilon;epsiv;eqcirc;eqcolon;eqsim;eqslantgtr;eqslantless;"
+    "equals;equest;equiv;equivDD;eqvparsl;erDot;erarr;escr;esdot;esim;eta;eth"
+    "eth;eumleuml;euro;excl;exist;expectation;exponentiale;fallingdotseq;fcy;"
+    "female;ffilig;fflig;ffllig;ffr;filig;fjlig;flat;fllig;fltns;fnof;fopf;"
+    "forall;fork;forkv;fpartint;frac12frac12;frac13;frac14frac14;frac15;"
+    "frac16;frac18;frac23;frac25;frac34frac34;frac35;frac38;frac45;frac56;"
+    "frac58;frac78;frasl;frown;fscr;gE;gEl;gacute;gamma;gammad;gap;gbreve;"
+    "gcirc;gcy;gdot;ge;gel;geq;geqq;geqslant;ges;gescc;gesdot;gesdoto;"
+    "gesdotol;gesl;gesles;gfr;gg;ggg;gimel;gjcy;gl;glE;gla;glj;gnE;gnap;"
+    "gnapprox;gne;gneq;gneqq;gnsim;gopf;grave;gscr;gsim;gsime;gsiml;gtgt;"
+    "gtcc;gtcir;gtdot;gtlPar;gtquest;gtrapprox;gtrarr;gtrdot;gtreqless;"
+    "gtreqqless;gtrless;gtrsim;gvertneqq;gvnE;hArr;hairsp;half;hamilt;hardcy;"
+    "harr;harrcir;harrw;hbar;hcirc;hearts;heartsuit;hellip;hercon;hfr;"
+    "hksearow;hkswarow;hoarr;homtht;hookleftarrow;hookrightarrow;hopf;horbar;"
+    "hscr;hslash;hstrok;hybull;hyphen;iacuteiacute;ic;icircicirc;icy;iecy;"
+    "iexcliexcl;iff;ifr;igraveigrave;ii;iiiint;iiint;iinfin;iiota;ijlig;"
+    "imacr;image;imagline;imagpart;imath;imof;imped;in;incare;infin;infintie;"
+    "inodot;int;intcal;integers;intercal;intlarhk;intprod;iocy;iogon;iopf;"
+    "iota;iprod;iquestiquest;iscr;isin;isinE;isindot;isins;isinsv;isinv;it;"
+    "itilde;iukcy;iumliuml;jcirc;jcy;jfr;jmath;jopf;jscr;jsercy;jukcy;kappa;"
+    "kappav;kcedil;kcy;kfr;kgreen;khcy;kjcy;kopf;kscr;lAarr;lArr;lAtail;"
+    "lBarr;lE;lEg;lHar;lacute;laemptyv;lagran;lambda;lang;langd;langle;lap;"
+    "laquolaquo;larr;larrb;larrbfs;larrfs;larrhk;larrlp;larrpl;larrsim;"
+    "larrtl;lat;latail;late;lates;lbarr;lbbrk;lbrace;lbrack;lbrke;lbrksld;"
+    "lbrkslu;lcaron;lcedil;lceil;lcub;lcy;ldca;ldquo;ldquor;ldrdhar;ldrushar;"
+    "ldsh;le;leftarrow;leftarrowtail;leftharpoondown;leftharpoonup;"
+    "leftleftarrows;leftrightarrow;leftrightarrows;leftrightharpoons;"
+    "leftrightsquigarrow;leftthreetimes;leg;leq;leqq;leqslant;les;lescc;"
+    "lesdot;lesdoto;lesdotor;lesg;lesges;lessapprox;lessdot;lesseqgtr;"
+    "lesseqqgtr;lessgtr;lesssim;lfisht;lfloor;lfr;lg;lgE;lhard;lharu;lharul;"
+    "lhblk;ljcy;ll;llarr;llcorner;llhard;lltri;lmidot;lmoust;lmoustache;lnE;"
+    "lnap;lnapprox;lne;lneq;lneqq;lnsim;loang;loarr;lobrk;longleftarrow;"
+    "longleftrightarrow;longmapsto;longrightarrow;looparrowleft;"
+    "looparrowright;lopar;lopf;loplus;lotimes;lowast;lowbar;loz;lozenge;lozf;"
+    "lpar;lparlt;lrarr;lrcorner;lrhar;lrhard;lrm;lrtri;lsaquo;lscr;lsh;lsim;"
+    "lsime;lsimg;lsqb;lsquo;lsquor;lstrok;ltlt;ltcc;ltcir;ltdot;lthree;"
+    "ltimes;ltlarr;ltquest;ltrPar;ltri;ltrie;ltrif;lurdshar;luruhar;"
+    "lvertneqq;lvnE;mDDot;macrmacr;male;malt;maltese;map;mapsto;mapstodown;"
+    "mapstoleft;mapstoup;marker;mcomma;mcy;mdash;measuredangle;mfr;mho;micro"
+    "micro;mid;midast;midcir;middotmiddot;minus;minusb;minusd;minusdu;mlcp;"
+    "mldr;mnplus;models;mopf;mp;mscr;mstpos;mu;multimap;mumap;nGg;nGt;nGtv;"
+    "nLeftarrow;nLeftrightarrow;nLl;nLt;nLtv;nRightarrow;nVDash;nVdash;nabla;"
+    "nacute;nang;nap;napE;napid;napos;napprox;natur;natural;naturals;nbsp"
+    "nbsp;nbump;nbumpe;ncap;ncaron;ncedil;ncong;ncongdot;ncup;ncy;ndash;ne;"
+    "neArr;nearhk;nearr;nearrow;nedot;nequiv;nesear;nesim;nexist;nexists;nfr;"
+    "ngE;nge;ngeq;ngeqq;ngeqslant;nges;ngsim;ngt;ngtr;nhArr;nharr;nhpar;ni;"
+    "nis;nisd;niv;njcy;nlArr;nlE;nlarr;nldr;nle;nleftarrow;nleftrightarrow;"
+    "nleq;nleqq;nleqslant;nles;nless;nlsim;nlt;nltri;nltrie;nmid;nopf;notnot;"
+    "notin;notinE;notindot;notinva;notinvb;notinvc;notni;notniva;notnivb;"
+    "notnivc;npar;nparallel;nparsl;npart;npolint;npr;nprcue;npre;nprec;"
+    "npreceq;nrArr;nrarr;nrarrc;nrarrw;nrightarrow;nrtri;nrtrie;nsc;nsccue;"
+    "nsce;nscr;nshortmid;nshortparallel;nsim;nsime;nsimeq;nsmid;nspar;"
+    "nsqsube;nsqsupe;nsub;nsubE;nsube;nsubset;nsubseteq;nsubseteqq;nsucc;"
+    "nsucceq;nsup;nsupE;nsupe;nsupset;nsupseteq;nsupseteqq;ntgl;ntildentilde;"
+    "ntlg;ntriangleleft;ntrianglelefteq;ntriangleright;ntrianglerighteq;nu;"
+    "num;numero;numsp;nvDash;nvHarr;nvap;nvdash;nvge;nvgt;nvinfin;nvlArr;"
+    "nvle;nvlt;nvltrie;nvrArr;nvrtrie;nvsim;nwArr;nwarhk;nwarr;nwarrow;"
+    "nwnear;oS;oacuteoacute;oast;ocir;ocircocirc;ocy;odash;odblac;odiv;odot;"
+    "odsold;oelig;ofcir;ofr;ogon;ograveograve;ogt;ohbar;ohm;oint;olarr;olcir;"
+    "olcross;oline;olt;omacr;omega;omicron;omid;ominus;oopf;opar;operp;oplus;"
+    "or;orarr;ord;order;orderof;ordfordf;ordmordm;origof;oror;orslope;orv;"
+    "oscr;oslashoslash;osol;otildeotilde;otimes;otimesas;oumlouml;ovbar;par;"
+    "parapara;parallel;parsim;parsl;part;pcy;percnt;period;permil;perp;"
+    "pertenk;pfr;phi;phiv;phmmat;phone;pi;pitchfork;piv;planck;planckh;"
+    "plankv;plus;plusacir;plusb;pluscir;plusdo;plusdu;pluse;plusmnplusmn;"
+    "plussim;plustwo;pm;pointint;popf;poundpound;pr;prE;prap;prcue;pre;prec;"
+    "precapprox;preccurlyeq;preceq;precnapprox;precneqq;precnsim;precsim;"
+    "prime;primes;prnE;prnap;prnsim;prod;profalar;profline;profsurf;prop;"
+    "propto;prsim;prurel;pscr;psi;puncsp;qfr;qint;qopf;qprime;qscr;"
+    "quaternions;quatint;quest;questeq;quotquot;rAarr;rArr;rAtail;rBarr;rHar;"
+    "race;racute;radic;raemptyv;rang;rangd;range;rangle;raquoraquo;rarr;"
+    "rarrap;rarrb;rarrbfs;rarrc;rarrfs;rarrhk;rarrlp;rarrpl;rarrsim;rarrtl;"
+    "rarrw;ratail;ratio;rationals;rbarr;rbbrk;rbrace;rbrack;rbrke;rbrksld;"
+    "rbrkslu;rcaron;rcedil;rceil;rcub;rcy;rdca;rdldhar;rdquo;rdquor;rdsh;"
+    "real;realine;realpart;reals;rect;regreg;rfisht;rfloor;rfr;rhard;rharu;"
+    "rharul;rho;rhov;rightarrow;rightarrowtail;rightharpoondown;"
+    "rightharpoonup;rightleftarrows;rightleftharpoons;rightrightarrows;"
+    "rightsquigarrow;rightthreetimes;ring;risingdotseq;rlarr;rlhar;rlm;"
+    "rmoust;rmoustache;rnmid;roang;roarr;robrk;ropar;ropf;roplus;rotimes;"
+    "rpar;rpargt;rppolint;rrarr;rsaquo;rscr;rsh;rsqb;rsquo;rsquor;rthree;"
+    "rtimes;rtri;rtrie;rtrif;rtriltri;ruluhar;rx;sacute;sbquo;sc;scE;scap;"
+    "scaron;sccue;sce;scedil;scirc;scnE;scnap;scnsim;scpolint;scsim;scy;sdot;"
+    "sdotb;sdote;seArr;searhk;searr;searrow;sectsect;semi;seswar;setminus;"
+    "setmn;sext;sfr;sfrown;sharp;shchcy;shcy;shortmid;shortparallel;shyshy;"
+    "sigma;sigmaf;sigmav;sim;simdot;sime;simeq;simg;simgE;siml;simlE;simne;"
+    "simplus;simrarr;slarr;smallsetminus;smashp;smeparsl;smid;smile;smt;smte;"
+    "smtes;softcy;sol;solb;solbar;sopf;spades;spadesuit;spar;sqcap;sqcaps;"
+    "sqcup;sqcups;sqsub;sqsube;sqsubset;sqsubseteq;sqsup;sqsupe;sqsupset;"
+    "sqsupseteq;squ;square;squarf;squf;srarr;sscr;ssetmn;ssmile;sstarf;star;"
+    "starf;straightepsilon;straightphi;strns;sub;subE;subdot;sube;subedot;"
+    "submult;subnE;subne;subplus;subrarr;subset;subseteq;subseteqq;subsetneq;"
+    "subsetneqq;subsim;subsub;subsup;succ;succapprox;succcurlyeq;succeq;"
+    "succnapprox;succneqq;succnsim;succsim;sum;sung;sup1sup1;sup2sup2;sup3"
+    "sup3;sup;supE;supdot;supdsub;supe;supedot;suphsol;suphsub;suplarr;"
+    "supmult;supnE;supne;supplus;supset;supseteq;supseteqq;supsetneq;"
+    "supsetneqq;supsim;supsub;supsup;swArr;swarhk;swarr;swarrow;swnwar;szlig"
+    "szlig;target;tau;tbrk;tcaron;tcedil;tcy;tdot;telrec;tfr;there4;"
+    "therefore;theta;thetasym;thetav;thickapprox;thicksim;thinsp;thkap;"
+    "thksim;thornthorn;tilde;timestimes;timesb;timesbar;timesd;tint;toea;top;"
+    "topbot;topcir;topf;topfork;tosa;tprime;trade;triangle;triangledown;"
+    "triangleleft;trianglelefteq;triangleq;triangleright;trianglerighteq;"
+    "tridot;trie;triminus;triplus;trisb;tritime;trpezium;tscr;tscy;tshcy;"
+    "tstrok;twixt;twoheadleftarrow;twoheadrightarrow;uArr;uHar;uacuteuacute;"
+    "uarr;ubrcy;ubreve;ucircucirc;ucy;udarr;udblac;udhar;ufisht;ufr;ugrave"
+    "ugrave;uharl;uharr;uhblk;ulcorn;ulcorner;ulcrop;ultri;umacr;umluml;"
+    "uogon;uopf;uparrow;updownarrow;upharpoonleft;upharpoonright;uplus;upsi;"
+    "upsih;upsilon;upuparrows;urcorn;urcorner;urcrop;uring;urtri;uscr;utdot;"
+    "utilde;utri;utrif;uuarr;uumluuml;uwangle;vArr;vBar;vBarv;vDash;vangrt;"
+    "varepsilon;varkappa;varnothing;varphi;varpi;varpropto;varr;varrho;"
+    "varsigma;varsubsetneq;varsubsetneqq;varsupsetneq;varsupsetneqq;vartheta;"
+    "vartriangleleft;vartriangleright;vcy;vdash;vee;veebar;veeeq;vellip;"
+    "verbar;vert;vfr;vltri;vnsub;vnsup;vopf;vprop;vrtri;vscr;vsubnE;vsubne;"
+    "vsupnE;vsupne;vzigzag;wcirc;wedbar;wedge;wedgeq;weierp;wfr;wopf;wp;wr;"
+    "wreath;wscr;xcap;xcirc;xcup;xdtri;xfr;xhArr;xharr;xi;xlArr;xlarr;xmap;"
+    "xnis;xodot;xopf;xoplus;xotime;xrArr;xrarr;xscr;xsqcup;xuplus;xutri;xvee;"
+    "xwedge;yacuteyacute;yacy;ycirc;ycy;yenyen;yfr;yicy;yopf;yscr;yucy;yuml"
+    "yuml;zacute;zcaron;zcy;zdot;zeetrf;zeta;zfr;zhcy;zigrarr;zopf;zscr;zwj;"
+    "zwnj;";
+
+static const PgHtmlEntity pg_html_entities[PG_HTML_ENTITIES_LEN] = {
+    {0, 5, 2, {0xc3, 0x86}},
+    {5, 6, 2, {0xc3, 0x86}},
+    {11, 3, 1, {0x26}},
+    {14, 4, 1, {0x26}},
+    {18, 6, 2, {0xc3, 0x81}},
+    {24, 7, 2, {0xc3, 0x81}},
+    {31, 7, 2, {0xc4, 0x82}},
+    {38, 5, 2, {0xc3, 0x82}},
+    {43, 6, 2, {0xc3, 0x82}},
+    {49, 4, 2, {0xd0, 0x90}},
+    {53, 4, 4, {0xf0, 0x9d, 0x94, 0x84}},
+    {57, 6, 2, {0xc3, 0x80}},
+    {63, 7, 2, {0xc3, 0x80}},
+    {70, 6, 2, {0xce, 0x91}},
+    {76, 6, 2, {0xc4, 0x80}},
+    {82, 4, 3, {0xe2, 0xa9, 0x93}},
+    {86, 6, 2, {0xc4, 0x84}},
+    {92, 5, 4, {0xf0, 0x9d, 0x94, 0xb8}},
+    {97, 14, 3, {0xe2, 0x81, 0xa1}},
+    {111, 5, 2, {0xc3, 0x85}},
+    {116, 6, 2, {0xc3, 0x85}},
+    {122, 5, 4, {0xf0, 0x9d, 0x92, 0x9c}},
+    {127, 7, 3, {0xe2, 0x89, 0x94}},
+    {134, 6, 2, {0xc3, 0x83}},
+    {140, 7, 2, {0xc3, 0x83}},
+    {147, 4, 2, {0xc3, 0x84}},
+    {151, 5, 2, {0xc3, 0x84}},
+    {156, 10, 3, {0xe2, 0x88, 0x96}},
+    {166, 5, 3, {0xe2, 0xab, 0xa7}},
+    {171, 7, 3, {0xe2, 0x8c, 0x86}},
+    {178, 4, 2, {0xd0, 0x91}},
+    {182, 8, 3, {0xe2, 0x88, 0xb5}},
+    {190, 11, 3, {0xe2, 0x84, 0xac}},
+    {201, 5, 2, {0xce, 0x92}},
+    {206, 4, 4, {0xf0, 0x9d, 0x94, 0x85}},
+    {210, 5, 4, {0xf0, 0x9d, 0x94, 0xb9}},
+    {215, 6, 2, {0xcb, 0x98}},
+    {221, 5, 3, {0xe2, 0x84, 0xac}},
+    {226, 7, 3, {0xe2, 0x89, 0x8e}},
+    {233, 5, 2, {0xd0, 0xa7}},
+    {238, 4, 2, {0xc2, 0xa9}},
+    {242, 5, 2, {0xc2, 0xa9}},
+    {247, 7, 2, {0xc4, 0x86}},
+    {254, 4, 3, {0xe2, 0x8b, 0x92}},
+    {258, 21, 3, {0xe2, 0x85, 0x85}},
+    {279, 8, 3, {0xe2, 0x84, 0xad}},
+    {287, 7, 2, {0xc4, 0x8c}},
+    {294, 6, 2, {0xc3, 0x87}},
+    {300, 7, 2, {0xc3, 0x87}},
+    {307, 6, 2, {0xc4, 0x88}},
+    {313, 8, 3, {0xe2, 0x88, 0xb0}},
+    {321, 5, 2, {0xc4, 0x8a}},
+    {326, 8, 2, {0xc2, 0xb8}},
+    {334, 10, 2, {0xc2, 0xb7}},
+    {344, 4, 3, {0xe2, 0x84, 0xad}},
+    {348, 4, 2, {0xce, 0xa7}},
+    {352, 10, 3, {0xe2, 0x8a, 0x99}},
+    {362, 12, 3, {0xe2, 0x8a, 0x96}},
+    {374, 11, 3, {0xe2, 0x8a, 0x95}},
+    {385, 12, 3, {0xe2, 0x8a, 0x97}},
+    {397, 25, 3, {0xe2, 0x88, 0xb2}},
+    {422, 22, 3, {0xe2, 0x80, 0x9d}},
+    {444, 16, 3, {0xe2, 0x80, 0x99}},
+    {460, 6, 3, {0xe2, 0x88, 0xb7}},
+    {466, 7, 3, {0xe2, 0xa9, 0xb4}},
+    {473, 10, 3, {0xe2, 0x89, 0xa1}},
+    {483, 7, 3, {0xe2, 0x88, 0xaf}},
+    {490, 16, 3, {0xe2, 0x88, 0xae}},
+    {506, 5, 3, {0xe2, 0x84, 0x82}},
+    {511, 10, 3, {0xe2, 0x88, 0x90}},
+    {521, 32, 3, {0xe2, 0x88, 0xb3}},
+    {553, 6, 3, {0xe2, 0xa8, 0xaf}},
+    {559, 5, 4, {0xf0, 0x9d, 0x92, 0x9e}},
+    {564, 4, 3, {0xe2, 0x8b, 0x93}},
+    {568, 7, 3, {0xe2, 0x89, 0x8d}},
+    {575, 3, 3, {0xe2, 0x85, 0x85}},
+    {578, 9, 3, {0xe2, 0xa4, 0x91}},
+    {587, 5, 2, {0xd0, 0x82}},
+    {592, 5, 2, {0xd0, 0x85}},
+    {597, 5, 2, {0xd0, 0x8f}},
+    {602, 7, 3, {0xe2, 0x80, 0xa1}},
+    {609, 5, 3, {0xe2, 0x86, 0xa1}},
+    {614, 6, 3, {0xe2, 0xab, 0xa4}},
+    {620, 7, 2, {0xc4, 0x8e}},
+    {627, 4, 2, {0xd0, 0x94}},
+    {631, 4, 3, {0xe2, 0x88, 0x87}},
+    {635, 6, 2, {0xce, 0x94}},
+    {641, 4, 4, {0xf0, 0x9d, 0x94, 0x87}},
+    {645, 17, 2, {0xc2, 0xb4}},
+    {662, 15, 2, {0xcb, 0x99}},
+    {677, 23, 2, {0xcb, 0x9d}},
+    {700, 17, 1, {0x60}},
+    {717, 17, 2, {0xcb, 0x9c}},
+    {734, 8, 3, {0xe2, 0x8b, 0x84}},
+    {742, 14, 3, {0xe2, 0x85, 0x86}},
+    {756, 5, 4, {0xf0, 0x9d, 0x94, 0xbb}},
+    {761, 4, 2, {0xc2, 0xa8}},
+    {765, 7, 3, {0xe2, 0x83, 0x9c}},
+    {772, 9, 3, {0xe2, 0x89, 0x90}},
+    {781, 22, 3, {0xe2, 0x88, 0xaf}},
+    {803, 10, 2, {0xc2, 0xa8}},
+    {813, 16, 3, {0xe2, 0x87, 0x93}},
+    {829, 16, 3, {0xe2, 0x87, 0x90}},
+    {845, 21, 3, {0xe2, 0x87, 0x94}},
+    {866, 14, 3, {0xe2, 0xab, 0xa4}},
+    {880, 20, 3, {0xe2, 0x9f, 0xb8}},
+    {900, 25, 3, {0xe2, 0x9f, 0xba}},
+    {925, 21, 3, {0xe2, 0x9f, 0xb9}},
+    {946, 17, 3, {0xe2, 0x87, 0x92}},
+    {963, 15, 3, {0xe2, 0x8a, 0xa8}},
+    {978, 14, 3, {0xe2, 0x87, 0x91}},
+    {992, 18, 3, {0xe2, 0x87, 0x95}},
+    {1010, 18, 3, {0xe2, 0x88, 0xa5}},
+    {1028, 10, 3, {0xe2, 0x86, 0x93}},
+    {1038, 13, 3, {0xe2, 0xa4, 0x93}},
+    {1051, 17, 3, {0xe2, 0x87, 0xb5}},
+    {1068, 10, 2, {0xcc, 0x91}},
+    {1078, 20, 3, {0xe2, 0xa5, 0x90}},
+    {1098, 18, 3, {0xe2, 0xa5, 0x9e}},
+    {1116, 15, 3, {0xe2, 0x86, 0xbd}},
+    {1131, 18, 3, {0xe2, 0xa5, 0x96}},
+    {1149, 19, 3, {0xe2, 0xa5, 0x9f}},
+    {1168, 16, 3, {0xe2, 0x87, 0x81}},
+    {1184, 19, 3, {0xe2, 0xa5, 0x97}},
+    {1203, 8, 3, {0xe2, 0x8a, 0xa4}},
+    {1211, 13, 3, {0xe2, 0x86, 0xa7}},
+    {1224, 10, 3, {0xe2, 0x87, 0x93}},
+    {1234, 5, 4, {0xf0, 0x9d, 0x92, 0x9f}},
+    {1239, 7, 2, {0xc4, 0x90}},
+    {1246, 4, 2, {0xc5, 0x8a}},
+    {1250, 3, 2, {0xc3, 0x90}},
+    {1253, 4, 2, {0xc3, 0x90}},
+    {1257, 6, 2, {0xc3, 0x89}},
+    {1263, 7, 2, {0xc3, 0x89}},
+    {1270, 7, 2, {0xc4, 0x9a}},
+    {1277, 5, 2, {0xc3, 0x8a}},
+    {1282, 6, 2, {0xc3, 0x8a}},
+    {1288, 4, 2, {0xd0, 0xad}},
+    {1292, 5, 2, {0xc4, 0x96}},
+    {1297, 4, 4, {0xf0, 0x9d, 0x94, 0x88}},
+    {1301, 6, 2, {0xc3, 0x88}},
+    {1307, 7, 2, {0xc3, 0x88}},
+    {1314, 8, 3, {0xe2, 0x88, 0x88}},
+    {1322, 6, 2, {0xc4, 0x92}},
+    {1328, 17, 3, {0xe2, 0x97, 0xbb}},
+    {1345, 21, 3, {0xe2, 0x96, 0xab}},
+    {1366, 6, 2, {0xc4, 0x98}},
+    {1372, 5, 4, {0xf0, 0x9d, 0x94, 0xbc}},
+    {1377, 8, 2, {0xce, 0x95}},
+    {1385, 6, 3, {0xe2, 0xa9, 0xb5}},
+    {1391, 11, 3, {0xe2, 0x89, 0x82}},
+    {1402, 12, 3, {0xe2, 0x87, 0x8c}},
+    {1414, 5, 3, {0xe2, 0x84, 0xb0}},
+    {1419, 5, 3, {0xe2, 0xa9, 0xb3}},
+    {1424, 4, 2, {0xce, 0x97}},
+    {1428, 4, 2, {0xc3, 0x8b}},
+    {1432, 5, 2, {0xc3, 0x8b}},
+    {1437, 7, 3, {0xe2, 0x88, 0x83}},
+    {1444, 13, 3, {0xe2, 0x85, 0x87}},
+    {1457, 4, 2, {0xd0, 0xa4}},
+    {1461, 4, 4, {0xf0, 0x9d, 0x94, 0x89}},
+    {1465, 18, 3, {0xe2, 0x97, 0xbc}},
+    {1483, 22, 3, {0xe2, 0x96, 0xaa}},
+    {1505, 5, 4, {0xf0, 0x9d, 0x94, 0xbd}},
+    {1510, 7, 3, {0xe2, 0x88, 0x80}},
+    {1517, 11, 3, {0xe2, 0x84, 0xb1}},
+    {1528, 5, 3, {0xe2, 0x84, 0xb1}},
+    {1533, 5, 2, {0xd0, 0x83}},
+    {1538, 2, 1, {0x3e}},
+    {1540, 3, 1, {0x3e}},
+    {1543, 6, 2, {0xce, 0x93}},
+    {1549, 7, 2, {0xcf, 0x9c}},
+    {1556, 7, 2, {0xc4, 0x9e}},
+    {1563, 7, 2, {0xc4, 0xa2}},
+    {1570, 6, 2, {0xc4, 0x9c}},
+    {1576, 4, 2, {0xd0, 0x93}},
+    {1580, 5, 2, {0xc4, 0xa0}},
+    {1585, 4, 4, {0xf0, 0x9d, 0x94, 0x8a}},
+    {1589, 3, 3, {0xe2, 0x8b, 0x99}},
+    {1592, 5, 4, {0xf0, 0x9d, 0x94, 0xbe}},
+    {1597, 13, 3, {0xe2, 0x89, 0xa5}},
+    {1610, 17, 3, {0xe2, 0x8b, 0x9b}},
+    {1627, 17, 3, {0xe2, 0x89, 0xa7}},
+    {1644, 15, 3, {0xe2, 0xaa, 0xa2}},
+    {1659, 12, 3, {0xe2, 0x89, 0xb7}},
+    {1671, 18, 3, {0xe2, 0xa9, 0xbe}},
+    {1689, 13, 3, {0xe2, 0x89, 0xb3}},
+    {1702, 5, 4, {0xf0, 0x9d, 0x92, 0xa2}},
+    {1707, 3, 3, {0xe2, 0x89, 0xab}},
+    {1710, 7, 2, {0xd0, 0xaa}},
+    {1717, 6, 2, {0xcb, 0x87}},
+    {1723, 4, 1, {0x5e}},
+    {1727, 6, 2, {0xc4, 0xa4}},
+    {1733, 4, 3, {0xe2, 0x84, 0x8c}},
+    {1737, 13, 3, {0xe2, 0x84, 0x8b}},
+    {1750, 5, 3, {0xe2, 0x84, 0x8d}},
+    {1755, 15, 3, {0xe2, 0x94, 0x80}},
+    {1770, 5, 3, {0xe2, 0x84, 0x8b}},
+    {1775, 7, 2, {0xc4, 0xa6}},
+    {1782, 13, 3, {0xe2, 0x89, 0x8e}},
+    {1795, 10, 3, {0xe2, 0x89, 0x8f}},
+    {1805, 5, 2, {0xd0, 0x95}},
+    {1810, 6, 2, {0xc4, 0xb2}},
+    {1816, 5, 2, {0xd0, 0x81}},
+    {1821, 6, 2, {0xc3, 0x8d}},
+    {1827, 7, 2, {0xc3, 0x8d}},
+    {1834, 5, 2, {0xc3, 0x8e}},
+    {1839, 6, 2, {0xc3, 0x8e}},
+    {1845, 4, 2, {0xd0, 0x98}},
+    {1849, 5, 2, {0xc4, 0xb0}},
+    {1854, 4, 3, {0xe2, 0x84, 0x91}},
+    {1858, 6, 2, {0xc3, 0x8c}},
+    {1864, 7, 2, {0xc3, 0x8c}},
+    {1871, 3, 3, {0xe2, 0x84, 0x91}},
+    {1874, 6, 2, {0xc4, 0xaa}},
+    {1880, 11, 3, {0xe2, 0x85, 0x88}},
+    {1891, 8, 3, {0xe2, 0x87, 0x92}},
+    {1899, 4, 3, {0xe2, 0x88, 0xac}},
+    {1903, 9, 3, {0xe2, 0x88, 0xab}},
+    {1912, 13, 3, {0xe2, 0x8b, 0x82}},
+    {1925, 15, 3, {0xe2, 0x81, 0xa3}},
+    {1940, 15, 3, {0xe2, 0x81, 0xa2}},
+    {1955, 6, 2, {0xc4, 0xae}},
+    {1961, 5, 4, {0xf0, 0x9d, 0x95, 0x80}},
+    {1966, 5, 2, {0xce, 0x99}},
+    {1971, 5, 3, {0xe2, 0x84, 0x90}},
+    {1976, 7, 2, {0xc4, 0xa8}},
+    {1983, 6, 2, {0xd0, 0x86}},
+    {1989, 4, 2, {0xc3, 0x8f}},
+    {1993, 5, 2, {0xc3, 0x8f}},
+    {1998, 6, 2, {0xc4, 0xb4}},
+    {2004, 4, 2, {0xd0, 0x99}},
+    {2008, 4, 4, {0xf0, 0x9d, 0x94, 0x8d}},
+    {2012, 5, 4, {0xf0, 0x9d, 0x95, 0x81}},
+    {2017, 5, 4, {0xf0, 0x9d, 0x92, 0xa5}},
+    {2022, 7, 2, {0xd0, 0x88}},
+    {2029, 6, 2, {0xd0, 0x84}},
+    {2035, 5, 2, {0xd0, 0xa5}},
+    {2040, 5, 2, {0xd0, 0x8c}},
+    {2045, 6, 2, {0xce, 0x9a}},
+    {2051, 7, 2, {0xc4, 0xb6}},
+    {2058, 4, 2, {0xd0, 0x9a}},
+    {2062, 4, 4, {0xf0, 0x9d, 0x94, 0x8e}},
+    {2066, 5, 4, {0xf0, 0x9d, 0x95, 0x82}},
+    {2071, 5, 4, {0xf0, 0x9d, 0x92, 0xa6}},
+    {2076, 5, 2, {0xd0, 0x89}},
+    {2081, 2, 1, {0x3c}},
+    {2083, 3, 1, {0x3c}},
+    {2086, 7, 2, {0xc4, 0xb9}},
+    {2093, 7, 2, {0xce, 0x9b}},
+    {2100, 5, 3, {0xe2, 0x9f, 0xaa}},
+    {2105, 11, 3, {0xe2, 0x84, 0x92}},
+    {2116, 5, 3, {0xe2, 0x86, 0x9e}},
+    {2121, 7, 2, {0xc4, 0xbd}},
+    {2128, 7, 2, {0xc4, 0xbb}},
+    {2135, 4, 2, {0xd0, 0x9b}},
+    {2139, 17, 3, {0xe2, 0x9f, 0xa8}},
+    {2156, 10, 3, {0xe2, 0x86, 0x90}},
+    {2166, 13, 3, {0xe2, 0x87, 0xa4}},
+    {2179, 20, 3, {0xe2, 0x87, 0x86}},
+    {2199, 12, 3, {0xe2, 0x8c, 0x88}},
+    {2211, 18, 3, {0xe2, 0x9f, 0xa6}},
+    {2229, 18, 3, {0xe2, 0xa5, 0xa1}},
+    {2247, 15, 3, {0xe2, 0x87, 0x83}},
+    {2262, 18, 3, {0xe2, 0xa5, 0x99}},
+    {2280, 10, 3, {0xe2, 0x8c, 0x8a}},
+    {2290, 15, 3, {0xe2, 0x86, 0x94}},
+    {2305, 16, 3, {0xe2, 0xa5, 0x8e}},
+    {2321, 8, 3, {0xe2, 0x8a, 0xa3}},
+    {2329, 13, 3, {0xe2, 0x86, 0xa4}},
+    {2342, 14, 3, {0xe2, 0xa5, 0x9a}},
+    {2356, 13, 3, {0xe2, 0x8a, 0xb2}},
+    {2369, 16, 3, {0xe2, 0xa7, 0x8f}},
+    {2385, 18, 3, {0xe2, 0x8a, 0xb4}},
+    {2403, 17, 3, {0xe2, 0xa5, 0x91}},
+    {2420, 16, 3, {0xe2, 0xa5, 0xa0}},
+    {2436, 13, 3, {0xe2, 0x86, 0xbf}},
+    {2449, 16, 3, {0xe2, 0xa5, 0x98}},
+    {2465, 11, 3, {0xe2, 0x86, 0xbc}},
+    {2476, 14, 3, {0xe2, 0xa5, 0x92}},
+    {2490, 10, 3, {0xe2, 0x87, 0x90}},
+    {2500, 15, 3, {0xe2, 0x87, 0x94}},
+    {2515, 17, 3, {0xe2, 0x8b, 0x9a}},
+    {2532, 14, 3, {0xe2, 0x89, 0xa6}},
+    {2546, 12, 3, {0xe2, 0x89, 0xb6}},
+    {2558, 9, 3, {0xe2, 0xaa, 0xa1}},
+    {2567, 15, 3, {0xe2, 0xa9, 0xbd}},
+    {2582, 10, 3, {0xe2, 0x89, 0xb2}},
+    {2592, 4, 4, {0xf0, 0x9d, 0x94, 0x8f}},
+    {2596, 3, 3, {0xe2, 0x8b, 0x98}},
+    {2599, 11, 3, {0xe2, 0x87, 0x9a}},
+    {2610, 7, 2, {0xc4, 0xbf}},
+    {2617, 14, 3, {0xe2, 0x9f, 0xb5}},
+    {2631, 19, 3, {0xe2, 0x9f, 0xb7}},
+    {2650, 15, 3, {0xe2, 0x9f, 0xb6}},
+    {2665, 14, 3, {0xe2, 0x9f, 0xb8}},
+    {2679, 19, 3, {0xe2, 0x9f, 0xba}},
+    {2698, 15, 3, {0xe2, 0x9f, 0xb9}},
+    {2713, 5, 4, {0xf0, 0x9d, 0x95, 0x83}},
+    {2718, 15, 3, {0xe2, 0x86, 0x99}},
+    {2733, 16, 3, {0xe2, 0x86, 0x98}},
+    {2749, 5, 3, {0xe2, 0x84, 0x92}},
+    {2754, 4, 3, {0xe2, 0x86, 0xb0}},
+    {2758, 7, 2, {0xc5, 0x81}},
+    {2765, 3, 3, {0xe2, 0x89, 0xaa}},
+    {2768, 4, 3, {0xe2, 0xa4, 0x85}},
+    {2772, 4, 2, {0xd0, 0x9c}},
+    {2776, 12, 3, {0xe2, 0x81, 0x9f}},
+    {2788, 10, 3, {0xe2, 0x84, 0xb3}},
+    {2798, 4, 4, {0xf0, 0x9d, 0x94, 0x90}},
+    {2802, 10, 3, {0xe2, 0x88, 0x93}},
+    {2812, 5, 4, {0xf0, 0x9d, 0x95, 0x84}},
+    {2817, 5, 3, {0xe2, 0x84, 0xb3}},
+    {2822, 3, 2, {0xce, 0x9c}},
+    {2825, 5, 2, {0xd0, 0x8a}},
+    {2830, 7, 2, {0xc5, 0x83}},
+    {2837, 7, 2, {0xc5, 0x87}},
+    {2844, 7, 2, {0xc5, 0x85}},
+    {2851, 4, 2, {0xd0, 0x9d}},
+    {2855, 20, 3, {0xe2, 0x80, 0x8b}},
+    {2875, 19, 3, {0xe2, 0x80, 0x8b}},
+    {2894, 18, 3, {0xe2, 0x80, 0x8b}},
+    {2912, 22, 3, {0xe2, 0x80, 0x8b}},
+    {2934, 21, 3, {0xe2, 0x89, 0xab}},
+    {2955, 15, 3, {0xe2, 0x89, 0xaa}},
+    {2970, 8, 1, {0x0a}},
+    {2978, 4, 4, {0xf0, 0x9d, 0x94, 0x91}},
+    {2982, 8, 3, {0xe2, 0x81, 0xa0}},
+    {2990, 17, 2, {0xc2, 0xa0}},
+    {3007, 5, 3, {0xe2, 0x84, 0x95}},
+    {3012, 4, 3, {0xe2, 0xab, 0xac}},
+    {3016, 13, 3, {0xe2, 0x89, 0xa2}},
+    {3029, 10, 3, {0xe2, 0x89, 0xad}},
+    {3039, 21, 3, {0xe2, 0x88, 0xa6}},
+    {3060, 11, 3, {0xe2, 0x88, 0x89}},
+    {3071, 9, 3, {0xe2, 0x89, 0xa0}},
+    {3080, 14, 5, {0xe2, 0x89, 0x82, 0xcc, 0xb8}},
+    {3094, 10, 3, {0xe2, 0x88, 0x84}},
+    {3104, 11, 3, {0xe2, 0x89, 0xaf}},
+    {3115, 16, 3, {0xe2, 0x89, 0xb1}},
+    {3131, 20, 5, {0xe2, 0x89, 0xa7, 0xcc, 0xb8}},
+    {3151, 18, 5, {0xe2, 0x89, 0xab, 0xcc, 0xb8}},
+    {3169, 15, 3, {0xe2, 0x89, 0xb9}},
+    {3184, 21, 5, {0xe2, 0xa9, 0xbe, 0xcc, 0xb8}},
+    {3205, 16, 3, {0xe2, 0x89, 0xb5}},
+    {3221, 16, 5, {0xe2, 0x89, 0x8e, 0xcc, 0xb8}},
+    {3237, 13, 5, {0xe2, 0x89, 0x8f, 0xcc, 0xb8}},
+    {3250, 16, 3, {0xe2, 0x8b, 0xaa}},
+    {3266, 19, 5, {0xe2, 0xa7, 0x8f, 0xcc, 0xb8}},
+    {3285, 21, 3, {0xe2, 0x8b, 0xac}},
+    {3306, 8, 3, {0xe2, 0x89, 0xae}},
+    {3314, 13, 3, {0xe2, 0x89, 0xb0}},
+    {3327, 15, 3, {0xe2, 0x89, 0xb8}},
+    {3342, 12, 5, {0xe2, 0x89, 0xaa, 0xcc, 0xb8}},
+    {3354, 18, 5, {0xe2, 0xa9, 0xbd, 0xcc, 0xb8}},
+    {3372, 13, 3, {0xe2, 0x89, 0xb4}},
+    {3385, 24, 5, {0xe2, 0xaa, 0xa2, 0xcc, 0xb8}},
+    {3409, 18, 5, {0xe2, 0xaa, 0xa1, 0xcc, 0xb8}},
+    {3427, 12, 3, {0xe2, 0x8a, 0x80}},
+    {3439, 17, 5, {0xe2, 0xaa, 0xaf, 0xcc, 0xb8}},
+    {3456, 22, 3, {0xe2, 0x8b, 0xa0}},
+    {3478, 18, 3, {0xe2, 0x88, 0x8c}},
+    {3496, 17, 3, {0xe2, 0x8b, 0xab}},
+    {3513, 20, 5, {0xe2, 0xa7, 0x90, 0xcc, 0xb8}},
+    {3533, 22, 3, {0xe2, 0x8b, 0xad}},
+    {3555, 16, 5, {0xe2, 0x8a, 0x8f, 0xcc, 0xb8}},
+    {3571, 21, 3, {0xe2, 0x8b, 0xa2}},
+    {3592, 18, 5, {0xe2, 0x8a, 0x90, 0xcc, 0xb8}},
+    {3610, 23, 3, {0xe2, 0x8b, 0xa3}},
+    {3633, 10, 6, {0xe2, 0x8a, 0x82, 0xe2, 0x83, 0x92}},
+    {3643, 15, 3, {0xe2, 0x8a, 0x88}},
+    {3658, 12, 3, {0xe2, 0x8a, 0x81}},
+    {3670, 17, 5, {0xe2, 0xaa, 0xb0, 0xcc, 0xb8}},
+    {3687, 22, 3, {0xe2, 0x8b, 0xa1}},
+    {3709, 17, 5, {0xe2, 0x89, 0xbf, 0xcc, 0xb8}},
+    {3726, 12, 6, {0xe2, 0x8a, 0x83, 0xe2, 0x83, 0x92}},
+    {3738, 17, 3, {0xe2, 0x8a, 0x89}},
+    {3755, 9, 3, {0xe2, 0x89, 0x81}},
+    {3764, 14, 3, {0xe2, 0x89, 0x84}},
+    {3778, 18, 3, {0xe2, 0x89, 0x87}},
+    {3796, 14, 3, {0xe2, 0x89, 0x89}},
+    {3810, 15, 3, {0xe2, 0x88, 0xa4}},
+    {3825, 5, 4, {0xf0, 0x9d, 0x92, 0xa9}},
+    {3830, 6, 2, {0xc3, 0x91}},
+    {3836, 7, 2, {0xc3, 0x91}},
+    {3843, 3, 2, {0xce, 0x9d}},
+    {3846, 6, 2, {0xc5, 0x92}},
+    {3852, 6, 2, {0xc3, 0x93}},
+    {3858, 7, 2, {0xc3, 0x93}},
+    {3865, 5, 2, {0xc3, 0x94}},
+    {3870, 6, 2, {0xc3, 0x94}},
+    {3876, 4, 2, {0xd0, 0x9e}},
+    {3880, 7, 2, {0xc5, 0x90}},
+    {3887, 4, 4, {0xf0, 0x9d, 0x94, 0x92}},
+    {3891, 6, 2, {0xc3, 0x92}},
+    {3897, 7, 2, {0xc3, 0x92}},
+    {3904, 6, 2, {0xc5, 0x8c}},
+    {3910, 6, 2, {0xce, 0xa9}},
+    {3916, 8, 2, {0xce, 0x9f}},
+    {3924, 5, 4, {0xf0, 0x9d, 0x95, 0x86}},
+    {3929, 21, 3, {0xe2, 0x80, 0x9c}},
+    {3950, 15, 3, {0xe2, 0x80, 0x98}},
+    {3965, 3, 3, {0xe2, 0xa9, 0x94}},
+    {3968, 5, 4, {0xf0, 0x9d, 0x92, 0xaa}},
+    {3973, 6, 2, {0xc3, 0x98}},
+    {3979, 7, 2, {0xc3, 0x98}},
+    {3986, 6, 2, {0xc3, 0x95}},
+    {3992, 7, 2, {0xc3, 0x95}},
+    {3999, 7, 3, {0xe2, 0xa8, 0xb7}},
+    {4006, 4, 2, {0xc3, 0x96}},
+    {4010, 5, 2, {0xc3, 0x96}},
+    {4015, 8, 3, {0xe2, 0x80, 0xbe}},
+    {4023, 10, 3, {0xe2, 0x8f, 0x9e}},
+    {4033, 12, 3, {0xe2, 0x8e, 0xb4}},
+    {4045, 16, 3, {0xe2, 0x8f, 0x9c}},
+    {4061, 9, 3, {0xe2, 0x88, 0x82}},
+    {4070, 4, 2, {0xd0, 0x9f}},
+    {4074, 4, 4, {0xf0, 0x9d, 0x94, 0x93}},
+    {4078, 4, 2, {0xce, 0xa6}},
+    {4082, 3, 2, {0xce, 0xa0}},
+    {4085, 10, 2, {0xc2, 0xb1}},
+    {4095, 14, 3, {0xe2, 0x84, 0x8c}},
+    {4109, 5, 3, {0xe2, 0x84, 0x99}},
+    {4114, 3, 3, {0xe2, 0xaa, 0xbb}},
+    {4117, 9, 3, {0xe2, 0x89, 0xba}},
+    {4126, 14, 3, {0xe2, 0xaa, 0xaf}},
+    {4140, 19, 3, {0xe2, 0x89, 0xbc}},
+    {4159, 14, 3, {0xe2, 0x89, 0xbe}},
+    {4173, 6, 3, {0xe2, 0x80, 0xb3}},
+    {4179, 8, 3, {0xe2, 0x88, 0x8f}},
+    {4187, 11, 3, {0xe2, 0x88, 0xb7}},
+    {4198, 13, 3, {0xe2, 0x88, 0x9d}},
+    {4211, 5, 4, {0xf0, 0x9d, 0x92, 0xab}},
+    {4216, 4, 2, {0xce, 0xa8}},
+    {4220, 4, 1, {0x22}},
+    {4224, 5, 1, {0x22}},
+    {4229, 4, 4, {0xf0, 0x9d, 0x94, 0x94}},
+    {4233, 5, 3, {0xe2, 0x84, 0x9a}},
+    {4238, 5, 4, {0xf0, 0x9d, 0x92, 0xac}},
+    {4243, 6, 3, {0xe2, 0xa4, 0x90}},
+    {4249, 3, 2, {0xc2, 0xae}},
+    {4252, 4, 2, {0xc2, 0xae}},
+    {4256, 7, 2, {0xc5, 0x94}},
+    {4263, 5, 3, {0xe2, 0x9f, 0xab}},
+    {4268, 5, 3, {0xe2, 0x86, 0xa0}},
+    {4273, 7, 3, {0xe2, 0xa4, 0x96}},
+    {4280, 7, 2, {0xc5, 0x98}},
+    {4287, 7, 2, {0xc5, 0x96}},
+    {4294, 4, 2, {0xd0, 0xa0}},
+    {4298, 3, 3, {0xe2, 0x84, 0x9c}},
+    {4301, 15, 3, {0xe2, 0x88, 0x8b}},
+    {4316, 19, 3, {0xe2, 0x87, 0x8b}},
+    {4335, 21, 3, {0xe2, 0xa5, 0xaf}},
+    {4356, 4, 3, {0xe2, 0x84, 0x9c}},
+    {4360, 4, 2, {0xce, 0xa1}},
+    {4364, 18, 3, {0xe2, 0x9f, 0xa9}},
+    {4382, 11, 3, {0xe2, 0x86, 0x92}},
+    {4393, 14, 3, {0xe2, 0x87, 0xa5}},
+    {4407, 20, 3, {0xe2, 0x87, 0x84}},
+    {4427, 13, 3, {0xe2, 0x8c, 0x89}},
+    {4440, 19, 3, {0xe2, 0x9f, 0xa7}},
+    {4459, 19, 3, {0xe2, 0xa5, 0x9d}},
+    {4478, 16, 3, {0xe2, 0x87, 0x82}},
+    {4494, 19, 3, {0xe2, 0xa5, 0x95}},
+    {4513, 11, 3, {0xe2, 0x8c, 0x8b}},
+    {4524, 9, 3, {0xe2, 0x8a, 0xa2}},
+    {4533, 14, 3, {0xe2, 0x86, 0xa6}},
+    {4547, 15, 3, {0xe2, 0xa5, 0x9b}},
+    {4562, 14, 3, {0xe2, 0x8a, 0xb3}},
+    {4576, 17, 3, {0xe2, 0xa7, 0x90}},
+    {4593, 19, 3, {0xe2, 0x8a, 0xb5}},
+    {4612, 18, 3, {0xe2, 0xa5, 0x8f}},
+    {4630, 17, 3, {0xe2, 0xa5, 0x9c}},
+    {4647, 14, 3, {0xe2, 0x86, 0xbe}},
+    {4661, 17, 3, {0xe2, 0xa5, 0x94}},
+    {4678, 12, 3, {0xe2, 0x87, 0x80}},
+    {4690, 15, 3, {0xe2, 0xa5, 0x93}},
+    {4705, 11, 3, {0xe2, 0x87, 0x92}},
+    {4716, 5, 3, {0xe2, 0x84, 0x9d}},
+    {4721, 13, 3, {0xe2, 0xa5, 0xb0}},
+    {4734, 12, 3, {0xe2, 0x87, 0x9b}},
+    {4746, 5, 3, {0xe2, 0x84, 0x9b}},
+    {4751, 4, 3, {0xe2, 0x86, 0xb1}},
+    {4755, 12, 3, {0xe2, 0xa7, 0xb4}},
+    {4767, 7, 2, {0xd0, 0xa9}},
+    {4774, 5, 2, {0xd0, 0xa8}},
+    {4779, 7, 2, {0xd0, 0xac}},
+    {4786, 7, 2, {0xc5, 0x9a}},
+    {4793, 3, 3, {0xe2, 0xaa, 0xbc}},
+    {4796, 7, 2, {0xc5, 0xa0}},
+    {4803, 7, 2, {0xc5, 0x9e}},
+    {4810, 6, 2, {0xc5, 0x9c}},
+    {4816, 4, 2, {0xd0, 0xa1}},
+    {4820, 4, 4, {0xf0, 0x9d, 0x94, 0x96}},
+    {4824, 15, 3, {0xe2, 0x86, 0x93}},
+    {4839, 15, 3, {0xe2, 0x86, 0x90}},
+    {4854, 16, 3, {0xe2, 0x86, 0x92}},
+    {4870, 13, 3, {0xe2, 0x86, 0x91}},
+    {4883, 6, 2, {0xce, 0xa3}},
+    {4889, 12, 3, {0xe2, 0x88, 0x98}},
+    {4901, 5, 4, {0xf0, 0x9d, 0x95, 0x8a}},
+    {4906, 5, 3, {0xe2, 0x88, 0x9a}},
+    {4911, 7, 3, {0xe2, 0x96, 0xa1}},
+    {4918, 19, 3, {0xe2, 0x8a, 0x93}},
+    {4937, 13, 3, {0xe2, 0x8a, 0x8f}},
+    {4950, 18, 3, {0xe2, 0x8a, 0x91}},
+    {4968, 15, 3, {0xe2, 0x8a, 0x90}},
+    {4983, 20, 3, {0xe2, 0x8a, 0x92}},
+    {5003, 12, 3, {0xe2, 0x8a, 0x94}},
+    {5015, 5, 4, {0xf0, 0x9d, 0x92, 0xae}},
+    {5020, 5, 3, {0xe2, 0x8b, 0x86}},
+    {5025, 4, 3, {0xe2, 0x8b, 0x90}},
+    {5029, 7, 3, {0xe2, 0x8b, 0x90}},
+    {5036, 12, 3, {0xe2, 0x8a, 0x86}},
+    {5048, 9, 3, {0xe2, 0x89, 0xbb}},
+    {5057, 14, 3, {0xe2, 0xaa, 0xb0}},
+    {5071, 19, 3, {0xe2, 0x89, 0xbd}},
+    {5090, 14, 3, {0xe2, 0x89, 0xbf}},
+    {5104, 9, 3, {0xe2, 0x88, 0x8b}},
+    {5113, 4, 3, {0xe2, 0x88, 0x91}},
+    {5117, 4, 3, {0xe2, 0x8b, 0x91}},
+    {5121, 9, 3, {0xe2, 0x8a, 0x83}},
+    {5130, 14, 3, {0xe2, 0x8a, 0x87}},
+    {5144, 7, 3, {0xe2, 0x8b, 0x91}},
+    {5151, 5, 2, {0xc3, 0x9e}},
+    {5156, 6, 2, {0xc3, 0x9e}},
+    {5162, 6, 3, {0xe2, 0x84, 0xa2}},
+    {5168, 6, 2, {0xd0, 0x8b}},
+    {5174, 5, 2, {0xd0, 0xa6}},
+    {5179, 4, 1, {0x09}},
+    {5183, 4, 2, {0xce, 0xa4}},
+    {5187, 7, 2, {0xc5, 0xa4}},
+    {5194, 7, 2, {0xc5, 0xa2}},
+    {5201, 4, 2, {0xd0, 0xa2}},
+    {5205, 4, 4, {0xf0, 0x9d, 0x94, 0x97}},
+    {5209, 10, 3, {0xe2, 0x88, 0xb4}},
+    {5219, 6, 2, {0xce, 0x98}},
+    {5225, 11, 6, {0xe2, 0x81, 0x9f, 0xe2, 0x80, 0x8a}},
+    {5236, 10, 3, {0xe2, 0x80, 0x89}},
+    {5246, 6, 3, {0xe2, 0x88, 0xbc}},
+    {5252, 11, 3, {0xe2, 0x89, 0x83}},
+    {5263, 15, 3, {0xe2, 0x89, 0x85}},
+    {5278, 11, 3, {0xe2, 0x89, 0x88}},
+    {5289, 5, 4, {0xf0, 0x9d, 0x95, 0x8b}},
+    {5294, 10, 3, {0xe2, 0x83, 0x9b}},
+    {5304, 5, 4, {0xf0, 0x9d, 0x92, 0xaf}},
+    {5309, 7, 2, {0xc5, 0xa6}},
+    {5316, 6, 2, {0xc3, 0x9a}},
+    {5322, 7, 2, {0xc3, 0x9a}},
+    {5329, 5, 3, {0xe2, 0x86, 0x9f}},
+    {5334, 9, 3, {0xe2, 0xa5, 0x89}},
+    {5343, 6, 2, {0xd0, 0x8e}},
+    {5349, 7, 2, {0xc5, 0xac}},
+    {5356, 5, 2, {0xc3, 0x9b}},
+    {5361, 6, 2, {0xc3, 0x9b}},
+    {5367, 4, 2, {0xd0, 0xa3}},
+    {5371, 7, 2, {0xc5, 0xb0}},
+    {5378, 4, 4, {0xf0, 0x9d, 0x94, 0x98}},
+    {5382, 6, 2, {0xc3, 0x99}},
+    {5388, 7, 2, {0xc3, 0x99}},
+    {5395, 6, 2, {0xc5, 0xaa}},
+    {5401, 9, 1, {0x5f}},
+    {5410, 11, 3, {0xe2, 0x8f, 0x9f}},
+    {5421, 13, 3, {0xe2, 0x8e, 0xb5}},
+    {5434, 17, 3, {0xe2, 0x8f, 0x9d}},
+    {5451, 6, 3, {0xe2, 0x8b, 0x83}},
+    {5457, 10, 3, {0xe2, 0x8a, 0x8e}},
+    {5467, 6, 2, {0xc5, 0xb2}},
+    {5473, 5, 4, {0xf0, 0x9d, 0x95, 0x8c}},
+    {5478, 8, 3, {0xe2, 0x86, 0x91}},
+    {5486, 11, 3, {0xe2, 0xa4, 0x92}},
+    {5497, 17, 3, {0xe2, 0x87, 0x85}},
+    {5514, 12, 3, {0xe2, 0x86, 0x95}},
+    {5526, 14, 3, {0xe2, 0xa5, 0xae}},
+    {5540, 6, 3, {0xe2, 0x8a, 0xa5}},
+    {5546, 11, 3, {0xe2, 0x86, 0xa5}},
+    {5557, 8, 3, {0xe2, 0x87, 0x91}},
+    {5565, 12, 3, {0xe2, 0x87, 0x95}},
+    {5577, 15, 3, {0xe2, 0x86, 0x96}},
+    {5592, 16, 3, {0xe2, 0x86, 0x97}},
+    {5608, 5, 2, {0xcf, 0x92}},
+    {5613, 8, 2, {0xce, 0xa5}},
+    {5621, 6, 2, {0xc5, 0xae}},
+    {5627, 5, 4, {0xf0, 0x9d, 0x92, 0xb0}},
+    {5632, 7, 2, {0xc5, 0xa8}},
+    {5639, 4, 2, {0xc3, 0x9c}},
+    {5643, 5, 2, {0xc3, 0x9c}},
+    {5648, 6, 3, {0xe2, 0x8a, 0xab}},
+    {5654, 5, 3, {0xe2, 0xab, 0xab}},
+    {5659, 4, 2, {0xd0, 0x92}},
+    {5663, 6, 3, {0xe2, 0x8a, 0xa9}},
+    {5669, 7, 3, {0xe2, 0xab, 0xa6}},
+    {5676, 4, 3, {0xe2, 0x8b, 0x81}},
+    {5680, 7, 3, {0xe2, 0x80, 0x96}},
+    {5687, 5, 3, {0xe2, 0x80, 0x96}},
+    {5692, 12, 3, {0xe2, 0x88, 0xa3}},
+    {5704, 13, 1, {0x7c}},
+    {5717, 18, 3, {0xe2, 0x9d, 0x98}},
+    {5735, 14, 3, {0xe2, 0x89, 0x80}},
+    {5749, 14, 3, {0xe2, 0x80, 0x8a}},
+    {5763, 4, 4, {0xf0, 0x9d, 0x94, 0x99}},
+    {5767, 5, 4, {0xf0, 0x9d, 0x95, 0x8d}},
+    {5772, 5, 4, {0xf0, 0x9d, 0x92, 0xb1}},
+    {5777, 7, 3, {0xe2, 0x8a, 0xaa}},
+    {5784, 6, 2, {0xc5, 0xb4}},
+    {5790, 6, 3, {0xe2, 0x8b, 0x80}},
+    {5796, 4, 4, {0xf0, 0x9d, 0x94, 0x9a}},
+    {5800, 5, 4, {0xf0, 0x9d, 0x95, 0x8e}},
+    {5805, 5, 4, {0xf0, 0x9d, 0x92, 0xb2}},
+    {5810, 4, 4, {0xf0, 0x9d, 0x94, 0x9b}},
+    {5814, 3, 2, {0xce, 0x9e}},
+    {5817, 5, 4, {0xf0, 0x9d, 0x95, 0x8f}},
+    {5822, 5, 4, {0xf0, 0x9d, 0x92, 0xb3}},
+    {5827, 5, 2, {0xd0, 0xaf}},
+    {5832, 5, 2, {0xd0, 0x87}},
+    {5837, 5, 2, {0xd0, 0xae}},
+    {5842, 6, 2, {0xc3, 0x9d}},
+    {5848, 7, 2, {0xc3, 0x9d}},
+    {5855, 6, 2, {0xc5, 0xb6}},
+    {5861, 4, 2, {0xd0, 0xab}},
+    {5865, 4, 4, {0xf0, 0x9d, 0x94, 0x9c}},
+    {5869, 5, 4, {0xf0, 0x9d, 0x95, 0x90}},
+    {5874, 5, 4, {0xf0, 0x9d, 0x92, 0xb4}},
+    {5879, 5, 2, {0xc5, 0xb8}},
+    {5884, 5, 2, {0xd0, 0x96}},
+    {5889, 7, 2, {0xc5, 0xb9}},
+    {5896, 7, 2, {0xc5, 0xbd}},
+    {5903, 4, 2, {0xd0, 0x97}},
+    {5907, 5, 2, {0xc5, 0xbb}},
+    {5912, 15, 3, {0xe2, 0x80, 0x8b}},
+    {5927, 5, 2, {0xce, 0x96}},
+    {5932, 4, 3, {0xe2, 0x84, 0xa8}},
+    {5936, 5, 3, {0xe2, 0x84, 0xa4}},
+    {5941, 5, 4, {0xf0, 0x9d, 0x92, 0xb5}},
+    {5946, 6, 2, {0xc3, 0xa1}},
+    {5952, 7, 2, {0xc3, 0xa1}},
+    {5959, 7, 2, {0xc4, 0x83}},
+    {5966, 3, 3, {0xe2, 0x88, 0xbe}},
+    {5969, 4, 5, {0xe2, 0x88, 0xbe, 0xcc, 0xb3}},
+    {5973, 4, 3, {0xe2, 0x88, 0xbf}},
+    {5977, 5, 2, {0xc3, 0xa2}},
+    {5982, 6, 2, {0xc3, 0xa2}},
+    {5988, 5, 2, {0xc2, 0xb4}},
+    {5993, 6, 2, {0xc2, 0xb4}},
+    {5999, 4, 2, {0xd0, 0xb0}},
+    {6003, 5, 2, {0xc3, 0xa6}},
+    {6008, 6, 2, {0xc3, 0xa6}},
+    {6014, 3, 3, {0xe2, 0x81, 0xa1}},
+    {6017, 4, 4, {0xf0, 0x9d, 0x94, 0x9e}},
+    {6021, 6, 2, {0xc3, 0xa0}},
+    {6027, 7, 2, {0xc3, 0xa0}},
+    {6034, 8, 3, {0xe2, 0x84, 0xb5}},
+    {6042, 6, 3, {0xe2, 0x84, 0xb5}},
+    {6048, 6, 2, {0xce, 0xb1}},
+    {6054, 6, 2, {0xc4, 0x81}},
+    {6060, 6, 3, {0xe2, 0xa8, 0xbf}},
+    {6066, 3, 1, {0x26}},
+    {6069, 4, 1, {0x26}},
+    {6073, 4, 3, {0xe2, 0x88, 0xa7}},
+    {6077, 7, 3, {0xe2, 0xa9, 0x95}},
+    {6084, 5, 3, {0xe2, 0xa9, 0x9c}},
+    {6089, 9, 3, {0xe2, 0xa9, 0x98}},
+    {6098, 5, 3, {0xe2, 0xa9, 0x9a}},
+    {6103, 4, 3, {0xe2, 0x88, 0xa0}},
+    {6107, 5, 3, {0xe2, 0xa6, 0xa4}},
+    {6112, 6, 3, {0xe2, 0x88, 0xa0}},
+    {6118, 7, 3, {0xe2, 0x88, 0xa1}},
+    {6125, 9, 3, {0xe2, 0xa6, 0xa8}},
+    {6134, 9, 3, {0xe2, 0xa6, 0xa9}},
+    {6143, 9, 3, {0xe2, 0xa6, 0xaa}},
+    {6152, 9, 3, {0xe2, 0xa6, 0xab}},
+    {6161, 9, 3, {0xe2, 0xa6, 0xac}},
+    {6170, 9, 3, {0xe2, 0xa6, 0xad}},
+    {6179, 9, 3, {0xe2, 0xa6, 0xae}},
+    {6188, 9, 3, {0xe2, 0xa6, 0xaf}},
+    {6197, 6, 3, {0xe2, 0x88, 0x9f}},
+    {6203, 8, 3, {0xe2, 0x8a, 0xbe}},
+    {6211, 9, 3, {0xe2, 0xa6, 0x9d}},
+    {6220, 7, 3, {0xe2, 0x88, 0xa2}},
+    {6227, 6, 2, {0xc3, 0x85}},
+    {6233, 8, 3, {0xe2, 0x8d, 0xbc}},
+    {6241, 6, 2, {0xc4, 0x85}},
+    {6247, 5, 4, {0xf0, 0x9d, 0x95, 0x92}},
+    {6252, 3, 3, {0xe2, 0x89, 0x88}},
+    {6255, 4, 3, {0xe2, 0xa9, 0xb0}},
+    {6259, 7, 3, {0xe2, 0xa9, 0xaf}},
+    {6266, 4, 3, {0xe2, 0x89, 0x8a}},
+    {6270, 5, 3, {0xe2, 0x89, 0x8b}},
+    {6275, 5, 1, {0x27}},
+    {6280, 7, 3, {0xe2, 0x89, 0x88}},
+    {6287, 9, 3, {0xe2, 0x89, 0x8a}},
+    {6296, 5, 2, {0xc3, 0xa5}},
+    {6301, 6, 2, {0xc3, 0xa5}},
+    {6307, 5, 4, {0xf0, 0x9d, 0x92, 0xb6}},
+    {6312, 4, 1, {0x2a}},
+    {6316, 6, 3, {0xe2, 0x89, 0x88}},
+    {6322, 8, 3, {0xe2, 0x89, 0x8d}},
+    {6330, 6, 2, {0xc3, 0xa3}},
+    {6336, 7, 2, {0xc3, 0xa3}},
+    {6343, 4, 2, {0xc3, 0xa4}},
+    {6347, 5, 2, {0xc3, 0xa4}},
+    {6352, 9, 3, {0xe2, 0x88, 0xb3}},
+    {6361, 6, 3, {0xe2, 0xa8, 0x91}},
+    {6367, 5, 3, {0xe2, 0xab, 0xad}},
+    {6372, 9, 3, {0xe2, 0x89, 0x8c}},
+    {6381, 12, 2, {0xcf, 0xb6}},
+    {6393, 10, 3, {0xe2, 0x80, 0xb5}},
+    {6403, 8, 3, {0xe2, 0x88, 0xbd}},
+    {6411, 10, 3, {0xe2, 0x8b, 0x8d}},
+    {6421, 7, 3, {0xe2, 0x8a, 0xbd}},
+    {6428, 7, 3, {0xe2, 0x8c, 0x85}},
+    {6435, 9, 3, {0xe2, 0x8c, 0x85}},
+    {6444, 5, 3, {0xe2, 0x8e, 0xb5}},
+    {6449, 9, 3, {0xe2, 0x8e, 0xb6}},
+    {6458, 6, 3, {0xe2, 0x89, 0x8c}},
+    {6464, 4, 2, {0xd0, 0xb1}},
+    {6468, 6, 3, {0xe2, 0x80, 0x9e}},
+    {6474, 7, 3, {0xe2, 0x88, 0xb5}},
+    {6481, 8, 3, {0xe2, 0x88, 0xb5}},
+    {6489, 8, 3, {0xe2, 0xa6, 0xb0}},
+    {6497, 6, 2, {0xcf, 0xb6}},
+    {6503, 7, 3, {0xe2, 0x84, 0xac}},
+    {6510, 5, 2, {0xce, 0xb2}},
+    {6515, 5, 3, {0xe2, 0x84, 0xb6}},
+    {6520, 8, 3, {0xe2, 0x89, 0xac}},
+    {6528, 4, 4, {0xf0, 0x9d, 0x94, 0x9f}},
+    {6532, 7, 3, {0xe2, 0x8b, 0x82}},
+    {6539, 8, 3, {0xe2, 0x97, 0xaf}},
+    {6547, 7, 3, {0xe2, 0x8b, 0x83}},
+    {6554, 8, 3, {0xe2, 0xa8, 0x80}},
+    {6562, 9, 3, {0xe2, 0xa8, 0x81}},
+    {6571, 10, 3, {0xe2, 0xa8, 0x82}},
+    {6581, 9, 3, {0xe2, 0xa8, 0x86}},
+    {6590, 8, 3, {0xe2, 0x98, 0x85}},
+    {6598, 16, 3, {0xe2, 0x96, 0xbd}},
+    {6614, 14, 3, {0xe2, 0x96, 0xb3}},
+    {6628, 9, 3, {0xe2, 0xa8, 0x84}},
+    {6637, 7, 3, {0xe2, 0x8b, 0x81}},
+    {6644, 9, 3, {0xe2, 0x8b, 0x80}},
+    {6653, 7, 3, {0xe2, 0xa4, 0x8d}},
+    {6660, 13, 3, {0xe2, 0xa7, 0xab}},
+    {6673, 12, 3, {0xe2, 0x96, 0xaa}},
+    {6685, 14, 3, {0xe2, 0x96, 0xb4}},
+    {6699, 18, 3, {0xe2, 0x96, 0xbe}},
+    {6717, 18, 3, {0xe2, 0x97, 0x82}},
+    {6735, 19, 3, {0xe2, 0x96, 0xb8}},
+    {6754, 6, 3, {0xe2, 0x90, 0xa3}},
+    {6760, 6, 3, {0xe2, 0x96, 0x92}},
+    {6766, 6, 3, {0xe2, 0x96, 0x91}},
+    {6772, 6, 3, {0xe2, 0x96, 0x93}},
+    {6778, 6, 3, {0xe2, 0x96, 0x88}},
+    {6784, 4, 4, {0x3d, 0xe2, 0x83, 0xa5}},
+    {6788, 8, 6, {0xe2, 0x89, 0xa1, 0xe2, 0x83, 0xa5}},
+    {6796, 5, 3, {0xe2, 0x8c, 0x90}},
+    {6801, 5, 4, {0xf0, 0x9d, 0x95, 0x93}},
+    {6806, 4, 3, {0xe2, 0x8a, 0xa5}},
+    {6810, 7, 3, {0xe2, 0x8a, 0xa5}},
+    {6817, 7, 3, {0xe2, 0x8b, 0x88}},
+    {6824, 6, 3, {0xe2, 0x95, 0x97}},
+    {6830, 6, 3, {0xe2, 0x95, 0x94}},
+    {6836, 6, 3, {0xe2, 0x95, 0x96}},
+    {6842, 6, 3, {0xe2, 0x95, 0x93}},
+    {6848, 5, 3, {0xe2, 0x95, 0x90}},
+    {6853, 6, 3, {0xe2, 0x95, 0xa6}},
+    {6859, 6, 3, {0xe2, 0x95, 0xa9}},
+    {6865, 6, 3, {0xe2, 0x95, 0xa4}},
+    {6871, 6, 3, {0xe2, 0x95, 0xa7}},
+    {6877, 6, 3, {0xe2, 0x95, 0x9d}},
+    {6883, 6, 3, {0xe2, 0x95, 0x9a}},
+    {6889, 6, 3, {0xe2, 0x95, 0x9c}},
+    {6895, 6, 3, {0xe2, 0x95, 0x99}},
+    {6901, 5, 3, {0xe2, 0x95, 0x91}},
+    {6906, 6, 3, {0xe2, 0x95, 0xac}},
+    {6912, 6, 3, {0xe2, 0x95, 0xa3}},
+    {6918, 6, 3, {0xe2, 0x95, 0xa0}},
+    {6924, 6, 3, {0xe2, 0x95, 0xab}},
+    {6930, 6, 3, {0xe2, 0x95, 0xa2}},
+    {6936, 6, 3, {0xe2, 0x95, 0x9f}},
+    {6942, 7, 3, {0xe2, 0xa7, 0x89}},
+    {6949, 6, 3, {0xe2, 0x95, 0x95}},
+    {6955, 6, 3, {0xe2, 0x95, 0x92}},
+    {6961, 6, 3, {0xe2, 0x94, 0x90}},
+    {6967, 6, 3, {0xe2, 0x94, 0x8c}},
+    {6973, 5, 3, {0xe2, 0x94, 0x80}},
+    {6978, 6, 3, {0xe2, 0x95, 0xa5}},
+    {6984, 6, 3, {0xe2, 0x95, 0xa8}},
+    {6990, 6, 3, {0xe2, 0x94, 0xac}},
+    {6996, 6, 3, {0xe2, 0x94, 0xb4}},
+    {7002, 9, 3, {0xe2, 0x8a, 0x9f}},
+    {7011, 8, 3, {0xe2, 0x8a, 0x9e}},
+    {7019, 9, 3, {0xe2, 0x8a, 0xa0}},
+    {7028, 6, 3, {0xe2, 0x95, 0x9b}},
+    {7034, 6, 3, {0xe2, 0x95, 0x98}},
+    {7040, 6, 3, {0xe2, 0x94, 0x98}},
+    {7046, 6, 3, {0xe2, 0x94, 0x94}},
+    {7052, 5, 3, {0xe2, 0x94, 0x82}},
+    {7057, 6, 3, {0xe2, 0x95, 0xaa}},
+    {7063, 6, 3, {0xe2, 0x95, 0xa1}},
+    {7069, 6, 3, {0xe2, 0x95, 0x9e}},
+    {7075, 6, 3, {0xe2, 0x94, 0xbc}},
+    {7081, 6, 3, {0xe2, 0x94, 0xa4}},
+    {7087, 6, 3, {0xe2, 0x94, 0x9c}},
+    {7093, 7, 3, {0xe2, 0x80, 0xb5}},
+    {7100, 6, 2, {0xcb, 0x98}},
+    {7106, 6, 2, {0xc2, 0xa6}},
+    {7112, 7, 2, {0xc2, 0xa6}},
+    {7119, 5, 4, {0xf0, 0x9d, 0x92, 0xb7}},
+    {7124, 6, 3, {0xe2, 0x81, 0x8f}},
+    {7130, 5, 3, {0xe2, 0x88, 0xbd}},
+    {7135, 6, 3, {0xe2, 0x8b, 0x8d}},
+    {7141, 5, 1, {0x5c}},
+    {7146, 6, 3, {0xe2, 0xa7, 0x85}},
+    {7152, 9, 3, {0xe2, 0x9f, 0x88}},
+    {7161, 5, 3, {0xe2, 0x80, 0xa2}},
+    {7166, 7, 3, {0xe2, 0x80, 0xa2}},
+    {7173, 5, 3, {0xe2, 0x89, 0x8e}},
+    {7178, 6, 3, {0xe2, 0xaa, 0xae}},
+    {7184, 6, 3, {0xe2, 0x89, 0x8f}},
+    {7190, 7, 3, {0xe2, 0x89, 0x8f}},
+    {7197, 7, 2, {0xc4, 0x87}},
+    {7204, 4, 3, {0xe2, 0x88, 0xa9}},
+    {7208, 7, 3, {0xe2, 0xa9, 0x84}},
+    {7215, 9, 3, {0xe2, 0xa9, 0x89}},
+    {7224, 7, 3, {0xe2, 0xa9, 0x8b}},
+    {7231, 7, 3, {0xe2, 0xa9, 0x87}},
+    {7238, 7, 3, {0xe2, 0xa9, 0x80}},
+    {7245, 5, 6, {0xe2, 0x88, 0xa9, 0xef, 0xb8, 0x80}},
+    {7250, 6, 3, {0xe2, 0x81, 0x81}},
+    {7256, 6, 2, {0xcb, 0x87}},
+    {7262, 6, 3, {0xe2, 0xa9, 0x8d}},
+    {7268, 7, 2, {0xc4, 0x8d}},
+    {7275, 6, 2, {0xc3, 0xa7}},
+    {7281, 7, 2, {0xc3, 0xa7}},
+    {7288, 6, 2, {0xc4, 0x89}},
+    {7294, 6, 3, {0xe2, 0xa9, 0x8c}},
+    {7300, 8, 3, {0xe2, 0xa9, 0x90}},
+    {7308, 5, 2, {0xc4, 0x8b}},
+    {7313, 5, 2, {0xc2, 0xb8}},
+    {7318, 6, 2, {0xc2, 0xb8}},
+    {7324, 8, 3, {0xe2, 0xa6, 0xb2}},
+    {7332, 4, 2, {0xc2, 0xa2}},
+    {7336, 5, 2, {0xc2, 0xa2}},
+    {7341, 10, 2, {0xc2, 0xb7}},
+    {7351, 4, 4, {0xf0, 0x9d, 0x94, 0xa0}},
+    {7355, 5, 2, {0xd1, 0x87}},
+    {7360, 6, 3, {0xe2, 0x9c, 0x93}},
+    {7366, 10, 3, {0xe2, 0x9c, 0x93}},
+    {7376, 4, 2, {0xcf, 0x87}},
+    {7380, 4, 3, {0xe2, 0x97, 0x8b}},
+    {7384, 5, 3, {0xe2, 0xa7, 0x83}},
+    {7389, 5, 2, {0xcb, 0x86}},
+    {7394, 7, 3, {0xe2, 0x89, 0x97}},
+    {7401, 16, 3, {0xe2, 0x86, 0xba}},
+    {7417, 17, 3, {0xe2, 0x86, 0xbb}},
+    {7434, 9, 2, {0xc2, 0xae}},
+    {7443, 9, 3, {0xe2, 0x93, 0x88}},
+    {7452, 11, 3, {0xe2, 0x8a, 0x9b}},
+    {7463, 12, 3, {0xe2, 0x8a, 0x9a}},
+    {7475, 12, 3, {0xe2, 0x8a, 0x9d}},
+    {7487, 5, 3, {0xe2, 0x89, 0x97}},
+    {7492, 9, 3, {0xe2, 0xa8, 0x90}},
+    {7501, 7, 3, {0xe2, 0xab, 0xaf}},
+    {7508, 8, 3, {0xe2, 0xa7, 0x82}},
+    {7516, 6, 3, {0xe2, 0x99, 0xa3}},
+    {7522, 9, 3, {0xe2, 0x99, 0xa3}},
+    {7531, 6, 1, {0x3a}},
+    {7537, 7, 3, {0xe2, 0x89, 0x94}},
+    {7544, 8, 3, {0xe2, 0x89, 0x94}},
+    {7552, 6, 1, {0x2c}},
+    {7558, 7, 1, {0x40}},
+    {7565, 5, 3, {0xe2, 0x88, 0x81}},
+    {7570, 7, 3, {0xe2, 0x88, 0x98}},
+    {7577, 11, 3, {0xe2, 0x88, 0x81}},
+    {7588, 10, 3, {0xe2, 0x84, 0x82}},
+    {7598, 5, 3, {0xe2, 0x89, 0x85}},
+    {7603, 8, 3, {0xe2, 0xa9, 0xad}},
+    {7611, 7, 3, {0xe2, 0x88, 0xae}},
+    {7618, 5, 4, {0xf0, 0x9d, 0x95, 0x94}},
+    {7623, 7, 3, {0xe2, 0x88, 0x90}},
+    {7630, 4, 2, {0xc2, 0xa9}},
+    {7634, 5, 2, {0xc2, 0xa9}},
+    {7639, 7, 3, {0xe2, 0x84, 0x97}},
+    {7646, 6, 3, {0xe2, 0x86, 0xb5}},
+    {7652, 6, 3, {0xe2, 0x9c, 0x97}},
+    {7658, 5, 4, {0xf0, 0x9d, 0x92, 0xb8}},
+    {7663, 5, 3, {0xe2, 0xab, 0x8f}},
+    {7668, 6, 3, {0xe2, 0xab, 0x91}},
+    {7674, 5, 3, {0xe2, 0xab, 0x90}},
+    {7679, 6, 3, {0xe2, 0xab, 0x92}},
+    {7685, 6, 3, {0xe2, 0x8b, 0xaf}},
+    {7691, 8, 3, {0xe2, 0xa4, 0xb8}},
+    {7699, 8, 3, {0xe2, 0xa4, 0xb5}},
+    {7707, 6, 3, {0xe2, 0x8b, 0x9e}},
+    {7713, 6, 3, {0xe2, 0x8b, 0x9f}},
+    {7719, 7, 3, {0xe2, 0x86, 0xb6}},
+    {7726, 8, 3, {0xe2, 0xa4, 0xbd}},
+    {7734, 4, 3, {0xe2, 0x88, 0xaa}},
+    {7738, 9, 3, {0xe2, 0xa9, 0x88}},
+    {7747, 7, 3, {0xe2, 0xa9, 0x86}},
+    {7754, 7, 3, {0xe2, 0xa9, 0x8a}},
+    {7761, 7, 3, {0xe2, 0x8a, 0x8d}},
+    {7768, 6, 3, {0xe2, 0xa9, 0x85}},
+    {7774, 5, 6, {0xe2, 0x88, 0xaa, 0xef, 0xb8, 0x80}},
+    {7779, 7, 3, {0xe2, 0x86, 0xb7}},
+    {7786, 8, 3, {0xe2, 0xa4, 0xbc}},
+    {7794, 12, 3, {0xe2, 0x8b, 0x9e}},
+    {7806, 12, 3, {0xe2, 0x8b, 0x9f}},
+    {7818, 9, 3, {0xe2, 0x8b, 0x8e}},
+    {7827, 11, 3, {0xe2, 0x8b, 0x8f}},
+    {7838, 6, 2, {0xc2, 0xa4}},
+    {7844, 7, 2, {0xc2, 0xa4}},
+    {7851, 15, 3, {0xe2, 0x86, 0xb6}},
+    {7866, 16, 3, {0xe2, 0x86, 0xb7}},
+    {7882, 6, 3, {0xe2, 0x8b, 0x8e}},
+    {7888, 6, 3, {0xe2, 0x8b, 0x8f}},
+    {7894, 9, 3, {0xe2, 0x88, 0xb2}},
+    {7903, 6, 3, {0xe2, 0x88, 0xb1}},
+    {7909, 7, 3, {0xe2, 0x8c, 0xad}},
+    {7916, 5, 3, {0xe2, 0x87, 0x93}},
+    {7921, 5, 3, {0xe2, 0xa5, 0xa5}},
+    {7926, 7, 3, {0xe2, 0x80, 0xa0}},
+    {7933, 7, 3, {0xe2, 0x84, 0xb8}},
+    {7940, 5, 3, {0xe2, 0x86, 0x93}},
+    {7945, 5, 3, {0xe2, 0x80, 0x90}},
+    {7950, 6, 3, {0xe2, 0x8a, 0xa3}},
+    {7956, 8, 3, {0xe2, 0xa4, 0x8f}},
+    {7964, 6, 2, {0xcb, 0x9d}},
+    {7970, 7, 2, {0xc4, 0x8f}},
+    {7977, 4, 2, {0xd0, 0xb4}},
+    {7981, 3, 3, {0xe2, 0x85, 0x86}},
+    {7984, 8, 3, {0xe2, 0x80, 0xa1}},
+    {7992, 6, 3, {0xe2, 0x87, 0x8a}},
+    {7998, 8, 3, {0xe2, 0xa9, 0xb7}},
+    {8006, 3, 2, {0xc2, 0xb0}},
+    {8009, 4, 2, {0xc2, 0xb0}},
+    {8013, 6, 2, {0xce, 0xb4}},
+    {8019, 8, 3, {0xe2, 0xa6, 0xb1}},
+    {8027, 7, 3, {0xe2, 0xa5, 0xbf}},
+    {8034, 4, 4, {0xf0, 0x9d, 0x94, 0xa1}},
+    {8038, 6, 3, {0xe2, 0x87, 0x83}},
+    {8044, 6, 3, {0xe2, 0x87, 0x82}},
+    {8050, 5, 3, {0xe2, 0x8b, 0x84}},
+    {8055, 8, 3, {0xe2, 0x8b, 0x84}},
+    {8063, 12, 3, {0xe2, 0x99, 0xa6}},
+    {8075, 6, 3, {0xe2, 0x99, 0xa6}},
+    {8081, 4, 2, {0xc2, 0xa8}},
+    {8085, 8, 2, {0xcf, 0x9d}},
+    {8093, 6, 3, {0xe2, 0x8b, 0xb2}},
+    {8099, 4, 2, {0xc3, 0xb7}},
+    {8103, 6, 2, {0xc3, 0xb7}},
+    {8109, 7, 2, {0xc3, 0xb7}},
+    {8116, 14, 3, {0xe2, 0x8b, 0x87}},
+    {8130, 7, 3, {0xe2, 0x8b, 0x87}},
+    {8137, 5, 2, {0xd1, 0x92}},
+    {8142, 7, 3, {0xe2, 0x8c, 0x9e}},
+    {8149, 7, 3, {0xe2, 0x8c, 0x8d}},
+    {8156, 7, 1, {0x24}},
+    {8163, 5, 4, {0xf0, 0x9d, 0x95, 0x95}},
+    {8168, 4, 2, {0xcb, 0x99}},
+    {8172, 6, 3, {0xe2, 0x89, 0x90}},
+    {8178, 9, 3, {0xe2, 0x89, 0x91}},
+    {8187, 9, 3, {0xe2, 0x88, 0xb8}},
+    {8196, 8, 3, {0xe2, 0x88, 0x94}},
+    {8204, 10, 3, {0xe2, 0x8a, 0xa1}},
+    {8214, 15, 3, {0xe2, 0x8c, 0x86}},
+    {8229, 10, 3, {0xe2, 0x86, 0x93}},
+    {8239, 15, 3, {0xe2, 0x87, 0x8a}},
+    {8254, 16, 3, {0xe2, 0x87, 0x83}},
+    {8270, 17, 3, {0xe2, 0x87, 0x82}},
+    {8287, 9, 3, {0xe2, 0xa4, 0x90}},
+    {8296, 7, 3, {0xe2, 0x8c, 0x9f}},
+    {8303, 7, 3, {0xe2, 0x8c, 0x8c}},
+    {8310, 5, 4, {0xf0, 0x9d, 0x92, 0xb9}},
+    {8315, 5, 2, {0xd1, 0x95}},
+    {8320, 5, 3, {0xe2, 0xa7, 0xb6}},
+    {8325, 7, 2, {0xc4, 0x91}},
+    {8332, 6, 3, {0xe2, 0x8b, 0xb1}},
+    {8338, 5, 3, {0xe2, 0x96, 0xbf}},
+    {8343, 6, 3, {0xe2, 0x96, 0xbe}},
+    {8349, 6, 3, {0xe2, 0x87, 0xb5}},
+    {8355, 6, 3, {0xe2, 0xa5, 0xaf}},
+    {8361, 8, 3, {0xe2, 0xa6, 0xa6}},
+    {8369, 5, 2, {0xd1, 0x9f}},
+    {8374, 9, 3, {0xe2, 0x9f, 0xbf}},
+    {8383, 6, 3, {0xe2, 0xa9, 0xb7}},
+    {8389, 5, 3, {0xe2, 0x89, 0x91}},
+    {8394, 6, 2, {0xc3, 0xa9}},
+    {8400, 7, 2, {0xc3, 0xa9}},
+    {8407, 7, 3, {0xe2, 0xa9, 0xae}},
+    {8414, 7, 2, {0xc4, 0x9b}},
+    {8421, 5, 3, {0xe2, 0x89, 0x96}},
+    {8426, 5, 2, {0xc3, 0xaa}},
+    {8431, 6, 2, {0xc3, 0xaa}},
+    {8437, 7, 3, {0xe2, 0x89, 0x95}},
+    {8444, 4, 2, {0xd1, 0x8d}},
+    {8448, 5, 2, {0xc4, 0x97}},
+    {8453, 3, 3, {0xe2, 0x85, 0x87}},
+    {8456, 6, 3, {0xe2, 0x89, 0x92}},
+    {8462, 4, 4, {0xf0, 0x9d, 0x94, 0xa2}},
+    {8466, 3, 3, {0xe2, 0xaa, 0x9a}},
+    {8469, 6, 2, {0xc3, 0xa8}},
+    {8475, 7, 2, {0xc3, 0xa8}},
+    {8482, 4, 3, {0xe2, 0xaa, 0x96}},
+    {8486, 7, 3, {0xe2, 0xaa, 0x98}},
+    {8493, 3, 3, {0xe2, 0xaa, 0x99}},
+    {8496, 9, 3, {0xe2, 0x8f, 0xa7}},
+    {8505, 4, 3, {0xe2, 0x84, 0x93}},
+    {8509, 4, 3, {0xe2, 0xaa, 0x95}},
+    {8513, 7, 3, {0xe2, 0xaa, 0x97}},
+    {8520, 6, 2, {0xc4, 0x93}},
+    {8526, 6, 3, {0xe2, 0x88, 0x85}},
+    {8532, 9, 3, {0xe2, 0x88, 0x85}},
+    {8541, 7, 3, {0xe2, 0x88, 0x85}},
+    {8548, 7, 3, {0xe2, 0x80, 0x84}},
+    {8555, 7, 3, {0xe2, 0x80, 0x85}},
+    {8562, 5, 3, {0xe2, 0x80, 0x83}},
+    {8567, 4, 2, {0xc5, 0x8b}},
+    {8571, 5, 3, {0xe2, 0x80, 0x82}},
+    {8576, 6, 2, {0xc4, 0x99}},
+    {8582, 5, 4, {0xf0, 0x9d, 0x95, 0x96}},
+    {8587, 5, 3, {0xe2, 0x8b, 0x95}},
+    {8592, 7, 3, {0xe2, 0xa7, 0xa3}},
+    {8599, 6, 3, {0xe2, 0xa9, 0xb1}},
+    {8605, 5, 2, {0xce, 0xb5}},
+    {8610, 8, 2, {0xce, 0xb5}},
+    {8618, 6, 2, {0xcf, 0xb5}},
+    {8624, 7, 3, {0xe2, 0x89, 0x96}},
+    {8631, 8, 3, {0xe2, 0x89, 0x95}},
+    {8639, 6, 3, {0xe2, 0x89, 0x82}},
+    {8645, 11, 3, {0xe2, 0xaa, 0x96}},
+    {8656, 12, 3, {0xe2, 0xaa, 0x95}},
+    {8668, 7, 1, {0x3d}},
+    {8675, 7, 3, {0xe2, 0x89, 0x9f}},
+    {8682, 6, 3, {0xe2, 0x89, 0xa1}},
+    {8688, 8, 3, {0xe2, 0xa9, 0xb8}},
+    {8696, 9, 3, {0xe2, 0xa7, 0xa5}},
+    {8705, 6, 3, {0xe2, 0x89, 0x93}},
+    {8711, 6, 3, {0xe2, 0xa5, 0xb1}},
+    {8717, 5, 3, {0xe2, 0x84, 0xaf}},
+    {8722, 6, 3, {0xe2, 0x89, 0x90}},
+    {8728, 5, 3, {0xe2, 0x89, 0x82}},
+    {8733, 4, 2, {0xce, 0xb7}},
+    {8737, 3, 2, {0xc3, 0xb0}},
+    {8740, 4, 2, {0xc3, 0xb0}},
+    {8744, 4, 2, {0xc3, 0xab}},
+    {8748, 5, 2, {0xc3, 0xab}},
+    {8753, 5, 3, {0xe2, 0x82, 0xac}},
+    {8758, 5, 1, {0x21}},
+    {8763, 6, 3, {0xe2, 0x88, 0x83}},
+    {8769, 12, 3, {0xe2, 0x84, 0xb0}},
+    {8781, 13, 3, {0xe2, 0x85, 0x87}},
+    {8794, 14, 3, {0xe2, 0x89, 0x92}},
+    {8808, 4, 2, {0xd1, 0x84}},
+    {8812, 7, 3, {0xe2, 0x99, 0x80}},
+    {8819, 7, 3, {0xef, 0xac, 0x83}},
+    {8826, 6, 3, {0xef, 0xac, 0x80}},
+    {8832, 7, 3, {0xef, 0xac, 0x84}},
+    {8839, 4, 4, {0xf0, 0x9d, 0x94, 0xa3}},
+    {8843, 6, 3, {0xef, 0xac, 0x81}},
+    {8849, 6, 2, {0x66, 0x6a}},
+    {8855, 5, 3, {0xe2, 0x99, 0xad}},
+    {8860, 6, 3, {0xef, 0xac, 0x82}},
+    {8866, 6, 3, {0xe2, 0x96, 0xb1}},
+    {8872, 5, 2, {0xc6, 0x92}},
+    {8877, 5, 4, {0xf0, 0x9d, 0x95, 0x97}},
+    {8882, 7, 3, {0xe2, 0x88, 0x80}},
+    {8889, 5, 3, {0xe2, 0x8b, 0x94}},
+    {8894, 6, 3, {0xe2, 0xab, 0x99}},
+    {8900, 9, 3, {0xe2, 0xa8, 0x8d}},
+    {8909, 6, 2, {0xc2, 0xbd}},
+    {8915, 7, 2, {0xc2, 0xbd}},
+    {8922, 7, 3, {0xe2, 0x85, 0x93}},
+    {8929, 6, 2, {0xc2, 0xbc}},
+    {8935, 7, 2, {0xc2, 0xbc}},
+    {8942, 7, 3, {0xe2, 0x85, 0x95}},
+    {8949, 7, 3, {0xe2, 0x85, 0x99}},
+    {8956, 7, 3, {0xe2, 0x85, 0x9b}},
+    {8963, 7, 3, {0xe2, 0x85, 0x94}},
+    {8970, 7, 3, {0xe2, 0x85, 0x96}},
+    {8977, 6, 2, {0xc2, 0xbe}},
+    {8983, 7, 2, {0xc2, 0xbe}},
+    {8990, 7, 3, {0xe2, 0x85, 0x97}},
+    {8997, 7, 3, {0xe2, 0x85, 0x9c}},
+    {9004, 7, 3, {0xe2, 0x85, 0x98}},
+    {9011, 7, 3, {0xe2, 0x85, 0x9a}},
+    {9018, 7, 3, {0xe2, 0x85, 0x9d}},
+    {9025, 7, 3, {0xe2, 0x85, 0x9e}},
+    {9032, 6, 3, {0xe2, 0x81, 0x84}},
+    {9038, 6, 3, {0xe2, 0x8c, 0xa2}},
+    {9044, 5, 4, {0xf0, 0x9d, 0x92, 0xbb}},
+    {9049, 3, 3, {0xe2, 0x89, 0xa7}},
+    {9052, 4, 3, {0xe2, 0xaa, 0x8c}},
+    {9056, 7, 2, {0xc7, 0xb5}},
+    {9063, 6, 2, {0xce, 0xb3}},
+    {9069, 7, 2, {0xcf, 0x9d}},
+    {9076, 4, 3, {0xe2, 0xaa, 0x86}},
+    {9080, 7, 2, {0xc4, 0x9f}},
+    {9087, 6, 2, {0xc4, 0x9d}},
+    {9093, 4, 2, {0xd0, 0xb3}},
+    {9097, 5, 2, {0xc4, 0xa1}},
+    {9102, 3, 3, {0xe2, 0x89, 0xa5}},
+    {9105, 4, 3, {0xe2, 0x8b, 0x9b}},
+    {9109, 4, 3, {0xe2, 0x89, 0xa5}},
+    {9113, 5, 3, {0xe2, 0x89, 0xa7}},
+    {9118, 9, 3, {0xe2, 0xa9, 0xbe}},
+    {9127, 4, 3, {0xe2, 0xa9, 0xbe}},
+    {9131, 6, 3, {0xe2, 0xaa, 0xa9}},
+    {9137, 7, 3, {0xe2, 0xaa, 0x80}},
+    {9144, 8, 3, {0xe2, 0xaa, 0x82}},
+    {9152, 9, 3, {0xe2, 0xaa, 0x84}},
+    {9161, 5, 6, {0xe2, 0x8b, 0x9b, 0xef, 0xb8, 0x80}},
+    {9166, 7, 3, {0xe2, 0xaa, 0x94}},
+    {9173, 4, 4, {0xf0, 0x9d, 0x94, 0xa4}},
+    {9177, 3, 3, {0xe2, 0x89, 0xab}},
+    {9180, 4, 3, {0xe2, 0x8b, 0x99}},
+    {9184, 6, 3, {0xe2, 0x84, 0xb7}},
+    {9190, 5, 2, {0xd1, 0x93}},
+    {9195, 3, 3, {0xe2, 0x89, 0xb7}},
+    {9198, 4, 3, {0xe2, 0xaa, 0x92}},
+    {9202, 4, 3, {0xe2, 0xaa, 0xa5}},
+    {9206, 4, 3, {0xe2, 0xaa, 0xa4}},
+    {9210, 4, 3, {0xe2, 0x89, 0xa9}},
+    {9214, 5, 3, {0xe2, 0xaa, 0x8a}},
+    {9219, 9, 3, {0xe2, 0xaa, 0x8a}},
+    {9228, 4, 3, {0xe2, 0xaa, 0x88}},
+    {9232, 5, 3, {0xe2, 0xaa, 0x88}},
+    {9237, 6, 3, {0xe2, 0x89, 0xa9}},
+    {9243, 6, 3, {0xe2, 0x8b, 0xa7}},
+    {9249, 5, 4, {0xf0, 0x9d, 0x95, 0x98}},
+    {9254, 6, 1, {0x60}},
+    {9260, 5, 3, {0xe2, 0x84, 0x8a}},
+    {9265, 5, 3, {0xe2, 0x89, 0xb3}},
+    {9270, 6, 3, {0xe2, 0xaa, 0x8e}},
+    {9276, 6, 3, {0xe2, 0xaa, 0x90}},
+    {9282, 2, 1, {0x3e}},
+    {9284, 3, 1, {0x3e}},
+    {9287, 5, 3, {0xe2, 0xaa, 0xa7}},
+    {9292, 6, 3, {0xe2, 0xa9, 0xba}},
+    {9298, 6, 3, {0xe2, 0x8b, 0x97}},
+    {9304, 7, 3, {0xe2, 0xa6, 0x95}},
+    {9311, 8, 3, {0xe2, 0xa9, 0xbc}},
+    {9319, 10, 3, {0xe2, 0xaa, 0x86}},
+    {9329, 7, 3, {0xe2, 0xa5, 0xb8}},
+    {9336, 7, 3, {0xe2, 0x8b, 0x97}},
+    {9343, 10, 3, {0xe2, 0x8b, 0x9b}},
+    {9353, 11, 3, {0xe2, 0xaa, 0x8c}},
+    {9364, 8, 3, {0xe2, 0x89, 0xb7}},
+    {9372, 7, 3, {0xe2, 0x89, 0xb3}},
+    {9379, 10, 6, {0xe2, 0x89, 0xa9, 0xef, 0xb8, 0x80}},
+    {9389, 5, 6, {0xe2, 0x89, 0xa9, 0xef, 0xb8, 0x80}},
+    {9394, 5, 3, {0xe2, 0x87, 0x94}},
+    {9399, 7, 3, {0xe2, 0x80, 0x8a}},
+    {9406, 5, 2, {0xc2, 0xbd}},
+    {9411, 7, 3, {0xe2, 0x84, 0x8b}},
+    {9418, 7, 2, {0xd1, 0x8a}},
+    {9425, 5, 3, {0xe2, 0x86, 0x94}},
+    {9430, 8, 3, {0xe2, 0xa5, 0x88}},
+    {9438, 6, 3, {0xe2, 0x86, 0xad}},
+    {9444, 5, 3, {0xe2, 0x84, 0x8f}},
+    {9449, 6, 2, {0xc4, 0xa5}},
+    {9455, 7, 3, {0xe2, 0x99, 0xa5}},
+    {9462, 10, 3, {0xe2, 0x99, 0xa5}},
+    {9472, 7, 3, {0xe2, 0x80, 0xa6}},
+    {9479, 7, 3, {0xe2, 0x8a, 0xb9}},
+    {9486, 4, 4, {0xf0, 0x9d, 0x94, 0xa5}},
+    {9490, 9, 3, {0xe2, 0xa4, 0xa5}},
+    {9499, 9, 3, {0xe2, 0xa4, 0xa6}},
+    {9508, 6, 3, {0xe2, 0x87, 0xbf}},
+    {9514, 7, 3, {0xe2, 0x88, 0xbb}},
+    {9521, 14, 3, {0xe2, 0x86, 0xa9}},
+    {9535, 15, 3, {0xe2, 0x86, 0xaa}},
+    {9550, 5, 4, {0xf0, 0x9d, 0x95, 0x99}},
+    {9555, 7, 3, {0xe2, 0x80, 0x95}},
+    {9562, 5, 4, {0xf0, 0x9d, 0x92, 0xbd}},
+    {9567, 7, 3, {0xe2, 0x84, 0x8f}},
+    {9574, 7, 2, {0xc4, 0xa7}},
+    {9581, 7, 3, {0xe2, 0x81, 0x83}},
+    {9588, 7, 3, {0xe2, 0x80, 0x90}},
+    {9595, 6, 2, {0xc3, 0xad}},
+    {9601, 7, 2, {0xc3, 0xad}},
+    {9608, 3, 3, {0xe2, 0x81, 0xa3}},
+    {9611, 5, 2, {0xc3, 0xae}},
+    {9616, 6, 2, {0xc3, 0xae}},
+    {9622, 4, 2, {0xd0, 0xb8}},
+    {9626, 5, 2, {0xd0, 0xb5}},
+    {9631, 5, 2, {0xc2, 0xa1}},
+    {9636, 6, 2, {0xc2, 0xa1}},
+    {9642, 4, 3, {0xe2, 0x87, 0x94}},
+    {9646, 4, 4, {0xf0, 0x9d, 0x94, 0xa6}},
+    {9650, 6, 2, {0xc3, 0xac}},
+    {9656, 7, 2, {0xc3, 0xac}},
+    {9663, 3, 3, {0xe2, 0x85, 0x88}},
+    {9666, 7, 3, {0xe2, 0xa8, 0x8c}},
+    {9673, 6, 3, {0xe2, 0x88, 0xad}},
+    {9679, 7, 3, {0xe2, 0xa7, 0x9c}},
+    {9686, 6, 3, {0xe2, 0x84, 0xa9}},
+    {9692, 6, 2, {0xc4, 0xb3}},
+    {9698, 6, 2, {0xc4, 0xab}},
+    {9704, 6, 3, {0xe2, 0x84, 0x91}},
+    {9710, 9, 3, {0xe2, 0x84, 0x90}},
+    {9719, 9, 3, {0xe2, 0x84, 0x91}},
+    {9728, 6, 2, {0xc4, 0xb1}},
+    {9734, 5, 3, {0xe2, 0x8a, 0xb7}},
+    {9739, 6, 2, {0xc6, 0xb5}},
+    {9745, 3, 3, {0xe2, 0x88, 0x88}},
+    {9748, 7, 3, {0xe2, 0x84, 0x85}},
+    {9755, 6, 3, {0xe2, 0x88, 0x9e}},
+    {9761, 9, 3, {0xe2, 0xa7, 0x9d}},
+    {9770, 7, 2, {0xc4, 0xb1}},
+    {9777, 4, 3, {0xe2, 0x88, 0xab}},
+    {9781, 7, 3, {0xe2, 0x8a, 0xba}},
+    {9788, 9, 3, {0xe2, 0x84, 0xa4}},
+    {9797, 9, 3, {0xe2, 0x8a, 0xba}},
+    {9806, 9, 3, {0xe2, 0xa8, 0x97}},
+    {9815, 8, 3, {0xe2, 0xa8, 0xbc}},
+    {9823, 5, 2, {0xd1, 0x91}},
+    {9828, 6, 2, {0xc4, 0xaf}},
+    {9834, 5, 4, {0xf0, 0x9d, 0x95, 0x9a}},
+    {9839, 5, 2, {0xce, 0xb9}},
+    {9844, 6, 3, {0xe2, 0xa8, 0xbc}},
+    {9850, 6, 2, {0xc2, 0xbf}},
+    {9856, 7, 2, {0xc2, 0xbf}},
+    {9863, 5, 4, {0xf0, 0x9d, 0x92, 0xbe}},
+    {9868, 5, 3, {0xe2, 0x88, 0x88}},
+    {9873, 6, 3, {0xe2, 0x8b, 0xb9}},
+    {9879, 8, 3, {0xe2, 0x8b, 0xb5}},
+    {9887, 6, 3, {0xe2, 0x8b, 0xb4}},
+    {9893, 7, 3, {0xe2, 0x8b, 0xb3}},
+    {9900, 6, 3, {0xe2, 0x88, 0x88}},
+    {9906, 3, 3, {0xe2, 0x81, 0xa2}},
+    {9909, 7, 2, {0xc4, 0xa9}},
+    {9916, 6, 2, {0xd1, 0x96}},
+    {9922, 4, 2, {0xc3, 0xaf}},
+    {9926, 5, 2, {0xc3, 0xaf}},
+    {9931, 6, 2, {0xc4, 0xb5}},
+    {9937, 4, 2, {0xd0, 0xb9}},
+    {9941, 4, 4, {0xf0, 0x9d, 0x94, 0xa7}},
+    {9945, 6, 2, {0xc8, 0xb7}},
+    {9951, 5, 4, {0xf0, 0x9d, 0x95, 0x9b}},
+    {9956, 5, 4, {0xf0, 0x9d, 0x92, 0xbf}},
+    {9961, 7, 2, {0xd1, 0x98}},
+    {9968, 6, 2, {0xd1, 0x94}},
+    {9974, 6, 2, {0xce, 0xba}},
+    {9980, 7, 2, {0xcf, 0xb0}},
+    {9987, 7, 2, {0xc4, 0xb7}},
+    {9994, 4, 2, {0xd0, 0xba}},
+    {9998, 4, 4, {0xf0, 0x9d, 0x94, 0xa8}},
+    {10002, 7, 2, {0xc4, 0xb8}},
+    {10009, 5, 2, {0xd1, 0x85}},
+    {10014, 5, 2, {0xd1, 0x9c}},
+    {10019, 5, 4, {0xf0, 0x9d, 0x95, 0x9c}},
+    {10024, 5, 4, {0xf0, 0x9d, 0x93, 0x80}},
+    {10029, 6, 3, {0xe2, 0x87, 0x9a}},
+    {10035, 5, 3, {0xe2, 0x87, 0x90}},
+    {10040, 7, 3, {0xe2, 0xa4, 0x9b}},
+    {10047, 6, 3, {0xe2, 0xa4, 0x8e}},
+    {10053, 3, 3, {0xe2, 0x89, 0xa6}},
+    {10056, 4, 3, {0xe2, 0xaa, 0x8b}},
+    {10060, 5, 3, {0xe2, 0xa5, 0xa2}},
+    {10065, 7, 2, {0xc4, 0xba}},
+    {10072, 9, 3, {0xe2, 0xa6, 0xb4}},
+    {10081, 7, 3, {0xe2, 0x84, 0x92}},
+    {10088, 7, 2, {0xce, 0xbb}},
+    {10095, 5, 3, {0xe2, 0x9f, 0xa8}},
+    {10100, 6, 3, {0xe2, 0xa6, 0x91}},
+    {10106, 7, 3, {0xe2, 0x9f, 0xa8}},
+    {10113, 4, 3, {0xe2, 0xaa, 0x85}},
+    {10117, 5, 2, {0xc2, 0xab}},
+    {10122, 6, 2, {0xc2, 0xab}},
+    {10128, 5, 3, {0xe2, 0x86, 0x90}},
+    {10133, 6, 3, {0xe2, 0x87, 0xa4}},
+    {10139, 8, 3, {0xe2, 0xa4, 0x9f}},
+    {10147, 7, 3, {0xe2, 0xa4, 0x9d}},
+    {10154, 7, 3, {0xe2, 0x86, 0xa9}},
+    {10161, 7, 3, {0xe2, 0x86, 0xab}},
+    {10168, 7, 3, {0xe2, 0xa4, 0xb9}},
+    {10175, 8, 3, {0xe2, 0xa5, 0xb3}},
+    {10183, 7, 3, {0xe2, 0x86, 0xa2}},
+    {10190, 4, 3, {0xe2, 0xaa, 0xab}},
+    {10194, 7, 3, {0xe2, 0xa4, 0x99}},
+    {10201, 5, 3, {0xe2, 0xaa, 0xad}},
+    {10206, 6, 6, {0xe2, 0xaa, 0xad, 0xef, 0xb8, 0x80}},
+    {10212, 6, 3, {0xe2, 0xa4, 0x8c}},
+    {10218, 6, 3, {0xe2, 0x9d, 0xb2}},
+    {10224, 7, 1, {0x7b}},
+    {10231, 7, 1, {0x5b}},
+    {10238, 6, 3, {0xe2, 0xa6, 0x8b}},
+    {10244, 8, 3, {0xe2, 0xa6, 0x8f}},
+    {10252, 8, 3, {0xe2, 0xa6, 0x8d}},
+    {10260, 7, 2, {0xc4, 0xbe}},
+    {10267, 7, 2, {0xc4, 0xbc}},
+    {10274, 6, 3, {0xe2, 0x8c, 0x88}},
+    {10280, 5, 1, {0x7b}},
+    {10285, 4, 2, {0xd0, 0xbb}},
+    {10289, 5, 3, {0xe2, 0xa4, 0xb6}},
+    {10294, 6, 3, {0xe2, 0x80, 0x9c}},
+    {10300, 7, 3, {0xe2, 0x80, 0x9e}},
+    {10307, 8, 3, {0xe2, 0xa5, 0xa7}},
+    {10315, 9, 3, {0xe2, 0xa5, 0x8b}},
+    {10324, 5, 3, {0xe2, 0x86, 0xb2}},
+    {10329, 3, 3, {0xe2, 0x89, 0xa4}},
+    {10332, 10, 3, {0xe2, 0x86, 0x90}},
+    {10342, 14, 3, {0xe2, 0x86, 0xa2}},
+    {10356, 16, 3, {0xe2, 0x86, 0xbd}},
+    {10372, 14, 3, {0xe2, 0x86, 0xbc}},
+    {10386, 15, 3, {0xe2, 0x87, 0x87}},
+    {10401, 15, 3, {0xe2, 0x86, 0x94}},
+    {10416, 16, 3, {0xe2, 0x87, 0x86}},
+    {10432, 18, 3, {0xe2, 0x87, 0x8b}},
+    {10450, 20, 3, {0xe2, 0x86, 0xad}},
+    {10470, 15, 3, {0xe2, 0x8b, 0x8b}},
+    {10485, 4, 3, {0xe2, 0x8b, 0x9a}},
+    {10489, 4, 3, {0xe2, 0x89, 0xa4}},
+    {10493, 5, 3, {0xe2, 0x89, 0xa6}},
+    {10498, 9, 3, {0xe2, 0xa9, 0xbd}},
+    {10507, 4, 3, {0xe2, 0xa9, 0xbd}},
+    {10511, 6, 3, {0xe2, 0xaa, 0xa8}},
+    {10517, 7, 3, {0xe2, 0xa9, 0xbf}},
+    {10524, 8, 3, {0xe2, 0xaa, 0x81}},
+    {10532, 9, 3, {0xe2, 0xaa, 0x83}},
+    {10541, 5, 6, {0xe2, 0x8b, 0x9a, 0xef, 0xb8, 0x80}},
+    {10546, 7, 3, {0xe2, 0xaa, 0x93}},
+    {10553, 11, 3, {0xe2, 0xaa, 0x85}},
+    {10564, 8, 3, {0xe2, 0x8b, 0x96}},
+    {10572, 10, 3, {0xe2, 0x8b, 0x9a}},
+    {10582, 11, 3, {0xe2, 0xaa, 0x8b}},
+    {10593, 8, 3, {0xe2, 0x89, 0xb6}},
+    {10601, 8, 3, {0xe2, 0x89, 0xb2}},
+    {10609, 7, 3, {0xe2, 0xa5, 0xbc}},
+    {10616, 7, 3, {0xe2, 0x8c, 0x8a}},
+    {10623, 4, 4, {0xf0, 0x9d, 0x94, 0xa9}},
+    {10627, 3, 3, {0xe2, 0x89, 0xb6}},
+    {10630, 4, 3, {0xe2, 0xaa, 0x91}},
+    {10634, 6, 3, {0xe2, 0x86, 0xbd}},
+    {10640, 6, 3, {0xe2, 0x86, 0xbc}},
+    {10646, 7, 3, {0xe2, 0xa5, 0xaa}},
+    {10653, 6, 3, {0xe2, 0x96, 0x84}},
+    {10659, 5, 2, {0xd1, 0x99}},
+    {10664, 3, 3, {0xe2, 0x89, 0xaa}},
+    {10667, 6, 3, {0xe2, 0x87, 0x87}},
+    {10673, 9, 3, {0xe2, 0x8c, 0x9e}},
+    {10682, 7, 3, {0xe2, 0xa5, 0xab}},
+    {10689, 6, 3, {0xe2, 0x97, 0xba}},
+    {10695, 7, 2, {0xc5, 0x80}},
+    {10702, 7, 3, {0xe2, 0x8e, 0xb0}},
+    {10709, 11, 3, {0xe2, 0x8e, 0xb0}},
+    {10720, 4, 3, {0xe2, 0x89, 0xa8}},
+    {10724, 5, 3, {0xe2, 0xaa, 0x89}},
+    {10729, 9, 3, {0xe2, 0xaa, 0x89}},
+    {10738, 4, 3, {0xe2, 0xaa, 0x87}},
+    {10742, 5, 3, {0xe2, 0xaa, 0x87}},
+    {10747, 6, 3, {0xe2, 0x89, 0xa8}},
+    {10753, 6, 3, {0xe2, 0x8b, 0xa6}},
+    {10759, 6, 3, {0xe2, 0x9f, 0xac}},
+    {10765, 6, 3, {0xe2, 0x87, 0xbd}},
+    {10771, 6, 3, {0xe2, 0x9f, 0xa6}},
+    {10777, 14, 3, {0xe2, 0x9f, 0xb5}},
+    {10791, 19, 3, {0xe2, 0x9f, 0xb7}},
+    {10810, 11, 3, {0xe2, 0x9f, 0xbc}},
+    {10821, 15, 3, {0xe2, 0x9f, 0xb6}},
+    {10836, 14, 3, {0xe2, 0x86, 0xab}},
+    {10850, 15, 3, {0xe2, 0x86, 0xac}},
+    {10865, 6, 3, {0xe2, 0xa6, 0x85}},
+    {10871, 5, 4, {0xf0, 0x9d, 0x95, 0x9d}},
+    {10876, 7, 3, {0xe2, 0xa8, 0xad}},
+    {10883, 8, 3, {0xe2, 0xa8, 0xb4}},
+    {10891, 7, 3, {0xe2, 0x88, 0x97}},
+    {10898, 7, 1, {0x5f}},
+    {10905, 4, 3, {0xe2, 0x97, 0x8a}},
+    {10909, 8, 3, {0xe2, 0x97, 0x8a}},
+    {10917, 5, 3, {0xe2, 0xa7, 0xab}},
+    {10922, 5, 1, {0x28}},
+    {10927, 7, 3, {0xe2, 0xa6, 0x93}},
+    {10934, 6, 3, {0xe2, 0x87, 0x86}},
+    {10940, 9, 3, {0xe2, 0x8c, 0x9f}},
+    {10949, 6, 3, {0xe2, 0x87, 0x8b}},
+    {10955, 7, 3, {0xe2, 0xa5, 0xad}},
+    {10962, 4, 3, {0xe2, 0x80, 0x8e}},
+    {10966, 6, 3, {0xe2, 0x8a, 0xbf}},
+    {10972, 7, 3, {0xe2, 0x80, 0xb9}},
+    {10979, 5, 4, {0xf0, 0x9d, 0x93, 0x81}},
+    {10984, 4, 3, {0xe2, 0x86, 0xb0}},
+    {10988, 5, 3, {0xe2, 0x89, 0xb2}},
+    {10993, 6, 3, {0xe2, 0xaa, 0x8d}},
+    {10999, 6, 3, {0xe2, 0xaa, 0x8f}},
+    {11005, 5, 1, {0x5b}},
+    {11010, 6, 3, {0xe2, 0x80, 0x98}},
+    {11016, 7, 3, {0xe2, 0x80, 0x9a}},
+    {11023, 7, 2, {0xc5, 0x82}},
+    {11030, 2, 1, {0x3c}},
+    {11032, 3, 1, {0x3c}},
+    {11035, 5, 3, {0xe2, 0xaa, 0xa6}},
+    {11040, 6, 3, {0xe2, 0xa9, 0xb9}},
+    {11046, 6, 3, {0xe2, 0x8b, 0x96}},
+    {11052, 7, 3, {0xe2, 0x8b, 0x8b}},
+    {11059, 7, 3, {0xe2, 0x8b, 0x89}},
+    {11066, 7, 3, {0xe2, 0xa5, 0xb6}},
+    {11073, 8, 3, {0xe2, 0xa9, 0xbb}},
+    {11081, 7, 3, {0xe2, 0xa6, 0x96}},
+    {11088, 5, 3, {0xe2, 0x97, 0x83}},
+    {11093, 6, 3, {0xe2, 0x8a, 0xb4}},
+    {11099, 6, 3, {0xe2, 0x97, 0x82}},
+    {11105, 9, 3, {0xe2, 0xa5, 0x8a}},
+    {11114, 8, 3, {0xe2, 0xa5, 0xa6}},
+    {11122, 10, 6, {0xe2, 0x89, 0xa8, 0xef, 0xb8, 0x80}},
+    {11132, 5, 6, {0xe2, 0x89, 0xa8, 0xef, 0xb8, 0x80}},
+    {11137, 6, 3, {0xe2, 0x88, 0xba}},
+    {11143, 4, 2, {0xc2, 0xaf}},
+    {11147, 5, 2, {0xc2, 0xaf}},
+    {11152, 5, 3, {0xe2, 0x99, 0x82}},
+    {11157, 5, 3, {0xe2, 0x9c, 0xa0}},
+    {11162, 8, 3, {0xe2, 0x9c, 0xa0}},
+    {11170, 4, 3, {0xe2, 0x86, 0xa6}},
+    {11174, 7, 3, {0xe2, 0x86, 0xa6}},
+    {11181, 11, 3, {0xe2, 0x86, 0xa7}},
+    {11192, 11, 3, {0xe2, 0x86, 0xa4}},
+    {11203, 9, 3, {0xe2, 0x86, 0xa5}},
+    {11212, 7, 3, {0xe2, 0x96, 0xae}},
+    {11219, 7, 3, {0xe2, 0xa8, 0xa9}},
+    {11226, 4, 2, {0xd0, 0xbc}},
+    {11230, 6, 3, {0xe2, 0x80, 0x94}},
+    {11236, 14, 3, {0xe2, 0x88, 0xa1}},
+    {11250, 4, 4, {0xf0, 0x9d, 0x94, 0xaa}},
+    {11254, 4, 3, {0xe2, 0x84, 0xa7}},
+    {11258, 5, 2, {0xc2, 0xb5}},
+    {11263, 6, 2, {0xc2, 0xb5}},
+    {11269, 4, 3, {0xe2, 0x88, 0xa3}},
+    {11273, 7, 1, {0x2a}},
+    {11280, 7, 3, {0xe2, 0xab, 0xb0}},
+    {11287, 6, 2, {0xc2, 0xb7}},
+    {11293, 7, 2, {0xc2, 0xb7}},
+    {11300, 6, 3, {0xe2, 0x88, 0x92}},
+    {11306, 7, 3, {0xe2, 0x8a, 0x9f}},
+    {11313, 7, 3, {0xe2, 0x88, 0xb8}},
+    {11320, 8, 3, {0xe2, 0xa8, 0xaa}},
+    {11328, 5, 3, {0xe2, 0xab, 0x9b}},
+    {11333, 5, 3, {0xe2, 0x80, 0xa6}},
+    {11338, 7, 3, {0xe2, 0x88, 0x93}},
+    {11345, 7, 3, {0xe2, 0x8a, 0xa7}},
+    {11352, 5, 4, {0xf0, 0x9d, 0x95, 0x9e}},
+    {11357, 3, 3, {0xe2, 0x88, 0x93}},
+    {11360, 5, 4, {0xf0, 0x9d, 0x93, 0x82}},
+    {11365, 7, 3, {0xe2, 0x88, 0xbe}},
+    {11372, 3, 2, {0xce, 0xbc}},
+    {11375, 9, 3, {0xe2, 0x8a, 0xb8}},
+    {11384, 6, 3, {0xe2, 0x8a, 0xb8}},
+    {11390, 4, 5, {0xe2, 0x8b, 0x99, 0xcc, 0xb8}},
+    {11394, 4, 6, {0xe2, 0x89, 0xab, 0xe2, 0x83, 0x92}},
+    {11398, 5, 5, {0xe2, 0x89, 0xab, 0xcc, 0xb8}},
+    {11403, 11, 3, {0xe2, 0x87, 0x8d}},
+    {11414, 16, 3, {0xe2, 0x87, 0x8e}},
+    {11430, 4, 5, {0xe2, 0x8b, 0x98, 0xcc, 0xb8}},
+    {11434, 4, 6, {0xe2, 0x89, 0xaa, 0xe2, 0x83, 0x92}},
+    {11438, 5, 5, {0xe2, 0x89, 0xaa, 0xcc, 0xb8}},
+    {11443, 12, 3, {0xe2, 0x87, 0x8f}},
+    {11455, 7, 3, {0xe2, 0x8a, 0xaf}},
+    {11462, 7, 3, {0xe2, 0x8a, 0xae}},
+    {11469, 6, 3, {0xe2, 0x88, 0x87}},
+    {11475, 7, 2, {0xc5, 0x84}},
+    {11482, 5, 6, {0xe2, 0x88, 0xa0, 0xe2, 0x83, 0x92}},
+    {11487, 4, 3, {0xe2, 0x89, 0x89}},
+    {11491, 5, 5, {0xe2, 0xa9, 0xb0, 0xcc, 0xb8}},
+    {11496, 6, 5, {0xe2, 0x89, 0x8b, 0xcc, 0xb8}},
+    {11502, 6, 2, {0xc5, 0x89}},
+    {11508, 8, 3, {0xe2, 0x89, 0x89}},
+    {11516, 6, 3, {0xe2, 0x99, 0xae}},
+    {11522, 8, 3, {0xe2, 0x99, 0xae}},
+    {11530, 9, 3, {0xe2, 0x84, 0x95}},
+    {11539, 4, 2, {0xc2, 0xa0}},
+    {11543, 5, 2, {0xc2, 0xa0}},
+    {11548, 6, 5, {0xe2, 0x89, 0x8e, 0xcc, 0xb8}},
+    {11554, 7, 5, {0xe2, 0x89, 0x8f, 0xcc, 0xb8}},
+    {11561, 5, 3, {0xe2, 0xa9, 0x83}},
+    {11566, 7, 2, {0xc5, 0x88}},
+    {11573, 7, 2, {0xc5, 0x86}},
+    {11580, 6, 3, {0xe2, 0x89, 0x87}},
+    {11586, 9, 5, {0xe2, 0xa9, 0xad, 0xcc, 0xb8}},
+    {11595, 5, 3, {0xe2, 0xa9, 0x82}},
+    {11600, 4, 2, {0xd0, 0xbd}},
+    {11604, 6, 3, {0xe2, 0x80, 0x93}},
+    {11610, 3, 3, {0xe2, 0x89, 0xa0}},
+    {11613, 6, 3, {0xe2, 0x87, 0x97}},
+    {11619, 7, 3, {0xe2, 0xa4, 0xa4}},
+    {11626, 6, 3, {0xe2, 0x86, 0x97}},
+    {11632, 8, 3, {0xe2, 0x86, 0x97}},
+    {11640, 6, 5, {0xe2, 0x89, 0x90, 0xcc, 0xb8}},
+    {11646, 7, 3, {0xe2, 0x89, 0xa2}},
+    {11653, 7, 3, {0xe2, 0xa4, 0xa8}},
+    {11660, 6, 5, {0xe2, 0x89, 0x82, 0xcc, 0xb8}},
+    {11666, 7, 3, {0xe2, 0x88, 0x84}},
+    {11673, 8, 3, {0xe2, 0x88, 0x84}},
+    {11681, 4, 4, {0xf0, 0x9d, 0x94, 0xab}},
+    {11685, 4, 5, {0xe2, 0x89, 0xa7, 0xcc, 0xb8}},
+    {11689, 4, 3, {0xe2, 0x89, 0xb1}},
+    {11693, 5, 3, {0xe2, 0x89, 0xb1}},
+    {11698, 6, 5, {0xe2, 0x89, 0xa7, 0xcc, 0xb8}},
+    {11704, 10, 5, {0xe2, 0xa9, 0xbe, 0xcc, 0xb8}},
+    {11714, 5, 5, {0xe2, 0xa9, 0xbe, 0xcc, 0xb8}},
+    {11719, 6, 3, {0xe2, 0x89, 0xb5}},
+    {11725, 4, 3, {0xe2, 0x89, 0xaf}},
+    {11729, 5, 3, {0xe2, 0x89, 0xaf}},
+    {11734, 6, 3, {0xe2, 0x87, 0x8e}},
+    {11740, 6, 3, {0xe2, 0x86, 0xae}},
+    {11746, 6, 3, {0xe2, 0xab, 0xb2}},
+    {11752, 3, 3, {0xe2, 0x88, 0x8b}},
+    {11755, 4, 3, {0xe2, 0x8b, 0xbc}},
+    {11759, 5, 3, {0xe2, 0x8b, 0xba}},
+    {11764, 4, 3, {0xe2, 0x88, 0x8b}},
+    {11768, 5, 2, {0xd1, 0x9a}},
+    {11773, 6, 3, {0xe2, 0x87, 0x8d}},
+    {11779, 4, 5, {0xe2, 0x89, 0xa6, 0xcc, 0xb8}},
+    {11783, 6, 3, {0xe2, 0x86, 0x9a}},
+    {11789, 5, 3, {0xe2, 0x80, 0xa5}},
+    {11794, 4, 3, {0xe2, 0x89, 0xb0}},
+    {11798, 11, 3, {0xe2, 0x86, 0x9a}},
+    {11809, 16, 3, {0xe2, 0x86, 0xae}},
+    {11825, 5, 3, {0xe2, 0x89, 0xb0}},
+    {11830, 6, 5, {0xe2, 0x89, 0xa6, 0xcc, 0xb8}},
+    {11836, 10, 5, {0xe2, 0xa9, 0xbd, 0xcc, 0xb8}},
+    {11846, 5, 5, {0xe2, 0xa9, 0xbd, 0xcc, 0xb8}},
+    {11851, 6, 3, {0xe2, 0x89, 0xae}},
+    {11857, 6, 3, {0xe2, 0x89, 0xb4}},
+    {11863, 4, 3, {0xe2, 0x89, 0xae}},
+    {11867, 6, 3, {0xe2, 0x8b, 0xaa}},
+    {11873, 7, 3, {0xe2, 0x8b, 0xac}},
+    {11880, 5, 3, {0xe2, 0x88, 0xa4}},
+    {11885, 5, 4, {0xf0, 0x9d, 0x95, 0x9f}},
+    {11890, 3, 2, {0xc2, 0xac}},
+    {11893, 4, 2, {0xc2, 0xac}},
+    {11897, 6, 3, {0xe2, 0x88, 0x89}},
+    {11903, 7, 5, {0xe2, 0x8b, 0xb9, 0xcc, 0xb8}},
+    {11910, 9, 5, {0xe2, 0x8b, 0xb5, 0xcc, 0xb8}},
+    {11919, 8, 3, {0xe2, 0x88, 0x89}},
+    {11927, 8, 3, {0xe2, 0x8b, 0xb7}},
+    {11935, 8, 3, {0xe2, 0x8b, 0xb6}},
+    {11943, 6, 3, {0xe2, 0x88, 0x8c}},
+    {11949, 8, 3, {0xe2, 0x88, 0x8c}},
+    {11957, 8, 3, {0xe2, 0x8b, 0xbe}},
+    {11965, 8, 3, {0xe2, 0x8b, 0xbd}},
+    {11973, 5, 3, {0xe2, 0x88, 0xa6}},
+    {11978, 10, 3, {0xe2, 0x88, 0xa6}},
+    {11988, 7, 6, {0xe2, 0xab, 0xbd, 0xe2, 0x83, 0xa5}},
+    {11995, 6, 5, {0xe2, 0x88, 0x82, 0xcc, 0xb8}},
+    {12001, 8, 3, {0xe2, 0xa8, 0x94}},
+    {12009, 4, 3, {0xe2, 0x8a, 0x80}},
+    {12013, 7, 3, {0xe2, 0x8b, 0xa0}},
+    {12020, 5, 5, {0xe2, 0xaa, 0xaf, 0xcc, 0xb8}},
+    {12025, 6, 3, {0xe2, 0x8a, 0x80}},
+    {12031, 8, 5, {0xe2, 0xaa, 0xaf, 0xcc, 0xb8}},
+    {12039, 6, 3, {0xe2, 0x87, 0x8f}},
+    {12045, 6, 3, {0xe2, 0x86, 0x9b}},
+    {12051, 7, 5, {0xe2, 0xa4, 0xb3, 0xcc, 0xb8}},
+    {12058, 7, 5, {0xe2, 0x86, 0x9d, 0xcc, 0xb8}},
+    {12065, 12, 3, {0xe2, 0x86, 0x9b}},
+    {12077, 6, 3, {0xe2, 0x8b, 0xab}},
+    {12083, 7, 3, {0xe2, 0x8b, 0xad}},
+    {12090, 4, 3, {0xe2, 0x8a, 0x81}},
+    {12094, 7, 3, {0xe2, 0x8b, 0xa1}},
+    {12101, 5, 5, {0xe2, 0xaa, 0xb0, 0xcc, 0xb8}},
+    {12106, 5, 4, {0xf0, 0x9d, 0x93, 0x83}},
+    {12111, 10, 3, {0xe2, 0x88, 0xa4}},
+    {12121, 15, 3, {0xe2, 0x88, 0xa6}},
+    {12136, 5, 3, {0xe2, 0x89, 0x81}},
+    {12141, 6, 3, {0xe2, 0x89, 0x84}},
+    {12147, 7, 3, {0xe2, 0x89, 0x84}},
+    {12154, 6, 3, {0xe2, 0x88, 0xa4}},
+    {12160, 6, 3, {0xe2, 0x88, 0xa6}},
+    {12166, 8, 3, {0xe2, 0x8b, 0xa2}},
+    {12174, 8, 3, {0xe2, 0x8b, 0xa3}},
+    {12182, 5, 3, {0xe2, 0x8a, 0x84}},
+    {12187, 6, 5, {0xe2, 0xab, 0x85, 0xcc, 0xb8}},
+    {12193, 6, 3, {0xe2, 0x8a, 0x88}},
+    {12199, 8, 6, {0xe2, 0x8a, 0x82, 0xe2, 0x83, 0x92}},
+    {12207, 10, 3, {0xe2, 0x8a, 0x88}},
+    {12217, 11, 5, {0xe2, 0xab, 0x85, 0xcc, 0xb8}},
+    {12228, 6, 3, {0xe2, 0x8a, 0x81}},
+    {12234, 8, 5, {0xe2, 0xaa, 0xb0, 0xcc, 0xb8}},
+    {12242, 5, 3, {0xe2, 0x8a, 0x85}},
+    {12247, 6, 5, {0xe2, 0xab, 0x86, 0xcc, 0xb8}},
+    {12253, 6, 3, {0xe2, 0x8a, 0x89}},
+    {12259, 8, 6, {0xe2, 0x8a, 0x83, 0xe2, 0x83, 0x92}},
+    {12267, 10, 3, {0xe2, 0x8a, 0x89}},
+    {12277, 11, 5, {0xe2, 0xab, 0x86, 0xcc, 0xb8}},
+    {12288, 5, 3, {0xe2, 0x89, 0xb9}},
+    {12293, 6, 2, {0xc3, 0xb1}},
+    {12299, 7, 2, {0xc3, 0xb1}},
+    {12306, 5, 3, {0xe2, 0x89, 0xb8}},
+    {12311, 14, 3, {0xe2, 0x8b, 0xaa}},
+    {12325, 16, 3, {0xe2, 0x8b, 0xac}},
+    {12341, 15, 3, {0xe2, 0x8b, 0xab}},
+    {12356, 17, 3, {0xe2, 0x8b, 0xad}},
+    {12373, 3, 2, {0xce, 0xbd}},
+    {12376, 4, 1, {0x23}},
+    {12380, 7, 3, {0xe2, 0x84, 0x96}},
+    {12387, 6, 3, {0xe2, 0x80, 0x87}},
+    {12393, 7, 3, {0xe2, 0x8a, 0xad}},
+    {12400, 7, 3, {0xe2, 0xa4, 0x84}},
+    {12407, 5, 6, {0xe2, 0x89, 0x8d, 0xe2, 0x83, 0x92}},
+    {12412, 7, 3, {0xe2, 0x8a, 0xac}},
+    {12419, 5, 6, {0xe2, 0x89, 0xa5, 0xe2, 0x83, 0x92}},
+    {12424, 5, 4, {0x3e, 0xe2, 0x83, 0x92}},
+    {12429, 8, 3, {0xe2, 0xa7, 0x9e}},
+    {12437, 7, 3, {0xe2, 0xa4, 0x82}},
+    {12444, 5, 6, {0xe2, 0x89, 0xa4, 0xe2, 0x83, 0x92}},
+    {12449, 5, 4, {0x3c, 0xe2, 0x83, 0x92}},
+    {12454, 8, 6, {0xe2, 0x8a, 0xb4, 0xe2, 0x83, 0x92}},
+    {12462, 7, 3, {0xe2, 0xa4, 0x83}},
+    {12469, 8, 6, {0xe2, 0x8a, 0xb5, 0xe2, 0x83, 0x92}},
+    {12477, 6, 6, {0xe2, 0x88, 0xbc, 0xe2, 0x83, 0x92}},
+    {12483, 6, 3, {0xe2, 0x87, 0x96}},
+    {12489, 7, 3, {0xe2, 0xa4, 0xa3}},
+    {12496, 6, 3, {0xe2, 0x86, 0x96}},
+    {12502, 8, 3, {0xe2, 0x86, 0x96}},
+    {12510, 7, 3, {0xe2, 0xa4, 0xa7}},
+    {12517, 3, 3, {0xe2, 0x93, 0x88}},
+    {12520, 6, 2, {0xc3, 0xb3}},
+    {12526, 7, 2, {0xc3, 0xb3}},
+    {12533, 5, 3, {0xe2, 0x8a, 0x9b}},
+    {12538, 5, 3, {0xe2, 0x8a, 0x9a}},
+    {12543, 5, 2, {0xc3, 0xb4}},
+    {12548, 6, 2, {0xc3, 0xb4}},
+    {12554, 4, 2, {0xd0, 0xbe}},
+    {12558, 6, 3, {0xe2, 0x8a, 0x9d}},
+    {12564, 7, 2, {0xc5, 0x91}},
+    {12571, 5, 3, {0xe2, 0xa8, 0xb8}},
+    {12576, 5, 3, {0xe2, 0x8a, 0x99}},
+    {12581, 7, 3, {0xe2, 0xa6, 0xbc}},
+    {12588, 6, 2, {0xc5, 0x93}},
+    {12594, 6, 3, {0xe2, 0xa6, 0xbf}},
+    {12600, 4, 4, {0xf0, 0x9d, 0x94, 0xac}},
+    {12604, 5, 2, {0xcb, 0x9b}},
+    {12609, 6, 2, {0xc3, 0xb2}},
+    {12615, 7, 2, {0xc3, 0xb2}},
+    {12622, 4, 3, {0xe2, 0xa7, 0x81}},
+    {12626, 6, 3, {0xe2, 0xa6, 0xb5}},
+    {12632, 4, 2, {0xce, 0xa9}},
+    {12636, 5, 3, {0xe2, 0x88, 0xae}},
+    {12641, 6, 3, {0xe2, 0x86, 0xba}},
+    {12647, 6, 3, {0xe2, 0xa6, 0xbe}},
+    {12653, 8, 3, {0xe2, 0xa6, 0xbb}},
+    {12661, 6, 3, {0xe2, 0x80, 0xbe}},
+    {12667, 4, 3, {0xe2, 0xa7, 0x80}},
+    {12671, 6, 2, {0xc5, 0x8d}},
+    {12677, 6, 2, {0xcf, 0x89}},
+    {12683, 8, 2, {0xce, 0xbf}},
+    {12691, 5, 3, {0xe2, 0xa6, 0xb6}},
+    {12696, 7, 3, {0xe2, 0x8a, 0x96}},
+    {12703, 5, 4, {0xf0, 0x9d, 0x95, 0xa0}},
+    {12708, 5, 3, {0xe2, 0xa6, 0xb7}},
+    {12713, 6, 3, {0xe2, 0xa6, 0xb9}},
+    {12719, 6, 3, {0xe2, 0x8a, 0x95}},
+    {12725, 3, 3, {0xe2, 0x88, 0xa8}},
+    {12728, 6, 3, {0xe2, 0x86, 0xbb}},
+    {12734, 4, 3, {0xe2, 0xa9, 0x9d}},
+    {12738, 6, 3, {0xe2, 0x84, 0xb4}},
+    {12744, 8, 3, {0xe2, 0x84, 0xb4}},
+    {12752, 4, 2, {0xc2, 0xaa}},
+    {12756, 5, 2, {0xc2, 0xaa}},
+    {12761, 4, 2, {0xc2, 0xba}},
+    {12765, 5, 2, {0xc2, 0xba}},
+    {12770, 7, 3, {0xe2, 0x8a, 0xb6}},
+    {12777, 5, 3, {0xe2, 0xa9, 0x96}},
+    {12782, 8, 3, {0xe2, 0xa9, 0x97}},
+    {12790, 4, 3, {0xe2, 0xa9, 0x9b}},
+    {12794, 5, 3, {0xe2, 0x84, 0xb4}},
+    {12799, 6, 2, {0xc3, 0xb8}},
+    {12805, 7, 2, {0xc3, 0xb8}},
+    {12812, 5, 3, {0xe2, 0x8a, 0x98}},
+    {12817, 6, 2, {0xc3, 0xb5}},
+    {12823, 7, 2, {0xc3, 0xb5}},
+    {12830, 7, 3, {0xe2, 0x8a, 0x97}},
+    {12837, 9, 3, {0xe2, 0xa8, 0xb6}},
+    {12846, 4, 2, {0xc3, 0xb6}},
+    {12850, 5, 2, {0xc3, 0xb6}},
+    {12855, 6, 3, {0xe2, 0x8c, 0xbd}},
+    {12861, 4, 3, {0xe2, 0x88, 0xa5}},
+    {12865, 4, 2, {0xc2, 0xb6}},
+    {12869, 5, 2, {0xc2, 0xb6}},
+    {12874, 9, 3, {0xe2, 0x88, 0xa5}},
+    {12883, 7, 3, {0xe2, 0xab, 0xb3}},
+    {12890, 6, 3, {0xe2, 0xab, 0xbd}},
+    {12896, 5, 3, {0xe2, 0x88, 0x82}},
+    {12901, 4, 2, {0xd0, 0xbf}},
+    {12905, 7, 1, {0x25}},
+    {12912, 7, 1, {0x2e}},
+    {12919, 7, 3, {0xe2, 0x80, 0xb0}},
+    {12926, 5, 3, {0xe2, 0x8a, 0xa5}},
+    {12931, 8, 3, {0xe2, 0x80, 0xb1}},
+    {12939, 4, 4, {0xf0, 0x9d, 0x94, 0xad}},
+    {12943, 4, 2, {0xcf, 0x86}},
+    {12947, 5, 2, {0xcf, 0x95}},
+    {12952, 7, 3, {0xe2, 0x84, 0xb3}},
+    {12959, 6, 3, {0xe2, 0x98, 0x8e}},
+    {12965, 3, 2, {0xcf, 0x80}},
+    {12968, 10, 3, {0xe2, 0x8b, 0x94}},
+    {12978, 4, 2, {0xcf, 0x96}},
+    {12982, 7, 3, {0xe2, 0x84, 0x8f}},
+    {12989, 8, 3, {0xe2, 0x84, 0x8e}},
+    {12997, 7, 3, {0xe2, 0x84, 0x8f}},
+    {13004, 5, 1, {0x2b}},
+    {13009, 9, 3, {0xe2, 0xa8, 0xa3}},
+    {13018, 6, 3, {0xe2, 0x8a, 0x9e}},
+    {13024, 8, 3, {0xe2, 0xa8, 0xa2}},
+    {13032, 7, 3, {0xe2, 0x88, 0x94}},
+    {13039, 7, 3, {0xe2, 0xa8, 0xa5}},
+    {13046, 6, 3, {0xe2, 0xa9, 0xb2}},
+    {13052, 6, 2, {0xc2, 0xb1}},
+    {13058, 7, 2, {0xc2, 0xb1}},
+    {13065, 8, 3, {0xe2, 0xa8, 0xa6}},
+    {13073, 8, 3, {0xe2, 0xa8, 0xa7}},
+    {13081, 3, 2, {0xc2, 0xb1}},
+    {13084, 9, 3, {0xe2, 0xa8, 0x95}},
+    {13093, 5, 4, {0xf0, 0x9d, 0x95, 0xa1}},
+    {13098, 5, 2, {0xc2, 0xa3}},
+    {13103, 6, 2, {0xc2, 0xa3}},
+    {13109, 3, 3, {0xe2, 0x89, 0xba}},
+    {13112, 4, 3, {0xe2, 0xaa, 0xb3}},
+    {13116, 5, 3, {0xe2, 0xaa, 0xb7}},
+    {13121, 6, 3, {0xe2, 0x89, 0xbc}},
+    {13127, 4, 3, {0xe2, 0xaa, 0xaf}},
+    {13131, 5, 3, {0xe2, 0x89, 0xba}},
+    {13136, 11, 3, {0xe2, 0xaa, 0xb7}},
+    {13147, 12, 3, {0xe2, 0x89, 0xbc}},
+    {13159, 7, 3, {0xe2, 0xaa, 0xaf}},
+    {13166, 12, 3, {0xe2, 0xaa, 0xb9}},
+    {13178, 9, 3, {0xe2, 0xaa, 0xb5}},
+    {13187, 9, 3, {0xe2, 0x8b, 0xa8}},
+    {13196, 8, 3, {0xe2, 0x89, 0xbe}},
+    {13204, 6, 3, {0xe2, 0x80, 0xb2}},
+    {13210, 7, 3, {0xe2, 0x84, 0x99}},
+    {13217, 5, 3, {0xe2, 0xaa, 0xb5}},
+    {13222, 6, 3, {0xe2, 0xaa, 0xb9}},
+    {13228, 7, 3, {0xe2, 0x8b, 0xa8}},
+    {13235, 5, 3, {0xe2, 0x88, 0x8f}},
+    {13240, 9, 3, {0xe2, 0x8c, 0xae}},
+    {13249, 9, 3, {0xe2, 0x8c, 0x92}},
+    {13258, 9, 3, {0xe2, 0x8c, 0x93}},
+    {13267, 5, 3, {0xe2, 0x88, 0x9d}},
+    {13272, 7, 3, {0xe2, 0x88, 0x9d}},
+    {13279, 6, 3, {0xe2, 0x89, 0xbe}},
+    {13285, 7, 3, {0xe2, 0x8a, 0xb0}},
+    {13292, 5, 4, {0xf0, 0x9d, 0x93, 0x85}},
+    {13297, 4, 2, {0xcf, 0x88}},
+    {13301, 7, 3, {0xe2, 0x80, 0x88}},
+    {13308, 4, 4, {0xf0, 0x9d, 0x94, 0xae}},
+    {13312, 5, 3, {0xe2, 0xa8, 0x8c}},
+    {13317, 5, 4, {0xf0, 0x9d, 0x95, 0xa2}},
+    {13322, 7, 3, {0xe2, 0x81, 0x97}},
+    {13329, 5, 4, {0xf0, 0x9d, 0x93, 0x86}},
+    {13334, 12, 3, {0xe2, 0x84, 0x8d}},
+    {13346, 8, 3, {0xe2, 0xa8, 0x96}},
+    {13354, 6, 1, {0x3f}},
+    {13360, 8, 3, {0xe2, 0x89, 0x9f}},
+    {13368, 4, 1, {0x22}},
+    {13372, 5, 1, {0x22}},
+    {13377, 6, 3, {0xe2, 0x87, 0x9b}},
+    {13383, 5, 3, {0xe2, 0x87, 0x92}},
+    {13388, 7, 3, {0xe2, 0xa4, 0x9c}},
+    {13395, 6, 3, {0xe2, 0xa4, 0x8f}},
+    {13401, 5, 3, {0xe2, 0xa5, 0xa4}},
+    {13406, 5, 5, {0xe2, 0x88, 0xbd, 0xcc, 0xb1}},
+    {13411, 7, 2, {0xc5, 0x95}},
+    {13418, 6, 3, {0xe2, 0x88, 0x9a}},
+    {13424, 9, 3, {0xe2, 0xa6, 0xb3}},
+    {13433, 5, 3, {0xe2, 0x9f, 0xa9}},
+    {13438, 6, 3, {0xe2, 0xa6, 0x92}},
+    {13444, 6, 3, {0xe2, 0xa6, 0xa5}},
+    {13450, 7, 3, {0xe2, 0x9f, 0xa9}},
+    {13457, 5, 2, {0xc2, 0xbb}},
+    {13462, 6, 2, {0xc2, 0xbb}},
+    {13468, 5, 3, {0xe2, 0x86, 0x92}},
+    {13473, 7, 3, {0xe2, 0xa5, 0xb5}},
+    {13480, 6, 3, {0xe2, 0x87, 0xa5}},
+    {13486, 8, 3, {0xe2, 0xa4, 0xa0}},
+    {13494, 6, 3, {0xe2, 0xa4, 0xb3}},
+    {13500, 7, 3, {0xe2, 0xa4, 0x9e}},
+    {13507, 7, 3, {0xe2, 0x86, 0xaa}},
+    {13514, 7, 3, {0xe2, 0x86, 0xac}},
+    {13521, 7, 3, {0xe2, 0xa5, 0x85}},
+    {13528, 8, 3, {0xe2, 0xa5, 0xb4}},
+    {13536, 7, 3, {0xe2, 0x86, 0xa3}},
+    {13543, 6, 3, {0xe2, 0x86, 0x9d}},
+    {13549, 7, 3, {0xe2, 0xa4, 0x9a}},
+    {13556, 6, 3, {0xe2, 0x88, 0xb6}},
+    {13562, 10, 3, {0xe2, 0x84, 0x9a}},
+    {13572, 6, 3, {0xe2, 0xa4, 0x8d}},
+    {13578, 6, 3, {0xe2, 0x9d, 0xb3}},
+    {13584, 7, 1, {0x7d}},
+    {13591, 7, 1, {0x5d}},
+    {13598, 6, 3, {0xe2, 0xa6, 0x8c}},
+    {13604, 8, 3, {0xe2, 0xa6, 0x8e}},
+    {13612, 8, 3, {0xe2, 0xa6, 0x90}},
+    {13620, 7, 2, {0xc5, 0x99}},
+    {13627, 7, 2, {0xc5, 0x97}},
+    {13634, 6, 3, {0xe2, 0x8c, 0x89}},
+    {13640, 5, 1, {0x7d}},
+    {13645, 4, 2, {0xd1, 0x80}},
+    {13649, 5, 3, {0xe2, 0xa4, 0xb7}},
+    {13654, 8, 3, {0xe2, 0xa5, 0xa9}},
+    {13662, 6, 3, {0xe2, 0x80, 0x9d}},
+    {13668, 7, 3, {0xe2, 0x80, 0x9d}},
+    {13675, 5, 3, {0xe2, 0x86, 0xb3}},
+    {13680, 5, 3, {0xe2, 0x84, 0x9c}},
+    {13685, 8, 3, {0xe2, 0x84, 0x9b}},
+    {13693, 9, 3, {0xe2, 0x84, 0x9c}},
+    {13702, 6, 3, {0xe2, 0x84, 0x9d}},
+    {13708, 5, 3, {0xe2, 0x96, 0xad}},
+    {13713, 3, 2, {0xc2, 0xae}},
+    {13716, 4, 2, {0xc2, 0xae}},
+    {13720, 7, 3, {0xe2, 0xa5, 0xbd}},
+    {13727, 7, 3, {0xe2, 0x8c, 0x8b}},
+    {13734, 4, 4, {0xf0, 0x9d, 0x94, 0xaf}},
+    {13738, 6, 3, {0xe2, 0x87, 0x81}},
+    {13744, 6, 3, {0xe2, 0x87, 0x80}},
+    {13750, 7, 3, {0xe2, 0xa5, 0xac}},
+    {13757, 4, 2, {0xcf, 0x81}},
+    {13761, 5, 2, {0xcf, 0xb1}},
+    {13766, 11, 3, {0xe2, 0x86, 0x92}},
+    {13777, 15, 3, {0xe2, 0x86, 0xa3}},
+    {13792, 17, 3, {0xe2, 0x87, 0x81}},
+    {13809, 15, 3, {0xe2, 0x87, 0x80}},
+    {13824, 16, 3, {0xe2, 0x87, 0x84}},
+    {13840, 18, 3, {0xe2, 0x87, 0x8c}},
+    {13858, 17, 3, {0xe2, 0x87, 0x89}},
+    {13875, 16, 3, {0xe2, 0x86, 0x9d}},
+    {13891, 16, 3, {0xe2, 0x8b, 0x8c}},
+    {13907, 5, 2, {0xcb, 0x9a}},
+    {13912, 13, 3, {0xe2, 0x89, 0x93}},
+    {13925, 6, 3, {0xe2, 0x87, 0x84}},
+    {13931, 6, 3, {0xe2, 0x87, 0x8c}},
+    {13937, 4, 3, {0xe2, 0x80, 0x8f}},
+    {13941, 7, 3, {0xe2, 0x8e, 0xb1}},
+    {13948, 11, 3, {0xe2, 0x8e, 0xb1}},
+    {13959, 6, 3, {0xe2, 0xab, 0xae}},
+    {13965, 6, 3, {0xe2, 0x9f, 0xad}},
+    {13971, 6, 3, {0xe2, 0x87, 0xbe}},
+    {13977, 6, 3, {0xe2, 0x9f, 0xa7}},
+    {13983, 6, 3, {0xe2, 0xa6, 0x86}},
+    {13989, 5, 4, {0xf0, 0x9d, 0x95, 0xa3}},
+    {13994, 7, 3, {0xe2, 0xa8, 0xae}},
+    {14001, 8, 3, {0xe2, 0xa8, 0xb5}},
+    {14009, 5, 1, {0x29}},
+    {14014, 7, 3, {0xe2, 0xa6, 0x94}},
+    {14021, 9, 3, {0xe2, 0xa8, 0x92}},
+    {14030, 6, 3, {0xe2, 0x87, 0x89}},
+    {14036, 7, 3, {0xe2, 0x80, 0xba}},
+    {14043, 5, 4, {0xf0, 0x9d, 0x93, 0x87}},
+    {14048, 4, 3, {0xe2, 0x86, 0xb1}},
+    {14052, 5, 1, {0x5d}},
+    {14057, 6, 3, {0xe2, 0x80, 0x99}},
+    {14063, 7, 3, {0xe2, 0x80, 0x99}},
+    {14070, 7, 3, {0xe2, 0x8b, 0x8c}},
+    {14077, 7, 3, {0xe2, 0x8b, 0x8a}},
+    {14084, 5, 3, {0xe2, 0x96, 0xb9}},
+    {14089, 6, 3, {0xe2, 0x8a, 0xb5}},
+    {14095, 6, 3, {0xe2, 0x96, 0xb8}},
+    {14101, 9, 3, {0xe2, 0xa7, 0x8e}},
+    {14110, 8, 3, {0xe2, 0xa5, 0xa8}},
+    {14118, 3, 3, {0xe2, 0x84, 0x9e}},
+    {14121, 7, 2, {0xc5, 0x9b}},
+    {14128, 6, 3, {0xe2, 0x80, 0x9a}},
+    {14134, 3, 3, {0xe2, 0x89, 0xbb}},
+    {14137, 4, 3, {0xe2, 0xaa, 0xb4}},
+    {14141, 5, 3, {0xe2, 0xaa, 0xb8}},
+    {14146, 7, 2, {0xc5, 0xa1}},
+    {14153, 6, 3, {0xe2, 0x89, 0xbd}},
+    {14159, 4, 3, {0xe2, 0xaa, 0xb0}},
+    {14163, 7, 2, {0xc5, 0x9f}},
+    {14170, 6, 2, {0xc5, 0x9d}},
+    {14176, 5, 3, {0xe2, 0xaa, 0xb6}},
+    {14181, 6, 3, {0xe2, 0xaa, 0xba}},
+    {14187, 7, 3, {0xe2, 0x8b, 0xa9}},
+    {14194, 9, 3, {0xe2, 0xa8, 0x93}},
+    {14203, 6, 3, {0xe2, 0x89, 0xbf}},
+    {14209, 4, 2, {0xd1, 0x81}},
+    {14213, 5, 3, {0xe2, 0x8b, 0x85}},
+    {14218, 6, 3, {0xe2, 0x8a, 0xa1}},
+    {14224, 6, 3, {0xe2, 0xa9, 0xa6}},
+    {14230, 6, 3, {0xe2, 0x87, 0x98}},
+    {14236, 7, 3, {0xe2, 0xa4, 0xa5}},
+    {14243, 6, 3, {0xe2, 0x86, 0x98}},
+    {14249, 8, 3, {0xe2, 0x86, 0x98}},
+    {14257, 4, 2, {0xc2, 0xa7}},
+    {14261, 5, 2, {0xc2, 0xa7}},
+    {14266, 5, 1, {0x3b}},
+    {14271, 7, 3, {0xe2, 0xa4, 0xa9}},
+    {14278, 9, 3, {0xe2, 0x88, 0x96}},
+    {14287, 6, 3, {0xe2, 0x88, 0x96}},
+    {14293, 5, 3, {0xe2, 0x9c, 0xb6}},
+    {14298, 4, 4, {0xf0, 0x9d, 0x94, 0xb0}},
+    {14302, 7, 3, {0xe2, 0x8c, 0xa2}},
+    {14309, 6, 3, {0xe2, 0x99, 0xaf}},
+    {14315, 7, 2, {0xd1, 0x89}},
+    {14322, 5, 2, {0xd1, 0x88}},
+    {14327, 9, 3, {0xe2, 0x88, 0xa3}},
+    {14336, 14, 3, {0xe2, 0x88, 0xa5}},
+    {14350, 3, 2, {0xc2, 0xad}},
+    {14353, 4, 2, {0xc2, 0xad}},
+    {14357, 6, 2, {0xcf, 0x83}},
+    {14363, 7, 2, {0xcf, 0x82}},
+    {14370, 7, 2, {0xcf, 0x82}},
+    {14377, 4, 3, {0xe2, 0x88, 0xbc}},
+    {14381, 7, 3, {0xe2, 0xa9, 0xaa}},
+    {14388, 5, 3, {0xe2, 0x89, 0x83}},
+    {14393, 6, 3, {0xe2, 0x89, 0x83}},
+    {14399, 5, 3, {0xe2, 0xaa, 0x9e}},
+    {14404, 6, 3, {0xe2, 0xaa, 0xa0}},
+    {14410, 5, 3, {0xe2, 0xaa, 0x9d}},
+    {14415, 6, 3, {0xe2, 0xaa, 0x9f}},
+    {14421, 6, 3, {0xe2, 0x89, 0x86}},
+    {14427, 8, 3, {0xe2, 0xa8, 0xa4}},
+    {14435, 8, 3, {0xe2, 0xa5, 0xb2}},
+    {14443, 6, 3, {0xe2, 0x86, 0x90}},
+    {14449, 14, 3, {0xe2, 0x88, 0x96}},
+    {14463, 7, 3, {0xe2, 0xa8, 0xb3}},
+    {14470, 9, 3, {0xe2, 0xa7, 0xa4}},
+    {14479, 5, 3, {0xe2, 0x88, 0xa3}},
+    {14484, 6, 3, {0xe2, 0x8c, 0xa3}},
+    {14490, 4, 3, {0xe2, 0xaa, 0xaa}},
+    {14494, 5, 3, {0xe2, 0xaa, 0xac}},
+    {14499, 6, 6, {0xe2, 0xaa, 0xac, 0xef, 0xb8, 0x80}},
+    {14505, 7, 2, {0xd1, 0x8c}},
+    {14512, 4, 1, {0x2f}},
+    {14516, 5, 3, {0xe2, 0xa7, 0x84}},
+    {14521, 7, 3, {0xe2, 0x8c, 0xbf}},
+    {14528, 5, 4, {0xf0, 0x9d, 0x95, 0xa4}},
+    {14533, 7, 3, {0xe2, 0x99, 0xa0}},
+    {14540, 10, 3, {0xe2, 0x99, 0xa0}},
+    {14550, 5, 3, {0xe2, 0x88, 0xa5}},
+    {14555, 6, 3, {0xe2, 0x8a, 0x93}},
+    {14561, 7, 6, {0xe2, 0x8a, 0x93, 0xef, 0xb8, 0x80}},
+    {14568, 6, 3, {0xe2, 0x8a, 0x94}},
+    {14574, 7, 6, {0xe2, 0x8a, 0x94, 0xef, 0xb8, 0x80}},
+    {14581, 6, 3, {0xe2, 0x8a, 0x8f}},
+    {14587, 7, 3, {0xe2, 0x8a, 0x91}},
+    {14594, 9, 3, {0xe2, 0x8a, 0x8f}},
+    {14603, 11, 3, {0xe2, 0x8a, 0x91}},
+    {14614, 6, 3, {0xe2, 0x8a, 0x90}},
+    {14620, 7, 3, {0xe2, 0x8a, 0x92}},
+    {14627, 9, 3, {0xe2, 0x8a, 0x90}},
+    {14636, 11, 3, {0xe2, 0x8a, 0x92}},
+    {14647, 4, 3, {0xe2, 0x96, 0xa1}},
+    {14651, 7, 3, {0xe2, 0x96, 0xa1}},
+    {14658, 7, 3, {0xe2, 0x96, 0xaa}},
+    {14665, 5, 3, {0xe2, 0x96, 0xaa}},
+    {14670, 6, 3, {0xe2, 0x86, 0x92}},
+    {14676, 5, 4, {0xf0, 0x9d, 0x93, 0x88}},
+    {14681, 7, 3, {0xe2, 0x88, 0x96}},
+    {14688, 7, 3, {0xe2, 0x8c, 0xa3}},
+    {14695, 7, 3, {0xe2, 0x8b, 0x86}},
+    {14702, 5, 3, {0xe2, 0x98, 0x86}},
+    {14707, 6, 3, {0xe2, 0x98, 0x85}},
+    {14713, 16, 2, {0xcf, 0xb5}},
+    {14729, 12, 2, {0xcf, 0x95}},
+    {14741, 6, 2, {0xc2, 0xaf}},
+    {14747, 4, 3, {0xe2, 0x8a, 0x82}},
+    {14751, 5, 3, {0xe2, 0xab, 0x85}},
+    {14756, 7, 3, {0xe2, 0xaa, 0xbd}},
+    {14763, 5, 3, {0xe2, 0x8a, 0x86}},
+    {14768, 8, 3, {0xe2, 0xab, 0x83}},
+    {14776, 8, 3, {0xe2, 0xab, 0x81}},
+    {14784, 6, 3, {0xe2, 0xab, 0x8b}},
+    {14790, 6, 3, {0xe2, 0x8a, 0x8a}},
+    {14796, 8, 3, {0xe2, 0xaa, 0xbf}},
+    {14804, 8, 3, {0xe2, 0xa5, 0xb9}},
+    {14812, 7, 3, {0xe2, 0x8a, 0x82}},
+    {14819, 9, 3, {0xe2, 0x8a, 0x86}},
+    {14828, 10, 3, {0xe2, 0xab, 0x85}},
+    {14838, 10, 3, {0xe2, 0x8a, 0x8a}},
+    {14848, 11, 3, {0xe2, 0xab, 0x8b}},
+    {14859, 7, 3, {0xe2, 0xab, 0x87}},
+    {14866, 7, 3, {0xe2, 0xab, 0x95}},
+    {14873, 7, 3, {0xe2, 0xab, 0x93}},
+    {14880, 5, 3, {0xe2, 0x89, 0xbb}},
+    {14885, 11, 3, {0xe2, 0xaa, 0xb8}},
+    {14896, 12, 3, {0xe2, 0x89, 0xbd}},
+    {14908, 7, 3, {0xe2, 0xaa, 0xb0}},
+    {14915, 12, 3, {0xe2, 0xaa, 0xba}},
+    {14927, 9, 3, {0xe2, 0xaa, 0xb6}},
+    {14936, 9, 3, {0xe2, 0x8b, 0xa9}},
+    {14945, 8, 3, {0xe2, 0x89, 0xbf}},
+    {14953, 4, 3, {0xe2, 0x88, 0x91}},
+    {14957, 5, 3, {0xe2, 0x99, 0xaa}},
+    {14962, 4, 2, {0xc2, 0xb9}},
+    {14966, 5, 2, {0xc2, 0xb9}},
+    {14971, 4, 2, {0xc2, 0xb2}},
+    {14975, 5, 2, {0xc2, 0xb2}},
+    {14980, 4, 2, {0xc2, 0xb3}},
+    {14984, 5, 2, {0xc2, 0xb3}},
+    {14989, 4, 3, {0xe2, 0x8a, 0x83}},
+    {14993, 5, 3, {0xe2, 0xab, 0x86}},
+    {14998, 7, 3, {0xe2, 0xaa, 0xbe}},
+    {15005, 8, 3, {0xe2, 0xab, 0x98}},
+    {15013, 5, 3, {0xe2, 0x8a, 0x87}},
+    {15018, 8, 3, {0xe2, 0xab, 0x84}},
+    {15026, 8, 3, {0xe2, 0x9f, 0x89}},
+    {15034, 8, 3, {0xe2, 0xab, 0x97}},
+    {15042, 8, 3, {0xe2, 0xa5, 0xbb}},
+    {15050, 8, 3, {0xe2, 0xab, 0x82}},
+    {15058, 6, 3, {0xe2, 0xab, 0x8c}},
+    {15064, 6, 3, {0xe2, 0x8a, 0x8b}},
+    {15070, 8, 3, {0xe2, 0xab, 0x80}},
+    {15078, 7, 3, {0xe2, 0x8a, 0x83}},
+    {15085, 9, 3, {0xe2, 0x8a, 0x87}},
+    {15094, 10, 3, {0xe2, 0xab, 0x86}},
+    {15104, 10, 3, {0xe2, 0x8a, 0x8b}},
+    {15114, 11, 3, {0xe2, 0xab, 0x8c}},
+    {15125, 7, 3, {0xe2, 0xab, 0x88}},
+    {15132, 7, 3, {0xe2, 0xab, 0x94}},
+    {15139, 7, 3, {0xe2, 0xab, 0x96}},
+    {15146, 6, 3, {0xe2, 0x87, 0x99}},
+    {15152, 7, 3, {0xe2, 0xa4, 0xa6}},
+    {15159, 6, 3, {0xe2, 0x86, 0x99}},
+    {15165, 8, 3, {0xe2, 0x86, 0x99}},
+    {15173, 7, 3, {0xe2, 0xa4, 0xaa}},
+    {15180, 5, 2, {0xc3, 0x9f}},
+    {15185, 6, 2, {0xc3, 0x9f}},
+    {15191, 7, 3, {0xe2, 0x8c, 0x96}},
+    {15198, 4, 2, {0xcf, 0x84}},
+    {15202, 5, 3, {0xe2, 0x8e, 0xb4}},
+    {15207, 7, 2, {0xc5, 0xa5}},
+    {15214, 7, 2, {0xc5, 0xa3}},
+    {15221, 4, 2, {0xd1, 0x82}},
+    {15225, 5, 3, {0xe2, 0x83, 0x9b}},
+    {15230, 7, 3, {0xe2, 0x8c, 0x95}},
+    {15237, 4, 4, {0xf0, 0x9d, 0x94, 0xb1}},
+    {15241, 7, 3, {0xe2, 0x88, 0xb4}},
+    {15248, 10, 3, {0xe2, 0x88, 0xb4}},
+    {15258, 6, 2, {0xce, 0xb8}},
+    {15264, 9, 2, {0xcf, 0x91}},
+    {15273, 7, 2, {0xcf, 0x91}},
+    {15280, 12, 3, {0xe2, 0x89, 0x88}},
+    {15292, 9, 3, {0xe2, 0x88, 0xbc}},
+    {15301, 7, 3, {0xe2, 0x80, 0x89}},
+    {15308, 6, 3, {0xe2, 0x89, 0x88}},
+    {15314, 7, 3, {0xe2, 0x88, 0xbc}},
+    {15321, 5, 2, {0xc3, 0xbe}},
+    {15326, 6, 2, {0xc3, 0xbe}},
+    {15332, 6, 2, {0xcb, 0x9c}},
+    {15338, 5, 2, {0xc3, 0x97}},
+    {15343, 6, 2, {0xc3, 0x97}},
+    {15349, 7, 3, {0xe2, 0x8a, 0xa0}},
+    {15356, 9, 3, {0xe2, 0xa8, 0xb1}},
+    {15365, 7, 3, {0xe2, 0xa8, 0xb0}},
+    {15372, 5, 3, {0xe2, 0x88, 0xad}},
+    {15377, 5, 3, {0xe2, 0xa4, 0xa8}},
+    {15382, 4, 3, {0xe2, 0x8a, 0xa4}},
+    {15386, 7, 3, {0xe2, 0x8c, 0xb6}},
+    {15393, 7, 3, {0xe2, 0xab, 0xb1}},
+    {15400, 5, 4, {0xf0, 0x9d, 0x95, 0xa5}},
+    {15405, 8, 3, {0xe2, 0xab, 0x9a}},
+    {15413, 5, 3, {0xe2, 0xa4, 0xa9}},
+    {15418, 7, 3, {0xe2, 0x80, 0xb4}},
+    {15425, 6, 3, {0xe2, 0x84, 0xa2}},
+    {15431, 9, 3, {0xe2, 0x96, 0xb5}},
+    {15440, 13, 3, {0xe2, 0x96, 0xbf}},
+    {15453, 13, 3, {0xe2, 0x97, 0x83}},
+    {15466, 15, 3, {0xe2, 0x8a, 0xb4}},
+    {15481, 10, 3, {0xe2, 0x89, 0x9c}},
+    {15491, 14, 3, {0xe2, 0x96, 0xb9}},
+    {15505, 16, 3, {0xe2, 0x8a, 0xb5}},
+    {15521, 7, 3, {0xe2, 0x97, 0xac}},
+    {15528, 5, 3, {0xe2, 0x89, 0x9c}},
+    {15533, 9, 3, {0xe2, 0xa8, 0xba}},
+    {15542, 8, 3, {0xe2, 0xa8, 0xb9}},
+    {15550, 6, 3, {0xe2, 0xa7, 0x8d}},
+    {15556, 8, 3, {0xe2, 0xa8, 0xbb}},
+    {15564, 9, 3, {0xe2, 0x8f, 0xa2}},
+    {15573, 5, 4, {0xf0, 0x9d, 0x93, 0x89}},
+    {15578, 5, 2, {0xd1, 0x86}},
+    {15583, 6, 2, {0xd1, 0x9b}},
+    {15589, 7, 2, {0xc5, 0xa7}},
+    {15596, 6, 3, {0xe2, 0x89, 0xac}},
+    {15602, 17, 3, {0xe2, 0x86, 0x9e}},
+    {15619, 18, 3, {0xe2, 0x86, 0xa0}},
+    {15637, 5, 3, {0xe2, 0x87, 0x91}},
+    {15642, 5, 3, {0xe2, 0xa5, 0xa3}},
+    {15647, 6, 2, {0xc3, 0xba}},
+    {15653, 7, 2, {0xc3, 0xba}},
+    {15660, 5, 3, {0xe2, 0x86, 0x91}},
+    {15665, 6, 2, {0xd1, 0x9e}},
+    {15671, 7, 2, {0xc5, 0xad}},
+    {15678, 5, 2, {0xc3, 0xbb}},
+    {15683, 6, 2, {0xc3, 0xbb}},
+    {15689, 4, 2, {0xd1, 0x83}},
+    {15693, 6, 3, {0xe2, 0x87, 0x85}},
+    {15699, 7, 2, {0xc5, 0xb1}},
+    {15706, 6, 3, {0xe2, 0xa5, 0xae}},
+    {15712, 7, 3, {0xe2, 0xa5, 0xbe}},
+    {15719, 4, 4, {0xf0, 0x9d, 0x94, 0xb2}},
+    {15723, 6, 2, {0xc3, 0xb9}},
+    {15729, 7, 2, {0xc3, 0xb9}},
+    {15736, 6, 3, {0xe2, 0x86, 0xbf}},
+    {15742, 6, 3, {0xe2, 0x86, 0xbe}},
+    {15748, 6, 3, {0xe2, 0x96, 0x80}},
+    {15754, 7, 3, {0xe2, 0x8c, 0x9c}},
+    {15761, 9, 3, {0xe2, 0x8c, 0x9c}},
+    {15770, 7, 3, {0xe2, 0x8c, 0x8f}},
+    {15777, 6, 3, {0xe2, 0x97, 0xb8}},
+    {15783, 6, 2, {0xc5, 0xab}},
+    {15789, 3, 2, {0xc2, 0xa8}},
+    {15792, 4, 2, {0xc2, 0xa8}},
+    {15796, 6, 2, {0xc5, 0xb3}},
+    {15802, 5, 4, {0xf0, 0x9d, 0x95, 0xa6}},
+    {15807, 8, 3, {0xe2, 0x86, 0x91}},
+    {15815, 12, 3, {0xe2, 0x86, 0x95}},
+    {15827, 14, 3, {0xe2, 0x86, 0xbf}},
+    {15841, 15, 3, {0xe2, 0x86, 0xbe}},
+    {15856, 6, 3, {0xe2, 0x8a, 0x8e}},
+    {15862, 5, 2, {0xcf, 0x85}},
+    {15867, 6, 2, {0xcf, 0x92}},
+    {15873, 8, 2, {0xcf, 0x85}},
+    {15881, 11, 3, {0xe2, 0x87, 0x88}},
+    {15892, 7, 3, {0xe2, 0x8c, 0x9d}},
+    {15899, 9, 3, {0xe2, 0x8c, 0x9d}},
+    {15908, 7, 3, {0xe2, 0x8c, 0x8e}},
+    {15915, 6, 2, {0xc5, 0xaf}},
+    {15921, 6, 3, {0xe2, 0x97, 0xb9}},
+    {15927, 5, 4, {0xf0, 0x9d, 0x93, 0x8a}},
+    {15932, 6, 3, {0xe2, 0x8b, 0xb0}},
+    {15938, 7, 2, {0xc5, 0xa9}},
+    {15945, 5, 3, {0xe2, 0x96, 0xb5}},
+    {15950, 6, 3, {0xe2, 0x96, 0xb4}},
+    {15956, 6, 3, {0xe2, 0x87, 0x88}},
+    {15962, 4, 2, {0xc3, 0xbc}},
+    {15966, 5, 2, {0xc3, 0xbc}},
+    {15971, 8, 3, {0xe2, 0xa6, 0xa7}},
+    {15979, 5, 3, {0xe2, 0x87, 0x95}},
+    {15984, 5, 3, {0xe2, 0xab, 0xa8}},
+    {15989, 6, 3, {0xe2, 0xab, 0xa9}},
+    {15995, 6, 3, {0xe2, 0x8a, 0xa8}},
+    {16001, 7, 3, {0xe2, 0xa6, 0x9c}},
+    {16008, 11, 2, {0xcf, 0xb5}},
+    {16019, 9, 2, {0xcf, 0xb0}},
+    {16028, 11, 3, {0xe2, 0x88, 0x85}},
+    {16039, 7, 2, {0xcf, 0x95}},
+    {16046, 6, 2, {0xcf, 0x96}},
+    {16052, 10, 3, {0xe2, 0x88, 0x9d}},
+    {16062, 5, 3, {0xe2, 0x86, 0x95}},
+    {16067, 7, 2, {0xcf, 0xb1}},
+    {16074, 9, 2, {0xcf, 0x82}},
+    {16083, 13, 6, {0xe2, 0x8a, 0x8a, 0xef, 0xb8, 0x80}},
+    {16096, 14, 6, {0xe2, 0xab, 0x8b, 0xef, 0xb8, 0x80}},
+    {16110, 13, 6, {0xe2, 0x8a, 0x8b, 0xef, 0xb8, 0x80}},
+    {16123, 14, 6, {0xe2, 0xab, 0x8c, 0xef, 0xb8, 0x80}},
+    {16137, 9, 2, {0xcf, 0x91}},
+    {16146, 16, 3, {0xe2, 0x8a, 0xb2}},
+    {16162, 17, 3, {0xe2, 0x8a, 0xb3}},
+    {16179, 4, 2, {0xd0, 0xb2}},
+    {16183, 6, 3, {0xe2, 0x8a, 0xa2}},
+    {16189, 4, 3, {0xe2, 0x88, 0xa8}},
+    {16193, 7, 3, {0xe2, 0x8a, 0xbb}},
+    {16200, 6, 3, {0xe2, 0x89, 0x9a}},
+    {16206, 7, 3, {0xe2, 0x8b, 0xae}},
+    {16213, 7, 1, {0x7c}},
+    {16220, 5, 1, {0x7c}},
+    {16225, 4, 4, {0xf0, 0x9d, 0x94, 0xb3}},
+    {16229, 6, 3, {0xe2, 0x8a, 0xb2}},
+    {16235, 6, 6, {0xe2, 0x8a, 0x82, 0xe2, 0x83, 0x92}},
+    {16241, 6, 6, {0xe2, 0x8a, 0x83, 0xe2, 0x83, 0x92}},
+    {16247, 5, 4, {0xf0, 0x9d, 0x95, 0xa7}},
+    {16252, 6, 3, {0xe2, 0x88, 0x9d}},
+    {16258, 6, 3, {0xe2, 0x8a, 0xb3}},
+    {16264, 5, 4, {0xf0, 0x9d, 0x93, 0x8b}},
+    {16269, 7, 6, {0xe2, 0xab, 0x8b, 0xef, 0xb8, 0x80}},
+    {16276, 7, 6, {0xe2, 0x8a, 0x8a, 0xef, 0xb8, 0x80}},
+    {16283, 7, 6, {0xe2, 0xab, 0x8c, 0xef, 0xb8, 0x80}},
+    {16290, 7, 6, {0xe2, 0x8a, 0x8b, 0xef, 0xb8, 0x80}},
+    {16297, 8, 3, {0xe2, 0xa6, 0x9a}},
+    {16305, 6, 2, {0xc5, 0xb5}},
+    {16311, 7, 3, {0xe2, 0xa9, 0x9f}},
+    {16318, 6, 3, {0xe2, 0x88, 0xa7}},
+    {16324, 7, 3, {0xe2, 0x89, 0x99}},
+    {16331, 7, 3, {0xe2, 0x84, 0x98}},
+    {16338, 4, 4, {0xf0, 0x9d, 0x94, 0xb4}},
+    {16342, 5, 4, {0xf0, 0x9d, 0x95, 0xa8}},
+    {16347, 3, 3, {0xe2, 0x84, 0x98}},
+    {16350, 3, 3, {0xe2, 0x89, 0x80}},
+    {16353, 7, 3, {0xe2, 0x89, 0x80}},
+    {16360, 5, 4, {0xf0, 0x9d, 0x93, 0x8c}},
+    {16365, 5, 3, {0xe2, 0x8b, 0x82}},
+    {16370, 6, 3, {0xe2, 0x97, 0xaf}},
+    {16376, 5, 3, {0xe2, 0x8b, 0x83}},
+    {16381, 6, 3, {0xe2, 0x96, 0xbd}},
+    {16387, 4, 4, {0xf0, 0x9d, 0x94, 0xb5}},
+    {16391, 6, 3, {0xe2, 0x9f, 0xba}},
+    {16397, 6, 3, {0xe2, 0x9f, 0xb7}},
+    {16403, 3, 2, {0xce, 0xbe}},
+    {16406, 6, 3, {0xe2, 0x9f, 0xb8}},
+    {16412, 6, 3, {0xe2, 0x9f, 0xb5}},
+    {16418, 5, 3, {0xe2, 0x9f, 0xbc}},
+    {16423, 5, 3, {0xe2, 0x8b, 0xbb}},
+    {16428, 6, 3, {0xe2, 0xa8, 0x80}},
+    {16434, 5, 4, {0xf0, 0x9d, 0x95, 0xa9}},
+    {16439, 7, 3, {0xe2, 0xa8, 0x81}},
+    {16446, 7, 3, {0xe2, 0xa8, 0x82}},
+    {16453, 6, 3, {0xe2, 0x9f, 0xb9}},
+    {16459, 6, 3, {0xe2, 0x9f, 0xb6}},
+    {16465, 5, 4, {0xf0, 0x9d, 0x93, 0x8d}},
+    {16470, 7, 3, {0xe2, 0xa8, 0x86}},
+    {16477, 7, 3, {0xe2, 0xa8, 0x84}},
+    {16484, 6, 3, {0xe2, 0x96, 0xb3}},
+    {16490, 5, 3, {0xe2, 0x8b, 0x81}},
+    {16495, 7, 3, {0xe2, 0x8b, 0x80}},
+    {16502, 6, 2, {0xc3, 0xbd}},
+    {16508, 7, 2, {0xc3, 0xbd}},
+    {16515, 5, 2, {0xd1, 0x8f}},
+    {16520, 6, 2, {0xc5, 0xb7}},
+    {16526, 4, 2, {0xd1, 0x8b}},
+    {16530, 3, 2, {0xc2, 0xa5}},
+    {16533, 4, 2, {0xc2, 0xa5}},
+    {16537, 4, 4, {0xf0, 0x9d, 0x94, 0xb6}},
+    {16541, 5, 2, {0xd1, 0x97}},
+    {16546, 5, 4, {0xf0, 0x9d, 0x95, 0xaa}},
+    {16551, 5, 4, {0xf0, 0x9d, 0x93, 0x8e}},
+    {16556, 5, 2, {0xd1, 0x8e}},
+    {16561, 4, 2, {0xc3, 0xbf}},
+    {16565, 5, 2, {0xc3, 0xbf}},
+    {16570, 7, 2, {0xc5, 0xba}},
+    {16577, 7, 2, {0xc5, 0xbe}},
+    {16584, 4, 2, {0xd0, 0xb7}},
+    {16588, 5, 2, {0xc5, 0xbc}},
+    {16593, 7, 3, {0xe2, 0x84, 0xa8}},
+    {16600, 5, 2, {0xce, 0xb6}},
+    {16605, 4, 4, {0xf0, 0x9d, 0x94, 0xb7}},
+    {16609, 5, 2, {0xd0, 0xb6}},
+    {16614, 8, 3, {0xe2, 0x87, 0x9d}},
+    {16622, 5, 4, {0xf0, 0x9d, 0x95, 0xab}},
+    {16627, 5, 4, {0xf0, 0x9d, 0x93, 0x8f}},
+    {16632, 4, 3, {0xe2, 0x80, 0x8d}},
+    {16636, 5, 3, {0xe2, 0x80, 0x8c}},
+};
+
+static const u16 pg_html_entity_seeds[PG_HTML_ENTITY_BUCKETS_LEN] = {
+    3, 5, 3, 2, 2, 1, 4, 2, 1, 1, 1, 4,
+    3, 2, 2, 0, 1, 1, 0, 5, 2, 1, 8, 0,
+    1, 2, 2, 0, 1, 3, 0, 1, 3, 2, 3, 3,
+    1, 7, 4, 2, 2, 1, 2, 1, 2, 2, 2, 0,
+    2, 4, 0, 1, 1, 2, 2, 2, 1, 3, 6, 1,
+    2, 0, 2, 0, 2, 2, 3, 1, 1, 0, 1, 4,
+    4, 1, 3, 2, 2, 3, 0, 3, 1, 1, 0, 1,
+    1, 1, 5, 2, 1, 1, 1, 1, 1, 0, 2, 1,
+    1, 1, 2, 1, 1, 1, 3, 1, 3, 1, 1, 7,
+    2, 3, 0, 4, 1, 1, 14, 6, 1, 7, 2, 17,
+    1, 1, 2, 1, 3, 1, 0, 1, 1, 8, 1, 1,
+    1, 2, 22, 1, 7, 1, 1, 1, 1, 0, 1, 2,
+    7, 0, 8, 1, 6, 1, 5, 0, 2, 1, 2, 1,
+    1, 2, 1, 2, 2, 2, 3, 0, 2, 2, 2, 1,
+    6, 1, 1, 1, 1, 1, 1, 1, 3, 8, 1, 0,
+    1, 1, 1, 7, 4, 1, 9, 1, 1, 0, 1, 2,
+    1, 1, 1, 1, 7, 4, 2, 6, 1, 3, 5, 1,
+    0, 1, 1, 1, 1, 2, 1, 8, 2, 1, 1, 2,
+    1, 1, 0, 5, 4, 1, 1, 1, 0, 2, 1, 2,
+    6, 1, 1, 1, 1, 1, 3, 1, 4, 1, 2, 1,
+    1, 1, 1, 2, 2, 3, 0, 4, 3, 1, 0, 2,
+    0, 43, 1, 2, 3, 2, 6, 1, 4, 1, 8, 1,
+    11, 14, 3, 5, 16, 0, 1, 1, 1, 2, 6, 2,
+    4, 2, 4, 1, 1, 4, 1, 4, 0, 0, 64, 2,
+    1, 3, 1, 1, 2, 1, 1, 3, 2, 1, 4, 1,
+    0, 5, 5, 1, 2, 2, 1, 1, 0, 1, 1, 0,
+    5, 1, 5, 2, 1, 3, 3, 3, 0, 1, 7, 9,
+    1, 3, 3, 0, 6, 1, 3, 2, 1, 0, 0, 3,
+    6, 1, 1, 1, 1, 17, 1, 7, 5, 2, 2, 1,
+    3, 2, 1, 2, 0, 5, 7, 3, 1, 2, 2, 0,
+    0, 1, 1, 1, 1, 1, 1, 3, 3, 1, 4, 1,
+    7, 3, 3, 1, 0, 1, 3, 5, 1, 2, 6, 4,
+    18, 2, 1, 2, 1, 4, 1, 2, 2, 1, 1, 1,
+    1, 4, 3, 1, 4, 5, 3, 1, 2, 1, 1, 1,
+    4, 3, 1, 3, 3, 6, 1, 16, 3, 4, 7, 1,
+    1, 3, 0, 9, 1, 3, 0, 9, 4, 0, 3, 10,
+    2, 1, 0, 3, 57, 6, 1, 1, 2, 0, 5, 20,
+    1, 2, 3, 2, 1, 1, 2, 3, 7, 1, 0, 1,
+    4, 1, 2, 5, 1, 1, 1, 0, 1, 1, 0, 1,
+    1, 5, 1, 1, 1, 4, 0, 2, 2, 2, 4, 0,
+    1, 1, 6, 2, 1, 0, 1, 4, 2, 1, 1, 0,
+    2, 1, 0, 64, 2, 1, 1, 1, 2, 2, 3, 1,
+    1, 14, 1, 1, 1, 1, 3, 2, 1, 2, 3, 1,
+    27, 1, 64, 5, 3, 1, 1, 1, 0, 7, 1, 1,
+    64, 1, 5, 4, 5, 1, 3, 4, 1, 1, 1, 3,
+    1, 2, 5, 0, 3, 2, 0, 1, 0, 1, 1, 2,
+    4, 5, 2, 2, 2, 2, 1, 9, 11, 1, 1, 0,
+    1, 0, 2, 4, 1, 2, 2, 1, 0, 4, 3, 1,
+    11, 3, 0, 1, 14, 5, 1, 0, 1, 2, 2, 0,
+    1, 2, 6, 0, 1, 2, 4, 0, 1, 20, 3, 65,
+    1, 5, 47, 1, 1, 3, 2, 1, 1, 1, 8, 16,
+    2, 1, 0, 6, 64, 50, 1, 64, 2, 0, 1, 9,
+    1, 2, 9, 1, 2, 4, 3, 5, 1, 1, 3, 0,
+    26, 2, 0, 4, 1, 1, 4, 0, 1, 0, 3, 1,
+    2, 1, 2, 5, 0, 0, 0, 1, 1, 4, 0, 1,
+    6, 3, 0, 5, 2, 2, 0, 17, 6, 0, 1, 2,
+    1, 10, 2, 1, 2, 2, 1, 1, 1, 1, 2, 0,
+    1, 17, 0, 1, 33, 1, 1, 6, 1, 5, 2, 0,
+    1, 1, 25, 3, 3, 2, 1, 1, 2, 0, 64, 1,
+    1, 21, 2, 1, 2, 1, 1, 3, 7, 3, 1, 4,
+    0, 2, 16, 7, 10, 3, 7, 2, 31, 64, 1, 1,
+    2, 2, 4, 0, 2, 5, 2, 2, 3, 2, 1, 3,
+    7, 4, 2, 4, 1, 1, 6, 0, 5, 4, 1, 4,
+    1, 3, 3, 29, 1, 6, 3, 2, 1, 9, 2, 2,
+    1, 0, 2, 10, 7, 5, 0, 1, 2, 5, 0, 3,
+    33, 10, 1, 4, 1, 3, 9, 1, 3, 0, 2, 1,
+    2, 3, 1, 4, 1, 3, 1, 6, 2, 47, 5, 4,
+    1, 5, 1, 2, 6, 2, 0, 3, 1, 3, 1, 1,
+    4, 1, 2, 1, 1, 5, 1, 4, 0, 12, 2, 3,
+    2, 8, 2, 73, 1, 4, 0, 1, 1, 3, 1, 2,
+    1, 9, 4, 2, 2, 1, 1, 67, 17, 0, 0, 3,
+    1, 3, 2, 3, 8, 2, 5, 9, 2, 4, 6, 5,
+    1, 0, 2, 6, 1, 2, 4, 2, 3, 6, 5, 0,
+    3, 1, 13, 0, 1, 3, 3, 1, 2, 1, 2, 4,
+    2, 3, 0, 6, 6, 2, 2, 1, 1, 3, 2, 2,
+    3, 2, 1, 2, 68, 1, 2, 2, 3, 1, 1, 9,
+    3, 2, 66, 1, 4, 10, 4, 1, 3, 1, 3, 1,
+    1, 1, 4, 0, 2, 64, 1, 5, 1, 1, 2, 1,
+    39, 30, 0, 9, 8, 2, 4, 1, 1, 34, 2, 1,
+    4, 2, 5, 3, 6, 2, 1, 2, 3, 3, 4, 6,
+    0, 0, 0, 1, 0, 2, 3, 1, 10, 3, 1, 1,
+    4, 0, 4, 0, 0, 1, 1, 19, 0, 2, 1, 1,
+    66, 2, 5, 4, 1, 12, 0, 2, 1, 4, 0, 0,
+    65, 3, 11, 11, 2, 25, 2, 5, 3, 4, 2, 3,
+    1, 8, 1, 1, 2, 3, 1, 2, 5, 2, 1, 1,
+    2, 2, 2, 3,
+};
+
+static const u16 pg_html_entity_slots[PG_HTML_ENTITY_SLOTS_LEN] = {
+    0, 548, 1648, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    369, 1904, 0, 1070, 0, 2156, 1814, 2026, 0, 1649, 241, 0,
+    0, 1423, 344, 0, 428, 0, 0, 1220, 1499, 1263, 0, 0,
+    1306, 1823, 1959, 361, 1850, 1435, 2185, 0, 0, 0, 1396, 160,
+    1984, 0, 2074, 2031, 0, 0, 852, 1742, 1246, 0, 161, 2108,
+    318, 0, 0, 0, 1317, 0, 1077, 720, 0, 0, 1381, 0,
+    1769, 928, 1305, 808, 1131, 0, 120, 2130, 0, 0, 0, 2060,
+    949, 0, 1030, 0, 0, 1947, 0, 0, 0, 1456, 0, 0,
+    0, 1450, 386, 383, 398, 0, 0, 0, 0, 0, 1523, 0,
+    1600, 0, 933, 594, 0, 0, 0, 2148, 1340, 0, 0, 0,
+    0, 0, 0, 2035, 0, 452, 0, 2186, 1709, 1408, 0, 2149,
+    0, 0, 1415, 2230, 0, 1096, 0, 0, 0, 2168, 0, 1047,
+    0, 1669, 975, 1269, 0, 1235, 0, 1043, 1018, 0, 2163, 1672,
+    0, 487, 0, 0, 686, 1625, 1401, 0, 1133, 1186, 0, 0,
+    1237, 1050, 2023, 1182, 40, 0, 1832, 0, 315, 0, 1717, 0,
+    0, 0, 1575, 270, 0, 1538, 1347, 1185, 1219, 420, 0, 1370,
+    267, 0, 1244, 0, 1853, 1000, 410, 1780, 0, 341, 702, 1041,
+    0, 2103, 435, 0, 1482, 0, 1785, 0, 818, 503, 799, 1378,
+    1437, 0, 0, 0, 1338, 821, 0, 1249, 275, 0, 0, 772,
+    558, 0, 2161, 0, 1811, 0, 171, 0, 0, 167, 446, 0,
+    0, 278, 1256, 1008, 0, 0, 127, 77, 0, 0, 1640, 668,
+    468, 0, 0, 1167, 0, 644, 1164, 162, 0, 1221, 1014, 0,
+    0, 68, 0, 878, 1594, 0, 109, 0, 0, 1440, 2015, 0,
+    2008, 0, 0, 0, 1901, 0, 346, 183, 0, 0, 844, 0,
+    1631, 2201, 0, 58, 1020, 2146, 181, 257, 1671, 1228, 501, 718,
+    0, 0, 0, 795, 0, 0, 1326, 0, 1985, 2225, 339, 751,
+    1214, 1117, 2169, 831, 23, 1285, 1714, 0, 1429, 0, 0, 0,
+    580, 1215, 437, 390, 0, 0, 2106, 280, 978, 1410, 1781, 1361,
+    377, 32, 0, 906, 0, 2077, 243, 0, 0, 0, 90, 0,
+    1229, 0, 0, 0, 760, 0, 22, 0, 1040, 0, 0, 365,
+    1076, 1590, 2070, 0, 1609, 0, 1161, 0, 0, 0, 1962, 0,
+    0, 833, 0, 0, 803, 1626, 887, 1703, 0, 1593, 0, 0,
+    2085, 1002, 1069, 1463, 0, 1311, 0, 0, 1554, 1162, 0, 0,
+    912, 1476, 2044, 563, 0, 0, 0, 1706, 0, 0, 0, 507,
+    0, 905, 0, 471, 0, 0, 1486, 1420, 528, 682, 0, 0,
+    672, 1754, 575, 0, 478, 1132, 0, 1015, 823, 262, 0, 1330,
+    496, 0, 0, 0, 0, 0, 927, 0, 862, 0, 1176, 2041,
+    0, 1105, 0, 0, 0, 593, 0, 0, 0, 1038, 0, 0,
+    877, 0, 0, 0, 50, 0, 0, 2063, 1345, 1122, 1885, 792,
+    459, 2143, 1403, 0, 1836, 0, 0, 1634, 1071, 1304, 1768, 192,
+    0, 0, 463, 0, 2048, 0, 0, 0, 0, 1772, 0, 1592,
+    1150, 0, 0, 492, 320, 0, 1028, 1477, 0, 1895, 881, 2134,
+    1033, 289, 0, 0, 0, 217, 0, 0, 11, 0, 791, 1761,
+    0, 416, 0, 0, 1981, 0, 587, 259, 0, 166, 0, 1654,
+    1458, 0, 657, 159, 0, 1582, 914, 0, 0, 0, 606, 0,
+    1584, 0, 0, 378, 0, 1806, 0, 0, 1974, 1383, 0, 0,
+    0, 0, 269, 0, 0, 213, 1371, 1446, 1484, 0, 627, 0,
+    0, 2056, 982, 1400, 0, 984, 1467, 1792, 1506, 0, 0, 0,
+    1559, 85, 1691, 0, 1085, 1068, 0, 0, 858, 1223, 0, 0,
+    0, 0, 796, 945, 1775, 0, 0, 395, 0, 0, 0, 375,
+    1565, 180, 534, 0, 1994, 0, 2160, 812, 0, 1413, 0, 0,
+    1980, 401, 989, 0, 1503, 484, 0, 1053, 1101, 0, 110, 0,
+    797, 1145, 0, 143, 0, 1207, 755, 0, 399, 0, 1419, 0,
+    0, 0, 0, 0, 1382, 0, 1322, 64, 1695, 0, 0, 660,
+    382, 163, 0, 0, 0, 635, 0, 0, 185, 991, 2220, 0,
+    0, 1826, 0, 0, 1858, 0, 0, 973, 0, 0, 1535, 0,
+    1782, 1498, 0, 646, 0, 2067, 610, 1386, 1296, 0, 29, 1147,
+    1156, 0, 1148, 953, 993, 0, 1387, 1563, 1758, 0, 802, 0,
+    1566, 816, 943, 747, 0, 1929, 0, 1143, 287, 1196, 583, 738,
+    0, 0, 0, 0, 0, 1393, 1260, 2102, 37, 590, 0, 2207,
+    495, 0, 1723, 0, 0, 1279, 493, 0, 908, 1932, 1579, 565,
+    0, 0, 1111, 0, 0, 715, 0, 0, 448, 851, 0, 1491,
+    1483, 843, 1255, 0, 0, 642, 1287, 1967, 1572, 0, 0, 571,
+    1353, 0, 0, 572, 0, 2062, 0, 1035, 0, 891, 1444, 0,
+    0, 0, 0, 1845, 1837, 194, 0, 0, 0, 0, 737, 102,
+    865, 502, 758, 1048, 559, 1056, 977, 0, 0, 0, 1760, 615,
+    0, 308, 0, 1611, 465, 56, 633, 1488, 0, 438, 0, 0,
+    0, 1278, 0, 0, 1587, 0, 152, 0, 0, 708, 2079, 226,
+    1731, 0, 652, 0, 556, 589, 832, 1638, 258, 0, 1928, 0,
+    0, 0, 99, 1517, 781, 0, 1740, 1356, 2144, 1136, 944, 229,
+    236, 1556, 0, 0, 1368, 0, 1667, 1492, 0, 0, 0, 842,
+    0, 182, 1179, 1398, 0, 0, 0, 554, 0, 1926, 805, 1341,
+    0, 1183, 1627, 125, 1211, 2053, 1329, 0, 0, 1705, 0, 154,
+    602, 2076, 750, 910, 421, 0, 1704, 1827, 0, 0, 379, 651,
+    0, 215, 1899, 0, 0, 1108, 1265, 1431, 2071, 2119, 370, 0,
+    1543, 0, 0, 1790, 1920, 888, 347, 0, 667, 0, 135, 0,
+    1281, 1225, 0, 719, 1301, 0, 0, 1944, 136, 1115, 0, 1852,
+    0, 0, 0, 1616, 1940, 151, 1945, 1957, 0, 0, 1137, 0,
+    0, 1294, 0, 0, 1103, 0, 2057, 2018, 0, 1125, 0, 0,
+    0, 0, 1097, 0, 0, 0, 0, 1507, 0, 1809, 2165, 0,
+    706, 74, 0, 303, 0, 0, 0, 2090, 1816, 1426, 0, 0,
+    0, 873, 0, 474, 0, 494, 0, 1657, 0, 930, 0, 0,
+    632, 1605, 1100, 0, 0, 358, 1848, 349, 0, 0, 1930, 2125,
+    0, 1791, 2205, 0, 0, 2200, 1524, 2105, 701, 1643, 0, 0,
+    0, 0, 1198, 273, 0, 0, 0, 45, 0, 0, 0, 1912,
+    0, 0, 0, 1762, 0, 0, 986, 679, 184, 814, 1835, 0,
+    0, 0, 1727, 0, 0, 0, 1083, 0, 0, 1662, 0, 1351,
+    637, 1560, 295, 0, 0, 0, 1699, 1532, 1894, 1019, 779, 0,
+    0, 0, 1866, 0, 0, 1251, 744, 1233, 2173, 0, 542, 957,
+    0, 1169, 0, 0, 0, 825, 619, 0, 1222, 1399, 265, 0,
+    0, 0, 1716, 1747, 1470, 0, 1905, 1349, 141, 0, 1621, 0,
+    0, 0, 1540, 0, 0, 256, 0, 0, 2021, 0, 0, 0,
+    740, 1195, 0, 2014, 362, 0, 0, 312, 0, 530, 1693, 263,
+    1203, 0, 0, 0, 0, 2055, 0, 0, 624, 1046, 1986, 694,
+    0, 0, 2187, 0, 1226, 364, 2045, 0, 2224, 0, 1448, 1479,
+    356, 432, 0, 1007, 1786, 0, 588, 233, 620, 1596, 353, 1471,
+    0, 0, 636, 0, 1261, 6, 0, 480, 0, 0, 0, 1551,
+    1690, 1862, 1036, 0, 2010, 0, 1857, 0, 0, 0, 242, 1180,
+    0, 380, 2219, 675, 1595, 1906, 1327, 0, 0, 0, 0, 0,
+    485, 1295, 292, 0, 0, 488, 907, 0, 0, 1283, 0, 121,
+    0, 0, 266, 1257, 0, 1236, 0, 1843, 0, 2196, 0, 1171,
+    227, 0, 0, 0, 520, 2003, 0, 0, 2175, 2095, 0, 0,
+    0, 2029, 0, 0, 0, 0, 0, 566, 1571, 0, 1079, 0,
+    1375, 515, 0, 1877, 1939, 902, 279, 1335, 1331, 950, 0, 2227,
+    1659, 2078, 0, 0, 0, 0, 0, 618, 591, 935, 0, 2142,
+    0, 1430, 1647, 1859, 0, 0, 1501, 0, 937, 0, 0, 525,
+    508, 0, 1124, 1601, 0, 418, 0, 1119, 1518, 0, 0, 1485,
+    212, 500, 0, 0, 0, 1770, 460, 0, 1130, 0, 535, 1248,
+    0, 0, 0, 1911, 83, 2120, 1856, 0, 585, 690, 1863, 1332,
+    0, 0, 1449, 1022, 2051, 0, 147, 0, 132, 1286, 366, 2157,
+    0, 0, 0, 0, 0, 0, 787, 1321, 665, 1104, 0, 1230,
+    0, 1109, 2198, 2147, 1160, 2210, 0, 0, 0, 0, 0, 396,
+    0, 1395, 0, 1252, 0, 0, 1502, 0, 0, 0, 1824, 0,
+    359, 543, 0, 1869, 0, 0, 1890, 0, 0, 0, 2177, 1184,
+    0, 0, 1779, 0, 551, 0, 0, 1652, 1138, 0, 1607, 0,
+    250, 0, 0, 25, 1712, 223, 753, 1581, 0, 148, 0, 0,
+    0, 0, 3, 582, 1795, 0, 1292, 1624, 0, 0, 1732, 2216,
+    669, 2202, 2133, 0, 0, 826, 0, 57, 0, 1316, 0, 612,
+    2179, 65, 0, 567, 746, 0, 0, 0, 0, 10, 397, 0,
+    0, 838, 0, 0, 325, 836, 228, 2088, 2007, 0, 0, 0,
+    0, 1312, 1027, 0, 1516, 2082, 625, 0, 1847, 0, 0, 1099,
+    0, 1777, 0, 0, 1152, 0, 0, 868, 76, 284, 0, 0,
+    1992, 1730, 0, 0, 940, 0, 1490, 955, 0, 0, 1619, 1876,
+    0, 169, 0, 1834, 0, 355, 0, 0, 0, 2181, 0, 1880,
+    0, 0, 0, 1144, 0, 165, 0, 595, 334, 14, 748, 879,
+    1157, 0, 0, 513, 0, 0, 1991, 0, 413, 0, 0, 1436,
+    0, 0, 1589, 1550, 0, 1106, 0, 89, 512, 0, 1783, 1898,
+    1965, 0, 0, 1557, 216, 1988, 335, 225, 0, 0, 0, 0,
+    0, 113, 0, 0, 0, 1831, 0, 626, 255, 0, 128, 0,
+    0, 0, 1771, 1472, 2215, 0, 951, 0, 1603, 2193, 0, 1766,
+    0, 1004, 1897, 0, 0, 2038, 0, 0, 0, 0, 376, 628,
+    870, 343, 0, 0, 1194, 0, 552, 1793, 0, 0, 0, 0,
+    0, 640, 0, 0, 391, 0, 0, 0, 916, 2194, 0, 202,
+    0, 1009, 1267, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 498, 0, 0, 0, 0, 2164, 0, 0, 0, 1829, 0,
+    1264, 0, 0, 188, 0, 1418, 1365, 2115, 419, 0, 726, 0,
+    244, 2037, 0, 676, 2145, 0, 0, 1439, 0, 2217, 71, 509,
+    742, 0, 1112, 0, 363, 647, 0, 0, 1023, 1359, 0, 0,
+    157, 1407, 0, 1080, 2170, 2203, 0, 2059, 2172, 374, 2114, 0,
+    1424, 0, 0, 0, 1881, 1242, 0, 658, 0, 1209, 763, 219,
+    0, 0, 1175, 1935, 288, 854, 371, 1414, 820, 1661, 1363, 0,
+    1729, 0, 505, 0, 1487, 857, 1362, 0, 0, 764, 0, 0,
+    1241, 1385, 918, 2137, 211, 5, 1095, 0, 0, 326, 1318, 711,
+    557, 302, 0, 1445, 0, 78, 0, 931, 274, 0, 1800, 1001,
+    1081, 4, 1240, 0, 573, 806, 654, 1615, 427, 0, 0, 134,
+    0, 357, 0, 1394, 924, 0, 1481, 1639, 2064, 0, 0, 0,
+    1908, 1774, 0, 479, 1193, 1405, 714, 0, 696, 48, 0, 599,
+    0, 434, 1805, 0, 0, 0, 0, 1736, 13, 0, 69, 1177,
+    1688, 1166, 1522, 2191, 1888, 2222, 2184, 140, 73, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 1674, 1433, 0, 1135, 0, 0,
+    0, 1298, 126, 252, 0, 0, 0, 323, 0, 0, 880, 848,
+    222, 0, 1090, 0, 384, 0, 0, 1955, 936, 0, 962, 1534,
+    574, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0,
+    0, 2122, 0, 139, 21, 0, 306, 79, 0, 1528, 1822, 1685,
+    0, 251, 1320, 1057, 1172, 656, 1933, 449, 490, 300, 1005, 477,
+    0, 321, 1086, 1453, 510, 1938, 337, 447, 0, 0, 2072, 2162,
+    0, 1921, 0, 0, 0, 725, 0, 173, 0, 0, 974, 2036,
+    0, 1562, 0, 0, 411, 789, 0, 80, 0, 0, 0, 282,
+    0, 0, 0, 638, 0, 1120, 1003, 1021, 0, 985, 0, 2113,
+    0, 0, 0, 1591, 0, 721, 0, 0, 0, 845, 898, 1245,
+    0, 2042, 1323, 1276, 0, 144, 1059, 1128, 0, 939, 0, 1392,
+    0, 0, 0, 0, 0, 0, 392, 1821, 2087, 1739, 1896, 2099,
+    0, 0, 1937, 730, 0, 0, 1678, 0, 450, 100, 0, 533,
+    641, 0, 809, 1902, 96, 0, 1367, 0, 0, 889, 0, 415,
+    1063, 1745, 0, 1293, 1963, 0, 0, 0, 2212, 0, 0, 0,
+    1072, 0, 0, 0, 970, 0, 1374, 0, 1547, 246, 0, 0,
+    2139, 0, 547, 0, 0, 0, 1250, 1204, 0, 709, 458, 0,
+    0, 0, 0, 971, 0, 1052, 759, 0, 1651, 0, 1960, 0,
+    0, 0, 0, 0, 958, 0, 393, 0, 0, 0, 734, 0,
+    0, 0, 0, 1452, 0, 0, 941, 2121, 0, 0, 0, 1325,
+    0, 0, 0, 39, 0, 0, 2228, 26, 0, 1839, 0, 0,
+    1983, 1797, 403, 0, 0, 882, 156, 201, 0, 164, 717, 0,
+    1011, 0, 0, 1494, 0, 1526, 1514, 0, 0, 1163, 827, 1082,
+    2154, 1447, 329, 1934, 1116, 837, 103, 0, 0, 1961, 0, 253,
+    2178, 1282, 1006, 0, 0, 1465, 0, 0, 1641, 521, 268, 0,
+    0, 777, 1666, 963, 1121, 0, 0, 2211, 0, 0, 55, 1525,
+    0, 1700, 899, 0, 146, 1743, 0, 1724, 1110, 1545, 1803, 0,
+    0, 0, 0, 614, 2229, 987, 1720, 0, 0, 1629, 0, 0,
+    0, 596, 1350, 2019, 0, 0, 952, 0, 0, 28, 0, 0,
+    698, 1037, 685, 1262, 1943, 1681, 1308, 0, 373, 0, 0, 1999,
+    1588, 372, 0, 622, 0, 1764, 2209, 0, 1867, 0, 856, 1577,
+    412, 0, 549, 0, 0, 0, 0, 1757, 0, 1865, 995, 2092,
+    2096, 0, 0, 0, 70, 1617, 1328, 0, 0, 0, 1860, 0,
+    2180, 511, 778, 539, 1633, 0, 0, 402, 0, 0, 0, 305,
+    731, 0, 230, 0, 529, 1849, 0, 0, 0, 0, 1455, 322,
+    207, 0, 0, 569, 0, 1438, 0, 0, 1060, 18, 1315, 0,
+    0, 0, 0, 0, 0, 0, 2040, 0, 1073, 1977, 0, 1799,
+    0, 1299, 0, 0, 187, 0, 1677, 519, 0, 0, 960, 0,
+    1539, 1227, 0, 0, 1541, 846, 0, 0, 0, 0, 0, 0,
+    0, 1552, 0, 0, 2052, 536, 1971, 145, 475, 2094, 0, 1815,
+    689, 896, 0, 0, 0, 1787, 0, 405, 2022, 598, 0, 1675,
+    0, 0, 0, 0, 0, 0, 1307, 0, 254, 0, 483, 0,
+    442, 0, 0, 649, 1558, 1357, 1508, 1942, 462, 0, 800, 1585,
+    0, 1191, 239, 523, 0, 0, 2107, 0, 861, 0, 2066, 0,
+    545, 0, 66, 0, 1817, 0, 0, 1660, 0, 316, 967, 1549,
+    0, 617, 431, 1738, 232, 555, 0, 1314, 732, 0, 49, 597,
+    1990, 2183, 853, 1973, 2024, 1598, 0, 0, 2049, 0, 0, 1291,
+    1049, 0, 2002, 221, 0, 0, 1750, 1512, 2097, 2033, 0, 1462,
+    2182, 172, 0, 59, 336, 0, 0, 631, 0, 0, 0, 0,
+    1422, 0, 0, 1173, 1796, 0, 0, 0, 909, 0, 1531, 1997,
+    1872, 1113, 1778, 360, 0, 1272, 0, 1726, 0, 1210, 0, 0,
+    248, 1146, 0, 980, 0, 876, 2065, 0, 423, 0, 0, 0,
+    0, 0, 345, 0, 0, 0, 220, 0, 0, 1734, 333, 1599,
+    872, 992, 445, 2110, 1818, 1466, 1089, 0, 27, 1034, 0, 0,
+    0, 1334, 1289, 767, 883, 0, 0, 0, 0, 137, 439, 1360,
+    486, 741, 2195, 0, 245, 771, 1564, 1277, 31, 0, 0, 0,
+    0, 2190, 331, 186, 1098, 0, 864, 0, 1372, 0, 203, 497,
+    0, 0, 0, 0, 1417, 0, 780, 0, 0, 2192, 0, 0,
+    762, 1468, 0, 863, 969, 1655, 1496, 541, 0, 0, 0, 0,
+    0, 1751, 2005, 581, 0, 0, 1570, 2189, 0, 1205, 0, 723,
+    1087, 1324, 16, 0, 757, 0, 153, 634, 0, 291, 0, 1336,
+    1982, 0, 2025, 0, 0, 688, 1553, 0, 735, 0, 101, 964,
+    1457, 0, 0, 1493, 2158, 0, 1511, 0, 1637, 0, 518, 53,
+    621, 0, 0, 1680, 0, 0, 0, 0, 713, 1140, 0, 0,
+    1900, 218, 0, 1966, 1232, 0, 0, 0, 93, 0, 666, 196,
+    0, 1746, 942, 0, 0, 0, 350, 1016, 1878, 0, 0, 506,
+    1254, 20, 1344, 193, 917, 61, 0, 604, 0, 0, 2016, 678,
+    1391, 0, 0, 0, 776, 0, 0, 0, 0, 1763, 1247, 0,
+    0, 611, 0, 0, 0, 0, 189, 788, 1239, 1238, 0, 0,
+    531, 815, 1389, 179, 0, 1404, 550, 683, 0, 0, 0, 1258,
+    1891, 235, 0, 174, 600, 756, 114, 0, 544, 0, 1950, 1956,
+    0, 1870, 0, 0, 2001, 0, 0, 224, 0, 1010, 0, 330,
+    0, 299, 0, 0, 786, 105, 0, 0, 716, 0, 607, 1045,
+    2058, 2100, 775, 1946, 1968, 0, 0, 1280, 0, 0, 1941, 2093,
+    2047, 0, 0, 0, 388, 0, 0, 38, 0, 0, 0, 0,
+    354, 0, 407, 1875, 1031, 0, 0, 0, 470, 1231, 1064, 0,
+    2138, 0, 0, 0, 0, 0, 387, 1443, 0, 532, 959, 424,
+    1379, 0, 198, 1188, 0, 0, 0, 1879, 0, 249, 2009, 0,
+    1861, 0, 1614, 564, 0, 0, 0, 0, 2153, 469, 1788, 1574,
+    659, 835, 0, 1970, 206, 52, 1719, 0, 578, 0, 997, 0,
+    409, 41, 1158, 1515, 389, 2151, 830, 461, 1200, 1733, 994, 0,
+    1339, 0, 0, 2101, 885, 817, 1366, 1189, 710, 0, 0, 1715,
+    783, 524, 0, 968, 0, 0, 0, 0, 168, 537, 1613, 774,
+    1951, 681, 0, 408, 35, 839, 1623, 1134, 0, 1469, 42, 0,
+    562, 0, 0, 1673, 1118, 972, 0, 765, 0, 0, 616, 1012,
+    0, 0, 1819, 0, 0, 0, 1529, 0, 0, 0, 0, 996,
+    1406, 1679, 1567, 0, 2123, 0, 0, 0, 0, 0, 1165, 0,
+    874, 1913, 0, 455, 0, 929, 0, 352, 901, 1741, 324, 822,
+    342, 2223, 1735, 19, 1093, 0, 0, 648, 1509, 707, 1993, 613,
+    0, 0, 584, 2081, 0, 0, 1580, 54, 630, 1576, 1342, 0,
+    1067, 1530, 0, 0, 1794, 785, 441, 281, 2083, 1217, 0, 1753,
+    1630, 0, 1218, 0, 436, 1909, 0, 770, 1268, 915, 453, 1107,
+    231, 0, 1266, 1208, 1474, 1402, 2166, 1065, 1604, 824, 0, 0,
+    0, 0, 1026, 0, 1505, 7, 0, 0, 546, 0, 1290, 0,
+    0, 1952, 0, 0, 0, 1978, 0, 34, 0, 1178, 464, 1687,
+    1519, 1919, 897, 0, 0, 947, 739, 1074, 0, 1373, 1310, 0,
+    1129, 0, 0, 1996, 729, 0, 2152, 2131, 0, 1915, 0, 1032,
+    1461, 0, 1066, 2117, 0, 0, 0, 1825, 687, 0, 1813, 697,
+    0, 297, 979, 0, 784, 296, 0, 903, 1642, 840, 0, 570,
+    1288, 1427, 15, 0, 0, 1421, 0, 0, 0, 1686, 671, 0,
+    367, 2140, 1755, 0, 1537, 1091, 0, 0, 0, 0, 1701, 0,
+    0, 0, 0, 1868, 0, 1192, 1274, 0, 2073, 1620, 0, 0,
+    0, 0, 286, 1051, 0, 0, 705, 1608, 1684, 0, 0, 0,
+    1884, 2124, 0, 990, 294, 0, 0, 1102, 1893, 768, 920, 0,
+    0, 84, 1874, 0, 922, 0, 609, 0, 1533, 444, 0, 0,
+    1798, 0, 0, 0, 158, 1586, 0, 0, 754, 2039, 0, 1062,
+    782, 0, 1903, 576, 0, 0, 608, 1473, 1224, 62, 0, 605,
+    2089, 1058, 0, 0, 773, 1916, 1871, 368, 0, 2214, 0, 0,
+    0, 1748, 0, 204, 1964, 0, 0, 1024, 197, 1597, 0, 1820,
+    404, 1451, 0, 0, 0, 1804, 0, 1187, 793, 893, 0, 394,
+    2167, 86, 0, 981, 0, 0, 2135, 860, 0, 1216, 0, 0,
+    2129, 381, 1728, 0, 1854, 2028, 0, 0, 0, 553, 0, 0,
+    0, 0, 1094, 0, 0, 0, 0, 1520, 592, 81, 0, 1682,
+    948, 0, 0, 2006, 307, 954, 0, 527, 0, 0, 1765, 0,
+    0, 1489, 0, 0, 0, 0, 481, 0, 639, 0, 1979, 1882,
+    0, 0, 0, 129, 0, 133, 2080, 0, 0, 0, 205, 209,
+    1302, 1434, 0, 175, 1243, 1300, 0, 834, 0, 692, 0, 1275,
+    2109, 0, 0, 0, 0, 75, 0, 0, 0, 0, 1802, 0,
+    1355, 94, 0, 0, 0, 961, 0, 1075, 919, 0, 1645, 0,
+    704, 283, 0, 1910, 0, 1017, 234, 0, 1664, 0, 338, 0,
+    123, 0, 0, 0, 1692, 177, 0, 272, 0, 1949, 0, 0,
+    0, 1384, 0, 0, 829, 0, 850, 1953, 1253, 0, 0, 0,
+    0, 17, 0, 0, 170, 0, 0, 0, 327, 0, 138, 653,
+    0, 1573, 0, 1752, 1668, 0, 650, 2159, 1636, 0, 0, 149,
+    0, 0, 0, 97, 0, 2206, 0, 1155, 871, 983, 0, 0,
+    932, 293, 0, 0, 0, 1092, 0, 0, 0, 1123, 1054, 0,
+    1284, 0, 1159, 1459, 0, 2075, 0, 131, 440, 433, 0, 1042,
+    1078, 238, 0, 0, 1917, 727, 457, 0, 1548, 1555, 0, 1883,
+    2126, 0, 2104, 0, 0, 2012, 724, 0, 0, 0, 0, 1855,
+    0, 0, 0, 328, 1697, 1397, 0, 0, 700, 2174, 1343, 516,
+    1696, 0, 0, 673, 0, 693, 0, 0, 934, 662, 0, 264,
+    540, 0, 0, 703, 1464, 761, 443, 332, 304, 1513, 0, 1025,
+    923, 0, 0, 674, 911, 0, 0, 0, 0, 130, 0, 0,
+    0, 0, 1055, 0, 1789, 670, 1976, 855, 0, 1801, 1948, 0,
+    2011, 0, 1432, 0, 0, 1149, 317, 414, 0, 0, 0, 0,
+    1568, 0, 309, 0, 1358, 0, 2000, 938, 119, 0, 178, 1127,
+    0, 0, 107, 1702, 0, 0, 1428, 0, 200, 1500, 0, 956,
+    1141, 0, 1088, 2034, 0, 504, 1749, 2054, 1676, 9, 0, 0,
+    1174, 1569, 0, 0, 645, 0, 1618, 0, 0, 1989, 0, 798,
+    2150, 1721, 766, 2176, 2086, 695, 1369, 0, 0, 472, 0, 2213,
+    108, 0, 476, 0, 0, 0, 0, 1841, 430, 142, 115, 1153,
+    0, 417, 0, 1197, 0, 491, 900, 36, 1925, 117, 1683, 237,
+    1653, 1454, 1202, 1887, 1084, 794, 0, 0, 2050, 0, 429, 91,
+    489, 810, 1039, 0, 2046, 12, 0, 0, 988, 0, 1975, 0,
+    0, 966, 0, 0, 2112, 790, 112, 1352, 1864, 1377, 1656, 0,
+    1698, 422, 0, 0, 1767, 0, 0, 0, 866, 0, 0, 1810,
+    2116, 623, 0, 1995, 0, 473, 0, 210, 0, 859, 2171, 722,
+    2098, 1412, 0, 456, 0, 0, 0, 0, 0, 0, 0, 0,
+    1914, 191, 2020, 0, 0, 0, 1632, 601, 0, 122, 2199, 0,
+    400, 661, 1442, 1480, 1907, 998, 894, 1886, 769, 199, 2208, 0,
+    0, 1807, 0, 1497, 699, 561, 0, 904, 1126, 1333, 1844, 0,
+    240, 0, 1376, 629, 0, 0, 43, 733, 0, 0, 0, 2218,
+    0, 801, 2004, 87, 2141, 1478, 0, 95, 0, 0, 522, 1114,
+    0, 466, 0, 1542, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1650, 1958, 0, 869, 0, 1646, 24, 0, 2204, 0, 0,
+    0, 0, 1773, 976, 0, 1892, 313, 1460, 1713, 0, 1718, 0,
+    0, 0, 847, 0, 684, 0, 0, 1583, 2155, 0, 88, 0,
+    0, 0, 1234, 1987, 2069, 0, 1319, 0, 1972, 1927, 1441, 2027,
+    0, 2231, 752, 0, 2127, 118, 1013, 0, 261, 0, 0, 0,
+    1665, 1475, 0, 867, 560, 0, 0, 925, 340, 2132, 0, 0,
+    1425, 1303, 0, 577, 1154, 51, 0, 0, 0, 0, 311, 1969,
+    0, 467, 1309, 0, 0, 0, 0, 0, 895, 0, 63, 190,
+    828, 0, 1029, 310, 247, 0, 0, 0, 0, 811, 1206, 1918,
+    586, 0, 0, 2, 1348, 0, 0, 454, 1199, 406, 1840, 0,
+    749, 214, 0, 298, 0, 1578, 0, 0, 0, 1610, 517, 804,
+    2032, 0, 1833, 1416, 0, 875, 46, 745, 1151, 1708, 285, 1873,
+    999, 849, 1527, 0, 0, 514, 0, 0, 2043, 1297, 2013, 1504,
+    0, 1922, 276, 0, 1061, 277, 0, 1510, 1190, 0, 1931, 1998,
+    0, 351, 0, 0, 0, 538, 67, 0, 0, 655, 2068, 1544,
+    0, 664, 0, 124, 1722, 0, 1635, 2226, 0, 603, 819, 0,
+    680, 0, 0, 0, 0, 1273, 1213, 1936, 1851, 0, 2128, 0,
+    2030, 0, 2136, 1354, 0, 1663, 0, 0, 2188, 1954, 1201, 0,
+    1759, 2091, 0, 813, 1744, 348, 0, 0, 0, 0, 0, 1830,
+    1889, 0, 0, 33, 0, 1711, 0, 663, 1784, 0, 1536, 0,
+    0, 1606, 0, 0, 1170, 385, 0, 736, 0, 314, 728, 691,
+    1694, 0, 0, 0, 1270, 0, 0, 1364, 0, 150, 0, 0,
+    712, 0, 0, 271, 0, 0, 0, 0, 208, 0, 1628, 1271,
+    0, 0, 0, 0, 0, 0, 1842, 0, 2221, 1756, 2197, 1812,
+    0, 0, 0, 1168, 0, 72, 1808, 60, 1259, 195, 0, 301,
+    890, 568, 1689, 0, 0, 0, 0, 1776, 0, 0, 0, 0,
+    104, 0, 841, 1612, 926, 1622, 176, 0, 0, 0, 0, 0,
+    1346, 2061, 0, 98, 0, 0, 886, 1924, 1337, 0, 0, 0,
+    0, 1602, 0, 0, 0, 155, 0, 0, 319, 290, 1737, 1313,
+    499, 892, 1495, 0, 643, 482, 260, 451, 0, 0, 0, 0,
+    106, 0, 2017, 579, 1561, 2118, 0, 1521, 1181, 0, 526, 921,
+    1142, 1380, 0, 1846, 0, 0, 1411, 0, 946, 0, 2084, 965,
+    677, 0, 116, 0, 0, 884, 30, 1923, 0, 0, 1838, 2111,
+    0, 0, 1, 1670, 1658, 913, 0, 0, 1212, 0, 743, 1388,
+    82, 0, 0, 0, 0, 0, 0, 0, 425, 0, 1044, 0,
+    1390, 807, 0, 0, 0, 0, 1710, 0, 1644, 0, 1707, 0,
+    0, 1725, 111, 1139, 47, 0, 0, 0, 426, 1828, 0, 1546,
+    1409, 92, 0, 44,
+};
+
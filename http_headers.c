@@ -0,0 +1,200 @@
+// Code generated by gen_http_headers.py. DO NOT EDIT.
+
+typedef enum : u8 {
+  PG_HTTP_HEADER_ID_NONE, // Not a well-known header.
+  PG_HTTP_HEADER_ID_ACCEPT,
+  PG_HTTP_HEADER_ID_ACCEPT_CHARSET,
+  PG_HTTP_HEADER_ID_ACCEPT_ENCODING,
+  PG_HTTP_HEADER_ID_ACCEPT_LANGUAGE,
+  PG_HTTP_HEADER_ID_ACCEPT_RANGES,
+  PG_HTTP_HEADER_ID_ACCESS_CONTROL_ALLOW_CREDENTIALS,
+  PG_HTTP_HEADER_ID_ACCESS_CONTROL_ALLOW_HEADERS,
+  PG_HTTP_HEADER_ID_ACCESS_CONTROL_ALLOW_METHODS,
+  PG_HTTP_HEADER_ID_ACCESS_CONTROL_ALLOW_ORIGIN,
+  PG_HTTP_HEADER_ID_ACCESS_CONTROL_EXPOSE_HEADERS,
+  PG_HTTP_HEADER_ID_ACCESS_CONTROL_MAX_AGE,
+  PG_HTTP_HEADER_ID_ACCESS_CONTROL_REQUEST_HEADERS,
+  PG_HTTP_HEADER_ID_ACCESS_CONTROL_REQUEST_METHOD,
+  PG_HTTP_HEADER_ID_AGE,
+  PG_HTTP_HEADER_ID_ALLOW,
+  PG_HTTP_HEADER_ID_AUTHORIZATION,
+  PG_HTTP_HEADER_ID_CACHE_CONTROL,
+  PG_HTTP_HEADER_ID_CONNECTION,
+  PG_HTTP_HEADER_ID_CONTENT_DISPOSITION,
+  PG_HTTP_HEADER_ID_CONTENT_ENCODING,
+  PG_HTTP_HEADER_ID_CONTENT_LANGUAGE,
+  PG_HTTP_HEADER_ID_CONTENT_LENGTH,
+  PG_HTTP_HEADER_ID_CONTENT_LOCATION,
+  PG_HTTP_HEADER_ID_CONTENT_RANGE,
+  PG_HTTP_HEADER_ID_CONTENT_SECURITY_POLICY,
+  PG_HTTP_HEADER_ID_CONTENT_TYPE,
+  PG_HTTP_HEADER_ID_COOKIE,
+  PG_HTTP_HEADER_ID_DATE,
+  PG_HTTP_HEADER_ID_ETAG,
+  PG_HTTP_HEADER_ID_EXPECT,
+  PG_HTTP_HEADER_ID_EXPIRES,
+  PG_HTTP_HEADER_ID_FORWARDED,
+  PG_HTTP_HEADER_ID_FROM,
+  PG_HTTP_HEADER_ID_HOST,
+  PG_HTTP_HEADER_ID_IF_MATCH,
+  PG_HTTP_HEADER_ID_IF_MODIFIED_SINCE,
+  PG_HTTP_HEADER_ID_IF_NONE_MATCH,
+  PG_HTTP_HEADER_ID_IF_RANGE,
+  PG_HTTP_HEADER_ID_IF_UNMODIFIED_SINCE,
+  PG_HTTP_HEADER_ID_KEEP_ALIVE,
+  PG_HTTP_HEADER_ID_LAST_MODIFIED,
+  PG_HTTP_HEADER_ID_LINK,
+  PG_HTTP_HEADER_ID_LOCATION,
+  PG_HTTP_HEADER_ID_MAX_FORWARDS,
+  PG_HTTP_HEADER_ID_ORIGIN,
+  PG_HTTP_HEADER_ID_PRAGMA,
+  PG_HTTP_HEADER_ID_PROXY_AUTHENTICATE,
+  PG_HTTP_HEADER_ID_PROXY_AUTHORIZATION,
+  PG_HTTP_HEADER_ID_RANGE,
+  PG_HTTP_HEADER_ID_REFERER,
+  PG_HTTP_HEADER_ID_RETRY_AFTER,
+  PG_HTTP_HEADER_ID_SERVER,
+  PG_HTTP_HEADER_ID_SET_COOKIE,
+  PG_HTTP_HEADER_ID_STRICT_TRANSPORT_SECURITY,
+  PG_HTTP_HEADER_ID_TE,
+  PG_HTTP_HEADER_ID_TRAILER,
+  PG_HTTP_HEADER_ID_TRANSFER_ENCODING,
+  PG_HTTP_HEADER_ID_UPGRADE,
+  PG_HTTP_HEADER_ID_USER_AGENT,
+  PG_HTTP_HEADER_ID_VARY,
+  PG_HTTP_HEADER_ID_VIA,
+  PG_HTTP_HEADER_ID_WWW_AUTHENTICATE,
+  PG_HTTP_HEADER_ID_X_CONTENT_TYPE_OPTIONS,
+  PG_HTTP_HEADER_ID_X_FORWARDED_FOR,
+  PG_HTTP_HEADER_ID_X_FORWARDED_PROTO,
+  PG_HTTP_HEADER_ID_X_FRAME_OPTIONS,
+  PG_HTTP_HEADER_ID_X_REQUESTED_WITH,
+  PG_HTTP_HEADER_ID_COUNT,
+} PgHttpHeaderId;
+
+#define PG_HTTP_HEADER_SEED 64U
+#define PG_HTTP_HEADER_SLOTS_LEN 512
+
+static const char pg_http_header_prefixes[] =
+    "Accept: Accept-Charset: Accept-Encoding: Accept-Language: "
+    "Accept-Ranges: Access-Control-Allow-Credentials: "
+    "Access-Control-Allow-Headers: Access-Control-Allow-Methods: "
+    "Access-Control-Allow-Origin: Access-Control-Expose-Headers: "
+    "Access-Control-Max-Age: Access-Control-Request-Headers: "
+    "Access-Control-Request-Method: Age: Allow: Authorization: "
+    "Cache-Control: Connection: Content-Disposition: Content-Encoding: "
+    "Content-Language: Content-Length: Content-Location: Content-Range: "
+    "Content-Security-Policy: Content-Type: Cookie: Date: ETag: Expect: "
+    "Expires: Forwarded: From: Host: If-Match: If-Modified-Since: "
+    "If-None-Match: If-Range: If-Unmodified-Since: Keep-Alive: "
+    "Last-Modified: Link: Location: Max-Forwards: Origin: Pragma: "
+    "Proxy-Authenticate: Proxy-Authorization: Range: Referer: Retry-After: "
+    "Server: Set-Cookie: Strict-Transport-Security: TE: Trailer: "
+    "Transfer-Encoding: Upgrade: User-Agent: Vary: Via: WWW-Authenticate: "
+    "X-Content-Type-Options: X-Forwarded-For: X-Forwarded-Proto: "
+    "X-Frame-Options: X-Requested-With: ";
+
+static const PgString pg_http_header_names[PG_HTTP_HEADER_ID_COUNT] = {
+    [PG_HTTP_HEADER_ID_ACCEPT] = {(u8 *)pg_http_header_prefixes + 0, 6},
+    [PG_HTTP_HEADER_ID_ACCEPT_CHARSET] = {(u8 *)pg_http_header_prefixes + 8, 14},
+    [PG_HTTP_HEADER_ID_ACCEPT_ENCODING] = {(u8 *)pg_http_header_prefixes + 24, 15},
+    [PG_HTTP_HEADER_ID_ACCEPT_LANGUAGE] = {(u8 *)pg_http_header_prefixes + 41, 15},
+    [PG_HTTP_HEADER_ID_ACCEPT_RANGES] = {(u8 *)pg_http_header_prefixes + 58, 13},
+    [PG_HTTP_HEADER_ID_ACCESS_CONTROL_ALLOW_CREDENTIALS] = {(u8 *)pg_http_header_prefixes + 73, 32},
+    [PG_HTTP_HEADER_ID_ACCESS_CONTROL_ALLOW_HEADERS] = {(u8 *)pg_http_header_prefixes + 107, 28},
+    [PG_HTTP_HEADER_ID_ACCESS_CONTROL_ALLOW_METHODS] = {(u8 *)pg_http_header_prefixes + 137, 28},
+    [PG_HTTP_HEADER_ID_ACCESS_CONTROL_ALLOW_ORIGIN] = {(u8 *)pg_http_header_prefixes + 167, 27},
+    [PG_HTTP_HEADER_ID_ACCESS_CONTROL_EXPOSE_HEADERS] = {(u8 *)pg_http_header_prefixes + 196, 29},
+    [PG_HTTP_HEADER_ID_ACCESS_CONTROL_MAX_AGE] = {(u8 *)pg_http_header_prefixes + 227, 22},
+    [PG_HTTP_HEADER_ID_ACCESS_CONTROL_REQUEST_HEADERS] = {(u8 *)pg_http_header_prefixes + 251, 30},
+    [PG_HTTP_HEADER_ID_ACCESS_CONTROL_REQUEST_METHOD] = {(u8 *)pg_http_header_prefixes + 283, 29},
+    [PG_HTTP_HEADER_ID_AGE] = {(u8 *)pg_http_header_prefixes + 314, 3},
+    [PG_HTTP_HEADER_ID_ALLOW] = {(u8 *)pg_http_header_prefixes + 319, 5},
+    [PG_HTTP_HEADER_ID_AUTHORIZATION] = {(u8 *)pg_http_header_prefixes + 326, 13},
+    [PG_HTTP_HEADER_ID_CACHE_CONTROL] = {(u8 *)pg_http_header_prefixes + 341, 13},
+    [PG_HTTP_HEADER_ID_CONNECTION] = {(u8 *)pg_http_header_prefixes + 356, 10},
+    [PG_HTTP_HEADER_ID_CONTENT_DISPOSITION] = {(u8 *)pg_http_header_prefixes + 368, 19},
+    [PG_HTTP_HEADER_ID_CONTENT_ENCODING] = {(u8 *)pg_http_header_prefixes + 389, 16},
+    [PG_HTTP_HEADER_ID_CONTENT_LANGUAGE] = {(u8 *)pg_http_header_prefixes + 407, 16},
+    [PG_HTTP_HEADER_ID_CONTENT_LENGTH] = {(u8 *)pg_http_header_prefixes + 425, 14},
+    [PG_HTTP_HEADER_ID_CONTENT_LOCATION] = {(u8 *)pg_http_header_prefixes + 441, 16},
+    [PG_HTTP_HEADER_ID_CONTENT_RANGE] = {(u8 *)pg_http_header_prefixes + 459, 13},
+    [PG_HTTP_HEADER_ID_CONTENT_SECURITY_POLICY] = {(u8 *)pg_http_header_prefixes + 474, 23},
+    [PG_HTTP_HEADER_ID_CONTENT_TYPE] = {(u8 *)pg_http_header_prefixes + 499, 12},
+    [PG_HTTP_HEADER_ID_COOKIE] = {(u8 *)pg_http_header_prefixes + 513, 6},
+    [PG_HTTP_HEADER_ID_DATE] = {(u8 *)pg_http_header_prefixes + 521, 4},
+    [PG_HTTP_HEADER_ID_ETAG] = {(u8 *)pg_http_header_prefixes + 527, 4},
+    [PG_HTTP_HEADER_ID_EXPECT] = {(u8 *)pg_http_header_prefixes + 533, 6},
+    [PG_HTTP_HEADER_ID_EXPIRES] = {(u8 *)pg_http_header_prefixes + 541, 7},
+    [PG_HTTP_HEADER_ID_FORWARDED] = {(u8 *)pg_http_header_prefixes + 550, 9},
+    [PG_HTTP_HEADER_ID_FROM] = {(u8 *)pg_http_header_prefixes + 561, 4},
+    [PG_HTTP_HEADER_ID_HOST] = {(u8 *)pg_http_header_prefixes + 567, 4},
+    [PG_HTTP_HEADER_ID_IF_MATCH] = {(u8 *)pg_http_header_prefixes + 573, 8},
+    [PG_HTTP_HEADER_ID_IF_MODIFIED_SINCE] = {(u8 *)pg_http_header_prefixes + 583, 17},
+    [PG_HTTP_HEADER_ID_IF_NONE_MATCH] = {(u8 *)pg_http_header_prefixes + 602, 13},
+    [PG_HTTP_HEADER_ID_IF_RANGE] = {(u8 *)pg_http_header_prefixes + 617, 8},
+    [PG_HTTP_HEADER_ID_IF_UNMODIFIED_SINCE] = {(u8 *)pg_http_header_prefixes + 627, 19},
+    [PG_HTTP_HEADER_ID_KEEP_ALIVE] = {(u8 *)pg_http_header_prefixes + 648, 10},
+    [PG_HTTP_HEADER_ID_LAST_MODIFIED] = {(u8 *)pg_http_header_prefixes + 660, 13},
+    [PG_HTTP_HEADER_ID_LINK] = {(u8 *)pg_http_header_prefixes + 675, 4},
+    [PG_HTTP_HEADER_ID_LOCATION] = {(u8 *)pg_http_header_prefixes + 681, 8},
+    [PG_HTTP_HEADER_ID_MAX_FORWARDS] = {(u8 *)pg_http_header_prefixes + 691, 12},
+    [PG_HTTP_HEADER_ID_ORIGIN] = {(u8 *)pg_http_header_prefixes + 705, 6},
+    [PG_HTTP_HEADER_ID_PRAGMA] = {(u8 *)pg_http_header_prefixes + 713, 6},
+    [PG_HTTP_HEADER_ID_PROXY_AUTHENTICATE] = {(u8 *)pg_http_header_prefixes + 721, 18},
+    [PG_HTTP_HEADER_ID_PROXY_AUTHORIZATION] = {(u8 *)pg_http_header_prefixes + 741, 19},
+    [PG_HTTP_HEADER_ID_RANGE] = {(u8 *)pg_http_header_prefixes + 762, 5},
+    [PG_HTTP_HEADER_ID_REFERER] = {(u8 *)pg_http_header_prefixes + 769, 7},
+    [PG_HTTP_HEADER_ID_RETRY_AFTER] = {(u8 *)pg_http_header_prefixes + 778, 11},
+    [PG_HTTP_HEADER_ID_SERVER] = {(u8 *)pg_http_header_prefixes + 791, 6},
+    [PG_HTTP_HEADER_ID_SET_COOKIE] = {(u8 *)pg_http_header_prefixes + 799, 10},
+    [PG_HTTP_HEADER_ID_STRICT_TRANSPORT_SECURITY] = {(u8 *)pg_http_header_prefixes + 811, 25},
+    [PG_HTTP_HEADER_ID_TE] = {(u8 *)pg_http_header_prefixes + 838, 2},
+    [PG_HTTP_HEADER_ID_TRAILER] = {(u8 *)pg_http_header_prefixes + 842, 7},
+    [PG_HTTP_HEADER_ID_TRANSFER_ENCODING] = {(u8 *)pg_http_header_prefixes + 851, 17},
+    [PG_HTTP_HEADER_ID_UPGRADE] = {(u8 *)pg_http_header_prefixes + 870, 7},
+    [PG_HTTP_HEADER_ID_USER_AGENT] = {(u8 *)pg_http_header_prefixes + 879, 10},
+    [PG_HTTP_HEADER_ID_VARY] = {(u8 *)pg_http_header_prefixes + 891, 4},
+    [PG_HTTP_HEADER_ID_VIA] = {(u8 *)pg_http_header_prefixes + 897, 3},
+    [PG_HTTP_HEADER_ID_WWW_AUTHENTICATE] = {(u8 *)pg_http_header_prefixes + 902, 16},
+    [PG_HTTP_HEADER_ID_X_CONTENT_TYPE_OPTIONS] = {(u8 *)pg_http_header_prefixes + 920, 22},
+    [PG_HTTP_HEADER_ID_X_FORWARDED_FOR] = {(u8 *)pg_http_header_prefixes + 944, 15},
+    [PG_HTTP_HEADER_ID_X_FORWARDED_PROTO] = {(u8 *)pg_http_header_prefixes + 961, 17},
+    [PG_HTTP_HEADER_ID_X_FRAME_OPTIONS] = {(u8 *)pg_http_header_prefixes + 980, 15},
+    [PG_HTTP_HEADER_ID_X_REQUESTED_WITH] = {(u8 *)pg_http_header_prefixes + 997, 16},
+};
+
+static const u8 pg_http_header_slots[PG_HTTP_HEADER_SLOTS_LEN] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 45,
+    0, 0, 0, 0, 0, 0, 0, 0, 30, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 50, 0, 0, 0, 35, 0, 0, 0, 59, 34,
+    0, 0, 0, 0, 0, 33, 0, 37, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 62, 31, 0, 0, 0, 0, 0, 0, 39, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 14, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 13, 0, 0, 0, 32, 0, 0, 23, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 38, 0,
+    29, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 57, 0, 0, 0,
+    0, 0, 52, 0, 0, 0, 0, 0, 0, 18, 0, 0, 19, 0, 0, 0,
+    56, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    12, 67, 0, 61, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0,
+    0, 54, 0, 0, 0, 46, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+    0, 0, 15, 0, 0, 0, 0, 0, 0, 0, 0, 48, 0, 0, 0, 0,
+    7, 0, 0, 0, 0, 60, 0, 0, 66, 63, 0, 0, 0, 17, 11, 0,
+    0, 0, 0, 0, 0, 0, 44, 0, 0, 28, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 42, 0, 0, 9, 0, 0, 47,
+    0, 0, 0, 0, 0, 0, 0, 58, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 64, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 21, 0, 0, 4, 0, 0, 0, 0, 0, 0, 22, 0, 0,
+    0, 0, 0, 0, 0, 0, 43, 0, 0, 36, 0, 0, 0, 0, 0, 0,
+    0, 0, 55, 0, 0, 0, 0, 0, 53, 0, 0, 0, 0, 0, 16, 27,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 24, 0, 0, 0, 0, 0,
+    0, 0, 49, 0, 0, 0, 0, 0, 0, 0, 0, 0, 25, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 41, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 20, 0, 0, 0, 6, 0, 0, 0,
+    0, 0, 0, 0, 0, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 0, 0, 8, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 65, 0, 0, 0, 0, 0, 0,
+};
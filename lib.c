@@ -31,15 +31,26 @@
 #define PG_OS_WASM
 #endif
 
+// Opt-in: back `PgMutex` and `PgConditionVar` with the native futex-based
+// primitives instead of pthread.
+#if defined(PG_OS_LINUX) && defined(PG_USE_FUTEX)
+#define PG_SYNC_FUTEX
+#endif
+
 #if defined(PG_OS_UNIX)
 #define _POSIX_C_SOURCE 200809L
 #define _DEFAULT_SOURCE 1
 #endif
 
 #ifdef PG_OS_LINUX
+#include <linux/futex.h>
+#include <linux/perf_event.h>
 #include <sys/epoll.h>
 #include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <netinet/udp.h>
 #include <sys/sendfile.h>
+#include <sys/syscall.h>
 #endif
 
 #include "sha1.c"
@@ -50,6 +61,12 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#if defined(__x86_64__) && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #ifndef PG_OS_WASM
 #include <inttypes.h>
 #include <stdio.h>
@@ -256,8 +273,9 @@ typedef double f64;
 
 #define PG_ERR_RETURN(E)                                                       \
   {                                                                            \
-    if ((E)) {                                                                 \
-      return (E);                                                              \
+    typeof(E) __err__ = (E);                                                   \
+    if (__err__) {                                                             \
+      return __err__;                                                          \
     }                                                                          \
   }
 
@@ -294,6 +312,11 @@ typedef u64 PgError;
 #define PG_ERR_DWARF_UNKNOWN_FORM 0xff'00'f0
 #define PG_ERR_DWARF_INVALID_ATTR_FORM_VALUE 0xff'00'f1
 
+// The name does not exist or has no address.
+#define PG_ERR_DNS_NOT_FOUND 0xff'00'e0
+// The server could not answer e.g. SERVFAIL, REFUSED.
+#define PG_ERR_DNS_SERVER_FAILURE 0xff'00'e1
+
 PG_RESULT_DECL(u8, PgError);
 PG_RESULT_DECL(u16, PgError);
 PG_RESULT_DECL(u32, PgError);
@@ -461,6 +484,13 @@ typedef struct {
   u64 idx;
 } PgUtf8Iterator;
 
+// Escaping contexts served by the shared escaping engine.
+typedef enum : u8 {
+  PG_ESCAPE_KIND_HTML,
+  PG_ESCAPE_KIND_JS,
+  PG_ESCAPE_KIND_LOGFMT,
+} PgEscapeKind;
+
 typedef struct {
   PgString s;
   PgString sep;
@@ -490,6 +520,8 @@ typedef struct {
 typedef struct {
   u64 n;
   bool present;
+  // The digits do not fit in a `u64`: `present` is then false.
+  bool overflow;
   PgString remaining;
 } PgParseNumberResult;
 
@@ -519,6 +551,76 @@ typedef struct {
 } PgArenaAllocator;
 static_assert(sizeof(PgArenaAllocator) >= sizeof(PgAllocator));
 
+// Saved position in an arena: everything allocated after it gets freed at
+// once when restoring it. Can be nested.
+typedef struct {
+  PgArena *arena;
+  u8 *start;
+  // For APIs taking a `PgAllocator *`.
+  PgArenaAllocator allocator;
+} PgArenaTemp;
+
+typedef struct PgAllocSite PgAllocSite;
+// Aggregated counters for one call-site i.e. stack trace.
+struct PgAllocSite {
+  PgAllocSite *child[4]; // Hash trie.
+  PgAllocSite *next;     // Linked list of all sites.
+  PG_SLICE(u64) stack;
+  u64 hash;
+  u64 id;
+  u64 alloc_count, alloc_bytes;
+  u64 live_count, live_bytes;
+};
+
+typedef struct PgAllocLive PgAllocLive;
+struct PgAllocLive {
+  PgAllocLive *child[4]; // Hash trie.
+  u64 ptr;
+  // `nullptr` once freed.
+  PgAllocSite *site;
+  u64 size;
+  u64 timestamp_ns;
+};
+
+typedef enum : u8 {
+  PG_ALLOC_TRACE_EVENT_SITE = 1,
+  PG_ALLOC_TRACE_EVENT_ALLOC = 2,
+  PG_ALLOC_TRACE_EVENT_FREE = 3,
+} PgAllocTraceEvent;
+
+// Wraps any allocator to record, for a sample of allocations, the call-site,
+// size, alignment and lifetime.
+// Not thread-safe, like the allocators it typically wraps.
+typedef struct {
+  PgAllocFn alloc_fn;
+  PgReallocFn realloc_fn;
+  PgFreeFn free_fn;
+
+  PgAllocator *backing;
+  // For the bookkeeping: sites, live allocations, trace.
+  // Should not be `backing` to not skew the measurements.
+  PgAllocator *meta;
+  // Record one allocation out of `sample_rate`. 1 means: all.
+  u64 sample_rate;
+  u64 allocations_seen;
+
+  PgAllocSite *sites_htrie;
+  PgAllocSite *sites;
+  u64 sites_count;
+  PgAllocLive *live_htrie;
+
+  // Compact binary trace. Each event is a `PgAllocTraceEvent` byte followed by
+  // ULEB128 fields:
+  // - SITE: site id, frames count, frames...
+  // - ALLOC: time delta (ns), ptr, size, align, site id.
+  // - FREE: time delta (ns), ptr, lifetime (ns).
+  // Time deltas are relative to the previous event.
+  PG_DYN(u8) trace;
+  u64 trace_last_timestamp_ns;
+  bool trace_enabled;
+  PG_PAD(7);
+} PgTrackingAllocator;
+
 typedef enum {
   PG_CMP_LESS = -1,
   PG_CMP_EQ = 0,
@@ -538,40 +640,141 @@ typedef struct {
   u64 count;
 } PgRing;
 
+#define PG_CACHE_LINE_SIZE 64
+
+// Lock-free single-producer, single-consumer ring buffer of bytes.
+// Same read/write semantics as `PgRing` but one thread may write while another
+// thread reads, concurrently.
+// Invariants:
+// - `data.len` is a power of two.
+// - `idx_read <= idx_write <= idx_read + data.len`
+// - Indices only grow and get masked when indexing `data`.
+// - Producer and consumer state each live on their own cache line.
+typedef struct {
+  // Producer.
+  _Alignas(PG_CACHE_LINE_SIZE) _Atomic u64 idx_write;
+  // Last `idx_read` seen by the producer, to avoid touching the consumer cache
+  // line on each write.
+  u64 idx_read_cached;
+  PG_PAD(PG_CACHE_LINE_SIZE - 2 * sizeof(u64));
+
+  // Consumer.
+  _Atomic u64 idx_read;
+  // Last `idx_write` seen by the consumer.
+  u64 idx_write_cached;
+  PG_PAD(PG_CACHE_LINE_SIZE - 2 * sizeof(u64));
+
+  // Read-only after creation.
+  PgString data;
+  PG_PAD(PG_CACHE_LINE_SIZE - sizeof(PgString));
+} PgSpscRing;
+
+// Lock-free multi-producer, multi-consumer bounded queue of fixed-size
+// elements. See:
+// https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+// Each cell holds a sequence number followed by the element bytes.
+// Invariants:
+// - The cell count (`mask + 1`) is a power of two.
+// - Cell `i` is free for the producer at position `p` iff `sequence == p`,
+//   and ready for the consumer at position `p` iff `sequence == p + 1`.
+typedef struct {
+  _Alignas(PG_CACHE_LINE_SIZE) _Atomic u64 idx_enqueue;
+  PG_PAD(PG_CACHE_LINE_SIZE - sizeof(u64));
+
+  _Atomic u64 idx_dequeue;
+  PG_PAD(PG_CACHE_LINE_SIZE - sizeof(u64));
+
+  // Read-only after creation.
+  u8 *cells;
+  u64 mask;
+  u64 elem_size;
+  u64 cell_size;
+  PG_PAD(PG_CACHE_LINE_SIZE - sizeof(u8 *) - 3 * sizeof(u64));
+} PgMpmcQueue;
+
+typedef enum : u8 {
+  PG_DEFLATE_FORMAT_RAW,  // RFC 1951, no framing.
+  PG_DEFLATE_FORMAT_ZLIB, // RFC 1950: 2 bytes header, Adler-32 trailer.
+  PG_DEFLATE_FORMAT_GZIP, // RFC 1952: 10 bytes header, CRC-32 trailer.
+} PgDeflateFormat;
+
+// Decompressor, see `pg_inflate_reader_make`.
+typedef struct PgInflater PgInflater;
+
 typedef enum {
   PG_READER_KIND_NONE,
   PG_READER_KIND_BYTES,
   PG_READER_KIND_FILE,
   PG_READER_KIND_SOCKET,
+  PG_READER_KIND_HTTP_BODY,
+  PG_READER_KIND_HTTP_CHUNKED,
+  PG_READER_KIND_INFLATE,
 } PgReaderKind;
 
+typedef struct PgReader PgReader;
+typedef struct PgHttpHeaders PgHttpHeaders;
+
+typedef enum : u8 {
+  PG_HTTP_CHUNKED_STATE_SIZE, // Expecting a chunk size line.
+  PG_HTTP_CHUNKED_STATE_DATA,
+  PG_HTTP_CHUNKED_STATE_DONE, // The last chunk and the trailers were read.
+} PgHttpChunkedState;
+
+// Decoder of a `Transfer-Encoding: chunked` body read from `inner`.
 typedef struct {
+  PgReader *inner;
+  u64 chunk_remaining;
+  PgHttpHeaders *trailers; // Optional.
+  PgAllocator *allocator;  // For the trailers.
+  PgHttpChunkedState state;
+  PG_PAD(7);
+} PgHttpChunkedReader;
+
+struct PgReader {
   PgReaderKind kind;
   union {
     PG_SLICE(u8) bytes;
     PgFileDescriptor file;
     PgFileDescriptor socket;
+    // The next `remaining` bytes of `inner` e.g. a `Content-Length` body.
+    struct {
+      PgReader *inner;
+      u64 remaining;
+    } http_body;
+    PgHttpChunkedReader http_chunked;
+    PgInflater *inflate;
   } u;
   PgRing ring;
-} PgReader;
+};
+PG_RESULT_DECL(PgReader, PgError);
 
 typedef enum {
   PG_WRITER_KIND_NONE, // no-op.
   PG_WRITER_KIND_FILE,
   PG_WRITER_KIND_BYTES,
   PG_WRITER_KIND_SOCKET,
+  PG_WRITER_KIND_HTTP_CHUNKED,
+  PG_WRITER_KIND_DEFLATE,
 } PgWriterKind;
 
-typedef struct {
+// Compressor, see `pg_deflate_writer_make`.
+typedef struct PgDeflater PgDeflater;
+
+typedef struct PgWriter PgWriter;
+struct PgWriter {
   PgWriterKind kind;
   union {
     PgFileDescriptor file;
     PG_DYN(u8) bytes;
     PgFileDescriptor socket;
+    // Each write to this writer is a chunk of a `Transfer-Encoding: chunked`
+    // body written to `http_chunked`.
+    PgWriter *http_chunked;
+    PgDeflater *deflate;
   } u;
   // In case of buffered writer;
   PgRing ring;
-} PgWriter;
+};
 
 typedef struct {
   u8 data[PG_SHA1_DIGEST_LENGTH];
@@ -586,9 +789,31 @@ typedef struct {
   u32 ip;   // Host order.
   u16 port; // Host order.
 } PgIpv4Address;
+PG_RESULT_DECL(PgIpv4Address, PgError);
 PG_DYN_DECL(PgIpv4Address);
 PG_SLICE_DECL(PgIpv4Address);
 
+typedef enum : u8 {
+  PG_IP_FAMILY_V4,
+  PG_IP_FAMILY_V6,
+} PgIpFamily;
+
+// IPv4 or IPv6 address.
+typedef struct {
+  union {
+    u32 ipv4;    // Host order, as in `PgIpv4Address`.
+    u8 ipv6[16]; // Network order.
+  };
+  u16 port; // Host order.
+  PgIpFamily family;
+  PG_PAD(1);
+} PgIpAddress;
+PG_RESULT_DECL(PgIpAddress, PgError);
+PG_OPTION_DECL(PgIpAddress);
+PG_DYN_DECL(PgIpAddress);
+PG_SLICE_DECL(PgIpAddress);
+PG_RESULT_DECL(PG_SLICE(PgIpAddress), PgError);
+
 // Example: nodes=6
 // Matrix:
 //   | 0 1 2 3 4 5
@@ -691,6 +916,55 @@ typedef struct {
   PgError err;
 } PgIpv4AddressAcceptResult;
 
+typedef struct {
+  u64 len;
+  PgIpv4Address address; // Sender.
+  PgError err;
+} PgIpv4AddressRecvResult;
+
+typedef struct {
+  PgFileDescriptor socket;
+  PgIpAddress address;
+  PG_PAD(4);
+} PgIpAddressSocket;
+PG_RESULT_DECL(PgIpAddressSocket, PgError);
+PG_OPTION_DECL(PgIpAddressSocket);
+PG_DYN_DECL(PgIpAddressSocket);
+
+typedef struct {
+  PgIpAddress address;
+  PG_PAD(4);
+  PgFileDescriptor socket;
+  PgError err;
+} PgIpAddressAcceptResult;
+
+typedef struct {
+  // 0 waits indefinitely.
+  u64 timeout_ms;
+  // Before racing the next address while the previous attempts are still
+  // pending. 0 means the 250ms recommended by RFC 8305.
+  u64 attempt_delay_ms;
+} PgNetConnectOptions;
+
+// One entry of a batched UDP send or receive.
+typedef struct {
+  // Send: the payload. Receive: the buffer on input, what was received on
+  // output.
+  PgString data;
+  // Send: the destination. A zero port means none, on a connected socket.
+  // Receive: the sender.
+  PgIpAddress address;
+  // Send: when non-zero, `data` goes out as datagrams of this size, the last
+  // one possibly shorter, segmented by the kernel (UDP GSO, Linux only).
+  // Receive: non-zero when datagrams of this size from the same sender were
+  // coalesced into `data` (UDP GRO, see `pg_net_udp_set_gro`).
+  u16 segment_len;
+  // Receive: the datagram did not fit in `data` and the rest was discarded.
+  bool truncated;
+  PG_PAD(1);
+} PgUdpDatagram;
+PG_SLICE_DECL(PgUdpDatagram);
+
 typedef enum {
   PG_HTTP_METHOD_UNKNOWN,
   PG_HTTP_METHOD_OPTIONS,
@@ -712,30 +986,76 @@ PG_DYN_DECL(PgStringKeyValue);
 PG_SLICE_DECL(PgStringKeyValue);
 PG_RESULT_DECL(PG_DYN(PgStringKeyValue), PgError);
 
+#include "http_headers.c"
+
+typedef struct {
+  PgString key, value;
+  PgHttpHeaderId id;
+  PG_PAD(7);
+} PgHttpHeader;
+PG_DYN_DECL(PgHttpHeader);
+
+// Headers in the order they were added. The first occurrence of each
+// well-known header is found in O(1) through `known`, custom headers with a
+// scan of the (usually short) remainder.
+struct PgHttpHeaders {
+  PG_DYN(PgHttpHeader) entries;
+  // Index + 1 in `entries`, 0 if absent.
+  u16 known[PG_HTTP_HEADER_ID_COUNT];
+};
+
 typedef struct {
   PgString scheme;
   PgString username, password;
   PgString host; // Including subdomains.
   PG_DYN(PgString) path_components;
   PG_DYN(PgStringKeyValue) query_parameters;
+  PgString fragment; // Without the `#`.
   u16 port;
-  // TODO: fragment.
 } PgUrl;
 
+// The components of a URL as slices of the parsed string, so that parsing
+// does not allocate. The path and query are split lazily with
+// `PgUrlPathIterator` and `PgUrlQueryIterator`, and stay percent-encoded
+// until `pg_url_percent_decode` is called on the parts that need it.
+typedef struct {
+  PgString scheme;
+  PgString user_info;
+  PgString host; // Without the brackets of an IPv6 literal.
+  PgString path;
+  PgString query;    // Without the `?`.
+  PgString fragment; // Without the `#`.
+  u16 port;
+  PG_PAD(6);
+} PgUrlView;
+PG_RESULT_DECL(PgUrlView, PgError);
+
 typedef struct {
   PgUrl url; // Does not have a scheme, domain, port.
   PgHttpMethod method;
-  PG_DYN(PgStringKeyValue) headers;
+  PgHttpHeaders headers;
   u8 version_minor;
   u8 version_major;
 } PgHttpRequest;
 
+// A received request. The target is kept as slices of a copy of the request
+// line, so that reading it does not allocate more: `pg_http_request_url`
+// splits it into path components and query parameters for the handlers that
+// want them.
+typedef struct {
+  PgUrlView target; // Only has a path and query.
+  PgHttpMethod method;
+  PgHttpHeaders headers;
+  u8 version_minor;
+  u8 version_major;
+} PgHttpServerRequest;
+
 // `GET /en-US/docs/Web/HTTP/Messages HTTP/1.1`.
 typedef struct {
   PgHttpMethod method;
   u8 version_minor;
   u8 version_major;
-  PgUrl url; // Does not have a scheme, domain, port.
+  PgUrlView url; // Slices of the status line. Only has a path and query.
 } PgHttpRequestStatusLine;
 
 PG_RESULT_DECL(PgHttpRequestStatusLine, PgError);
@@ -753,7 +1073,7 @@ typedef struct {
   u8 version_major;
   u8 version_minor;
   u16 status;
-  PG_DYN(PgStringKeyValue) headers;
+  PgHttpHeaders headers;
 } PgHttpResponse;
 
 typedef struct {
@@ -769,6 +1089,17 @@ typedef struct {
 PG_RESULT_DECL(PgUrlAuthority, PgError);
 PG_RESULT_DECL(PgUrl, PgError);
 
+// Yields the non-empty path components.
+typedef struct {
+  PgString remaining;
+} PgUrlPathIterator;
+
+// Yields the query parameters with a non-empty key.
+typedef struct {
+  PgString remaining;
+} PgUrlQueryIterator;
+PG_OPTION_DECL(PgStringKeyValue);
+
 typedef struct {
   bool done;
   PgHttpResponse resp;
@@ -777,7 +1108,7 @@ typedef struct {
 
 typedef struct {
   bool done;
-  PgHttpRequest req;
+  PgHttpServerRequest req;
   PgError err;
 } PgHttpRequestReadResult;
 
@@ -860,6 +1191,14 @@ PG_DYN_DECL(PgHtmlToken);
 PG_SLICE_DECL(PgHtmlToken);
 PG_RESULT_DECL(PG_DYN(PgHtmlToken), PgError);
 
+// Named character reference e.g. `&amp;`. See `html_entities.c`.
+typedef struct {
+  u32 name_offset; // In `pg_html_entity_names`.
+  u8 name_len;
+  u8 value_len;
+  u8 value[6]; // UTF-8.
+} PgHtmlEntity;
+
 typedef enum {
   PG_HTML_PARSE_ERROR_NONE = 0,
   PG_HTML_PARSE_ERROR_INCORRECTLY_CLOSED_COMMENT = 0x600,
@@ -873,6 +1212,28 @@ typedef enum {
   PG_HTML_PARSE_ERROR_EOF_IN_COMMENT = 0x608,
 } PgHtmlParseError;
 
+// Pull-based HTML tokenizer over an in-memory string, or over a reader which
+// is read in chunks of `chunk_size`. In the latter case it is resumable: when
+// the reader fails e.g. with `PG_ERR_EAGAIN`, calling
+// `pg_html_tokenizer_next` again later picks up where it left off.
+// Token strings point into `buf` and, when reading from a reader, are only
+// valid until the next call. Token offsets are from the start of the input.
+// Character references in text are decoded: in place when reading from a
+// reader, and into memory from `allocator` for a string, if it is set.
+typedef struct {
+  PgReader *reader; // `nullptr` for an in-memory string.
+  PgAllocator *allocator;
+  PG_DYN(u8) buf;
+  u64 chunk_size;
+  u64 offset;  // Input offset of `buf.data[0]`.
+  u64 pos;     // Start of the pending token in `buf`.
+  u64 scanned; // Bytes of the pending token already scanned for its end.
+  u8 quote;    // Inside a quoted attribute value of the pending tag.
+  bool text_has_ampersand;
+  bool eof;
+  PG_PAD(5);
+} PgHtmlTokenizer;
+
 typedef struct PgLinkedListNode PgLinkedListNode;
 struct PgLinkedListNode {
   PgLinkedListNode *next;
@@ -886,6 +1247,38 @@ struct PgHtmlNode {
 typedef PgHtmlNode *PgHtmlNodePtr;
 PG_RESULT_DECL(PgHtmlNodePtr, PgError);
 
+// Interned tag name of `PgHtmlDom`.
+typedef struct PgHtmlTag PgHtmlTag;
+struct PgHtmlTag {
+  PgHtmlTag *child[4]; // Hash trie.
+  PgString name;
+  u32 id;
+  bool self_closing;
+  PG_PAD(3);
+};
+typedef PgHtmlTag *PgHtmlTagPtr;
+PG_DYN_DECL(PgHtmlTagPtr);
+
+// Node of `PgHtmlDom`. Links are indices in `PgHtmlDom.nodes`. Index 0 is the
+// root, which is never a child or a sibling, so 0 also means 'none'.
+typedef struct {
+  u32 parent, first_child, last_child, next_sibling;
+  u32 start, end; // Source range of the token e.g. the text or the tag name.
+  u32 tag;        // Interned tag name of elements, 0 otherwise.
+  PgHtmlTokenKind kind;
+} PgHtmlDomNode;
+PG_DYN_DECL(PgHtmlDomNode);
+
+// Compact alternative to the `PgHtmlNode` tree: nodes live in one array, in
+// document order, so that a preorder traversal is a linear scan.
+typedef struct {
+  PgString source;
+  PG_DYN(PgHtmlDomNode) nodes;
+  PG_DYN(PgHtmlTagPtr) tags; // By id. Id 0 is unused.
+  PgHtmlTag *tags_htrie;
+} PgHtmlDom;
+PG_RESULT_DECL(PgHtmlDom, PgError);
+
 // TODO: Remove and use enum values instead.
 static const u32 PgElfProgramHeaderTypeLoad = 1;
 static const u32 PgElfProgramHeaderFlagsExecutable = 1;
@@ -1091,18 +1484,139 @@ typedef struct {
 } PgMacho;
 PG_RESULT_DECL(PgMacho, PgError);
 
-typedef void (*PgHttpHandler)(PgHttpRequest req, PgReader *reader,
+// Token bucket per key, kept as in GCRA: a slot only holds the time at which
+// the bucket of its key is full again. A fixed-size open-addressing table,
+// updated with compare-and-swap only.
+typedef struct {
+  _Atomic u64 key; // Plus one, 0 for a free slot.
+  _Atomic u64 full_at_ns;
+} PgRateLimiterSlot;
+
+typedef struct {
+  PgRateLimiterSlot *slots;
+  u64 slots_len;   // Power of two.
+  u64 interval_ns; // Between two tokens.
+  u64 burst_ns;    // `interval_ns` times the capacity of a bucket.
+} PgRateLimiter;
+
+typedef enum {
+  PG_HTTP_ADMISSION_ACCEPT,
+  PG_HTTP_ADMISSION_OVERLOADED,   // 503.
+  PG_HTTP_ADMISSION_RATE_LIMITED, // 429.
+} PgHttpAdmission;
+
+typedef void (*PgHttpHandler)(PgHttpServerRequest req, PgReader *reader,
                               PgWriter *writer, PgLogger *logger,
                               PgAllocator *allocator, void *ctx);
 
+typedef struct PgHttpFileCache PgHttpFileCache;
+typedef struct PgAio PgAio;
+
 typedef struct {
   u16 port;
   u64 listen_backlog;
   u64 http_handler_arena_mem;
   PgHttpHandler handler;
   void *ctx;
+  // Optional: refreshed in the parent before each connection is handed to a
+  // child, see `pg_http_file_cache_refresh`.
+  PgHttpFileCache *file_cache;
+  // Serve further requests on the same connection until it stays idle for
+  // that long. 0 to close the connection after the first response.
+  u64 keep_alive_timeout_ms;
+
+  // Admission control, before forking: a connection turned away gets a canned
+  // response without its request being read. 0 disables each check.
+  // Connections being handled at once, above which new ones get a 503.
+  u64 max_connections;
+  // Linux: a connection that waited longer than this in the accept queue
+  // since its last data arrived gets a 503.
+  u64 max_queue_ms;
+  // Per client IP: a burst of `rate_limit_burst` connections, then
+  // `rate_limit_per_s`. Beyond, a 429.
+  u64 rate_limit_per_s;
+  u64 rate_limit_burst;
+  // Clients tracked at once, a power of two. Defaults to 4096.
+  u64 rate_limit_slots;
 } PgHttpServerOptions;
 
+typedef struct {
+  u64 size;
+  u64 mtime_ns; // Realtime clock.
+  u64 ino, dev;
+  bool regular;
+  bool directory;
+  PG_PAD(6);
+} PgFileStat;
+PG_RESULT_DECL(PgFileStat, PgError);
+
+// HTTP-date in the IMF-fixdate format e.g. `Sun, 06 Nov 1994 08:49:37 GMT`.
+#define PG_HTTP_DATE_LEN 29
+
+// Open file of `PgHttpFileCache`. The validators are computed once when the
+// file is (re)opened, and stored inline so that revalidating does not
+// allocate.
+typedef struct PgHttpFile PgHttpFile;
+struct PgHttpFile {
+  PgHttpFile *child[4]; // Hash trie.
+  PgString path;        // Relative to the root of the cache.
+  PgString content_type;
+  PgFileDescriptor fd;
+  // Linux: gzip representation stored by `pg_http_file_cache_store`, see
+  // `gzip_max_bytes`.
+  PgFileDescriptor gzip_fd;
+  PgFileStat stat;
+  u64 validated_at_ns; // Monotonic clock.
+  u64 gzip_len;
+  PgHttpFile *lru_prev, *lru_next; // Most recently used first.
+  u8 etag[40];                     // Quoted.
+  u8 etag_len;
+  u8 last_modified[PG_HTTP_DATE_LEN];
+  bool open;
+  bool gzip;
+  bool refresh_pending; // In `PgHttpFileCache.refresh_pending`.
+  PG_PAD(7);
+};
+typedef PgHttpFile *PgHttpFilePtr;
+PG_RESULT_DECL(PgHttpFilePtr, PgError);
+PG_DYN_DECL(PgHttpFilePtr);
+
+// Static files under `root`, opened and stat'ed once per path instead of once
+// per request. A file replaced or modified on disk is picked up at most
+// `revalidate_after_ns` later.
+// With `pg_http_server_start`, each connection is handled by a forked child
+// which gets a copy of the cache: only what the parent opened and stored
+// before forking, see `pg_http_file_cache_preload` and
+// `pg_http_file_cache_refresh`, is shared. What a child opens or revalidates
+// is lost when it exits, and is done again by the next one.
+struct PgHttpFileCache {
+  PgHttpFile *htrie;
+  PgString root;
+  u64 revalidate_after_ns;
+  PgAllocator *allocator; // Outlives the requests.
+  // Linux: budget of the gzip representations compressed once and kept in
+  // memory, the least recently used being evicted first. 0 to compress on
+  // each request instead.
+  u64 gzip_max_bytes;
+  u64 gzip_bytes;
+  PgHttpFile *lru_head, *lru_tail;
+  PgAio *aio; // Optional, see `pg_http_file_cache_watch`.
+  // Changed on disk, to compress again, oldest first.
+  PG_DYN(PgHttpFilePtr) refresh_pending;
+};
+
+typedef enum {
+  PG_HTTP_RANGE_KIND_NONE, // Absent, ignored or multiple ranges: full body.
+  PG_HTTP_RANGE_KIND_SATISFIABLE,
+  PG_HTTP_RANGE_KIND_UNSATISFIABLE,
+} PgHttpRangeKind;
+
+typedef struct {
+  u64 start, end; // Exclusive end.
+  PgHttpRangeKind kind;
+  PG_PAD(4);
+} PgHttpRange;
+
 PG_RESULT_DECL(PG_SLICE(PgString), PgError);
 
 #ifdef PG_OS_UNIX
@@ -1116,7 +1630,46 @@ PG_RESULT_DECL(PgThread, PgError);
 PG_SLICE_DECL(PgThread);
 PG_DYN_DECL(PgThread);
 
-#ifdef PG_OS_UNIX
+#ifdef PG_OS_LINUX
+// States: 0 = unlocked, 1 = locked, 2 = locked and maybe with waiters.
+// See "Futexes Are Tricky", Ulrich Drepper.
+typedef struct {
+  _Atomic u32 state;
+} PgFutexMutex;
+
+typedef struct {
+  // Bumped on each signal/broadcast. Waiters park on it.
+  _Atomic u32 seq;
+  // Used to skip the syscall when nobody waits.
+  _Atomic u32 waiters;
+} PgFutexConditionVar;
+
+#define PG_FUTEX_RWLOCK_WRITE_LOCKED UINT32_MAX
+
+// Readers are preferred: writers may starve under a constant read load.
+typedef struct {
+  // Count of readers holding the lock, or `PG_FUTEX_RWLOCK_WRITE_LOCKED`.
+  _Atomic u32 state;
+  _Atomic u32 waiters;
+} PgFutexRwLock;
+
+// Count-down latch. An event is a latch with a count of 1.
+typedef struct {
+  _Atomic u32 count;
+} PgLatch;
+#endif
+
+#if defined(PG_SYNC_FUTEX)
+typedef struct {
+  PgFutexMutex inner;
+  // Only for recursive mutexes: thread id of the owner, 0 when unlocked.
+  _Atomic u32 owner;
+  // Count of nested locks held by the owner.
+  u32 depth;
+  bool recursive;
+  PG_PAD(3);
+} PgMutex;
+#elif defined(PG_OS_UNIX)
 typedef pthread_mutex_t PgMutex;
 #else
 // FIXME
@@ -1128,7 +1681,9 @@ typedef enum {
   PG_MUTEX_KIND_RECURSIVE,
 } PgMutexKind;
 
-#ifdef PG_OS_UNIX
+#if defined(PG_SYNC_FUTEX)
+typedef PgFutexConditionVar PgConditionVar;
+#elif defined(PG_OS_UNIX)
 typedef pthread_cond_t PgConditionVar;
 #else
 // FIXME
@@ -1166,6 +1721,8 @@ typedef enum [[clang::flag_enum]] {
 
   PG_AIO_EVENT_KIND_ERROR = 1 << 6,
   PG_AIO_EVENT_KIND_EOF = 1 << 7,
+  // A timer expired. Its `user_data` is in the event, and its `fd` is unset.
+  PG_AIO_EVENT_KIND_TIMER = 1 << 8,
   // More...
 } PgAioEventKind;
 
@@ -1180,22 +1737,236 @@ PG_SLICE_DECL(PgAioEvent);
 PG_RESULT_DECL(PgAioEvent, PgError);
 PG_OPTION_DECL(PgAioEvent);
 
+typedef enum {
+  PG_WALK_DIRECTORY_KIND_NONE = 0,
+  PG_WALK_DIRECTORY_KIND_FILE = 1 << 0,
+  PG_WALK_DIRECTORY_KIND_DIRECTORY = 1 << 1,
+  PG_WALK_DIRECTORY_KIND_RECURSE = 1 << 2,
+  PG_WALK_DIRECTORY_KIND_IGNORE_ERRORS = 1 << 3,
+} PgWalkDirectoryOption;
+
+// Last known state of an entry of a watched directory, to tell what changed
+// when the directory reports it.
+typedef struct PgAioFsEntry PgAioFsEntry;
+struct PgAioFsEntry {
+  PgAioFsEntry *child[4]; // Hash trie.
+  PgString name;
+  u64 name_cap; // Kept when reused, see `pg_aio_fs_entry_remove`.
+  u64 mtime_ns;
+  u64 size;
+  u64 ino;        // Replaced e.g. by a rename if it changes.
+  u64 generation; // Of the last full scan which saw it.
+  bool exists;    // Deleted entries only stay in the trie while pending.
+  bool directory;
+  bool pending; // Reported by the kernel, not diffed yet.
+  bool written; // Reported written to, which may not show in its state.
+  PG_PAD(4);
+};
+
 typedef struct PgAioFsNode PgAioFsNode;
 struct PgAioFsNode {
   PgFileDescriptor fd;
   PgString name;
   PgAioFsNode *child[4];
+  // Directories watched with `pg_aio_register_watch_directory`.
+  PgAioFsEntry *entries;
+  // Removed from `entries`, to reuse, linked by `child[0]`.
+  PgAioFsEntry *entries_free;
+  PgAllocator *allocator; // Of the entries.
+  u64 generation;
+  PgWalkDirectoryOption options;
+  bool directory;
+  PG_PAD(3);
+};
+
+typedef struct {
+  PgAioFsNode *node;
+  PgAioFsEntry *entry; // nullptr: the watch of `node` was dropped.
+} PgAioFsChange;
+PG_DYN_DECL(PgAioFsChange);
+
+// Embedded by the caller e.g. in a connection, so that arming and
+// cancelling a timer never allocate.
+typedef struct PgTimer PgTimer;
+struct PgTimer {
+  PgTimer *next;
+  PgTimer **pprev; // nullptr when not armed.
+  u64 deadline_ns; // Monotonic clock.
+  u64 user_data;
 };
 
+#define PG_TIMER_WHEEL_LEVELS 4
+#define PG_TIMER_WHEEL_SLOTS_BITS 8
+#define PG_TIMER_WHEEL_SLOTS (1 << PG_TIMER_WHEEL_SLOTS_BITS)
+
+// Hierarchical timing wheel: level `l` holds the timers expiring in the
+// current block of `256^(l+1)` ticks but not in the current block of `256^l`
+// ticks, in a slot per sub-block. A slot is moved down a level when its
+// sub-block starts, so inserting and cancelling are O(1), and expiring
+// is O(1) per timer.
 typedef struct {
+  PgTimer *slots[PG_TIMER_WHEEL_LEVELS][PG_TIMER_WHEEL_SLOTS];
+  // Slots which may be non-empty. Bits are cleared lazily.
+  u64 occupied[PG_TIMER_WHEEL_LEVELS][PG_TIMER_WHEEL_SLOTS / 64];
+  // Beyond the top level, i.e. `2^32` ticks away.
+  PgTimer *overflow;
+  u64 tick_ns;
+  u64 tick; // Next tick to expire.
+  u64 count;
+} PgTimerWheel;
+
+struct PgAio {
   PgFileDescriptor aio;
 #ifdef PG_OS_LINUX
   PG_OPTION(PgFileDescriptor) inotify;
 #endif
   PgAioFsNode *fs_nodes;
-} PgAio;
+  PgTimerWheel *timers; // Optional, see `pg_aio_timers_init`.
+};
 PG_RESULT_DECL(PgAio, PgError);
 
+typedef enum : u8 {
+  PG_DNS_ENTRY_STATE_PENDING, // A query is in flight.
+  PG_DNS_ENTRY_STATE_RESOLVED,
+  PG_DNS_ENTRY_STATE_FAILED, // Negative caching.
+} PgDnsEntryState;
+
+// Cached answer of `PgDnsResolver` for one name.
+typedef struct PgDnsEntry PgDnsEntry;
+struct PgDnsEntry {
+  PgDnsEntry *child[4]; // Hash trie.
+  PgString name;        // Lowercase.
+  PG_DYN(u32) addresses;
+  PgError err; // When failed.
+  // Monotonic clock. 0 for `/etc/hosts` and IP literals, which never expire.
+  u64 expires_at_ns;
+  u64 sent_at_ns;
+  u16 query_id;
+  u8 attempts;
+  PgDnsEntryState state;
+  PG_PAD(4);
+};
+typedef PgDnsEntry *PgDnsEntryPtr;
+PG_DYN_DECL(PgDnsEntryPtr);
+
+// Zero values get defaults.
+typedef struct {
+  // The first `nameserver` of `/etc/resolv.conf` by default.
+  PgIpv4Address server;
+  // Of each attempt.
+  u64 timeout_ms;
+  u64 attempts;
+  // How long negative answers without a SOA record, server failures and
+  // timeouts are cached.
+  u64 negative_ttl_ms;
+  // Upper bound on the TTL of answers.
+  u64 max_ttl_ms;
+} PgDnsResolverOptions;
+
+// Stub resolver of IPv4 addresses over UDP, driven by an event loop: lookups
+// do not block, and concurrent lookups of a name share one query. Answers are
+// cached for their TTL. Not thread-safe.
+typedef struct {
+  PgDnsEntry *htrie;
+  PG_DYN(PgDnsEntryPtr) pending;
+  PgDnsResolverOptions options;
+  PgFileDescriptor socket; // Connected to the server.
+  // Only watches `socket`. Its descriptor can be registered in another event
+  // loop.
+  PgAio aio;
+  PgRng rng; // Query ids.
+  u64 queries_sent;
+  PgAllocator *allocator;
+} PgDnsResolver;
+PG_RESULT_DECL(PgDnsResolver, PgError);
+
+typedef struct {
+  PG_SLICE(u32) addresses; // Host order.
+  PgError err;
+  // Try again once `socket` is readable or after
+  // `pg_dns_resolver_timeout_ms`.
+  bool pending;
+  PG_PAD(7);
+} PgDnsLookup;
+
+typedef struct {
+  PG_DYN(u32) addresses; // Host order.
+  u64 ttl_s;             // Of the addresses, or of the negative answer.
+  u8 rcode;
+  bool ttl_present;
+  PG_PAD(6);
+} PgDnsAnswer;
+PG_RESULT_DECL(PgDnsAnswer, PgError);
+PG_RESULT_DECL(PG_SLICE(u32), PgError);
+
+// Connection of `PgHttpClient`, with its buffers.
+typedef struct {
+  PgFileDescriptor socket;
+  PgReader reader;
+  PgWriter writer;
+  u64 idle_since_ns; // Monotonic clock.
+} PgHttpClientConn;
+PG_DYN_DECL(PgHttpClientConn);
+
+// Resolved addresses and idle connections of one `host:port`.
+typedef struct PgHttpClientHost PgHttpClientHost;
+struct PgHttpClientHost {
+  PgHttpClientHost *child[4];    // Hash trie.
+  PgString key;                  // `host:port`.
+  PG_DYN(PgIpAddress) addresses; // Empty until resolved.
+  // Most recently used last, which is reused first since it is the least
+  // likely to have been closed by the server.
+  PG_DYN(PgHttpClientConn) idle;
+};
+
+typedef struct {
+  // 0 waits indefinitely.
+  u64 connect_timeout_ms;
+  u64 read_timeout_ms;
+  // Idle connections are closed by the client after that long, which should
+  // be shorter than the server keep-alive timeout. Defaults to 4 s, under the
+  // 5 s of common servers.
+  u64 idle_timeout_ms;
+  // 0 disables pooling: each request opens and closes a connection.
+  u64 max_idle_per_host;
+  // Larger response bodies fail with `PG_ERR_TOO_BIG`. Defaults to 16 MiB.
+  u64 max_body_len;
+  u64 buffer_size;
+  // Optional, instead of a blocking `getaddrinfo` per new host.
+  PgDnsResolver *resolver;
+} PgHttpClientOptions;
+
+typedef struct {
+  PgHttpClientOptions options;
+  PgHttpClientHost *hosts_htrie;
+  // Buffers of closed connections, reused by the next connections.
+  PG_DYN(PgHttpClientConn) spare;
+  PgAio aio; // Responses of `pg_http_client_do_many`.
+  // Only the attempts of `pg_http_client_connect`, as required by
+  // `pg_net_connect_happy_eyeballs`: a response ready meanwhile must not cut
+  // the wait short.
+  PgAio connect_aio;
+  u64 connections_opened;
+  PgAllocator *allocator; // Outlives the requests.
+} PgHttpClient;
+PG_RESULT_DECL(PgHttpClient, PgError);
+
+typedef struct {
+  PgString host;
+  u16 port;
+  PG_PAD(6);
+  PgHttpRequest req;
+  PgString body;
+} PgHttpClientRequest;
+PG_SLICE_DECL(PgHttpClientRequest);
+
+typedef struct {
+  PgHttpResponse res;
+  PgString body;
+  PgError err;
+} PgHttpClientResponse;
+PG_SLICE_DECL(PgHttpClientResponse);
+
 typedef struct {
 #ifdef PG_OS_UNIX
   DIR *dir;
@@ -1218,14 +1989,6 @@ typedef struct {
   u64 nanoseconds;
 } PgTime;
 
-typedef enum {
-  PG_WALK_DIRECTORY_KIND_NONE = 0,
-  PG_WALK_DIRECTORY_KIND_FILE = 1 << 0,
-  PG_WALK_DIRECTORY_KIND_DIRECTORY = 1 << 1,
-  PG_WALK_DIRECTORY_KIND_RECURSE = 1 << 2,
-  PG_WALK_DIRECTORY_KIND_IGNORE_ERRORS = 1 << 3,
-} PgWalkDirectoryOption;
-
 typedef struct {
   u32 length;
   u16 version;
@@ -1827,6 +2590,61 @@ typedef struct {
   void (*fn)(void);
 } PgTest;
 PG_SLICE_DECL(PgTest);
+PG_DYN_DECL(PgTest);
+
+typedef enum : u8 {
+  PG_TEST_OUTCOME_PASS,
+  // Non-zero exit status.
+  PG_TEST_OUTCOME_FAIL,
+  // Killed by a signal e.g. a failed assertion (trap) or a segfault.
+  PG_TEST_OUTCOME_SIGNAL,
+  PG_TEST_OUTCOME_TIMEOUT,
+} PgTestOutcome;
+
+typedef struct {
+  PgTest test;
+  // Combined stdout and stderr of the test.
+  PgString output;
+  u64 duration_ns;
+  i32 exit_status;
+  i32 signal;
+  PgTestOutcome outcome;
+  PG_PAD(7);
+} PgTestResult;
+PG_DYN_DECL(PgTestResult);
+
+typedef struct {
+  // Set by the runner: how many times the benchmark body should run.
+  u64 iterations;
+  // Optionally set by the benchmark to get a throughput report.
+  u64 bytes_per_iteration;
+  // Same, for e.g. packets or requests.
+  u64 items_per_iteration;
+  // Optionally set by the benchmark e.g. the compression ratio, reported as
+  // is.
+  f64 ratio;
+} PgBenchState;
+
+typedef struct {
+  PgString name;
+  void (*fn)(PgBenchState *state);
+} PgBench;
+PG_SLICE_DECL(PgBench);
+
+typedef enum : u8 {
+  PG_BENCH_COUNTER_CYCLES,
+  PG_BENCH_COUNTER_INSTRUCTIONS,
+  PG_BENCH_COUNTER_CACHE_MISSES,
+  PG_BENCH_COUNTER_COUNT,
+} PgBenchCounterKind;
+
+// Hardware counters, read as one group. `fds[0]` is the group leader and is
+// -1 when the counters are not available (e.g. no permission).
+typedef struct {
+  i32 fds[PG_BENCH_COUNTER_COUNT];
+  PG_PAD(4);
+  u64 values[PG_BENCH_COUNTER_COUNT];
+} PgBenchCounters;
 
 typedef enum {
   PG_DURATION_NANOSECOND,
@@ -1896,6 +2714,12 @@ pg_file_truncate(PgFileDescriptor file, u64 size);
 [[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
     pg_file_size(PgFileDescriptor file);
 
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileStat, PgError)
+    pg_file_stat(PgFileDescriptor file);
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileStat, PgError)
+    pg_file_stat_from_path(PgString path, PgAllocator *allocator);
+
 [[nodiscard]] static PG_RESULT(u64, PgError)
     pg_file_read(PgFileDescriptor file, PgString dst);
 
@@ -1930,6 +2754,14 @@ pg_aio_unregister_interest(PgAio aio, PgFileDescriptor fd,
 
 [[maybe_unused]] static void pg_thread_yield();
 
+#ifdef PG_OS_LINUX
+// Park the calling thread as long as `*addr == expected`.
+// May return spuriously: callers must re-check their condition in a loop.
+static void pg_futex_wait(_Atomic u32 *addr, u32 expected);
+
+static void pg_futex_wake(_Atomic u32 *addr, u32 count);
+#endif
+
 [[maybe_unused]] [[nodiscard]] PgError pg_thread_join(PgThread thread);
 
 [[maybe_unused]] [[nodiscard]] PgError pg_mtx_init(PgMutex *mutex,
@@ -1977,6 +2809,10 @@ pg_aio_fs_node_upsert(PgAioFsNode **htrie, PgFileDescriptor fd,
 static void pg_once_mark_as_done(_Atomic PgOnce *done) {
   // PG_ONCE_INITIALIZING -> PG_ONCE_INITIALIZED.
   atomic_store_explicit(done, PG_ONCE_INITIALIZED, memory_order_release);
+
+#ifdef PG_OS_LINUX
+  pg_futex_wake((_Atomic u32 *)(void *)done, INT32_MAX);
+#endif
 }
 
 [[nodiscard]] static bool pg_once_do(_Atomic PgOnce *done) {
@@ -1999,8 +2835,13 @@ static void pg_once_mark_as_done(_Atomic PgOnce *done) {
       if (PG_ONCE_INITIALIZED == expected) {
         return false;
       } else if (PG_ONCE_INITIALIZING == expected) {
+#ifdef PG_OS_LINUX
+        // Park until the initializing thread is done.
+        pg_futex_wait((_Atomic u32 *)(void *)done, PG_ONCE_INITIALIZING);
+#else
         // Busy wait by looping again, for simplicity.
         pg_thread_yield();
+#endif
       }
     }
   }
@@ -2020,6 +2861,12 @@ static void pg_once_mark_as_done(_Atomic PgOnce *done) {
 pg_fill_stack_trace(u64 skip, u64 pie_offset,
                     u64 stack_trace[PG_STACK_TRACE_MAX]);
 
+// Like `pg_fill_stack_trace`, starting at the caller of the function owning
+// `frame_pointer`.
+[[maybe_unused]] static u64
+pg_fill_stack_trace_from_frame(u64 *frame_pointer, u64 skip, u64 pie_offset,
+                               u64 stack_trace[PG_STACK_TRACE_MAX]);
+
 [[nodiscard]] static u64 pg_self_pie_get_offset();
 
 #ifndef PG_OS_WASM
@@ -2388,6 +3235,38 @@ pg_utf8_iterator_peek_next(PgUtf8Iterator it) {
   return 0;
 }
 
+// Write the UTF-8 encoding of `c` to `dst`, which has room for 4 bytes.
+// Returns the number of bytes written, 0 for an invalid rune.
+[[maybe_unused]] [[nodiscard]] static u64 pg_utf8_encode_rune(PgRune c,
+                                                              u8 *dst) {
+  u64 len = pg_utf8_rune_bytes_count(c);
+  switch (len) {
+  case 0:
+    break;
+  case 1:
+    dst[0] = (u8)c;
+    break;
+  case 2:
+    dst[0] = (u8)(0xC0 | (c >> 6));
+    dst[1] = (u8)(0x80 | (c & 0x3F));
+    break;
+  case 3:
+    dst[0] = (u8)(0xE0 | (c >> 12));
+    dst[1] = (u8)(0x80 | ((c >> 6) & 0x3F));
+    dst[2] = (u8)(0x80 | (c & 0x3F));
+    break;
+  case 4:
+    dst[0] = (u8)(0xF0 | (c >> 18));
+    dst[1] = (u8)(0x80 | ((c >> 12) & 0x3F));
+    dst[2] = (u8)(0x80 | ((c >> 6) & 0x3F));
+    dst[3] = (u8)(0x80 | (c & 0x3F));
+    break;
+  default:
+    PG_ASSERT(0);
+  }
+  return len;
+}
+
 [[maybe_unused]] [[nodiscard]] static PgRuneUtf8Result
 pg_utf8_iterator_next(PgUtf8Iterator *it) {
   PgRuneUtf8Result res = pg_utf8_iterator_peek_next(*it);
@@ -2558,11 +3437,14 @@ pg_string_is_ascii_alphabetical(PgString s) {
   return res;
 }
 
+// ASCII spaces never occur inside a multi-byte UTF-8 sequence so the trimming
+// can go byte by byte.
 [[maybe_unused]] [[nodiscard]] static PgString
 pg_string_trim_space_left(PgString s) {
   PgString res = s;
-  PG_EACH_PTR(space, &PG_ASCII_SPACES) {
-    res = pg_string_trim_left(res, *space);
+  while (!pg_string_is_empty(res) &&
+         pg_rune_ascii_is_space(PG_SLICE_AT(res, 0))) {
+    res = PG_SLICE_RANGE_START(res, 1);
   }
   return res;
 }
@@ -2570,17 +3452,16 @@ pg_string_trim_space_left(PgString s) {
 [[maybe_unused]] [[nodiscard]] static PgString
 pg_string_trim_space_right(PgString s) {
   PgString res = s;
-  PG_EACH_PTR(space, &PG_ASCII_SPACES) {
-    res = pg_string_trim_right(res, *space);
+  while (!pg_string_is_empty(res) &&
+         pg_rune_ascii_is_space(PG_SLICE_AT(res, res.len - 1))) {
+    res.len -= 1;
   }
   return res;
 }
 
 [[maybe_unused]] [[nodiscard]] static PgString
 pg_string_trim_space(PgString s) {
-  PgString res = s;
-  PG_EACH_PTR(space, &PG_ASCII_SPACES) { res = pg_string_trim(res, *space); }
-  return res;
+  return pg_string_trim_space_right(pg_string_trim_space_left(s));
 }
 
 [[maybe_unused]] [[nodiscard]] static PgSplitIterator
@@ -2686,13 +3567,15 @@ pg_string_cut_rune(PgString s, PgRune needle) {
 [[maybe_unused]] [[nodiscard]]
 static PG_OPTION(u64) pg_bytes_index_of_byte(PG_SLICE(u8) haystack, u8 needle) {
   PG_OPTION(u64) res = {0};
+  if (PG_SLICE_IS_EMPTY(haystack)) {
+    return res;
+  }
 
-  PG_EACH_PTR(it, &haystack) {
-    if (needle == *it) {
-      res.value = PG_SLICE_PTR_TO_INDEX(it, haystack);
-      res.has_value = true;
-      return res;
-    }
+  // Vectorized in libc.
+  const u8 *it = __builtin_memchr(haystack.data, needle, haystack.len);
+  if (it) {
+    res.value = (u64)(it - haystack.data);
+    res.has_value = true;
   }
 
   return res;
@@ -3100,54 +3983,184 @@ pg_string_ends_with(PgString haystack, PgString needle) {
   return pg_string_eq(needle, end);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgParseNumberResult
-pg_string_parse_u64(PgString s, u64 base, bool forbid_leading_zeroes) {
-  PG_ASSERT(10 == base || 16 == base);
+// Value + 1 of each ASCII hex digit, 0 for other bytes.
+static const u8 pg_hex_digit_values[256] = {
+    ['0'] = 1,   ['1'] = 2,   ['2'] = 3,   ['3'] = 4,   ['4'] = 5,
+    ['5'] = 6,   ['6'] = 7,   ['7'] = 8,   ['8'] = 9,   ['9'] = 10,
+    ['a'] = 11,  ['b'] = 12,  ['c'] = 13,  ['d'] = 14,  ['e'] = 15,
+    ['f'] = 16,  ['A'] = 11,  ['B'] = 12,  ['C'] = 13,  ['D'] = 14,
+    ['E'] = 15,  ['F'] = 16,
+};
 
-  PgParseNumberResult res = {0};
-  res.remaining = s;
+[[nodiscard]] static u64 pg_u64_load_unaligned(const u8 *p) {
+  u64 res = 0;
+  pg_memcpy(&res, p, sizeof(res));
+  return res;
+}
 
-  static const u8 hex_to_num[256] = {
-      ['0'] = 0,  ['1'] = 1,  ['2'] = 2,  ['3'] = 3,  ['4'] = 4,  ['5'] = 5,
-      ['6'] = 6,  ['7'] = 7,  ['8'] = 8,  ['9'] = 9,  ['a'] = 10, ['b'] = 11,
-      ['c'] = 12, ['d'] = 13, ['e'] = 14, ['f'] = 15, ['A'] = 10, ['B'] = 11,
-      ['C'] = 12, ['D'] = 13, ['E'] = 14, ['F'] = 15,
+// Are all 8 bytes in `'0'..'9'`? Endianness-independent.
+[[nodiscard]] static bool pg_swar_is_eight_decimal_digits(u64 x) {
+  return 0 == (((x & 0xf0f0f0f0f0f0f0f0ULL) |
+                (((x + 0x0606060606060606ULL) & 0xf0f0f0f0f0f0f0f0ULL) >> 4)) ^
+               0x3333333333333333ULL);
+}
+
+// Parse 8 decimal digits with 3 multiplications instead of 8.
+[[nodiscard]] static u32 pg_swar_parse_eight_decimal_digits(const u8 *p) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  u64 x = pg_u64_load_unaligned(p) - 0x3030303030303030ULL;
+  // Pairs of digits.
+  x = (x * 10) + (x >> 8);
+  // Groups of 4 digits, then 8.
+  x = (((x & 0x000000ff000000ffULL) * (100 + (1000000ULL << 32))) +
+       (((x >> 16) & 0x000000ff000000ffULL) * (1 + (10000ULL << 32)))) >>
+      32;
+  return (u32)x;
+#else
+  u32 res = 0;
+  for (u64 i = 0; i < 8; i++) {
+    res = res * 10 + (u32)(p[i] - '0');
+  }
+  return res;
+#endif
+}
 
-  };
+// Parse 8 hex digits, already validated.
+[[nodiscard]] static u32 pg_swar_parse_eight_hex_digits(const u8 *p) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  u64 x = pg_u64_load_unaligned(p);
+  // `'0'..'9'` => 0..9, `'a'..'f'` and `'A'..'F'` => 10..15: letters have
+  // the bit 6 set.
+  x = (x & 0x0f0f0f0f0f0f0f0fULL) + 9 * ((x >> 6) & 0x0101010101010101ULL);
+  // Pack nibbles: the first (most significant) digit is the lowest byte.
+  x = ((x & 0x0f000f000f000f00ULL) >> 8) | ((x & 0x000f000f000f000fULL) << 4);
+  x = (x | (x >> 8)) & 0x0000ffff0000ffffULL;
+  x = (x | (x >> 16)) & 0x00000000ffffffffULL;
+  return __builtin_bswap32((u32)x);
+#else
+  u32 res = 0;
+  for (u64 i = 0; i < 8; i++) {
+    res = (res << 4) | (u32)(pg_hex_digit_values[p[i]] - 1);
+  }
+  return res;
+#endif
+}
 
-  // Forbid leading zero(es) if there is more than one digit.
-  if (forbid_leading_zeroes && pg_string_starts_with(s, PG_S("0")) &&
-      s.len >= 2 && pg_rune_ascii_is_numeric(PG_SLICE_AT(s, 1))) {
-    return res;
+// Length of the run of digits at the start of `s`.
+[[nodiscard]] static u64 pg_digits_run_len(PgString s, u64 base) {
+  u64 i = 0;
+
+  if (16 == base) {
+    for (; i < s.len && pg_hex_digit_values[PG_SLICE_AT(s, i)]; i++) {
+    }
+    return i;
   }
 
-  PgUtf8Iterator it = pg_make_utf8_iterator(s);
-  u64 last_idx = 0;
-  for (;;) {
-    PgRuneUtf8Result res_rune = pg_utf8_iterator_next(&it);
-    if (res_rune.err || res_rune.end) {
+#if defined(__x86_64__) && defined(__SSE2__)
+  for (; i + 16 <= s.len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(void *)(s.data + i));
+    __m128i d = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    // Unsigned `d <= 9`.
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    u32 mask = ~(u32)_mm_movemask_epi8(is_digit) & 0xffff;
+    if (mask) {
+      return i + (u64)__builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; i + 8 <= s.len; i += 8) {
+    if (!pg_swar_is_eight_decimal_digits(pg_u64_load_unaligned(s.data + i))) {
       break;
     }
+  }
+  for (; i < s.len && pg_rune_ascii_is_numeric(PG_SLICE_AT(s, i)); i++) {
+  }
 
-    PgRune c = res_rune.rune;
-    if (10 == base &&
-        !pg_rune_ascii_is_numeric(c)) { // End of numbers sequence.
-      break;
+  return i;
+}
+
+// `digits` only contains valid digits. Returns false on overflow.
+[[nodiscard]] static bool pg_digits_to_u64(PgString digits, u64 base,
+                                           u64 *res) {
+  u64 n = 0;
+  u64 i = 0;
+
+  if (16 == base) {
+    if (digits.len > 16) {
+      return false;
     }
-    if (16 == base && !pg_rune_ascii_is_hex(c)) { // End of numbers sequence.
-      break;
+
+    for (; i + 8 <= digits.len; i += 8) {
+      n = (n << 32) | pg_swar_parse_eight_hex_digits(digits.data + i);
     }
+    for (; i < digits.len; i++) {
+      n = (n << 4) | (u64)(pg_hex_digit_values[PG_SLICE_AT(digits, i)] - 1);
+    }
+
+    *res = n;
+    return true;
+  }
+
+  // `UINT64_MAX` has 20 digits.
+  if (digits.len > 20) {
+    return false;
+  }
 
-    res.n *= base;
-    if (10 == base) {
-      res.n += (u8)c - '0';
-    } else if (16 == base) {
-      res.n += hex_to_num[c];
+  if (digits.len >= 16) {
+    u64 hi = pg_swar_parse_eight_decimal_digits(digits.data);
+    u64 lo = pg_swar_parse_eight_decimal_digits(digits.data + 8);
+    // 16 digits always fit, only the leftovers can overflow.
+    n = hi * 100000000 + lo;
+    i = 16;
+  }
+  for (; i + 8 <= digits.len; i += 8) {
+    if (ckd_mul(&n, n, 100000000) ||
+        ckd_add(&n, n, pg_swar_parse_eight_decimal_digits(digits.data + i))) {
+      return false;
+    }
+  }
+  for (; i < digits.len; i++) {
+    if (ckd_mul(&n, n, 10) ||
+        ckd_add(&n, n, (u64)(PG_SLICE_AT(digits, i) - '0'))) {
+      return false;
     }
-    res.present = true;
-    last_idx = it.idx;
   }
-  res.remaining = PG_SLICE_RANGE_START(s, last_idx);
+
+  *res = n;
+  return true;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgParseNumberResult
+pg_string_parse_u64(PgString s, u64 base, bool forbid_leading_zeroes) {
+  PG_ASSERT(10 == base || 16 == base);
+
+  PgParseNumberResult res = {0};
+  res.remaining = s;
+
+  // Forbid leading zero(es) if there is more than one digit.
+  if (forbid_leading_zeroes && pg_string_starts_with(s, PG_S("0")) &&
+      s.len >= 2 && pg_rune_ascii_is_numeric(PG_SLICE_AT(s, 1))) {
+    return res;
+  }
+
+  u64 digits_len = pg_digits_run_len(s, base);
+  if (0 == digits_len) {
+    return res;
+  }
+
+  // Leading zeroes do not count towards overflow.
+  u64 zeroes = 0;
+  for (; zeroes < digits_len && '0' == PG_SLICE_AT(s, zeroes); zeroes++) {
+  }
+
+  PgString significant = PG_SLICE_RANGE(s, zeroes, digits_len);
+  if (!pg_digits_to_u64(significant, base, &res.n)) {
+    res.overflow = true;
+    return res;
+  }
+
+  res.present = true;
+  res.remaining = PG_SLICE_RANGE_START(s, digits_len);
   return res;
 }
 
@@ -3580,16 +4593,70 @@ pg_string_to_cstr(PgString s, PgAllocator *allocator) {
 
 [[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
     pg_net_create_tcp_socket();
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_net_create_udp_socket();
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_udp_send_to(PgFileDescriptor sock, PgString data,
+                       PgIpv4Address address);
+[[maybe_unused]] [[nodiscard]] static PgIpv4AddressRecvResult
+pg_net_udp_recv_from(PgFileDescriptor sock, PgString dst);
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_net_create_udp_socket_ip(PgIpFamily family);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_udp_bind_ip(PgFileDescriptor sock, PgIpAddress address);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_udp_connect_ip(PgFileDescriptor sock, PgIpAddress address);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_udp_set_gro(PgFileDescriptor sock, bool enabled);
+// Returns how many datagrams were sent, possibly fewer than requested when
+// the socket buffer fills up. Up to `PG_NET_UDP_BATCH_MAX` per syscall.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_udp_send_batch(PgFileDescriptor sock,
+                          PG_SLICE(PgUdpDatagram) datagrams);
+// Waits for at least one datagram per the socket blocking mode, then returns
+// how many of `datagrams` were filled without waiting further, with one
+// syscall on Linux.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_udp_recv_batch(PgFileDescriptor sock,
+                          PG_SLICE(PgUdpDatagram) datagrams);
 [[maybe_unused]] [[nodiscard]] static PgError
 pg_net_socket_close(PgFileDescriptor sock);
 [[maybe_unused]] [[nodiscard]] static PgError
 pg_net_set_nodelay(PgFileDescriptor sock, bool enabled);
+// How long an accepted connection waited in the accept queue, since the
+// handshake or its last data. Linux only, 0 elsewhere.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_net_tcp_queue_time_ms(PgFileDescriptor sock);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_set_cork(PgFileDescriptor sock, bool enabled);
 [[maybe_unused]] [[nodiscard]] static PgError
 pg_net_connect_ipv4(PgFileDescriptor sock, PgIpv4Address address);
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_net_create_tcp_socket_ip(PgIpFamily family);
+// Does not wait for a non-blocking socket to connect.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_connect_ip(PgFileDescriptor sock, PgIpAddress address);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_tcp_bind_ip(PgFileDescriptor sock, PgIpAddress address);
+[[maybe_unused]] [[nodiscard]] static PgIpAddressAcceptResult
+pg_net_tcp_accept_ip(PgFileDescriptor sock);
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgIpAddress, PgError)
+    pg_net_socket_local_address_ip(PgFileDescriptor sock);
+
+// All the IPv4 and IPv6 addresses, interleaved per RFC 8305.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_SLICE(PgIpAddress), PgError)
+    pg_net_dns_resolve_ip(PgString host, u16 port, PgAllocator *allocator);
 
 [[maybe_unused]] [[nodiscard]] static PgError
 pg_net_socket_set_timeout(PgFileDescriptor sock, u64 seconds, u64 microseconds);
 
+// Resolve without connecting, to the first IPv4 address.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgIpv4Address, PgError)
+    pg_net_dns_resolve_ipv4(PgString host, u16 port, PgAllocator *allocator);
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgIpv4Address, PgError)
+    pg_net_socket_local_address(PgFileDescriptor sock);
+
 [[maybe_unused]] [[nodiscard]] static PG_RESULT(PgIpv4AddressSocket, PgError)
     pg_net_dns_resolve_ipv4_tcp(PgString host, u16 port,
                                 PgAllocator *allocator);
@@ -3604,6 +4671,8 @@ pg_net_socket_enable_reuse(PgFileDescriptor sock);
 
 [[maybe_unused]] [[nodiscard]] static PgError
 pg_net_socket_set_blocking(PgFileDescriptor sock, bool blocking);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_fd_set_blocking(PgFileDescriptor fd, bool block);
 
 [[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
     pg_net_socket_write(PgFileDescriptor sock, PgString data);
@@ -3629,6 +4698,10 @@ pg_net_get_socket_error(PgFileDescriptor socket);
 
 [[nodiscard]] static PgError pg_process_avoid_child_zombies();
 
+// Reap the child processes that exited, without waiting.
+// Returns how many there were.
+[[maybe_unused]] [[nodiscard]] static u64 pg_process_reap_children();
+
 [[maybe_unused]] [[nodiscard]] static PG_DYN(u8)
     pg_string_builder_make(u64 cap, PgAllocator *allocator) {
   PG_DYN(u8) res = {0};
@@ -3763,57 +4836,34 @@ pg_ring_write_bytes(PgRing *rg, PG_SLICE(u8) src) {
   PG_ASSERT(rg.data.data);
   PG_OPTION(u64) res = {0};
 
-  if (rg.idx_read <= rg.idx_write) { // 1 memchr.
+  // The readable bytes are in two parts when they wrap around.
+  u64 first_len = PG_MIN(rg.count, rg.data.len - rg.idx_read);
+  {
     u8 *start = rg.data.data + rg.idx_read;
-    u64 len =
-        rg.idx_read == rg.idx_write ? rg.count : (rg.idx_write - rg.idx_read);
-    u8 *find = __builtin_memchr(start, needle, len);
+    u8 *find = __builtin_memchr(start, needle, first_len);
     if (find) {
       res.has_value = true;
       res.value = (u64)(find - start);
+      return res;
     }
-    return res;
   }
 
-  if (rg.idx_write < rg.idx_read) { // 2 memchr.
-    {
-      u8 *start = rg.data.data + rg.idx_read;
-      u64 len = rg.data.len - rg.idx_read;
-      u8 *find = __builtin_memchr(start, needle, len);
-      if (find) {
-        res.has_value = true;
-        res.value = (u64)(find - start);
-      }
-    }
-
-    {
-      u8 *start = rg.data.data;
-      u64 len = rg.idx_write;
-      u8 *find = __builtin_memchr(start, needle, len);
-      if (find) {
-        res.has_value = true;
-        res.value = (u64)(find - start);
-      }
+  {
+    u8 *start = rg.data.data;
+    u8 *find = __builtin_memchr(start, needle, rg.count - first_len);
+    if (find) {
+      res.has_value = true;
+      res.value = first_len + (u64)(find - start);
     }
   }
   return res;
 }
 
 static void pg_ring_read_skip(PgRing *rg, u64 count) {
-  u64 skip = 0;
-  if (rg->idx_read == rg->idx_write) {
-    if (pg_ring_is_empty(*rg)) {
-      return;
-    }
-    skip = PG_MIN(count, rg->count);
-  } else if (rg->idx_read < rg->idx_write) {
-    skip = PG_MIN(rg->idx_write - rg->idx_read, count);
-  } else if (rg->idx_read > rg->idx_write) {
-    skip = PG_MIN(rg->idx_read - rg->idx_write, count);
+  u64 skip = PG_MIN(count, rg->count);
+  if (0 == skip) {
+    return;
   }
-  PG_ASSERT(skip <= count);
-  PG_ASSERT(skip <= rg->count);
-  PG_ASSERT(skip <= rg->data.len);
 
   rg->idx_read = (rg->idx_read + skip) % rg->data.len;
   rg->count -= skip;
@@ -3876,6 +4926,383 @@ static void pg_ring_read_skip(PgRing *rg, u64 count) {
   return sizeof(*val) == pg_ring_read_bytes(rg, s);
 }
 
+[[maybe_unused]] [[nodiscard]] static bool pg_is_power_of_two(u64 n) {
+  return 0 != n && 0 == (n & (n - 1));
+}
+
+[[maybe_unused]] [[nodiscard]] static PgSpscRing
+pg_spsc_ring_make(u64 cap, PgAllocator *allocator) {
+  PG_ASSERT(pg_is_power_of_two(cap));
+
+  return (PgSpscRing){.data = pg_string_make(cap, allocator)};
+}
+
+// Must only be called by the producer.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_spsc_ring_can_write_count(PgSpscRing *rg) {
+  u64 idx_write = atomic_load_explicit(&rg->idx_write, memory_order_relaxed);
+  rg->idx_read_cached =
+      atomic_load_explicit(&rg->idx_read, memory_order_acquire);
+  PG_ASSERT(idx_write - rg->idx_read_cached <= rg->data.len);
+
+  return rg->data.len - (idx_write - rg->idx_read_cached);
+}
+
+// Must only be called by the consumer.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_spsc_ring_can_read_count(PgSpscRing *rg) {
+  u64 idx_read = atomic_load_explicit(&rg->idx_read, memory_order_relaxed);
+  rg->idx_write_cached =
+      atomic_load_explicit(&rg->idx_write, memory_order_acquire);
+  PG_ASSERT(rg->idx_write_cached - idx_read <= rg->data.len);
+
+  return rg->idx_write_cached - idx_read;
+}
+
+// Must only be called by the producer.
+// Like `pg_ring_write_bytes`: write as much as possible and return the count
+// written. All bytes become visible to the consumer at once.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_spsc_ring_write_bytes(PgSpscRing *rg, PG_SLICE(u8) src) {
+  PG_ASSERT(nullptr != rg->data.data);
+  PG_ASSERT(pg_is_power_of_two(rg->data.len));
+
+  if (0 == src.len) {
+    return 0;
+  }
+
+  u64 idx_write = atomic_load_explicit(&rg->idx_write, memory_order_relaxed);
+  u64 space = rg->data.len - (idx_write - rg->idx_read_cached);
+  if (space < src.len) {
+    // Only go to the shared cache line when the cached value is not enough.
+    space = pg_spsc_ring_can_write_count(rg);
+  }
+
+  u64 write_count = PG_MIN(space, src.len);
+  if (0 == write_count) {
+    return 0;
+  }
+
+  u64 start = idx_write & (rg->data.len - 1);
+  u64 write_to_end_count = PG_MIN(write_count, rg->data.len - start);
+  pg_memcpy(rg->data.data + start, src.data, write_to_end_count);
+  pg_memcpy(rg->data.data, src.data + write_to_end_count,
+            write_count - write_to_end_count);
+
+  atomic_store_explicit(&rg->idx_write, idx_write + write_count,
+                        memory_order_release);
+
+  return write_count;
+}
+
+// Must only be called by the consumer.
+// Like `pg_ring_read_bytes`: read as much as possible and return the count
+// read.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_spsc_ring_read_bytes(PgSpscRing *rg, PG_SLICE(u8) dst) {
+  PG_ASSERT(nullptr != rg->data.data);
+  PG_ASSERT(pg_is_power_of_two(rg->data.len));
+
+  if (0 == dst.len) {
+    return 0;
+  }
+
+  u64 idx_read = atomic_load_explicit(&rg->idx_read, memory_order_relaxed);
+  u64 available = rg->idx_write_cached - idx_read;
+  if (available < dst.len) {
+    available = pg_spsc_ring_can_read_count(rg);
+  }
+
+  u64 read_count = PG_MIN(available, dst.len);
+  if (0 == read_count) {
+    return 0;
+  }
+
+  u64 start = idx_read & (rg->data.len - 1);
+  u64 read_to_end_count = PG_MIN(read_count, rg->data.len - start);
+  pg_memcpy(dst.data, rg->data.data + start, read_to_end_count);
+  pg_memcpy(dst.data + read_to_end_count, rg->data.data,
+            read_count - read_to_end_count);
+
+  atomic_store_explicit(&rg->idx_read, idx_read + read_count,
+                        memory_order_release);
+
+  return read_count;
+}
+
+// Must only be called by the producer.
+// Write all of `src` or nothing, e.g. for fixed-size records.
+[[maybe_unused]] [[nodiscard]] static bool
+pg_spsc_ring_write_full(PgSpscRing *rg, PG_SLICE(u8) src) {
+  if (pg_spsc_ring_can_write_count(rg) < src.len) {
+    return false;
+  }
+
+  PG_ASSERT(src.len == pg_spsc_ring_write_bytes(rg, src));
+  return true;
+}
+
+// Must only be called by the consumer.
+// Read exactly `dst.len` bytes or nothing, e.g. for fixed-size records.
+[[maybe_unused]] [[nodiscard]] static bool
+pg_spsc_ring_read_full(PgSpscRing *rg, PG_SLICE(u8) dst) {
+  if (pg_spsc_ring_can_read_count(rg) < dst.len) {
+    return false;
+  }
+
+  PG_ASSERT(dst.len == pg_spsc_ring_read_bytes(rg, dst));
+  return true;
+}
+
+#define PG_MPMC_QUEUE_MAKE(T, cap, allocator)                                  \
+  (pg_mpmc_queue_make(sizeof(T), _Alignof(T), cap, allocator))
+
+[[maybe_unused]] [[nodiscard]] static PgMpmcQueue
+pg_mpmc_queue_make(u64 elem_size, u64 elem_align, u64 cap,
+                   PgAllocator *allocator) {
+  PG_ASSERT(pg_is_power_of_two(cap));
+  PG_ASSERT(elem_size > 0);
+  // Elements are stored right after the 8 bytes sequence number.
+  PG_ASSERT(elem_align <= sizeof(u64));
+
+  PgMpmcQueue res = {0};
+  res.elem_size = elem_size;
+  res.mask = cap - 1;
+  res.cell_size = (sizeof(u64) + elem_size + sizeof(u64) - 1) &
+                  ~(sizeof(u64) - 1);
+  res.cells = pg_alloc(allocator, res.cell_size, _Alignof(u64), cap);
+  PG_ASSERT(res.cells);
+
+  for (u64 i = 0; i < cap; i++) {
+    _Atomic u64 *seq = (_Atomic u64 *)(void *)(res.cells + i * res.cell_size);
+    atomic_init(seq, i);
+  }
+
+  return res;
+}
+
+[[nodiscard]] static _Atomic u64 *
+pg_mpmc_queue_cell_sequence(PgMpmcQueue *queue, u64 pos) {
+  return (_Atomic u64 *)(void *)(queue->cells +
+                                 (pos & queue->mask) * queue->cell_size);
+}
+
+[[nodiscard]] static u8 *pg_mpmc_queue_cell_data(PgMpmcQueue *queue,
+                                                 u64 pos) {
+  return queue->cells + (pos & queue->mask) * queue->cell_size + sizeof(u64);
+}
+
+// Enqueue up to `elems_count` elements stored contiguously in `elems`, claiming
+// all the slots with one CAS. Returns the count enqueued, 0 if full.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_mpmc_queue_enqueue_batch(PgMpmcQueue *queue, void *elems,
+                            u64 elems_count) {
+  PG_ASSERT(queue->cells);
+  PG_ASSERT(elems);
+
+  elems_count = PG_MIN(elems_count, queue->mask + 1);
+  if (0 == elems_count) {
+    return 0;
+  }
+
+  u8 *src = elems;
+  u64 pos = atomic_load_explicit(&queue->idx_enqueue, memory_order_relaxed);
+
+  for (;;) {
+    u64 count = 0;
+    for (; count < elems_count; count++) {
+      u64 seq = atomic_load_explicit(
+          pg_mpmc_queue_cell_sequence(queue, pos + count),
+          memory_order_acquire);
+      if (seq != pos + count) {
+        break;
+      }
+    }
+
+    if (0 == count) {
+      u64 seq = atomic_load_explicit(pg_mpmc_queue_cell_sequence(queue, pos),
+                                     memory_order_acquire);
+      if ((i64)(seq - pos) < 0) { // Full.
+        return 0;
+      }
+
+      // Another producer got there first.
+      pos = atomic_load_explicit(&queue->idx_enqueue, memory_order_relaxed);
+      continue;
+    }
+
+    // On failure, `pos` gets the current value.
+    if (atomic_compare_exchange_weak_explicit(&queue->idx_enqueue, &pos,
+                                              pos + count, memory_order_relaxed,
+                                              memory_order_relaxed)) {
+      for (u64 i = 0; i < count; i++) {
+        pg_memcpy(pg_mpmc_queue_cell_data(queue, pos + i),
+                  src + i * queue->elem_size, queue->elem_size);
+        atomic_store_explicit(pg_mpmc_queue_cell_sequence(queue, pos + i),
+                              pos + i + 1, memory_order_release);
+      }
+      return count;
+    }
+  }
+}
+
+// Dequeue up to `elems_count` elements into `elems`, claiming all the slots
+// with one CAS. Returns the count dequeued, 0 if empty.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_mpmc_queue_dequeue_batch(PgMpmcQueue *queue, void *elems,
+                            u64 elems_count) {
+  PG_ASSERT(queue->cells);
+  PG_ASSERT(elems);
+
+  elems_count = PG_MIN(elems_count, queue->mask + 1);
+  if (0 == elems_count) {
+    return 0;
+  }
+
+  u8 *dst = elems;
+  u64 pos = atomic_load_explicit(&queue->idx_dequeue, memory_order_relaxed);
+
+  for (;;) {
+    u64 count = 0;
+    for (; count < elems_count; count++) {
+      u64 seq = atomic_load_explicit(
+          pg_mpmc_queue_cell_sequence(queue, pos + count),
+          memory_order_acquire);
+      if (seq != pos + count + 1) {
+        break;
+      }
+    }
+
+    if (0 == count) {
+      u64 seq = atomic_load_explicit(pg_mpmc_queue_cell_sequence(queue, pos),
+                                     memory_order_acquire);
+      if ((i64)(seq - (pos + 1)) < 0) { // Empty.
+        return 0;
+      }
+
+      // Another consumer got there first.
+      pos = atomic_load_explicit(&queue->idx_dequeue, memory_order_relaxed);
+      continue;
+    }
+
+    // On failure, `pos` gets the current value.
+    if (atomic_compare_exchange_weak_explicit(&queue->idx_dequeue, &pos,
+                                              pos + count, memory_order_relaxed,
+                                              memory_order_relaxed)) {
+      for (u64 i = 0; i < count; i++) {
+        pg_memcpy(dst + i * queue->elem_size,
+                  pg_mpmc_queue_cell_data(queue, pos + i), queue->elem_size);
+        // Free the cell for the producer of the next lap.
+        atomic_store_explicit(pg_mpmc_queue_cell_sequence(queue, pos + i),
+                              pos + i + queue->mask + 1, memory_order_release);
+      }
+      return count;
+    }
+  }
+}
+
+[[maybe_unused]] [[nodiscard]] static bool
+pg_mpmc_queue_try_enqueue(PgMpmcQueue *queue, void *elem) {
+  return 1 == pg_mpmc_queue_enqueue_batch(queue, elem, 1);
+}
+
+[[maybe_unused]] [[nodiscard]] static bool
+pg_mpmc_queue_try_dequeue(PgMpmcQueue *queue, void *elem) {
+  return 1 == pg_mpmc_queue_dequeue_batch(queue, elem, 1);
+}
+
+// `burst` tokens per key, refilled at `per_s` tokens per second.
+// `slots_len` must be a power of two.
+[[maybe_unused]] [[nodiscard]] static PgRateLimiter
+pg_rate_limiter_make(u64 per_s, u64 burst, u64 slots_len,
+                     PgAllocator *allocator) {
+  PG_ASSERT(per_s > 0);
+  PG_ASSERT(burst > 0);
+  PG_ASSERT(pg_is_power_of_two(slots_len));
+
+  PgRateLimiter res = {0};
+  res.slots_len = slots_len;
+  res.slots = pg_alloc(allocator, sizeof(PgRateLimiterSlot),
+                       _Alignof(PgRateLimiterSlot), res.slots_len);
+  res.interval_ns = PG_MAX(PG_Seconds / per_s, 1);
+  res.burst_ns = res.interval_ns * burst;
+  return res;
+}
+
+#define PG_RATE_LIMITER_PROBES 8
+
+// Take a token from the bucket of `key`.
+// A slot whose bucket is full again holds nothing worth keeping and may be
+// taken over by another key. When all the slots around are in use, the key
+// is let through untracked.
+[[maybe_unused]] [[nodiscard]] static bool
+pg_rate_limiter_allow(PgRateLimiter *limiter, u64 key, u64 now_ns) {
+  PG_ASSERT(key < UINT64_MAX);
+  u64 stored_key = key + 1;
+
+  PG_SLICE(u8) key_bytes = {.data = (u8 *)&key, .len = sizeof(key)};
+  u64 hash = pg_hash_fnv(key_bytes);
+
+  PgRateLimiterSlot *slot = nullptr;
+  PgRateLimiterSlot *reclaimable = nullptr;
+  u64 reclaimable_key = 0;
+  for (u64 i = 0; i < PG_RATE_LIMITER_PROBES && !slot; i++) {
+    PgRateLimiterSlot *it =
+        &limiter->slots[(hash + i) & (limiter->slots_len - 1)];
+    u64 it_key = atomic_load_explicit(&it->key, memory_order_acquire);
+    if (0 == it_key &&
+        atomic_compare_exchange_strong_explicit(&it->key, &it_key, stored_key,
+                                                memory_order_acq_rel,
+                                                memory_order_acquire)) {
+      slot = it;
+    } else if (stored_key == it_key) {
+      slot = it;
+    } else if (!reclaimable &&
+               atomic_load_explicit(&it->full_at_ns, memory_order_relaxed) <=
+                   now_ns) {
+      reclaimable = it;
+      reclaimable_key = it_key;
+    }
+  }
+
+  if (!slot) {
+    if (!reclaimable || !atomic_compare_exchange_strong_explicit(
+                            &reclaimable->key, &reclaimable_key, stored_key,
+                            memory_order_acq_rel, memory_order_acquire)) {
+      return true;
+    }
+    slot = reclaimable;
+  }
+
+  u64 full_at_ns =
+      atomic_load_explicit(&slot->full_at_ns, memory_order_relaxed);
+  for (;;) {
+    u64 next_ns = PG_MAX(full_at_ns, now_ns) + limiter->interval_ns;
+    if (next_ns - now_ns > limiter->burst_ns) {
+      return false;
+    }
+    if (atomic_compare_exchange_weak_explicit(&slot->full_at_ns, &full_at_ns,
+                                              next_ns, memory_order_relaxed,
+                                              memory_order_relaxed)) {
+      return true;
+    }
+  }
+}
+
+// HTTP body adaptors, defined with the rest of the HTTP code.
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_http_body_read(PgReader *r, PG_SLICE(u8) dst);
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_http_chunked_read(PgReader *r, PG_SLICE(u8) dst);
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_http_chunked_write(PgWriter *w, PG_SLICE(u8) src,
+                          PgAllocator *allocator);
+// Compression adaptors, defined with DEFLATE.
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_inflate_read(PgReader *r, PG_SLICE(u8) dst);
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_deflate_write(PgWriter *w, PG_SLICE(u8) src, PgAllocator *allocator);
+
 [[maybe_unused]] [[nodiscard]] static PgError pg_writer_close(PgWriter *w) {
   PG_ASSERT(w);
 
@@ -3886,6 +5313,8 @@ static void pg_ring_read_skip(PgRing *rg, u64 count) {
 
   case PG_WRITER_KIND_NONE:
   case PG_WRITER_KIND_BYTES:
+  case PG_WRITER_KIND_HTTP_CHUNKED: // Does not own the underlying writer.
+  case PG_WRITER_KIND_DEFLATE:
     return 0;
   default:
     PG_ASSERT(0);
@@ -3902,6 +5331,9 @@ static void pg_ring_read_skip(PgRing *rg, u64 count) {
 
   case PG_READER_KIND_NONE:
   case PG_READER_KIND_BYTES:
+  case PG_READER_KIND_HTTP_BODY: // Does not own the underlying reader.
+  case PG_READER_KIND_HTTP_CHUNKED:
+  case PG_READER_KIND_INFLATE:
     return 0;
   default:
     PG_ASSERT(0);
@@ -3928,6 +5360,10 @@ pg_writer_make_string_builder(u64 cap, PgAllocator *allocator) {
     return PG_OK(src.len, u64, PgError);
   case PG_WRITER_KIND_SOCKET:
     return pg_net_socket_write(w->u.socket, src);
+  case PG_WRITER_KIND_HTTP_CHUNKED:
+    return pg_http_chunked_write(w, src, allocator);
+  case PG_WRITER_KIND_DEFLATE:
+    return pg_deflate_write(w, src, allocator);
   }
   default:
     PG_ASSERT(0);
@@ -4001,17 +5437,20 @@ pg_writer_flush(PgWriter *w, PgAllocator *allocator) {
   // Buffered reader.
   // Could `src` fit in the ring buffer?
   if (src.len > w->ring.data.len) {
-    // Do not bother going through the ring buffer, just write all we can
-    // directly.
+    // Do not bother going through the ring buffer, just write all of it
+    // directly, after what is already buffered to preserve ordering.
+    PgError err = pg_writer_flush(w, allocator);
+    if (err) {
+      return PG_ERR(err, u64, PgError);
+    }
 
     // TODO: Questionable to use `xxx_write_full` in a function that
     // is supposed to be able to do partial writes.
-    PgError err = pg_writer_do_write_full(
-        w, PG_SLICE_RANGE(src, 0, src.len - w->ring.data.len), allocator);
+    err = pg_writer_do_write_full(w, src, allocator);
     if (err) {
       return PG_ERR(err, u64, PgError);
     }
-    src = PG_SLICE_RANGE(src, 0, src.len % w->ring.data.len);
+    return PG_OK(src.len, u64, PgError);
   }
 
   // `src` fits in the ring buffer.
@@ -4093,6 +5532,12 @@ pg_writer_write_full(PgWriter *w, PG_SLICE(u8) s, PgAllocator *allocator) {
     return pg_net_socket_read(r->u.socket, dst);
   case PG_READER_KIND_FILE:
     return pg_file_read(r->u.file, dst);
+  case PG_READER_KIND_HTTP_BODY:
+    return pg_http_body_read(r, dst);
+  case PG_READER_KIND_HTTP_CHUNKED:
+    return pg_http_chunked_read(r, dst);
+  case PG_READER_KIND_INFLATE:
+    return pg_inflate_read(r, dst);
   default:
     PG_ASSERT(0);
   }
@@ -4295,8 +5740,23 @@ pg_reader_read_full(PgReader *r, u8 *s, u64 len) {
   return PG_OK(res, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(i64, PgError)
-    pg_reader_read_i64_leb128(PgReader *r) {
+[[maybe_unused]] static void
+pg_string_builder_append_u64_leb128(PG_DYN(u8) * sb, u64 n,
+                                    PgAllocator *allocator) {
+  do {
+    u8 byte = n & 0x7F;
+    n >>= 7;
+
+    // More to come?
+    if (0 != n) {
+      byte |= 0x80;
+    }
+    PG_DYN_PUSH(sb, byte, allocator);
+  } while (0 != n);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(i64, PgError)
+    pg_reader_read_i64_leb128(PgReader *r) {
   i64 res = 0;
   u8 byte = 0;
   u64 shift = 0;
@@ -4336,6 +5796,9 @@ pg_reader_read_full(PgReader *r, u8 *s, u64 len) {
   case PG_READER_KIND_NONE:
     return res;
   case PG_READER_KIND_BYTES:
+  case PG_READER_KIND_HTTP_BODY:
+  case PG_READER_KIND_HTTP_CHUNKED:
+  case PG_READER_KIND_INFLATE:
     return pg_reader_do_read(r, dst);
   case PG_READER_KIND_SOCKET:
     return pg_net_socket_read_non_blocking(r->u.socket, dst);
@@ -4377,53 +5840,302 @@ pg_reader_read_full(PgReader *r, u8 *s, u64 len) {
   return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_writer_write_u64_as_string(PgWriter *w, u64 n, PgAllocator *allocator) {
-  u8 tmp[30] = {0};
-  u64 idx = PG_STATIC_ARRAY_LEN(tmp);
+// Batch API: parse all the numbers in `s`, separated by runs of any of the
+// `separators` bytes (e.g. columns of numbers in a text file), into `out`.
+// Stops at the first field which is not a valid number (including overflow):
+// the returned string starts there, and is empty if everything was parsed.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_string_parse_u64_many(PgString s, u64 base, PgString separators,
+                         PG_DYN(u64) * out, PgAllocator *allocator) {
+  PG_ASSERT(10 == base || 16 == base);
+
+  u64 is_separator[4] = {0};
+  PG_EACH_PTR(c, &separators) { is_separator[*c / 64] |= 1ULL << (*c % 64); }
+
+  u64 i = 0;
+  for (;;) {
+    for (; i < s.len && (is_separator[PG_SLICE_AT(s, i) / 64] >>
+                         (PG_SLICE_AT(s, i) % 64)) &
+                            1;
+         i++) {
+    }
+    if (i == s.len) {
+      break;
+    }
+
+    PgString remaining = PG_SLICE_RANGE_START(s, i);
+    u64 digits_len = pg_digits_run_len(remaining, base);
+    u64 n = 0;
+    if (0 == digits_len ||
+        !pg_digits_to_u64(PG_SLICE_RANGE(remaining, 0, digits_len), base,
+                          &n)) {
+      return remaining;
+    }
+
+    // The number must be followed by a separator or the end.
+    if (digits_len < remaining.len) {
+      u8 c = PG_SLICE_AT(remaining, digits_len);
+      if (!((is_separator[c / 64] >> (c % 64)) & 1)) {
+        return remaining;
+      }
+    }
+
+    PG_DYN_PUSH(out, n, allocator);
+    i += digits_len;
+  }
+
+  return PG_SLICE_RANGE_START(s, s.len);
+}
+
+// Reserve `len` contiguous bytes in the writer's own buffer (dyn buffer or
+// ring) so that the caller can format directly into it, followed by
+// `pg_writer_commit`.
+// Returns an empty slice when the writer has no such buffer (e.g. unbuffered
+// file or socket) or when the free space in the ring wraps around: the caller
+// should then fall back to `pg_writer_write_full` with a temporary buffer.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
+    pg_writer_reserve(PgWriter *w, u64 len, PgAllocator *allocator) {
+  PG_ASSERT(w);
+
+  if (0 == len) {
+    return PG_OK((PgString){0}, PgString, PgError);
+  }
+
+  if (0 == w->ring.data.len) {
+    if (PG_WRITER_KIND_BYTES != w->kind) {
+      return PG_OK((PgString){0}, PgString, PgError);
+    }
+
+    PG_DYN_ENSURE_CAP(&w->u.bytes, w->u.bytes.len + len, allocator);
+    PgString res = {.data = w->u.bytes.data + w->u.bytes.len, .len = len};
+    return PG_OK(res, PgString, PgError);
+  }
+
+  if (len > w->ring.data.len) {
+    return PG_OK((PgString){0}, PgString, PgError);
+  }
+
+  if (pg_ring_can_write_count(w->ring) < len ||
+      w->ring.idx_write + len > w->ring.data.len) {
+    PgError err = pg_writer_flush(w, allocator);
+    if (err) {
+      return PG_ERR(err, PgString, PgError);
+    }
+  }
+
+  // After a flush, the ring is empty but its indices are wherever the last
+  // read left them.
+  if (0 == w->ring.count) {
+    w->ring.idx_read = w->ring.idx_write = 0;
+  }
+
+  if (pg_ring_can_write_count(w->ring) < len ||
+      w->ring.idx_write + len > w->ring.data.len) {
+    return PG_OK((PgString){0}, PgString, PgError);
+  }
+
+  PgString res = {.data = w->ring.data.data + w->ring.idx_write, .len = len};
+  return PG_OK(res, PgString, PgError);
+}
+
+// Mark `len` bytes previously returned by `pg_writer_reserve` as written.
+[[maybe_unused]] static void pg_writer_commit(PgWriter *w, u64 len) {
+  PG_ASSERT(w);
+
+  if (0 == w->ring.data.len) {
+    PG_ASSERT(PG_WRITER_KIND_BYTES == w->kind);
+    PG_ASSERT(w->u.bytes.len + len <= w->u.bytes.cap);
+    w->u.bytes.len += len;
+    return;
+  }
+
+  PG_ASSERT(w->ring.idx_write + len <= w->ring.data.len);
+  PG_ASSERT(w->ring.count + len <= w->ring.data.len);
+  w->ring.idx_write = (w->ring.idx_write + len) % w->ring.data.len;
+  w->ring.count += len;
+}
+
+// `"00" "01" ... "99"`: two digits per lookup, halving the number of
+// divisions.
+static const u8 pg_decimal_digit_pairs[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0',
+    '7', '0', '8', '0', '9', '1', '0', '1', '1', '1', '2', '1', '3', '1', '4',
+    '1', '5', '1', '6', '1', '7', '1', '8', '1', '9', '2', '0', '2', '1', '2',
+    '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3',
+    '7', '3', '8', '3', '9', '4', '0', '4', '1', '4', '2', '4', '3', '4', '4',
+    '4', '5', '4', '6', '4', '7', '4', '8', '4', '9', '5', '0', '5', '1', '5',
+    '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6',
+    '7', '6', '8', '6', '9', '7', '0', '7', '1', '7', '2', '7', '3', '7', '4',
+    '7', '5', '7', '6', '7', '7', '7', '8', '7', '9', '8', '0', '8', '1', '8',
+    '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9',
+    '7', '9', '8', '9', '9',
+};
+
+static const u64 pg_u64_powers_of_10[20] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+#define PG_U64_DECIMAL_MAX_LEN 20
+#define PG_I64_DECIMAL_MAX_LEN 20
+#define PG_U128_DECIMAL_MAX_LEN 39
 
+// No loop: estimate from the bit length (`log10(2) ~= 1233 / 4096`) and
+// correct with one comparison.
+[[maybe_unused]] [[nodiscard]] static u64 pg_u64_decimal_digits_count(u64 n) {
+  u64 bits = 64 - (u64)__builtin_clzll(n | 1);
+  u64 approx = (bits * 1233) >> 12;
+  PG_ASSERT(approx < PG_STATIC_ARRAY_LEN(pg_u64_powers_of_10));
+
+  return approx + 1 - ((n | 1) < pg_u64_powers_of_10[approx]);
+}
+
+// Write exactly `dst.len` digits of `n`, zero-padded on the left, from right
+// to left. 32 bits arithmetic is cheaper so it is the inner kernel.
+static void pg_u32_to_decimal_fixed(u32 n, PgString dst) {
+  u8 *p = dst.data + dst.len;
+
+  while (p - dst.data >= 2) {
+    u32 q = n / 100;
+    u32 r = n - q * 100;
+    p -= 2;
+    pg_memcpy(p, pg_decimal_digit_pairs + r * 2, 2);
+    n = q;
+  }
+  if (p > dst.data) {
+    p -= 1;
+    *p = (u8)('0' + n % 10);
+  }
+}
+
+[[maybe_unused]] static void pg_u64_to_decimal_fixed(u64 n, PgString dst) {
+  // Peel 8 digits at a time so that the rest is done in 32 bits.
+  while (dst.len > 8) {
+    u64 q = n / 100000000;
+    u32 r = (u32)(n - q * 100000000);
+    pg_u32_to_decimal_fixed(r, PG_SLICE_RANGE_START(dst, dst.len - 8));
+    dst.len -= 8;
+    n = q;
+  }
+  PG_ASSERT(n < 100000000);
+  pg_u32_to_decimal_fixed((u32)n, dst);
+}
+
+// Returns the number of bytes written.
+[[maybe_unused]] static u64
+pg_u64_to_decimal(u64 n, u8 dst[PG_U64_DECIMAL_MAX_LEN]) {
+  u64 len = pg_u64_decimal_digits_count(n);
+  pg_u64_to_decimal_fixed(n, (PgString){.data = dst, .len = len});
+  return len;
+}
+
+// Returns the number of bytes written.
+[[maybe_unused]] static u64
+pg_i64_to_decimal(i64 n, u8 dst[PG_I64_DECIMAL_MAX_LEN]) {
+  // Negating in unsigned arithmetic also handles `INT64_MIN`.
+  u64 magnitude = n < 0 ? (u64)0 - (u64)n : (u64)n;
+  u64 sign = n < 0;
+  dst[0] = '-';
+
+  return sign + pg_u64_to_decimal(magnitude, dst + sign);
+}
+
+// Returns the number of bytes written.
+[[maybe_unused]] static u64
+pg_u128_to_decimal(u128 n, u8 dst[PG_U128_DECIMAL_MAX_LEN]) {
+  // Split in base 10^19 chunks, each fitting in a u64.
+  const u64 base = pg_u64_powers_of_10[19];
+  u64 chunks[3] = {0};
+  u64 chunks_count = 0;
   do {
-    idx -= 1;
-    PG_C_ARRAY_AT(tmp, PG_STATIC_ARRAY_LEN(tmp), idx) = '0' + (n % 10);
-    n /= 10;
+    PG_ASSERT(chunks_count < PG_STATIC_ARRAY_LEN(chunks));
+    chunks[chunks_count++] = (u64)(n % base);
+    n /= base;
   } while (n > 0);
 
-  PG_ASSERT(idx <= PG_STATIC_ARRAY_LEN(tmp));
+  u64 len = pg_u64_to_decimal(chunks[chunks_count - 1], dst);
+  for (u64 i = chunks_count - 1; i > 0; i--) {
+    pg_u64_to_decimal_fixed(chunks[i - 1],
+                            (PgString){.data = dst + len, .len = 19});
+    len += 19;
+  }
+  PG_ASSERT(len <= PG_U128_DECIMAL_MAX_LEN);
+
+  return len;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_writer_write_u64_as_string(PgWriter *w, u64 n, PgAllocator *allocator) {
+  u64 len = pg_u64_decimal_digits_count(n);
 
-  PgString s = {.data = tmp + idx, .len = PG_STATIC_ARRAY_LEN(tmp) - idx};
+  PG_RESULT(PgString, PgError)
+  res_reserve = pg_writer_reserve(w, len, allocator);
+  PG_IF_LET_ERR(err, res_reserve) {
+    return err;
+  }
+  PgString dst = PG_UNWRAP(res_reserve);
+  if (dst.len == len) {
+    pg_u64_to_decimal_fixed(n, dst);
+    pg_writer_commit(w, len);
+    return 0;
+  }
 
+  u8 tmp[PG_U64_DECIMAL_MAX_LEN] = {0};
+  PgString s = {.data = tmp, .len = pg_u64_to_decimal(n, tmp)};
   return pg_writer_write_full(w, s, allocator);
 }
 
 [[maybe_unused]] [[nodiscard]] static PgError
 pg_writer_write_u128_as_string(PgWriter *w, u128 n, PgAllocator *allocator) {
-  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, n >> 64, allocator));
-  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, n & UINT64_MAX, allocator));
+  u8 tmp[PG_U128_DECIMAL_MAX_LEN] = {0};
+  PgString s = {.data = tmp, .len = pg_u128_to_decimal(n, tmp)};
 
-  return 0;
+  return pg_writer_write_full(w, s, allocator);
 }
 
 [[maybe_unused]] [[nodiscard]] static PgError
 pg_writer_write_i64_as_string(PgWriter *w, i64 n, PgAllocator *allocator) {
-  u8 tmp[30] = {0};
-  u64 idx = PG_STATIC_ARRAY_LEN(tmp);
-
-  u64 val = n < 0 ? (u64)-n : (u64)n;
-  while (val > 0) {
-    idx -= 1;
-    PG_C_ARRAY_AT(tmp, PG_STATIC_ARRAY_LEN(tmp), idx) = '0' + (val % 10);
-    val /= 10;
-  }
-
-  if (n < 0) {
-    idx -= 1;
-    PG_C_ARRAY_AT(tmp, PG_STATIC_ARRAY_LEN(tmp), idx) = '-';
+  if (n >= 0) {
+    return pg_writer_write_u64_as_string(w, (u64)n, allocator);
   }
 
-  PG_ASSERT(idx <= PG_STATIC_ARRAY_LEN(tmp));
+  u64 len = 1 + pg_u64_decimal_digits_count((u64)0 - (u64)n);
 
-  PgString s = {.data = tmp + idx, .len = PG_STATIC_ARRAY_LEN(tmp) - idx};
+  PG_RESULT(PgString, PgError)
+  res_reserve = pg_writer_reserve(w, len, allocator);
+  PG_IF_LET_ERR(err, res_reserve) {
+    return err;
+  }
+  PgString dst = PG_UNWRAP(res_reserve);
+  if (dst.len == len) {
+    PG_ASSERT(len == pg_i64_to_decimal(n, dst.data));
+    pg_writer_commit(w, len);
+    return 0;
+  }
 
+  u8 tmp[PG_I64_DECIMAL_MAX_LEN] = {0};
+  PgString s = {.data = tmp, .len = pg_i64_to_decimal(n, tmp)};
   return pg_writer_write_full(w, s, allocator);
 }
 
@@ -4439,8 +6151,8 @@ pg_writer_write_i64_as_string(PgWriter *w, i64 n, PgAllocator *allocator) {
 [[maybe_unused]] static void
 pg_string_builder_append_rune(PG_DYN(u8) * sb, PgRune rune,
                               PgAllocator *allocator) {
-  PG_SLICE(u8)
-  bytes = {.data = (u8 *)&rune, .len = pg_utf8_rune_bytes_count(rune)};
+  u8 tmp[4] = {0};
+  PG_SLICE(u8) bytes = {.data = tmp, .len = pg_utf8_encode_rune(rune, tmp)};
   PG_DYN_APPEND_SLICE(sb, bytes, allocator);
 }
 
@@ -4513,62 +6225,354 @@ pg_string_builder_append_string(PG_DYN(u8) * sb, PgString s,
   }
 }
 
-[[maybe_unused]] static void
-pg_string_builder_append_js_string_escaped(PG_DYN(u8) * sb, PgString s,
-                                           PgAllocator *allocator) {
-  PgUtf8Iterator it = pg_make_utf8_iterator(s);
+// Escaping engine shared by the HTML, JS and logfmt escaping functions.
+// Bytes are classified 16 or 32 at a time, clean runs are copied in one go and
+// only the (rare) flagged bytes go through the scalar path.
+// The classification is conservative: a flagged byte may still end up being
+// copied as is by `pg_escape_next` (e.g. JS control characters without a short
+// escape sequence).
 
-  for (u64 i = 0; i < s.len; i++) {
-    PgRuneUtf8Result res_rune = pg_utf8_iterator_next(&it);
-    PG_ASSERT(0 == res_rune.err);
-    if (res_rune.end) {
-      break;
+#define PG_ESCAPE_REPLACEMENT_MAX_LEN 16
+
+[[maybe_unused]] [[nodiscard]] static bool
+pg_escape_byte_is_flagged(u8 c, PgEscapeKind kind) {
+  switch (kind) {
+  case PG_ESCAPE_KIND_HTML:
+    return '&' == c || '<' == c || '>' == c || '"' == c || '\'' == c;
+  case PG_ESCAPE_KIND_JS:
+    return c <= '\r' || c >= 0x80 || '\'' == c || '"' == c || '\\' == c;
+  case PG_ESCAPE_KIND_LOGFMT:
+    return c < ' ' || '\\' == c || '"' == c;
+  default:
+    PG_ASSERT(0);
+  }
+}
+
+#if defined(__x86_64__) && defined(__AVX2__)
+[[maybe_unused]] [[nodiscard]] static u32 pg_escape_mask_avx2(__m256i v,
+                                                              PgEscapeKind kind) {
+  __m256i m = _mm256_setzero_si256();
+
+  switch (kind) {
+  case PG_ESCAPE_KIND_HTML:
+    m = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('&'));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('<')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('>')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\'')));
+    break;
+  case PG_ESCAPE_KIND_JS:
+    // Unsigned `v <= '\r'`.
+    m = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8('\r')), v);
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\'')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+    // Non-ASCII: the movemask only looks at the high bit.
+    m = _mm256_or_si256(m, v);
+    break;
+  case PG_ESCAPE_KIND_LOGFMT:
+    // Unsigned `v < ' '`.
+    m = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(' ' - 1)), v);
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+    break;
+  default:
+    PG_ASSERT(0);
+  }
+
+  return (u32)_mm256_movemask_epi8(m);
+}
+#endif
+
+#if defined(__x86_64__) && defined(__SSE2__)
+[[maybe_unused]] [[nodiscard]] static u32 pg_escape_mask_sse2(__m128i v,
+                                                              PgEscapeKind kind) {
+  __m128i m = _mm_setzero_si128();
+
+  switch (kind) {
+  case PG_ESCAPE_KIND_HTML:
+    m = _mm_cmpeq_epi8(v, _mm_set1_epi8('&'));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('<')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('>')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\'')));
+    break;
+  case PG_ESCAPE_KIND_JS:
+    m = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8('\r')), v);
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\'')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    m = _mm_or_si128(m, v);
+    break;
+  case PG_ESCAPE_KIND_LOGFMT:
+    m = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(' ' - 1)), v);
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    break;
+  default:
+    PG_ASSERT(0);
+  }
+
+  return (u32)_mm_movemask_epi8(m);
+}
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+// 4 bits per input byte.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_escape_mask_neon(uint8x16_t v, PgEscapeKind kind) {
+  uint8x16_t m = vdupq_n_u8(0);
+
+  switch (kind) {
+  case PG_ESCAPE_KIND_HTML:
+    m = vceqq_u8(v, vdupq_n_u8('&'));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('<')));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('>')));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('"')));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\'')));
+    break;
+  case PG_ESCAPE_KIND_JS:
+    m = vcleq_u8(v, vdupq_n_u8('\r'));
+    m = vorrq_u8(m, vcgeq_u8(v, vdupq_n_u8(0x80)));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\'')));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('"')));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\\')));
+    break;
+  case PG_ESCAPE_KIND_LOGFMT:
+    m = vcltq_u8(v, vdupq_n_u8(' '));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\\')));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('"')));
+    break;
+  default:
+    PG_ASSERT(0);
+  }
+
+  uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(m), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+#endif
+
+// Index of the first byte at or after `start` that may need escaping, or
+// `s.len` if there is none.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_escape_scan(PgString s, u64 start, PgEscapeKind kind) {
+  u64 i = start;
+
+#if defined(__x86_64__) && defined(__AVX2__)
+  for (; i + 32 <= s.len; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(void *)(s.data + i));
+    u32 mask = pg_escape_mask_avx2(v, kind);
+    if (mask) {
+      return i + (u64)__builtin_ctz(mask);
     }
-    PgRune rune = res_rune.rune;
-    if (0 == rune) {
-      break;
+  }
+#endif
+
+#if defined(__x86_64__) && defined(__SSE2__)
+  for (; i + 16 <= s.len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(void *)(s.data + i));
+    u32 mask = pg_escape_mask_sse2(v, kind);
+    if (mask) {
+      return i + (u64)__builtin_ctz(mask);
+    }
+  }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  for (; i + 16 <= s.len; i += 16) {
+    u64 mask = pg_escape_mask_neon(vld1q_u8(s.data + i), kind);
+    if (mask) {
+      return i + (u64)__builtin_ctzll(mask) / 4;
+    }
+  }
+#endif
+
+  for (; i < s.len; i++) {
+    if (pg_escape_byte_is_flagged(PG_SLICE_AT(s, i), kind)) {
+      return i;
+    }
+  }
+
+  return s.len;
+}
+
+// JS escaping stops at the first NUL byte.
+[[maybe_unused]] [[nodiscard]] static bool
+pg_escape_is_end(PgString s, u64 i, PgEscapeKind kind) {
+  return i >= s.len ||
+         (PG_ESCAPE_KIND_JS == kind && 0 == PG_SLICE_AT(s, i));
+}
+
+// Consume the flagged byte at `*idx` (for JS, the whole non-ASCII rune) and
+// return what should be written in its place.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_escape_next(PgString s, u64 *idx, PgEscapeKind kind,
+               u8 buf[PG_ESCAPE_REPLACEMENT_MAX_LEN]) {
+  u8 c = PG_SLICE_AT(s, *idx);
+  PgString res = {.data = s.data + *idx, .len = 1};
+
+  switch (kind) {
+  case PG_ESCAPE_KIND_HTML:
+    if ('&' == c) {
+      res = PG_S("&amp;");
+    } else if ('<' == c) {
+      res = PG_S("&lt;");
+    } else if ('>' == c) {
+      res = PG_S("&gt;");
+    } else if ('"' == c) {
+      res = PG_S("&quot;");
+    } else if ('\'' == c) {
+      res = PG_S("&#39;");
+    }
+    break;
+
+  case PG_ESCAPE_KIND_JS:
+    if (c >= 0x80) {
+      PgUtf8Iterator it = {.s = s, .idx = *idx};
+      PgRuneUtf8Result res_rune = pg_utf8_iterator_next(&it);
+      PG_ASSERT(0 == res_rune.err);
+      PgRune rune = res_rune.rune;
+
+      u64 digits = 1;
+      for (PgRune r = rune >> 4; r; r >>= 4) {
+        digits += 1;
+      }
+
+      u64 len = 0;
+      buf[len++] = '\\';
+      buf[len++] = 'u';
+      buf[len++] = '{';
+      for (u64 d = digits; d > 0; d--) {
+        buf[len++] = pg_u8_to_hex_rune((rune >> (4 * (d - 1))) & 0xf);
+      }
+      buf[len++] = '}';
+      PG_ASSERT(len <= PG_ESCAPE_REPLACEMENT_MAX_LEN);
+
+      *idx = it.idx;
+      return (PgString){.data = buf, .len = len};
     }
 
-    switch (rune) {
+    switch (c) {
     case '\'':
-      PG_DYN_APPEND_SLICE(sb, PG_S("\\'"), allocator);
+      res = PG_S("\\'");
       break;
     case '"':
-      PG_DYN_APPEND_SLICE(sb, PG_S("\\\""), allocator);
+      res = PG_S("\\\"");
       break;
     case '\\':
-      PG_DYN_APPEND_SLICE(sb, PG_S("\\\\"), allocator);
+      res = PG_S("\\\\");
       break;
     case '\t':
-      PG_DYN_APPEND_SLICE(sb, PG_S("\\t"), allocator);
+      res = PG_S("\\t");
       break;
     case '\n':
-      PG_DYN_APPEND_SLICE(sb, PG_S("\\n"), allocator);
+      res = PG_S("\\n");
       break;
     case '\r':
-      PG_DYN_APPEND_SLICE(sb, PG_S("\\r"), allocator);
+      res = PG_S("\\r");
       break;
     case '\f':
-      PG_DYN_APPEND_SLICE(sb, PG_S("\\f"), allocator);
+      res = PG_S("\\f");
       break;
     case '\b':
-      PG_DYN_APPEND_SLICE(sb, PG_S("\\b"), allocator);
+      res = PG_S("\\b");
       break;
     case '\v':
-      PG_DYN_APPEND_SLICE(sb, PG_S("\\v"), allocator);
+      res = PG_S("\\v");
       break;
     default:
-      if (rune <= 127) {
-        pg_string_builder_append_rune(sb, rune, allocator);
-      } else {
-        PG_DYN_PUSH(sb, '\\', allocator);
-        PG_DYN_PUSH(sb, 'u', allocator);
-        PG_DYN_PUSH(sb, '{', allocator);
-        pg_string_builder_append_u64_hex(sb, rune, allocator);
-        PG_DYN_PUSH(sb, '}', allocator);
+      break;
+    }
+    break;
+
+  case PG_ESCAPE_KIND_LOGFMT:
+    buf[0] = '\\';
+    buf[1] = c;
+    res = (PgString){.data = buf, .len = 2};
+    break;
+
+  default:
+    PG_ASSERT(0);
+  }
+
+  *idx += 1;
+  return res;
+}
+
+// Exact length of `s` once escaped, so that the destination can be allocated
+// once.
+[[maybe_unused]] [[nodiscard]] static u64 pg_escaped_len(PgString s,
+                                                         PgEscapeKind kind) {
+  u8 buf[PG_ESCAPE_REPLACEMENT_MAX_LEN] = {0};
+  u64 res = 0;
+
+  for (u64 i = 0; i < s.len;) {
+    u64 j = pg_escape_scan(s, i, kind);
+    res += j - i;
+    i = j;
+
+    if (pg_escape_is_end(s, i, kind)) {
+      break;
+    }
+    res += pg_escape_next(s, &i, kind, buf).len;
+  }
+
+  return res;
+}
+
+[[maybe_unused]] static void
+pg_string_builder_append_escaped(PG_DYN(u8) * sb, PgString s,
+                                 PgEscapeKind kind, PgAllocator *allocator) {
+  u64 escaped_len = pg_escaped_len(s, kind);
+  PG_DYN_ENSURE_CAP(sb, sb->len + escaped_len, allocator);
+  u64 len_expected = sb->len + escaped_len;
+
+  u8 buf[PG_ESCAPE_REPLACEMENT_MAX_LEN] = {0};
+  for (u64 i = 0; i < s.len;) {
+    u64 j = pg_escape_scan(s, i, kind);
+    pg_memcpy(sb->data + sb->len, s.data + i, j - i);
+    sb->len += j - i;
+    i = j;
+
+    if (pg_escape_is_end(s, i, kind)) {
+      break;
+    }
+    PgString replacement = pg_escape_next(s, &i, kind, buf);
+    pg_memcpy(sb->data + sb->len, replacement.data, replacement.len);
+    sb->len += replacement.len;
+  }
+  PG_ASSERT(sb->len == len_expected);
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_writer_write_escaped(PgWriter *w, PgString s, PgEscapeKind kind,
+                        PgAllocator *allocator) {
+  PgError err = 0;
+
+  u8 buf[PG_ESCAPE_REPLACEMENT_MAX_LEN] = {0};
+  for (u64 i = 0; i < s.len;) {
+    u64 j = pg_escape_scan(s, i, kind);
+    if (j > i) {
+      err = pg_writer_write_full(w, PG_SLICE_RANGE(s, i, j), allocator);
+      if (err) {
+        return err;
       }
     }
+    i = j;
+
+    if (pg_escape_is_end(s, i, kind)) {
+      break;
+    }
+    PgString replacement = pg_escape_next(s, &i, kind, buf);
+    err = pg_writer_write_full(w, replacement, allocator);
+    if (err) {
+      return err;
+    }
   }
+
+  return 0;
+}
+
+[[maybe_unused]] static void
+pg_string_builder_append_js_string_escaped(PG_DYN(u8) * sb, PgString s,
+                                           PgAllocator *allocator) {
+  pg_string_builder_append_escaped(sb, s, PG_ESCAPE_KIND_JS, allocator);
 }
 
 [[maybe_unused]] static void
@@ -5072,5133 +7076,10818 @@ static void pg_sha1_process_x86(u32 state[5], const u8 data[], u32 length) {
 }
 #endif
 
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_net_ipv4_address_to_string(PgIpv4Address address, PgAllocator *allocator) {
-  PgWriter w = pg_writer_make_string_builder(3 * 4 + 4 + 5, allocator);
+// CRC-32 of gzip, zip and PNG: reflected, polynomial 0xEDB88320.
+static const u32 pg_crc32_table[256] = {
+    0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
+    0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
+    0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
+    0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+    0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9,
+    0xfa0f3d63, 0x8d080df5, 0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172,
+    0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b, 0x35b5a8fa, 0x42b2986c,
+    0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+    0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423,
+    0xcfba9599, 0xb8bda50f, 0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
+    0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d, 0x76dc4190, 0x01db7106,
+    0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+    0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d,
+    0x91646c97, 0xe6635c01, 0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e,
+    0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457, 0x65b0d9c6, 0x12b7e950,
+    0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+    0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7,
+    0xa4d1c46d, 0xd3d6f4fb, 0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0,
+    0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9, 0x5005713c, 0x270241aa,
+    0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+    0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81,
+    0xb7bd5c3b, 0xc0ba6cad, 0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a,
+    0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683, 0xe3630b12, 0x94643b84,
+    0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+    0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb,
+    0x196c3671, 0x6e6b06e7, 0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc,
+    0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5, 0xd6d6a3e8, 0xa1d1937e,
+    0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+    0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55,
+    0x316e8eef, 0x4669be79, 0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
+    0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f, 0xc5ba3bbe, 0xb2bd0b28,
+    0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+    0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f,
+    0x72076785, 0x05005713, 0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38,
+    0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21, 0x86d3d2d4, 0xf1d4e242,
+    0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+    0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69,
+    0x616bffd3, 0x166ccf45, 0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2,
+    0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db, 0xaed16a4a, 0xd9d65adc,
+    0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+    0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693,
+    0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
+    0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d,
+};
 
-  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, (address.ip >> 24) & 0xFF,
-                                               allocator));
-  PG_ASSERT(0 == pg_writer_write_u8(&w, '.', allocator));
-  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, (address.ip >> 16) & 0xFF,
-                                               allocator));
-  PG_ASSERT(0 == pg_writer_write_u8(&w, '.', allocator));
-  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, (address.ip >> 8) & 0xFF,
-                                               allocator));
-  PG_ASSERT(0 == pg_writer_write_u8(&w, '.', allocator));
-  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, (address.ip >> 0) & 0xFF,
-                                               allocator));
-  PG_ASSERT(0 == pg_writer_write_u8(&w, ':', allocator));
-  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, address.port, allocator));
-
-  return PG_DYN_TO_SLICE(PgString, w.u.bytes);
-}
-
-[[maybe_unused]] [[nodiscard]] static u32 pg_u8x4_be_to_u32(PgString s) {
-  PG_ASSERT(4 == s.len);
-  return (u32)(PG_SLICE_AT(s, 0) << 24) | (u32)(PG_SLICE_AT(s, 1) << 16) |
-         (u32)(PG_SLICE_AT(s, 2) << 8) | (u32)(PG_SLICE_AT(s, 3) << 0);
-}
+[[nodiscard]] static u32 pg_crc32_update_table(u32 crc, const u8 *data,
+                                               u64 len) {
+  for (u64 i = 0; i < len; i++) {
+    crc = pg_crc32_table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+  }
+  return crc;
+}
 
-[[nodiscard]] static bool pg_bitfield_get_ptr(u8 *bitfield, u64 bitfield_len,
-                                              u64 idx_bit) {
-  PG_ASSERT(idx_bit < bitfield_len * 8);
+// Folding constants of Intel's "Fast CRC Computation for Generic Polynomials
+// Using PCLMULQDQ Instruction", for the reflected CRC-32: x^(4*128+32),
+// x^(4*128-32) to fold 512 bits, and x^(128+32), x^(128-32) to fold 128
+// bits, modulo the polynomial.
+#define PG_CRC32_K1 0x154442bd4ULL
+#define PG_CRC32_K2 0x1c6e41596ULL
+#define PG_CRC32_K3 0x1751997d0ULL
+#define PG_CRC32_K4 0x0ccaa009eULL
 
-  u64 idx_byte = idx_bit / 8;
+#if defined(__x86_64__) && defined(__PCLMUL__)
+#define PG_CRC32_FOLD
 
-  return PG_C_ARRAY_AT(bitfield, bitfield_len, idx_byte) & (1 << (idx_bit % 8));
+[[nodiscard]] static __m128i pg_crc32_fold_128(__m128i x, __m128i k,
+                                               __m128i next) {
+  __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+  __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(lo, hi), next);
 }
 
-[[maybe_unused]] [[nodiscard]] static bool pg_bitfield_get(PgString bitfield,
-                                                           u64 idx_bit) {
-  return pg_bitfield_get_ptr(bitfield.data, bitfield.len, idx_bit);
-}
+// Fold `len` bytes, a multiple of 16 and at least 64, into 128 bits whose
+// CRC with the table, starting from 0, is the CRC of the input.
+static void pg_crc32_fold(u32 crc, const u8 *data, u64 len, u8 out[16]) {
+  PG_ASSERT(len >= 64);
+  PG_ASSERT(0 == len % 16);
 
-static void pg_bitfield_set_ptr(u8 *bitfield, u64 bitfield_len, u64 idx_bit,
-                                bool val) {
-  PG_ASSERT(idx_bit < bitfield_len * 8);
+  __m128i k1k2 = _mm_set_epi64x((i64)PG_CRC32_K2, (i64)PG_CRC32_K1);
+  __m128i k3k4 = _mm_set_epi64x((i64)PG_CRC32_K4, (i64)PG_CRC32_K3);
 
-  u64 idx_byte = idx_bit / 8;
+  __m128i x0 = _mm_loadu_si128((const __m128i *)(const void *)(data + 0));
+  __m128i x1 = _mm_loadu_si128((const __m128i *)(const void *)(data + 16));
+  __m128i x2 = _mm_loadu_si128((const __m128i *)(const void *)(data + 32));
+  __m128i x3 = _mm_loadu_si128((const __m128i *)(const void *)(data + 48));
+  x0 = _mm_xor_si128(x0, _mm_cvtsi32_si128((i32)crc));
+  data += 64;
+  len -= 64;
 
-  u8 *ptr = PG_C_ARRAY_AT_PTR(bitfield, bitfield_len, idx_byte);
-  if (val) {
-    *ptr |= 1 << (idx_bit % 8);
-  } else {
-    *ptr &= ~(1 << (idx_bit % 8));
+  for (; len >= 64; data += 64, len -= 64) {
+    x0 = pg_crc32_fold_128(
+        x0, k1k2, _mm_loadu_si128((const __m128i *)(const void *)(data + 0)));
+    x1 = pg_crc32_fold_128(
+        x1, k1k2, _mm_loadu_si128((const __m128i *)(const void *)(data + 16)));
+    x2 = pg_crc32_fold_128(
+        x2, k1k2, _mm_loadu_si128((const __m128i *)(const void *)(data + 32)));
+    x3 = pg_crc32_fold_128(
+        x3, k1k2, _mm_loadu_si128((const __m128i *)(const void *)(data + 48)));
   }
 
-  PG_ASSERT(val == pg_bitfield_get_ptr(bitfield, bitfield_len, idx_bit));
+  x0 = pg_crc32_fold_128(x0, k3k4, x1);
+  x0 = pg_crc32_fold_128(x0, k3k4, x2);
+  x0 = pg_crc32_fold_128(x0, k3k4, x3);
+  for (; len >= 16; data += 16, len -= 16) {
+    x0 = pg_crc32_fold_128(
+        x0, k3k4, _mm_loadu_si128((const __m128i *)(const void *)data));
+  }
+
+  _mm_storeu_si128((__m128i *)(void *)out, x0);
 }
 
-[[maybe_unused]] static void pg_bitfield_set(PgString bitfield, u64 idx_bit,
-                                             bool val) {
-  pg_bitfield_set_ptr(bitfield.data, bitfield.len, idx_bit, val);
+#elif defined(__aarch64__) && defined(__ARM_NEON) &&                          \
+    defined(__ARM_FEATURE_AES)
+#define PG_CRC32_FOLD
+
+[[nodiscard]] static uint64x2_t pg_crc32_fold_128(uint64x2_t x, uint64x2_t k,
+                                                  uint64x2_t next) {
+  uint64x2_t lo = vreinterpretq_u64_p128(vmull_p64(
+      (poly64_t)vgetq_lane_u64(x, 0), (poly64_t)vgetq_lane_u64(k, 0)));
+  uint64x2_t hi = vreinterpretq_u64_p128(
+      vmull_high_p64(vreinterpretq_p64_u64(x), vreinterpretq_p64_u64(k)));
+  return veorq_u64(veorq_u64(lo, hi), next);
 }
 
-[[maybe_unused]] [[nodiscard]] static u64 pg_bitfield_count(PgString bitfield) {
-  u64 res = 0;
-  PG_EACH_PTR(c, &bitfield) { res += (u8)__builtin_popcount(*c); }
-  return res;
+[[nodiscard]] static uint64x2_t pg_crc32_load_128(const u8 *data) {
+  return vreinterpretq_u64_u8(vld1q_u8(data));
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_OPTION(u64)
-    pg_bitfield_get_first_zero(PgString bitfield) {
-  PG_OPTION(u64) res = {0};
+// See the x86_64 version.
+static void pg_crc32_fold(u32 crc, const u8 *data, u64 len, u8 out[16]) {
+  PG_ASSERT(len >= 64);
+  PG_ASSERT(0 == len % 16);
 
-  PG_EACH_PTR(c, &bitfield) {
-    if (0xff == *c) {
-      continue;
-    }
+  uint64x2_t k1k2 =
+      vcombine_u64(vcreate_u64(PG_CRC32_K1), vcreate_u64(PG_CRC32_K2));
+  uint64x2_t k3k4 =
+      vcombine_u64(vcreate_u64(PG_CRC32_K3), vcreate_u64(PG_CRC32_K4));
 
-    u64 bit_idx = 0;
-    u8 bit_pattern = 1;
-    for (u64 j = 0; j < 8; j++) {
-      if (0 == (*c & bit_pattern)) {
-        bit_idx = j;
-        break;
-      }
-      bit_pattern <<= 1;
-    }
-    PG_ASSERT(bit_idx < 8);
-    PG_ASSERT(bit_idx > 0);
+  uint64x2_t x0 = pg_crc32_load_128(data + 0);
+  uint64x2_t x1 = pg_crc32_load_128(data + 16);
+  uint64x2_t x2 = pg_crc32_load_128(data + 32);
+  uint64x2_t x3 = pg_crc32_load_128(data + 48);
+  x0 = veorq_u64(x0, vcombine_u64(vcreate_u64(crc), vcreate_u64(0)));
+  data += 64;
+  len -= 64;
 
-    res.value = PG_SLICE_PTR_TO_INDEX(c, bitfield) * 8 + (bit_idx - 1);
-    res.has_value = true;
-    return res;
+  for (; len >= 64; data += 64, len -= 64) {
+    x0 = pg_crc32_fold_128(x0, k1k2, pg_crc32_load_128(data + 0));
+    x1 = pg_crc32_fold_128(x1, k1k2, pg_crc32_load_128(data + 16));
+    x2 = pg_crc32_fold_128(x2, k1k2, pg_crc32_load_128(data + 32));
+    x3 = pg_crc32_fold_128(x3, k1k2, pg_crc32_load_128(data + 48));
   }
-  return res;
-}
 
-[[maybe_unused]] [[nodiscard]] static PgAdjacencyMatrix
-pg_adjacency_matrix_make(u64 nodes_count, PgAllocator *allocator) {
-  PgAdjacencyMatrix res = {0};
-  if (0 == nodes_count) {
-    return res;
+  x0 = pg_crc32_fold_128(x0, k3k4, x1);
+  x0 = pg_crc32_fold_128(x0, k3k4, x2);
+  x0 = pg_crc32_fold_128(x0, k3k4, x3);
+  for (; len >= 16; data += 16, len -= 16) {
+    x0 = pg_crc32_fold_128(x0, k3k4, pg_crc32_load_128(data));
   }
 
-  res.nodes_count = nodes_count;
-  res.bitfield_len = nodes_count * (nodes_count - 1) / 2;
-  res.bitfield = pg_string_make(res.bitfield_len, allocator);
-  return res;
+  vst1q_u8(out, vreinterpretq_u8_u64(x0));
 }
+#endif
 
-[[nodiscard]] static u64
-pg_adjacency_matrix_row_column_to_bitfield_index(PgAdjacencyMatrix matrix,
-                                                 u64 row, u64 col) {
-  PG_ASSERT(row > 0);
-  PG_ASSERT(col < matrix.nodes_count - 1);
-  PG_ASSERT(row >= col);
+// CRC-32 of `s` following `crc`, which is 0 for the first part, so that
+// `pg_crc32_update(pg_crc32_update(0, a), b)` is the CRC-32 of `a` then `b`.
+// Large inputs are folded with carry-less multiplications (PCLMULQDQ on
+// x86_64, PMULL on aarch64) when the target has them.
+[[maybe_unused]] [[nodiscard]] static u32 pg_crc32_update(u32 crc,
+                                                          PgString s) {
+  crc = ~crc;
+  u8 *data = s.data;
+  u64 len = s.len;
+
+#ifdef PG_CRC32_FOLD
+  if (len >= 64) {
+    u64 fold_len = len & ~(u64)15;
+    u8 folded[16] = {0};
+    pg_crc32_fold(crc, data, fold_len, folded);
+    crc = pg_crc32_update_table(0, folded, sizeof(folded));
+    data += fold_len;
+    len -= fold_len;
+  }
+#endif
 
-  u64 idx = (row * (row - 1)) / 2 + col;
-  PG_ASSERT(idx < matrix.bitfield_len);
-  return idx;
+  return ~pg_crc32_update_table(crc, data, len);
 }
 
-[[maybe_unused]] [[nodiscard]] static bool
-pg_adjacency_matrix_has_edge(PgAdjacencyMatrix matrix, u64 row, u64 col) {
-  u64 idx = pg_adjacency_matrix_row_column_to_bitfield_index(matrix, row, col);
-  return pg_bitfield_get(matrix.bitfield, idx);
-}
+// Adler-32 of zlib, following `adler` which is 1 for the first part.
+[[maybe_unused]] [[nodiscard]] static u32 pg_adler32_update(u32 adler,
+                                                            PgString s) {
+  // Largest n such that 255n(n+1)/2 + (n+1)(65521-1) fits in 32 bits, to
+  // reduce modulo 65521 as rarely as possible.
+  const u64 block_len = 5552;
+  u32 a = adler & 0xffff;
+  u32 b = adler >> 16;
 
-[[maybe_unused]] [[nodiscard]] static PgAdjacencyMatrix
-pg_adjacency_matrix_clone(PgAdjacencyMatrix matrix, PgAllocator *allocator) {
-  PgAdjacencyMatrix res = {0};
-  res.nodes_count = matrix.nodes_count;
-  res.bitfield_len = matrix.bitfield_len;
-  res.bitfield = pg_string_clone(matrix.bitfield, allocator);
-  return res;
+  for (u64 i = 0; i < s.len;) {
+    u64 end = PG_MIN(s.len, i + block_len);
+    for (; i < end; i++) {
+      a += s.data[i];
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+
+  return (b << 16) | a;
 }
 
-[[maybe_unused]]
-static void pg_adjacency_matrix_add_edge(PgAdjacencyMatrix *matrix, u64 row,
-                                         u64 col) {
-  PG_ASSERT(row < matrix->nodes_count);
-  PG_ASSERT(col < matrix->nodes_count);
+#define PG_DEFLATE_WINDOW_SIZE (32 * PG_KiB)
+#define PG_DEFLATE_MIN_MATCH 3
+#define PG_DEFLATE_MAX_MATCH 258
+#define PG_DEFLATE_MAX_BITS 15
+#define PG_DEFLATE_LITLEN_CODES 286
+#define PG_DEFLATE_DIST_CODES 30
+#define PG_DEFLATE_CODELEN_CODES 19
+#define PG_DEFLATE_END_OF_BLOCK 256
 
-  u64 idx = pg_adjacency_matrix_row_column_to_bitfield_index(*matrix, row, col);
+// RFC 1951 section 3.2.5.
+static const u16 pg_deflate_len_base[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+static const u8 pg_deflate_len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+    2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+};
+static const u16 pg_deflate_dist_base[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
+static const u8 pg_deflate_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+};
+// RFC 1951 section 3.2.7.
+static const u8 pg_deflate_codelen_order[PG_DEFLATE_CODELEN_CODES] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+};
 
-  pg_bitfield_set(matrix->bitfield, idx, 1);
+// Code lengths of the fixed Huffman codes, RFC 1951 section 3.2.6. The
+// literal/length code has 2 extra symbols and the distance code 2 extra ones,
+// which are invalid.
+static void pg_deflate_fixed_lens(u8 litlen[288], u8 dist[32]) {
+  for (u32 i = 0; i < 288; i++) {
+    litlen[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+  }
+  for (u32 i = 0; i < 32; i++) {
+    dist[i] = 5;
+  }
 }
 
-static void pg_adjacency_matrix_remove_edge(PgAdjacencyMatrix *matrix, u64 row,
-                                            u64 col) {
-  PG_ASSERT(row < matrix->nodes_count);
-  PG_ASSERT(col < matrix->nodes_count);
-
-  u64 idx = pg_adjacency_matrix_row_column_to_bitfield_index(*matrix, row, col);
-
-  pg_bitfield_set(matrix->bitfield, idx, 0);
+// Index in `pg_deflate_len_base` of a match of `len_minus_3 + 3` bytes.
+[[nodiscard]] static u32 pg_deflate_len_code(u32 len_minus_3) {
+  if (len_minus_3 < 8) {
+    return len_minus_3;
+  }
+  if (PG_DEFLATE_MAX_MATCH - PG_DEFLATE_MIN_MATCH == len_minus_3) {
+    return 28;
+  }
+  // 4 codes per number of extra bits, which is `floor(log2(l)) - 2`.
+  u32 extra = 29 - (u32)__builtin_clz(len_minus_3);
+  return 4 * extra + 4 + ((len_minus_3 >> extra) & 3);
 }
 
-[[maybe_unused]] [[nodiscard]]
-static PgAdjacencyMatrixNeighborIterator
-pg_adjacency_matrix_make_neighbor_iterator(PgAdjacencyMatrix matrix, u64 node) {
-  PgAdjacencyMatrixNeighborIterator it = {0};
-  it.matrix = matrix;
-  it.row = node;
-  return it;
+// Index in `pg_deflate_dist_base` of a distance of `dist_minus_1 + 1`.
+[[nodiscard]] static u32 pg_deflate_dist_code(u32 dist_minus_1) {
+  if (dist_minus_1 < 4) {
+    return dist_minus_1;
+  }
+  // 2 codes per number of extra bits, which is `floor(log2(d)) - 1`.
+  u32 log2 = 31 - (u32)__builtin_clz(dist_minus_1);
+  return 2 * log2 + ((dist_minus_1 >> (log2 - 1)) & 1);
 }
 
-[[maybe_unused]] [[nodiscard]]
-static PgAdjacencyMatrixNeighbor pg_adjacency_matrix_neighbor_iterator_next(
-    PgAdjacencyMatrixNeighborIterator *it) {
-  PG_ASSERT(it);
-  PG_ASSERT(it->row <= it->matrix.nodes_count);
-  PG_ASSERT(it->col <= it->matrix.nodes_count);
+#define PG_INFLATE_IN_SIZE (16 * PG_KiB)
+#define PG_INFLATE_WINDOW_MASK (2 * PG_DEFLATE_WINDOW_SIZE - 1)
+#define PG_INFLATE_LITLEN_ROOT_BITS 10
+#define PG_INFLATE_DIST_ROOT_BITS 8
+// Each second level table of `n` bits holds at least `n + 1` codes, since
+// incomplete codes are rejected, hence at most 32 entries per 6 codes.
+#define PG_INFLATE_LITLEN_TABLE_LEN 2560
+#define PG_INFLATE_DIST_TABLE_LEN 1024
+#define PG_INFLATE_LINK (1U << 31)
 
-  PgAdjacencyMatrixNeighbor res = {0};
-  if (it->row >= it->matrix.nodes_count || it->col >= it->matrix.nodes_count ||
-      it->col > it->row) { // The end.
-    return res;
+typedef enum : u8 {
+  PG_INFLATE_STATE_HEADER,
+  PG_INFLATE_STATE_BLOCK_HEADER,
+  PG_INFLATE_STATE_STORED,
+  PG_INFLATE_STATE_HUFFMAN,
+  PG_INFLATE_STATE_TRAILER,
+  PG_INFLATE_STATE_DONE,
+  PG_INFLATE_STATE_INVALID, // Sticky: the data is corrupt.
+} PgInflateState;
+
+typedef enum : u8 {
+  PG_INFLATE_STEP_CONTINUE,
+  PG_INFLATE_STEP_OUTPUT, // The window is full: hand out what was decoded.
+  PG_INFLATE_STEP_INPUT,  // The input buffer runs out.
+  PG_INFLATE_STEP_INVALID,
+} PgInflateStep;
+
+struct PgInflater {
+  PgReader *inner;
+  u64 bit_buf;     // Next bits of input, the first one in the lowest bit.
+  u64 window_pos;  // Bytes decoded so far.
+  u64 window_read; // Bytes handed out so far, at most `window_pos`.
+  u32 bit_count;   // Valid bits in `bit_buf`.
+  u32 in_pos;
+  u32 in_len;
+  u32 stored_remaining;
+  u32 checksum;
+  PgDeflateFormat format;
+  PgInflateState state;
+  bool final_block;
+  PG_PAD(1);
+  u8 in[PG_INFLATE_IN_SIZE];
+  // Decoded data, addressed modulo its size: the last 32 KiB, which matches
+  // refer to, and up to 32 KiB not handed out yet.
+  u8 window[2 * PG_DEFLATE_WINDOW_SIZE];
+  u32 litlen_table[PG_INFLATE_LITLEN_TABLE_LEN];
+  u32 dist_table[PG_INFLATE_DIST_TABLE_LEN];
+};
+
+// Decoding table of the canonical Huffman code with the code lengths `lens`,
+// 0 for unused symbols: `1 << root_bits` entries indexed by the next bits of
+// input, followed by second level tables for the longer codes. An entry is
+// `symbol | length << 16`, or `offset | bits << 16 | PG_INFLATE_LINK` for the
+// second level table of the codes with this prefix, or 0 for no code.
+// Over-subscribed and incomplete codes are rejected, except for a single
+// code of one bit, like zlib does.
+[[nodiscard]] static bool pg_inflate_build_table(u32 *table, u32 table_len,
+                                                 const u8 *lens, u32 lens_len,
+                                                 u32 root_bits) {
+  PG_ASSERT(lens_len <= 288);
+  PG_ASSERT(root_bits <= PG_INFLATE_LITLEN_ROOT_BITS);
+
+  u32 counts[PG_DEFLATE_MAX_BITS + 1] = {0};
+  for (u32 i = 0; i < lens_len; i++) {
+    counts[lens[i]]++;
+  }
+  counts[0] = 0;
+
+  i32 left = 1;
+  u32 max_len = 0;
+  for (u32 len = 1; len <= PG_DEFLATE_MAX_BITS; len++) {
+    left = 2 * left - (i32)counts[len];
+    if (left < 0) {
+      return false;
+    }
+    if (counts[len]) {
+      max_len = len;
+    }
+  }
+  if (left > 0 && max_len > 1) {
+    return false;
   }
 
-  if (!it->scan_mode_column) { // Scan row.
+  u32 next_code[PG_DEFLATE_MAX_BITS + 1] = {0};
+  for (u32 len = 1, code = 0; len <= PG_DEFLATE_MAX_BITS; len++) {
+    code = (code + counts[len - 1]) << 1;
+    next_code[len] = code;
+  }
 
-    for (; it->col < it->row; it->col++) {
-      res.edge = pg_adjacency_matrix_has_edge(it->matrix, it->row, it->col);
-      if (res.edge) {
-        res.has_value = true;
-        res.col = it->col;
-        res.row = it->row;
-        res.node = it->col;
-        PG_ASSERT(res.col != res.row);
+  // Codes are read from their most significant bit: index by the reversed
+  // code. Also note the longest code under each first level entry.
+  u16 codes[288] = {0};
+  u8 sub_max_len[1U << PG_INFLATE_LITLEN_ROOT_BITS] = {0};
+  u32 root_len = 1U << root_bits;
+  for (u32 sym = 0; sym < lens_len; sym++) {
+    u32 len = lens[sym];
+    if (0 == len) {
+      continue;
+    }
 
-        it->col += 1;
-        return res;
-      }
+    u32 code = next_code[len]++;
+    u32 reversed = 0;
+    for (u32 i = 0; i < len; i++) {
+      reversed = (reversed << 1) | ((code >> i) & 1);
     }
-    if (it->col == it->row) { // Skip diagonal.
-      it->row += 1;
-      it->scan_mode_column = true;
+    codes[sym] = (u16)reversed;
+
+    if (len > root_bits) {
+      u32 prefix = reversed & (root_len - 1);
+      sub_max_len[prefix] = (u8)PG_MAX(sub_max_len[prefix], len);
     }
   }
 
-  if (it->scan_mode_column) { // Scan column.
+  for (u32 i = 0; i < root_len; i++) {
+    table[i] = 0;
+  }
+  u32 used = root_len;
+  for (u32 prefix = 0; prefix < root_len; prefix++) {
+    if (0 == sub_max_len[prefix]) {
+      continue;
+    }
 
-    for (; it->row < it->matrix.nodes_count; it->row++) {
-      res.edge = pg_adjacency_matrix_has_edge(it->matrix, it->row, it->col);
-      if (res.edge) {
-        res.has_value = true;
-        res.col = it->col;
-        res.row = it->row;
-        res.node = it->row;
-        PG_ASSERT(res.col != res.row);
+    u32 sub_bits = sub_max_len[prefix] - root_bits;
+    if (used + (1U << sub_bits) > table_len) {
+      return false;
+    }
+    table[prefix] = used | sub_bits << 16 | PG_INFLATE_LINK;
+    for (u32 i = 0; i < 1U << sub_bits; i++) {
+      table[used + i] = 0;
+    }
+    used += 1U << sub_bits;
+  }
 
-        it->row += 1;
-        return res;
+  for (u32 sym = 0; sym < lens_len; sym++) {
+    u32 len = lens[sym];
+    if (0 == len) {
+      continue;
+    }
+
+    u32 entry = sym | len << 16;
+    u32 reversed = codes[sym];
+    if (len <= root_bits) {
+      for (u32 i = reversed; i < root_len; i += 1U << len) {
+        table[i] = entry;
+      }
+    } else {
+      u32 link = table[reversed & (root_len - 1)];
+      u32 offset = link & 0xffff;
+      u32 sub_bits = (link >> 16) & 0xff;
+      for (u32 i = reversed >> root_bits; i < 1U << sub_bits;
+           i += 1U << (len - root_bits)) {
+        table[offset + i] = entry;
       }
     }
   }
-  return res;
+
+  return true;
 }
 
-[[maybe_unused]]
-static void pg_adjacency_matrix_remove_node(PgAdjacencyMatrix *matrix,
-                                            u64 node) {
-  u64 row = node;
-  PG_ASSERT(row < matrix->nodes_count);
+// Entry of `table` for the code at the start of `bits`.
+[[nodiscard]] static u32 pg_inflate_lookup(const u32 *table, u32 root_bits,
+                                           u64 bits) {
+  u32 entry = table[bits & ((1U << root_bits) - 1)];
+  if (entry & PG_INFLATE_LINK) {
+    u32 sub_bits = (entry >> 16) & 0xff;
+    entry = table[(entry & 0xffff) +
+                  ((bits >> root_bits) & ((1U << sub_bits) - 1))];
+  }
+  return entry;
+}
+
+// Move input bytes to the bit buffer, without I/O. With 8 bytes available,
+// this is the branchless refill of Fabian Giesen's "Reading bits in far too
+// many ways": the bits past `bit_count` are then those of the next bytes,
+// which the next refill writes again.
+static void pg_inflate_refill(PgInflater *inf) {
+  if (inf->in_len - inf->in_pos >= sizeof(u64)) {
+    inf->bit_buf |= pg_u64_load_unaligned(inf->in + inf->in_pos)
+                    << inf->bit_count;
+    inf->in_pos += (63 - inf->bit_count) >> 3;
+    inf->bit_count |= 56;
+    return;
+  }
 
-  PgAdjacencyMatrixNeighborIterator it =
-      pg_adjacency_matrix_make_neighbor_iterator(*matrix, node);
+  while (inf->bit_count <= 56 && inf->in_pos < inf->in_len) {
+    inf->bit_buf |= (u64)inf->in[inf->in_pos++] << inf->bit_count;
+    inf->bit_count += 8;
+  }
+}
 
-  PgAdjacencyMatrixNeighbor neighbor = {0};
-  do {
-    neighbor = pg_adjacency_matrix_neighbor_iterator_next(&it);
-    if (!neighbor.has_value) {
-      break;
-    }
+// Take the next `count` bits, or nothing if the input buffer runs out.
+[[nodiscard]] static bool pg_inflate_take_bits(PgInflater *inf, u32 count,
+                                               u32 *bits) {
+  PG_ASSERT(count <= 32);
 
-    pg_adjacency_matrix_remove_edge(matrix, neighbor.row, neighbor.col);
-  } while (neighbor.has_value);
-}
+  if (inf->bit_count < count) {
+    pg_inflate_refill(inf);
+    if (inf->bit_count < count) {
+      return false;
+    }
+  }
 
-[[maybe_unused]] [[nodiscard]]
-static bool pg_adjacency_matrix_is_empty(PgAdjacencyMatrix matrix) {
-  bool set = false;
-  PG_EACH_PTR(it, &matrix.bitfield) { set |= *it; }
-  return set == 0;
+  *bits = (u32)(inf->bit_buf & (((u64)1 << count) - 1));
+  inf->bit_buf >>= count;
+  inf->bit_count -= count;
+  return true;
 }
 
-[[maybe_unused]] [[nodiscard]]
-static u64 pg_adjacency_matrix_count_neighbors(PgAdjacencyMatrix matrix,
-                                               u64 node) {
-  PG_ASSERT(node < matrix.nodes_count);
+// Take the next symbol of the code of `table`.
+[[nodiscard]] static PgInflateStep
+pg_inflate_take_symbol(PgInflater *inf, const u32 *table, u32 root_bits,
+                       u32 *sym) {
+  if (inf->bit_count < PG_DEFLATE_MAX_BITS) {
+    pg_inflate_refill(inf);
+  }
 
-  u64 res = 0;
-  PgAdjacencyMatrixNeighborIterator it =
-      pg_adjacency_matrix_make_neighbor_iterator(matrix, node);
+  u32 entry = pg_inflate_lookup(table, root_bits, inf->bit_buf);
+  u32 len = (entry >> 16) & 0xff;
+  if (0 == len) {
+    return inf->bit_count >= PG_DEFLATE_MAX_BITS ? PG_INFLATE_STEP_INVALID
+                                                 : PG_INFLATE_STEP_INPUT;
+  }
+  if (len > inf->bit_count) {
+    return PG_INFLATE_STEP_INPUT;
+  }
 
-  PgAdjacencyMatrixNeighbor neighbor = {0};
-  do {
-    neighbor = pg_adjacency_matrix_neighbor_iterator_next(&it);
-    res += neighbor.edge;
-    PG_ASSERT(res + 1 <= matrix.nodes_count);
-  } while (neighbor.has_value);
+  inf->bit_buf >>= len;
+  inf->bit_count -= len;
+  *sym = entry & 0xffff;
+  return PG_INFLATE_STEP_CONTINUE;
+}
 
-  return res;
+static void pg_inflate_align(PgInflater *inf) {
+  inf->bit_buf >>= inf->bit_count & 7;
+  inf->bit_count &= ~7U;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_adjacency_matrix_print(PgAdjacencyMatrix matrix, PgWriter *w,
-                          PgAllocator *allocator) {
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("    | "), allocator));
+// Read more input from `inner`, after what is left in the input buffer.
+[[nodiscard]] static PgError pg_inflate_read_more(PgInflater *inf) {
+  u32 left = inf->in_len - inf->in_pos;
+  pg_memmove(inf->in, inf->in + inf->in_pos, left);
+  inf->in_pos = 0;
+  inf->in_len = left;
 
-  for (u64 col = 0; col < matrix.nodes_count; col++) {
-    PG_ERR_RETURN(pg_writer_write_u64_as_string(w, col, allocator));
+  // E.g. a gzip file name longer than the input buffer.
+  if (PG_INFLATE_IN_SIZE == left) {
+    return PG_ERR_TOO_BIG;
   }
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
 
-  for (u64 col = 0; col < matrix.nodes_count; col++) {
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("-----"), allocator));
+  PG_SLICE(u8) dst = {.data = inf->in + left, .len = PG_INFLATE_IN_SIZE - left};
+  PG_RESULT(u64, PgError) res = pg_reader_read_slice(inf->inner, dst);
+  // The stream is truncated.
+  PG_IF_LET_ERR(err, res) { return PG_ERR_EOF == err ? PG_ERR_IO : err; }
+  u64 n = PG_UNWRAP(res);
+  if (0 == n) {
+    return PG_ERR_IO;
   }
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
 
-  for (u64 row = 0; row < matrix.nodes_count; row++) {
-    PG_ERR_RETURN(pg_writer_write_u64_as_string(w, row, allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" | "), allocator));
-    for (u64 col = 0; col < matrix.nodes_count; col++) {
-      if (col >= row) {
-        PG_ERR_RETURN(pg_writer_write_full(w, PG_S("  "), allocator));
-        continue;
-      }
-
-      bool edge = pg_adjacency_matrix_has_edge(matrix, row, col);
-      PG_ERR_RETURN(
-          pg_writer_write_full(w, edge ? PG_S("1") : PG_S("0"), allocator));
-    }
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
-  }
-  return (PgError){0};
+  inf->in_len += (u32)n;
+  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_time_ns_now(PgClockKind clock_kind);
+// The zlib or gzip header, once it is whole in the input buffer.
+[[nodiscard]] static PgInflateStep pg_inflate_header(PgInflater *inf) {
+  PG_ASSERT(0 == inf->bit_count);
 
-// From https://nullprogram.com/blog/2017/09/21/.
-// PCG.
-[[maybe_unused]] [[nodiscard]] static u32
-pg_rand_u32_min_incl_max_incl(PgRng *rng, u32 min_incl, u32 max_incl) {
-  PG_ASSERT(rng);
-  PG_ASSERT(min_incl <= max_incl);
+  u8 *in = inf->in + inf->in_pos;
+  u32 len = inf->in_len - inf->in_pos;
+  u32 i = 0;
 
-  u64 m = 0x9b60933458e17d7d;
-  u64 a = 0xd737232eeccdf7ed;
-  rng->state = rng->state * m + a;
-  int shift = 29 - (rng->state >> 61);
-  u32 rand = (u32)(rng->state >> shift);
+  if (PG_DEFLATE_FORMAT_ZLIB == inf->format) {
+    if (len < 2) {
+      return PG_INFLATE_STEP_INPUT;
+    }
+    // Preset dictionaries are not supported.
+    if (8 != (in[0] & 0xf) || (in[0] >> 4) > 7 ||
+        0 != ((u32)in[0] << 8 | in[1]) % 31 || (in[1] & 0x20)) {
+      return PG_INFLATE_STEP_INVALID;
+    }
+    i = 2;
+  } else {
+    PG_ASSERT(PG_DEFLATE_FORMAT_GZIP == inf->format);
 
-  u32 res = min_incl + (u32)((f32)rand * ((f32)max_incl - (f32)min_incl) /
-                             (f32)UINT32_MAX);
-  PG_ASSERT(min_incl <= res);
-  PG_ASSERT(res <= max_incl);
-  return res;
-}
+    if (len < 10) {
+      return PG_INFLATE_STEP_INPUT;
+    }
+    u8 flags = in[3];
+    if (0x1f != in[0] || 0x8b != in[1] || 8 != in[2] || (flags & 0xe0)) {
+      return PG_INFLATE_STEP_INVALID;
+    }
+    i = 10;
 
-[[maybe_unused]] [[nodiscard]] static u32
-pg_rand_u32_min_incl_max_excl(PgRng *rng, u32 min_incl, u32 max_excl) {
-  PG_ASSERT(max_excl > 0);
-  return pg_rand_u32_min_incl_max_incl(rng, min_incl, max_excl - 1);
+    if (flags & 4) { // FEXTRA.
+      if (len < i + 2) {
+        return PG_INFLATE_STEP_INPUT;
+      }
+      i += 2 + ((u32)in[i] | (u32)in[i + 1] << 8);
+      if (len < i) {
+        return PG_INFLATE_STEP_INPUT;
+      }
+    }
+    // FNAME then FCOMMENT, zero terminated.
+    for (u32 flag = 8; flag <= 16; flag <<= 1) {
+      if (!(flags & flag)) {
+        continue;
+      }
+      for (; i < len && in[i]; i++) {
+      }
+      if (i == len) {
+        return PG_INFLATE_STEP_INPUT;
+      }
+      i++;
+    }
+    if (flags & 2) { // FHCRC: the low 16 bits of the CRC-32 of the header.
+      if (len < i + 2) {
+        return PG_INFLATE_STEP_INPUT;
+      }
+      u32 crc = pg_crc32_update(0, (PgString){.data = in, .len = i});
+      if ((crc & 0xffff) != ((u32)in[i] | (u32)in[i + 1] << 8)) {
+        return PG_INFLATE_STEP_INVALID;
+      }
+      i += 2;
+    }
+  }
+
+  inf->in_pos += i;
+  inf->state = PG_INFLATE_STATE_BLOCK_HEADER;
+  return PG_INFLATE_STEP_CONTINUE;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_rand_string(PgRng *rng, u64 len, PgAllocator *allocator) {
-  PgString res = pg_string_make(len, allocator);
+[[nodiscard]] static PgInflateStep pg_inflate_stored_header(PgInflater *inf) {
+  pg_inflate_align(inf);
 
-  for (u64 i = 0; i < res.len; i++) {
-    *PG_C_ARRAY_AT_PTR(res.data, res.len, i) =
-        (u8)pg_rand_u32_min_incl_max_incl(rng, 0, UINT8_MAX);
+  u32 lens = 0;
+  if (!pg_inflate_take_bits(inf, 32, &lens)) {
+    return PG_INFLATE_STEP_INPUT;
   }
-  return res;
+  if ((lens & 0xffff) != (~lens >> 16)) {
+    return PG_INFLATE_STEP_INVALID;
+  }
+
+  inf->stored_remaining = lens & 0xffff;
+  inf->state = PG_INFLATE_STATE_STORED;
+  return PG_INFLATE_STEP_CONTINUE;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_OPTION(u32)
-    pg_bitfield_get_first_zero_rand(PgString bitfield, u32 len, PgRng *rng) {
-  PG_ASSERT(len <= bitfield.len);
+[[nodiscard]] static PgInflateStep pg_inflate_dynamic_header(PgInflater *inf) {
+  u32 counts = 0;
+  if (!pg_inflate_take_bits(inf, 14, &counts)) {
+    return PG_INFLATE_STEP_INPUT;
+  }
+  u32 hlit = (counts & 0x1f) + 257;
+  u32 hdist = ((counts >> 5) & 0x1f) + 1;
+  u32 hclen = (counts >> 10) + 4;
+  if (hlit > PG_DEFLATE_LITLEN_CODES || hdist > PG_DEFLATE_DIST_CODES) {
+    return PG_INFLATE_STEP_INVALID;
+  }
 
-  PG_OPTION(u32) res = {0};
+  u8 codelen_lens[PG_DEFLATE_CODELEN_CODES] = {0};
+  for (u32 i = 0; i < hclen; i++) {
+    u32 len = 0;
+    if (!pg_inflate_take_bits(inf, 3, &len)) {
+      return PG_INFLATE_STEP_INPUT;
+    }
+    codelen_lens[pg_deflate_codelen_order[i]] = (u8)len;
+  }
+  // The distance table is unused until the end of the header.
+  if (!pg_inflate_build_table(inf->dist_table, PG_INFLATE_DIST_TABLE_LEN,
+                              codelen_lens, PG_DEFLATE_CODELEN_CODES, 7)) {
+    return PG_INFLATE_STEP_INVALID;
+  }
 
-  u32 start = pg_rand_u32_min_incl_max_excl(rng, 0, len);
-  for (u64 i = 0; i < len; i++) {
-    u32 idx = (start + i) % len;
-    if (pg_bitfield_get(bitfield, idx)) {
+  u8 lens[PG_DEFLATE_LITLEN_CODES + PG_DEFLATE_DIST_CODES] = {0};
+  for (u32 i = 0; i < hlit + hdist;) {
+    u32 sym = 0;
+    PgInflateStep step = pg_inflate_take_symbol(inf, inf->dist_table, 7, &sym);
+    if (PG_INFLATE_STEP_CONTINUE != step) {
+      return step;
+    }
+
+    if (sym < 16) {
+      lens[i++] = (u8)sym;
       continue;
     }
-    res.value = idx;
-    res.has_value = true;
-    return res;
+
+    // Runs: of the previous length, then of zeros.
+    u8 len = 0;
+    u32 repeat = 0;
+    bool ok = false;
+    if (16 == sym) {
+      if (0 == i) {
+        return PG_INFLATE_STEP_INVALID;
+      }
+      len = lens[i - 1];
+      ok = pg_inflate_take_bits(inf, 2, &repeat);
+      repeat += 3;
+    } else if (17 == sym) {
+      ok = pg_inflate_take_bits(inf, 3, &repeat);
+      repeat += 3;
+    } else {
+      ok = pg_inflate_take_bits(inf, 7, &repeat);
+      repeat += 11;
+    }
+    if (!ok) {
+      return PG_INFLATE_STEP_INPUT;
+    }
+    if (i + repeat > hlit + hdist) {
+      return PG_INFLATE_STEP_INVALID;
+    }
+    for (; repeat > 0; repeat--) {
+      lens[i++] = len;
+    }
   }
-  return res;
+
+  if (0 == lens[PG_DEFLATE_END_OF_BLOCK] ||
+      !pg_inflate_build_table(inf->litlen_table, PG_INFLATE_LITLEN_TABLE_LEN,
+                              lens, hlit, PG_INFLATE_LITLEN_ROOT_BITS) ||
+      !pg_inflate_build_table(inf->dist_table, PG_INFLATE_DIST_TABLE_LEN,
+                              lens + hlit, hdist,
+                              PG_INFLATE_DIST_ROOT_BITS)) {
+    return PG_INFLATE_STEP_INVALID;
+  }
+
+  inf->state = PG_INFLATE_STATE_HUFFMAN;
+  return PG_INFLATE_STEP_CONTINUE;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgRng pg_rand_make() {
-  PgRng rng = {0};
-  // Rely on ASLR.
-  PG_RESULT(u64, PgError) now = pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC);
-  u64 value = PG_UNWRAP(now);
-  rng.state = (u64)(&pg_rand_make) ^ value;
+[[nodiscard]] static PgInflateStep pg_inflate_block_header(PgInflater *inf) {
+  if (inf->final_block) {
+    inf->state = PG_INFLATE_STATE_TRAILER;
+    return PG_INFLATE_STEP_CONTINUE;
+  }
 
-  return rng;
+  // The header is parsed again from the start once more input arrives.
+  u64 bit_buf = inf->bit_buf;
+  u32 bit_count = inf->bit_count;
+  u32 in_pos = inf->in_pos;
+
+  u32 header = 0;
+  if (!pg_inflate_take_bits(inf, 3, &header)) {
+    return PG_INFLATE_STEP_INPUT;
+  }
+
+  PgInflateStep step = PG_INFLATE_STEP_INVALID;
+  switch (header >> 1) {
+  case 0:
+    step = pg_inflate_stored_header(inf);
+    break;
+  case 1: {
+    u8 litlen_lens[288] = {0};
+    u8 dist_lens[32] = {0};
+    pg_deflate_fixed_lens(litlen_lens, dist_lens);
+    PG_ASSERT(pg_inflate_build_table(
+        inf->litlen_table, PG_INFLATE_LITLEN_TABLE_LEN, litlen_lens,
+        PG_STATIC_ARRAY_LEN(litlen_lens), PG_INFLATE_LITLEN_ROOT_BITS));
+    PG_ASSERT(pg_inflate_build_table(
+        inf->dist_table, PG_INFLATE_DIST_TABLE_LEN, dist_lens,
+        PG_STATIC_ARRAY_LEN(dist_lens), PG_INFLATE_DIST_ROOT_BITS));
+    inf->state = PG_INFLATE_STATE_HUFFMAN;
+    step = PG_INFLATE_STEP_CONTINUE;
+  } break;
+  case 2:
+    step = pg_inflate_dynamic_header(inf);
+    break;
+  default:
+    break;
+  }
+
+  if (PG_INFLATE_STEP_CONTINUE != step) {
+    inf->bit_buf = bit_buf;
+    inf->bit_count = bit_count;
+    inf->in_pos = in_pos;
+    return step;
+  }
+
+  inf->final_block = header & 1;
+  return PG_INFLATE_STEP_CONTINUE;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_file_close(PgFileDescriptor file);
+[[nodiscard]] static PgInflateStep pg_inflate_stored(PgInflater *inf) {
+  u64 pos_max = inf->window_read + PG_DEFLATE_WINDOW_SIZE;
 
-[[nodiscard]] static u64 pg_os_get_page_size();
+  while (inf->stored_remaining > 0) {
+    if (inf->window_pos >= pos_max) {
+      return PG_INFLATE_STEP_OUTPUT;
+    }
 
-[[nodiscard]] i32 pg_os_get_last_error();
-[[nodiscard]] PG_RESULT(PgVoidPtr, PgError)
-    pg_virtual_mem_alloc(u64 size, PgVirtualMemFlags flags);
-[[nodiscard]] PgError pg_virtual_mem_protect(void *ptr, u64 size,
-                                             PgVirtualMemFlags flags_new);
-[[nodiscard]] PgError pg_virtual_mem_release(void *ptr, u64 size);
+    // Bytes already moved to the bit buffer.
+    if (inf->bit_count >= 8) {
+      inf->window[inf->window_pos++ & PG_INFLATE_WINDOW_MASK] =
+          (u8)inf->bit_buf;
+      inf->bit_buf >>= 8;
+      inf->bit_count -= 8;
+      inf->stored_remaining--;
+      continue;
+    }
 
-[[nodiscard]] i32 pg_virtual_mem_flags_to_os_flags(PgVirtualMemFlags flags);
+    if (inf->in_pos == inf->in_len) {
+      return PG_INFLATE_STEP_INPUT;
+    }
 
-[[maybe_unused]] [[nodiscard]] static PgArena
-pg_arena_make_from_virtual_mem(u64 size) {
-  if (0 == size) {
-    return (PgArena){0};
+    // The bit buffer may hold the bytes about to be copied.
+    PG_ASSERT(0 == inf->bit_count);
+    inf->bit_buf = 0;
+
+    u64 at = inf->window_pos & PG_INFLATE_WINDOW_MASK;
+    u64 n = PG_MIN(inf->stored_remaining, pos_max - inf->window_pos);
+    n = PG_MIN(n, inf->in_len - inf->in_pos);
+    n = PG_MIN(n, sizeof(inf->window) - at);
+    pg_memcpy(inf->window + at, inf->in + inf->in_pos, n);
+    inf->window_pos += n;
+    inf->in_pos += (u32)n;
+    inf->stored_remaining -= (u32)n;
   }
 
-  u64 page_size = pg_os_get_page_size();
-  PG_ASSERT(0 != page_size);
-  PG_ASSERT(0 == (page_size % 2));
+  inf->state = PG_INFLATE_STATE_BLOCK_HEADER;
+  return PG_INFLATE_STEP_CONTINUE;
+}
 
-  u64 size_rounded_up_to_page_size = pg_round_up_multiple_of(size, page_size);
-  PG_ASSERT(0 == size_rounded_up_to_page_size % page_size);
+// Decode a Huffman block until its end, the window is full or the input
+// buffer runs out. Each symbol, with the distance of a match, is only
+// consumed once whole.
+[[nodiscard]] static PgInflateStep pg_inflate_huffman(PgInflater *inf) {
+  const u32 *litlen_table = inf->litlen_table;
+  const u32 *dist_table = inf->dist_table;
+  u8 *window = inf->window;
+  const u8 *in = inf->in;
+  u64 bit_buf = inf->bit_buf;
+  u32 bit_count = inf->bit_count;
+  u32 in_pos = inf->in_pos;
+  u32 in_len = inf->in_len;
+  u64 pos = inf->window_pos;
+  u64 pos_max =
+      inf->window_read + PG_DEFLATE_WINDOW_SIZE - PG_DEFLATE_MAX_MATCH;
+  PgInflateStep step = PG_INFLATE_STEP_CONTINUE;
 
-  u64 os_alloc_size = size_rounded_up_to_page_size;
-  // Page guard before.
-  PG_ASSERT(false == ckd_add(&os_alloc_size, os_alloc_size, page_size));
-  // Page guard after.
-  PG_ASSERT(false == ckd_add(&os_alloc_size, os_alloc_size, page_size));
+  for (;;) {
+    if (pos > pos_max) {
+      step = PG_INFLATE_STEP_OUTPUT;
+      break;
+    }
 
-  PG_RESULT(PgVoidPtr, PgError)
-  res_alloc = pg_virtual_mem_alloc(
-      os_alloc_size, PG_VIRTUAL_MEM_FLAGS_READ | PG_VIRTUAL_MEM_FLAGS_WRITE);
-  u8 *alloc = PG_UNWRAP(res_alloc);
-  PG_ASSERT(nullptr != alloc);
+    // See `pg_inflate_refill`.
+    if (bit_count < 48) {
+      if (in_len - in_pos >= sizeof(u64)) {
+        bit_buf |= pg_u64_load_unaligned(in + in_pos) << bit_count;
+        in_pos += (63 - bit_count) >> 3;
+        bit_count |= 56;
+      } else {
+        for (; bit_count <= 56 && in_pos < in_len; bit_count += 8) {
+          bit_buf |= (u64)in[in_pos++] << bit_count;
+        }
+      }
+    }
 
-  u64 page_guard_before = (u64)alloc;
+    u64 bits = bit_buf;
+    u32 count = bit_count;
 
-  PG_ASSERT(false == ckd_add((u64 *)&alloc, (u64)alloc, page_size));
-  PG_ASSERT(page_guard_before + page_size == (u64)alloc);
+    u32 entry =
+        pg_inflate_lookup(litlen_table, PG_INFLATE_LITLEN_ROOT_BITS, bits);
+    u32 len = (entry >> 16) & 0xff;
+    if (0 == len || len > count) {
+      step = (0 == len && count >= PG_DEFLATE_MAX_BITS)
+                 ? PG_INFLATE_STEP_INVALID
+                 : PG_INFLATE_STEP_INPUT;
+      break;
+    }
+    bits >>= len;
+    count -= len;
+    u32 sym = entry & 0xffff;
 
-  u64 page_guard_after = (u64)0;
-  PG_ASSERT(false == ckd_add(&page_guard_after, (u64)alloc,
-                             size_rounded_up_to_page_size));
-  PG_ASSERT((u64)alloc + size_rounded_up_to_page_size == page_guard_after);
-  PG_ASSERT(page_guard_before + page_size + size_rounded_up_to_page_size ==
-            page_guard_after);
+    if (sym < PG_DEFLATE_END_OF_BLOCK) {
+      window[pos++ & PG_INFLATE_WINDOW_MASK] = (u8)sym;
+      bit_buf = bits;
+      bit_count = count;
+      continue;
+    }
+    if (PG_DEFLATE_END_OF_BLOCK == sym) {
+      bit_buf = bits;
+      bit_count = count;
+      inf->state = PG_INFLATE_STATE_BLOCK_HEADER;
+      break;
+    }
 
-  PG_ASSERT(0 == pg_virtual_mem_protect((void *)page_guard_before, page_size,
-                                        PG_VIRTUAL_MEM_FLAGS_NONE));
+    sym -= PG_DEFLATE_END_OF_BLOCK + 1;
+    if (sym >= PG_STATIC_ARRAY_LEN(pg_deflate_len_base)) {
+      step = PG_INFLATE_STEP_INVALID;
+      break;
+    }
+    u32 extra = pg_deflate_len_extra[sym];
+    if (extra > count) {
+      step = PG_INFLATE_STEP_INPUT;
+      break;
+    }
+    u32 length = pg_deflate_len_base[sym] + (u32)(bits & ((1U << extra) - 1));
+    bits >>= extra;
+    count -= extra;
 
-  PG_ASSERT(0 == pg_virtual_mem_protect((void *)page_guard_after, page_size,
-                                        PG_VIRTUAL_MEM_FLAGS_NONE));
+    entry = pg_inflate_lookup(dist_table, PG_INFLATE_DIST_ROOT_BITS, bits);
+    len = (entry >> 16) & 0xff;
+    if (0 == len || len > count) {
+      step = (0 == len && count >= PG_DEFLATE_MAX_BITS)
+                 ? PG_INFLATE_STEP_INVALID
+                 : PG_INFLATE_STEP_INPUT;
+      break;
+    }
+    bits >>= len;
+    count -= len;
+    sym = entry & 0xffff;
 
-  PG_ASSERT(os_alloc_size >= 2 * page_size);
-  return (PgArena){
-      .start_original = alloc,
-      .start = alloc,
-      .end = (u8 *)alloc + size,
-      .os_start = (u8 *)page_guard_before,
-      .os_alloc_size = os_alloc_size,
-  };
-}
+    if (sym >= PG_DEFLATE_DIST_CODES) {
+      step = PG_INFLATE_STEP_INVALID;
+      break;
+    }
+    extra = pg_deflate_dist_extra[sym];
+    if (extra > count) {
+      step = PG_INFLATE_STEP_INPUT;
+      break;
+    }
+    u32 dist = pg_deflate_dist_base[sym] + (u32)(bits & ((1U << extra) - 1));
+    bits >>= extra;
+    count -= extra;
 
-[[maybe_unused]] [[nodiscard]] static PgError pg_arena_release(PgArena *arena) {
-  if (nullptr == arena->start) {
-    return 0;
+    // Before the start of the stream.
+    if (dist > pos) {
+      step = PG_INFLATE_STEP_INVALID;
+      break;
+    }
+    bit_buf = bits;
+    bit_count = count;
+
+    u64 from = pos - dist;
+    u64 to_at = pos & PG_INFLATE_WINDOW_MASK;
+    u64 from_at = from & PG_INFLATE_WINDOW_MASK;
+    // 8 bytes at a time when neither side wraps around. Overshooting
+    // overwrites bytes older than the history.
+    if (dist >= sizeof(u64) &&
+        to_at + length + sizeof(u64) <= sizeof(inf->window) &&
+        from_at + length + sizeof(u64) <= sizeof(inf->window)) {
+      for (u32 i = 0; i < length; i += sizeof(u64)) {
+        u64 x = pg_u64_load_unaligned(window + from_at + i);
+        pg_memcpy(window + to_at + i, &x, sizeof(x));
+      }
+    } else {
+      for (u32 i = 0; i < length; i++) {
+        window[(pos + i) & PG_INFLATE_WINDOW_MASK] =
+            window[(from + i) & PG_INFLATE_WINDOW_MASK];
+      }
+    }
+    pos += length;
   }
 
-  PG_ASSERT(nullptr != arena->end);
-  PG_ASSERT(nullptr != arena->os_start);
-
-  return pg_virtual_mem_release(arena->os_start, arena->os_alloc_size);
+  inf->bit_buf = bit_buf;
+  inf->bit_count = bit_count;
+  inf->in_pos = in_pos;
+  inf->window_pos = pos;
+  return step;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_OPTION(Pgu64Range)
-    pg_u64_range_search(PG_SLICE(u64) haystack, u64 needle) {
-  PG_OPTION(Pgu64Range) res = {0};
-
-  if (0 == haystack.len) {
-    return res;
+[[nodiscard]] static PgInflateStep pg_inflate_trailer(PgInflater *inf) {
+  // The checksum covers all the data.
+  if (inf->window_read < inf->window_pos) {
+    return PG_INFLATE_STEP_OUTPUT;
   }
 
-  for (u64 i = 1; i < haystack.len; i++) {
-    u64 elem = PG_SLICE_AT(haystack, i);
-    if (needle < elem) {
-      res.has_value = true;
-      res.value.idx = i - 1;
-      res.value.start_incl = PG_SLICE_AT(haystack, i - 1);
-      res.value.end_excl = elem;
+  pg_inflate_align(inf);
+  u64 bit_buf = inf->bit_buf;
+  u32 bit_count = inf->bit_count;
+  u32 in_pos = inf->in_pos;
 
-      PG_ASSERT(res.value.start_incl <= needle);
-      PG_ASSERT(needle < res.value.end_excl);
-      return res;
+  switch (inf->format) {
+  case PG_DEFLATE_FORMAT_RAW:
+    break;
+  case PG_DEFLATE_FORMAT_ZLIB: {
+    u32 adler = 0;
+    if (!pg_inflate_take_bits(inf, 32, &adler)) {
+      return PG_INFLATE_STEP_INPUT;
     }
+    // Big endian.
+    if (__builtin_bswap32(adler) != inf->checksum) {
+      return PG_INFLATE_STEP_INVALID;
+    }
+  } break;
+  case PG_DEFLATE_FORMAT_GZIP: {
+    u32 crc = 0;
+    u32 size = 0;
+    if (!pg_inflate_take_bits(inf, 32, &crc) ||
+        !pg_inflate_take_bits(inf, 32, &size)) {
+      inf->bit_buf = bit_buf;
+      inf->bit_count = bit_count;
+      inf->in_pos = in_pos;
+      return PG_INFLATE_STEP_INPUT;
+    }
+    // The size is modulo 2^32.
+    if (crc != inf->checksum || size != (u32)inf->window_read) {
+      return PG_INFLATE_STEP_INVALID;
+    }
+  } break;
+  default:
+    PG_ASSERT(0);
   }
 
-  return res;
+  inf->state = PG_INFLATE_STATE_DONE;
+  return PG_INFLATE_STEP_CONTINUE;
 }
 
-// TODO: Trim separators in `a` and `b`?
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_path_join(PgString a, PgString b, PgAllocator *allocator) {
-  PgString sep = PG_S(PG_PATH_SEPARATOR_S);
+// Copy decoded data to `dst`, which updates the checksum.
+[[nodiscard]] static u64 pg_inflate_copy_out(PgInflater *inf,
+                                             PG_SLICE(u8) dst) {
+  u64 n = PG_MIN(dst.len, inf->window_pos - inf->window_read);
+  u64 at = inf->window_read & PG_INFLATE_WINDOW_MASK;
 
-  PG_DYN(u8) sb = pg_string_builder_make(a.len + sep.len + b.len, allocator);
+  for (u64 copied = 0; copied < n;) {
+    PgString part = {
+        .data = inf->window + at,
+        .len = PG_MIN(n - copied, sizeof(inf->window) - at),
+    };
+    pg_memcpy(dst.data + copied, part.data, part.len);
 
-  PG_DYN_APPEND_SLICE_WITHIN_CAPACITY(&sb, a);
-  PG_DYN_APPEND_SLICE_WITHIN_CAPACITY(&sb, sep);
-  PG_DYN_APPEND_SLICE_WITHIN_CAPACITY(&sb, b);
+    if (PG_DEFLATE_FORMAT_ZLIB == inf->format) {
+      inf->checksum = pg_adler32_update(inf->checksum, part);
+    } else if (PG_DEFLATE_FORMAT_GZIP == inf->format) {
+      inf->checksum = pg_crc32_update(inf->checksum, part);
+    }
 
-  return PG_DYN_TO_SLICE(PgString, sb);
+    copied += part.len;
+    at = 0;
+  }
+
+  inf->window_read += n;
+  return n;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString pg_path_base_name(PgString s) {
-  i64 idx = pg_string_last_index_of_rune(s, PG_PATH_SEPARATOR);
-  if (-1 == idx) {
-    return s;
-  } else {
-    return PG_SLICE_RANGE_START(s, (u64)idx + 1);
+[[nodiscard]] static PgInflateStep pg_inflate_step(PgInflater *inf) {
+  switch (inf->state) {
+  case PG_INFLATE_STATE_HEADER:
+    return pg_inflate_header(inf);
+  case PG_INFLATE_STATE_BLOCK_HEADER:
+    return pg_inflate_block_header(inf);
+  case PG_INFLATE_STATE_STORED:
+    return pg_inflate_stored(inf);
+  case PG_INFLATE_STATE_HUFFMAN:
+    return pg_inflate_huffman(inf);
+  case PG_INFLATE_STATE_TRAILER:
+    return pg_inflate_trailer(inf);
+  case PG_INFLATE_STATE_INVALID:
+    return PG_INFLATE_STEP_INVALID;
+  case PG_INFLATE_STATE_DONE:
+  default:
+    PG_ASSERT(0);
   }
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString pg_path_dir_name(PgString s) {
-  i64 idx = pg_string_last_index_of_rune(s, PG_PATH_SEPARATOR);
-  if (-1 == idx) {
-    return s;
-  } else {
-    return PG_SLICE_RANGE(s, 0, (u64)idx);
-  }
-}
-
-[[maybe_unused]] [[nodiscard]] static PgString pg_path_stem(PgString s) {
-  i64 idx = pg_string_last_index_of_rune(s, '.');
-  if (-1 == idx) {
-    return s;
-  }
+// Reader of the data decompressed from `inner`, which is in `format`. The
+// state, with the history and the input buffer, is allocated once so that
+// streams of any size are decoded in about 100 KiB. Each read pulls from
+// `inner` at most once, and not at all if some data can be returned without.
+// A truncated stream fails with `PG_ERR_IO`, and corrupt data or a checksum
+// mismatch with `PG_ERR_INVALID_VALUE`. Data after the end of the
+// compressed stream, e.g. another gzip member, is ignored.
+[[maybe_unused]] [[nodiscard]] static PgReader
+pg_inflate_reader_make(PgReader *inner, PgDeflateFormat format,
+                       PgAllocator *allocator) {
+  PgInflater *inf = PG_NEW(PgInflater, allocator);
+  inf->inner = inner;
+  inf->format = format;
+  inf->state = PG_DEFLATE_FORMAT_RAW == format ? PG_INFLATE_STATE_BLOCK_HEADER
+                                               : PG_INFLATE_STATE_HEADER;
+  inf->checksum = PG_DEFLATE_FORMAT_ZLIB == format ? 1 : 0;
 
-  return PG_SLICE_RANGE(s, 0, (u64)idx);
+  PgReader r = {0};
+  r.kind = PG_READER_KIND_INFLATE;
+  r.u.inflate = inf;
+  return r;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString pg_file_stem(PgString s) {
-  PgString base_name = pg_path_base_name(s);
-  i64 idx = pg_string_last_index_of_rune(base_name, '.');
-  if (-1 == idx) {
-    return base_name;
-  }
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_inflate_read(PgReader *r, PG_SLICE(u8) dst) {
+  PG_ASSERT(PG_READER_KIND_INFLATE == r->kind);
+  PgInflater *inf = r->u.inflate;
 
-  return PG_SLICE_RANGE(base_name, 0, (u64)idx);
-}
+  u64 n = 0;
+  for (;;) {
+    n += pg_inflate_copy_out(inf, PG_SLICE_RANGE_START(dst, n));
+    if (n == dst.len) {
+      return PG_OK(n, u64, PgError);
+    }
+    if (PG_INFLATE_STATE_DONE == inf->state) {
+      return n > 0 ? PG_OK(n, u64, PgError) : PG_ERR(PG_ERR_EOF, u64, PgError);
+    }
 
-[[maybe_unused]] [[nodiscard]] static PgString pg_file_extension(PgString s) {
-  PgString base_name = pg_path_base_name(s);
-  i64 idx = pg_string_last_index_of_rune(base_name, '.');
-  if (-1 == idx) {
-    return PG_S("");
+    switch (pg_inflate_step(inf)) {
+    case PG_INFLATE_STEP_CONTINUE:
+    case PG_INFLATE_STEP_OUTPUT:
+      break;
+    case PG_INFLATE_STEP_INPUT: {
+      if (n > 0) {
+        return PG_OK(n, u64, PgError);
+      }
+      PgError err = pg_inflate_read_more(inf);
+      if (err) {
+        return PG_ERR(err, u64, PgError);
+      }
+    } break;
+    case PG_INFLATE_STEP_INVALID:
+      // The error is reported by the next read.
+      inf->state = PG_INFLATE_STATE_INVALID;
+      return n > 0 ? PG_OK(n, u64, PgError)
+                   : PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+    default:
+      PG_ASSERT(0);
+    }
   }
-
-  return PG_SLICE_RANGE_START(base_name, (u64)idx + 1);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_string_concat(PgString left, PgString right, PgAllocator *allocator) {
-  PgString res = pg_string_make(left.len + right.len, allocator);
-  PG_ASSERT(res.data);
+#define PG_DEFLATE_HASH_BITS 15
+#define PG_DEFLATE_SYMS_MAX (16 * PG_KiB)
+#define PG_DEFLATE_OUT_SIZE (16 * PG_KiB)
+// Input kept ahead of the position being compressed, unless flushing, so
+// that matches can be as long as allowed.
+#define PG_DEFLATE_MIN_LOOKAHEAD                                               \
+  (PG_DEFLATE_MAX_MATCH + PG_DEFLATE_MIN_MATCH + 1)
+// Matches of 3 bytes further than this cost more than the literals.
+#define PG_DEFLATE_TOO_FAR 4096
 
-  pg_memmove(res.data, left.data, left.len);
-  pg_memmove(res.data + left.len, right.data, right.len);
+// zlib's configuration table. Levels 1 to 3 take the first match found
+// (greedy), and only index the strings within matches of at most `lazy_len`
+// bytes. The others look for a longer match at the next byte unless the
+// current one is `lazy_len` long (lazy). Searching the hash chain stops after
+// `max_chain` candidates, a quarter of that once the match is `good_len`
+// long, or once it is `nice_len` long.
+typedef struct {
+  u16 good_len;
+  u16 lazy_len;
+  u16 nice_len;
+  u16 max_chain;
+} PgDeflateLevel;
+
+static const PgDeflateLevel pg_deflate_levels[10] = {
+    {0, 0, 0, 0},           // Stored.
+    {4, 4, 8, 4},           //
+    {4, 5, 16, 8},          //
+    {4, 6, 32, 32},         //
+    {4, 4, 16, 16},         //
+    {8, 16, 32, 32},        //
+    {8, 16, 128, 128},      //
+    {8, 32, 128, 256},      //
+    {32, 128, 258, 1024},   //
+    {32, 258, 258, 4096},   //
+};
 
-  return res;
+struct PgDeflater {
+  PgWriter *inner;
+  PgAllocator *allocator; // For `inner`.
+  u64 bit_buf;            // Bits not in `out` yet, the first one lowest.
+  u64 total_in;
+  // Window offset of the input not in a block yet. Negative once slid out,
+  // which rules out a stored block.
+  i64 block_start;
+  // Sticky: the output is unusable after an error, which lets the hot paths
+  // ignore them.
+  PgError err;
+  u32 bit_count;
+  u32 window_len;
+  u32 pos; // Next byte of the window to compress.
+  // Lazy matching: the match found at `pos - 1`.
+  u32 match_len;
+  u32 match_dist;
+  u32 syms_len;
+  u32 out_len;
+  u32 checksum;
+  PgDeflateFormat format;
+  u8 level;
+  // Lazy matching: the byte at `pos - 1` is not tallied yet.
+  bool match_available;
+  bool finished;
+  PG_PAD(4);
+  // The last 32 KiB of input, which matches refer to, then up to 32 KiB of
+  // new input. Padded for 8 bytes loads past the end.
+  u8 window[2 * PG_DEFLATE_WINDOW_SIZE + sizeof(u64)];
+  // Hash chains of the 3 bytes strings: the last window offset with each
+  // hash, and for each offset the previous one with the same hash. 0 ends a
+  // chain, at the cost of never matching the first byte of the window.
+  u16 head[1U << PG_DEFLATE_HASH_BITS];
+  u16 prev[PG_DEFLATE_WINDOW_SIZE];
+  // The current block: literals, and matches as `dist << 16 | (len - 3)`.
+  u32 syms[PG_DEFLATE_SYMS_MAX];
+  u32 litlen_freqs[PG_DEFLATE_LITLEN_CODES];
+  u32 dist_freqs[PG_DEFLATE_DIST_CODES];
+  u8 out[PG_DEFLATE_OUT_SIZE];
+};
+
+// Send `out` to `inner`.
+static void pg_deflate_out_flush(PgDeflater *d) {
+  if (!d->err && d->out_len > 0) {
+    d->err = pg_writer_write_full(
+        d->inner, (PgString){.data = d->out, .len = d->out_len}, d->allocator);
+  }
+  d->out_len = 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgWriter
-pg_writer_make_from_file_descriptor(PgFileDescriptor file, u64 buffer_size,
-                                    PgAllocator *allocator) {
-  PgWriter w = {0};
-  w.kind = PG_WRITER_KIND_FILE;
-  w.u.file = file;
+static void pg_deflate_put_bits(PgDeflater *d, u32 bits, u32 count) {
+  PG_ASSERT(count <= 32);
 
-  if (buffer_size) {
-    w.ring = pg_ring_make(buffer_size, allocator);
+  d->bit_buf |= (u64)bits << d->bit_count;
+  d->bit_count += count;
+  if (d->bit_count < 32) {
+    return;
   }
 
-  return w;
-}
-
-[[maybe_unused]] [[nodiscard]] static PgWriter pg_writer_make_noop() {
-  PgWriter w = {0};
-  return w;
+  if (d->out_len + sizeof(u32) > PG_DEFLATE_OUT_SIZE) {
+    pg_deflate_out_flush(d);
+  }
+  u8 *out = d->out + d->out_len;
+  out[0] = (u8)d->bit_buf;
+  out[1] = (u8)(d->bit_buf >> 8);
+  out[2] = (u8)(d->bit_buf >> 16);
+  out[3] = (u8)(d->bit_buf >> 24);
+  d->out_len += sizeof(u32);
+  d->bit_buf >>= 32;
+  d->bit_count -= 32;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
-    pg_file_read_full_from_descriptor(PgFileDescriptor file, u64 size,
-                                      PgAllocator *allocator) {
-  PgError err = {0};
-  PG_DYN(u8) sb = {0};
-  PG_DYN_ENSURE_CAP(&sb, size, allocator);
+// Pad to a byte boundary and move the bit buffer to `out`.
+static void pg_deflate_align(PgDeflater *d) {
+  pg_deflate_put_bits(d, 0, (8 - (d->bit_count & 7)) & 7);
 
-  for (u64 lim = 0; lim < size; lim++) {
-    if (size == sb.len) {
-      break;
-    }
+  if (d->out_len + sizeof(u32) > PG_DEFLATE_OUT_SIZE) {
+    pg_deflate_out_flush(d);
+  }
+  for (; d->bit_count > 0; d->bit_count -= 8) {
+    d->out[d->out_len++] = (u8)d->bit_buf;
+    d->bit_buf >>= 8;
+  }
+}
 
-    PgString space = {.data = sb.data + sb.len, .len = sb.cap - sb.len};
-    PG_RESULT(u64, PgError) res_read = pg_file_read(file, space);
-    if (PG_IS_ERR(res_read)) {
-      err = (PgError)pg_os_get_last_error();
-      goto end;
-    }
+static void pg_deflate_put_bytes(PgDeflater *d, const u8 *data, u64 len) {
+  PG_ASSERT(0 == d->bit_count);
 
-    u64 read_n = PG_UNWRAP(res_read);
-    if (0 == read_n) {
-      err = PG_ERR_INVALID_VALUE;
-      goto end;
+  while (len > 0) {
+    if (PG_DEFLATE_OUT_SIZE == d->out_len) {
+      pg_deflate_out_flush(d);
     }
+    u64 n = PG_MIN(len, PG_DEFLATE_OUT_SIZE - d->out_len);
+    pg_memcpy(d->out + d->out_len, data, n);
+    d->out_len += (u32)n;
+    data += n;
+    len -= n;
+  }
+}
 
-    PG_ASSERT((u64)read_n <= space.len);
-
-    sb.len += (u64)read_n;
+// Canonical codes for the code lengths `lens`, bit reversed since they are
+// written from their most significant bit.
+static void pg_deflate_codes(const u8 *lens, u32 lens_len, u16 *codes) {
+  u32 counts[PG_DEFLATE_MAX_BITS + 1] = {0};
+  for (u32 i = 0; i < lens_len; i++) {
+    counts[lens[i]]++;
   }
+  counts[0] = 0;
 
-end:
-  if (err && sb.data) {
-    pg_free(allocator, sb.data);
-    return PG_ERR(err, PgString, PgError);
+  u32 next_code[PG_DEFLATE_MAX_BITS + 1] = {0};
+  for (u32 len = 1, code = 0; len <= PG_DEFLATE_MAX_BITS; len++) {
+    code = (code + counts[len - 1]) << 1;
+    next_code[len] = code;
   }
 
-  return PG_OK(PG_DYN_TO_SLICE(PgString, sb), PgString, PgError);
+  for (u32 sym = 0; sym < lens_len; sym++) {
+    u32 len = lens[sym];
+    u32 code = next_code[len]++;
+    u32 reversed = 0;
+    for (u32 i = 0; i < len; i++) {
+      reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    codes[sym] = (u16)reversed;
+  }
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
-    pg_file_read_full_from_descriptor_until_eof(PgFileDescriptor file,
-                                                u64 size_hint,
-                                                PgAllocator *allocator) {
-  PgError err = 0;
-
-  PG_DYN(u8) sb = {0};
-  PG_DYN_ENSURE_CAP(&sb, size_hint, allocator);
-
-  for (;;) {
-    PG_DYN_ENSURE_CAP(&sb, 4096, allocator);
-    PgString space = {.data = sb.data + sb.len, .len = sb.cap - sb.len};
-    PG_ASSERT(space.len);
+// Code lengths of at most `max_len` bits minimizing the size of the symbols
+// counted in `freqs`: Moffat and Katajainen's in-place computation of the
+// Huffman code lengths, then the lengths over the limit are shortened and
+// the others lengthened to stay within Kraft's inequality, as miniz does.
+// Codes have at least 2 symbols, which some decoders require.
+static void pg_deflate_build_lens(const u32 *freqs, u32 freqs_len,
+                                  u32 max_len, u8 *lens) {
+  PG_ASSERT(freqs_len <= PG_DEFLATE_LITLEN_CODES);
 
-    PG_RESULT(u64, PgError) res_read = pg_file_read(file, space);
-    if (PG_IS_ERR(res_read)) {
-      err = (PgError)pg_os_get_last_error();
-      goto end;
+  // Used symbols, by increasing frequency.
+  u16 syms[PG_DEFLATE_LITLEN_CODES] = {0};
+  u32 a[PG_DEFLATE_LITLEN_CODES] = {0};
+  u32 n = 0;
+  for (u32 sym = 0; sym < freqs_len; sym++) {
+    lens[sym] = 0;
+    if (0 == freqs[sym]) {
+      continue;
     }
 
-    u64 read_n = PG_UNWRAP(res_read);
-    if (0 == read_n) {
-      goto end;
+    u32 i = n++;
+    for (; i > 0 && freqs[syms[i - 1]] > freqs[sym]; i--) {
+      syms[i] = syms[i - 1];
     }
+    syms[i] = (u16)sym;
+  }
 
-    PG_ASSERT((u64)read_n <= space.len);
+  if (0 == n) {
+    lens[0] = lens[1] = 1;
+    return;
+  }
+  if (1 == n) {
+    lens[syms[0]] = 1;
+    lens[0 == syms[0] ? 1 : 0] = 1;
+    return;
+  }
 
-    sb.len += (u64)read_n;
+  for (u32 i = 0; i < n; i++) {
+    a[i] = freqs[syms[i]];
   }
 
-end:
-  if (err && sb.data) {
-    pg_free(allocator, sb.data);
-    return PG_ERR(err, PgString, PgError);
+  // Combine the two lightest nodes, the internal nodes replacing the leaves
+  // from the start of `a`, which then holds the parent of each.
+  a[0] += a[1];
+  u32 root = 0;
+  u32 leaf = 2;
+  for (u32 next = 1; next < n - 1; next++) {
+    if (leaf >= n || a[root] < a[leaf]) {
+      a[next] = a[root];
+      a[root++] = next;
+    } else {
+      a[next] = a[leaf++];
+    }
+    if (leaf >= n || (root < next && a[root] < a[leaf])) {
+      a[next] += a[root];
+      a[root++] = next;
+    } else {
+      a[next] += a[leaf++];
+    }
+  }
+  // Depths of the internal nodes.
+  a[n - 2] = 0;
+  for (i64 next = (i64)n - 3; next >= 0; next--) {
+    a[next] = a[a[next]] + 1;
+  }
+  // Depths of the leaves, from the deepest.
+  {
+    i64 avail = 1;
+    i64 used = 0;
+    u32 depth = 0;
+    i64 root_i = (i64)n - 2;
+    i64 next = (i64)n - 1;
+    while (avail > 0) {
+      for (; root_i >= 0 && a[root_i] == depth; root_i--) {
+        used++;
+      }
+      for (; avail > used; avail--) {
+        a[next--] = depth;
+      }
+      avail = 2 * used;
+      depth++;
+      used = 0;
+    }
   }
 
-  return PG_OK(PG_DYN_TO_SLICE(PgString, sb), PgString, PgError);
-}
+  u32 len_counts[PG_DEFLATE_MAX_BITS + 1] = {0};
+  for (u32 i = 0; i < n; i++) {
+    len_counts[PG_MIN(a[i], max_len)]++;
+  }
+  u32 kraft = 0;
+  for (u32 len = 1; len <= max_len; len++) {
+    kraft += len_counts[len] << (max_len - len);
+  }
+  for (; kraft > 1U << max_len; kraft--) {
+    len_counts[max_len]--;
+    for (u32 len = max_len - 1; len > 0; len--) {
+      if (len_counts[len]) {
+        len_counts[len]--;
+        len_counts[len + 1] += 2;
+        break;
+      }
+    }
+  }
 
-[[maybe_unused]] [[nodiscard]] static PgReader
-pg_reader_make_from_file(PgFileDescriptor file, u64 buffer_size,
-                         PgAllocator *allocator) {
-  PgReader r = {0};
-  r.kind = PG_READER_KIND_FILE;
-  r.u.file = file;
-  if (buffer_size) {
-    r.ring = pg_ring_make(buffer_size, allocator);
+  // The most frequent symbols get the shortest codes.
+  for (u32 len = 1, i = n; len <= max_len; len++) {
+    for (u32 k = 0; k < len_counts[len]; k++) {
+      lens[syms[--i]] = (u8)len;
+    }
   }
-  return r;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgReader
-pg_reader_make_from_socket(PgFileDescriptor file, u64 buffer_size,
-                           PgAllocator *allocator) {
-  PgReader r = {0};
-  r.kind = PG_READER_KIND_SOCKET;
-  r.u.file = file;
-  if (buffer_size) {
-    r.ring = pg_ring_make(buffer_size, allocator);
+// Bits of the symbols of the block with these code lengths, including the
+// extra bits.
+[[nodiscard]] static u64 pg_deflate_syms_cost(PgDeflater *d,
+                                              const u8 *litlen_lens,
+                                              const u8 *dist_lens) {
+  u64 cost = 0;
+  for (u32 i = 0; i < PG_DEFLATE_LITLEN_CODES; i++) {
+    cost += (u64)d->litlen_freqs[i] * litlen_lens[i];
   }
-  return r;
+  for (u32 i = 0; i < PG_STATIC_ARRAY_LEN(pg_deflate_len_extra); i++) {
+    cost += (u64)d->litlen_freqs[PG_DEFLATE_END_OF_BLOCK + 1 + i] *
+            pg_deflate_len_extra[i];
+  }
+  for (u32 i = 0; i < PG_DEFLATE_DIST_CODES; i++) {
+    cost += (u64)d->dist_freqs[i] * (dist_lens[i] + pg_deflate_dist_extra[i]);
+  }
+  return cost;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgReader
-pg_reader_make_from_bytes(PG_SLICE(u8) bytes) {
-  PgReader r = {0};
-  r.kind = PG_READER_KIND_BYTES;
-  r.u.bytes = bytes;
-  return r;
-}
+static void pg_deflate_put_syms(PgDeflater *d, const u8 *litlen_lens,
+                                const u16 *litlen_codes, const u8 *dist_lens,
+                                const u16 *dist_codes) {
+  for (u32 i = 0; i < d->syms_len; i++) {
+    u32 sym = d->syms[i];
+    u32 dist = sym >> 16;
+    if (0 == dist) {
+      pg_deflate_put_bits(d, litlen_codes[sym], litlen_lens[sym]);
+      continue;
+    }
 
-[[maybe_unused]] [[nodiscard]] static PgWriter
-pg_writer_make_from_socket(PgFileDescriptor file, u64 buffer_size,
-                           PgAllocator *allocator) {
-  PgWriter w = {0};
-  w.kind = PG_WRITER_KIND_SOCKET;
-  w.u.file = file;
-  if (buffer_size) {
-    w.ring = pg_ring_make(buffer_size, allocator);
+    u32 len_minus_3 = sym & 0xffff;
+    u32 code = pg_deflate_len_code(len_minus_3);
+    u32 lit = PG_DEFLATE_END_OF_BLOCK + 1 + code;
+    pg_deflate_put_bits(d, litlen_codes[lit], litlen_lens[lit]);
+    pg_deflate_put_bits(d,
+                        len_minus_3 + PG_DEFLATE_MIN_MATCH -
+                            pg_deflate_len_base[code],
+                        pg_deflate_len_extra[code]);
+
+    code = pg_deflate_dist_code(dist - 1);
+    pg_deflate_put_bits(d, dist_codes[code], dist_lens[code]);
+    pg_deflate_put_bits(d, dist - pg_deflate_dist_base[code],
+                        pg_deflate_dist_extra[code]);
   }
-  return w;
-}
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_file_write_full_with_descriptor(PgFileDescriptor file,
-                                   PG_SLICE(u8) content) {
-  PgError err = 0;
-  PgString remaining = content;
-  for (u64 lim = 0; lim < content.len; lim++) {
-    if (pg_string_is_empty(remaining)) {
-      break;
-    }
+  pg_deflate_put_bits(d, litlen_codes[PG_DEFLATE_END_OF_BLOCK],
+                      litlen_lens[PG_DEFLATE_END_OF_BLOCK]);
+}
 
-    PG_RESULT(u64, PgError) res_write = pg_file_write(file, remaining);
-    if (PG_IS_ERR(res_write)) {
-      err = (PgError)pg_os_get_last_error();
-      goto end;
+// Stored blocks of `len` bytes of the window from `start`.
+static void pg_deflate_put_stored(PgDeflater *d, u32 start, u32 len,
+                                  bool final) {
+  do {
+    u32 n = PG_MIN(len, UINT16_MAX);
+    pg_deflate_put_bits(d, (final && n == len) ? 1 : 0, 3);
+    pg_deflate_align(d);
+
+    u8 header[4] = {
+        (u8)n,
+        (u8)(n >> 8),
+        (u8)~n,
+        (u8)(~n >> 8),
+    };
+    pg_deflate_put_bytes(d, header, sizeof(header));
+    pg_deflate_put_bytes(d, d->window + start, n);
+
+    start += n;
+    len -= n;
+  } while (len > 0);
+}
+
+// Emit the symbols tallied since the last block as the smallest of a
+// stored, a fixed Huffman or a dynamic Huffman block.
+static void pg_deflate_emit_block(PgDeflater *d, bool final) {
+  u32 block_end = d->pos - (d->match_available ? 1 : 0);
+  d->litlen_freqs[PG_DEFLATE_END_OF_BLOCK] = 1;
+
+  u8 litlen_lens[288] = {0};
+  u8 dist_lens[32] = {0};
+  pg_deflate_build_lens(d->litlen_freqs, PG_DEFLATE_LITLEN_CODES,
+                        PG_DEFLATE_MAX_BITS, litlen_lens);
+  pg_deflate_build_lens(d->dist_freqs, PG_DEFLATE_DIST_CODES,
+                        PG_DEFLATE_MAX_BITS, dist_lens);
+
+  u32 hlit = PG_DEFLATE_LITLEN_CODES;
+  for (; hlit > 257 && 0 == litlen_lens[hlit - 1]; hlit--) {
+  }
+  u32 hdist = PG_DEFLATE_DIST_CODES;
+  for (; hdist > 1 && 0 == dist_lens[hdist - 1]; hdist--) {
+  }
+
+  // The code lengths of both codes, run length encoded as
+  // `symbol | repeat << 5`.
+  u8 lens[PG_DEFLATE_LITLEN_CODES + PG_DEFLATE_DIST_CODES] = {0};
+  pg_memcpy(lens, litlen_lens, hlit);
+  pg_memcpy(lens + hlit, dist_lens, hdist);
+  u16 runs[PG_STATIC_ARRAY_LEN(lens)] = {0};
+  u32 runs_len = 0;
+  u32 codelen_freqs[PG_DEFLATE_CODELEN_CODES] = {0};
+  for (u32 i = 0; i < hlit + hdist;) {
+    u8 len = lens[i];
+    u32 run = 1;
+    for (; i + run < hlit + hdist && lens[i + run] == len; run++) {
+    }
+    i += run;
+
+    if (0 == len) {
+      for (; run >= 11; run -= PG_MIN(run, 138)) {
+        runs[runs_len++] = (u16)(18 | (PG_MIN(run, 138) - 11) << 5);
+        codelen_freqs[18]++;
+      }
+      if (run >= 3) {
+        runs[runs_len++] = (u16)(17 | (run - 3) << 5);
+        codelen_freqs[17]++;
+        run = 0;
+      }
+    } else {
+      runs[runs_len++] = len;
+      codelen_freqs[len]++;
+      run--;
+      for (; run >= 3; run -= PG_MIN(run, 6)) {
+        runs[runs_len++] = (u16)(16 | (PG_MIN(run, 6) - 3) << 5);
+        codelen_freqs[16]++;
+      }
     }
-
-    u64 write_n = PG_UNWRAP(res_write);
-    if (0 == write_n) {
-      err = PG_ERR_INVALID_VALUE;
-      goto end;
+    for (; run > 0; run--) {
+      runs[runs_len++] = len;
+      codelen_freqs[len]++;
     }
+  }
 
-    remaining = PG_SLICE_RANGE_START(remaining, write_n);
+  u8 codelen_lens[PG_DEFLATE_CODELEN_CODES] = {0};
+  pg_deflate_build_lens(codelen_freqs, PG_DEFLATE_CODELEN_CODES, 7,
+                        codelen_lens);
+  u32 hclen = PG_DEFLATE_CODELEN_CODES;
+  for (; hclen > 4 && 0 == codelen_lens[pg_deflate_codelen_order[hclen - 1]];
+       hclen--) {
   }
 
-end:
-  return err;
-}
+  u64 dynamic_cost = 3 + 14 + 3 * hclen;
+  for (u32 i = 0; i < PG_DEFLATE_CODELEN_CODES; i++) {
+    dynamic_cost += (u64)codelen_freqs[i] * codelen_lens[i];
+  }
+  dynamic_cost += 2 * codelen_freqs[16] + 3 * codelen_freqs[17] +
+                  7 * codelen_freqs[18];
+  dynamic_cost += pg_deflate_syms_cost(d, litlen_lens, dist_lens);
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
-    pg_file_read_full_from_path(PgString path, PgAllocator *allocator) {
-  PG_RESULT(PgString, PgError) res = {0};
+  u8 fixed_litlen_lens[288] = {0};
+  u8 fixed_dist_lens[32] = {0};
+  pg_deflate_fixed_lens(fixed_litlen_lens, fixed_dist_lens);
+  u64 fixed_cost =
+      3 + pg_deflate_syms_cost(d, fixed_litlen_lens, fixed_dist_lens);
 
-  PG_RESULT(PgFileDescriptor, PgError)
-  res_file = pg_file_open(path, PG_FILE_ACCESS_READ, 0600, false, allocator);
-  if (PG_IS_ERR(res_file)) {
-    return PG_ERR(PG_UNWRAP_ERR(res_file), PgString, PgError);
+  // The header and the padding of each stored block, roughly.
+  u64 stored_cost = UINT64_MAX;
+  if (d->block_start >= 0) {
+    u64 stored_len = block_end - (u64)d->block_start;
+    stored_cost =
+        (stored_len / UINT16_MAX + 1) * (3 + 7 + 32) + 8 * stored_len;
   }
 
-  PgFileDescriptor file = PG_UNWRAP(res_file);
+  // Level 0 has no symbols.
+  if (0 == d->level ||
+      (stored_cost <= fixed_cost && stored_cost <= dynamic_cost)) {
+    pg_deflate_put_stored(d, (u32)d->block_start,
+                          block_end - (u32)d->block_start, final);
+  } else if (fixed_cost <= dynamic_cost) {
+    u16 litlen_codes[288] = {0};
+    u16 dist_codes[32] = {0};
+    pg_deflate_codes(fixed_litlen_lens, 288, litlen_codes);
+    pg_deflate_codes(fixed_dist_lens, 32, dist_codes);
 
-  PG_RESULT(u64, PgError) res_size = pg_file_size(file);
-  if (PG_IS_ERR(res_size)) {
-    res = PG_ERR(PG_UNWRAP_ERR(res_size), PgString, PgError);
-    goto end;
+    pg_deflate_put_bits(d, final | 1 << 1, 3);
+    pg_deflate_put_syms(d, fixed_litlen_lens, litlen_codes, fixed_dist_lens,
+                        dist_codes);
+  } else {
+    u16 litlen_codes[288] = {0};
+    u16 dist_codes[32] = {0};
+    u16 codelen_codes[PG_DEFLATE_CODELEN_CODES] = {0};
+    pg_deflate_codes(litlen_lens, PG_DEFLATE_LITLEN_CODES, litlen_codes);
+    pg_deflate_codes(dist_lens, PG_DEFLATE_DIST_CODES, dist_codes);
+    pg_deflate_codes(codelen_lens, PG_DEFLATE_CODELEN_CODES, codelen_codes);
+
+    pg_deflate_put_bits(d, final | 2 << 1, 3);
+    pg_deflate_put_bits(d, (hlit - 257) | (hdist - 1) << 5 | (hclen - 4) << 10,
+                        14);
+    for (u32 i = 0; i < hclen; i++) {
+      pg_deflate_put_bits(d, codelen_lens[pg_deflate_codelen_order[i]], 3);
+    }
+    for (u32 i = 0; i < runs_len; i++) {
+      u32 sym = runs[i] & 0x1f;
+      pg_deflate_put_bits(d, codelen_codes[sym], codelen_lens[sym]);
+      if (sym >= 16) {
+        pg_deflate_put_bits(d, runs[i] >> 5, 16 == sym ? 2 : 17 == sym ? 3 : 7);
+      }
+    }
+    pg_deflate_put_syms(d, litlen_lens, litlen_codes, dist_lens, dist_codes);
   }
 
-  u64 size = PG_UNWRAP(res_size);
+  for (u32 i = 0; i < PG_DEFLATE_LITLEN_CODES; i++) {
+    d->litlen_freqs[i] = 0;
+  }
+  for (u32 i = 0; i < PG_DEFLATE_DIST_CODES; i++) {
+    d->dist_freqs[i] = 0;
+  }
+  d->syms_len = 0;
+  d->block_start = block_end;
+}
 
-  res = pg_file_read_full_from_descriptor(file, size, allocator);
+static void pg_deflate_tally_literal(PgDeflater *d, u8 c) {
+  d->syms[d->syms_len++] = c;
+  d->litlen_freqs[c]++;
+}
 
-end:
-  (void)pg_file_close(file);
+static void pg_deflate_tally_match(PgDeflater *d, u32 len, u32 dist) {
+  u32 len_minus_3 = len - PG_DEFLATE_MIN_MATCH;
+  d->syms[d->syms_len++] = dist << 16 | len_minus_3;
+  d->litlen_freqs[PG_DEFLATE_END_OF_BLOCK + 1 +
+                  pg_deflate_len_code(len_minus_3)]++;
+  d->dist_freqs[pg_deflate_dist_code(dist - 1)]++;
+}
 
-  return res;
+// Add the string at `pos` to its hash chain, and return the previous window
+// offset with the same hash, 0 for none.
+static u32 pg_deflate_insert(PgDeflater *d, u32 pos) {
+  const u8 *p = d->window + pos;
+  u32 h = (((u32)p[0] | (u32)p[1] << 8 | (u32)p[2] << 16) * 0x9e3779b1U) >>
+          (32 - PG_DEFLATE_HASH_BITS);
+
+  u32 head = d->head[h];
+  d->prev[pos & (PG_DEFLATE_WINDOW_SIZE - 1)] = (u16)head;
+  d->head[h] = (u16)pos;
+  return head;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_file_write_full(PgString path, PgString content, u64 mode,
-                   PgAllocator *allocator) {
-  PgFileDescriptor file = PG_TRY_ERR(
-      pg_file_open(path, PG_FILE_ACCESS_WRITE, mode, true, allocator));
+// Longest match for the string at `pos` in the hash chain from `candidate`,
+// if longer than `best_len`.
+[[nodiscard]] static u32 pg_deflate_longest_match(PgDeflater *d, u32 candidate,
+                                                  u32 best_len,
+                                                  u32 *best_dist) {
+  PgDeflateLevel level = pg_deflate_levels[d->level];
+  u32 chain = level.max_chain;
+  if (best_len >= level.good_len) {
+    chain >>= 2;
+  }
+  u32 max_len = PG_MIN(PG_DEFLATE_MAX_MATCH, d->window_len - d->pos);
+  u32 nice_len = PG_MIN(level.nice_len, max_len);
+  best_len = PG_MAX(best_len, PG_DEFLATE_MIN_MATCH - 1);
+  if (best_len >= max_len) {
+    return best_len;
+  }
 
-  PG_ERR_RETURN(pg_file_write_full_with_descriptor(file, content));
+  const u8 *cur = d->window + d->pos;
+  u32 limit =
+      d->pos > PG_DEFLATE_WINDOW_SIZE ? d->pos - PG_DEFLATE_WINDOW_SIZE : 0;
 
-  PG_ERR_RETURN(pg_file_close(file));
+  for (; candidate > limit && chain > 0; chain--) {
+    const u8 *m = d->window + candidate;
 
-  return 0;
-}
+    // Check first whether it could be longer.
+    if (m[best_len] == cur[best_len] && m[0] == cur[0] && m[1] == cur[1]) {
+      u32 len = 0;
+      for (; len + sizeof(u64) <= max_len; len += sizeof(u64)) {
+        u64 diff = pg_u64_load_unaligned(cur + len) ^
+                   pg_u64_load_unaligned(m + len);
+        if (diff) {
+          len += (u32)__builtin_ctzll(diff) / 8;
+          goto end;
+        }
+      }
+      for (; len < max_len && cur[len] == m[len]; len++) {
+      }
+    end:
+      len = PG_MIN(len, max_len);
+
+      if (len > best_len) {
+        best_len = len;
+        *best_dist = d->pos - candidate;
+        if (len >= nice_len) {
+          break;
+        }
+      }
+    }
 
-[[maybe_unused]] [[nodiscard]]
-static PG_RESULT(PgProcess, PgError)
-    pg_process_spawn(PgString path, PG_SLICE(PgString) args,
-                     PgProcessSpawnOptions options, PgAllocator *allocator);
+    u32 next = d->prev[candidate & (PG_DEFLATE_WINDOW_SIZE - 1)];
+    // Overwritten by a newer string.
+    if (next >= candidate) {
+      break;
+    }
+    candidate = next;
+  }
 
-[[maybe_unused]] [[nodiscard]]
-static PG_RESULT(PgProcessStatus, PgError)
-    pg_process_wait(PgProcess process, u64 stdio_size_hint,
-                    u64 stderr_size_hint, PgAllocator *allocator);
+  return best_len;
+}
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_file_send_to_socket(PgFileDescriptor dst, PgFileDescriptor src);
+// Tally the input up to `PG_DEFLATE_MIN_LOOKAHEAD` bytes from the end of the
+// window, or all of it when `flush`ing.
+static void pg_deflate_tally(PgDeflater *d, bool flush) {
+  if (0 == d->level) {
+    d->pos = d->window_len;
+    return;
+  }
 
-// This works from any kind of file descriptor to any kind of file descriptor.
-// But this may be slower than OS-specific syscalls.
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_file_copy_with_descriptors_until_eof(PgFileDescriptor dst,
-                                        PgFileDescriptor src, u64 offset) {
-  // NOTE: on FreeBSD, we could use `copy_file_range` (and Linux too, actually),
-  // or `splice`.
+  PgDeflateLevel level = pg_deflate_levels[d->level];
+  bool lazy = d->level > 3;
 
   for (;;) {
-    u8 read_buf[4096] = {0};
-    PG_SLICE(u8)
-    read_slice = {.data = read_buf, .len = PG_STATIC_ARRAY_LEN(read_buf)};
+    u32 lookahead = d->window_len - d->pos;
+    if (0 == lookahead || (lookahead < PG_DEFLATE_MIN_LOOKAHEAD && !flush)) {
+      break;
+    }
+    if (PG_DEFLATE_SYMS_MAX == d->syms_len) {
+      pg_deflate_emit_block(d, false);
+    }
 
-    u64 read_count = PG_TRY_ERR(pg_file_read(src, read_slice));
-    // EOF.
-    if (0 == read_count) {
-      return (PgError)0;
+    u32 candidate = 0;
+    if (lookahead >= PG_DEFLATE_MIN_MATCH) {
+      candidate = pg_deflate_insert(d, d->pos);
     }
 
-    if (offset > read_count) {
-      // Keep reading and do not write yet.
+    u32 prev_len = lazy ? d->match_len : 0;
+    u32 len = PG_DEFLATE_MIN_MATCH - 1;
+    u32 dist = 0;
+    if (candidate && (!lazy || prev_len < level.lazy_len)) {
+      len = pg_deflate_longest_match(d, candidate, prev_len, &dist);
+      if (len <= prev_len ||
+          (PG_DEFLATE_MIN_MATCH == len && dist > PG_DEFLATE_TOO_FAR)) {
+        len = PG_DEFLATE_MIN_MATCH - 1;
+      }
+    }
 
-      offset -= read_count;
+    if (!lazy) {
+      if (len < PG_DEFLATE_MIN_MATCH) {
+        pg_deflate_tally_literal(d, d->window[d->pos]);
+        d->pos++;
+        continue;
+      }
+
+      pg_deflate_tally_match(d, len, dist);
+      if (len <= level.lazy_len) {
+        for (u32 p = d->pos + 1; p < d->pos + len; p++) {
+          if (p + PG_DEFLATE_MIN_MATCH <= d->window_len) {
+            (void)pg_deflate_insert(d, p);
+          }
+        }
+      }
+      d->pos += len;
       continue;
     }
 
-    PG_ASSERT(offset <= read_count);
+    // Lazy: the match at the previous byte, unless this one is longer.
+    if (prev_len >= PG_DEFLATE_MIN_MATCH && len <= prev_len) {
+      pg_deflate_tally_match(d, prev_len, d->match_dist);
+      u32 end = d->pos - 1 + prev_len;
+      for (u32 p = d->pos + 1; p < end; p++) {
+        if (p + PG_DEFLATE_MIN_MATCH <= d->window_len) {
+          (void)pg_deflate_insert(d, p);
+        }
+      }
+      d->pos = end;
+      d->match_available = false;
+      d->match_len = PG_DEFLATE_MIN_MATCH - 1;
+      continue;
+    }
 
-    PG_SLICE(u8)
-    write_slice = {.data = read_slice.data + offset,
-                   .len = read_count - offset};
-    PgError err = pg_file_write_full_with_descriptor(dst, write_slice);
-    if (err) {
-      return err;
+    if (d->match_available) {
+      pg_deflate_tally_literal(d, d->window[d->pos - 1]);
     }
+    d->match_available = true;
+    d->match_len = len;
+    d->match_dist = dist;
+    d->pos++;
+  }
 
-    if (offset > 0) {
-      offset = 0;
+  if (flush && d->match_available) {
+    if (PG_DEFLATE_SYMS_MAX == d->syms_len) {
+      pg_deflate_emit_block(d, false);
     }
+    pg_deflate_tally_literal(d, d->window[d->pos - 1]);
+    d->match_available = false;
+    d->match_len = PG_DEFLATE_MIN_MATCH - 1;
   }
 }
 
-// ----- Start UNIX implementation ------
-#ifdef PG_OS_UNIX
-
-#define PG_PIPE_READ 0
-#define PG_PIPE_WRITE 1
+// Drop the oldest 32 KiB of the window to make room for more input.
+static void pg_deflate_slide(PgDeflater *d) {
+  PG_ASSERT(d->pos >= PG_DEFLATE_WINDOW_SIZE);
 
-[[maybe_unused]] [[nodiscard]] PG_RESULT(PgDirectory, PgError)
-    pg_directory_open(PgString name) {
-  if (name.len > PG_PATH_MAX - 1) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgDirectory, PgError);
+  // The stored blocks of level 0 are made from the window.
+  if (0 == d->level) {
+    pg_deflate_emit_block(d, false);
   }
 
-  u8 name_c[PG_PATH_MAX] = {0};
-  pg_memcpy(name_c, name.data, name.len);
+  pg_memmove(d->window, d->window + PG_DEFLATE_WINDOW_SIZE,
+             d->window_len - PG_DEFLATE_WINDOW_SIZE);
+  d->window_len -= PG_DEFLATE_WINDOW_SIZE;
+  d->pos -= PG_DEFLATE_WINDOW_SIZE;
+  d->block_start -= PG_DEFLATE_WINDOW_SIZE;
 
-  DIR *dir = opendir((char *)name_c);
-  if (!dir) {
-    return PG_ERR(errno, PgDirectory, PgError);
+  for (u32 i = 0; i < PG_STATIC_ARRAY_LEN(d->head); i++) {
+    u32 v = d->head[i];
+    d->head[i] = (u16)(v >= PG_DEFLATE_WINDOW_SIZE ? v - PG_DEFLATE_WINDOW_SIZE
+                                                   : 0);
+  }
+  for (u32 i = 0; i < PG_STATIC_ARRAY_LEN(d->prev); i++) {
+    u32 v = d->prev[i];
+    d->prev[i] = (u16)(v >= PG_DEFLATE_WINDOW_SIZE ? v - PG_DEFLATE_WINDOW_SIZE
+                                                   : 0);
   }
-
-  return PG_OK((PgDirectory){.dir = dir}, PgDirectory, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] PgError pg_directory_close(PgDirectory dir) {
-  i32 ret = closedir(dir.dir);
-  if (-1 == ret) {
-    return (PgError)errno;
+// Writer compressing what is written to it to `inner`, in `format`. `level`
+// goes from 1, the fastest, to 9, the smallest, like zlib's, and 0 stores the
+// data as is. The state, with the history and the pending block, is
+// allocated once so that streams of any size are compressed in about
+// 280 KiB. Data is only sent to `inner` by 16 KiB, or by
+// `pg_deflate_writer_flush`. `pg_deflate_writer_finish` ends the stream.
+[[maybe_unused]] [[nodiscard]] static PgWriter
+pg_deflate_writer_make(PgWriter *inner, PgDeflateFormat format, u8 level,
+                       PgAllocator *allocator) {
+  PG_ASSERT(level < PG_STATIC_ARRAY_LEN(pg_deflate_levels));
+
+  PgDeflater *d = PG_NEW(PgDeflater, allocator);
+  d->inner = inner;
+  d->allocator = allocator;
+  d->format = format;
+  d->level = level;
+  d->match_len = PG_DEFLATE_MIN_MATCH - 1;
+  d->checksum = PG_DEFLATE_FORMAT_ZLIB == format ? 1 : 0;
+
+  if (PG_DEFLATE_FORMAT_ZLIB == format) {
+    // 32 KiB window, and the compression level in `FLEVEL`.
+    u32 cmf = 0x78;
+    u32 flevel = level < 2 ? 0 : level < 6 ? 1 : 6 == level ? 2 : 3;
+    u32 flg = flevel << 6;
+    flg += 31 - (cmf << 8 | flg) % 31;
+    u8 header[2] = {(u8)cmf, (u8)flg};
+    pg_deflate_put_bytes(d, header, sizeof(header));
+  } else if (PG_DEFLATE_FORMAT_GZIP == format) {
+    // No modification time, and the OS is unknown.
+    u8 xfl = 9 == level ? 2 : 1 == level ? 4 : 0;
+    u8 header[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, xfl, 255};
+    pg_deflate_put_bytes(d, header, sizeof(header));
   }
 
-  return 0;
+  PgWriter w = {0};
+  w.kind = PG_WRITER_KIND_DEFLATE;
+  w.u.deflate = d;
+  return w;
 }
 
-[[maybe_unused]] [[nodiscard]] PG_RESULT(PgDirectoryEntry, PgError)
-    pg_directory_read(PgDirectory *dir) {
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_deflate_write(PgWriter *w, PG_SLICE(u8) src, PgAllocator *allocator) {
+  PG_ASSERT(PG_WRITER_KIND_DEFLATE == w->kind);
+  (void)allocator;
+  PgDeflater *d = w->u.deflate;
+  PG_ASSERT(!d->finished);
 
-  // Need to set `errno` to 0 to detect EOF.
-  errno = 0;
+  if (d->err) {
+    return PG_ERR(d->err, u64, PgError);
+  }
 
-  struct dirent *entry = readdir(dir->dir);
-  if (!entry && 0 == errno) {
-    return PG_OK({}, PgDirectoryEntry, PgError); // EOF
+  if (sizeof(d->window) - sizeof(u64) == d->window_len) {
+    pg_deflate_slide(d);
   }
-  if (!entry) {
-    return PG_ERR(errno, PgDirectoryEntry, PgError);
+
+  PgString written = {
+      .data = src.data,
+      .len = PG_MIN(src.len,
+                    sizeof(d->window) - sizeof(u64) - d->window_len),
+  };
+  pg_memcpy(d->window + d->window_len, written.data, written.len);
+  d->window_len += (u32)written.len;
+  d->total_in += written.len;
+  if (PG_DEFLATE_FORMAT_ZLIB == d->format) {
+    d->checksum = pg_adler32_update(d->checksum, written);
+  } else if (PG_DEFLATE_FORMAT_GZIP == d->format) {
+    d->checksum = pg_crc32_update(d->checksum, written);
   }
 
-  return PG_OK(entry, PgDirectoryEntry, PgError);
-}
+  pg_deflate_tally(d, false);
 
-[[maybe_unused]] [[nodiscard]] static bool
-pg_dirent_is_file(PgDirectoryEntry dirent) {
-  return DT_REG == dirent->d_type;
+  if (d->err) {
+    return PG_ERR(d->err, u64, PgError);
+  }
+  return PG_OK(written.len, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static bool
-pg_dirent_is_directory(PgDirectoryEntry dirent) {
-  return DT_DIR == dirent->d_type;
-}
+// Compress and send everything written so far, followed by an empty stored
+// block, so that the peer can decompress it all ("sync flush"), then flush
+// `inner`. The stream goes on, still referring to the earlier data. Flushing
+// often hurts the compression ratio.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_deflate_writer_flush(PgWriter *w, PgAllocator *allocator) {
+  PG_ASSERT(PG_WRITER_KIND_DEFLATE == w->kind);
+  PgDeflater *d = w->u.deflate;
+  PG_ASSERT(!d->finished);
 
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_dirent_name(PgDirectoryEntry dirent) {
-  return pg_cstr_to_string(dirent->d_name);
+  PgError err = pg_writer_flush(w, allocator);
+  if (err) {
+    return err;
+  }
+
+  pg_deflate_tally(d, true);
+  if (d->syms_len > 0 || (i64)d->pos > d->block_start) {
+    pg_deflate_emit_block(d, false);
+  }
+  pg_deflate_put_stored(d, d->pos, 0, false);
+  pg_deflate_out_flush(d);
+  if (d->err) {
+    return d->err;
+  }
+
+  return pg_writer_flush(d->inner, allocator);
 }
 
+// Compress and send what is left, end the stream with its trailer, and flush
+// `inner`.
 [[maybe_unused]] [[nodiscard]] static PgError
-pg_aio_register_watch_directory(PgAio *aio, PgString name,
-                                PgWalkDirectoryOption options,
-                                PgAllocator *allocator) {
-  bool ignore_errors = options & PG_WALK_DIRECTORY_KIND_IGNORE_ERRORS;
-  bool recurse = options & PG_WALK_DIRECTORY_KIND_RECURSE;
+pg_deflate_writer_finish(PgWriter *w, PgAllocator *allocator) {
+  PG_ASSERT(PG_WRITER_KIND_DEFLATE == w->kind);
+  PgDeflater *d = w->u.deflate;
+  PG_ASSERT(!d->finished);
 
-  PgDirectory dir = PG_TRY_ERR(pg_directory_open(name));
+  PgError err = pg_writer_flush(w, allocator);
+  if (err) {
+    return err;
+  }
 
-  for (;;) {
-    PgDirectoryEntry dirent = PG_TRY_ERR(pg_directory_read(&dir));
-    if (!dirent) {
-      break; // EOF.
-    }
+  pg_deflate_tally(d, true);
+  pg_deflate_emit_block(d, true);
+  pg_deflate_align(d);
 
-    PgString name = pg_dirent_name(dirent);
+  if (PG_DEFLATE_FORMAT_ZLIB == d->format) {
+    u8 trailer[4] = {
+        (u8)(d->checksum >> 24),
+        (u8)(d->checksum >> 16),
+        (u8)(d->checksum >> 8),
+        (u8)d->checksum,
+    };
+    pg_deflate_put_bytes(d, trailer, sizeof(trailer));
+  } else if (PG_DEFLATE_FORMAT_GZIP == d->format) {
+    u32 size = (u32)d->total_in;
+    u8 trailer[8] = {
+        (u8)d->checksum,         (u8)(d->checksum >> 8),
+        (u8)(d->checksum >> 16), (u8)(d->checksum >> 24),
+        (u8)size,                (u8)(size >> 8),
+        (u8)(size >> 16),        (u8)(size >> 24),
+    };
+    pg_deflate_put_bytes(d, trailer, sizeof(trailer));
+  }
 
-    // Do not visit parent.
-    if (pg_bytes_eq(name, PG_S(".."))) {
-      continue;
-    }
+  pg_deflate_out_flush(d);
+  d->finished = true;
+  if (d->err) {
+    return d->err;
+  }
 
-    if (pg_dirent_is_file(dirent) && (PG_WALK_DIRECTORY_KIND_FILE & options)) {
-#if defined(PG_OS_LINUX)
-      if (0 == (PG_WALK_DIRECTORY_KIND_DIRECTORY & options))
-#endif
-      {
-        PG_RESULT(PgFileDescriptor, PgError)
-        res_fs = pg_aio_register_interest_fs_name(
-            aio, name,
-            PG_AIO_EVENT_KIND_FILE_MODIFIED | PG_AIO_EVENT_KIND_FILE_DELETED,
-            allocator);
-        if (PG_IS_ERR(res_fs) && !ignore_errors) {
-          return PG_UNWRAP_ERR(res_fs);
-        }
-      }
-    }
+  return pg_writer_flush(d->inner, allocator);
+}
 
-    if (pg_dirent_is_directory(dirent) &&
-        (PG_WALK_DIRECTORY_KIND_DIRECTORY & options)) {
-      PG_RESULT(PgFileDescriptor, PgError)
-      res_fs = pg_aio_register_interest_fs_name(
-          aio, name,
-          PG_AIO_EVENT_KIND_FILE_MODIFIED | PG_AIO_EVENT_KIND_FILE_DELETED |
-              PG_AIO_EVENT_KIND_FILE_CREATED,
-          allocator);
-      if (PG_IS_ERR(res_fs) && !ignore_errors) {
-        return PG_UNWRAP_ERR(res_fs);
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_net_ipv4_address_to_string(PgIpv4Address address, PgAllocator *allocator) {
+  PgWriter w = pg_writer_make_string_builder(3 * 4 + 4 + 5, allocator);
+
+  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, (address.ip >> 24) & 0xFF,
+                                               allocator));
+  PG_ASSERT(0 == pg_writer_write_u8(&w, '.', allocator));
+  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, (address.ip >> 16) & 0xFF,
+                                               allocator));
+  PG_ASSERT(0 == pg_writer_write_u8(&w, '.', allocator));
+  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, (address.ip >> 8) & 0xFF,
+                                               allocator));
+  PG_ASSERT(0 == pg_writer_write_u8(&w, '.', allocator));
+  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, (address.ip >> 0) & 0xFF,
+                                               allocator));
+  PG_ASSERT(0 == pg_writer_write_u8(&w, ':', allocator));
+  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, address.port, allocator));
+
+  return PG_DYN_TO_SLICE(PgString, w.u.bytes);
+}
+
+// Dotted decimal e.g. `127.0.0.1`, to host order.
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(u32)
+    pg_net_ipv4_parse(PgString s) {
+  u32 ip = 0;
+  for (u64 i = 0; i < 4; i++) {
+    if (i > 0) {
+      if (!pg_string_starts_with(s, PG_S("."))) {
+        return PG_NONE(u32);
       }
+      s = PG_SLICE_RANGE_START(s, 1);
     }
 
-    if (pg_dirent_is_directory(dirent) && recurse) {
-      PgError err =
-          pg_aio_register_watch_directory(aio, name, options, allocator);
-      if (0 != err && !ignore_errors) {
-        return err;
-      }
+    PgParseNumberResult res = pg_string_parse_u64(s, 10, true);
+    if (!res.present || res.n > UINT8_MAX || s.len - res.remaining.len > 3) {
+      return PG_NONE(u32);
     }
+    ip = (ip << 8) | (u32)res.n;
+    s = res.remaining;
   }
 
-  PG_ERR_RETURN(pg_directory_close(dir));
+  if (!pg_string_is_empty(s)) {
+    return PG_NONE(u32);
+  }
+  return PG_SOME(ip, u32);
+}
 
-  return 0;
+[[maybe_unused]] [[nodiscard]] static PgIpAddress
+pg_ip_address_from_ipv4(PgIpv4Address address) {
+  return (PgIpAddress){
+      .ipv4 = address.ip,
+      .port = address.port,
+      .family = PG_IP_FAMILY_V4,
+  };
 }
 
-[[maybe_unused]] [[nodiscard]] PgError pg_mtx_init(PgMutex *mutex,
-                                                   PgMutexKind type) {
-  pthread_mutexattr_t attr = {0};
-  i32 err = pthread_mutexattr_init(&attr);
-  if (err) {
-    return err;
+// Textual IPv6 address per RFC 4291 e.g. `::1` or `::ffff:1.2.3.4`, without
+// brackets nor zone.
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(PgIpAddress)
+    pg_net_ipv6_parse(PgString s) {
+  u16 head[8] = {0};
+  u64 head_len = 0;
+  u16 tail[8] = {0};
+  u64 tail_len = 0;
+  bool compressed = false;
+
+  if (pg_string_starts_with(s, PG_S("::"))) {
+    compressed = true;
+    s = PG_SLICE_RANGE_START(s, 2);
   }
 
-  if (PG_MUTEX_KIND_RECURSIVE == type) {
-    err = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
-    if (err) {
-      goto end;
+  while (!pg_string_is_empty(s)) {
+    u16 *groups = compressed ? tail : head;
+    u64 *groups_len = compressed ? &tail_len : &head_len;
+    if (head_len + tail_len >= 8) {
+      return PG_NONE(PgIpAddress);
+    }
+
+    // Trailing IPv4 address, worth two groups.
+    if (-1 == pg_string_index_of_rune(s, ':') &&
+        -1 != pg_string_index_of_rune(s, '.')) {
+      PG_OPTION(u32) ipv4 = pg_net_ipv4_parse(s);
+      if (!ipv4.has_value || head_len + tail_len + 2 > 8) {
+        return PG_NONE(PgIpAddress);
+      }
+      groups[(*groups_len)++] = (u16)(ipv4.value >> 16);
+      groups[(*groups_len)++] = (u16)ipv4.value;
+      s = (PgString){0};
+      break;
     }
-  }
 
-  err = pthread_mutex_init(mutex, &attr);
+    PgParseNumberResult res = pg_string_parse_u64(s, 16, false);
+    if (!res.present || s.len - res.remaining.len > 4) {
+      return PG_NONE(PgIpAddress);
+    }
+    groups[(*groups_len)++] = (u16)res.n;
+    s = res.remaining;
 
-end:
-  i32 fin_err = pthread_mutexattr_destroy(&attr);
-  if (fin_err) {
-    return err ? err : fin_err;
+    if (pg_string_starts_with(s, PG_S("::"))) {
+      if (compressed) {
+        return PG_NONE(PgIpAddress);
+      }
+      compressed = true;
+      s = PG_SLICE_RANGE_START(s, 2);
+    } else if (pg_string_starts_with(s, PG_S(":"))) {
+      s = PG_SLICE_RANGE_START(s, 1);
+      if (pg_string_is_empty(s)) {
+        return PG_NONE(PgIpAddress);
+      }
+    } else if (!pg_string_is_empty(s)) {
+      return PG_NONE(PgIpAddress);
+    }
   }
 
-  return (PgError)err;
-}
+  // `::` stands for at least one group.
+  if (compressed ? head_len + tail_len > 7 : head_len + tail_len != 8) {
+    return PG_NONE(PgIpAddress);
+  }
 
-[[maybe_unused]] void pg_mtx_destroy(PgMutex *mutex) {
-  pthread_mutex_destroy(mutex);
+  PgIpAddress res = {.family = PG_IP_FAMILY_V6};
+  for (u64 i = 0; i < head_len; i++) {
+    res.ipv6[2 * i] = (u8)(head[i] >> 8);
+    res.ipv6[2 * i + 1] = (u8)head[i];
+  }
+  for (u64 i = 0; i < tail_len; i++) {
+    u64 group = 8 - tail_len + i;
+    res.ipv6[2 * group] = (u8)(tail[i] >> 8);
+    res.ipv6[2 * group + 1] = (u8)tail[i];
+  }
+  return PG_SOME(res, PgIpAddress);
 }
 
-[[maybe_unused]] [[nodiscard]] PgError pg_mtx_lock(PgMutex *mutex) {
-  i32 ret = pthread_mutex_lock(mutex);
-  if (0 != ret) {
-    return (PgError)ret;
+// IPv4 or IPv6 textual address.
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(PgIpAddress)
+    pg_net_ip_parse(PgString s) {
+  PG_OPTION(u32) ipv4 = pg_net_ipv4_parse(s);
+  if (ipv4.has_value) {
+    PgIpAddress res = {.ipv4 = ipv4.value, .family = PG_IP_FAMILY_V4};
+    return PG_SOME(res, PgIpAddress);
   }
-
-  return 0;
+  return pg_net_ipv6_parse(s);
 }
 
-[[maybe_unused]] [[nodiscard]] PgError pg_mtx_trylock(PgMutex *mutex) {
-  i32 ret = pthread_mutex_trylock(mutex);
-  if (0 != ret) {
-    return (PgError)ret;
+// `1.2.3.4:80` or `[::1]:80`, with the canonical IPv6 text of RFC 5952: the
+// longest run of zero groups is elided.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_net_ip_address_to_string(PgIpAddress address, PgAllocator *allocator) {
+  if (PG_IP_FAMILY_V4 == address.family) {
+    return pg_net_ipv4_address_to_string(
+        (PgIpv4Address){.ip = address.ipv4, .port = address.port}, allocator);
   }
 
-  return 0;
-}
-
-#if 0
-// TODO
-[[maybe_unused]][[nodiscard]] PgError pg_mtx_timedlock(PgMutex *mutex, const struct timespec *time_point);
-#endif
+  u16 groups[8] = {0};
+  for (u64 i = 0; i < 8; i++) {
+    groups[i] =
+        (u16)((u16)address.ipv6[2 * i] << 8 | (u16)address.ipv6[2 * i + 1]);
+  }
 
-[[maybe_unused]] [[nodiscard]] PgError pg_mtx_unlock(PgMutex *mutex) {
-  i32 ret = pthread_mutex_unlock(mutex);
-  if (0 != ret) {
-    return (PgError)ret;
+  // A single zero group is not elided.
+  u64 zeroes_start = 0;
+  u64 zeroes_len = 1;
+  for (u64 i = 0; i < 8;) {
+    u64 len = 0;
+    for (; i + len < 8 && 0 == groups[i + len]; len++) {
+    }
+    if (len > zeroes_len) {
+      zeroes_start = i;
+      zeroes_len = len;
+    }
+    i += len > 0 ? len : 1;
   }
+  bool elide = zeroes_len > 1;
 
-  return 0;
-}
+  PgWriter w = pg_writer_make_string_builder(2 + 8 * 5 + 6, allocator);
+  PG_ASSERT(0 == pg_writer_write_u8(&w, '[', allocator));
+  for (u64 i = 0; i < 8; i++) {
+    if (elide && i == zeroes_start) {
+      PG_ASSERT(0 == pg_writer_write_full(&w, PG_S("::"), allocator));
+      i += zeroes_len - 1;
+      continue;
+    }
+    if (i > 0 && !(elide && i == zeroes_start + zeroes_len)) {
+      PG_ASSERT(0 == pg_writer_write_u8(&w, ':', allocator));
+    }
 
-[[maybe_unused]] [[nodiscard]] PgError pg_cnd_init(PgConditionVar *cond) {
-  i32 ret = pthread_cond_init(cond, nullptr);
-  if (0 != ret) {
-    return (PgError)ret;
+    bool leading = true;
+    for (i64 shift = 12; shift >= 0; shift -= 4) {
+      u8 nibble = (groups[i] >> shift) & 0xf;
+      if (leading && 0 == nibble && shift > 0) {
+        continue;
+      }
+      leading = false;
+      PG_ASSERT(0 == pg_writer_write_u8(&w, pg_u8_to_hex_rune(nibble),
+                                        allocator));
+    }
   }
+  PG_ASSERT(0 == pg_writer_write_full(&w, PG_S("]:"), allocator));
+  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, address.port, allocator));
 
-  return 0;
+  return PG_DYN_TO_SLICE(PgString, w.u.bytes);
 }
 
-[[maybe_unused]] void pg_cnd_destroy(PgConditionVar *cond) {
-  pthread_cond_destroy(cond);
-}
+// Reorder the addresses to alternate between families, starting with the
+// family of the first one, which is the preferred one, per RFC 8305.
+// The relative order within a family is kept.
+[[maybe_unused]] [[nodiscard]] static PG_SLICE(PgIpAddress)
+    pg_net_ip_addresses_interleave(PG_SLICE(PgIpAddress) addresses,
+                                   PgAllocator *allocator) {
+  PG_DYN(PgIpAddress) res = {0};
+  if (0 == addresses.len) {
+    return (PG_SLICE(PgIpAddress)){0};
+  }
+  PG_DYN_ENSURE_CAP(&res, addresses.len, allocator);
 
-[[maybe_unused]] [[nodiscard]] PgError pg_cnd_wait(PgConditionVar *cond,
-                                                   PgMutex *mutex) {
-  i32 ret = pthread_cond_wait(cond, mutex);
-  if (0 != ret) {
-    return (PgError)ret;
+  PgIpFamily family = PG_SLICE_AT(addresses, 0).family;
+  u64 next[2] = {0}; // Per family.
+  while (res.len < addresses.len) {
+    u64 *it = &next[family];
+    for (; *it < addresses.len &&
+           family != PG_SLICE_AT(addresses, *it).family;
+         (*it)++) {
+    }
+    if (*it < addresses.len) {
+      *PG_DYN_PUSH_WITHIN_CAPACITY(&res) = PG_SLICE_AT(addresses, *it);
+      (*it)++;
+    }
+    family = PG_IP_FAMILY_V4 == family ? PG_IP_FAMILY_V6 : PG_IP_FAMILY_V4;
   }
 
-  return 0;
+  return PG_DYN_TO_SLICE(PG_SLICE(PgIpAddress), res);
 }
 
-[[maybe_unused]] [[nodiscard]] PgError pg_cnd_broadcast(PgConditionVar *cond) {
-  i32 ret = pthread_cond_broadcast(cond);
-  if (0 != ret) {
-    return (PgError)ret;
-  }
+#define PG_DNS_HEADER_LEN 12
+#define PG_DNS_NAME_MAX_LEN 255 // Encoded.
+#define PG_DNS_UDP_MAX_LEN 512
+#define PG_DNS_TYPE_A 1
+#define PG_DNS_TYPE_CNAME 5
+#define PG_DNS_TYPE_SOA 6
+#define PG_DNS_CLASS_IN 1
+#define PG_DNS_RCODE_NXDOMAIN 3
 
-  return 0;
+[[nodiscard]] static u16 pg_dns_read_u16(PgString msg, u64 offset) {
+  return (u16)((u16)PG_SLICE_AT(msg, offset) << 8 |
+               (u16)PG_SLICE_AT(msg, offset + 1));
 }
 
-[[maybe_unused]] [[nodiscard]] PgError pg_cnd_signal(PgConditionVar *cond) {
-  i32 ret = pthread_cond_signal(cond);
-  if (0 != ret) {
-    return (PgError)ret;
-  }
+[[nodiscard]] static u32 pg_dns_read_u32(PgString msg, u64 offset) {
+  return (u32)pg_dns_read_u16(msg, offset) << 16 |
+         (u32)pg_dns_read_u16(msg, offset + 2);
+}
 
-  return 0;
+static void pg_dns_write_u16(PgString dst, u64 offset, u16 n) {
+  PG_SLICE_AT(dst, offset) = (u8)(n >> 8);
+  PG_SLICE_AT(dst, offset + 1) = (u8)n;
 }
 
-#if 0
-// TODO
-[[maybe_unused]][[nodiscard]]PgError pg_cnd_timedwait(PgConditionVar *cond, PgMutex *mutex, const struct timespec *time_point);
-#endif
+// `example.com` or `example.com.` to `\x07example\x03com\x00` at the start of
+// `dst`. Returns the encoded length.
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_dns_name_encode(PgString name, PgString dst) {
+  if (pg_string_ends_with(name, PG_S("."))) {
+    name = PG_SLICE_RANGE(name, 0, name.len - 1);
+  }
+  if (pg_string_is_empty(name) || name.len + 2 > PG_DNS_NAME_MAX_LEN ||
+      name.len + 2 > dst.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+  }
+  // Empty labels, which the split below would skip.
+  if (pg_string_starts_with(name, PG_S(".")) ||
+      -1 != pg_string_index_of_string(name, PG_S(".."))) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+  }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgThread, PgError)
-    pg_thread_create(PgThreadFn fn, void *fn_data) {
-  PgThread thread = {0};
+  u64 len = 0;
+  PgSplitIterator it = pg_string_split_string(name, PG_S("."));
+  for (;;) {
+    PG_OPTION(PgString) label = pg_string_split_next(&it);
+    if (!label.has_value) {
+      break;
+    }
+    if (pg_string_is_empty(label.value) || label.value.len > 63) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+    }
 
-  i32 ret = pthread_create(&thread, nullptr, (void *(*)(void *))fn, fn_data);
-  if (-1 == ret) {
-    return PG_ERR(errno, PgThread, PgError);
+    PG_SLICE_AT(dst, len) = (u8)label.value.len;
+    pg_memcpy(dst.data + len + 1, label.value.data, label.value.len);
+    len += 1 + label.value.len;
   }
+  PG_SLICE_AT(dst, len) = 0;
 
-  return PG_OK(thread, PgThread, PgError);
+  return PG_OK(len + 1, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] PgError pg_thread_join(PgThread thread) {
-  i32 ret = pthread_join(thread, nullptr);
-  if (-1 == ret) {
-    return (PgError)errno;
+// Query of the A records of `name`, with recursion desired, into `dst`.
+// Returns the length of the message.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_dns_query_encode(u16 id, PgString name, PgString dst) {
+  if (dst.len < PG_DNS_HEADER_LEN + 4) {
+    return PG_ERR(PG_ERR_TOO_BIG, u64, PgError);
   }
 
-  return 0;
-}
+  pg_dns_write_u16(dst, 0, id);
+  pg_dns_write_u16(dst, 2, 0x0100); // RD.
+  pg_dns_write_u16(dst, 4, 1);      // QDCOUNT.
+  pg_dns_write_u16(dst, 6, 0);      // ANCOUNT.
+  pg_dns_write_u16(dst, 8, 0);      // NSCOUNT.
+  pg_dns_write_u16(dst, 10, 0);     // ARCOUNT.
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_PAIR(PgFileDescriptor),
-                                                PgError)
-    pg_net_make_socket_pair(PgNetSocketDomain domain, PgNetSocketType type,
-                            PgNetSocketOption option) {
-  i32 unix_domain = 0;
-  switch (domain) {
-  case PG_NET_SOCKET_DOMAIN_LOCAL:
-    unix_domain = AF_LOCAL;
-    break;
-  case PG_NET_SOCKET_DOMAIN_IPV4:
-    unix_domain = AF_INET;
-    break;
-  case PG_NET_SOCKET_DOMAIN_IPV6:
-    unix_domain = AF_INET6;
-    break;
-  default:
-    PG_ASSERT(0);
-  }
+  PgString question = PG_SLICE_RANGE(dst, PG_DNS_HEADER_LEN, dst.len - 4);
+  u64 name_len = PG_TRY(pg_dns_name_encode(name, question), u64, PgError);
 
-  i32 unix_type = 0;
-  switch (type) {
-  case PG_NET_SOCKET_TYPE_TCP:
-    unix_type = SOCK_STREAM;
-    break;
-  case PG_NET_SOCKET_TYPE_UDP:
-    unix_type = SOCK_DGRAM;
-    break;
-  default:
-    PG_ASSERT(0);
-  }
+  u64 len = PG_DNS_HEADER_LEN + name_len;
+  pg_dns_write_u16(dst, len, PG_DNS_TYPE_A);
+  pg_dns_write_u16(dst, len + 2, PG_DNS_CLASS_IN);
+  return PG_OK(len + 4, u64, PgError);
+}
 
-  i32 unix_option = 0;
-  switch (option) {
-  case PG_NET_SOCKET_OPTION_NONE:
-  default:
-  }
+// Offset right after the name at `offset`, which may end with a compression
+// pointer.
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_dns_name_skip(PgString msg, u64 offset) {
+  for (u64 i = 0; i < PG_DNS_NAME_MAX_LEN; i++) {
+    if (offset >= msg.len) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+    }
 
-  i32 fds[2] = {0};
-  i32 ret = socketpair(unix_domain, unix_type, unix_option, fds);
-  if (-1 == ret) {
-    return PG_ERR(errno, PG_PAIR(PgFileDescriptor), PgError);
+    u8 len = PG_SLICE_AT(msg, offset);
+    if (0 == len) {
+      return PG_OK(offset + 1, u64, PgError);
+    }
+    if (0xc0 == (len & 0xc0)) { // Pointer.
+      if (offset + 2 > msg.len) {
+        return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+      }
+      return PG_OK(offset + 2, u64, PgError);
+    }
+    if (len > 63) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+    }
+    offset += 1 + len;
   }
-
-  PG_PAIR(PgFileDescriptor) pair = {.first.fd = fds[0], .second.fd = fds[1]};
-  return PG_OK(pair, PG_PAIR(PgFileDescriptor), PgError);
+  return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_PAIR(PgFileDescriptor),
-                                                PgError) pg_pipe_make() {
-  int fds[2] = {0};
-  int ret = pipe(fds);
-  if (-1 == ret) {
-    return PG_ERR(errno, PG_PAIR(PgFileDescriptor), PgError);
+// Addresses of the answer to the query `id` of the A records of `name`.
+// Answers to other queries are rejected: they may be late or forged.
+// The addresses of a CNAME chain are included, with the lowest TTL of the
+// chain. A negative answer has the TTL of its SOA record, per RFC 2308.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgDnsAnswer, PgError)
+    pg_dns_response_parse(PgString msg, u16 id, PgString name,
+                          PgAllocator *allocator) {
+  if (msg.len < PG_DNS_HEADER_LEN) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgDnsAnswer, PgError);
   }
 
-  PG_PAIR(PgFileDescriptor)
-  pair = {.first.fd = fds[PG_PIPE_READ], .second.fd = fds[PG_PIPE_WRITE]};
-  return PG_OK(pair, PG_PAIR(PgFileDescriptor), PgError);
-}
-
-[[nodiscard]] static PgError pg_process_avoid_child_zombies() {
-  struct sigaction handler = {.sa_handler = SIG_IGN};
-  int ret = sigaction(SIGCHLD, &handler, nullptr);
-  if (-1 == ret) {
-    return (PgError)errno;
+  u16 flags = pg_dns_read_u16(msg, 2);
+  bool is_response = flags & 0x8000;
+  if (id != pg_dns_read_u16(msg, 0) || !is_response ||
+      1 != pg_dns_read_u16(msg, 4)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgDnsAnswer, PgError);
   }
+  u16 answer_count = pg_dns_read_u16(msg, 6);
+  u16 authority_count = pg_dns_read_u16(msg, 8);
 
-  return 0;
-}
+  // Question.
+  u64 offset = PG_DNS_HEADER_LEN;
+  {
+    u8 expected_data[PG_DNS_NAME_MAX_LEN] = {0};
+    PgString expected = {.data = expected_data, .len = sizeof(expected_data)};
+    expected.len =
+        PG_TRY(pg_dns_name_encode(name, expected), PgDnsAnswer, PgError);
+    if (offset + expected.len + 4 > msg.len ||
+        !pg_string_ieq_ascii(PG_SLICE_RANGE(msg, offset, offset + expected.len),
+                             expected) ||
+        PG_DNS_TYPE_A != pg_dns_read_u16(msg, offset + expected.len) ||
+        PG_DNS_CLASS_IN != pg_dns_read_u16(msg, offset + expected.len + 2)) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgDnsAnswer, PgError);
+    }
+    offset += expected.len + 4;
+  }
+
+  PgDnsAnswer res = {.rcode = flags & 0xf};
+  u64 ttl_min = UINT32_MAX;
+
+  for (u64 i = 0; i < (u64)answer_count + authority_count; i++) {
+    offset = PG_TRY(pg_dns_name_skip(msg, offset), PgDnsAnswer, PgError);
+    if (offset + 10 > msg.len) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgDnsAnswer, PgError);
+    }
+    u16 type = pg_dns_read_u16(msg, offset);
+    u16 class = pg_dns_read_u16(msg, offset + 2);
+    u32 ttl = pg_dns_read_u32(msg, offset + 4);
+    u16 rdata_len = pg_dns_read_u16(msg, offset + 8);
+    offset += 10;
+    if (offset + rdata_len > msg.len) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgDnsAnswer, PgError);
+    }
+    PgString rdata = PG_SLICE_RANGE(msg, offset, offset + rdata_len);
+    offset += rdata_len;
+
+    if (PG_DNS_CLASS_IN != class) {
+      continue;
+    }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u32, PgError) pg_process_dup() {
-  i32 pid = fork();
+    bool is_answer = i < answer_count;
+    if (is_answer && PG_DNS_TYPE_A == type && 4 == rdata.len) {
+      PG_DYN_PUSH(&res.addresses, pg_dns_read_u32(rdata, 0), allocator);
+      ttl_min = PG_MIN(ttl_min, ttl);
+    } else if (is_answer && PG_DNS_TYPE_CNAME == type) {
+      ttl_min = PG_MIN(ttl_min, ttl);
+    } else if (!is_answer && PG_DNS_TYPE_SOA == type &&
+               0 == res.addresses.len) {
+      // MNAME, RNAME, SERIAL, REFRESH, RETRY, EXPIRE, MINIMUM.
+      u64 rdata_offset =
+          PG_TRY(pg_dns_name_skip(rdata, 0), PgDnsAnswer, PgError);
+      rdata_offset =
+          PG_TRY(pg_dns_name_skip(rdata, rdata_offset), PgDnsAnswer, PgError);
+      if (rdata_offset + 20 != rdata.len) {
+        return PG_ERR(PG_ERR_INVALID_VALUE, PgDnsAnswer, PgError);
+      }
+      u32 minimum = pg_dns_read_u32(rdata, rdata_offset + 16);
+      res.ttl_s = PG_MIN(ttl, minimum);
+      res.ttl_present = true;
+    }
+  }
 
-  if (-1 == pid) {
-    return PG_ERR(errno, u32, PgError);
+  if (res.addresses.len > 0) {
+    res.ttl_s = ttl_min;
+    res.ttl_present = true;
   }
 
-  return PG_OK((u32)pid, u32, PgError);
+  return PG_OK(res, PgDnsAnswer, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_net_socket_set_timeout(PgFileDescriptor sock, u64 seconds,
-                          u64 microseconds) {
-  struct timeval timeout = {0};
-  timeout.tv_sec = (time_t)seconds;
-  timeout.tv_usec = (i32)microseconds;
-
-  i32 ret =
-      setsockopt(sock.fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
-  if (-1 == ret) {
-    return (PgError)errno;
-  }
-  return 0;
-}
+// First IPv4 `nameserver` of the content of `/etc/resolv.conf`.
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(u32)
+    pg_dns_resolv_conf_nameserver(PgString content) {
+  PgSplitIterator it = pg_string_split_string(content, PG_S("\n"));
+  for (;;) {
+    PG_OPTION(PgString) line = pg_string_split_next(&it);
+    if (!line.has_value) {
+      return PG_NONE(u32);
+    }
 
-[[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
-    pg_net_create_tcp_socket() {
-  i32 sock_fd = 0;
-  do {
-    sock_fd = socket(AF_INET, SOCK_STREAM, 0);
-  } while (-1 == sock_fd && EINTR == errno);
+    PgString rest = pg_string_trim_space(line.value);
+    if (!pg_string_starts_with(rest, PG_S("nameserver"))) {
+      continue;
+    }
+    rest = pg_string_trim_space(
+        PG_SLICE_RANGE_START(rest, PG_S("nameserver").len));
 
-  if (-1 == sock_fd) {
-    return PG_ERR(errno, PgFileDescriptor, PgError);
+    PG_OPTION(u32) ip = pg_net_ipv4_parse(rest);
+    if (ip.has_value) {
+      return ip;
+    }
   }
-
-  PgFileDescriptor fd = {.fd = sock_fd};
-  return PG_OK(fd, PgFileDescriptor, PgError);
 }
 
-[[nodiscard]]
-static PgError pg_net_socket_close(PgFileDescriptor sock) {
-  return pg_file_close(sock);
+[[maybe_unused]] [[nodiscard]] static u32 pg_u8x4_be_to_u32(PgString s) {
+  PG_ASSERT(4 == s.len);
+  return (u32)(PG_SLICE_AT(s, 0) << 24) | (u32)(PG_SLICE_AT(s, 1) << 16) |
+         (u32)(PG_SLICE_AT(s, 2) << 8) | (u32)(PG_SLICE_AT(s, 3) << 0);
 }
 
-[[nodiscard]]
-static PgError pg_net_set_nodelay(PgFileDescriptor sock, bool enabled) {
-  int opt = enabled;
-  int ret = 0;
-  do {
-    ret = setsockopt(sock.fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
-  } while (-1 == ret && EINTR == errno);
+[[nodiscard]] static bool pg_bitfield_get_ptr(u8 *bitfield, u64 bitfield_len,
+                                              u64 idx_bit) {
+  PG_ASSERT(idx_bit < bitfield_len * 8);
 
-  if (-1 == ret) {
-    return (PgError)errno;
-  }
+  u64 idx_byte = idx_bit / 8;
 
-  return 0;
+  return PG_C_ARRAY_AT(bitfield, bitfield_len, idx_byte) & (1 << (idx_bit % 8));
 }
 
-[[nodiscard]]
-static PgError pg_net_connect_ipv4(PgFileDescriptor sock,
-                                   PgIpv4Address address) {
-  struct sockaddr_in addr = {
-      .sin_family = AF_INET,
-      .sin_port = htons(address.port),
-      .sin_addr = {htonl(address.ip)},
-  };
+[[maybe_unused]] [[nodiscard]] static bool pg_bitfield_get(PgString bitfield,
+                                                           u64 idx_bit) {
+  return pg_bitfield_get_ptr(bitfield.data, bitfield.len, idx_bit);
+}
 
-  int ret = 0;
-  do {
-    ret = connect(sock.fd, (struct sockaddr *)&addr, sizeof(addr));
-  } while (-1 == ret && EINTR == errno);
+static void pg_bitfield_set_ptr(u8 *bitfield, u64 bitfield_len, u64 idx_bit,
+                                bool val) {
+  PG_ASSERT(idx_bit < bitfield_len * 8);
 
-  if (-1 == ret) {
-    if (EINPROGRESS != errno) {
-      return (PgError)errno;
-    }
+  u64 idx_byte = idx_bit / 8;
+
+  u8 *ptr = PG_C_ARRAY_AT_PTR(bitfield, bitfield_len, idx_byte);
+  if (val) {
+    *ptr |= 1 << (idx_bit % 8);
+  } else {
+    *ptr &= ~(1 << (idx_bit % 8));
   }
 
-  return 0;
+  PG_ASSERT(val == pg_bitfield_get_ptr(bitfield, bitfield_len, idx_bit));
 }
 
-[[maybe_unused]] [[nodiscard]]
-static PG_RESULT(PgIpv4AddressSocket, PgError)
-    pg_net_dns_resolve_ipv4_tcp(PgString host, u16 port,
-                                PgAllocator *allocator) {
-  PG_RESULT(PgIpv4AddressSocket, PgError) res = {0};
-
-  struct addrinfo hints = {0};
-  hints.ai_socktype = SOCK_STREAM;
-  hints.ai_protocol = IPPROTO_TCP;
+[[maybe_unused]] static void pg_bitfield_set(PgString bitfield, u64 idx_bit,
+                                             bool val) {
+  pg_bitfield_set_ptr(bitfield.data, bitfield.len, idx_bit, val);
+}
 
-  struct addrinfo *addr_info = nullptr;
-  int res_getaddrinfo = 0;
-  do {
-    res_getaddrinfo = getaddrinfo(
-        pg_string_to_cstr(host, allocator),
-        pg_string_to_cstr(pg_u64_to_string(port, allocator), allocator), &hints,
-        &addr_info);
-  } while (-1 == res_getaddrinfo && EINTR == errno);
+[[maybe_unused]] [[nodiscard]] static u64 pg_bitfield_count(PgString bitfield) {
+  u64 res = 0;
+  PG_EACH_PTR(c, &bitfield) { res += (u8)__builtin_popcount(*c); }
+  return res;
+}
 
-  if (-1 == res_getaddrinfo) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgIpv4AddressSocket, PgError);
-  }
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(u64)
+    pg_bitfield_get_first_zero(PgString bitfield) {
+  PG_OPTION(u64) res = {0};
 
-  struct addrinfo *rp = nullptr;
-  for (rp = addr_info; rp != nullptr; rp = rp->ai_next) {
-    PG_RESULT(PgFileDescriptor, PgError)
-    res_create_socket = pg_net_create_tcp_socket();
-    if (PG_IS_ERR(res_create_socket)) {
-      res = PG_ERR(PG_UNWRAP_ERR(res_create_socket), PgIpv4AddressSocket,
-                   PgError);
+  PG_EACH_PTR(c, &bitfield) {
+    if (0xff == *c) {
       continue;
     }
 
-    PgFileDescriptor socket = PG_UNWRAP(res_create_socket);
-
-    // TODO: Use pg_net_connect_ipv4?
-    int ret = 0;
-    do {
-      ret = connect(socket.fd, rp->ai_addr, rp->ai_addrlen);
-    } while (-1 == ret && EINTR == errno);
-
-    if (-1 == ret) {
-      if (EINPROGRESS != errno) {
-        (void)pg_net_socket_close(socket);
-        continue;
+    u64 bit_idx = 0;
+    u8 bit_pattern = 1;
+    for (u64 j = 0; j < 8; j++) {
+      if (0 == (*c & bit_pattern)) {
+        bit_idx = j;
+        break;
       }
+      bit_pattern <<= 1;
     }
+    PG_ASSERT(bit_idx < 8);
+    PG_ASSERT(bit_idx > 0);
 
-    PgIpv4AddressSocket addr_socket = {
-        .socket = socket,
-        .address.ip =
-            ntohl(((struct sockaddr_in *)(void *)rp->ai_addr)->sin_addr.s_addr),
-        .address.port = port,
-    };
-    res = PG_OK(addr_socket, PgIpv4AddressSocket, PgError);
-    break;
+    res.value = PG_SLICE_PTR_TO_INDEX(c, bitfield) * 8 + (bit_idx - 1);
+    res.has_value = true;
+    return res;
   }
+  return res;
+}
 
-  freeaddrinfo(addr_info);
-
-  if (nullptr == rp) { // No address succeeded.
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgIpv4AddressSocket, PgError);
+[[maybe_unused]] [[nodiscard]] static PgAdjacencyMatrix
+pg_adjacency_matrix_make(u64 nodes_count, PgAllocator *allocator) {
+  PgAdjacencyMatrix res = {0};
+  if (0 == nodes_count) {
+    return res;
   }
 
+  res.nodes_count = nodes_count;
+  res.bitfield_len = nodes_count * (nodes_count - 1) / 2;
+  res.bitfield = pg_string_make(res.bitfield_len, allocator);
   return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_net_socket_write(PgFileDescriptor sock, PgString data) {
-  i64 n = 0;
-  do {
-    n = send(sock.fd, data.data, data.len, MSG_NOSIGNAL);
-  } while (-1 == n && EINTR == errno);
+[[nodiscard]] static u64
+pg_adjacency_matrix_row_column_to_bitfield_index(PgAdjacencyMatrix matrix,
+                                                 u64 row, u64 col) {
+  PG_ASSERT(row > 0);
+  PG_ASSERT(col < matrix.nodes_count - 1);
+  PG_ASSERT(row >= col);
 
-  if (n < 0) {
-    return PG_ERR(errno, u64, PgError);
-  }
+  u64 idx = (row * (row - 1)) / 2 + col;
+  PG_ASSERT(idx < matrix.bitfield_len);
+  return idx;
+}
 
-  return PG_OK((u64)n, u64, PgError);
+[[maybe_unused]] [[nodiscard]] static bool
+pg_adjacency_matrix_has_edge(PgAdjacencyMatrix matrix, u64 row, u64 col) {
+  u64 idx = pg_adjacency_matrix_row_column_to_bitfield_index(matrix, row, col);
+  return pg_bitfield_get(matrix.bitfield, idx);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_net_socket_read(PgFileDescriptor sock, PgString data) {
-  i64 n = 0;
-  do {
-    n = recv(sock.fd, data.data, data.len, 0);
-  } while (-1 == n && EINTR == errno);
+[[maybe_unused]] [[nodiscard]] static PgAdjacencyMatrix
+pg_adjacency_matrix_clone(PgAdjacencyMatrix matrix, PgAllocator *allocator) {
+  PgAdjacencyMatrix res = {0};
+  res.nodes_count = matrix.nodes_count;
+  res.bitfield_len = matrix.bitfield_len;
+  res.bitfield = pg_string_clone(matrix.bitfield, allocator);
+  return res;
+}
 
-  if (n < 0) {
-    return PG_ERR(errno, u64, PgError);
-  }
+[[maybe_unused]]
+static void pg_adjacency_matrix_add_edge(PgAdjacencyMatrix *matrix, u64 row,
+                                         u64 col) {
+  PG_ASSERT(row < matrix->nodes_count);
+  PG_ASSERT(col < matrix->nodes_count);
 
-  return PG_OK((u64)n, u64, PgError);
+  u64 idx = pg_adjacency_matrix_row_column_to_bitfield_index(*matrix, row, col);
+
+  pg_bitfield_set(matrix->bitfield, idx, 1);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_net_tcp_listen(PgFileDescriptor sock, u64 backlog) {
-  PG_ASSERT(backlog <= INT32_MAX);
+static void pg_adjacency_matrix_remove_edge(PgAdjacencyMatrix *matrix, u64 row,
+                                            u64 col) {
+  PG_ASSERT(row < matrix->nodes_count);
+  PG_ASSERT(col < matrix->nodes_count);
 
-  int ret = 0;
-  do {
-    ret = listen(sock.fd, (int)backlog);
-  } while (-1 == ret && EINTR == errno);
+  u64 idx = pg_adjacency_matrix_row_column_to_bitfield_index(*matrix, row, col);
 
-  if (-1 == ret) {
-    return (PgError)errno;
-  }
+  pg_bitfield_set(matrix->bitfield, idx, 0);
+}
 
-  return 0;
+[[maybe_unused]] [[nodiscard]]
+static PgAdjacencyMatrixNeighborIterator
+pg_adjacency_matrix_make_neighbor_iterator(PgAdjacencyMatrix matrix, u64 node) {
+  PgAdjacencyMatrixNeighborIterator it = {0};
+  it.matrix = matrix;
+  it.row = node;
+  return it;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_net_tcp_bind_ipv4(PgFileDescriptor sock, PgIpv4Address addr) {
-  struct sockaddr_in addrin = {0};
-  addrin.sin_family = AF_INET;
-  addrin.sin_port = htons(addr.port);
-  addrin.sin_addr.s_addr = htonl(addr.ip);
+[[maybe_unused]] [[nodiscard]]
+static PgAdjacencyMatrixNeighbor pg_adjacency_matrix_neighbor_iterator_next(
+    PgAdjacencyMatrixNeighborIterator *it) {
+  PG_ASSERT(it);
+  PG_ASSERT(it->row <= it->matrix.nodes_count);
+  PG_ASSERT(it->col <= it->matrix.nodes_count);
 
-  int ret = 0;
-  do {
-    ret = bind(sock.fd, (struct sockaddr *)&addrin, sizeof(addrin));
-  } while (-1 == ret && EINTR == errno);
+  PgAdjacencyMatrixNeighbor res = {0};
+  if (it->row >= it->matrix.nodes_count || it->col >= it->matrix.nodes_count ||
+      it->col > it->row) { // The end.
+    return res;
+  }
 
-  if (-1 == ret) {
-    return (PgError)errno;
+  if (!it->scan_mode_column) { // Scan row.
+
+    for (; it->col < it->row; it->col++) {
+      res.edge = pg_adjacency_matrix_has_edge(it->matrix, it->row, it->col);
+      if (res.edge) {
+        res.has_value = true;
+        res.col = it->col;
+        res.row = it->row;
+        res.node = it->col;
+        PG_ASSERT(res.col != res.row);
+
+        it->col += 1;
+        return res;
+      }
+    }
+    if (it->col == it->row) { // Skip diagonal.
+      it->row += 1;
+      it->scan_mode_column = true;
+    }
   }
 
-  return 0;
-}
+  if (it->scan_mode_column) { // Scan column.
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_net_get_socket_error(PgFileDescriptor sock) {
-  int socket_error = -1;
-  socklen_t len = sizeof(socket_error);
-  int ret = 0;
-  do {
-    ret = getsockopt(sock.fd, SOL_SOCKET, SO_ERROR, &socket_error, &len);
-  } while (-1 == ret && EINTR == errno);
+    for (; it->row < it->matrix.nodes_count; it->row++) {
+      res.edge = pg_adjacency_matrix_has_edge(it->matrix, it->row, it->col);
+      if (res.edge) {
+        res.has_value = true;
+        res.col = it->col;
+        res.row = it->row;
+        res.node = it->row;
+        PG_ASSERT(res.col != res.row);
 
-  if (-1 == ret) {
-    return (PgError)errno;
+        it->row += 1;
+        return res;
+      }
+    }
   }
-  return (PgError)socket_error;
+  return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_net_socket_enable_reuse(PgFileDescriptor sock) {
-  int val = 1;
-  int ret = 0;
-  do {
-    ret = setsockopt(sock.fd, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val));
-  } while (-1 == ret && EINTR == errno);
+[[maybe_unused]]
+static void pg_adjacency_matrix_remove_node(PgAdjacencyMatrix *matrix,
+                                            u64 node) {
+  u64 row = node;
+  PG_ASSERT(row < matrix->nodes_count);
 
-  if (-1 == ret) {
-    return (PgError)errno;
-  }
+  PgAdjacencyMatrixNeighborIterator it =
+      pg_adjacency_matrix_make_neighbor_iterator(*matrix, node);
 
+  PgAdjacencyMatrixNeighbor neighbor = {0};
   do {
-    ret = setsockopt(sock.fd, SOL_SOCKET, SO_REUSEPORT, &val, sizeof(val));
-  } while (-1 == ret && EINTR == errno);
-
-  if (-1 == ret) {
-    return (PgError)errno;
-  }
+    neighbor = pg_adjacency_matrix_neighbor_iterator_next(&it);
+    if (!neighbor.has_value) {
+      break;
+    }
 
-  return 0;
+    pg_adjacency_matrix_remove_edge(matrix, neighbor.row, neighbor.col);
+  } while (neighbor.has_value);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgIpv4AddressAcceptResult
-pg_net_tcp_accept(PgFileDescriptor sock) {
-  PgIpv4AddressAcceptResult res = {0};
+[[maybe_unused]] [[nodiscard]]
+static bool pg_adjacency_matrix_is_empty(PgAdjacencyMatrix matrix) {
+  bool set = false;
+  PG_EACH_PTR(it, &matrix.bitfield) { set |= *it; }
+  return set == 0;
+}
 
-  struct sockaddr_in sockaddrin = {0};
-  socklen_t sockaddrin_len = sizeof(sockaddrin);
-  int sock_client = 0;
-  do {
-    sock_client =
-        accept(sock.fd, (struct sockaddr *)&sockaddrin, &sockaddrin_len);
-  } while (-1 == sock_client && EINTR == errno);
+[[maybe_unused]] [[nodiscard]]
+static u64 pg_adjacency_matrix_count_neighbors(PgAdjacencyMatrix matrix,
+                                               u64 node) {
+  PG_ASSERT(node < matrix.nodes_count);
 
-  if (-1 == sock_client) {
-    res.err = (PgError)errno;
-    return res;
-  }
+  u64 res = 0;
+  PgAdjacencyMatrixNeighborIterator it =
+      pg_adjacency_matrix_make_neighbor_iterator(matrix, node);
 
-  res.socket.fd = sock_client;
-  res.address.port = ntohs(sockaddrin.sin_port);
-  res.address.ip = ntohl(sockaddrin.sin_addr.s_addr);
+  PgAdjacencyMatrixNeighbor neighbor = {0};
+  do {
+    neighbor = pg_adjacency_matrix_neighbor_iterator_next(&it);
+    res += neighbor.edge;
+    PG_ASSERT(res + 1 <= matrix.nodes_count);
+  } while (neighbor.has_value);
 
   return res;
 }
 
 [[maybe_unused]] [[nodiscard]] static PgError
-pg_file_rewind_start(PgFileDescriptor f) {
-  off_t ret = lseek(f.fd, 0, SEEK_SET);
-  if (-1 == ret) {
-    return (PgError)errno;
-  }
-  return 0;
-}
-
-// TODO: Review in the context of multiple threads spawning and reaping
-// processes.
-[[maybe_unused]] [[nodiscard]]
-static PG_RESULT(PgProcess, PgError)
-    pg_process_spawn(PgString path, PG_SLICE(PgString) args,
-                     PgProcessSpawnOptions options, PgAllocator *allocator) {
-  PG_RESULT(PgProcess, PgError) res = {0};
-
-  char *path_c = (char *)pg_string_to_cstr(path, allocator);
-
-  PG_DYN(PgCstr) args_c = {0};
-  PG_DYN_ENSURE_CAP(&args_c, args.len + 2, allocator);
-  PG_DYN_PUSH(&args_c, path_c, allocator);
+pg_adjacency_matrix_print(PgAdjacencyMatrix matrix, PgWriter *w,
+                          PgAllocator *allocator) {
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("    | "), allocator));
 
-  PG_EACH_PTR(arg, &args) {
-    PG_DYN_PUSH(&args_c, pg_string_to_cstr(*arg, allocator), allocator);
+  for (u64 col = 0; col < matrix.nodes_count; col++) {
+    PG_ERR_RETURN(pg_writer_write_u64_as_string(w, col, allocator));
   }
-  PG_ASSERT(args.len + 1 == args_c.len);
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
 
-  int stdin_pipe[2] = {0};
-  {
-    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stdin_capture) {
-      int ret = pipe(stdin_pipe);
-      if (-1 == ret) {
-        res = PG_ERR(errno, PgProcess, PgError);
-        goto end;
-      }
-    }
+  for (u64 col = 0; col < matrix.nodes_count; col++) {
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("-----"), allocator));
   }
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
 
-  int stdout_pipe[2] = {0};
-  {
-    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stdout_capture) {
-      int ret = pipe(stdout_pipe);
-      if (-1 == ret) {
-        res = PG_ERR(errno, PgProcess, PgError);
-        goto end;
+  for (u64 row = 0; row < matrix.nodes_count; row++) {
+    PG_ERR_RETURN(pg_writer_write_u64_as_string(w, row, allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" | "), allocator));
+    for (u64 col = 0; col < matrix.nodes_count; col++) {
+      if (col >= row) {
+        PG_ERR_RETURN(pg_writer_write_full(w, PG_S("  "), allocator));
+        continue;
       }
-    }
-  }
 
-  int stderr_pipe[2] = {0};
-  {
-    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stderr_capture) {
-      int ret = pipe(stderr_pipe);
-      if (-1 == ret) {
-        res = PG_ERR(errno, PgProcess, PgError);
-        goto end;
-      }
+      bool edge = pg_adjacency_matrix_has_edge(matrix, row, col);
+      PG_ERR_RETURN(
+          pg_writer_write_full(w, edge ? PG_S("1") : PG_S("0"), allocator));
     }
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
   }
+  return (PgError){0};
+}
 
-  int pid = fork();
-
-  if (-1 == pid) {
-    res = PG_ERR(errno, PgProcess, PgError);
-    goto end;
-  }
-
-  if (0 == pid) { // Child.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_time_ns_now(PgClockKind clock_kind);
 
-    bool need_ignore =
-        (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stdin_capture) ||
-        (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stdout_capture) ||
-        (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stderr_capture);
+// From https://nullprogram.com/blog/2017/09/21/.
+// PCG.
+[[maybe_unused]] [[nodiscard]] static u32
+pg_rand_u32_min_incl_max_incl(PgRng *rng, u32 min_incl, u32 max_incl) {
+  PG_ASSERT(rng);
+  PG_ASSERT(min_incl <= max_incl);
 
-    int fd_ignore = 0;
-    if (need_ignore) {
-      fd_ignore = open("/dev/null", O_RDWR, 0);
-      PG_ASSERT(-1 != fd_ignore);
-    }
+  u64 m = 0x9b60933458e17d7d;
+  u64 a = 0xd737232eeccdf7ed;
+  rng->state = rng->state * m + a;
+  int shift = 29 - (rng->state >> 61);
+  u32 rand = (u32)(rng->state >> shift);
 
-    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stdin_capture) {
-      close(stdin_pipe[PG_PIPE_WRITE]);
-      int ret_dup2 = dup2(stdin_pipe[PG_PIPE_READ], STDIN_FILENO);
-      PG_ASSERT(-1 != ret_dup2);
-    } else if (PG_CHILD_PROCESS_STD_IO_CLOSE == options.stdin_capture) {
-      close(STDIN_FILENO);
-    } else if (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stdin_capture) {
-      int ret_dup2 = dup2(fd_ignore, STDIN_FILENO);
-      PG_ASSERT(-1 != ret_dup2);
-    }
+  u32 res = min_incl + (u32)((f32)rand * ((f32)max_incl - (f32)min_incl) /
+                             (f32)UINT32_MAX);
+  PG_ASSERT(min_incl <= res);
+  PG_ASSERT(res <= max_incl);
+  return res;
+}
 
-    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stdout_capture) {
-      close(stdout_pipe[PG_PIPE_READ]);
-      int ret_dup2 = dup2(stdout_pipe[PG_PIPE_WRITE], STDOUT_FILENO);
-      PG_ASSERT(-1 != ret_dup2);
-    } else if (PG_CHILD_PROCESS_STD_IO_CLOSE == options.stdout_capture) {
-      close(STDOUT_FILENO);
-    } else if (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stdout_capture) {
-      int ret_dup2 = dup2(fd_ignore, STDOUT_FILENO);
-      PG_ASSERT(-1 != ret_dup2);
-    }
+[[maybe_unused]] [[nodiscard]] static u32
+pg_rand_u32_min_incl_max_excl(PgRng *rng, u32 min_incl, u32 max_excl) {
+  PG_ASSERT(max_excl > 0);
+  return pg_rand_u32_min_incl_max_incl(rng, min_incl, max_excl - 1);
+}
 
-    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stderr_capture) {
-      close(stderr_pipe[PG_PIPE_READ]);
-      int ret_dup2 = dup2(stderr_pipe[PG_PIPE_WRITE], STDERR_FILENO);
-      PG_ASSERT(-1 != ret_dup2);
-    } else if (PG_CHILD_PROCESS_STD_IO_CLOSE == options.stderr_capture) {
-      close(STDERR_FILENO);
-    } else if (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stderr_capture) {
-      int ret_dup2 = dup2(fd_ignore, STDERR_FILENO);
-      PG_ASSERT(-1 != ret_dup2);
-    }
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_rand_string(PgRng *rng, u64 len, PgAllocator *allocator) {
+  PgString res = pg_string_make(len, allocator);
 
-    if (-1 == execvp(path_c, args_c.data)) {
-      // Not easy to give the error back to the caller here.
-      // Maybe with a separate pipe?
-      PG_ASSERT(0);
-    }
-    PG_ASSERT(0 && "unreachable");
+  for (u64 i = 0; i < res.len; i++) {
+    *PG_C_ARRAY_AT_PTR(res.data, res.len, i) =
+        (u8)pg_rand_u32_min_incl_max_incl(rng, 0, UINT8_MAX);
   }
+  return res;
+}
 
-  PG_ASSERT(pid > 0); // Parent.
-  PgProcess process = {0};
-  process.pid = (u64)pid;
-  process.stdin_pipe.fd = stdin_pipe[PG_PIPE_WRITE];
-  process.stdout_pipe.fd = stdout_pipe[PG_PIPE_READ];
-  process.stderr_pipe.fd = stderr_pipe[PG_PIPE_READ];
-  res = PG_OK(process, PgProcess, PgError);
-
-end:
-  PG_EACH_PTR(arg_c, &args_c) { pg_free(allocator, *arg_c); }
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(u32)
+    pg_bitfield_get_first_zero_rand(PgString bitfield, u32 len, PgRng *rng) {
+  PG_ASSERT(len <= bitfield.len);
 
-  if (stdin_pipe[PG_PIPE_READ]) {
-    close(stdin_pipe[PG_PIPE_READ]);
-  }
-  if (stdout_pipe[PG_PIPE_WRITE]) {
-    close(stdout_pipe[PG_PIPE_WRITE]);
-  }
-  if (stderr_pipe[PG_PIPE_WRITE]) {
-    close(stderr_pipe[PG_PIPE_WRITE]);
-  }
+  PG_OPTION(u32) res = {0};
 
-  if (PG_IS_ERR(res)) {
-    if (stdin_pipe[PG_PIPE_WRITE]) {
-      close(stdin_pipe[PG_PIPE_WRITE]);
-    }
-    if (stdout_pipe[PG_PIPE_READ]) {
-      close(stdout_pipe[PG_PIPE_READ]);
-    }
-    if (stderr_pipe[PG_PIPE_READ]) {
-      close(stderr_pipe[PG_PIPE_READ]);
+  u32 start = pg_rand_u32_min_incl_max_excl(rng, 0, len);
+  for (u64 i = 0; i < len; i++) {
+    u32 idx = (start + i) % len;
+    if (pg_bitfield_get(bitfield, idx)) {
+      continue;
     }
+    res.value = idx;
+    res.has_value = true;
+    return res;
   }
-
   return res;
 }
 
-// TODO: Review in the context of multiple threads spawning and reaping
-// processes.
-[[maybe_unused]] [[nodiscard]]
-static PG_RESULT(PgProcessCaptureStd, PgError)
-    pg_process_capture_std_io(PgProcess process, u64 stdio_size_hint,
-                              u64 stderr_size_hint, PgAllocator *allocator) {
-  PG_RESULT(PgProcessCaptureStd, PgError) res = {0};
+[[maybe_unused]] [[nodiscard]] static PgRng pg_rand_make() {
+  PgRng rng = {0};
+  // Rely on ASLR.
+  PG_RESULT(u64, PgError) now = pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC);
+  u64 value = PG_UNWRAP(now);
+  rng.state = (u64)(&pg_rand_make) ^ value;
 
-  PG_DYN(u8) stdout_sb = {0};
-  PG_DYN(u8) stderr_sb = {0};
+  return rng;
+}
 
-  if (process.stdout_pipe.fd) {
-    stdout_sb = pg_string_builder_make(
-        stdio_size_hint == 0 ? 4096 : stdio_size_hint, allocator);
-  }
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_close(PgFileDescriptor file);
 
-  if (process.stderr_pipe.fd) {
-    stderr_sb = pg_string_builder_make(
-        stderr_size_hint == 0 ? 4096 : stderr_size_hint, allocator);
-  }
+[[nodiscard]] static u64 pg_os_get_page_size();
 
-  while (process.stdout_pipe.fd || process.stderr_pipe.fd) {
-    struct pollfd pollfds[2] = {0};
-    nfds_t pollfds_len = 0;
+[[maybe_unused]] [[nodiscard]] static u64 pg_os_get_cpu_count();
 
-    if (process.stdout_pipe.fd) {
-      pollfds[pollfds_len++] = (struct pollfd){
-          .fd = process.stdout_pipe.fd,
-          .events = POLLIN,
-      };
-    }
+[[nodiscard]] i32 pg_os_get_last_error();
+[[nodiscard]] PG_RESULT(PgVoidPtr, PgError)
+    pg_virtual_mem_alloc(u64 size, PgVirtualMemFlags flags);
+[[nodiscard]] PgError pg_virtual_mem_protect(void *ptr, u64 size,
+                                             PgVirtualMemFlags flags_new);
+[[nodiscard]] PgError pg_virtual_mem_release(void *ptr, u64 size);
 
-    if (process.stderr_pipe.fd) {
-      pollfds[pollfds_len++] = (struct pollfd){
-          .fd = process.stderr_pipe.fd,
-          .events = POLLIN,
-      };
-    }
+[[nodiscard]] i32 pg_virtual_mem_flags_to_os_flags(PgVirtualMemFlags flags);
 
-    int res_poll = poll(pollfds, pollfds_len, -1);
-    if (-1 == res_poll) {
-      res = PG_ERR(errno, PgProcessCaptureStd, PgError);
-      goto end;
-    }
+[[maybe_unused]] [[nodiscard]] static PgArena
+pg_arena_make_from_virtual_mem(u64 size) {
+  if (0 == size) {
+    return (PgArena){0};
+  }
 
-    if (0 == res_poll) {
-      break;
-    }
+  u64 page_size = pg_os_get_page_size();
+  PG_ASSERT(0 != page_size);
+  PG_ASSERT(0 == (page_size % 2));
 
-    for (u64 i = 0; i < (u64)res_poll; i++) {
-      struct pollfd pollfd = PG_C_ARRAY_AT(pollfds, pollfds_len, i);
+  u64 size_rounded_up_to_page_size = pg_round_up_multiple_of(size, page_size);
+  PG_ASSERT(0 == size_rounded_up_to_page_size % page_size);
 
-      PgFileDescriptor *fd = &process.stdout_pipe;
-      PG_DYN(u8) *sb = &stdout_sb;
-      if (pollfd.fd == process.stderr_pipe.fd) {
-        fd = &process.stderr_pipe;
-        sb = &stderr_sb;
-      }
+  u64 os_alloc_size = size_rounded_up_to_page_size;
+  // Page guard before.
+  PG_ASSERT(false == ckd_add(&os_alloc_size, os_alloc_size, page_size));
+  // Page guard after.
+  PG_ASSERT(false == ckd_add(&os_alloc_size, os_alloc_size, page_size));
 
-      if (pollfd.revents & (POLLERR | POLLNVAL)) {
-        close(pollfd.fd);
-        fd->fd = 0;
-        continue;
-      }
+  PG_RESULT(PgVoidPtr, PgError)
+  res_alloc = pg_virtual_mem_alloc(
+      os_alloc_size, PG_VIRTUAL_MEM_FLAGS_READ | PG_VIRTUAL_MEM_FLAGS_WRITE);
+  u8 *alloc = PG_UNWRAP(res_alloc);
+  PG_ASSERT(nullptr != alloc);
 
-      // Not sure why/how it could happen?
-      if (0 == (pollfd.revents & (POLLIN | POLLHUP))) {
-        close(pollfd.fd);
-        fd->fd = 0;
-        continue;
-      }
+  u64 page_guard_before = (u64)alloc;
 
-      u8 tmp[4096] = {0};
-      ssize_t read_n = read(pollfd.fd, tmp, PG_STATIC_ARRAY_LEN(tmp));
-      if (-1 == read_n) {
-        res = PG_ERR(errno, PgProcessCaptureStd, PgError);
-        goto end;
-      }
-      if (0 == read_n) {
-        close(pollfd.fd);
-        fd->fd = 0;
-        continue;
-      }
+  PG_ASSERT(false == ckd_add((u64 *)&alloc, (u64)alloc, page_size));
+  PG_ASSERT(page_guard_before + page_size == (u64)alloc);
 
-      PgString actually_read = {.data = tmp, .len = (u64)read_n};
-      PG_DYN_APPEND_SLICE(sb, actually_read, allocator);
-    }
-  }
+  u64 page_guard_after = (u64)0;
+  PG_ASSERT(false == ckd_add(&page_guard_after, (u64)alloc,
+                             size_rounded_up_to_page_size));
+  PG_ASSERT((u64)alloc + size_rounded_up_to_page_size == page_guard_after);
+  PG_ASSERT(page_guard_before + page_size + size_rounded_up_to_page_size ==
+            page_guard_after);
 
-end:
-  if (PG_IS_ERR(res)) {
-    pg_free(allocator, stdout_sb.data);
-    pg_free(allocator, stderr_sb.data);
-  }
+  PG_ASSERT(0 == pg_virtual_mem_protect((void *)page_guard_before, page_size,
+                                        PG_VIRTUAL_MEM_FLAGS_NONE));
 
-  if (process.stdin_pipe.fd) {
-    close(process.stdin_pipe.fd);
-  }
-  if (process.stdout_pipe.fd) {
-    close(process.stdout_pipe.fd);
-  }
-  if (process.stderr_pipe.fd) {
-    close(process.stderr_pipe.fd);
-  }
+  PG_ASSERT(0 == pg_virtual_mem_protect((void *)page_guard_after, page_size,
+                                        PG_VIRTUAL_MEM_FLAGS_NONE));
 
-  PgProcessCaptureStd capture = {0};
-  capture.stdout_captured = PG_DYN_TO_SLICE(PgString, stdout_sb);
-  capture.stderr_captured = PG_DYN_TO_SLICE(PgString, stderr_sb);
-  return PG_OK(capture, PgProcessCaptureStd, PgError);
+  PG_ASSERT(os_alloc_size >= 2 * page_size);
+  return (PgArena){
+      .start_original = alloc,
+      .start = alloc,
+      .end = (u8 *)alloc + size,
+      .os_start = (u8 *)page_guard_before,
+      .os_alloc_size = os_alloc_size,
+  };
 }
 
-[[maybe_unused]] [[nodiscard]]
-static PG_RESULT(PgProcessStatus, PgError)
-    pg_process_wait(PgProcess process, u64 stdio_size_hint,
-                    u64 stderr_size_hint, PgAllocator *allocator) {
-  PG_RESULT(PgProcessCaptureStd, PgError)
-  res_capture = pg_process_capture_std_io(process, stdio_size_hint,
-                                          stderr_size_hint, allocator);
-  PG_IF_LET_ERR(err, res_capture) {
-    return PG_ERR(err, PgProcessStatus, PgError);
+[[maybe_unused]] [[nodiscard]] static PgError pg_arena_release(PgArena *arena) {
+  if (nullptr == arena->start) {
+    return 0;
   }
 
-  int status = 0;
-  int ret = 0;
-  do {
-    ret = waitpid((pid_t)process.pid, &status, 0);
-  } while (-1 == ret && EINTR == errno);
-
-  if (-1 == ret) {
-    return PG_ERR(errno, PgProcessStatus, PgError);
-  }
+  PG_ASSERT(nullptr != arena->end);
+  PG_ASSERT(nullptr != arena->os_start);
 
-  PgProcessCaptureStd capture = PG_UNWRAP(res_capture);
+  return pg_virtual_mem_release(arena->os_start, arena->os_alloc_size);
+}
 
-  PgProcessStatus res = {0};
-  res.exit_status = WEXITSTATUS(status);
-  res.exited = WIFEXITED(status);
-  res.signaled = WIFSIGNALED(status);
-  res.signal = WTERMSIG(status);
-  res.core_dumped = WCOREDUMP(status);
-  res.stopped = WIFSTOPPED(status);
-  res.stdout_captured = capture.stdout_captured;
-  res.stderr_captured = capture.stderr_captured;
+[[maybe_unused]] [[nodiscard]] static PgArenaTemp
+pg_arena_temp_begin(PgArena *arena) {
+  PG_ASSERT(arena);
 
-  return PG_OK(res, PgProcessStatus, PgError);
+  return (PgArenaTemp){
+      .arena = arena,
+      .start = arena->start,
+      .allocator = pg_make_arena_allocator(arena),
+  };
 }
 
-[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stdin() {
-  return (PgFileDescriptor){.fd = STDIN_FILENO};
-}
-[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stdout() {
-  return (PgFileDescriptor){.fd = STDOUT_FILENO};
+[[maybe_unused]] static void pg_arena_temp_end(PgArenaTemp temp) {
+  PG_ASSERT(temp.arena);
+  PG_ASSERT(temp.arena->start_original <= temp.start);
+  PG_ASSERT(temp.start <= temp.arena->start);
+
+  temp.arena->start = temp.start;
 }
-[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stderr() {
-  return (PgFileDescriptor){.fd = STDERR_FILENO};
+
+[[maybe_unused]] [[nodiscard]] static PgAllocator *
+pg_arena_temp_allocator(PgArenaTemp *temp) {
+  return pg_arena_allocator_as_allocator(&temp->allocator);
 }
 
-[[nodiscard]] i32 pg_os_get_last_error() { return errno; }
+// Per-thread scratch arenas for temporary allocations, lazily created.
+// There are two so that a function can always pick one that is not the arena
+// its caller wants the result in: the temporaries never overwrite the output.
+#define PG_SCRATCH_ARENAS_COUNT 2
 
-[[nodiscard]] i32 pg_virtual_mem_flags_to_os_flags(PgVirtualMemFlags flags) {
-  u64 res = 0;
-  if (flags & PG_VIRTUAL_MEM_FLAGS_READ) {
-    res |= PROT_READ;
-  }
-  if (flags & PG_VIRTUAL_MEM_FLAGS_WRITE) {
-    res |= PROT_WRITE;
-  }
-  if (flags & PG_VIRTUAL_MEM_FLAGS_EXEC) {
-    res |= PROT_EXEC;
-  }
-  return (i32)res;
-}
+#ifndef PG_SCRATCH_ARENA_SIZE
+// Only reserved: pages get committed on first use.
+#define PG_SCRATCH_ARENA_SIZE (64 * PG_MiB)
+#endif
 
-[[nodiscard]] PG_RESULT(PgVoidPtr, PgError)
-    pg_virtual_mem_alloc(u64 size, PgVirtualMemFlags flags) {
-  PG_ASSERT(size > 0);
+static _Thread_local PgArena pg_scratch_arenas[PG_SCRATCH_ARENAS_COUNT];
+
+// `conflict`: the allocator the result of the caller is allocated with, if any.
+// Usage:
+//
+// ```
+// PgArenaTemp scratch = pg_scratch_begin(allocator);
+// PgAllocator *scratch_allocator = pg_arena_temp_allocator(&scratch);
+// ...
+// pg_scratch_end(scratch);
+// ```
+[[maybe_unused]] [[nodiscard]] static PgArenaTemp
+pg_scratch_begin(PgAllocator *conflict) {
+  PgArena *conflict_arena = nullptr;
+  if (conflict && pg_alloc_arena == conflict->alloc_fn) {
+    conflict_arena = ((PgArenaAllocator *)conflict)->arena;
+  }
+
+  for (u64 i = 0; i < PG_SCRATCH_ARENAS_COUNT; i++) {
+    PgArena *arena = &pg_scratch_arenas[i];
+    if (arena == conflict_arena) {
+      continue;
+    }
 
-  PgVoidPtr ret = mmap(nullptr, size, pg_virtual_mem_flags_to_os_flags(flags),
-                       MAP_ANON | MAP_PRIVATE, -1, 0);
-  if ((void *)-1 == ret) {
-    return PG_ERR(errno, PgVoidPtr, PgError);
+    if (nullptr == arena->start) {
+      *arena = pg_arena_make_from_virtual_mem(PG_SCRATCH_ARENA_SIZE);
+    }
+    return pg_arena_temp_begin(arena);
   }
+  PG_ASSERT(0 && "unreachable");
+}
 
-  return PG_OK(ret, PgVoidPtr, PgError);
+[[maybe_unused]] static void pg_scratch_end(PgArenaTemp scratch) {
+  pg_arena_temp_end(scratch);
 }
 
-[[nodiscard]] PG_RESULT(PgVirtualMemFile, PgError)
-    pg_virtual_mem_map_file(PgString path, PgFileAccess access,
-                            bool create_if_not_exists) {
-  PgError err = 0;
+// To call at a boundary where no scratch allocation is live anymore e.g. at
+// the end of a request, in case some code forgot to call `pg_scratch_end`.
+[[maybe_unused]] static void pg_scratch_reset() {
+  for (u64 i = 0; i < PG_SCRATCH_ARENAS_COUNT; i++) {
+    PgArena *arena = &pg_scratch_arenas[i];
+    arena->start = arena->start_original;
+  }
+}
 
-  PG_RESULT(PgFileDescriptor, PgError)
-  res_fd = pg_file_open(path, access, 0600, create_if_not_exists, nullptr);
-  PG_IF_LET_ERR(err, res_fd) { return PG_ERR(err, PgVirtualMemFile, PgError); }
-  PgFileDescriptor fd = PG_UNWRAP(res_fd);
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(Pgu64Range)
+    pg_u64_range_search(PG_SLICE(u64) haystack, u64 needle) {
+  PG_OPTION(Pgu64Range) res = {0};
 
-  PG_RESULT(u64, PgError) res_size = pg_file_size(fd);
-  PG_IF_LET_ERR(_err, res_size) {
-    err = _err;
-    goto end;
+  if (0 == haystack.len) {
+    return res;
   }
-  u64 size = PG_UNWRAP(res_size);
 
-  i32 prot = 0;
-  switch (access) {
-  case PG_FILE_ACCESS_READ:
-    prot = PROT_READ;
-    break;
-  case PG_FILE_ACCESS_WRITE:
-    prot = PROT_WRITE;
-    break;
-  case PG_FILE_ACCESS_READ_WRITE:
-    prot = PROT_READ | PROT_WRITE;
-    break;
-  case PG_FILE_ACCESS_NONE:
-    break;
-  default:
-    PG_ASSERT(0);
-  }
+  for (u64 i = 1; i < haystack.len; i++) {
+    u64 elem = PG_SLICE_AT(haystack, i);
+    if (needle < elem) {
+      res.has_value = true;
+      res.value.idx = i - 1;
+      res.value.start_incl = PG_SLICE_AT(haystack, i - 1);
+      res.value.end_excl = elem;
 
-  u8 *mem = mmap(nullptr, size, prot, MAP_PRIVATE, fd.fd, 0);
-  if ((void *)-1 == mem) {
-    err = errno;
-    goto end;
+      PG_ASSERT(res.value.start_incl <= needle);
+      PG_ASSERT(needle < res.value.end_excl);
+      return res;
+    }
   }
 
-  PgVirtualMemFile res = {.data = {.data = mem, .len = size}};
+  return res;
+}
 
-end:
-  (void)pg_file_close(fd);
-  return err ? PG_ERR(err, PgVirtualMemFile, PgError)
-             : PG_OK(res, PgVirtualMemFile, PgError);
+// TODO: Trim separators in `a` and `b`?
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_path_join(PgString a, PgString b, PgAllocator *allocator) {
+  PgString sep = PG_S(PG_PATH_SEPARATOR_S);
+
+  PG_DYN(u8) sb = pg_string_builder_make(a.len + sep.len + b.len, allocator);
+
+  PG_DYN_APPEND_SLICE_WITHIN_CAPACITY(&sb, a);
+  PG_DYN_APPEND_SLICE_WITHIN_CAPACITY(&sb, sep);
+  PG_DYN_APPEND_SLICE_WITHIN_CAPACITY(&sb, b);
+
+  return PG_DYN_TO_SLICE(PgString, sb);
 }
 
-[[nodiscard]] PgError pg_virtual_mem_protect(void *ptr, u64 size,
-                                             PgVirtualMemFlags flags_new) {
-  if (-1 == mprotect(ptr, size, pg_virtual_mem_flags_to_os_flags(flags_new))) {
-    return (PgError)pg_os_get_last_error();
+[[maybe_unused]] [[nodiscard]] static PgString pg_path_base_name(PgString s) {
+  i64 idx = pg_string_last_index_of_rune(s, PG_PATH_SEPARATOR);
+  if (-1 == idx) {
+    return s;
+  } else {
+    return PG_SLICE_RANGE_START(s, (u64)idx + 1);
   }
-  return 0;
 }
 
-[[nodiscard]] PgError pg_virtual_mem_release(void *ptr, u64 size) {
-  if (-1 == munmap(ptr, size)) {
-    return (PgError)pg_os_get_last_error();
+[[maybe_unused]] [[nodiscard]] static PgString pg_path_dir_name(PgString s) {
+  i64 idx = pg_string_last_index_of_rune(s, PG_PATH_SEPARATOR);
+  if (-1 == idx) {
+    return s;
+  } else {
+    return PG_SLICE_RANGE(s, 0, (u64)idx);
   }
-  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static clockid_t
-pg_clock_to_linux(PgClockKind clock_kind) {
-  switch (clock_kind) {
-  case PG_CLOCK_KIND_MONOTONIC:
-    return CLOCK_MONOTONIC;
-  case PG_CLOCK_KIND_REALTIME:
-    return CLOCK_REALTIME;
-  default:
-    PG_ASSERT(0);
+[[maybe_unused]] [[nodiscard]] static PgString pg_path_stem(PgString s) {
+  i64 idx = pg_string_last_index_of_rune(s, '.');
+  if (-1 == idx) {
+    return s;
   }
-}
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_time_ns_now(PgClockKind clock) {
-  struct timespec ts = {0};
-  int ret = 0;
-  do {
-    ret = clock_gettime(pg_clock_to_linux(clock), &ts);
-  } while (-1 == ret && EINTR == errno);
+  return PG_SLICE_RANGE(s, 0, (u64)idx);
+}
 
-  if (-1 == ret) {
-    return PG_ERR(errno, u64, PgError);
+[[maybe_unused]] [[nodiscard]] static PgString pg_file_stem(PgString s) {
+  PgString base_name = pg_path_base_name(s);
+  i64 idx = pg_string_last_index_of_rune(base_name, '.');
+  if (-1 == idx) {
+    return base_name;
   }
 
-  u64 res = (u64)ts.tv_sec * PG_Seconds + (u64)ts.tv_nsec;
-
-  return PG_OK(res, u64, PgError);
+  return PG_SLICE_RANGE(base_name, 0, (u64)idx);
 }
 
-[[maybe_unused]] static u64
-pg_fill_stack_trace(u64 skip, u64 pie_offset,
-                    u64 stack_trace[PG_STACK_TRACE_MAX]) {
-  u64 *frame_pointer = __builtin_frame_address(0);
-  u64 res = 0;
-
-  while (res < PG_STACK_TRACE_MAX && frame_pointer != 0) {
-    u64 instruction_pointer = *(frame_pointer + 1);
-    // Careful not to enter an infinite recursion of `PG_ASSERT ->
-    // pg_fill_stack_trace`.
-    PG_ASSERT_TRAP_ONLY(instruction_pointer >= pie_offset);
-
-    // FIXME: If the current function is inlined, do not walk up the stack.
-    frame_pointer = (u64 *)*frame_pointer;
-
-    if (0 == skip) {
-      stack_trace[res++] = (instruction_pointer)-pie_offset;
-    } else {
-      skip--;
-    }
+[[maybe_unused]] [[nodiscard]] static PgString pg_file_extension(PgString s) {
+  PgString base_name = pg_path_base_name(s);
+  i64 idx = pg_string_last_index_of_rune(base_name, '.');
+  if (-1 == idx) {
+    return PG_S("");
   }
 
-  return res;
+  return PG_SLICE_RANGE_START(base_name, (u64)idx + 1);
 }
 
-[[nodiscard]] static u64 pg_os_get_page_size() {
-  i64 ret = 0;
-  do {
-    ret = sysconf(_SC_PAGE_SIZE);
-  } while (-1 == ret && EINTR == errno);
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_string_concat(PgString left, PgString right, PgAllocator *allocator) {
+  PgString res = pg_string_make(left.len + right.len, allocator);
+  PG_ASSERT(res.data);
 
-  PG_ASSERT(ret > 0);
+  pg_memmove(res.data, left.data, left.len);
+  pg_memmove(res.data + left.len, right.data, right.len);
 
-  return (u64)ret;
+  return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_file_read(PgFileDescriptor file, PgString buf) {
-  isize n = 0;
-  do {
-    n = read(file.fd, buf.data, buf.len);
-  } while (-1 == n && EINTR == errno);
+[[maybe_unused]] [[nodiscard]] static PgWriter
+pg_writer_make_from_file_descriptor(PgFileDescriptor file, u64 buffer_size,
+                                    PgAllocator *allocator) {
+  PgWriter w = {0};
+  w.kind = PG_WRITER_KIND_FILE;
+  w.u.file = file;
 
-  if (-1 == n) {
-    return PG_ERR(errno, u64, PgError);
+  if (buffer_size) {
+    w.ring = pg_ring_make(buffer_size, allocator);
   }
 
-  return PG_OK((u64)n, u64, PgError);
+  return w;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_file_write(PgFileDescriptor file, PgString s) {
-  isize n = 0;
-  do {
-    n = write(file.fd, s.data, s.len);
-  } while (-1 == n && EINTR == errno);
-
-  if (-1 == n) {
-    return PG_ERR(errno, u64, PgError);
-  }
-
-  return PG_OK((u64)n, u64, PgError);
+[[maybe_unused]] [[nodiscard]] static PgWriter pg_writer_make_noop() {
+  PgWriter w = {0};
+  return w;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_file_truncate(PgFileDescriptor file, u64 size) {
-  if (-1 == ftruncate(file.fd, (i64)size)) {
-    return (PgError)pg_os_get_last_error();
-  }
-  return 0;
-}
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
+    pg_file_read_full_from_descriptor(PgFileDescriptor file, u64 size,
+                                      PgAllocator *allocator) {
+  PgError err = {0};
+  PG_DYN(u8) sb = {0};
+  PG_DYN_ENSURE_CAP(&sb, size, allocator);
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_file_read_at(PgFileDescriptor file, PgString buf, u64 offset) {
-  isize n = 0;
-  do {
-    n = pread(file.fd, buf.data, buf.len, (off_t)offset);
-  } while (-1 == n && EINTR == errno);
+  for (u64 lim = 0; lim < size; lim++) {
+    if (size == sb.len) {
+      break;
+    }
 
-  if (-1 == n) {
-    return PG_ERR(errno, u64, PgError);
-  }
+    PgString space = {.data = sb.data + sb.len, .len = sb.cap - sb.len};
+    PG_RESULT(u64, PgError) res_read = pg_file_read(file, space);
+    if (PG_IS_ERR(res_read)) {
+      err = (PgError)pg_os_get_last_error();
+      goto end;
+    }
 
-  return PG_OK((u64)n, u64, PgError);
-}
+    u64 read_n = PG_UNWRAP(res_read);
+    if (0 == read_n) {
+      err = PG_ERR_INVALID_VALUE;
+      goto end;
+    }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
-    pg_file_open(PgString path, PgFileAccess access, u64 mode,
-                 bool create_if_not_exists, PgAllocator *) {
-  if (path.len > PG_PATH_MAX - 1) {
-    return PG_ERR(errno, PgFileDescriptor, PgError);
-  }
+    PG_ASSERT((u64)read_n <= space.len);
 
-  int flags = 0;
-  switch (access & PG_FILE_ACCESS_ALL) {
-  case PG_FILE_ACCESS_READ:
-    flags = O_RDONLY;
-    break;
-  case PG_FILE_ACCESS_WRITE:
-    flags = O_WRONLY | O_TRUNC;
-    break;
-  case PG_FILE_ACCESS_READ_WRITE:
-    flags = O_RDWR;
-    break;
-  case PG_FILE_ACCESS_NONE:
-  default:
-    PG_ASSERT(0);
+    sb.len += (u64)read_n;
   }
 
-  if (create_if_not_exists) {
-    flags |= O_CREAT;
+end:
+  if (err && sb.data) {
+    pg_free(allocator, sb.data);
+    return PG_ERR(err, PgString, PgError);
   }
 
-  u8 path_c[PG_PATH_MAX] = {0};
-  pg_memcpy(path_c, path.data, path.len);
+  return PG_OK(PG_DYN_TO_SLICE(PgString, sb), PgString, PgError);
+}
 
-  int fd = open((char *)path_c, flags, mode ? mode : 0600);
-  if (-1 == fd) {
-    return PG_ERR(errno, PgFileDescriptor, PgError);
-  }
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
+    pg_file_read_full_from_descriptor_until_eof(PgFileDescriptor file,
+                                                u64 size_hint,
+                                                PgAllocator *allocator) {
+  PgError err = 0;
 
-  PgFileDescriptor res = {.fd = fd};
-  return PG_OK(res, PgFileDescriptor, PgError);
-}
+  PG_DYN(u8) sb = {0};
+  PG_DYN_ENSURE_CAP(&sb, size_hint, allocator);
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_file_close(PgFileDescriptor file) {
-  if (-1 == close(file.fd)) {
-    return (PgError)pg_os_get_last_error();
-  }
+  for (;;) {
+    PG_DYN_ENSURE_CAP(&sb, sb.len + 4096, allocator);
+    PgString space = {.data = sb.data + sb.len, .len = sb.cap - sb.len};
+    PG_ASSERT(space.len);
 
-  return 0;
-}
+    PG_RESULT(u64, PgError) res_read = pg_file_read(file, space);
+    if (PG_IS_ERR(res_read)) {
+      err = (PgError)pg_os_get_last_error();
+      goto end;
+    }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_file_size(PgFileDescriptor file) {
-  struct stat st = {0};
+    u64 read_n = PG_UNWRAP(res_read);
+    if (0 == read_n) {
+      goto end;
+    }
 
-  int ret = 0;
-  do {
-    ret = fstat(file.fd, &st);
-  } while (-1 == ret && EINTR == errno);
+    PG_ASSERT((u64)read_n <= space.len);
 
-  if (-1 == ret) {
-    return PG_ERR(errno, u64, PgError);
+    sb.len += (u64)read_n;
   }
 
-  return PG_OK(st.st_size, u64, PgError);
-}
-
-[[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_net_socket_read_non_blocking(PgFileDescriptor socket, PgString dst) {
-  i64 ret = recv(socket.fd, dst.data, dst.len, MSG_DONTWAIT);
-  if (-1 == ret) {
-    return PG_ERR(errno, u64, PgError);
+end:
+  if (err && sb.data) {
+    pg_free(allocator, sb.data);
+    return PG_ERR(err, PgString, PgError);
   }
 
-  return PG_OK((u64)ret, u64, PgError);
+  return PG_OK(PG_DYN_TO_SLICE(PgString, sb), PgString, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_fd_set_blocking(PgFileDescriptor fd, bool block) {
-  i32 ret = 0;
-  do {
-    ret = fcntl(fd.fd, F_GETFL, O_NONBLOCK);
-  } while (-1 == ret && EINTR == errno);
-  if (-1 == ret) {
-    return (PgError)errno;
+[[maybe_unused]] [[nodiscard]] static PgReader
+pg_reader_make_from_file(PgFileDescriptor file, u64 buffer_size,
+                         PgAllocator *allocator) {
+  PgReader r = {0};
+  r.kind = PG_READER_KIND_FILE;
+  r.u.file = file;
+  if (buffer_size) {
+    r.ring = pg_ring_make(buffer_size, allocator);
   }
+  return r;
+}
 
-  i32 flags = ret;
-  if (block) {
-    flags &= ~O_NONBLOCK;
-  } else {
-    flags |= O_NONBLOCK;
+[[maybe_unused]] [[nodiscard]] static PgReader
+pg_reader_make_from_socket(PgFileDescriptor file, u64 buffer_size,
+                           PgAllocator *allocator) {
+  PgReader r = {0};
+  r.kind = PG_READER_KIND_SOCKET;
+  r.u.file = file;
+  if (buffer_size) {
+    r.ring = pg_ring_make(buffer_size, allocator);
   }
+  return r;
+}
 
-  do {
-    ret = fcntl(fd.fd, F_SETFL, flags);
-  } while (-1 == ret && EINTR == errno);
-  if (-1 == ret) {
-    return (PgError)errno;
-  }
+[[maybe_unused]] [[nodiscard]] static PgReader
+pg_reader_make_from_bytes(PG_SLICE(u8) bytes) {
+  PgReader r = {0};
+  r.kind = PG_READER_KIND_BYTES;
+  r.u.bytes = bytes;
+  return r;
+}
 
-  return 0;
+[[maybe_unused]] [[nodiscard]] static PgWriter
+pg_writer_make_from_socket(PgFileDescriptor file, u64 buffer_size,
+                           PgAllocator *allocator) {
+  PgWriter w = {0};
+  w.kind = PG_WRITER_KIND_SOCKET;
+  w.u.file = file;
+  if (buffer_size) {
+    w.ring = pg_ring_make(buffer_size, allocator);
+  }
+  return w;
 }
 
-#elif PG_OS_WINDOWS
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_write_full_with_descriptor(PgFileDescriptor file,
+                                   PG_SLICE(u8) content) {
+  PgError err = 0;
+  PgString remaining = content;
+  for (u64 lim = 0; lim < content.len; lim++) {
+    if (pg_string_is_empty(remaining)) {
+      break;
+    }
 
-// -- Win32 ---
+    PG_RESULT(u64, PgError) res_write = pg_file_write(file, remaining);
+    if (PG_IS_ERR(res_write)) {
+      err = (PgError)pg_os_get_last_error();
+      goto end;
+    }
 
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
+    u64 write_n = PG_UNWRAP(res_write);
+    if (0 == write_n) {
+      err = PG_ERR_INVALID_VALUE;
+      goto end;
+    }
 
-#include <io.h>
-#include <windows.h>
+    remaining = PG_SLICE_RANGE_START(remaining, write_n);
+  }
 
-[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stdin() {
-  return (PgFileDescriptor){.ptr = GetStdHandle(STD_INPUT_HANDLE)};
-}
-[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stdout() {
-  return (PgFileDescriptor){.ptr = GetStdHandle(STD_OUTPUT_HANDLE)};
-}
-[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stderr() {
-  return (PgFileDescriptor){.ptr = GetStdHandle(STD_ERROR_HANDLE)};
+end:
+  return err;
 }
 
-typedef struct {
-  wchar_t *data;
-  u64 len;
-} PgWtf16String;
-
-PG_RESULT_DECL(PgWtf16String, PgError) PgWtf16StringResult;
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
+    pg_file_read_full_from_path(PgString path, PgAllocator *allocator) {
+  PG_RESULT(PgString, PgError) res = {0};
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_writer_win32_write(PgWriter *w, PG_SLICE(u8) src) {
-  PG_ASSERT(nullptr != w);
-  if (PG_SLICE_IS_EMPTY(src)) {
-    return (PG_RESULT(u64, PgError)){0};
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_file = pg_file_open(path, PG_FILE_ACCESS_READ, 0600, false, allocator);
+  if (PG_IS_ERR(res_file)) {
+    return PG_ERR(PG_UNWRAP_ERR(res_file), PgString, PgError);
   }
 
-  PgFileDescriptor file = w->ctx;
-  HANDLE handle = file.ptr;
-  DWORD n = 0;
-  bool has_value = WriteFile(handle, src.data, (DWORD)src.len, &n, nullptr);
-  PG_RESULT(u64, PgError) res = {0};
-  if (!has_value) {
-    res.err = (PgError)pg_os_get_last_error();
-  } else {
-    res.value = (u64)n;
+  PgFileDescriptor file = PG_UNWRAP(res_file);
+
+  PG_RESULT(u64, PgError) res_size = pg_file_size(file);
+  if (PG_IS_ERR(res_size)) {
+    res = PG_ERR(PG_UNWRAP_ERR(res_size), PgString, PgError);
+    goto end;
   }
 
-  return res;
-}
+  u64 size = PG_UNWRAP(res_size);
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_writer_file_write(PgWriter *w, PG_SLICE(u8) src, PgAllocator *) {
-  return pg_writer_win32_write(w, src);
-}
+  res = pg_file_read_full_from_descriptor(file, size, allocator);
 
-[[nodiscard]] static u64 pg_os_get_page_size() {
-  SYSTEM_INFO info;
-  GetSystemInfo(&info);
-  u64 res = (u64)info.dwPageSize;
+end:
+  (void)pg_file_close(file);
 
-  PG_ASSERT(res > 0);
   return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64)
-    pg_time_ns_now(PgClockKind clock_kind, PgError) {
-  PG_RESULT(u64, PgError) res = {0};
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_write_full(PgString path, PgString content, u64 mode,
+                   PgAllocator *allocator) {
+  PgFileDescriptor file = PG_TRY_ERR(
+      pg_file_open(path, PG_FILE_ACCESS_WRITE, mode, true, allocator));
 
-  switch (clock_kind) {
-  case PG_CLOCK_KIND_MONOTONIC: {
-    LARGE_INTEGER frequency = {0};
-    if (!frequency.QuadPart) {
-      QueryPerformanceFrequency(&frequency);
-      PG_ASSERT(frequency.QuadPart);
-    }
-    LARGE_INTEGER counter = {0};
-    PG_ASSERT(QueryPerformanceCounter(&counter));
-    f64 seconds = (f64)counter.QuadPart / (f64)frequency.QuadPart;
+  PG_ERR_RETURN(pg_file_write_full_with_descriptor(file, content));
 
-    res.value = (u64)(PG_Seconds * seconds);
-    return res;
-  }
-  case PG_CLOCK_KIND_REALTIME: {
-    FILETIME ft = {0};
-    GetSystemTimeAsFileTime(&ft);
-    res.value = (((u64)ft.dwHighDateTime) << 32) | ((u64)ft.dwLowDateTime);
-    return res;
-  }
-  default:
-    PG_ASSERT(0);
-  }
+  PG_ERR_RETURN(pg_file_close(file));
 
-  return res;
+  return 0;
 }
 
-[[nodiscard]] i32 pg_os_get_last_error() { return (i32)GetLastError(); }
+[[nodiscard]] static PgAllocSite *
+pg_tracking_allocator_site_upsert(PgTrackingAllocator *tracking,
+                                  PG_SLICE(u64) stack) {
+  PG_SLICE(u8)
+  stack_bytes = {.data = (u8 *)stack.data, .len = stack.len * sizeof(u64)};
+  u64 hash = pg_hash_fnv(stack_bytes);
 
-[[nodiscard]] i32 pg_virtual_mem_flags_to_os_flags(PgVirtualMemFlags flags) {
-  if (PG_VIRTUAL_MEM_FLAGS_NONE == flags) {
-    return PAGE_NOACCESS;
+  PgAllocSite **htrie = &tracking->sites_htrie;
+  for (u64 h = hash; *htrie; h <<= 2) {
+    PgAllocSite *site = *htrie;
+    if (hash == site->hash && stack.len == site->stack.len &&
+        pg_bytes_eq(stack_bytes,
+                    (PG_SLICE(u8)){.data = (u8 *)site->stack.data,
+                                   .len = site->stack.len * sizeof(u64)})) {
+      return site;
+    }
+    htrie = &site->child[h >> 62];
   }
 
-  if (flags & PG_VIRTUAL_MEM_FLAGS_WRITE) {
-    return PAGE_READWRITE;
+  PgAllocSite *site = PG_NEW(PgAllocSite, tracking->meta);
+  if (!site) {
+    return nullptr;
   }
 
-  if (PG_VIRTUAL_MEM_FLAGS_READ == flags) {
-    return PAGE_READONLY;
+  site->hash = hash;
+  site->id = tracking->sites_count++;
+  site->stack.data =
+      pg_alloc(tracking->meta, sizeof(u64), _Alignof(u64), stack.len);
+  site->stack.len = site->stack.data ? stack.len : 0;
+  pg_memcpy(site->stack.data, stack.data, site->stack.len * sizeof(u64));
+
+  site->next = tracking->sites;
+  tracking->sites = site;
+  *htrie = site;
+
+  if (tracking->trace_enabled) {
+    PG_DYN_PUSH(&tracking->trace, PG_ALLOC_TRACE_EVENT_SITE, tracking->meta);
+    pg_string_builder_append_u64_leb128(&tracking->trace, site->id,
+                                        tracking->meta);
+    pg_string_builder_append_u64_leb128(&tracking->trace, site->stack.len,
+                                        tracking->meta);
+    for (u64 i = 0; i < site->stack.len; i++) {
+      pg_string_builder_append_u64_leb128(
+          &tracking->trace, PG_SLICE_AT(site->stack, i), tracking->meta);
+    }
   }
 
-  PG_ASSERT(0 && "todo");
+  return site;
 }
 
-[[nodiscard]] PgVoidPtrResult pg_virtual_mem_alloc(u64 size,
-                                                   PgVirtualMemFlags flags) {
-  PG_ASSERT(size > 0);
+// Only creates the entry if `allocator` is not null.
+[[nodiscard]] static PgAllocLive *
+pg_tracking_allocator_live_upsert(PgAllocLive **htrie, u64 ptr,
+                                  PgAllocator *allocator) {
+  PG_SLICE(u8) slice = {.data = (u8 *)&ptr, .len = sizeof(ptr)};
 
-  PgVoidPtrResult res = {0};
-  // Note: We will reserve the guard pages right now.
+  for (u64 h = pg_hash_fnv(slice); *htrie; h <<= 2) {
+    if (ptr == (*htrie)->ptr) {
+      return *htrie;
+    }
+    htrie = &(*htrie)->child[h >> 62];
+  }
+  if (!allocator) {
+    return nullptr;
+  }
 
-  res.value = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE,
-                           (DWORD)pg_virtual_mem_flags_to_os_flags(flags));
-  if (!res.value) {
-    res.err = (PgError)pg_os_get_last_error();
+  *htrie = PG_NEW(PgAllocLive, allocator);
+  if (*htrie) {
+    (*htrie)->ptr = ptr;
   }
+
+  return *htrie;
+}
+
+[[nodiscard]] static u64
+pg_tracking_allocator_trace_time_delta(PgTrackingAllocator *tracking,
+                                       u64 now_ns) {
+  u64 res = now_ns - tracking->trace_last_timestamp_ns;
+  tracking->trace_last_timestamp_ns = now_ns;
   return res;
 }
 
-[[nodiscard]] PgError pg_virtual_mem_protect(void *ptr, u64 size,
-                                             PgVirtualMemFlags flags_new) {
-  DWORD flags_old = 0;
-  if (0 == VirtualProtect(ptr, size,
-                          (DWORD)pg_virtual_mem_flags_to_os_flags(flags_new),
-                          &flags_old)) {
-    return (PgError)pg_os_get_last_error();
-  }
-  return 0;
+static void pg_tracking_allocator_live_release(PgAllocLive *live) {
+  PG_ASSERT(live->site->live_count > 0);
+  PG_ASSERT(live->site->live_bytes >= live->size);
+  live->site->live_count -= 1;
+  live->site->live_bytes -= live->size;
+  live->site = nullptr;
 }
 
-[[nodiscard]] PgError pg_virtual_mem_release(void *ptr, u64 size) {
-  (void)size;
+// `frame_pointer` is the frame of the allocator entry point (alloc or
+// realloc): the stack starts at its caller so that the frames of the tracking
+// itself are not part of the site.
+static void pg_tracking_allocator_on_alloc(PgTrackingAllocator *tracking,
+                                           u64 *frame_pointer, void *ptr,
+                                           u64 size, u64 align) {
+  if (!ptr) {
+    return;
+  }
 
-  if (0 == VirtualFree(ptr, 0, MEM_RELEASE)) {
-    return (PgError)pg_os_get_last_error();
+  u64 seen = tracking->allocations_seen++;
+  if (0 != seen % tracking->sample_rate) {
+    return;
   }
-  return 0;
-}
 
-[[nodiscard]] static PgWtf16StringResult
-pg_string_to_wtf16(PgString s, PgAllocator *allocator) {
-  int wlen = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS,
-                                 (const char *)s.data, (i32)s.len, nullptr, 0);
-  PgWtf16StringResult res = {0};
+  u64 stack_trace[PG_STACK_TRACE_MAX] = {0};
+  // Raw addresses, so that they can be symbolized with the process mappings.
+  u64 stack_trace_len =
+      pg_fill_stack_trace_from_frame(frame_pointer, 0, 0, stack_trace);
+  PG_SLICE(u64) stack = {.data = stack_trace, .len = stack_trace_len};
 
-  if (0 == wlen) {
-    res.err = (PgError)pg_os_get_last_error();
-    return res;
+  PgAllocSite *site = pg_tracking_allocator_site_upsert(tracking, stack);
+  if (!site) {
+    return;
   }
 
-  res.value.len = (u64)wlen + 1;
-  res.value.data =
-      pg_alloc(allocator, sizeof(wchar_t), _Alignof(wchar_t), res.value.len);
-  PG_ASSERT(res.value.data);
-  PG_ASSERT(0 != MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS,
-                                     (const char *)s.data, (i32)s.len,
-                                     res.value.data, (i32)res.value.len));
-  PG_ASSERT(0 == res.value.data[res.value.len - 1]);
+  site->alloc_count += 1;
+  site->alloc_bytes += size;
+  site->live_count += 1;
+  site->live_bytes += size;
 
-  return res;
-}
+  u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_file_truncate(PgFileDescriptor file, u64 size) {
-  LARGE_INTEGER li_offset;
-  li_offset.QuadPart = (LONGLONG)size;
-  if (!SetFilePointerEx(file.ptr, li_offset, nullptr, FILE_BEGIN)) {
-    return (PgError)pg_os_get_last_error();
+  PgAllocLive *live = pg_tracking_allocator_live_upsert(
+      &tracking->live_htrie, (u64)ptr, tracking->meta);
+  if (live) {
+    // The address is handed out again while still recorded as live: its
+    // previous allocation was released without going through this allocator
+    // e.g. by resetting the backing arena.
+    if (live->site) {
+      pg_tracking_allocator_live_release(live);
+    }
+    live->site = site;
+    live->size = size;
+    live->timestamp_ns = now_ns;
   }
 
-  if (!SetEndOfFile(file.ptr)) {
-    return (PgError)pg_os_get_last_error();
+  if (tracking->trace_enabled) {
+    PG_DYN_PUSH(&tracking->trace, PG_ALLOC_TRACE_EVENT_ALLOC, tracking->meta);
+    pg_string_builder_append_u64_leb128(
+        &tracking->trace,
+        pg_tracking_allocator_trace_time_delta(tracking, now_ns),
+        tracking->meta);
+    pg_string_builder_append_u64_leb128(&tracking->trace, (u64)ptr,
+                                        tracking->meta);
+    pg_string_builder_append_u64_leb128(&tracking->trace, size,
+                                        tracking->meta);
+    pg_string_builder_append_u64_leb128(&tracking->trace, align,
+                                        tracking->meta);
+    pg_string_builder_append_u64_leb128(&tracking->trace, site->id,
+                                        tracking->meta);
   }
+}
 
-  li_offset.QuadPart = 0;
-  if (!SetFilePointerEx(file.ptr, li_offset, nullptr, FILE_BEGIN)) {
-    return (PgError)pg_os_get_last_error();
+static void pg_tracking_allocator_on_free(PgTrackingAllocator *tracking,
+                                          void *ptr) {
+  if (!ptr) {
+    return;
   }
 
-  return 0;
-}
+  PgAllocLive *live =
+      pg_tracking_allocator_live_upsert(&tracking->live_htrie, (u64)ptr, nullptr);
+  // Not sampled, or already freed.
+  if (!live || !live->site) {
+    return;
+  }
 
-[[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
-    pg_file_open(PgString path, PgFileAccess access, u64 mode,
-                 bool create_if_not_exists, PgAllocator *allocator) {
-  PG_RESULT(PgFileDescriptor, PgError) res = {0};
+  pg_tracking_allocator_live_release(live);
 
-  DWORD desired_access = 0;
-  DWORD creation_disposition =
-      create_if_not_exists ? CREATE_ALWAYS : OPEN_EXISTING;
+  if (tracking->trace_enabled) {
+    u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
 
-  switch (access) {
-  case PG_FILE_ACCESS_READ:
-    desired_access = GENERIC_READ;
-    break;
-  case PG_FILE_ACCESS_WRITE:
-    desired_access = GENERIC_WRITE;
-    break;
-  case PG_FILE_ACCESS_READ_WRITE:
-    desired_access = GENERIC_READ | GENERIC_WRITE;
-    break;
-  case PG_FILE_ACCESS_NONE:
-  default:
-    PG_ASSERT(0);
+    PG_DYN_PUSH(&tracking->trace, PG_ALLOC_TRACE_EVENT_FREE, tracking->meta);
+    pg_string_builder_append_u64_leb128(
+        &tracking->trace,
+        pg_tracking_allocator_trace_time_delta(tracking, now_ns),
+        tracking->meta);
+    pg_string_builder_append_u64_leb128(&tracking->trace, (u64)ptr,
+                                        tracking->meta);
+    pg_string_builder_append_u64_leb128(
+        &tracking->trace, now_ns - live->timestamp_ns, tracking->meta);
   }
+}
 
-  PgWtf16StringResult res_path_os = pg_string_to_wtf16(path, allocator);
-  if (res_path_os.err) {
-    res.err = res_path_os.err;
-    return res;
-  }
+[[nodiscard]] static void *pg_alloc_tracking(PgAllocator *allocator,
+                                             u64 sizeof_type, u64 alignof_type,
+                                             u64 elem_count) {
+  PgTrackingAllocator *tracking = (PgTrackingAllocator *)allocator;
 
-  HANDLE handle =
-      CreateFileW(res_path_os.value.data, desired_access,
-                  FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
-                  creation_disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+  void *res =
+      pg_alloc(tracking->backing, sizeof_type, alignof_type, elem_count);
+  pg_tracking_allocator_on_alloc(tracking, __builtin_frame_address(0), res,
+                                 sizeof_type * elem_count, alignof_type);
+  return res;
+}
 
-  pg_free(allocator, res_path_os.value.data);
+[[nodiscard]] static void *pg_realloc_tracking(PgAllocator *allocator,
+                                               void *ptr, u64 elem_count_old,
+                                               u64 sizeof_type,
+                                               u64 alignof_type,
+                                               u64 elem_count) {
+  PgTrackingAllocator *tracking = (PgTrackingAllocator *)allocator;
 
-  if (INVALID_HANDLE_VALUE == handle) {
-    res.err = (PgError)pg_os_get_last_error();
-    return res;
+  void *res = pg_realloc(tracking->backing, ptr, elem_count_old, sizeof_type,
+                         alignof_type, elem_count);
+  if (res) {
+    pg_tracking_allocator_on_free(tracking, ptr);
+    pg_tracking_allocator_on_alloc(tracking, __builtin_frame_address(0), res,
+                                   sizeof_type * elem_count, alignof_type);
   }
-
-  res.value.ptr = handle;
   return res;
 }
 
-[[nodiscard]] static PgError pg_file_close(PgFileDescriptor file) {
-  if (0 == CloseHandle(file.ptr)) {
-    return (PgError)pg_os_get_last_error();
-  }
+static void pg_free_tracking(PgAllocator *allocator, void *ptr) {
+  PgTrackingAllocator *tracking = (PgTrackingAllocator *)allocator;
 
-  return 0;
+  pg_tracking_allocator_on_free(tracking, ptr);
+  pg_free(tracking->backing, ptr);
 }
 
-[[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_file_size(PgFileDescriptor file) {
-  PG_RESULT(u64, PgError) res = {0};
-
-  LARGE_INTEGER size;
-  if (0 == GetFileSizeEx(file.ptr, &size)) {
-    res.err = (PgError)pg_os_get_last_error();
-    return res;
-  }
+[[maybe_unused]] [[nodiscard]] static PgTrackingAllocator
+pg_make_tracking_allocator(PgAllocator *backing, PgAllocator *meta,
+                           u64 sample_rate, bool trace_enabled) {
+  PG_ASSERT(backing);
+  PG_ASSERT(meta);
+  PG_ASSERT(sample_rate > 0);
 
-  res.value = (u64)size.QuadPart;
-  return res;
+  return (PgTrackingAllocator){
+      .alloc_fn = pg_alloc_tracking,
+      .realloc_fn = pg_realloc_tracking,
+      .free_fn = pg_free_tracking,
+      .backing = backing,
+      .meta = meta,
+      .sample_rate = sample_rate,
+      .trace_enabled = trace_enabled,
+  };
 }
 
-[[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_file_read(PgFileDescriptor file, PgString dst) {
-  PG_RESULT(u64, PgError) res = {0};
+[[maybe_unused]] [[nodiscard]] static PgAllocator *
+pg_tracking_allocator_as_allocator(PgTrackingAllocator *allocator) {
+  return (PgAllocator *)allocator;
+}
 
-  if (0 == ReadFile(file.ptr, dst.data, (DWORD)dst.len, (LPDWORD)&res.value,
-                    nullptr)) {
-    res.err = (PgError)pg_os_get_last_error();
-    return res;
-  }
+[[nodiscard]] static PgError
+pg_tracking_allocator_write_heap_profile_counts(PgWriter *w, u64 live_count,
+                                                u64 live_bytes,
+                                                u64 alloc_count,
+                                                u64 alloc_bytes,
+                                                PgAllocator *allocator) {
+  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, live_count, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(": "), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, live_bytes, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" ["), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, alloc_count, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(": "), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, alloc_bytes, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("] @"), allocator));
 
-  return res;
+  return 0;
 }
 
-[[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_file_write(PgFileDescriptor file, PgString s) {
-  PG_RESULT(u64, PgError) res = {0};
-
-  if (0 ==
-      WriteFile(file.ptr, s.data, (DWORD)s.len, (LPDWORD)&res.value, nullptr)) {
-    res.err = (PgError)pg_os_get_last_error();
-    return res;
+// Write the per-site counters in the legacy text heap profile format that
+// `pprof` understands: `pprof -http=: ./my_exe heap.prof`.
+// Counters are scaled by the sample rate.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_tracking_allocator_write_heap_profile(PgTrackingAllocator *tracking,
+                                         PgWriter *w, PgAllocator *allocator) {
+  u64 live_count = 0, live_bytes = 0, alloc_count = 0, alloc_bytes = 0;
+  for (PgAllocSite *site = tracking->sites; site; site = site->next) {
+    live_count += site->live_count;
+    live_bytes += site->live_bytes;
+    alloc_count += site->alloc_count;
+    alloc_bytes += site->alloc_bytes;
+  }
+
+  u64 scale = tracking->sample_rate;
+
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("heap profile: "), allocator));
+  PG_ERR_RETURN(pg_tracking_allocator_write_heap_profile_counts(
+      w, live_count * scale, live_bytes * scale, alloc_count * scale,
+      alloc_bytes * scale, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" heapprofile\n"), allocator));
+
+  for (PgAllocSite *site = tracking->sites; site; site = site->next) {
+    PG_ERR_RETURN(pg_tracking_allocator_write_heap_profile_counts(
+        w, site->live_count * scale, site->live_bytes * scale,
+        site->alloc_count * scale, site->alloc_bytes * scale, allocator));
+
+    for (u64 i = 0; i < site->stack.len; i++) {
+      PG_ERR_RETURN(pg_writer_write_u8(w, ' ', allocator));
+      PG_ERR_RETURN(
+          pg_writer_write_u64_hex(w, PG_SLICE_AT(site->stack, i), allocator));
+    }
+    PG_ERR_RETURN(pg_writer_write_u8(w, '\n', allocator));
   }
 
-  return res;
-}
-
-[[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_file_read_at(PgFileDescriptor file, PgString dst, u64 offset) {
-  PG_RESULT(u64, PgError) res = {0};
+#ifdef PG_OS_LINUX
+  // Required by `pprof` to symbolize the raw addresses.
+  PgFileDescriptor maps_file = PG_TRY_ERR(pg_file_open(
+      PG_S("/proc/self/maps"), PG_FILE_ACCESS_READ, 0, false, allocator));
+  PG_RESULT(PgString, PgError)
+  res_maps =
+      pg_file_read_full_from_descriptor_until_eof(maps_file, 4096, allocator);
+  (void)pg_file_close(maps_file);
+  PgString maps = PG_TRY_ERR(res_maps);
 
-  LARGE_INTEGER li_offset;
-  li_offset.QuadPart = (LONGLONG)offset;
-  if (!SetFilePointerEx(file.ptr, li_offset, nullptr, FILE_BEGIN)) {
-    res.err = (PgError)pg_os_get_last_error();
-    return res;
-  }
+  PG_ERR_RETURN(
+      pg_writer_write_full(w, PG_S("\nMAPPED_LIBRARIES:\n"), allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, maps, allocator));
+#endif
 
-  if (!SetEndOfFile(file.ptr)) {
-    res.err = (PgError)pg_os_get_last_error();
-    return res;
-  }
+  return pg_writer_flush(w, allocator);
+}
 
-  res = pg_file_read(file, dst);
+[[maybe_unused]] [[nodiscard]]
+static PG_RESULT(PgProcess, PgError)
+    pg_process_spawn(PgString path, PG_SLICE(PgString) args,
+                     PgProcessSpawnOptions options, PgAllocator *allocator);
 
-  li_offset.QuadPart = 0;
-  if (!SetFilePointerEx(file.ptr, li_offset, nullptr, FILE_BEGIN)) {
-    res.err = (PgError)pg_os_get_last_error();
-    return res;
-  }
+[[maybe_unused]] [[nodiscard]]
+static PG_RESULT(PgProcessStatus, PgError)
+    pg_process_wait(PgProcess process, u64 stdio_size_hint,
+                    u64 stderr_size_hint, PgAllocator *allocator);
 
-  return res;
-}
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_send_to_socket(PgFileDescriptor dst, PgFileDescriptor src);
 
-#elifdef PG_OS_WASM
-#endif
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_send_to_socket_range(PgFileDescriptor dst, PgFileDescriptor src,
+                             u64 offset, u64 len);
 
-[[maybe_unused]]
-PgString static pg_http_method_to_string(PgHttpMethod m) {
-  switch (m) {
-  case PG_HTTP_METHOD_UNKNOWN:
-    return PG_S("UNKNOWN");
-  case PG_HTTP_METHOD_OPTIONS:
-    return PG_S("OPTIONS");
-  case PG_HTTP_METHOD_GET:
-    return PG_S("GET");
-  case PG_HTTP_METHOD_HEAD:
-    return PG_S("HEAD");
-  case PG_HTTP_METHOD_POST:
-    return PG_S("POST");
-  case PG_HTTP_METHOD_PUT:
-    return PG_S("PUT");
-  case PG_HTTP_METHOD_DELETE:
-    return PG_S("DELETE");
-  case PG_HTTP_METHOD_TRACE:
-    return PG_S("TRACE");
-  case PG_HTTP_METHOD_CONNECT:
-    return PG_S("CONNECT");
-  case PG_HTTP_METHOD_EXTENSION:
-    return PG_S("EXTENSION");
-  default:
-    PG_ASSERT(0);
-  }
-}
+// This works from any kind of file descriptor to any kind of file descriptor.
+// But this may be slower than OS-specific syscalls.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_copy_with_descriptors_until_eof(PgFileDescriptor dst,
+                                        PgFileDescriptor src, u64 offset) {
+  // NOTE: on FreeBSD, we could use `copy_file_range` (and Linux too, actually),
+  // or `splice`.
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHttpResponseStatusLine,
-                                                PgError)
-    pg_http_parse_response_status_line(PgString status_line) {
-  PgHttpResponseStatusLine res = {0};
+  for (;;) {
+    u8 read_buf[4096] = {0};
+    PG_SLICE(u8)
+    read_slice = {.data = read_buf, .len = PG_STATIC_ARRAY_LEN(read_buf)};
 
-  PgString remaining = status_line;
-  {
-    PG_OPTION(PgString)
-    consume_opt = pg_string_consume_string(remaining, PG_S("HTTP/"));
-    if (!consume_opt.has_value) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    u64 read_count = PG_TRY_ERR(pg_file_read(src, read_slice));
+    // EOF.
+    if (0 == read_count) {
+      return (PgError)0;
     }
-    remaining = consume_opt.value;
-  }
 
-  {
-    PgParseNumberResult res_major = pg_string_parse_u64(remaining, 10, true);
-    if (!res_major.present) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
-    }
-    if (res_major.n > 3) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
-    }
-    res.version_major = (u8)res_major.n;
-    remaining = res_major.remaining;
-  }
+    if (offset > read_count) {
+      // Keep reading and do not write yet.
 
-  {
-    PG_OPTION(PgString) consume_opt = pg_string_consume_rune(remaining, '.');
-    if (!consume_opt.has_value) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+      offset -= read_count;
+      continue;
     }
-    remaining = consume_opt.value;
-  }
 
-  {
-    PgParseNumberResult res_minor = pg_string_parse_u64(remaining, 10, true);
-    if (!res_minor.present) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
-    }
-    if (res_minor.n > 9) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    PG_ASSERT(offset <= read_count);
+
+    PG_SLICE(u8)
+    write_slice = {.data = read_slice.data + offset,
+                   .len = read_count - offset};
+    PgError err = pg_file_write_full_with_descriptor(dst, write_slice);
+    if (err) {
+      return err;
     }
-    res.version_minor = (u8)res_minor.n;
-    remaining = res_minor.remaining;
-  }
 
-  {
-    PG_OPTION(PgString) consume_opt = pg_string_consume_rune(remaining, ' ');
-    if (!consume_opt.has_value) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    if (offset > 0) {
+      offset = 0;
     }
-    remaining = consume_opt.value;
   }
+}
 
-  {
-    PgParseNumberResult res_status_code =
-        pg_string_parse_u64(remaining, 10, true);
-    if (!res_status_code.present) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
-    }
-    if (res_status_code.n < 100 || res_status_code.n > 599) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
-    }
-    res.status = (u16)res_status_code.n;
-    remaining = res_status_code.remaining;
+// ----- Start UNIX implementation ------
+#ifdef PG_OS_UNIX
+
+#define PG_PIPE_READ 0
+#define PG_PIPE_WRITE 1
+
+[[maybe_unused]] [[nodiscard]] PG_RESULT(PgDirectory, PgError)
+    pg_directory_open(PgString name) {
+  if (name.len > PG_PATH_MAX - 1) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgDirectory, PgError);
   }
 
-  // TODO: Should we keep the human-readable status code around or validate
-  // it?
+  u8 name_c[PG_PATH_MAX] = {0};
+  pg_memcpy(name_c, name.data, name.len);
 
-  return PG_OK(res, PgHttpResponseStatusLine, PgError);
-}
+  DIR *dir = opendir((char *)name_c);
+  if (!dir) {
+    return PG_ERR(errno, PgDirectory, PgError);
+  }
 
-[[maybe_unused]]
-static void pg_http_push_header(PG_DYN(PgStringKeyValue) * headers,
-                                PgString key, PgString value,
-                                PgAllocator *allocator) {
-  PG_DYN_PUSH(headers, ((PgStringKeyValue){.key = key, .value = value}),
-              allocator);
+  return PG_OK((PgDirectory){.dir = dir}, PgDirectory, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_writer_url_encode(PgWriter *w, PgString key, PgString value,
-                     PgAllocator *allocator) {
-  PgError err = 0;
-
-  PG_EACH_PTR(c, &key) {
-    if (pg_rune_ascii_is_alphanumeric(*c)) {
-      err = pg_writer_write_u8(w, *c, allocator);
-      if (err) {
-        return err;
-      }
-    } else {
-      err = pg_writer_write_u8(w, '%', allocator);
-      if (err) {
-        return err;
-      }
-
-      err = pg_writer_write_u8_hex_upper(w, *c, allocator);
-      if (err) {
-        return err;
-      }
-    }
-  }
-
-  err = pg_writer_write_u8(w, '=', allocator);
-  if (err) {
-    return err;
+[[maybe_unused]] [[nodiscard]] PgError pg_directory_close(PgDirectory dir) {
+  i32 ret = closedir(dir.dir);
+  if (-1 == ret) {
+    return (PgError)errno;
   }
 
-  PG_EACH_PTR(c, &value) {
-    if (pg_rune_ascii_is_alphanumeric(*c)) {
-      err = pg_writer_write_u8(w, *c, allocator);
-      if (err) {
-        return err;
-      }
-    } else {
-      err = pg_writer_write_u8(w, '%', allocator);
-      if (err) {
-        return err;
-      }
-      err = pg_writer_write_u8_hex_upper(w, *c, allocator);
-      if (err) {
-        return err;
-      }
-    }
-  }
   return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_http_request_write_status_line(PgWriter *w, PgHttpRequest req,
-                                  PgAllocator *allocator) {
-  PgError err = 0;
+[[maybe_unused]] [[nodiscard]] PG_RESULT(PgDirectoryEntry, PgError)
+    pg_directory_read(PgDirectory *dir) {
 
-  err =
-      pg_writer_write_full(w, pg_http_method_to_string(req.method), allocator);
-  if (err) {
-    return err;
-  }
+  // Need to set `errno` to 0 to detect EOF.
+  errno = 0;
 
-  err = pg_writer_write_full(w, PG_S(" /"), allocator);
-  if (err) {
-    return err;
+  struct dirent *entry = readdir(dir->dir);
+  if (!entry && 0 == errno) {
+    return PG_OK({}, PgDirectoryEntry, PgError); // EOF
+  }
+  if (!entry) {
+    return PG_ERR(errno, PgDirectoryEntry, PgError);
   }
 
-  PG_EACH_PTR(path_component, &req.url.path_components) {
-    err = pg_writer_write_full(w, *path_component, allocator);
-    if (err) {
-      return err;
-    }
+  return PG_OK(entry, PgDirectoryEntry, PgError);
+}
 
-    if (path_component != PG_SLICE_LAST_PTR(&req.url.path_components)) {
-      err = pg_writer_write_full(w, PG_S("/"), allocator);
-      if (err) {
-        return err;
-      }
-    }
-  }
+[[maybe_unused]] [[nodiscard]] static bool
+pg_dirent_is_file(PgDirectoryEntry dirent) {
+  return DT_REG == dirent->d_type;
+}
 
-  if (req.url.query_parameters.len > 0) {
-    err = pg_writer_write_full(w, PG_S("?"), allocator);
-    if (err) {
-      return err;
-    }
+[[maybe_unused]] [[nodiscard]] static bool
+pg_dirent_is_directory(PgDirectoryEntry dirent) {
+  return DT_DIR == dirent->d_type;
+}
 
-    PG_EACH_PTR(param, &req.url.query_parameters) {
-      err = pg_writer_url_encode(w, param->key, param->value, allocator);
-      if (err) {
-        return err;
-      }
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_dirent_name(PgDirectoryEntry dirent) {
+  return pg_cstr_to_string(dirent->d_name);
+}
 
-      if (param != PG_SLICE_LAST_PTR(&req.url.query_parameters)) {
-        err = pg_writer_write_full(w, PG_S("&"), allocator);
-        if (err) {
-          return err;
-        }
-      }
+// Slot of `name` in the hash trie: the entry if present, where to insert it
+// otherwise.
+[[nodiscard]] static PgAioFsEntry **
+pg_aio_fs_entry_find(PgAioFsEntry **htrie, PgString name) {
+  for (u64 h = pg_hash_fnv(name); *htrie; h <<= 2) {
+    if (pg_string_eq(name, (*htrie)->name)) {
+      break;
     }
+    htrie = &(*htrie)->child[h >> 62];
   }
-
-  err = pg_writer_write_full(w, PG_S(" HTTP/1.1\r\n"), allocator);
-  if (err) {
-    return err;
-  }
-  return 0;
+  return htrie;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_http_response_write_status_line(PgWriter *w, PgHttpResponse res,
-                                   PgAllocator *allocator) {
-  PgError err = 0;
-
-  err = pg_writer_write_full(w, PG_S("HTTP/"), allocator);
-  if (err) {
-    return err;
+// Entry of `name`, created absent if not present. A removed entry is reused,
+// along with its name if long enough, so that the entries take as much memory
+// as the most there have been at once.
+[[nodiscard]] static PgAioFsEntry *pg_aio_fs_entry_upsert(PgAioFsNode *node,
+                                                          PgString name) {
+  PgAioFsEntry **htrie = pg_aio_fs_entry_find(&node->entries, name);
+  if (*htrie) {
+    return *htrie;
   }
 
-  err = pg_writer_write_u64_as_string(w, res.version_major, allocator);
-  if (err) {
-    return err;
+  PgAioFsEntry *entry = node->entries_free;
+  if (entry) {
+    node->entries_free = entry->child[0];
+    entry->child[0] = nullptr;
+  } else {
+    entry = PG_NEW(PgAioFsEntry, node->allocator);
   }
 
-  err = pg_writer_write_u8(w, '.', allocator);
-  if (err) {
-    return err;
+  if (entry->name_cap < name.len) {
+    if (entry->name.data) {
+      pg_free(node->allocator, entry->name.data);
+    }
+    entry->name = pg_string_make(name.len, node->allocator);
+    entry->name_cap = name.len;
   }
+  pg_memcpy(entry->name.data, name.data, name.len);
+  entry->name.len = name.len;
 
-  err = pg_writer_write_u64_as_string(w, res.version_minor, allocator);
-  if (err) {
-    return err;
-  }
+  *htrie = entry;
+  return entry;
+}
 
-  err = pg_writer_write_u8(w, ' ', allocator);
-  if (err) {
-    return err;
-  }
+// Remove the deleted entry in `slot` from the trie, to be reused by
+// `pg_aio_fs_entry_upsert`. A leaf of its subtree takes its place: it shares
+// the hash prefix that leads there, so it and the entries below are still
+// found on the way.
+static void pg_aio_fs_entry_remove(PgAioFsNode *node, PgAioFsEntry **slot) {
+  PgAioFsEntry *entry = *slot;
+  PG_ASSERT(entry);
+  PG_ASSERT(!entry->exists);
+  PG_ASSERT(!entry->pending);
 
-  err = pg_writer_write_u64_as_string(w, res.status, allocator);
-  if (err) {
-    return err;
+  PgAioFsEntry **leaf = slot;
+  for (bool found = true; found;) {
+    found = false;
+    for (u64 i = 0; i < PG_STATIC_ARRAY_LEN((*leaf)->child); i++) {
+      if ((*leaf)->child[i]) {
+        leaf = &(*leaf)->child[i];
+        found = true;
+        break;
+      }
+    }
   }
 
-  err = pg_writer_write_full(w, PG_S("\r\n"), allocator);
-  if (err) {
-    return err;
+  PgAioFsEntry *last = *leaf;
+  *leaf = nullptr;
+  if (last != entry) {
+    pg_memcpy(last->child, entry->child, sizeof(entry->child));
+    *slot = last;
   }
 
-  return 0;
+  u8 *name_data = entry->name.data;
+  u64 name_cap = entry->name_cap;
+  *entry = (PgAioFsEntry){
+      .name = {.data = name_data},
+      .name_cap = name_cap,
+  };
+  entry->child[0] = node->entries_free;
+  node->entries_free = entry;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_http_write_header(PgWriter *w, PgStringKeyValue header,
-                     PgAllocator *allocator) {
-  PgError err = 0;
+static void pg_aio_fs_entries_free(PgAllocator *allocator,
+                                   PgAioFsEntry *entry) {
+  if (!entry) {
+    return;
+  }
 
-  err = pg_writer_write_full(w, header.key, allocator);
-  if (err) {
-    return err;
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(entry->child); i++) {
+    pg_aio_fs_entries_free(allocator, entry->child[i]);
+  }
+  if (entry->name.data) {
+    pg_free(allocator, entry->name.data);
   }
+  pg_free(allocator, entry);
+}
 
-  err = pg_writer_write_full(w, PG_S(": "), allocator);
-  if (err) {
-    return err;
+// The watch of `node` was dropped e.g. its directory deleted: its entries are
+// freed, lest the directory watched again with the same watch descriptor is
+// diffed against them.
+static void pg_aio_fs_node_forget(PgAioFsNode *node) {
+  node->directory = false;
+
+  pg_aio_fs_entries_free(node->allocator, node->entries);
+  node->entries = nullptr;
+
+  while (node->entries_free) {
+    PgAioFsEntry *entry = node->entries_free;
+    node->entries_free = entry->child[0];
+    entry->child[0] = nullptr;
+    pg_aio_fs_entries_free(node->allocator, entry);
   }
+}
 
-  err = pg_writer_write_full(w, header.value, allocator);
-  if (err) {
-    return err;
+// Path of the entry `name` of the directory of `node`, written to `buf` of
+// `PG_PATH_MAX` bytes. None if too long.
+[[nodiscard]] static PG_OPTION(PgString)
+    pg_aio_fs_entry_path(PgAioFsNode *node, PgString name, u8 *buf) {
+  PG_OPTION(PgString) res = {0};
+  if (node->name.len + 1 + name.len > PG_PATH_MAX - 1) {
+    return res;
   }
 
-  err = pg_writer_write_full(w, PG_S("\r\n"), allocator);
-  if (err) {
-    return err;
+  res.value.data = buf;
+  pg_memcpy(res.value.data, node->name.data, node->name.len);
+  res.value.len += node->name.len;
+  res.value.data[res.value.len++] = PG_PATH_SEPARATOR;
+  pg_memcpy(res.value.data + res.value.len, name.data, name.len);
+  res.value.len += name.len;
+  res.has_value = true;
+  return res;
+}
+
+// Record the current state of `entry`, and report how it changed to `events`
+// if not null. The modification time and size of directories are ignored:
+// they change with their entries, which are watched on their own. A file
+// `written` is modified even if its state looks the same, e.g. when written
+// twice within the resolution of the clock of the file system.
+// The events get a copy of the name from `allocator`: the entry may be
+// removed, and its memory reused for another name.
+[[nodiscard]] static PgAioEventKind
+pg_aio_fs_entry_update(PgAioFsNode *node, PgAioFsEntry *entry, bool exists,
+                       PgFileStat stat, bool written,
+                       PG_DYN(PgAioEvent) * events, PgAllocator *allocator) {
+  PgAioEventKind kind = PG_AIO_EVENT_KIND_NONE;
+  if (!entry->exists && exists) {
+    kind = PG_AIO_EVENT_KIND_FILE_CREATED;
+  } else if (entry->exists && !exists) {
+    kind = PG_AIO_EVENT_KIND_FILE_DELETED;
+  } else if (exists &&
+             (written || entry->ino != stat.ino ||
+              entry->directory != stat.directory ||
+              (!stat.directory && (entry->mtime_ns != stat.mtime_ns ||
+                                   entry->size != stat.size)))) {
+    kind = PG_AIO_EVENT_KIND_FILE_MODIFIED;
+  }
+
+  entry->exists = exists;
+  if (exists) {
+    entry->mtime_ns = stat.mtime_ns;
+    entry->size = stat.size;
+    entry->ino = stat.ino;
+    entry->directory = stat.directory;
+  }
+
+  PgWalkDirectoryOption wanted = entry->directory
+                                     ? PG_WALK_DIRECTORY_KIND_DIRECTORY
+                                     : PG_WALK_DIRECTORY_KIND_FILE;
+  if (events && kind && (node->options & wanted)) {
+    PgAioEvent event = {
+        .kind = kind,
+        .fd = node->fd,
+        .name = pg_string_clone(entry->name, allocator),
+    };
+    PG_DYN_PUSH(events, event, allocator);
   }
 
-  return 0;
+  return kind;
 }
 
-// NOTE: Only sanitation for including the string inside an HTML tag e.g.:
-// `<div>...ESCAPED_STRING..</div>`.
-// To include the string inside other context (e.g. JS, CSS, HTML
-// attributes, etc), more advanced sanitation is required.
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_html_sanitize(PgString s, PgAllocator *allocator) {
-  PG_DYN(u8) res = {0};
-  PG_DYN_ENSURE_CAP(&res, s.len * 2, allocator);
+[[nodiscard]] static PgError
+pg_aio_fs_watch_directory(PgAio *aio, PgString name,
+                          PgWalkDirectoryOption options,
+                          PgAllocator *allocator, PG_DYN(PgAioEvent) * events,
+                          PgAllocator *events_allocator);
+
+// Entries not seen by the scan of generation `generation` were deleted, and
+// are removed. The leaf taking the place of one was already visited.
+static void pg_aio_fs_entries_sweep(PgAioFsNode *node, PgAioFsEntry **slot,
+                                    PG_DYN(PgAioEvent) * events,
+                                    PgAllocator *allocator) {
+  PgAioFsEntry *entry = *slot;
+  if (!entry) {
+    return;
+  }
 
-  PG_EACH_PTR(c, &s) {
-    if ('&' == *c) {
-      PG_DYN_APPEND_SLICE(&res, PG_S("&amp;"), allocator);
-    } else if ('<' == *c) {
-      PG_DYN_APPEND_SLICE(&res, PG_S("&lt;"), allocator);
-    } else if ('>' == *c) {
-      PG_DYN_APPEND_SLICE(&res, PG_S("&gt;"), allocator);
-    } else if ('"' == *c) {
-      PG_DYN_APPEND_SLICE(&res, PG_S("&quot;"), allocator);
-    } else if ('\'' == *c) {
-      PG_DYN_APPEND_SLICE(&res, PG_S("&#39;"), allocator);
-    } else {
-      PG_DYN_PUSH(&res, *c, allocator);
-    }
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(entry->child); i++) {
+    pg_aio_fs_entries_sweep(node, &entry->child[i], events, allocator);
   }
 
-  return PG_DYN_TO_SLICE(PgString, res);
+  if (entry->generation == node->generation) {
+    return;
+  }
+  if (entry->exists) {
+    (void)pg_aio_fs_entry_update(node, entry, false, (PgFileStat){0}, false,
+                                 events, allocator);
+  }
+  if (!entry->pending) {
+    pg_aio_fs_entry_remove(node, slot);
+  }
 }
 
-[[maybe_unused]] [[nodiscard]]
-static PgString pg_html_make_slug(PgString s, PgAllocator *allocator) {
-  PG_DYN(u8) sb = {0};
-  PG_DYN_ENSURE_CAP(&sb, s.len * 2, allocator);
+// Read the whole directory and diff it with the state last recorded. The
+// subdirectories found are watched too when recursing, and their entries
+// reported as created.
+[[nodiscard]] static PgError pg_aio_fs_node_scan(PgAio *aio, PgAioFsNode *node,
+                                                 PG_DYN(PgAioEvent) * events,
+                                                 PgAllocator *allocator) {
+  bool ignore_errors = node->options & PG_WALK_DIRECTORY_KIND_IGNORE_ERRORS;
+  bool recurse = node->options & PG_WALK_DIRECTORY_KIND_RECURSE;
+  node->generation += 1;
 
-  PgUtf8Iterator it = pg_make_utf8_iterator(s);
+  PgDirectory dir = PG_TRY_ERR(pg_directory_open(node->name));
+  PgError err = 0;
 
   for (;;) {
-    PgRuneUtf8Result res = pg_utf8_iterator_next(&it);
-    // TODO: Use REPLACEMENT CHARACTER?
-    if (res.err) {
-      return (PgString){0};
+    PG_RESULT(PgDirectoryEntry, PgError) res_read = pg_directory_read(&dir);
+    if (PG_IS_ERR(res_read)) {
+      err = PG_UNWRAP_ERR(res_read);
+      break;
+    }
+    PgDirectoryEntry dirent = PG_UNWRAP(res_read);
+    if (!dirent) {
+      break; // EOF.
     }
 
-    if (res.end) {
-      break;
+    PgString name = pg_dirent_name(dirent);
+    if (pg_string_eq(name, PG_S(".")) || pg_string_eq(name, PG_S(".."))) {
+      continue;
     }
 
-    PgRune rune = res.rune;
+    u8 path_buf[PG_PATH_MAX] = {0};
+    PG_OPTION(PgString) path = pg_aio_fs_entry_path(node, name, path_buf);
+    if (!path.has_value) {
+      continue;
+    }
+    PG_RESULT(PgFileStat, PgError)
+    res_stat = pg_file_stat_from_path(path.value, nullptr);
+    // Deleted in the meantime.
+    if (PG_IS_ERR(res_stat)) {
+      continue;
+    }
+    PgFileStat stat = PG_UNWRAP(res_stat);
 
-    if (pg_rune_ascii_is_alphanumeric(rune)) {
-      PG_DYN_PUSH(&sb, pg_rune_ascii_to_lower_case(rune), allocator);
-    } else if ('+' == rune) {
-      PG_DYN_APPEND_SLICE(&sb, PG_S("plus"), allocator);
-    } else if ('#' == rune) {
-      PG_DYN_APPEND_SLICE(&sb, PG_S("sharp"), allocator);
-    } else if (PG_SLICE_LAST(sb) != '-') {
-      // Other runes are mapped to `-`, but we avoid consecutive `-`.
-      PG_DYN_PUSH(&sb, '-', allocator);
+    PgAioFsEntry *entry = pg_aio_fs_entry_upsert(node, name);
+    entry->generation = node->generation;
+    PgAioEventKind kind = pg_aio_fs_entry_update(node, entry, true, stat,
+                                                 false, events, allocator);
+
+    // A directory replaced gets a new watch.
+    if (recurse && stat.directory &&
+        (PG_AIO_EVENT_KIND_FILE_CREATED | PG_AIO_EVENT_KIND_FILE_MODIFIED) &
+            kind) {
+      err = pg_aio_fs_watch_directory(aio, path.value, node->options,
+                                      node->allocator, events, allocator);
+      if (err && !ignore_errors) {
+        break;
+      }
+      err = 0;
     }
   }
-  PgString res = PG_DYN_TO_SLICE(PgString, sb);
 
-  return pg_string_trim(res, '-');
-}
+  PgError err_close = pg_directory_close(dir);
+  if (err) {
+    return err;
+  }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_DYN(PgString), PgError)
-    pg_url_parse_path_components(PgString s, PgAllocator *allocator) {
+  pg_aio_fs_entries_sweep(node, &node->entries, events, allocator);
 
-  if (-1 != pg_string_index_of_any_rune(s, PG_S("?#:"))) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PgString), PgError);
-  }
+  return err_close;
+}
 
-  if (PG_SLICE_IS_EMPTY(s)) {
-    return PG_OK({}, PG_DYN(PgString), PgError);
+// `name` is copied if not already watched.
+[[nodiscard]] static PgError
+pg_aio_fs_watch_directory(PgAio *aio, PgString name,
+                          PgWalkDirectoryOption options,
+                          PgAllocator *allocator, PG_DYN(PgAioEvent) * events,
+                          PgAllocator *events_allocator) {
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_watch = pg_aio_register_interest_fs_name(
+      aio, name,
+      PG_AIO_EVENT_KIND_FILE_MODIFIED | PG_AIO_EVENT_KIND_FILE_DELETED |
+          PG_AIO_EVENT_KIND_FILE_CREATED,
+      allocator);
+  PG_IF_LET_ERR(err, res_watch) { return err; }
+
+  PgAioFsNode *node =
+      pg_aio_fs_node_upsert(&aio->fs_nodes, PG_UNWRAP(res_watch), nullptr);
+  PG_ASSERT(node);
+  if (node->directory) {
+    return 0;
   }
 
-  if (!pg_string_starts_with(s, PG_S("/"))) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PgString), PgError);
-  }
+  node->name = pg_string_clone(name, allocator);
+  node->directory = true;
+  node->options = options;
+  node->allocator = allocator;
 
-  PG_DYN(PgString) res = {0};
-  PgSplitIterator split_it_slash = pg_string_split_string(s, PG_S("/"));
-
-  for (u64 i = 0; i < s.len; i++) { // Bound.
-    PG_OPTION(PgString) split_opt = pg_string_split_next(&split_it_slash);
-    if (!split_opt.has_value) {
-      break;
-    }
-
-    if (PG_SLICE_IS_EMPTY(split_opt.value)) {
-      continue;
-    }
-
-    PG_DYN_PUSH(&res, split_opt.value, allocator);
-  }
-
-  return PG_OK(res, PG_DYN(PgString), PgError);
+  return pg_aio_fs_node_scan(aio, node, events, events_allocator);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_url_to_string(PgUrl u, PgAllocator *allocator) {
-  PG_DYN(u8) sb = pg_string_builder_make(256, allocator);
-  PG_DYN_APPEND_SLICE(&sb, u.scheme, allocator);
-  if (u.scheme.len) {
-    PG_DYN_APPEND_SLICE(&sb, PG_S("://"), allocator);
-  }
-
-  if (u.username.len) {
-    PG_DYN_APPEND_SLICE(&sb, u.username, allocator);
-  }
-  if (u.username.len || u.password.len) {
-    PG_DYN_APPEND_SLICE(&sb, PG_S(":"), allocator);
-  }
-
-  if (u.password.len) {
-    PG_DYN_APPEND_SLICE(&sb, u.password, allocator);
-  }
-  if (u.username.len || u.password.len) {
-    PG_DYN_APPEND_SLICE(&sb, PG_S("@"), allocator);
-  }
-
-  if (u.host.len) {
-    PG_DYN_APPEND_SLICE(&sb, u.host, allocator);
-  }
+// Watch the directory `name`, and its subdirectories with
+// `PG_WALK_DIRECTORY_KIND_RECURSE`, for their files
+// (`PG_WALK_DIRECTORY_KIND_FILE`) and/or subdirectories
+// (`PG_WALK_DIRECTORY_KIND_DIRECTORY`) being created, modified or deleted.
+// Only directories get a watch: the state of their entries is kept, hashed by
+// name, to find what changed when the directory reports a change, so that
+// watching a tree costs a watch per directory instead of per file.
+// The events are read with `pg_aio_fs_wait`. Watching a directory again is a
+// noop. `allocator` holds the state and must outlive the watch.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_aio_register_watch_directory(PgAio *aio, PgString name,
+                                PgWalkDirectoryOption options,
+                                PgAllocator *allocator) {
+  return pg_aio_fs_watch_directory(aio, name, options, allocator, nullptr,
+                                   nullptr);
+}
 
-  if (u.port) {
-    PG_DYN_APPEND_SLICE(&sb, PG_S(":"), allocator);
-    pg_string_builder_append_u64(&sb, u.port, allocator);
+#ifndef PG_SYNC_FUTEX
+[[maybe_unused]] [[nodiscard]] PgError pg_mtx_init(PgMutex *mutex,
+                                                   PgMutexKind type) {
+  pthread_mutexattr_t attr = {0};
+  i32 err = pthread_mutexattr_init(&attr);
+  if (err) {
+    return err;
   }
 
-  PG_EACH_PTR(it, &u.path_components) {
-    PG_DYN_APPEND_SLICE(&sb, PG_S("/"), allocator);
-    PG_DYN_APPEND_SLICE(&sb, *it, allocator);
+  if (PG_MUTEX_KIND_RECURSIVE == type) {
+    err = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    if (err) {
+      goto end;
+    }
   }
 
-  if (u.query_parameters.len) {
-    PG_DYN_APPEND_SLICE(&sb, PG_S("?"), allocator);
-
-    PG_EACH_PTR(it, &u.query_parameters) {
-      if (it->key.len) {
-        PG_DYN_APPEND_SLICE(&sb, it->key, allocator);
-      }
-      if (it->key.len && it->value.len) {
-        PG_DYN_APPEND_SLICE(&sb, PG_S("="), allocator);
-      }
-      if (it->value.len) {
-        PG_DYN_APPEND_SLICE(&sb, it->value, allocator);
-      }
+  err = pthread_mutex_init(mutex, &attr);
 
-      PG_DYN_APPEND_SLICE(&sb, PG_S("&"), allocator);
-    }
+end:
+  i32 fin_err = pthread_mutexattr_destroy(&attr);
+  if (fin_err) {
+    return err ? err : fin_err;
   }
 
-  return PG_DYN_TO_SLICE(PgString, sb);
+  return (PgError)err;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_DYN(PgStringKeyValue),
-                                                PgError)
-    pg_url_parse_query_parameters(PgString s, PgAllocator *allocator) {
-  PG_DYN(PgStringKeyValue) res = {0};
+[[maybe_unused]] void pg_mtx_destroy(PgMutex *mutex) {
+  pthread_mutex_destroy(mutex);
+}
 
-  PgString remaining = s;
-  {
-    PG_OPTION(PgString) consume_question_opt = pg_string_consume_rune(s, '?');
-    if (!consume_question_opt.has_value) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PgStringKeyValue), PgError);
-    }
-    remaining = consume_question_opt.value;
+[[maybe_unused]] [[nodiscard]] PgError pg_mtx_lock(PgMutex *mutex) {
+  i32 ret = pthread_mutex_lock(mutex);
+  if (0 != ret) {
+    return (PgError)ret;
   }
 
-  for (u64 _i = 0; _i < s.len; _i++) {
-    PgStringPairConsume res_consume_and =
-        pg_string_consume_until_rune_incl(remaining, '&');
-    remaining = res_consume_and.right;
-
-    PgString kv = res_consume_and.left;
-    PgStringPairConsume res_consume_eq =
-        pg_string_consume_until_rune_incl(kv, '=');
-    PgString k = res_consume_eq.left;
-    PgString v = res_consume_eq.consumed ? res_consume_eq.right : PG_S("");
-
-    if (!PG_SLICE_IS_EMPTY(k)) {
-      PG_DYN_PUSH(&res, ((PgStringKeyValue){.key = k, .value = v}), allocator);
-    }
+  return 0;
+}
 
-    if (!res_consume_and.consumed) {
-      break;
-    }
+[[maybe_unused]] [[nodiscard]] PgError pg_mtx_trylock(PgMutex *mutex) {
+  i32 ret = pthread_mutex_trylock(mutex);
+  if (0 != ret) {
+    return (PgError)ret;
   }
 
-  return PG_OK(res, PG_DYN(PgStringKeyValue), PgError);
+  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrlUserInfo, PgError)
-    pg_url_parse_user_info(PgString s) {
-  PG_RESULT(PgUrlUserInfo, PgError) res = {0};
-  // https://www.rfc-editor.org/rfc/rfc3986#section-3.2.1:
-  // Use of the format "user:password" in the userinfo field is
-  // deprecated.  Applications should not render as clear text any data
-  // after the first colon (":") character found within a userinfo
-  // subcomponent unless the data after the colon is the empty string
-  // (indicating no password).  Applications may choose to ignore or
-  // reject such data when it is received.
+#if 0
+// TODO
+[[maybe_unused]][[nodiscard]] PgError pg_mtx_timedlock(PgMutex *mutex, const struct timespec *time_point);
+#endif
 
-  if (PG_SLICE_IS_EMPTY(s)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlUserInfo, PgError);
+[[maybe_unused]] [[nodiscard]] PgError pg_mtx_unlock(PgMutex *mutex) {
+  i32 ret = pthread_mutex_unlock(mutex);
+  if (0 != ret) {
+    return (PgError)ret;
   }
 
-  return res;
+  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u16, PgError)
-    pg_url_parse_port(PgString s) {
-  // Allowed.
-  if (PG_SLICE_IS_EMPTY(s)) {
-    return PG_OK(0, u16, PgError);
-  }
-
-  PgParseNumberResult port_parse = pg_string_parse_u64(s, 10, true);
-  if (!PG_SLICE_IS_EMPTY(port_parse.remaining)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, u16, PgError);
-  }
-  if (port_parse.n > UINT16_MAX) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, u16, PgError);
+[[maybe_unused]] [[nodiscard]] PgError pg_cnd_init(PgConditionVar *cond) {
+  i32 ret = pthread_cond_init(cond, nullptr);
+  if (0 != ret) {
+    return (PgError)ret;
   }
 
-  return PG_OK((u16)port_parse.n, u16, PgError);
+  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrlAuthority, PgError)
-    pg_url_parse_authority(PgString s) {
-  PgUrlAuthority res = {0};
-
-  PgString remaining = s;
-  // User info, optional.
-  {
-    PgStringPairConsume user_info_and_rem =
-        pg_string_consume_until_rune_incl(remaining, '@');
-    remaining = user_info_and_rem.right;
+[[maybe_unused]] void pg_cnd_destroy(PgConditionVar *cond) {
+  pthread_cond_destroy(cond);
+}
 
-    if (user_info_and_rem.consumed) {
-      PG_RESULT(PgUrlUserInfo, PgError)
-      res_user_info = pg_url_parse_user_info(user_info_and_rem.left);
-      PG_IF_LET_ERR(err, res_user_info) {
-        return PG_ERR(err, PgUrlAuthority, PgError);
-      }
-      res.user_info = PG_UNWRAP(res_user_info);
-    }
+[[maybe_unused]] [[nodiscard]] PgError pg_cnd_wait(PgConditionVar *cond,
+                                                   PgMutex *mutex) {
+  i32 ret = pthread_cond_wait(cond, mutex);
+  if (0 != ret) {
+    return (PgError)ret;
   }
 
-  // Host, mandatory.
-  PgStringPairConsume host_and_rem =
-      pg_string_consume_until_rune_incl(remaining, ':');
-  {
-    remaining = host_and_rem.right;
-    res.host = host_and_rem.left;
-    if (PG_SLICE_IS_EMPTY(res.host)) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlAuthority, PgError);
-    }
-  }
+  return 0;
+}
 
-  // Port, optional.
-  if (host_and_rem.consumed) {
-    PG_RESULT(u16, PgError) res_port = pg_url_parse_port(host_and_rem.right);
-    PG_IF_LET_ERR(err, res_port) {
-      return PG_ERR(err, PgUrlAuthority, PgError);
-    }
-    res.port = PG_UNWRAP(res_port);
+[[maybe_unused]] [[nodiscard]] PgError pg_cnd_broadcast(PgConditionVar *cond) {
+  i32 ret = pthread_cond_broadcast(cond);
+  if (0 != ret) {
+    return (PgError)ret;
   }
 
-  return PG_OK(res, PgUrlAuthority, PgError);
+  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static bool
-pg_url_is_scheme_valid(PgString scheme) {
-  if (PG_SLICE_IS_EMPTY(scheme)) {
-    return false;
+[[maybe_unused]] [[nodiscard]] PgError pg_cnd_signal(PgConditionVar *cond) {
+  i32 ret = pthread_cond_signal(cond);
+  if (0 != ret) {
+    return (PgError)ret;
   }
 
-  u8 first = PG_SLICE_AT(scheme, 0);
-  if (!pg_rune_ascii_is_alphabetical(first)) {
-    return false;
-  }
+  return 0;
+}
 
-  PG_EACH_PTR(c, &scheme) {
-    if (!(pg_rune_ascii_is_alphanumeric(*c) || *c == '+' || *c == '-' ||
-          *c == '.')) {
-      return false;
-    }
+[[maybe_unused]] [[nodiscard]] PgError
+pg_cnd_timedwait(PgConditionVar *cond, PgMutex *mutex,
+                 const PgTime *time_point) {
+  struct timespec ts = {
+      .tv_sec = (time_t)time_point->seconds,
+      .tv_nsec = (long)time_point->nanoseconds,
+  };
+  i32 ret = pthread_cond_timedwait(cond, mutex, &ts);
+  if (0 != ret) {
+    return (PgError)ret;
   }
 
-  return true;
+  return 0;
 }
+#endif
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrl, PgError)
-    pg_url_parse_after_authority(PgString s, PgAllocator *allocator) {
-  PgUrl res = {0};
-  PgString remaining = s;
-
-  PgStringPairConsumeAny path_components_and_rem =
-      pg_string_consume_until_any_rune_excl(remaining, PG_S("?#"));
-  remaining = path_components_and_rem.right;
-
-  // Path, optional.
-  if (pg_string_starts_with(s, PG_S("/"))) {
-    PG_ASSERT(!PG_SLICE_IS_EMPTY(path_components_and_rem.left));
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgThread, PgError)
+    pg_thread_create(PgThreadFn fn, void *fn_data) {
+  PgThread thread = {0};
 
-    PG_RESULT(PG_DYN(PgString), PgError)
-    res_path_components =
-        pg_url_parse_path_components(path_components_and_rem.left, allocator);
-    PG_IF_LET_ERR(err, res_path_components) {
-      return PG_ERR(err, PgUrl, PgError);
-    }
-    res.path_components = PG_UNWRAP(res_path_components);
+  i32 ret = pthread_create(&thread, nullptr, (void *(*)(void *))fn, fn_data);
+  if (-1 == ret) {
+    return PG_ERR(errno, PgThread, PgError);
   }
 
-  // Query parameters, optional.
-  if (path_components_and_rem.consumed &&
-      path_components_and_rem.matched == '?') {
-    PG_RESULT(PG_DYN(PgStringKeyValue), PgError)
-    res_query =
-        pg_url_parse_query_parameters(path_components_and_rem.right, allocator);
-    PG_IF_LET_ERR(err, res_query) { return PG_ERR(err, PgUrl, PgError); }
-    res.query_parameters = PG_UNWRAP(res_query);
+  return PG_OK(thread, PgThread, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] PgError pg_thread_join(PgThread thread) {
+  i32 ret = pthread_join(thread, nullptr);
+  if (-1 == ret) {
+    return (PgError)errno;
   }
 
-  // TODO: fragments.
+  return 0;
+}
 
-  PG_ASSERT(PG_SLICE_IS_EMPTY(res.scheme));
-  PG_ASSERT(PG_SLICE_IS_EMPTY(res.username));
-  PG_ASSERT(PG_SLICE_IS_EMPTY(res.password));
-  PG_ASSERT(PG_SLICE_IS_EMPTY(res.host));
-  PG_ASSERT(0 == res.port);
-
-  return PG_OK(res, PgUrl, PgError);
-}
-
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrl, PgError)
-    pg_url_parse(PgString s, PgAllocator *allocator) {
-  PgUrl res = {0};
-
-  PgString remaining = s;
-
-  // Scheme, mandatory.
-  {
-    PgStringPairConsume scheme_and_rem =
-        pg_string_consume_until_rune_incl(remaining, ':');
-    remaining = scheme_and_rem.right;
-
-    if (!scheme_and_rem.consumed) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgUrl, PgError);
-    }
-
-    if (!pg_url_is_scheme_valid(scheme_and_rem.left)) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgUrl, PgError);
-    }
-    res.scheme = scheme_and_rem.left;
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_PAIR(PgFileDescriptor),
+                                                PgError)
+    pg_net_make_socket_pair(PgNetSocketDomain domain, PgNetSocketType type,
+                            PgNetSocketOption option) {
+  i32 unix_domain = 0;
+  switch (domain) {
+  case PG_NET_SOCKET_DOMAIN_LOCAL:
+    unix_domain = AF_LOCAL;
+    break;
+  case PG_NET_SOCKET_DOMAIN_IPV4:
+    unix_domain = AF_INET;
+    break;
+  case PG_NET_SOCKET_DOMAIN_IPV6:
+    unix_domain = AF_INET6;
+    break;
+  default:
+    PG_ASSERT(0);
   }
 
-  // Assume `://` as separator between the scheme and authority.
-  // TODO: Be less strict hier.
-  {
-
-    PG_OPTION(PgString)
-    res_consume = pg_string_consume_string(remaining, PG_S("//"));
-    if (!res_consume.has_value) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgUrl, PgError);
-    }
-    remaining = res_consume.value;
+  i32 unix_type = 0;
+  switch (type) {
+  case PG_NET_SOCKET_TYPE_TCP:
+    unix_type = SOCK_STREAM;
+    break;
+  case PG_NET_SOCKET_TYPE_UDP:
+    unix_type = SOCK_DGRAM;
+    break;
+  default:
+    PG_ASSERT(0);
   }
 
-  // Authority, mandatory.
-  PgStringPairConsumeAny authority_and_rem =
-      pg_string_consume_until_any_rune_excl(remaining, PG_S("/?#"));
-  remaining = authority_and_rem.right;
-  {
-    if (PG_SLICE_IS_EMPTY(authority_and_rem.left)) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgUrl, PgError);
-    }
-
-    PG_RESULT(PgUrlAuthority, PgError)
-    res_authority = pg_url_parse_authority(authority_and_rem.left);
-    PG_IF_LET_ERR(err, res_authority) { return PG_ERR(err, PgUrl, PgError); }
-    PgUrlAuthority auth = PG_UNWRAP(res_authority);
-    res.host = auth.host;
-    res.port = auth.port;
-    res.username = auth.user_info.username;
-    res.password = auth.user_info.password;
+  i32 unix_option = 0;
+  switch (option) {
+  case PG_NET_SOCKET_OPTION_NONE:
+  default:
   }
 
-  PgUrl after_auth = PG_TRY(pg_url_parse_after_authority(remaining, allocator),
-                            PgUrl, PgError);
-
-  res.path_components = after_auth.path_components;
-  res.query_parameters = after_auth.query_parameters;
+  i32 fds[2] = {0};
+  i32 ret = socketpair(unix_domain, unix_type, unix_option, fds);
+  if (-1 == ret) {
+    return PG_ERR(errno, PG_PAIR(PgFileDescriptor), PgError);
+  }
 
-  return PG_OK(res, PgUrl, PgError);
+  PG_PAIR(PgFileDescriptor) pair = {.first.fd = fds[0], .second.fd = fds[1]};
+  return PG_OK(pair, PG_PAIR(PgFileDescriptor), PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static bool pg_http_url_is_valid(PgUrl u) {
-  // TODO: Support https.
-  if (!pg_string_eq(u.scheme, PG_S("http"))) {
-    return false;
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_PAIR(PgFileDescriptor),
+                                                PgError) pg_pipe_make() {
+  int fds[2] = {0};
+  int ret = pipe(fds);
+  if (-1 == ret) {
+    return PG_ERR(errno, PG_PAIR(PgFileDescriptor), PgError);
   }
 
-  return true;
+  PG_PAIR(PgFileDescriptor)
+  pair = {.first.fd = fds[PG_PIPE_READ], .second.fd = fds[PG_PIPE_WRITE]};
+  return PG_OK(pair, PG_PAIR(PgFileDescriptor), PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHttpRequestStatusLine,
-                                                PgError)
-    pg_http_parse_request_status_line(PgString status_line,
-                                      PgAllocator *allocator) {
-  PgHttpRequestStatusLine res = {0};
-
-  PgStringCut cut = pg_string_cut_rune(status_line, ' ');
-  if (!cut.has_value) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+[[nodiscard]] static PgError pg_process_avoid_child_zombies() {
+  struct sigaction handler = {.sa_handler = SIG_IGN};
+  int ret = sigaction(SIGCHLD, &handler, nullptr);
+  if (-1 == ret) {
+    return (PgError)errno;
   }
 
-  // Method.
-  {
-    PgString method = pg_string_trim_space(cut.left);
-    if (pg_string_eq(method, PG_S("OPTIONS"))) {
-      res.method = PG_HTTP_METHOD_OPTIONS;
-    } else if (pg_string_eq(method, PG_S("GET"))) {
-      res.method = PG_HTTP_METHOD_GET;
-    } else if (pg_string_eq(method, PG_S("HEAD"))) {
-      res.method = PG_HTTP_METHOD_HEAD;
-    } else if (pg_string_eq(method, PG_S("POST"))) {
-      res.method = PG_HTTP_METHOD_POST;
-    } else if (pg_string_eq(method, PG_S("PUT"))) {
-      res.method = PG_HTTP_METHOD_PUT;
-    } else if (pg_string_eq(method, PG_S("DELETE"))) {
-      res.method = PG_HTTP_METHOD_DELETE;
-    } else if (pg_string_eq(method, PG_S("TRACE"))) {
-      res.method = PG_HTTP_METHOD_TRACE;
-    } else if (pg_string_eq(method, PG_S("CONNECT"))) {
-      res.method = PG_HTTP_METHOD_CONNECT;
-    } else {
-      res.method = PG_HTTP_METHOD_EXTENSION;
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static u64 pg_process_reap_children() {
+  u64 res = 0;
+  for (;;) {
+    i32 ret = waitpid(-1, nullptr, WNOHANG);
+    if (ret > 0) {
+      res += 1;
+    } else if (!(-1 == ret && EINTR == errno)) {
+      return res;
     }
   }
+}
 
-  // Path.
-  cut = pg_string_cut_rune(cut.right, ' ');
-  {
-    PgString path = pg_string_trim_space(cut.left);
-    // Need to clone since the data being parsed is transient.
-    path = pg_string_clone(path, allocator);
-    PG_RESULT(PgUrl, PgError)
-    res_url = pg_url_parse_after_authority(path, allocator);
-    PG_IF_LET_ERR(err, res_url) {
-      return PG_ERR(err, PgHttpRequestStatusLine, PgError);
-    }
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u32, PgError) pg_process_dup() {
+  i32 pid = fork();
 
-    res.url = PG_UNWRAP(res_url);
+  if (-1 == pid) {
+    return PG_ERR(errno, u32, PgError);
   }
 
-  PgString remaining = pg_string_trim_space(cut.right);
-  {
-    PG_OPTION(PgString)
-    consume_opt = pg_string_consume_string(remaining, PG_S("HTTP/"));
-    if (!consume_opt.has_value) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
-    }
-    remaining = consume_opt.value;
-  }
+  return PG_OK((u32)pid, u32, PgError);
+}
 
-  {
-    PgParseNumberResult res_major = pg_string_parse_u64(remaining, 10, true);
-    if (!res_major.present) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
-    }
-    if (res_major.n > 3) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
-    }
-    res.version_major = (u8)res_major.n;
-    remaining = res_major.remaining;
-  }
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_socket_set_timeout(PgFileDescriptor sock, u64 seconds,
+                          u64 microseconds) {
+  struct timeval timeout = {0};
+  timeout.tv_sec = (time_t)seconds;
+  timeout.tv_usec = (i32)microseconds;
 
-  {
-    PG_OPTION(PgString) consume_opt = pg_string_consume_rune(remaining, '.');
-    if (!consume_opt.has_value) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
-    }
-    remaining = consume_opt.value;
+  i32 ret =
+      setsockopt(sock.fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  if (-1 == ret) {
+    return (PgError)errno;
   }
+  return 0;
+}
 
-  {
-    PgParseNumberResult res_minor = pg_string_parse_u64(remaining, 10, true);
-    if (!res_minor.present) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
-    }
-    if (res_minor.n > 9) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
-    }
-    res.version_minor = (u8)res_minor.n;
-    remaining = res_minor.remaining;
-  }
+[[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_net_create_tcp_socket_ip(PgIpFamily family) {
+  int domain = PG_IP_FAMILY_V4 == family ? AF_INET : AF_INET6;
+  i32 sock_fd = 0;
+  do {
+    sock_fd = socket(domain, SOCK_STREAM, 0);
+  } while (-1 == sock_fd && EINTR == errno);
 
-  if (!PG_SLICE_IS_EMPTY(remaining)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+  if (-1 == sock_fd) {
+    return PG_ERR(errno, PgFileDescriptor, PgError);
   }
 
-  return PG_OK(res, PgHttpRequestStatusLine, PgError);
+  PgFileDescriptor fd = {.fd = sock_fd};
+  return PG_OK(fd, PgFileDescriptor, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgStringKeyValue, PgError)
-    pg_http_parse_header(PgString s) {
-  PgStringKeyValue res = {0};
-
-  PgStringCut cut = pg_string_cut_rune(s, ':');
-  if (!cut.has_value) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgStringKeyValue, PgError);
-  }
+[[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_net_create_tcp_socket() {
+  return pg_net_create_tcp_socket_ip(PG_IP_FAMILY_V4);
+}
 
-  res.key = pg_string_trim_space(cut.left);
-  if (pg_string_is_empty(res.key)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgStringKeyValue, PgError);
-  }
+[[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_net_create_udp_socket_ip(PgIpFamily family) {
+  int domain = PG_IP_FAMILY_V4 == family ? AF_INET : AF_INET6;
+  i32 sock_fd = 0;
+  do {
+    sock_fd = socket(domain, SOCK_DGRAM, 0);
+  } while (-1 == sock_fd && EINTR == errno);
 
-  res.value = pg_string_trim_space(cut.right);
-  if (pg_string_is_empty(res.value)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgStringKeyValue, PgError);
+  if (-1 == sock_fd) {
+    return PG_ERR(errno, PgFileDescriptor, PgError);
   }
 
-  return PG_OK(res, PgStringKeyValue, PgError);
+  PgFileDescriptor fd = {.fd = sock_fd};
+  return PG_OK(fd, PgFileDescriptor, PgError);
 }
 
-typedef enum {
-  PG_NEWLINE_KIND_LF,
-  PG_NEWLINE_KIND_CRLF,
-} PgNewlineKind;
+[[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_net_create_udp_socket() {
+  return pg_net_create_udp_socket_ip(PG_IP_FAMILY_V4);
+}
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_OPTION(u64), PgError)
-    pg_reader_read_until_byte_incl(PgReader *r, PG_SLICE(u8) dst, u8 needle) {
-  PG_ASSERT(dst.data);
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_udp_send_to(PgFileDescriptor sock, PgString data,
+                       PgIpv4Address address) {
+  struct sockaddr_in addr = {
+      .sin_family = AF_INET,
+      .sin_port = htons(address.port),
+      .sin_addr = {htonl(address.ip)},
+  };
 
-  if (0 == r->ring.data.len) { // Simple reader.
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_slice(r, dst);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(u64), PgError);
-    }
+  i64 n = 0;
+  do {
+    n = sendto(sock.fd, data.data, data.len, MSG_NOSIGNAL,
+               (struct sockaddr *)&addr, sizeof(addr));
+  } while (-1 == n && EINTR == errno);
 
-    u64 read_count = PG_UNWRAP(res_read);
+  if (n < 0) {
+    return PG_ERR(errno, u64, PgError);
+  }
 
-    PG_SLICE(u8) haystack = PG_SLICE_RANGE(dst, 0, read_count);
-    PG_OPTION(u64) search_opt = pg_bytes_index_of_byte(haystack, needle);
+  return PG_OK((u64)n, u64, PgError);
+}
 
-    return PG_OK(search_opt, PG_OPTION(u64), PgError);
-  } else { // Buffered reader.
-    PG_ASSERT(dst.len >= r->ring.data.len);
+// One datagram, truncated to `dst`.
+[[nodiscard]] static PgIpv4AddressRecvResult
+pg_net_udp_recv_from(PgFileDescriptor sock, PgString dst) {
+  PgIpv4AddressRecvResult res = {0};
 
-    for (u64 _i = 0; _i <= 1; _i++) {
-      PG_RESULT(PG_OPTION(u64), PgError) res = {0};
-      PG_OPTION(u64) search_opt = pg_ring_index_of_byte(r->ring, needle);
-      if (search_opt.has_value) {
-        search_opt.value += 1; // Incl.
-        PG_ASSERT(pg_ring_read_bytes(
-                      &r->ring, PG_SLICE_RANGE(dst, 0, search_opt.value)) ==
-                  search_opt.value);
-
-        return PG_OK(search_opt, PG_OPTION(u64), PgError);
-      }
-
-      // Do not overwrite data.
-      if (pg_ring_is_full(r->ring)) {
-        return PG_ERR(PG_ERR_TOO_BIG, PG_OPTION(u64), PgError);
-      }
-
-      // TODO: Should we do multiple reads?
-      u64 ring_size_before = pg_ring_can_read_count(r->ring);
-      PgError err = pg_buf_reader_try_fill_once(r);
-      if (err) {
-        return PG_ERR(err, PG_OPTION(u64), PgError);
-      }
+  struct sockaddr_in addr = {0};
+  socklen_t addr_len = sizeof(addr);
+  i64 n = 0;
+  do {
+    n = recvfrom(sock.fd, dst.data, dst.len, 0, (struct sockaddr *)&addr,
+                 &addr_len);
+  } while (-1 == n && EINTR == errno);
 
-      u64 ring_size_after = pg_ring_can_read_count(r->ring);
-      if (ring_size_before == ring_size_after) {
-        // Fill failed, stop.
-        return res;
-      }
-    }
-    PG_ASSERT(0);
+  if (n < 0) {
+    res.err = (PgError)errno;
+    return res;
   }
-}
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_OPTION(u64), PgError)
-    pg_reader_read_until_bytes2_incl(PgReader *r, PG_SLICE(u8) dst, u8 needle0,
-                                     u8 needle1) {
-  PG_ASSERT(dst.data);
+  res.len = (u64)n;
+  res.address.ip = ntohl(addr.sin_addr.s_addr);
+  res.address.port = ntohs(addr.sin_port);
+  return res;
+}
 
-  if (0 == r->ring.data.len) { // Simple reader.
-    // TODO: Multiple reads?
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_slice(r, dst);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(u64), PgError);
-    }
+[[nodiscard]]
+static PgError pg_net_socket_close(PgFileDescriptor sock) {
+  return pg_file_close(sock);
+}
 
-    u64 read_count = PG_UNWRAP(res_read);
-    u8 needle_data[2] = {needle0, needle1};
-    PG_SLICE(u8) needle = {.data = needle_data, .len = 2};
-    PG_SLICE(u8) haystack = PG_SLICE_RANGE(dst, 0, read_count);
-    PG_OPTION(u64) search_opt = pg_bytes_index_of_bytes(haystack, needle);
+[[nodiscard]]
+static PgError pg_net_set_nodelay(PgFileDescriptor sock, bool enabled) {
+  int opt = enabled;
+  int ret = 0;
+  do {
+    ret = setsockopt(sock.fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+  } while (-1 == ret && EINTR == errno);
 
-    return PG_OK(search_opt, PG_OPTION(u64), PgError);
-  } else {
-    PG_ASSERT(dst.len >= r->ring.data.len);
+  if (-1 == ret) {
+    return (PgError)errno;
+  }
 
-    for (u64 _i = 0; _i <= 1; _i++) {
-      PG_RESULT(PG_OPTION(u64), PgError) res = {0};
-      PG_OPTION(u64)
-      search_opt = pg_ring_index_of_bytes2(r->ring, needle0, needle1);
-      if (search_opt.has_value) {
-        search_opt.value += 2; // Incl.
-        PG_ASSERT(pg_ring_read_bytes(
-                      &r->ring, PG_SLICE_RANGE(dst, 0, search_opt.value)) ==
-                  search_opt.value);
-        return PG_OK(search_opt, PG_OPTION(u64), PgError);
-      }
+  return 0;
+}
 
-      // Do not overwrite data.
-      if (pg_ring_is_full(r->ring)) {
-        return PG_ERR(PG_ERR_TOO_BIG, PG_OPTION(u64), PgError);
-      }
+[[nodiscard]]
+static u64 pg_net_tcp_queue_time_ms(PgFileDescriptor sock) {
+#ifdef PG_OS_LINUX
+  struct tcp_info info = {0};
+  socklen_t len = sizeof(info);
+  if (-1 == getsockopt(sock.fd, IPPROTO_TCP, TCP_INFO, &info, &len)) {
+    return 0;
+  }
+  return info.tcpi_last_data_recv;
+#else
+  PG_UNUSED(sock);
+  return 0;
+#endif
+}
 
-      // TODO: Should we do multiple reads?
-      u64 ring_size_before = pg_ring_can_read_count(r->ring);
-      PgError err = pg_buf_reader_try_fill_once(r);
-      if (err) {
-        return PG_ERR(err, PG_OPTION(u64), PgError);
-      }
+// While corked, partial segments are held back so that e.g. the response
+// headers and the start of the body go out together. Uncorking sends what is
+// pending.
+[[nodiscard]]
+static PgError pg_net_set_cork(PgFileDescriptor sock, bool enabled) {
+#if defined(TCP_CORK)
+  int opt_name = TCP_CORK;
+#else
+  int opt_name = TCP_NOPUSH;
+#endif
+  int opt = enabled;
+  int ret = 0;
+  do {
+    ret = setsockopt(sock.fd, IPPROTO_TCP, opt_name, &opt, sizeof(opt));
+  } while (-1 == ret && EINTR == errno);
 
-      u64 ring_size_after = pg_ring_can_read_count(r->ring);
-      if (ring_size_before == ring_size_after) {
-        // Fill failed, stop.
-        return res;
-      }
-    }
-    PG_ASSERT(0);
+  if (-1 == ret) {
+    return (PgError)errno;
   }
+
+  return 0;
 }
 
-[[nodiscard]] static PG_RESULT(PG_OPTION(u64), PgError)
-    pg_reader_read_line(PgReader *reader, PgNewlineKind newline_kind,
-                        PgString dst) {
-  PG_OPTION(u64) read_count_opt = {0};
+[[nodiscard]] static socklen_t
+pg_net_ip_address_to_sockaddr(PgIpAddress address,
+                              struct sockaddr_storage *dst) {
+  *dst = (struct sockaddr_storage){0};
 
-  switch (newline_kind) {
-  case PG_NEWLINE_KIND_LF:
-    read_count_opt = PG_TRY(pg_reader_read_until_byte_incl(reader, dst, '\n'),
-                            PG_OPTION(u64), PgError);
-    break;
-  case PG_NEWLINE_KIND_CRLF:
-    read_count_opt =
-        PG_TRY(pg_reader_read_until_bytes2_incl(reader, dst, '\r', '\n'),
-               PG_OPTION(u64), PgError);
-    break;
-  default:
-    PG_ASSERT(0);
+  if (PG_IP_FAMILY_V4 == address.family) {
+    struct sockaddr_in *addr = (struct sockaddr_in *)(void *)dst;
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(address.port);
+    addr->sin_addr.s_addr = htonl(address.ipv4);
+    return sizeof(*addr);
   }
 
-  if (!read_count_opt.has_value) {
-    return PG_OK(read_count_opt, PG_OPTION(u64), PgError);
-  }
+  struct sockaddr_in6 *addr = (struct sockaddr_in6 *)(void *)dst;
+  addr->sin6_family = AF_INET6;
+  addr->sin6_port = htons(address.port);
+  pg_memcpy(addr->sin6_addr.s6_addr, address.ipv6, sizeof(address.ipv6));
+  return sizeof(*addr);
+}
 
-  switch (newline_kind) {
-  case PG_NEWLINE_KIND_LF: {
-    PG_ASSERT(read_count_opt.value >= 1);
-    PG_ASSERT('\n' == PG_SLICE_AT(dst, read_count_opt.value - 1));
-    // Trim.
-    read_count_opt.value -= 1;
-  } break;
-  case PG_NEWLINE_KIND_CRLF: {
-    PG_ASSERT(read_count_opt.value >= 2);
-    PG_ASSERT('\r' == PG_SLICE_AT(dst, read_count_opt.value - 2));
-    PG_ASSERT('\n' == PG_SLICE_AT(dst, read_count_opt.value - 1));
-    // Trim.
-    read_count_opt.value -= 2;
-  } break;
-  default:
-    PG_ASSERT(0);
+// An IPv4-mapped IPv6 address, as accepted by a dual-stack socket, is
+// reported as IPv4.
+[[nodiscard]] static PgIpAddress
+pg_net_ip_address_from_sockaddr(const struct sockaddr_storage *src) {
+  PgIpAddress res = {0};
+
+  if (AF_INET == src->ss_family) {
+    const struct sockaddr_in *addr = (const struct sockaddr_in *)(void *)src;
+    res.family = PG_IP_FAMILY_V4;
+    res.ipv4 = ntohl(addr->sin_addr.s_addr);
+    res.port = ntohs(addr->sin_port);
+    return res;
   }
 
-  return PG_OK(read_count_opt, PG_OPTION(u64), PgError);
+  PG_ASSERT(AF_INET6 == src->ss_family);
+  const struct sockaddr_in6 *addr = (const struct sockaddr_in6 *)(void *)src;
+  res.port = ntohs(addr->sin6_port);
+  if (IN6_IS_ADDR_V4MAPPED(&addr->sin6_addr)) {
+    res.family = PG_IP_FAMILY_V4;
+    const u8 *bytes = addr->sin6_addr.s6_addr;
+    res.ipv4 = (u32)bytes[12] << 24 | (u32)bytes[13] << 16 |
+               (u32)bytes[14] << 8 | (u32)bytes[15];
+  } else {
+    res.family = PG_IP_FAMILY_V6;
+    pg_memcpy(res.ipv6, addr->sin6_addr.s6_addr, sizeof(res.ipv6));
+  }
+  return res;
 }
 
-#define PG_HTTP_LINE_MAX_LEN 4096
-#define PG_HTTP_HEADERS_MAX 512
+[[nodiscard]]
+static PgError pg_net_connect_ip(PgFileDescriptor sock, PgIpAddress address) {
+  struct sockaddr_storage addr = {0};
+  socklen_t addr_len = pg_net_ip_address_to_sockaddr(address, &addr);
 
-[[maybe_unused]] [[nodiscard]] static PgHttpRequestReadResult
-pg_http_read_request(PgReader *reader, PgAllocator *allocator) {
-  PgHttpRequestReadResult res = {0};
+  int ret = 0;
+  do {
+    ret = connect(sock.fd, (struct sockaddr *)&addr, addr_len);
+  } while (-1 == ret && EINTR == errno);
 
-  u8 recv[PG_HTTP_LINE_MAX_LEN] = {0};
-  PG_SLICE(u8)
-  recv_slice = {
-      .data = recv,
-      .len = PG_HTTP_LINE_MAX_LEN,
-  };
-  // Status line.
-  {
-    PG_RESULT(PG_OPTION(u64), PgError)
-    res_read = pg_reader_read_line(reader, PG_NEWLINE_KIND_CRLF, recv_slice);
-    PG_IF_LET_ERR(err, res_read) {
-      res.err = err;
-      return res;
-    }
-    PG_OPTION(u64) read_opt = PG_UNWRAP(res_read);
-    if (!read_opt.has_value) {
-      res.err = PG_ERR_EOF;
-      return res;
+  if (-1 == ret) {
+    if (EINPROGRESS != errno) {
+      return (PgError)errno;
     }
+  }
 
-    PgString line = PG_SLICE_RANGE(recv_slice, 0, read_opt.value);
+  return 0;
+}
 
-    PG_RESULT(PgHttpRequestStatusLine, PgError)
-    res_status_line = pg_http_parse_request_status_line(line, allocator);
+[[nodiscard]]
+static PgError pg_net_connect_ipv4(PgFileDescriptor sock,
+                                   PgIpv4Address address) {
+  return pg_net_connect_ip(sock, pg_ip_address_from_ipv4(address));
+}
 
-    PG_IF_LET_ERR(err, res_status_line) {
-      res.err = err;
-      return res;
-    }
-    PgHttpRequestStatusLine status_line = PG_UNWRAP(res_status_line);
-    res.req.method = status_line.method;
-    res.req.url = status_line.url;
-    res.req.version_major = status_line.version_major;
-    res.req.version_minor = status_line.version_minor;
-  }
+[[maybe_unused]] [[nodiscard]]
+static PG_RESULT(PgIpv4AddressSocket, PgError)
+    pg_net_dns_resolve_ipv4_tcp(PgString host, u16 port,
+                                PgAllocator *allocator) {
+  PG_RESULT(PgIpv4AddressSocket, PgError) res = {0};
 
-  // Headers.
-  for (u64 i = 0; i < PG_HTTP_HEADERS_MAX; i++) {
-    recv_slice.len = PG_STATIC_ARRAY_LEN(recv);
-    PG_RESULT(PG_OPTION(u64), PgError)
-    res_read = pg_reader_read_line(reader, PG_NEWLINE_KIND_CRLF, recv_slice);
-    PG_IF_LET_ERR(err, res_read) {
-      res.err = err;
-      return res;
-    }
-    PG_OPTION(u64) read_opt = PG_UNWRAP(res_read);
-    if (!read_opt.has_value) {
-      res.err = PG_ERR_EOF;
-      return res;
-    }
+  struct addrinfo hints = {0};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_protocol = IPPROTO_TCP;
 
-    PgString line = PG_SLICE_RANGE(recv_slice, 0, read_opt.value);
+  // The port is set on each address rather than formatted for
+  // `getaddrinfo`.
+  struct addrinfo *addr_info = nullptr;
+  int res_getaddrinfo = 0;
+  do {
+    res_getaddrinfo = getaddrinfo(pg_string_to_cstr(host, allocator), nullptr,
+                                  &hints, &addr_info);
+  } while (EAI_SYSTEM == res_getaddrinfo && EINTR == errno);
 
-    if (0 == line.len) { // `\r\n\r\n`.
-      goto end;
-    }
+  if (0 != res_getaddrinfo) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgIpv4AddressSocket, PgError);
+  }
 
-    PG_RESULT(PgStringKeyValue, PgError)
-    res_kv = pg_http_parse_header(pg_string_clone(line, allocator));
-    PG_IF_LET_ERR(err, res_kv) {
-      res.err = err;
-      return res;
+  struct addrinfo *rp = nullptr;
+  for (rp = addr_info; rp != nullptr; rp = rp->ai_next) {
+    PG_RESULT(PgFileDescriptor, PgError)
+    res_create_socket = pg_net_create_tcp_socket();
+    if (PG_IS_ERR(res_create_socket)) {
+      res = PG_ERR(PG_UNWRAP_ERR(res_create_socket), PgIpv4AddressSocket,
+                   PgError);
+      continue;
     }
-    PgStringKeyValue kv = PG_UNWRAP(res_kv);
 
-    PG_DYN_PUSH(&res.req.headers, kv, allocator);
-  }
+    PgFileDescriptor socket = PG_UNWRAP(res_create_socket);
 
-  // Too many headers.
-  res.err = PG_ERR_TOO_BIG;
-  return res;
+    ((struct sockaddr_in *)(void *)rp->ai_addr)->sin_port = htons(port);
 
-end:
-  res.done = true;
-  return res;
-}
-
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_http_write_request(PgWriter *w, PgHttpRequest req, PgAllocator *allocator) {
-  PgError err = 0;
+    // TODO: Use pg_net_connect_ipv4?
+    int ret = 0;
+    do {
+      ret = connect(socket.fd, rp->ai_addr, rp->ai_addrlen);
+    } while (-1 == ret && EINTR == errno);
 
-  err = pg_http_request_write_status_line(w, req, allocator);
-  if (err) {
-    return err;
-  }
-  PG_EACH_PTR(header, &req.headers) {
-    err = pg_http_write_header(w, *header, allocator);
-    if (err) {
-      return err;
+    if (-1 == ret) {
+      if (EINPROGRESS != errno) {
+        (void)pg_net_socket_close(socket);
+        continue;
+      }
     }
+
+    PgIpv4AddressSocket addr_socket = {
+        .socket = socket,
+        .address.ip =
+            ntohl(((struct sockaddr_in *)(void *)rp->ai_addr)->sin_addr.s_addr),
+        .address.port = port,
+    };
+    res = PG_OK(addr_socket, PgIpv4AddressSocket, PgError);
+    break;
   }
-  err = pg_writer_write_full(w, PG_S("\r\n"), allocator);
-  if (err) {
-    return err;
+
+  freeaddrinfo(addr_info);
+
+  if (nullptr == rp) { // No address succeeded.
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgIpv4AddressSocket, PgError);
   }
 
-  return 0;
+  return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_http_request_to_string(PgHttpRequest req, PgAllocator *allocator) {
-  u64 cap =
-      // TODO: Tweak this number?
-      128 + req.url.path_components.len * 64 +
-      req.url.query_parameters.len * 64 + req.headers.len * 128;
-  PgWriter w = pg_writer_make_string_builder(cap, allocator);
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgIpv4Address, PgError)
+    pg_net_dns_resolve_ipv4(PgString host, u16 port, PgAllocator *allocator) {
+  struct addrinfo hints = {0};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_protocol = IPPROTO_TCP;
 
-  PG_ASSERT(0 == pg_http_write_request(&w, req, allocator));
+  struct addrinfo *addr_info = nullptr;
+  int ret = getaddrinfo(pg_string_to_cstr(host, allocator), nullptr, &hints,
+                        &addr_info);
+  if (0 != ret || nullptr == addr_info) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgIpv4Address, PgError);
+  }
 
-  return PG_DYN_TO_SLICE(PgString, w.u.bytes);
+  PgIpv4Address address = {
+      .ip = ntohl(
+          ((struct sockaddr_in *)(void *)addr_info->ai_addr)->sin_addr.s_addr),
+      .port = port,
+  };
+  freeaddrinfo(addr_info);
+
+  return PG_OK(address, PgIpv4Address, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_http_write_response(PgWriter *w, PgHttpResponse res,
-                       PgAllocator *allocator) {
-  PgError err = 0;
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_SLICE(PgIpAddress), PgError)
+    pg_net_dns_resolve_ip(PgString host, u16 port, PgAllocator *allocator) {
+  struct addrinfo hints = {0};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_protocol = IPPROTO_TCP;
+  // Skip the families without a configured address on this host.
+  hints.ai_flags = AI_ADDRCONFIG;
 
-  err = pg_http_response_write_status_line(w, res, allocator);
-  if (err) {
-    return err;
+  struct addrinfo *addr_info = nullptr;
+  int res_getaddrinfo = 0;
+  do {
+    res_getaddrinfo = getaddrinfo(pg_string_to_cstr(host, allocator), nullptr,
+                                  &hints, &addr_info);
+  } while (EAI_SYSTEM == res_getaddrinfo && EINTR == errno);
+
+  if (0 != res_getaddrinfo) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(PgIpAddress), PgError);
   }
 
-  PG_EACH_PTR(header, &res.headers) {
-    err = pg_http_write_header(w, *header, allocator);
-    if (err) {
-      return err;
+  // In the order of preference of the system (RFC 6724).
+  PG_DYN(PgIpAddress) addresses = {0};
+  for (struct addrinfo *rp = addr_info; rp != nullptr; rp = rp->ai_next) {
+    if (AF_INET != rp->ai_family && AF_INET6 != rp->ai_family) {
+      continue;
     }
+    struct sockaddr_storage addr = {0};
+    pg_memcpy(&addr, rp->ai_addr, rp->ai_addrlen);
+    PgIpAddress address = pg_net_ip_address_from_sockaddr(&addr);
+    address.port = port;
+    PG_DYN_PUSH(&addresses, address, allocator);
   }
-  err = pg_writer_write_full(w, PG_S("\r\n"), allocator);
-  if (err) {
-    return err;
+  freeaddrinfo(addr_info);
+
+  if (0 == addresses.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(PgIpAddress), PgError);
   }
 
-  err = pg_writer_flush(w, allocator);
-  if (err) {
-    return err;
+  PG_SLICE(PgIpAddress)
+  res = pg_net_ip_addresses_interleave(
+      PG_DYN_TO_SLICE(PG_SLICE(PgIpAddress), addresses), allocator);
+  return PG_OK(res, PG_SLICE(PgIpAddress), PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgIpv4Address, PgError)
+    pg_net_socket_local_address(PgFileDescriptor sock) {
+  struct sockaddr_in addr = {0};
+  socklen_t addr_len = sizeof(addr);
+  if (-1 == getsockname(sock.fd, (struct sockaddr *)&addr, &addr_len)) {
+    return PG_ERR(errno, PgIpv4Address, PgError);
   }
 
-  return 0;
+  PgIpv4Address address = {
+      .ip = ntohl(addr.sin_addr.s_addr),
+      .port = ntohs(addr.sin_port),
+  };
+  return PG_OK(address, PgIpv4Address, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_http_content_length(PG_SLICE(PgStringKeyValue) headers) {
-  PG_RESULT(u64, PgError) res = {0};
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgIpAddress, PgError)
+    pg_net_socket_local_address_ip(PgFileDescriptor sock) {
+  struct sockaddr_storage addr = {0};
+  socklen_t addr_len = sizeof(addr);
+  if (-1 == getsockname(sock.fd, (struct sockaddr *)&addr, &addr_len)) {
+    return PG_ERR(errno, PgIpAddress, PgError);
+  }
 
-  PG_EACH_PTR(h, &headers) {
-    if (!pg_string_ieq_ascii(PG_S("Content-Length"), h->key)) {
-      continue;
-    }
+  return PG_OK(pg_net_ip_address_from_sockaddr(&addr), PgIpAddress, PgError);
+}
 
-    PgParseNumberResult res_parse = pg_string_parse_u64(h->value, 10, true);
-    if (!res_parse.present) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
-    }
-    if (!pg_string_is_empty(res_parse.remaining)) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
-    }
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_socket_write(PgFileDescriptor sock, PgString data) {
+  i64 n = 0;
+  do {
+    n = send(sock.fd, data.data, data.len, MSG_NOSIGNAL);
+  } while (-1 == n && EINTR == errno);
 
-    return PG_OK(res_parse.n, u64, PgError);
-    return res;
+  if (n < 0) {
+    return PG_ERR(errno, u64, PgError);
   }
-  return res;
+
+  return PG_OK((u64)n, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgLogger
-pg_log_make_logger_stdout(PgLogLevel level, PgLogFormat format,
-                          PgAllocator *allocator) {
-  PgLogger logger = {
-      .level = level,
-      .writer = pg_writer_make_from_file_descriptor(pg_os_stdout(), 4 * PG_KiB,
-                                                    allocator),
-      .format = format,
-      // TODO: Consider using `rtdsc` or such.
-      .monotonic_epoch =
-          PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)),
-      .allocator = allocator,
-  };
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_socket_read(PgFileDescriptor sock, PgString data) {
+  i64 n = 0;
+  do {
+    n = recv(sock.fd, data.data, data.len, 0);
+  } while (-1 == n && EINTR == errno);
 
-  return logger;
+  if (n < 0) {
+    return PG_ERR(errno, u64, PgError);
+  }
+
+  return PG_OK((u64)n, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_log_level_to_string(PgLogLevel level) {
-  switch (level) {
-  case PG_LOG_LEVEL_DEBUG:
-    return PG_S("debug");
-  case PG_LOG_LEVEL_INFO:
-    return PG_S("info");
-  case PG_LOG_LEVEL_ERROR:
-    return PG_S("error");
-  default:
-    PG_ASSERT(false);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_tcp_listen(PgFileDescriptor sock, u64 backlog) {
+  PG_ASSERT(backlog <= INT32_MAX);
+
+  int ret = 0;
+  do {
+    ret = listen(sock.fd, (int)backlog);
+  } while (-1 == ret && EINTR == errno);
+
+  if (-1 == ret) {
+    return (PgError)errno;
   }
+
+  return 0;
 }
 
-#define pg_log_c_u8(k, v) pg_log_u8(PG_S(k), v)
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_tcp_bind_ip(PgFileDescriptor sock, PgIpAddress address) {
+  struct sockaddr_storage addr = {0};
+  socklen_t addr_len = pg_net_ip_address_to_sockaddr(address, &addr);
 
-[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_u8(PgString k, u8 v) {
-  return (PgLogEntry){
-      .key = k,
-      .value.kind = PG_LOG_VALUE_U64,
-      .value.n64 = (u64)v,
-  };
-}
+  int ret = 0;
+  do {
+    ret = bind(sock.fd, (struct sockaddr *)&addr, addr_len);
+  } while (-1 == ret && EINTR == errno);
 
-#define pg_log_c_u16(k, v) pg_log_u16(PG_S(k), v)
+  if (-1 == ret) {
+    return (PgError)errno;
+  }
 
-[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_u16(PgString k, u16 v) {
-  return (PgLogEntry){
-      .key = k,
-      .value.kind = PG_LOG_VALUE_U64,
-      .value.n64 = (u64)v,
-  };
+  return 0;
 }
 
-#define pg_log_c_u32(k, v) pg_log_u32(PG_S(k), v)
-
-[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_u32(PgString k, u32 v) {
-  return (PgLogEntry){
-      .key = k,
-      .value.kind = PG_LOG_VALUE_U64,
-      .value.n64 = (u64)v,
-  };
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_tcp_bind_ipv4(PgFileDescriptor sock, PgIpv4Address addr) {
+  return pg_net_tcp_bind_ip(sock, pg_ip_address_from_ipv4(addr));
 }
 
-#define pg_log_c_u64(k, v) pg_log_u64(PG_S(k), v)
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_udp_bind_ip(PgFileDescriptor sock, PgIpAddress address) {
+  return pg_net_tcp_bind_ip(sock, address);
+}
 
-[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_u64(PgString k, u64 v) {
-  return (PgLogEntry){
-      .key = k,
-      .value.kind = PG_LOG_VALUE_U64,
-      .value.n64 = v,
-  };
+// Sets the destination of datagrams sent without an address and only
+// receives from this peer. Completes immediately, unlike for TCP.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_udp_connect_ip(PgFileDescriptor sock, PgIpAddress address) {
+  return pg_net_connect_ip(sock, address);
 }
 
-#define pg_log_c_i32(k, v) pg_log_i32(PG_S(k), v)
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_udp_set_gro(PgFileDescriptor sock, bool enabled) {
+#ifdef PG_OS_LINUX
+  int opt = enabled;
+  int ret = 0;
+  do {
+    ret = setsockopt(sock.fd, SOL_UDP, UDP_GRO, &opt, sizeof(opt));
+  } while (-1 == ret && EINTR == errno);
 
-[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_i32(PgString k, i32 v) {
-  return (PgLogEntry){
-      .key = k,
-      .value.kind = PG_LOG_VALUE_I64,
-      .value.s64 = (i64)v,
-  };
+  if (-1 == ret) {
+    return (PgError)errno;
+  }
+  return 0;
+#else
+  PG_UNUSED(sock);
+  PG_UNUSED(enabled);
+  return (PgError)EOPNOTSUPP;
+#endif
 }
 
-#define pg_log_c_err(k, v) pg_log_i32(PG_S(k), (i32)v)
-#define pg_log_err(k, v) pg_log_i32(k, (i32)v)
+#define PG_NET_UDP_BATCH_MAX 64
 
-#define pg_log_c_i64(k, v) pg_log_i64(PG_S(k), v)
+// What a `struct msghdr` points to for one datagram, for the duration of the
+// syscall.
+typedef struct {
+  struct sockaddr_storage addr;
+  struct iovec iov;
+  // Room for either the `UDP_SEGMENT` or the `UDP_GRO` control message.
+  union {
+    struct cmsghdr align;
+    u8 data[CMSG_SPACE(sizeof(i32))];
+  } control;
+} PgUdpMsgScratch;
 
-[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_i64(PgString k, i64 v) {
-  return (PgLogEntry){
-      .key = k,
-      .value.kind = PG_LOG_VALUE_I64,
-      .value.s64 = v,
-  };
-}
+[[nodiscard]] static struct msghdr
+pg_net_udp_msghdr_send(PgUdpDatagram datagram, PgUdpMsgScratch *scratch) {
+  struct msghdr res = {0};
 
-[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_s(PgString k,
-                                                          PgString v) {
-  return (PgLogEntry){
-      .key = k,
-      .value.kind = PG_LOG_VALUE_STRING,
-      .value.s = v,
-  };
+  scratch->iov.iov_base = datagram.data.data;
+  scratch->iov.iov_len = datagram.data.len;
+  res.msg_iov = &scratch->iov;
+  res.msg_iovlen = 1;
+
+  if (0 != datagram.address.port) {
+    res.msg_name = &scratch->addr;
+    res.msg_namelen =
+        pg_net_ip_address_to_sockaddr(datagram.address, &scratch->addr);
+  }
+
+#ifdef PG_OS_LINUX
+  if (0 != datagram.segment_len) {
+    res.msg_control = scratch->control.data;
+    res.msg_controllen = CMSG_SPACE(sizeof(u16));
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&res);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(u16));
+    pg_memcpy(CMSG_DATA(cmsg), &datagram.segment_len,
+              sizeof(datagram.segment_len));
+  }
+#endif
+
+  return res;
 }
 
-#define pg_log_c_s(k, v) pg_log_s(PG_S(k), v)
+[[nodiscard]] static struct msghdr
+pg_net_udp_msghdr_recv(PgUdpDatagram datagram, PgUdpMsgScratch *scratch) {
+  struct msghdr res = {0};
 
-#define pg_log_c_ipv4(k, v) pg_log_ipv4(PG_S(k), v)
+  scratch->iov.iov_base = datagram.data.data;
+  scratch->iov.iov_len = datagram.data.len;
+  res.msg_iov = &scratch->iov;
+  res.msg_iovlen = 1;
+  res.msg_name = &scratch->addr;
+  res.msg_namelen = sizeof(scratch->addr);
+  res.msg_control = scratch->control.data;
+  res.msg_controllen = sizeof(scratch->control.data);
 
-[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_ipv4(PgString k,
-                                                             PgIpv4Address v) {
-  return (PgLogEntry){
-      .key = k,
-      .value.kind = PG_LOG_VALUE_IPV4_ADDRESS,
-      .value.ipv4_address = v,
-  };
+  return res;
 }
 
-#define PG_LOG_ARGS_COUNT(...)                                                 \
-  (sizeof((PgLogEntry[]){__VA_ARGS__}) / sizeof(PgLogEntry))
-#define pg_log(logger, lvl, msg, ...)                                          \
-  do {                                                                         \
-    if (nullptr == (logger)) {                                                 \
-      break;                                                                   \
-    }                                                                          \
-    if ((logger)->level > (lvl)) {                                             \
-      break;                                                                   \
-    };                                                                         \
-    (void)pg_logger_do_log(logger, lvl, PG_S(msg), (logger)->allocator,        \
-                           PG_LOG_ARGS_COUNT(__VA_ARGS__), __VA_ARGS__);       \
-  } while (0)
+static void pg_net_udp_datagram_received(PgUdpDatagram *datagram,
+                                         struct msghdr *hdr, u64 len,
+                                         PgUdpMsgScratch *scratch) {
+  datagram->data.len = len;
+  datagram->truncated = 0 != (hdr->msg_flags & MSG_TRUNC);
+  datagram->address = hdr->msg_namelen > 0
+                          ? pg_net_ip_address_from_sockaddr(&scratch->addr)
+                          : (PgIpAddress){0};
+  datagram->segment_len = 0;
+
+#ifdef PG_OS_LINUX
+  for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg;
+       cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+    if (SOL_UDP != cmsg->cmsg_level || UDP_GRO != cmsg->cmsg_type) {
+      continue;
+    }
 
-[[nodiscard]] static bool pg_logfmt_byte_needs_escaping(u8 c) {
-  return c < ' ' || '\\' == c || '"' == c;
+    i32 segment_len = 0;
+    pg_memcpy(&segment_len, CMSG_DATA(cmsg), sizeof(segment_len));
+    // A lone datagram may still be reported with its own length.
+    if (segment_len > 0 && (u64)segment_len < len) {
+      datagram->segment_len = (u16)segment_len;
+    }
+  }
+#endif
 }
 
-static PgError pg_logfmt_write_string_escaped(PgWriter *w, PgString entry,
-                                              PgAllocator *allocator) {
-  PgError err = 0;
+#ifdef PG_OS_LINUX
+// `struct mmsghdr`, which glibc only exposes with `_GNU_SOURCE`.
+typedef struct {
+  struct msghdr hdr;
+  u32 len;
+  PG_PAD(4);
+} PgMmsgHdr;
 
-  bool has_spaces = pg_bytes_contains_any_byte(entry, PG_ASCII_SPACES);
-  if (has_spaces) {
-    err = pg_writer_write_u8(w, '"', allocator);
-    if (err) {
-      return err;
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_udp_send_batch(PgFileDescriptor sock,
+                          PG_SLICE(PgUdpDatagram) datagrams) {
+  PgMmsgHdr msgs[PG_NET_UDP_BATCH_MAX] = {0};
+  PgUdpMsgScratch scratch[PG_NET_UDP_BATCH_MAX];
+
+  u64 sent = 0;
+  while (sent < datagrams.len) {
+    u64 batch_len = PG_MIN(datagrams.len - sent, PG_NET_UDP_BATCH_MAX);
+    for (u64 i = 0; i < batch_len; i++) {
+      msgs[i].hdr = pg_net_udp_msghdr_send(
+          PG_SLICE_AT(datagrams, sent + i), &scratch[i]);
     }
-  }
 
-  PG_EACH_PTR(c, &entry) {
-    if (pg_logfmt_byte_needs_escaping(*c)) {
-      err = pg_writer_write_u8(w, '\\', allocator);
-      if (err) {
-        return err;
+    i64 n = 0;
+    do {
+      n = syscall(SYS_sendmmsg, sock.fd, msgs, batch_len, MSG_NOSIGNAL);
+    } while (-1 == n && EINTR == errno);
+
+    if (-1 == n) {
+      // Report the progress so far, the error comes up again on the next
+      // call.
+      if (sent > 0) {
+        break;
       }
+      return PG_ERR(errno, u64, PgError);
     }
-    err = pg_writer_write_u8(w, *c, allocator);
-    if (err) {
-      return err;
-    }
-  }
 
-  if (has_spaces) {
-    err = pg_writer_write_u8(w, '"', allocator);
-    if (err) {
-      return err;
+    sent += (u64)n;
+    if ((u64)n < batch_len) {
+      break;
     }
   }
 
-  return 0;
-}
-
-[[maybe_unused]] [[nodiscard]] static PgArena pg_arena_make_from_mem(u8 *data,
-                                                                     u64 len) {
-  PgArena arena = {
-      .start = data,
-      .end = data + len,
-      .start_original = data,
-  };
-
-  return arena;
+  return PG_OK(sent, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_logger_do_log(PgLogger *logger, PgLogLevel level, PgString msg,
-                 PgAllocator *allocator, i32 args_count, ...) {
-  // Ignore clock errors.
-  u64 monotonic_ns =
-      PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)) -
-      logger->monotonic_epoch;
-  u64 timestamp_ns =
-      PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_REALTIME));
-
-  PgError err = 0;
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_udp_recv_batch(PgFileDescriptor sock,
+                          PG_SLICE(PgUdpDatagram) datagrams) {
+  PgMmsgHdr msgs[PG_NET_UDP_BATCH_MAX] = {0};
+  PgUdpMsgScratch scratch[PG_NET_UDP_BATCH_MAX];
 
-  err = pg_writer_write_full(&logger->writer, PG_S("level="), allocator);
-  if (err) {
-    return err;
-  }
-  err = pg_writer_write_full(&logger->writer, pg_log_level_to_string(level),
-                             allocator);
-  if (err) {
-    return err;
+  u64 batch_len = PG_MIN(datagrams.len, PG_NET_UDP_BATCH_MAX);
+  if (0 == batch_len) {
+    return PG_OK(0, u64, PgError);
   }
 
-  err =
-      pg_writer_write_full(&logger->writer, PG_S(" timestamp_ns="), allocator);
-  if (err) {
-    return err;
-  }
-  err = pg_writer_write_u64_as_string(&logger->writer, timestamp_ns, allocator);
-  if (err) {
-    return err;
+  for (u64 i = 0; i < batch_len; i++) {
+    msgs[i].hdr =
+        pg_net_udp_msghdr_recv(PG_SLICE_AT(datagrams, i), &scratch[i]);
   }
 
-  err =
-      pg_writer_write_full(&logger->writer, PG_S(" monotonic_ns="), allocator);
-  if (err) {
-    return err;
-  }
-  err = pg_writer_write_u64_as_string(&logger->writer, monotonic_ns, allocator);
-  if (err) {
-    return err;
-  }
+  i64 n = 0;
+  do {
+    n = syscall(SYS_recvmmsg, sock.fd, msgs, batch_len, MSG_WAITFORONE,
+                nullptr);
+  } while (-1 == n && EINTR == errno);
 
-  err = pg_writer_write_full(&logger->writer, PG_S(" message="), allocator);
-  if (err) {
-    return err;
+  if (-1 == n) {
+    return PG_ERR(errno, u64, PgError);
   }
-  err = pg_logfmt_write_string_escaped(&logger->writer, msg, allocator);
-  if (err) {
-    return err;
+
+  for (u64 i = 0; i < (u64)n; i++) {
+    pg_net_udp_datagram_received(PG_SLICE_AT_PTR(&datagrams, i), &msgs[i].hdr,
+                                 msgs[i].len, &scratch[i]);
   }
 
-  va_list argp = {0};
-  va_start(argp, args_count);
-  for (i32 i = 0; i < args_count; i++) {
-    PgLogEntry entry = va_arg(argp, PgLogEntry);
-    err = pg_writer_write_u8(&logger->writer, ' ', allocator);
-    if (err) {
-      return err;
-    }
-    err = pg_writer_write_full(&logger->writer, entry.key, allocator);
-    if (err) {
-      return err;
-    }
-    err = pg_writer_write_u8(&logger->writer, '=', allocator);
-    if (err) {
-      return err;
-    }
+  return PG_OK((u64)n, u64, PgError);
+}
+#else
+// No `sendmmsg`/`recvmmsg` everywhere: one syscall per datagram.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_udp_send_batch(PgFileDescriptor sock,
+                          PG_SLICE(PgUdpDatagram) datagrams) {
+  u64 sent = 0;
+  for (; sent < datagrams.len; sent++) {
+    PgUdpDatagram datagram = PG_SLICE_AT(datagrams, sent);
+    if (0 != datagram.segment_len) {
+      return PG_ERR(EOPNOTSUPP, u64, PgError);
+    }
+
+    PgUdpMsgScratch scratch;
+    struct msghdr hdr = pg_net_udp_msghdr_send(datagram, &scratch);
+    i64 n = 0;
+    do {
+      n = sendmsg(sock.fd, &hdr, MSG_NOSIGNAL);
+    } while (-1 == n && EINTR == errno);
 
-    switch (entry.value.kind) {
-    case PG_LOG_VALUE_STRING: {
-      err = pg_logfmt_write_string_escaped(&logger->writer, entry.value.s,
-                                           allocator);
-      if (err) {
-        return err;
-      }
-      break;
-    }
-    case PG_LOG_VALUE_U64:
-      err = pg_writer_write_u64_as_string(&logger->writer, entry.value.n64,
-                                          allocator);
-      if (err) {
-        return err;
-      }
-      break;
-    case PG_LOG_VALUE_I64:
-      err = pg_writer_write_i64_as_string(&logger->writer, entry.value.s64,
-                                          allocator);
-      if (err) {
-        return err;
-      }
-      break;
-    case PG_LOG_VALUE_IPV4_ADDRESS: {
-      PgString ipv4_addr_str =
-          pg_net_ipv4_address_to_string(entry.value.ipv4_address, allocator);
-      err = pg_writer_write_full(&logger->writer, ipv4_addr_str, allocator);
-      if (err) {
-        return err;
+    if (-1 == n) {
+      if (sent > 0) {
+        break;
       }
-    } break;
-    default:
-      PG_ASSERT(0 && "invalid PgLogValueKind");
+      return PG_ERR(errno, u64, PgError);
     }
   }
-  va_end(argp);
-
-  err = pg_writer_write_u8(&logger->writer, '\n', allocator);
-  if (err) {
-    return err;
-  }
 
-  return pg_writer_flush(&logger->writer, allocator);
+  return PG_OK(sent, u64, PgError);
 }
 
-typedef i32 (*PgCmpFn)(const void *a, const void *b);
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_udp_recv_batch(PgFileDescriptor sock,
+                          PG_SLICE(PgUdpDatagram) datagrams) {
+  u64 received = 0;
+  for (; received < datagrams.len; received++) {
+    PgUdpDatagram *datagram = PG_SLICE_AT_PTR(&datagrams, received);
+    PgUdpMsgScratch scratch;
+    struct msghdr hdr = pg_net_udp_msghdr_recv(*datagram, &scratch);
+    i64 n = 0;
+    do {
+      n = recvmsg(sock.fd, &hdr, received > 0 ? MSG_DONTWAIT : 0);
+    } while (-1 == n && EINTR == errno);
 
-[[maybe_unused]] [[nodiscard]] static i32 pg_cmp_u64(const void *va,
-                                                     const void *vb) {
-  PG_ASSERT(va);
-  PG_ASSERT(vb);
-  u64 a = *(u64 *)va;
-  u64 b = *(u64 *)vb;
+    if (-1 == n) {
+      if (received > 0) {
+        break;
+      }
+      return PG_ERR(errno, u64, PgError);
+    }
 
-  if (a < b) {
-    return -1;
-  } else if (a == b) {
-    return 0;
-  } else {
-    return 1;
+    pg_net_udp_datagram_received(datagram, &hdr, (u64)n, &scratch);
   }
+
+  return PG_OK(received, u64, PgError);
 }
+#endif
 
-static void pg_swap(void *a, void *b, u64 elem_size) {
-  u8 tmp[256] = {0};
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_get_socket_error(PgFileDescriptor sock) {
+  int socket_error = -1;
+  socklen_t len = sizeof(socket_error);
+  int ret = 0;
+  do {
+    ret = getsockopt(sock.fd, SOL_SOCKET, SO_ERROR, &socket_error, &len);
+  } while (-1 == ret && EINTR == errno);
 
-  for (u64 copied = 0; copied < elem_size;) {
-    PG_ASSERT(copied < elem_size);
+  if (-1 == ret) {
+    return (PgError)errno;
+  }
+  return (PgError)socket_error;
+}
 
-    u64 batch_size = PG_MIN(sizeof(tmp), elem_size);
-    if (elem_size - copied < batch_size) {
-      batch_size = elem_size - copied;
-    }
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_net_socket_enable_reuse(PgFileDescriptor sock) {
+  int val = 1;
+  int ret = 0;
+  do {
+    ret = setsockopt(sock.fd, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val));
+  } while (-1 == ret && EINTR == errno);
 
-    __builtin_memcpy(tmp + copied, a, batch_size);
-    __builtin_memcpy(b, tmp + copied, batch_size);
-    copied += batch_size;
+  if (-1 == ret) {
+    return (PgError)errno;
   }
-}
 
-static void pg_quicksort(void *elems, u64 elem_size, u64 elems_count,
-                         PgCmpFn cmp_fn) {
-  PG_ASSERT(elems != nullptr);
-  PG_ASSERT(elem_size != 0);
-  PG_ASSERT(cmp_fn);
+  do {
+    ret = setsockopt(sock.fd, SOL_SOCKET, SO_REUSEPORT, &val, sizeof(val));
+  } while (-1 == ret && EINTR == errno);
 
-  if (elems_count <= 1) {
-    return;
+  if (-1 == ret) {
+    return (PgError)errno;
   }
 
-  pg_quicksort(elems, elem_size, elems_count / 2, cmp_fn);
-  pg_quicksort(pivot, elem_size, (end - pivot) / elem_size, cmp_fn);
+  return 0;
 }
 
-[[nodiscard]]
-static u64 pg_quicksort_partition(void *elems, u64 elem_size, u64 elems_count,
-                                  PgCmpFn cmp_fn) {
-  if (elems_count <= 1) {
-    return 0;
-  }
-  u64 tmp_pivot_idx = 0; // First element.
-  void *pivot = elems + (elems_count - 1) * elem_size;
+[[maybe_unused]] [[nodiscard]] static PgIpv4AddressAcceptResult
+pg_net_tcp_accept(PgFileDescriptor sock) {
+  PgIpv4AddressAcceptResult res = {0};
 
-  for (u64 i = 0; i < elems_count - 1; i++) {
-    void *elem = elems + i * elem_size;
-    i32 cmp = cmp_fn(elem, pivot);
-    if (cmp > 0) { // Need to swap.
-      pg_swap(elem, pivot, elem_size);
-      tmp_pivot_idx += 1;
-      PG_ASSERT(tmp_pivot_idx <= elems_count);
-    }
+  struct sockaddr_in sockaddrin = {0};
+  socklen_t sockaddrin_len = sizeof(sockaddrin);
+  int sock_client = 0;
+  do {
+    sock_client =
+        accept(sock.fd, (struct sockaddr *)&sockaddrin, &sockaddrin_len);
+  } while (-1 == sock_client && EINTR == errno);
+
+  if (-1 == sock_client) {
+    res.err = (PgError)errno;
+    return res;
   }
 
-  PG_ASSERT(tmp_pivot_idx < elems_count);
-  // Swap temporary pivot with last element.
-  pg_swap(elems + tmp_pivot_idx * elem_size,
-          elems + (elems_count - 1) * elem_size, elem_size);
+  res.socket.fd = sock_client;
+  res.address.port = ntohs(sockaddrin.sin_port);
+  res.address.ip = ntohl(sockaddrin.sin_addr.s_addr);
 
-  return tmp_pivot_idx;
+  return res;
 }
 
-[[maybe_unused]] static void pg_sort_unique(void *elems, u64 elem_size,
-                                            u64 *elems_count, PgCmpFn cmp_fn) {
-  pg_quicksort(elems, *elems_count, elem_size, cmp_fn);
+[[maybe_unused]] [[nodiscard]] static PgIpAddressAcceptResult
+pg_net_tcp_accept_ip(PgFileDescriptor sock) {
+  PgIpAddressAcceptResult res = {0};
 
-  if (*elems_count <= 1) {
-    return;
-  }
+  struct sockaddr_storage addr = {0};
+  socklen_t addr_len = sizeof(addr);
+  int sock_client = 0;
+  do {
+    sock_client = accept(sock.fd, (struct sockaddr *)&addr, &addr_len);
+  } while (-1 == sock_client && EINTR == errno);
 
-  for (u64 i = 1; i < *elems_count;) {
-    void *previous = (u8 *)elems + elem_size * (i - 1);
-    void *current = (u8 *)elems + elem_size * i;
-    if (PG_CMP_EQ == cmp_fn(previous, current)) {
-      pg_memmove(previous, current, elem_size * (*elems_count - i));
-      PG_ASSERT(*elems_count > 0);
-      *elems_count -= 1;
-    } else {
-      i += 1;
-    }
+  if (-1 == sock_client) {
+    res.err = (PgError)errno;
+    return res;
   }
-}
-
-[[maybe_unused]] [[nodiscard]] static PgUuid pg_uuid_v5(PgUuid namespace,
-                                                        PgString name) {
-  PG_SHA1_CTX ctx = {0};
-  PG_SHA1Init(&ctx);
-  PG_SHA1Update(&ctx, namespace.value, PG_STATIC_ARRAY_LEN(namespace.value));
-  PG_SHA1Update(&ctx, name.data, name.len);
-
-  PgSha1 digest = {0};
-  PG_SHA1Final(digest.data, &ctx);
-
-  PgUuid res = {.version = 5};
-  pg_memcpy(res.value, digest.data, 16);
-
-  res.value[6] &= 0x0F;
-  res.value[6] |= 0x50;
 
-  res.value[8] &= 0x3F;
-  res.value[8] |= 0x80;
+  res.socket.fd = sock_client;
+  res.address = pg_net_ip_address_from_sockaddr(&addr);
 
   return res;
 }
 
-#define PG_UUID_STRING_LENGTH (8 + 4 + 4 + 4 + 12 + 4)
-
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_uuid_to_string(PgUuid uuid, PgAllocator *allocator) {
-  PgString res = pg_string_make(PG_UUID_STRING_LENGTH, allocator);
-  u64 i = 0;
-
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[0] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[0] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[1] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[1] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[2] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[2] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[3] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[3] & 0xF);
-  res.data[i++] = '-';
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[4] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[4] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[5] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[5] & 0xF);
-  res.data[i++] = '-';
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[6] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[6] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[7] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[7] & 0xF);
-  res.data[i++] = '-';
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[8] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[8] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[9] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[9] & 0xF);
-  res.data[i++] = '-';
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[10] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[10] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[11] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[11] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[12] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[12] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[13] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[13] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[14] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[14] & 0xF);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[15] >> 4);
-  res.data[i++] = pg_u8_to_hex_rune(uuid.value[15] & 0xF);
+// Non-blocking connect to `address`, watched by `aio`.
+[[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_net_connect_attempt_start(PgAio aio, PgIpAddress address) {
+  PgFileDescriptor socket =
+      PG_TRY(pg_net_create_tcp_socket_ip(address.family), PgFileDescriptor,
+             PgError);
 
-  return res;
-}
+  PgError err = pg_fd_set_blocking(socket, false);
+  if (err) {
+    goto fail;
+  }
+  err = pg_net_connect_ip(socket, address);
+  if (err) {
+    goto fail;
+  }
+  err = pg_aio_register_interest_fd(aio, socket, PG_AIO_EVENT_KIND_WRITABLE);
+  if (err) {
+    goto fail;
+  }
+  return PG_OK(socket, PgFileDescriptor, PgError);
 
-[[nodiscard]] static bool pg_html_tag_is_self_closing(PgString tag) {
-  return pg_string_eq(tag, PG_S("area")) || pg_string_eq(tag, PG_S("base")) ||
-         pg_string_eq(tag, PG_S("br")) || pg_string_eq(tag, PG_S("col")) ||
-         pg_string_eq(tag, PG_S("embed")) || pg_string_eq(tag, PG_S("hr")) ||
-         pg_string_eq(tag, PG_S("img")) || pg_string_eq(tag, PG_S("input")) ||
-         pg_string_eq(tag, PG_S("link")) || pg_string_eq(tag, PG_S("meta")) ||
-         pg_string_eq(tag, PG_S("param")) ||
-         pg_string_eq(tag, PG_S("source")) ||
-         pg_string_eq(tag, PG_S("track")) || pg_string_eq(tag, PG_S("wbr"));
+fail:
+  (void)pg_net_socket_close(socket);
+  return PG_ERR(err, PgFileDescriptor, PgError);
 }
 
-[[nodiscard]] static bool pg_svg_tag_is_self_closing(PgString tag) {
-  return pg_string_eq(tag, PG_S("path")) || pg_string_eq(tag, PG_S("line")) ||
-         pg_string_eq(tag, PG_S("circle")) || pg_string_eq(tag, PG_S("rect")) ||
-         pg_string_eq(tag, PG_S("polygon")) ||
-         pg_string_eq(tag, PG_S("polyline")) || pg_string_eq(tag, PG_S("stop"));
-
-  // TODO: more.
-}
+// Connect to the first address that answers, per the Happy Eyeballs
+// algorithm of RFC 8305: attempts start `attempt_delay_ms` apart, or as soon
+// as the previous one fails, and race each other. The losers are closed.
+// `addresses` should already be interleaved by family.
+// `aio` must not watch anything else during the call.
+// The socket is returned non-blocking.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgIpAddressSocket, PgError)
+    pg_net_connect_happy_eyeballs(PgAio aio, PG_SLICE(PgIpAddress) addresses,
+                                  PgNetConnectOptions options,
+                                  PgAllocator *allocator) {
+  if (0 == addresses.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgIpAddressSocket, PgError);
+  }
 
-// FIXME
-[[maybe_unused]] [[nodiscard]]
-static PgError pg_html_tokenize_attributes(PgString s, u64 *pos,
-                                           PG_DYN(PgHtmlToken) * tokens,
-                                           PgAllocator *allocator) {
-  (void)tokens;
-  (void)allocator;
+  u64 attempt_delay_ns =
+      (options.attempt_delay_ms ? options.attempt_delay_ms : 250) *
+      PG_Milliseconds;
+  u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  u64 deadline_ns = options.timeout_ms
+                        ? now_ns + options.timeout_ms * PG_Milliseconds
+                        : UINT64_MAX;
 
-  PgRune quote = 0;
+  PG_DYN(PgIpAddressSocket) attempts = {0};
+  PG_DYN_ENSURE_CAP(&attempts, addresses.len, allocator);
+  u64 next = 0;
+  u64 next_start_ns = now_ns;
+  PgError err = 0; // Of the last attempt to fail.
+  PG_OPTION(PgIpAddressSocket) winner = {0};
 
   for (;;) {
-    PG_OPTION(PgRune)
-    first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-    if (!first_opt.has_value) { // Early EOF.
-      return PG_HTML_PARSE_ERROR_EOF_IN_TAG;
+    now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    if (now_ns >= deadline_ns) {
+      err = (PgError)ETIMEDOUT;
+      break;
     }
 
-    PgRune first = first_opt.value;
-    if (pg_rune_ascii_is_space(first)) { // Skip.
-      *pos += pg_utf8_rune_bytes_count(first);
-      continue;
-    }
+    if (next < addresses.len &&
+        (now_ns >= next_start_ns || 0 == attempts.len)) {
+      PgIpAddress address = PG_SLICE_AT(addresses, next);
+      next += 1;
+      next_start_ns = now_ns + attempt_delay_ns;
 
-    if (('"' == first || '\'' == first) && 0 == quote) { // Entering quotes.
-      quote = first;
-      *pos += pg_utf8_rune_bytes_count(first);
-      continue;
-    }
-    if (quote && first == quote) { // Exiting quotes.
-      quote = 0;
-      *pos += pg_utf8_rune_bytes_count(first);
+      PG_RESULT(PgFileDescriptor, PgError)
+      res_start = pg_net_connect_attempt_start(aio, address);
+      if (PG_IS_ERR(res_start)) {
+        err = PG_UNWRAP_ERR(res_start);
+        next_start_ns = now_ns;
+        continue;
+      }
+      *PG_DYN_PUSH_WITHIN_CAPACITY(&attempts) = (PgIpAddressSocket){
+          .socket = PG_UNWRAP(res_start),
+          .address = address,
+      };
       continue;
     }
 
-    if (0 == quote && ('>' == first)) { // End of tag.
-      return 0;
+    if (0 == attempts.len) { // All failed.
+      break;
     }
 
-    // Other characters, skip.
-    *pos += pg_utf8_rune_bytes_count(first);
-  }
-
-  PG_ASSERT(0);
-}
-
-[[nodiscard]]
-static PgError pg_html_tokenize_comment(PgString s, u64 *pos,
-                                        PG_DYN(PgHtmlToken) * tokens,
-                                        PgAllocator *allocator) {
-  u32 start = (u32)*pos;
-
-  for (;;) {
-    PG_OPTION(PgRune)
-    first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-    if (!first_opt.has_value) {
-      return PG_HTML_PARSE_ERROR_EOF_IN_COMMENT;
+    u64 wait_until_ns = deadline_ns;
+    if (next < addresses.len) {
+      wait_until_ns = PG_MIN(wait_until_ns, next_start_ns);
     }
-
-    PgRune first = first_opt.value;
-
-    // FIXME: More complicated than that in the spec.
-    if (pg_string_starts_with(PG_SLICE_RANGE_START(s, *pos), PG_S("-->"))) {
-      PgHtmlToken token = {
-          .kind = PG_HTML_TOKEN_KIND_COMMENT,
-          .comment = pg_string_trim_space(PG_SLICE_RANGE(s, start, *pos)),
-          .start = start,
-          .end = (u32)*pos,
-      };
-      PG_DYN_PUSH(tokens, token, allocator);
-
-      *pos += PG_S("-->").len;
-      return 0;
+    PG_OPTION(u32) timeout_ms = {0};
+    if (UINT64_MAX != wait_until_ns) {
+      u64 ms = (wait_until_ns - now_ns + PG_Milliseconds - 1) / PG_Milliseconds;
+      timeout_ms = PG_SOME((u32)PG_MIN(ms, UINT32_MAX), u32);
     }
 
-    *pos += pg_utf8_rune_bytes_count(first);
-  }
-}
-
-[[nodiscard]]
-static PgError pg_html_tokenize_doctype_name(PgString s, u64 *pos,
-                                             PG_DYN(PgHtmlToken) * tokens,
-                                             PgAllocator *allocator) {
-  PgHtmlToken token = {
-      .kind = PG_HTML_TOKEN_KIND_DOCTYPE,
-      .doctype = {.data = s.data + *pos},
-      .start = (u32)*pos,
-  };
-
-  for (;;) {
-    PG_OPTION(PgRune)
-    first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-    if (!first_opt.has_value) {
-      return PG_HTML_PARSE_ERROR_EOF_IN_DOCTYPE;
+    PgAioEvent events_data[8] = {0};
+    PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+    PG_RESULT(u64, PgError) res_wait = pg_aio_wait(aio, events, timeout_ms);
+    if (PG_IS_ERR(res_wait)) {
+      err = PG_UNWRAP_ERR(res_wait);
+      break;
     }
 
-    PgRune first = first_opt.value;
+    for (u64 i = 0; i < PG_UNWRAP(res_wait) && !winner.has_value; i++) {
+      PgAioEvent event = PG_SLICE_AT(events, i);
 
-    if (pg_rune_ascii_is_space(first)) {
-      *pos += pg_utf8_rune_bytes_count(first);
-      return 0;
-    }
-
-    if ('>' == first) {
-      token.end = (u32)*pos;
-      token.doctype.len = token.end - token.start;
-      PG_ASSERT(!pg_string_is_empty(token.doctype));
-      PG_DYN_PUSH(tokens, token, allocator);
+      for (u64 j = 0; j < attempts.len; j++) {
+        PgIpAddressSocket attempt = PG_SLICE_AT(attempts, j);
+        if (attempt.socket.fd != event.fd.fd) {
+          continue;
+        }
 
-      *pos += pg_utf8_rune_bytes_count(first);
-      return 0;
+        (void)pg_aio_unregister_interest(aio, attempt.socket,
+                                         PG_AIO_EVENT_KIND_WRITABLE);
+        PG_SLICE_SWAP_REMOVE(&attempts, j);
+
+        PgError err_socket = pg_net_get_socket_error(attempt.socket);
+        if (err_socket) {
+          err = err_socket;
+          (void)pg_net_socket_close(attempt.socket);
+          next_start_ns = now_ns;
+        } else {
+          winner = PG_SOME(attempt, PgIpAddressSocket);
+        }
+        break;
+      }
+    }
+    if (winner.has_value) {
+      break;
     }
-
-    *pos += pg_utf8_rune_bytes_count(first);
-  }
-}
-
-[[nodiscard]]
-static PgError pg_html_tokenize_doctype(PgString s, u64 *pos,
-                                        PG_DYN(PgHtmlToken) * tokens,
-                                        PgAllocator *allocator) {
-  *pos += PG_S("DOCTYPE").len;
-
-  PG_OPTION(PgRune) first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-  if (!first_opt.has_value) {
-    return PG_HTML_PARSE_ERROR_MISSING_WHITESPACE_BEFORE_DOCTYPE_NAME;
   }
 
-  PgRune first = first_opt.value;
-  if (!pg_rune_ascii_is_space(first)) {
-    return PG_HTML_PARSE_ERROR_MISSING_WHITESPACE_BEFORE_DOCTYPE_NAME;
+  // Cancel the losers.
+  PG_EACH_PTR(it, &attempts) {
+    (void)pg_aio_unregister_interest(aio, it->socket,
+                                     PG_AIO_EVENT_KIND_WRITABLE);
+    (void)pg_net_socket_close(it->socket);
   }
-  *pos += pg_utf8_rune_bytes_count(first);
-
-  for (;;) {
-    first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-    if (!first_opt.has_value) {
-      return PG_HTML_PARSE_ERROR_EOF_IN_DOCTYPE;
-    }
-
-    first = first_opt.value;
-    if (pg_rune_ascii_is_space(first)) {
-      *pos += pg_utf8_rune_bytes_count(first);
-      continue;
-    }
-
-    if ('>' == first) {
-      return PG_HTML_PARSE_ERROR_MISSING_DOCTYPE_NAME;
-    }
 
-    return pg_html_tokenize_doctype_name(s, pos, tokens, allocator);
+  if (!winner.has_value) {
+    return PG_ERR(err ? err : PG_ERR_INVALID_VALUE, PgIpAddressSocket,
+                  PgError);
   }
+  return PG_OK(winner.value, PgIpAddressSocket, PgError);
 }
 
-[[nodiscard]]
-static PgError pg_html_tokenize_markup(PgString s, u64 *pos,
-                                       PG_DYN(PgHtmlToken) * tokens,
-                                       PgAllocator *allocator) {
-  if (pg_string_starts_with(PG_SLICE_RANGE_START(s, *pos), PG_S("--"))) {
-    *pos += pg_utf8_rune_bytes_count('-');
-    *pos += pg_utf8_rune_bytes_count('-');
-    return pg_html_tokenize_comment(s, pos, tokens, allocator);
-  }
-
-  if (PG_SLICE_RANGE_START(s, *pos).len >= PG_S("DOCTYPE").len &&
-      (('D' == PG_SLICE_AT(s, *pos + 0) || 'd' == PG_SLICE_AT(s, *pos + 0)) ||
-       ('O' == PG_SLICE_AT(s, *pos + 0) || 'o' == PG_SLICE_AT(s, *pos + 1)) ||
-       ('C' == PG_SLICE_AT(s, *pos + 0) || 'c' == PG_SLICE_AT(s, *pos + 2)) ||
-       ('T' == PG_SLICE_AT(s, *pos + 0) || 't' == PG_SLICE_AT(s, *pos + 3)) ||
-       ('Y' == PG_SLICE_AT(s, *pos + 0) || 'y' == PG_SLICE_AT(s, *pos + 4)) ||
-       ('P' == PG_SLICE_AT(s, *pos + 0) || 'p' == PG_SLICE_AT(s, *pos + 5)) ||
-       ('E' == PG_SLICE_AT(s, *pos + 0) || 'e' == PG_SLICE_AT(s, *pos + 6)))) {
-    return pg_html_tokenize_doctype(s, pos, tokens, allocator);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_rewind_start(PgFileDescriptor f) {
+  off_t ret = lseek(f.fd, 0, SEEK_SET);
+  if (-1 == ret) {
+    return (PgError)errno;
   }
-  PG_ASSERT(0);
-
   return 0;
 }
 
-[[nodiscard]]
-static PgError pg_html_tokenize_tag(PgString s, u64 *pos,
-                                    PG_DYN(PgHtmlToken) * tokens,
-                                    PgAllocator *allocator) {
-  PG_OPTION(PgRune) first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-  PG_ASSERT(first_opt.has_value);
-  PG_ASSERT('<' == first_opt.value);
-  *pos += pg_utf8_rune_bytes_count('<');
-
-  first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-  if (first_opt.has_value && ('!' == first_opt.value)) {
-    *pos += pg_utf8_rune_bytes_count('!');
-    return pg_html_tokenize_markup(s, pos, tokens, allocator);
-  }
-
-  PgHtmlToken token = {
-      .start = (u32)*pos,
-      .end = 0, // Backpatched,
-      .kind = PG_HTML_TOKEN_KIND_TAG_OPENING,
-      .tag = {.data = s.data + *pos}, // Length backpatched.
-  };
-
-  first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-  if (first_opt.has_value) {
-    PgRune first = first_opt.value;
-    if ('/' == first) {
-      *pos += pg_utf8_rune_bytes_count(first);
-      token.start = (u32)*pos;
-      token.kind = PG_HTML_TOKEN_KIND_TAG_CLOSING;
-      token.tag.data += pg_utf8_rune_bytes_count(first);
-    }
-  }
-
-  first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-  if (!first_opt.has_value ||
-      (!pg_rune_ascii_is_alphabetical(first_opt.value))) {
-    return PG_HTML_PARSE_ERROR_INVALID_FIRST_CHARACTER_OF_TAG_NAME;
-  }
-  *pos += pg_utf8_rune_bytes_count(first_opt.value);
+// TODO: Review in the context of multiple threads spawning and reaping
+// processes.
+[[maybe_unused]] [[nodiscard]]
+static PG_RESULT(PgProcess, PgError)
+    pg_process_spawn(PgString path, PG_SLICE(PgString) args,
+                     PgProcessSpawnOptions options, PgAllocator *allocator) {
+  PG_RESULT(PgProcess, PgError) res = {0};
 
-  for (;;) {
-    first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
+  char *path_c = (char *)pg_string_to_cstr(path, allocator);
 
-    if (!first_opt.has_value) { // Early EOF.
-      return PG_HTML_PARSE_ERROR_EOF_IN_TAG;
-    }
+  PG_DYN(PgCstr) args_c = {0};
+  PG_DYN_ENSURE_CAP(&args_c, args.len + 2, allocator);
+  PG_DYN_PUSH(&args_c, path_c, allocator);
 
-    PgRune first = first_opt.value;
+  PG_EACH_PTR(arg, &args) {
+    PG_DYN_PUSH(&args_c, pg_string_to_cstr(*arg, allocator), allocator);
+  }
+  PG_ASSERT(args.len + 1 == args_c.len);
 
-    // End of tag name.
-    if ('>' == first || pg_rune_ascii_is_space(first)) {
-      if (0 == token.tag.len) {
-        token.tag.len = (u64)((s.data + *pos) - token.tag.data);
-      }
-      PG_ASSERT(token.tag.len <= s.len);
-      if (0 == token.end) {
-        token.end = (u32)*pos;
+  int stdin_pipe[2] = {0};
+  {
+    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stdin_capture) {
+      int ret = pipe(stdin_pipe);
+      if (-1 == ret) {
+        res = PG_ERR(errno, PgProcess, PgError);
+        goto end;
       }
     }
+  }
 
-    if ('>' == first) {
-      token.tag = pg_string_trim_space(token.tag);
-      token.tag = pg_string_trim_right(token.tag, '/');
-
-      PG_DYN_PUSH(tokens, token, allocator);
-      *pos += pg_utf8_rune_bytes_count(first);
-      return 0;
-    }
+  int stdout_pipe[2] = {0};
+  {
+    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stdout_capture) {
+      int ret = pipe(stdout_pipe);
+      if (-1 == ret) {
+        res = PG_ERR(errno, PgProcess, PgError);
+        goto end;
+      }
+    }
+  }
 
-    if (pg_rune_ascii_is_space(first)) {
-      *pos += pg_utf8_rune_bytes_count(first);
-      PgError err = pg_html_tokenize_attributes(s, pos, tokens, allocator);
-      if (err) {
-        return err;
+  int stderr_pipe[2] = {0};
+  {
+    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stderr_capture) {
+      int ret = pipe(stderr_pipe);
+      if (-1 == ret) {
+        res = PG_ERR(errno, PgProcess, PgError);
+        goto end;
       }
-      continue;
     }
+  }
+
+  int pid = fork();
 
-    // Skip other characters in tag name.
-    *pos += pg_utf8_rune_bytes_count(first);
+  if (-1 == pid) {
+    res = PG_ERR(errno, PgProcess, PgError);
+    goto end;
   }
-}
 
-// TODO: Decode html entities e.g. `&amp;` ?
-[[maybe_unused]] [[nodiscard]]
-static PgError pg_html_tokenize_data(PgString s, u64 *pos,
-                                     PG_DYN(PgHtmlToken) * tokens,
-                                     PgAllocator *allocator) {
-  u32 start = (u32)*pos;
+  if (0 == pid) { // Child.
 
-  PG_ASSERT(tokens->len > 0);
-  PG_ASSERT(PG_SLICE_LAST(*tokens).end <= start);
+    bool need_ignore =
+        (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stdin_capture) ||
+        (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stdout_capture) ||
+        (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stderr_capture);
 
-  for (;;) {
-    PG_OPTION(PgRune)
-    first_opt = pg_string_first(PG_SLICE_RANGE_START(s, *pos));
-    if (!first_opt.has_value) {
-      return 0;
+    int fd_ignore = 0;
+    if (need_ignore) {
+      fd_ignore = open("/dev/null", O_RDWR, 0);
+      PG_ASSERT(-1 != fd_ignore);
     }
 
-    PgRune first = first_opt.value;
-    if ('<' == first) { // End of data, start of tag.
-      PgHtmlToken token = {
-          .start = start,
-          .end = (u32)(*pos),
-          .kind = PG_HTML_TOKEN_KIND_TEXT,
-          .text = PG_SLICE_RANGE(s, start, *pos),
-      };
-      if (!pg_string_is_empty(pg_string_trim_space(token.text))) {
-        PG_DYN_PUSH(tokens, token, allocator);
-      }
-      return 0;
+    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stdin_capture) {
+      close(stdin_pipe[PG_PIPE_WRITE]);
+      int ret_dup2 = dup2(stdin_pipe[PG_PIPE_READ], STDIN_FILENO);
+      PG_ASSERT(-1 != ret_dup2);
+    } else if (PG_CHILD_PROCESS_STD_IO_CLOSE == options.stdin_capture) {
+      close(STDIN_FILENO);
+    } else if (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stdin_capture) {
+      int ret_dup2 = dup2(fd_ignore, STDIN_FILENO);
+      PG_ASSERT(-1 != ret_dup2);
     }
-    // TODO: Ampersand.
 
-    *pos += pg_utf8_rune_bytes_count(first);
-  }
-}
+    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stdout_capture) {
+      close(stdout_pipe[PG_PIPE_READ]);
+      int ret_dup2 = dup2(stdout_pipe[PG_PIPE_WRITE], STDOUT_FILENO);
+      PG_ASSERT(-1 != ret_dup2);
+    } else if (PG_CHILD_PROCESS_STD_IO_CLOSE == options.stdout_capture) {
+      close(STDOUT_FILENO);
+    } else if (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stdout_capture) {
+      int ret_dup2 = dup2(fd_ignore, STDOUT_FILENO);
+      PG_ASSERT(-1 != ret_dup2);
+    }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_DYN(PgHtmlToken), PgError)
-    pg_html_tokenize(PgString s, PgAllocator *allocator) {
-  PG_DYN(PgHtmlToken) res = {0};
-  PG_DYN_ENSURE_CAP(&res, s.len / 8, allocator);
+    if (PG_CHILD_PROCESS_STD_IO_PIPE == options.stderr_capture) {
+      close(stderr_pipe[PG_PIPE_READ]);
+      int ret_dup2 = dup2(stderr_pipe[PG_PIPE_WRITE], STDERR_FILENO);
+      PG_ASSERT(-1 != ret_dup2);
+    } else if (PG_CHILD_PROCESS_STD_IO_CLOSE == options.stderr_capture) {
+      close(STDERR_FILENO);
+    } else if (PG_CHILD_PROCESS_STD_IO_IGNORE == options.stderr_capture) {
+      int ret_dup2 = dup2(fd_ignore, STDERR_FILENO);
+      PG_ASSERT(-1 != ret_dup2);
+    }
 
-  PgRune tag_start = '<';
-  u64 pos = 0;
-  for (;;) {
-    PG_OPTION(PgRune) first_opt = pg_string_first(PG_SLICE_RANGE_START(s, pos));
-    if (!first_opt.has_value) { // EOF.
-      return PG_OK(res, PG_DYN(PgHtmlToken), PgError);
+    if (-1 == execvp(path_c, args_c.data)) {
+      // Not easy to give the error back to the caller here.
+      // Maybe with a separate pipe?
+      PG_ASSERT(0);
     }
+    PG_ASSERT(0 && "unreachable");
+  }
 
-    PgRune first = first_opt.value;
+  PG_ASSERT(pid > 0); // Parent.
+  PgProcess process = {0};
+  process.pid = (u64)pid;
+  process.stdin_pipe.fd = stdin_pipe[PG_PIPE_WRITE];
+  process.stdout_pipe.fd = stdout_pipe[PG_PIPE_READ];
+  process.stderr_pipe.fd = stderr_pipe[PG_PIPE_READ];
+  res = PG_OK(process, PgProcess, PgError);
 
-    // TODO: Doctype.
-    // TODO: Comment.
+end:
+  PG_EACH_PTR(arg_c, &args_c) { pg_free(allocator, *arg_c); }
 
-    // Tag.
-    if (tag_start == first) {
-      PgError err = pg_html_tokenize_tag(s, &pos, &res, allocator);
-      if (err) {
-        return PG_ERR(err, PG_DYN(PgHtmlToken), PgError);
-      }
+  if (stdin_pipe[PG_PIPE_READ]) {
+    close(stdin_pipe[PG_PIPE_READ]);
+  }
+  if (stdout_pipe[PG_PIPE_WRITE]) {
+    close(stdout_pipe[PG_PIPE_WRITE]);
+  }
+  if (stderr_pipe[PG_PIPE_WRITE]) {
+    close(stderr_pipe[PG_PIPE_WRITE]);
+  }
 
-      err = pg_html_tokenize_data(s, &pos, &res, allocator);
-      if (err) {
-        return PG_ERR(err, PG_DYN(PgHtmlToken), PgError);
-      }
+  if (PG_IS_ERR(res)) {
+    if (stdin_pipe[PG_PIPE_WRITE]) {
+      close(stdin_pipe[PG_PIPE_WRITE]);
+    }
+    if (stdout_pipe[PG_PIPE_READ]) {
+      close(stdout_pipe[PG_PIPE_READ]);
+    }
+    if (stderr_pipe[PG_PIPE_READ]) {
+      close(stderr_pipe[PG_PIPE_READ]);
     }
   }
-  PG_ASSERT(0);
-}
 
-[[maybe_unused]] static void pg_linked_list_init(PgLinkedListNode *node) {
-  PG_ASSERT(node);
-  node->next = node;
-}
-
-[[nodiscard]]
-static bool pg_linked_list_is_empty(PgLinkedListNode *node) {
-  PG_ASSERT(node);
-  return node->next == node;
+  return res;
 }
 
+// TODO: Review in the context of multiple threads spawning and reaping
+// processes.
 [[maybe_unused]] [[nodiscard]]
-static PgLinkedListNode *pg_linked_list_tail(PgLinkedListNode *node) {
-  PG_ASSERT(node);
-  PgLinkedListNode *it = node;
-  for (; !pg_linked_list_is_empty(it); it = it->next) {
-  }
-  PG_ASSERT(it);
-  return it;
-}
-
-[[maybe_unused]] static void pg_linked_list_append(PgLinkedListNode *head,
-                                                   PgLinkedListNode *elem) {
-  PG_ASSERT(head);
-  PG_ASSERT(elem);
-
-  pg_linked_list_tail(head)->next = elem;
-}
+static PG_RESULT(PgProcessCaptureStd, PgError)
+    pg_process_capture_std_io(PgProcess process, u64 stdio_size_hint,
+                              u64 stderr_size_hint, PgAllocator *allocator) {
+  PG_RESULT(PgProcessCaptureStd, PgError) res = {0};
 
-[[nodiscard]] static PgHtmlNode *pg_html_node_get_parent(PgHtmlNode *node) {
-  PgLinkedListNode *linked_list_node = node->parent.next;
-  return PG_CONTAINER_OF(linked_list_node, PgHtmlNode, parent);
-}
+  PG_DYN(u8) stdout_sb = {0};
+  PG_DYN(u8) stderr_sb = {0};
 
-[[nodiscard]] static PgHtmlNode *
-pg_html_node_get_first_child(PgHtmlNode *node) {
-  PgLinkedListNode *linked_list_node = node->first_child.next;
-  return PG_CONTAINER_OF(linked_list_node, PgHtmlNode, first_child);
-}
+  if (process.stdout_pipe.fd) {
+    stdout_sb = pg_string_builder_make(
+        stdio_size_hint == 0 ? 4096 : stdio_size_hint, allocator);
+  }
 
-[[maybe_unused]] [[nodiscard]] static PgHtmlNode *
-pg_html_node_get_next_sibling(PgHtmlNode *node) {
-  PgLinkedListNode *linked_list_node = node->next_sibling.next;
-  return PG_CONTAINER_OF(linked_list_node, PgHtmlNode, next_sibling);
-}
+  if (process.stderr_pipe.fd) {
+    stderr_sb = pg_string_builder_make(
+        stderr_size_hint == 0 ? 4096 : stderr_size_hint, allocator);
+  }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHtmlNodePtr, PgError)
-    pg_html_parse(PgString s, PgAllocator *allocator) {
-  PG_RESULT(PG_DYN(PgHtmlToken), PgError)
-  res_tokens = pg_html_tokenize(s, allocator);
-  PG_IF_LET_ERR(err, res_tokens) { return PG_ERR(err, PgHtmlNodePtr, PgError); }
-  PG_SLICE(PgHtmlToken)
-  tokens = PG_DYN_TO_SLICE(PG_SLICE(PgHtmlToken), PG_UNWRAP(res_tokens));
+  while (process.stdout_pipe.fd || process.stderr_pipe.fd) {
+    struct pollfd pollfds[2] = {0};
+    nfds_t pollfds_len = 0;
 
-  PgHtmlNode *root =
-      pg_alloc(allocator, sizeof(PgHtmlNode), _Alignof(PgHtmlNode), 1);
-  pg_linked_list_init(&root->parent);
-  pg_linked_list_init(&root->first_child);
-  pg_linked_list_init(&root->next_sibling);
+    if (process.stdout_pipe.fd) {
+      pollfds[pollfds_len++] = (struct pollfd){
+          .fd = process.stdout_pipe.fd,
+          .events = POLLIN,
+      };
+    }
 
-  PgHtmlNode *parent = root;
+    if (process.stderr_pipe.fd) {
+      pollfds[pollfds_len++] = (struct pollfd){
+          .fd = process.stderr_pipe.fd,
+          .events = POLLIN,
+      };
+    }
 
-  PG_EACH_PTR(token, &tokens) {
-    PG_ASSERT(parent);
+    int res_poll = poll(pollfds, pollfds_len, -1);
+    if (-1 == res_poll) {
+      res = PG_ERR(errno, PgProcessCaptureStd, PgError);
+      goto end;
+    }
 
-    bool is_self_closing = ((PG_HTML_TOKEN_KIND_TAG_OPENING == token->kind) ||
-                            PG_HTML_TOKEN_KIND_TAG_CLOSING == token->kind) &&
-                           (pg_html_tag_is_self_closing(token->tag) ||
-                            pg_svg_tag_is_self_closing(token->tag));
+    if (0 == res_poll) {
+      break;
+    }
 
-    if (PG_HTML_TOKEN_KIND_TEXT == token->kind ||
-        PG_HTML_TOKEN_KIND_COMMENT == token->kind ||
-        PG_HTML_TOKEN_KIND_DOCTYPE == token->kind || is_self_closing) {
-      PgHtmlNode *node =
-          pg_alloc(allocator, sizeof(PgHtmlNode), _Alignof(PgHtmlNode), 1);
-      pg_linked_list_init(&node->parent);
-      pg_linked_list_init(&node->first_child);
-      pg_linked_list_init(&node->next_sibling);
-      node->token_start = node->token_end = *token;
-      node->parent.next = &parent->parent;
+    for (u64 i = 0; i < (u64)res_poll; i++) {
+      struct pollfd pollfd = PG_C_ARRAY_AT(pollfds, pollfds_len, i);
 
-      PgLinkedListNode *first_child_of_parent = &parent->first_child;
-      if (pg_linked_list_is_empty(first_child_of_parent)) {
-        first_child_of_parent->next = &node->first_child;
-      } else {
-        PgLinkedListNode *next_sibling_of_first_child_of_parent =
-            &pg_html_node_get_first_child(parent)->next_sibling;
-        pg_linked_list_append(next_sibling_of_first_child_of_parent,
-                              &node->next_sibling);
+      PgFileDescriptor *fd = &process.stdout_pipe;
+      PG_DYN(u8) *sb = &stdout_sb;
+      if (pollfd.fd == process.stderr_pipe.fd) {
+        fd = &process.stderr_pipe;
+        sb = &stderr_sb;
       }
-    } else if (PG_HTML_TOKEN_KIND_TAG_OPENING == token->kind) {
-      PgHtmlNode *node =
-          pg_alloc(allocator, sizeof(PgHtmlNode), _Alignof(PgHtmlNode), 1);
-      pg_linked_list_init(&node->parent);
-      pg_linked_list_init(&node->first_child);
-      pg_linked_list_init(&node->next_sibling);
-      node->token_start = node->token_end = *token;
-      node->parent.next = &parent->parent;
 
-      PgLinkedListNode *first_child_of_parent = &parent->first_child;
-      if (pg_linked_list_is_empty(first_child_of_parent)) {
-        first_child_of_parent->next = &node->first_child;
-      } else {
-        PgLinkedListNode *next_sibling_of_first_child_of_parent =
-            &pg_html_node_get_first_child(parent)->next_sibling;
-        pg_linked_list_append(next_sibling_of_first_child_of_parent,
-                              &node->next_sibling);
+      if (pollfd.revents & (POLLERR | POLLNVAL)) {
+        close(pollfd.fd);
+        fd->fd = 0;
+        continue;
       }
 
-      if (!is_self_closing) {
-        parent = node;
+      // Not sure why/how it could happen?
+      if (0 == (pollfd.revents & (POLLIN | POLLHUP))) {
+        close(pollfd.fd);
+        fd->fd = 0;
+        continue;
       }
-    } else if (PG_HTML_TOKEN_KIND_TAG_CLOSING == token->kind) {
-      PG_ASSERT(PG_HTML_TOKEN_KIND_TAG_OPENING == parent->token_start.kind &&
-                pg_string_eq(parent->token_start.tag, token->tag));
-      parent->token_end = *token;
 
-      parent = pg_html_node_get_parent(parent);
-    } else {
-      PG_ASSERT(0 && "todo");
+      u8 tmp[4096] = {0};
+      ssize_t read_n = read(pollfd.fd, tmp, PG_STATIC_ARRAY_LEN(tmp));
+      if (-1 == read_n) {
+        res = PG_ERR(errno, PgProcessCaptureStd, PgError);
+        goto end;
+      }
+      if (0 == read_n) {
+        close(pollfd.fd);
+        fd->fd = 0;
+        continue;
+      }
+
+      PgString actually_read = {.data = tmp, .len = (u64)read_n};
+      PG_DYN_APPEND_SLICE(sb, actually_read, allocator);
     }
   }
 
-  // All tags correctly closed.
-  PG_ASSERT(parent == root);
-
-  PG_ASSERT(pg_linked_list_is_empty(&root->next_sibling));
-  PG_ASSERT(pg_linked_list_is_empty(&root->parent));
-  PG_ASSERT(root->parent.next == &root->parent);
-  return PG_OK(root, PgHtmlNodePtr, PgError);
-}
-
-[[maybe_unused]] [[nodiscard]] static bool
-pg_html_node_is_title_opening(PgHtmlNode *node) {
-  return (PG_HTML_TOKEN_KIND_TAG_OPENING == node->token_start.kind) &&
-         (pg_string_eq(node->token_start.tag, PG_S("h1")) ||
-          pg_string_eq(node->token_start.tag, PG_S("h2")) ||
-          pg_string_eq(node->token_start.tag, PG_S("h3")) ||
-          pg_string_eq(node->token_start.tag, PG_S("h4")) ||
-          pg_string_eq(node->token_start.tag, PG_S("h5")) ||
-          pg_string_eq(node->token_start.tag, PG_S("h6")));
-}
-
-[[maybe_unused]] [[nodiscard]] static u8
-pg_html_node_get_title_level(PgHtmlNode *node) {
-  if (!pg_html_node_is_title_opening(node)) {
-    return 0;
+end:
+  if (PG_IS_ERR(res)) {
+    pg_free(allocator, stdout_sb.data);
+    pg_free(allocator, stderr_sb.data);
   }
 
-  PG_OPTION(PgRune) last_opt = pg_string_last(node->token_start.tag);
-  if (!last_opt.has_value) {
-    return 0;
+  if (process.stdin_pipe.fd) {
+    close(process.stdin_pipe.fd);
+  }
+  if (process.stdout_pipe.fd) {
+    close(process.stdout_pipe.fd);
+  }
+  if (process.stderr_pipe.fd) {
+    close(process.stderr_pipe.fd);
   }
 
-  PgRune last = last_opt.value;
-  PG_ASSERT(pg_rune_ascii_is_numeric(last));
-  return (u8)last - '0';
+  PgProcessCaptureStd capture = {0};
+  capture.stdout_captured = PG_DYN_TO_SLICE(PgString, stdout_sb);
+  capture.stderr_captured = PG_DYN_TO_SLICE(PgString, stderr_sb);
+  return PG_OK(capture, PgProcessCaptureStd, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_html_node_get_simple_title_content(PgHtmlNode *node) {
-  if (!pg_html_node_is_title_opening(node)) {
-    return PG_S("");
+[[maybe_unused]] [[nodiscard]]
+static PG_RESULT(PgProcessStatus, PgError)
+    pg_process_wait(PgProcess process, u64 stdio_size_hint,
+                    u64 stderr_size_hint, PgAllocator *allocator) {
+  PG_RESULT(PgProcessCaptureStd, PgError)
+  res_capture = pg_process_capture_std_io(process, stdio_size_hint,
+                                          stderr_size_hint, allocator);
+  PG_IF_LET_ERR(err, res_capture) {
+    return PG_ERR(err, PgProcessStatus, PgError);
   }
-  PG_ASSERT(!pg_linked_list_is_empty(&node->first_child));
-  PgHtmlNode *child =
-      PG_CONTAINER_OF(node->first_child.next, PgHtmlNode, first_child);
-  PG_ASSERT(PG_HTML_TOKEN_KIND_TEXT == child->token_start.kind);
-  PgString res = child->token_start.text;
 
-  PG_ASSERT(!pg_string_is_empty(res));
-  return res;
-}
+  int status = 0;
+  int ret = 0;
+  do {
+    ret = waitpid((pid_t)process.pid, &status, 0);
+  } while (-1 == ret && EINTR == errno);
 
-// Caller is responsible for proper locking.
-[[maybe_unused]] [[nodiscard]]
-static PgThreadPoolTask *pg_thread_pool_dequeue_task(PgThreadPool *pool) {
-  PG_ASSERT(pool);
-  PG_ASSERT(pool->tasks);
-  PgThreadPoolTask *res = pool->tasks;
-  pool->tasks = pool->tasks->next;
-  return res;
-}
+  if (-1 == ret) {
+    return PG_ERR(errno, PgProcessStatus, PgError);
+  }
 
-static i32 pg_pool_worker_start_fn(void *data) {
-  PG_ASSERT(data);
-  PgThreadPool *pool = data;
+  PgProcessCaptureStd capture = PG_UNWRAP(res_capture);
 
-  for (;;) {
-    PG_ASSERT(0 == pg_mtx_lock(&pool->tasks_mtx));
-    while (!pool->tasks) {
-      if (pool->done) {
-        PG_ASSERT(0 == pg_mtx_unlock(&pool->tasks_mtx));
-        return 0;
-      }
+  PgProcessStatus res = {0};
+  res.exit_status = WEXITSTATUS(status);
+  res.exited = WIFEXITED(status);
+  res.signaled = WIFSIGNALED(status);
+  res.signal = WTERMSIG(status);
+  res.core_dumped = WCOREDUMP(status);
+  res.stopped = WIFSTOPPED(status);
+  res.stdout_captured = capture.stdout_captured;
+  res.stderr_captured = capture.stderr_captured;
 
-      PG_ASSERT(0 == pg_cnd_wait(&pool->tasks_cnd, &pool->tasks_mtx));
-    }
+  return PG_OK(res, PgProcessStatus, PgError);
+}
 
-    PgThreadPoolTask *task = pg_thread_pool_dequeue_task(pool);
-    PG_ASSERT(0 == pg_mtx_unlock(&pool->tasks_mtx));
+[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stdin() {
+  return (PgFileDescriptor){.fd = STDIN_FILENO};
+}
+[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stdout() {
+  return (PgFileDescriptor){.fd = STDOUT_FILENO};
+}
+[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stderr() {
+  return (PgFileDescriptor){.fd = STDERR_FILENO};
+}
 
-    PG_ASSERT(task);
-    PG_ASSERT(task->fn);
+[[nodiscard]] i32 pg_os_get_last_error() { return errno; }
 
-    (void)task->fn(task->data);
+[[nodiscard]] i32 pg_virtual_mem_flags_to_os_flags(PgVirtualMemFlags flags) {
+  u64 res = 0;
+  if (flags & PG_VIRTUAL_MEM_FLAGS_READ) {
+    res |= PROT_READ;
+  }
+  if (flags & PG_VIRTUAL_MEM_FLAGS_WRITE) {
+    res |= PROT_WRITE;
+  }
+  if (flags & PG_VIRTUAL_MEM_FLAGS_EXEC) {
+    res |= PROT_EXEC;
   }
+  return (i32)res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgThreadPool, PgError)
-    pg_thread_pool_make(u32 size, PgAllocator *allocator) {
-  PgThreadPool res = {0};
+[[nodiscard]] PG_RESULT(PgVoidPtr, PgError)
+    pg_virtual_mem_alloc(u64 size, PgVirtualMemFlags flags) {
+  PG_ASSERT(size > 0);
 
-  if (0 != pg_mtx_init(&res.tasks_mtx, PG_MUTEX_KIND_PLAIN)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgThreadPool, PgError);
+  PgVoidPtr ret = mmap(nullptr, size, pg_virtual_mem_flags_to_os_flags(flags),
+                       MAP_ANON | MAP_PRIVATE, -1, 0);
+  if ((void *)-1 == ret) {
+    return PG_ERR(errno, PgVoidPtr, PgError);
   }
 
-  if (0 != pg_cnd_init(&res.tasks_cnd)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgThreadPool, PgError);
-  }
+  return PG_OK(ret, PgVoidPtr, PgError);
+}
 
-  res.workers.len = size;
-  res.workers.data =
-      pg_alloc(allocator, sizeof(PgThread), _Alignof(PgThread), size);
+[[nodiscard]] PG_RESULT(PgVirtualMemFile, PgError)
+    pg_virtual_mem_map_file(PgString path, PgFileAccess access,
+                            bool create_if_not_exists) {
+  PgError err = 0;
 
-  PG_EACH_PTR(it, &res.workers) {
-    PG_RESULT(PgThread, PgError)
-    res_thread = pg_thread_create(pg_pool_worker_start_fn, it);
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_fd = pg_file_open(path, access, 0600, create_if_not_exists, nullptr);
+  PG_IF_LET_ERR(err, res_fd) { return PG_ERR(err, PgVirtualMemFile, PgError); }
+  PgFileDescriptor fd = PG_UNWRAP(res_fd);
 
-    PG_IF_LET_ERR(err, res_thread) {
-      return PG_ERR(err, PgThreadPool, PgError);
-    }
+  PG_RESULT(u64, PgError) res_size = pg_file_size(fd);
+  PG_IF_LET_ERR(_err, res_size) {
+    err = _err;
+    goto end;
+  }
+  u64 size = PG_UNWRAP(res_size);
 
-    *it = PG_UNWRAP(res_thread);
+  i32 prot = 0;
+  switch (access) {
+  case PG_FILE_ACCESS_READ:
+    prot = PROT_READ;
+    break;
+  case PG_FILE_ACCESS_WRITE:
+    prot = PROT_WRITE;
+    break;
+  case PG_FILE_ACCESS_READ_WRITE:
+    prot = PROT_READ | PROT_WRITE;
+    break;
+  case PG_FILE_ACCESS_NONE:
+    break;
+  default:
+    PG_ASSERT(0);
   }
 
-  return PG_OK(res, PgThreadPool, PgError);
-}
+  u8 *mem = mmap(nullptr, size, prot, MAP_PRIVATE, fd.fd, 0);
+  if ((void *)-1 == mem) {
+    err = errno;
+    goto end;
+  }
 
-[[maybe_unused]]
-static void pg_thread_pool_enqueue_task(PgThreadPool *pool, PgThreadFn fn,
-                                        void *data, PgAllocator *allocator) {
-  PG_ASSERT(pool);
-  PG_ASSERT(fn);
-  PG_ASSERT(data);
-  PG_ASSERT(allocator);
+  PgVirtualMemFile res = {.data = {.data = mem, .len = size}};
 
-  PgThreadPoolTask *task = PG_NEW(PgThreadPoolTask, allocator);
-  task->data = data;
-  task->fn = fn;
+end:
+  (void)pg_file_close(fd);
+  return err ? PG_ERR(err, PgVirtualMemFile, PgError)
+             : PG_OK(res, PgVirtualMemFile, PgError);
+}
 
-  PG_ASSERT(0 == pg_mtx_lock(&pool->tasks_mtx));
-  if (!pool->tasks) {
-    pool->tasks = task;
-  } else {
-    task->next = pool->tasks;
-    pool->tasks = task;
+[[nodiscard]] PgError pg_virtual_mem_protect(void *ptr, u64 size,
+                                             PgVirtualMemFlags flags_new) {
+  if (-1 == mprotect(ptr, size, pg_virtual_mem_flags_to_os_flags(flags_new))) {
+    return (PgError)pg_os_get_last_error();
   }
-  PG_ASSERT(0 == pg_cnd_signal(&pool->tasks_cnd));
-  PG_ASSERT(0 == pg_mtx_unlock(&pool->tasks_mtx));
+  return 0;
 }
 
-[[maybe_unused]] static void pg_thread_pool_wait(PgThreadPool *pool) {
-  PG_ASSERT(0 == pg_mtx_lock(&pool->tasks_mtx));
-  pool->done = true;
-  PG_ASSERT(0 == pg_cnd_broadcast(&pool->tasks_cnd));
-  PG_ASSERT(0 == pg_mtx_unlock(&pool->tasks_mtx));
-
-  PG_EACH_PTR(w, &pool->workers) { (void)pg_thread_join(*w); }
+[[nodiscard]] PgError pg_virtual_mem_release(void *ptr, u64 size) {
+  if (-1 == munmap(ptr, size)) {
+    return (PgError)pg_os_get_last_error();
+  }
+  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgElfSymbolType
-pg_elf_symbol_get_type(PgElfSymbolTableEntry sym) {
-  return sym.info & 0xf;
-}
-
-[[maybe_unused]] [[nodiscard]] static PgElfSymbolBind
-pg_elf_symbol_get_bind(PgElfSymbolTableEntry sym) {
-  return sym.info >> 4;
-}
-
-[[nodiscard]] static PG_RESULT(PG_SLICE(u8), PgError)
-    pg_elf_get_section_header_bytes(PgElf elf, u32 section_idx) {
-  if (section_idx >= elf.section_headers.len) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+[[maybe_unused]] [[nodiscard]] static clockid_t
+pg_clock_to_linux(PgClockKind clock_kind) {
+  switch (clock_kind) {
+  case PG_CLOCK_KIND_MONOTONIC:
+    return CLOCK_MONOTONIC;
+  case PG_CLOCK_KIND_REALTIME:
+    return CLOCK_REALTIME;
+  default:
+    PG_ASSERT(0);
   }
+}
 
-  PgElfSectionHeader section = PG_SLICE_AT(elf.section_headers, section_idx);
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_time_ns_now(PgClockKind clock) {
+  struct timespec ts = {0};
+  int ret = 0;
+  do {
+    ret = clock_gettime(pg_clock_to_linux(clock), &ts);
+  } while (-1 == ret && EINTR == errno);
 
-  u64 end = 0;
-  if (__builtin_add_overflow(section.offset, section.size, &end)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+  if (-1 == ret) {
+    return PG_ERR(errno, u64, PgError);
   }
 
-  if (end >= elf.bytes.len) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
-  }
+  u64 res = (u64)ts.tv_sec * PG_Seconds + (u64)ts.tv_nsec;
 
-  return PG_OK(PG_SLICE_RANGE(elf.bytes, section.offset, end), PG_SLICE(u8),
-               PgError);
+  return PG_OK(res, u64, PgError);
 }
 
-[[nodiscard]] static PG_RESULT(PgString, PgError)
-    pg_elf_get_sh_string_at(PgElf elf, u32 offset) {
-  PG_SLICE(u8)
-  bytes = PG_TRY(pg_elf_get_section_header_bytes(
-                     elf, elf.header.section_header_shstrtab_index),
-                 PgString, PgError);
+[[maybe_unused]] static u64
+pg_fill_stack_trace_from_frame(u64 *frame_pointer, u64 skip, u64 pie_offset,
+                               u64 stack_trace[PG_STACK_TRACE_MAX]) {
+  u64 res = 0;
 
-  if (offset >= bytes.len) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgString, PgError);
-  }
+  while (res < PG_STACK_TRACE_MAX && frame_pointer != 0) {
+    u64 instruction_pointer = *(frame_pointer + 1);
+    // Careful not to enter an infinite recursion of `PG_ASSERT ->
+    // pg_fill_stack_trace`.
+    PG_ASSERT_TRAP_ONLY(instruction_pointer >= pie_offset);
 
-  PG_SLICE(u8) at = PG_SLICE_RANGE_START(bytes, offset);
-  PG_OPTION(PgString) s = pg_str0_to_string(at);
+    if (0 == skip) {
+      stack_trace[res++] = (instruction_pointer)-pie_offset;
+    } else {
+      skip--;
+    }
 
-  if (!s.has_value) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgString, PgError);
+    // FIXME: If the current function is inlined, do not walk up the stack.
+    u64 *frame_pointer_next = (u64 *)*frame_pointer;
+    // The stack grows down: stop at the outermost frame e.g. in libc, whose
+    // frame pointer may be garbage instead of null.
+    if (frame_pointer_next <= frame_pointer) {
+      break;
+    }
+    frame_pointer = frame_pointer_next;
   }
 
-  return PG_OK(s.value, PgString, PgError);
+  return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
-    pg_elf_get_string_at(PgElf elf, u32 offset) {
-  PG_SLICE(u8)
-  bytes = PG_TRY(
-      pg_elf_get_section_header_bytes(elf, elf.section_header_strtab_idx),
-      PgString, PgError);
-
-  if (offset >= bytes.len) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgString, PgError);
-  }
-
-  PG_SLICE(u8) at = PG_SLICE_RANGE_START(bytes, offset);
-
-  PgBytesCut cut = pg_bytes_cut_byte(at, 0);
-  if (!cut.has_value) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgString, PgError);
-  }
-
-  return PG_OK(cut.left, PgString, PgError);
+[[maybe_unused]] static u64
+pg_fill_stack_trace(u64 skip, u64 pie_offset,
+                    u64 stack_trace[PG_STACK_TRACE_MAX]) {
+  return pg_fill_stack_trace_from_frame(__builtin_frame_address(0), skip,
+                                        pie_offset, stack_trace);
 }
 
-[[nodiscard]] static PgElfSectionHeader *
-pg_elf_section_header_find_ptr_by_name_and_kind(PgElf *elf, PgString name,
-                                                PgElfSectionHeaderKind kind) {
-  PG_ASSERT(elf);
+[[nodiscard]] static u64 pg_os_get_page_size() {
+  i64 ret = 0;
+  do {
+    ret = sysconf(_SC_PAGE_SIZE);
+  } while (-1 == ret && EINTR == errno);
 
-  PG_EACH_PTR(section, &elf->section_headers) {
-    if (kind != section->kind) {
-      continue;
-    }
+  PG_ASSERT(ret > 0);
 
-    PG_RESULT(PgString, PgError)
-    res_str = pg_elf_get_sh_string_at(*elf, section->name);
-    if (PG_IS_ERR(res_str)) {
-      continue;
-    }
+  return (u64)ret;
+}
 
-    PgString value = PG_UNWRAP(res_str);
-    if (!pg_string_eq(value, name)) {
-      continue;
-    }
+// Online CPUs.
+[[maybe_unused]] [[nodiscard]] static u64 pg_os_get_cpu_count() {
+  i64 ret = sysconf(_SC_NPROCESSORS_ONLN);
 
-    return section;
-  }
-  return nullptr;
+  return ret > 0 ? (u64)ret : 1;
 }
 
-[[nodiscard]] static PG_RESULT(PG_SLICE(u8), PgError)
-    pg_elf_section_header_find_bytes_by_name_and_kind(
-        PgElf elf, PgString name, PgElfSectionHeaderKind kind) {
-  PG_RESULT(PG_SLICE(u8), PgError) res = {0};
-
-  PgElfSectionHeader *section_header =
-      pg_elf_section_header_find_ptr_by_name_and_kind(&elf, name, kind);
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_file_read(PgFileDescriptor file, PgString buf) {
+  isize n = 0;
+  do {
+    n = read(file.fd, buf.data, buf.len);
+  } while (-1 == n && EINTR == errno);
 
-  if (!section_header) {
-    return res;
+  if (-1 == n) {
+    return PG_ERR(errno, u64, PgError);
   }
 
-  u64 section_idx = section_header - elf.section_headers.data;
-  return pg_elf_get_section_header_bytes(elf, section_idx);
+  return PG_OK((u64)n, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgElf, PgError)
-    pg_elf_parse(PG_SLICE(u8) elf_bytes) {
-  PgElf res = {0};
-  res.bytes = elf_bytes;
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_file_write(PgFileDescriptor file, PgString s) {
+  isize n = 0;
+  do {
+    n = write(file.fd, s.data, s.len);
+  } while (-1 == n && EINTR == errno);
 
-  if (elf_bytes.len < sizeof(PgElfHeader)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgElf, PgError);
+  if (-1 == n) {
+    return PG_ERR(errno, u64, PgError);
   }
-  pg_memcpy(&res.header, elf_bytes.data, sizeof(res.header));
 
-  // Section headers.
-  {
-    PgElfHeader h = res.header;
-    u64 section_headers_size = 0;
-    if (__builtin_mul_overflow(h.section_header_entries_count,
-                               h.section_header_entry_size,
-                               &section_headers_size)) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgElf, PgError);
-    }
+  return PG_OK((u64)n, u64, PgError);
+}
 
-    u64 section_headers_end = 0;
-    if (__builtin_add_overflow(h.section_header_offset, section_headers_size,
-                               &section_headers_end)) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgElf, PgError);
-    }
-    PG_ASSERT(h.section_header_offset <= section_headers_end);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_truncate(PgFileDescriptor file, u64 size) {
+  if (-1 == ftruncate(file.fd, (i64)size)) {
+    return (PgError)pg_os_get_last_error();
+  }
+  return 0;
+}
 
-    PG_SLICE(u8)
-    section_headers_bytes =
-        PG_SLICE_RANGE(elf_bytes, h.section_header_offset, section_headers_end);
-    res.section_headers = (PG_DYN(PgElfSectionHeader)){
-        .data = (void *)section_headers_bytes.data,
-        .len = h.section_header_entries_count,
-        .cap = h.section_header_entries_count,
-    };
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_file_read_at(PgFileDescriptor file, PgString buf, u64 offset) {
+  isize n = 0;
+  do {
+    n = pread(file.fd, buf.data, buf.len, (off_t)offset);
+  } while (-1 == n && EINTR == errno);
 
-    PgElfSectionHeader *section_text =
-        pg_elf_section_header_find_ptr_by_name_and_kind(
-            &res, PG_S(".text"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
-    if (section_text) {
-      u32 idx = section_text - res.section_headers.data;
-      res.section_header_text_idx = idx;
-    }
+  if (-1 == n) {
+    return PG_ERR(errno, u64, PgError);
   }
 
-  return PG_OK(res, PgElf, PgError);
+  return PG_OK((u64)n, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_SLICE(u8), PgError)
-    pg_elf_symbol_get_program_text(PgElf elf, PgElfSymbolTableEntry sym) {
-  if (elf.section_header_text_idx != sym.section_header_table_index) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_file_open(PgString path, PgFileAccess access, u64 mode,
+                 bool create_if_not_exists, PgAllocator *) {
+  if (path.len > PG_PATH_MAX - 1) {
+    return PG_ERR(errno, PgFileDescriptor, PgError);
   }
 
-  PG_SLICE(u8)
-  bytes =
-      PG_TRY(pg_elf_get_section_header_bytes(elf, elf.section_header_text_idx),
-             PG_SLICE(u8), PgError);
-
-  if (sym.value >= bytes.len) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+  int flags = 0;
+  switch (access & PG_FILE_ACCESS_ALL) {
+  case PG_FILE_ACCESS_READ:
+    flags = O_RDONLY;
+    break;
+  case PG_FILE_ACCESS_WRITE:
+    flags = O_WRONLY | O_TRUNC;
+    break;
+  case PG_FILE_ACCESS_READ_WRITE:
+    flags = O_RDWR;
+    break;
+  case PG_FILE_ACCESS_NONE:
+  default:
+    PG_ASSERT(0);
   }
 
-  u64 end = 0;
-  if (__builtin_add_overflow(sym.value, sym.size, &end)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+  if (create_if_not_exists) {
+    flags |= O_CREAT;
   }
 
-  return PG_OK(PG_SLICE_RANGE(bytes, sym.value, end), PG_SLICE(u8), PgError);
-}
-
-#if defined(PG_OS_FREEBSD) || defined(PG_OS_APPLE)
-#include <sys/event.h>
+  u8 path_c[PG_PATH_MAX] = {0};
+  pg_memcpy(path_c, path.data, path.len);
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgAio, PgError) pg_aio_init() {
-  i32 ret = kqueue();
-  if (-1 == ret) {
-    return PG_ERR(errno, PgAio, PgError);
+  int fd = open((char *)path_c, flags, mode ? mode : 0600);
+  if (-1 == fd) {
+    return PG_ERR(errno, PgFileDescriptor, PgError);
   }
 
-  return PG_OK((PgAio){.aio.fd = ret}, PgAio, PgError);
+  PgFileDescriptor res = {.fd = fd};
+  return PG_OK(res, PgFileDescriptor, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
-    pg_aio_register_interest_fs_name(PgAio *aio, PgString name,
-                                     PgAioEventKind interest,
-                                     PgAllocator *allocator) {
-  PgFileDescriptor fd =
-      PG_TRY(pg_file_open(name, PG_FILE_ACCESS_READ, 0666, false, allocator),
-             PgFileDescriptor, PgError);
-
-  PgError err = pg_aio_register_interest_fd(*aio, fd, interest);
-  if (err) {
-    (void)pg_file_close(fd);
-    return PG_ERR(err, PgFileDescriptor, PgError);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_close(PgFileDescriptor file) {
+  if (-1 == close(file.fd)) {
+    return (PgError)pg_os_get_last_error();
   }
 
-  PgAioFsNode *fs_node = pg_aio_fs_node_upsert(&aio->fs_nodes, fd, allocator);
-  PG_ASSERT(fs_node);
-  fs_node->name = name;
-
-  return PG_OK(fd, PgFileDescriptor, PgError);
+  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_aio_register_interest_fd(PgAio aio, PgFileDescriptor fd,
-                            PgAioEventKind interest) {
-  struct kevent changelist[1] = {0};
-  changelist[0].ident = (u64)fd.fd;
-  changelist[0].flags = EV_ADD;
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_file_size(PgFileDescriptor file) {
+  struct stat st = {0};
 
-  if (interest & PG_AIO_EVENT_KIND_READABLE) {
-    changelist[0].filter |= EVFILT_READ;
-  }
-  if (interest & PG_AIO_EVENT_KIND_WRITABLE) {
-    changelist[0].filter |= EVFILT_WRITE;
-  }
-  if (interest & PG_AIO_EVENT_KIND_FILE_CREATED) {
-    // TODO
-  }
-  if (interest & PG_AIO_EVENT_KIND_FILE_MODIFIED) {
-    changelist[0].filter |= EVFILT_VNODE;
-    changelist[0].fflags |= NOTE_WRITE;
-  }
-  if (interest & PG_AIO_EVENT_KIND_FILE_DELETED) {
-    changelist[0].filter |= EVFILT_VNODE;
-    changelist[0].fflags |= NOTE_DELETE;
-  }
+  int ret = 0;
+  do {
+    ret = fstat(file.fd, &st);
+  } while (-1 == ret && EINTR == errno);
 
-  i32 ret = kevent(aio.aio.fd, changelist, 1, nullptr, 0, nullptr);
   if (-1 == ret) {
-    return (PgError)errno;
+    return PG_ERR(errno, u64, PgError);
   }
 
-  return 0;
+  return PG_OK(st.st_size, u64, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_aio_unregister_interest(PgAio aio, PgFileDescriptor fd,
-                           PgAioEventKind interest) {
-  struct kevent changelist[1] = {0};
-  changelist[0].ident = (u64)fd.fd;
-  changelist[0].flags = EV_DELETE;
-
-  if (PG_AIO_EVENT_KIND_FILE_MODIFIED & interest) {
-    changelist[0].filter = EVFILT_VNODE;
-    changelist[0].fflags = NOTE_WRITE;
-  }
-  if (PG_AIO_EVENT_KIND_FILE_DELETED & interest) {
-    changelist[0].filter = EVFILT_VNODE;
-    changelist[0].fflags = NOTE_DELETE;
-  }
-  if (PG_AIO_EVENT_KIND_FILE_CREATED & interest) {
-    // TODO
-  }
-  if (PG_AIO_EVENT_KIND_READABLE & interest) {
-    changelist[0].filter = EVFILT_READ;
-  }
-  if (PG_AIO_EVENT_KIND_WRITABLE & interest) {
-    changelist[0].filter = EVFILT_WRITE;
-  }
-
-  i32 ret = kevent(aio.aio.fd, changelist, 1, nullptr, 0, nullptr);
-  if (-1 == ret && ENOENT != errno) {
-    return (PgError)errno;
-  }
+[[nodiscard]] static PgFileStat pg_file_stat_from_os(struct stat st) {
+#ifdef PG_OS_APPLE
+  struct timespec mtime = st.st_mtimespec;
+#else
+  struct timespec mtime = st.st_mtim;
+#endif
 
-  return 0;
+  return (PgFileStat){
+      .size = (u64)st.st_size,
+      .mtime_ns = (u64)mtime.tv_sec * PG_Seconds + (u64)mtime.tv_nsec,
+      .ino = (u64)st.st_ino,
+      .dev = (u64)st.st_dev,
+      .regular = S_ISREG(st.st_mode),
+      .directory = S_ISDIR(st.st_mode),
+  };
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_aio_wait(PgAio aio, PG_SLICE(PgAioEvent) events_out,
-                PG_OPTION(u32) timeout_ms) {
-  PG_RESULT(u64, PgError) res = {0};
-
-  struct kevent eventlist[1024] = {0};
-  u64 eventlist_len = PG_MIN(PG_STATIC_ARRAY_LEN(eventlist), events_out.len);
-  if (0 == eventlist_len) {
-    return res;
-  }
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileStat, PgError)
+    pg_file_stat(PgFileDescriptor file) {
+  struct stat st = {0};
 
-  struct timespec timeout = {0};
-  if (timeout_ms.has_value) {
-    timeout.tv_sec = timeout_ms.value / 1000;
-    timeout.tv_nsec = (timeout_ms.value % 1000) * 1000 * 1000;
-  }
+  int ret = 0;
+  do {
+    ret = fstat(file.fd, &st);
+  } while (-1 == ret && EINTR == errno);
 
-  i32 ret = kevent(aio.aio.fd, nullptr, 0, eventlist, eventlist_len,
-                   timeout_ms.has_value ? &timeout : nullptr);
   if (-1 == ret) {
-    return PG_ERR(errno, u64, PgError);
+    return PG_ERR(errno, PgFileStat, PgError);
   }
 
-  for (u64 i = 0; i < (u64)ret; i++) {
-    struct kevent kevent = PG_C_ARRAY_AT(eventlist, eventlist_len, i);
-    PgAioEvent *ev = PG_SLICE_AT_PTR(&events_out, i);
-    ev->fd.fd = kevent.ident;
+  return PG_OK(pg_file_stat_from_os(st), PgFileStat, PgError);
+}
 
-    if (EV_ERROR & kevent.flags) {
-      ev->kind |= PG_AIO_EVENT_KIND_ERROR;
-    }
-    if (EV_EOF & kevent.flags) {
-      ev->kind |= PG_AIO_EVENT_KIND_EOF;
-    }
-    if (EVFILT_READ & kevent.filter) {
-      ev->kind |= PG_AIO_EVENT_KIND_READABLE;
-    }
-    if (EVFILT_WRITE & kevent.filter) {
-      ev->kind |= PG_AIO_EVENT_KIND_WRITABLE;
-    }
-    if ((EVFILT_VNODE & kevent.filter) && (NOTE_DELETE & kevent.fflags)) {
-      ev->kind |= PG_AIO_EVENT_KIND_FILE_DELETED;
-    }
-    if ((EVFILT_VNODE & kevent.filter) && (NOTE_WRITE & kevent.fflags)) {
-      ev->kind |= PG_AIO_EVENT_KIND_FILE_MODIFIED;
-    }
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileStat, PgError)
+    pg_file_stat_from_path(PgString path, PgAllocator *) {
+  if (path.len > PG_PATH_MAX - 1) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgFileStat, PgError);
   }
 
-  return PG_OK(ret, u64, PgError);
-};
+  u8 path_c[PG_PATH_MAX] = {0};
+  pg_memcpy(path_c, path.data, path.len);
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_aio_wait_cqe(PgAio aio, PgRing *cqe, PG_OPTION(u32) timeout_ms) {
-  // TODO: Use `pg_aio_wait` ?
+  struct stat st = {0};
 
-  u64 can_write_count = pg_ring_can_write_count(*cqe) / sizeof(PgAioEvent);
+  int ret = 0;
+  do {
+    ret = stat((char *)path_c, &st);
+  } while (-1 == ret && EINTR == errno);
 
-  struct kevent eventlist[1024] = {0};
-  u64 eventlist_len = PG_MIN(PG_STATIC_ARRAY_LEN(eventlist), can_write_count);
-  if (0 == eventlist_len) {
-    return PG_OK(0, u64, PgError);
+  if (-1 == ret) {
+    return PG_ERR(errno, PgFileStat, PgError);
   }
 
-  struct timespec timeout = {0};
-  if (timeout_ms.has_value) {
-    timeout.tv_sec = timeout_ms.value / 1000;
-    timeout.tv_nsec = (timeout_ms.value % 1000) * 1000 * 1000;
-  }
+  return PG_OK(pg_file_stat_from_os(st), PgFileStat, PgError);
+}
 
-  i32 ret = kevent(aio.aio.fd, nullptr, 0, eventlist, eventlist_len,
-                   timeout_ms.has_value ? &timeout : nullptr);
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_net_socket_read_non_blocking(PgFileDescriptor socket, PgString dst) {
+  i64 ret = recv(socket.fd, dst.data, dst.len, MSG_DONTWAIT);
   if (-1 == ret) {
     return PG_ERR(errno, u64, PgError);
   }
 
-  for (u64 i = 0; i < (u64)ret; i++) {
-    struct kevent kevent = PG_C_ARRAY_AT(eventlist, eventlist_len, i);
-    PgAioEvent ev = {0};
-    ev.fd.fd = kevent.ident;
-
-    if (EV_ERROR & kevent.flags) {
-      ev.kind |= PG_AIO_EVENT_KIND_ERROR;
-    }
-    if (EV_EOF & kevent.flags) {
-      ev.kind |= PG_AIO_EVENT_KIND_EOF;
-    }
-    if (EVFILT_READ & kevent.filter) {
-      ev.kind |= PG_AIO_EVENT_KIND_READABLE;
-    }
-    if (EVFILT_WRITE & kevent.filter) {
-      ev.kind |= PG_AIO_EVENT_KIND_WRITABLE;
-    }
-    if ((EVFILT_VNODE & kevent.filter) && (NOTE_DELETE & kevent.fflags)) {
-      ev.kind |= PG_AIO_EVENT_KIND_FILE_DELETED;
-    }
-    if ((EVFILT_VNODE & kevent.filter) && (NOTE_WRITE & kevent.fflags)) {
-      ev.kind |= PG_AIO_EVENT_KIND_FILE_MODIFIED;
-    }
-
-    PG_SLICE(u8) ev_bytes = {.data = (u8 *)&ev, .len = sizeof(ev)};
-    PG_ASSERT(sizeof(ev) == pg_ring_write_bytes(cqe, ev_bytes));
-  }
-
-  return PG_OK(ret, u64, PgError);
+  return PG_OK((u64)ret, u64, PgError);
 }
 
-#endif
-
+// Whether nothing was received on the socket and the peer did not close it,
+// without blocking. This is the state of a reusable idle connection.
 [[maybe_unused]] [[nodiscard]] static bool
-pg_aio_is_fs_event_kind(PgAioEventKind kind) {
-  switch (kind) {
-  case PG_AIO_EVENT_KIND_FILE_MODIFIED:
-  case PG_AIO_EVENT_KIND_FILE_DELETED:
-  case PG_AIO_EVENT_KIND_FILE_CREATED:
-    return true;
+pg_net_socket_is_idle(PgFileDescriptor socket) {
+  u8 c = 0;
+  i64 ret = 0;
+  do {
+    ret = recv(socket.fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+  } while (-1 == ret && EINTR == errno);
 
-  case PG_AIO_EVENT_KIND_READABLE:
-  case PG_AIO_EVENT_KIND_WRITABLE:
-  case PG_AIO_EVENT_KIND_NONE:
-  case PG_AIO_EVENT_KIND_ERROR:
-  case PG_AIO_EVENT_KIND_EOF:
-    return false;
+  return -1 == ret && (EAGAIN == errno || EWOULDBLOCK == errno);
+}
 
-  default:
-    PG_ASSERT(0);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_fd_set_blocking(PgFileDescriptor fd, bool block) {
+  i32 ret = 0;
+  do {
+    ret = fcntl(fd.fd, F_GETFL, O_NONBLOCK);
+  } while (-1 == ret && EINTR == errno);
+  if (-1 == ret) {
+    return (PgError)errno;
   }
-}
 
-[[nodiscard]] static PG_OPTION(PgDebugFunctionDeclaration)
-    pg_dwarf_find_function_by_addr(PG_DYN(PgDebugFunctionDeclaration) fns,
-                                   u64 addr) {
-  PG_OPTION(PgDebugFunctionDeclaration) res = {0};
+  i32 flags = ret;
+  if (block) {
+    flags &= ~O_NONBLOCK;
+  } else {
+    flags |= O_NONBLOCK;
+  }
 
-  PG_EACH_PTR(fn, &fns) {
-    if (fn->low_pc <= addr && addr < fn->high_pc) {
-      res.has_value = true;
-      res.value = *fn;
-      return res;
-    }
+  do {
+    ret = fcntl(fd.fd, F_SETFL, flags);
+  } while (-1 == ret && EINTR == errno);
+  if (-1 == ret) {
+    return (PgError)errno;
   }
 
-  return res;
+  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]]
-static PgError pg_debug_print_function(PgWriter *w,
-                                       PgDebugFunctionDeclaration fn,
-                                       PgAllocator *allocator) {
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("inlined="), allocator));
-  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, fn.inlined, allocator));
-  PG_ERR_RETURN(
-      pg_writer_write_full(w, PG_S(" debug_info_offset="), allocator));
-  PG_ERR_RETURN(pg_writer_write_u64_hex(w, fn.debug_info_offset, allocator));
-  PG_ERR_RETURN(
-      pg_writer_write_full(w, PG_S(" debug_info_offset_ref="), allocator));
-  PG_ERR_RETURN(
-      pg_writer_write_u64_hex(w, fn.debug_info_offset_ref, allocator));
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" file="), allocator));
-  PG_ERR_RETURN(pg_writer_write_full(w, fn.file, allocator));
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" name="), allocator));
-  PG_ERR_RETURN(pg_writer_write_full(w, fn.name, allocator));
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" low_pc="), allocator));
-  PG_ERR_RETURN(pg_writer_write_u64_hex(w, fn.low_pc, allocator));
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" high_pc="), allocator));
-  PG_ERR_RETURN(pg_writer_write_u64_hex(w, fn.high_pc, allocator));
+#elif PG_OS_WINDOWS
+
+// -- Win32 ---
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <io.h>
+#include <windows.h>
+
+[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stdin() {
+  return (PgFileDescriptor){.ptr = GetStdHandle(STD_INPUT_HANDLE)};
+}
+[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stdout() {
+  return (PgFileDescriptor){.ptr = GetStdHandle(STD_OUTPUT_HANDLE)};
+}
+[[maybe_unused]] [[nodiscard]] static PgFileDescriptor pg_os_stderr() {
+  return (PgFileDescriptor){.ptr = GetStdHandle(STD_ERROR_HANDLE)};
+}
+
+typedef struct {
+  wchar_t *data;
+  u64 len;
+} PgWtf16String;
+
+PG_RESULT_DECL(PgWtf16String, PgError) PgWtf16StringResult;
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_writer_win32_write(PgWriter *w, PG_SLICE(u8) src) {
+  PG_ASSERT(nullptr != w);
+  if (PG_SLICE_IS_EMPTY(src)) {
+    return (PG_RESULT(u64, PgError)){0};
+  }
+
+  PgFileDescriptor file = w->ctx;
+  HANDLE handle = file.ptr;
+  DWORD n = 0;
+  bool has_value = WriteFile(handle, src.data, (DWORD)src.len, &n, nullptr);
+  PG_RESULT(u64, PgError) res = {0};
+  if (!has_value) {
+    res.err = (PgError)pg_os_get_last_error();
+  } else {
+    res.value = (u64)n;
+  }
+
+  return res;
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_writer_file_write(PgWriter *w, PG_SLICE(u8) src, PgAllocator *) {
+  return pg_writer_win32_write(w, src);
+}
+
+[[nodiscard]] static u64 pg_os_get_page_size() {
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  u64 res = (u64)info.dwPageSize;
+
+  PG_ASSERT(res > 0);
+  return res;
+}
+
+[[maybe_unused]] [[nodiscard]] static u64 pg_os_get_cpu_count() {
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  u64 res = (u64)info.dwNumberOfProcessors;
+
+  return res > 0 ? res : 1;
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64)
+    pg_time_ns_now(PgClockKind clock_kind, PgError) {
+  PG_RESULT(u64, PgError) res = {0};
+
+  switch (clock_kind) {
+  case PG_CLOCK_KIND_MONOTONIC: {
+    LARGE_INTEGER frequency = {0};
+    if (!frequency.QuadPart) {
+      QueryPerformanceFrequency(&frequency);
+      PG_ASSERT(frequency.QuadPart);
+    }
+    LARGE_INTEGER counter = {0};
+    PG_ASSERT(QueryPerformanceCounter(&counter));
+    f64 seconds = (f64)counter.QuadPart / (f64)frequency.QuadPart;
+
+    res.value = (u64)(PG_Seconds * seconds);
+    return res;
+  }
+  case PG_CLOCK_KIND_REALTIME: {
+    FILETIME ft = {0};
+    GetSystemTimeAsFileTime(&ft);
+    res.value = (((u64)ft.dwHighDateTime) << 32) | ((u64)ft.dwLowDateTime);
+    return res;
+  }
+  default:
+    PG_ASSERT(0);
+  }
+
+  return res;
+}
+
+[[nodiscard]] i32 pg_os_get_last_error() { return (i32)GetLastError(); }
+
+[[nodiscard]] i32 pg_virtual_mem_flags_to_os_flags(PgVirtualMemFlags flags) {
+  if (PG_VIRTUAL_MEM_FLAGS_NONE == flags) {
+    return PAGE_NOACCESS;
+  }
+
+  if (flags & PG_VIRTUAL_MEM_FLAGS_WRITE) {
+    return PAGE_READWRITE;
+  }
+
+  if (PG_VIRTUAL_MEM_FLAGS_READ == flags) {
+    return PAGE_READONLY;
+  }
+
+  PG_ASSERT(0 && "todo");
+}
+
+[[nodiscard]] PgVoidPtrResult pg_virtual_mem_alloc(u64 size,
+                                                   PgVirtualMemFlags flags) {
+  PG_ASSERT(size > 0);
+
+  PgVoidPtrResult res = {0};
+  // Note: We will reserve the guard pages right now.
+
+  res.value = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE,
+                           (DWORD)pg_virtual_mem_flags_to_os_flags(flags));
+  if (!res.value) {
+    res.err = (PgError)pg_os_get_last_error();
+  }
+  return res;
+}
 
+[[nodiscard]] PgError pg_virtual_mem_protect(void *ptr, u64 size,
+                                             PgVirtualMemFlags flags_new) {
+  DWORD flags_old = 0;
+  if (0 == VirtualProtect(ptr, size,
+                          (DWORD)pg_virtual_mem_flags_to_os_flags(flags_new),
+                          &flags_old)) {
+    return (PgError)pg_os_get_last_error();
+  }
   return 0;
 }
 
-[[maybe_unused]] [[nodiscard]]
-static PgError pg_debug_print_functions(PgWriter *w,
-                                        PG_DYN(PgDebugFunctionDeclaration) fns,
-                                        PgAllocator *allocator) {
-  for (u64 i = 0; i < fns.len; i++) {
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("["), allocator));
-    PG_ERR_RETURN(pg_writer_write_u64_as_string(w, i, allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("]"), allocator));
-    PG_ERR_RETURN(pg_debug_print_function(w, PG_SLICE_AT(fns, i), allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
+[[nodiscard]] PgError pg_virtual_mem_release(void *ptr, u64 size) {
+  (void)size;
+
+  if (0 == VirtualFree(ptr, 0, MEM_RELEASE)) {
+    return (PgError)pg_os_get_last_error();
   }
-  PG_ERR_RETURN(pg_writer_flush(w, allocator));
   return 0;
 }
 
-#ifdef PG_OS_UNIX
-static const PgString pg_dwarf_compilation_unit_kind_to_str[] = {
-    [PG_DWARF_COMPILATION_UNIT_NONE] = PG_S("PG_DWARF_COMPILATION_UNIT_NONE"),
-    [PG_DWARF_COMPILATION_UNIT_COMPILE] =
-        PG_S("PG_DWARF_COMPILATION_UNIT_COMPILE"),
-    [PG_DWARF_COMPILATION_UNIT_TYPE] = PG_S("PG_DWARF_COMPILATION_UNIT_TYPE"),
-    [PG_DWARF_COMPILATION_UNIT_PARTIAL] =
-        PG_S("PG_DWARF_COMPILATION_UNIT_PARTIAL"),
-    [PG_DWARF_COMPILATION_UNIT_SKELETON] =
-        PG_S("PG_DWARF_COMPILATION_UNIT_SKELETON"),
-    [PG_DWARF_COMPILATION_UNIT_SPLIT_COMPILE] =
-        PG_S("PG_DWARF_COMPILATION_UNIT_SPLIT_COMPILE"),
-    [PG_DWARF_COMPILATION_UNIT_SPLIT_TYPE] =
-        PG_S("PG_DWARF_COMPILATION_UNIT_SPLIT_TYPE"),
-    [PG_DWARF_COMPILATION_UNIT_LO_USER] =
-        PG_S("PG_DWARF_COMPILATION_UNIT_LO_USER"),
-    [PG_DWARF_COMPILATION_UNIT_HI_USER] =
-        PG_S("PG_DWARF_COMPILATION_UNIT_HI_USER"),
-};
+[[nodiscard]] static PgWtf16StringResult
+pg_string_to_wtf16(PgString s, PgAllocator *allocator) {
+  int wlen = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS,
+                                 (const char *)s.data, (i32)s.len, nullptr, 0);
+  PgWtf16StringResult res = {0};
 
-static const PgString pg_dwarf_tag_str[] = {
-    [PG_DWARF_TAG_NULL] = PG_S("PG_DWARF_TAG_NULL"),
-    [PG_DWARF_TAG_ARRAY_TYPE] = PG_S("PG_DWARF_TAG_ARRAY_TYPE"),
-    [PG_DWARF_TAG_CLASS_TYPE] = PG_S("PG_DWARF_TAG_CLASS_TYPE"),
-    [PG_DWARF_TAG_ENTRY_POINT] = PG_S("PG_DWARF_TAG_ENTRY_POINT"),
-    [PG_DWARF_TAG_ENUMERATION_TYPE] = PG_S("PG_DWARF_TAG_ENUMERATION_TYPE"),
-    [PG_DWARF_TAG_FORMAL_PARAMETER] = PG_S("PG_DWARF_TAG_FORMAL_PARAMETER"),
-    [PG_DWARF_TAG_IMPORTED_DECLARATION] =
-        PG_S("PG_DWARF_TAG_IMPORTED_DECLARATION"),
-    [PG_DWARF_TAG_LABEL] = PG_S("PG_DWARF_TAG_LABEL"),
-    [PG_DWARF_TAG_LEXICAL_BLOCK] = PG_S("PG_DWARF_TAG_LEXICAL_BLOCK"),
-    [PG_DWARF_TAG_MEMBER] = PG_S("PG_DWARF_TAG_MEMBER"),
-    [PG_DWARF_TAG_POINTER_TYPE] = PG_S("PG_DWARF_TAG_POINTER_TYPE"),
-    [PG_DWARF_TAG_REFERENCE_TYPE] = PG_S("PG_DWARF_TAG_REFERENCE_TYPE"),
-    [PG_DWARF_TAG_COMPILE_UNIT] = PG_S("PG_DWARF_TAG_COMPILE_UNIT"),
-    [PG_DWARF_TAG_STRING_TYPE] = PG_S("PG_DWARF_TAG_STRING_TYPE"),
-    [PG_DWARF_TAG_STRUCTURE_TYPE] = PG_S("PG_DWARF_TAG_STRUCTURE_TYPE"),
-    [PG_DWARF_TAG_SUBROUTINE_TYPE] = PG_S("PG_DWARF_TAG_SUBROUTINE_TYPE"),
-    [PG_DWARF_TAG_TYPEDEF] = PG_S("PG_DWARF_TAG_TYPEDEF"),
-    [PG_DWARF_TAG_UNION_TYPE] = PG_S("PG_DWARF_TAG_UNION_TYPE"),
-    [PG_DWARF_TAG_UNSPECIFIED_PARAMETERS] =
-        PG_S("PG_DWARF_TAG_UNSPECIFIED_PARAMETERS"),
-    [PG_DWARF_TAG_VARIANT] = PG_S("PG_DWARF_TAG_VARIANT"),
-    [PG_DWARF_TAG_COMMON_BLOCK] = PG_S("PG_DWARF_TAG_COMMON_BLOCK"),
-    [PG_DWARF_TAG_COMMON_INCLUSION] = PG_S("PG_DWARF_TAG_COMMON_INCLUSION"),
-    [PG_DWARF_TAG_INHERITANCE] = PG_S("PG_DWARF_TAG_INHERITANCE"),
-    [PG_DWARF_TAG_INLINED_SUBROUTINE] = PG_S("PG_DWARF_TAG_INLINED_SUBROUTINE"),
-    [PG_DWARF_TAG_MODULE] = PG_S("PG_DWARF_TAG_MODULE"),
-    [PG_DWARF_TAG_PTR_TO_MEMBER_TYPE] = PG_S("PG_DWARF_TAG_PTR_TO_MEMBER_TYPE"),
-    [PG_DWARF_TAG_SET_TYPE] = PG_S("PG_DWARF_TAG_SET_TYPE"),
-    [PG_DWARF_TAG_SUBRANGE_TYPE] = PG_S("PG_DWARF_TAG_SUBRANGE_TYPE"),
-    [PG_DWARF_TAG_WITH_STMT] = PG_S("PG_DWARF_TAG_WITH_STMT"),
-    [PG_DWARF_TAG_ACCESS_DECLARATION] = PG_S("PG_DWARF_TAG_ACCESS_DECLARATION"),
-    [PG_DWARF_TAG_BASE_TYPE] = PG_S("PG_DWARF_TAG_BASE_TYPE"),
-    [PG_DWARF_TAG_CATCH_BLOCK] = PG_S("PG_DWARF_TAG_CATCH_BLOCK"),
-    [PG_DWARF_TAG_CONST_TYPE] = PG_S("PG_DWARF_TAG_CONST_TYPE"),
-    [PG_DWARF_TAG_CONSTANT] = PG_S("PG_DWARF_TAG_CONSTANT"),
-    [PG_DWARF_TAG_ENUMERATOR] = PG_S("PG_DWARF_TAG_ENUMERATOR"),
-    [PG_DWARF_TAG_FILE_TYPE] = PG_S("PG_DWARF_TAG_FILE_TYPE"),
-    [PG_DWARF_TAG_FRIEND] = PG_S("PG_DWARF_TAG_FRIEND"),
-    [PG_DWARF_TAG_NAMELIST] = PG_S("PG_DWARF_TAG_NAMELIST"),
-    [PG_DWARF_TAG_NAMELIST_ITEM] = PG_S("PG_DWARF_TAG_NAMELIST_ITEM"),
-    [PG_DWARF_TAG_PACKED_TYPE] = PG_S("PG_DWARF_TAG_PACKED_TYPE"),
-    [PG_DWARF_TAG_SUBPROGRAM] = PG_S("PG_DWARF_TAG_SUBPROGRAM"),
-    [PG_DWARF_TAG_TEMPLATE_TYPE_PARAMETER] =
-        PG_S("PG_DWARF_TAG_TEMPLATE_TYPE_PARAMETER"),
-    [PG_DWARF_TAG_TEMPLATE_VALUE_PARAMETER] =
-        PG_S("PG_DWARF_TAG_TEMPLATE_VALUE_PARAMETER"),
-    [PG_DWARF_TAG_THROWN_TYPE] = PG_S("PG_DWARF_TAG_THROWN_TYPE"),
-    [PG_DWARF_TAG_TRY_BLOCK] = PG_S("PG_DWARF_TAG_TRY_BLOCK"),
-    [PG_DWARF_TAG_VARIANT_PART] = PG_S("PG_DWARF_TAG_VARIANT_PART"),
-    [PG_DWARF_TAG_VARIABLE] = PG_S("PG_DWARF_TAG_VARIABLE"),
-    [PG_DWARF_TAG_VOLATILE_TYPE] = PG_S("PG_DWARF_TAG_VOLATILE_TYPE"),
-    [PG_DWARF_TAG_DWARF_PROCEDURE] = PG_S("PG_DWARF_TAG_DWARF_PROCEDURE"),
-    [PG_DWARF_TAG_RESTRICT_TYPE] = PG_S("PG_DWARF_TAG_RESTRICT_TYPE"),
-    [PG_DWARF_TAG_INTERFACE_TYPE] = PG_S("PG_DWARF_TAG_INTERFACE_TYPE"),
-    [PG_DWARF_TAG_NAMESPACE] = PG_S("PG_DWARF_TAG_NAMESPACE"),
-    [PG_DWARF_TAG_IMPORTED_MODULE] = PG_S("PG_DWARF_TAG_IMPORTED_MODULE"),
-    [PG_DWARF_TAG_UNSPECIFIED_TYPE] = PG_S("PG_DWARF_TAG_UNSPECIFIED_TYPE"),
-    [PG_DWARF_TAG_PARTIAL_UNIT] = PG_S("PG_DWARF_TAG_PARTIAL_UNIT"),
-    [PG_DWARF_TAG_IMPORTED_UNIT] = PG_S("PG_DWARF_TAG_IMPORTED_UNIT"),
-    [PG_DWARF_TAG_CONDITION] = PG_S("PG_DWARF_TAG_CONDITION"),
-    [PG_DWARF_TAG_SHARED_TYPE] = PG_S("PG_DWARF_TAG_SHARED_TYPE"),
-    [PG_DWARF_TAG_TYPE_UNIT] = PG_S("PG_DWARF_TAG_TYPE_UNIT"),
+  if (0 == wlen) {
+    res.err = (PgError)pg_os_get_last_error();
+    return res;
+  }
+
+  res.value.len = (u64)wlen + 1;
+  res.value.data =
+      pg_alloc(allocator, sizeof(wchar_t), _Alignof(wchar_t), res.value.len);
+  PG_ASSERT(res.value.data);
+  PG_ASSERT(0 != MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS,
+                                     (const char *)s.data, (i32)s.len,
+                                     res.value.data, (i32)res.value.len));
+  PG_ASSERT(0 == res.value.data[res.value.len - 1]);
+
+  return res;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_truncate(PgFileDescriptor file, u64 size) {
+  LARGE_INTEGER li_offset;
+  li_offset.QuadPart = (LONGLONG)size;
+  if (!SetFilePointerEx(file.ptr, li_offset, nullptr, FILE_BEGIN)) {
+    return (PgError)pg_os_get_last_error();
+  }
+
+  if (!SetEndOfFile(file.ptr)) {
+    return (PgError)pg_os_get_last_error();
+  }
+
+  li_offset.QuadPart = 0;
+  if (!SetFilePointerEx(file.ptr, li_offset, nullptr, FILE_BEGIN)) {
+    return (PgError)pg_os_get_last_error();
+  }
+
+  return 0;
+}
+
+[[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_file_open(PgString path, PgFileAccess access, u64 mode,
+                 bool create_if_not_exists, PgAllocator *allocator) {
+  PG_RESULT(PgFileDescriptor, PgError) res = {0};
+
+  DWORD desired_access = 0;
+  DWORD creation_disposition =
+      create_if_not_exists ? CREATE_ALWAYS : OPEN_EXISTING;
+
+  switch (access) {
+  case PG_FILE_ACCESS_READ:
+    desired_access = GENERIC_READ;
+    break;
+  case PG_FILE_ACCESS_WRITE:
+    desired_access = GENERIC_WRITE;
+    break;
+  case PG_FILE_ACCESS_READ_WRITE:
+    desired_access = GENERIC_READ | GENERIC_WRITE;
+    break;
+  case PG_FILE_ACCESS_NONE:
+  default:
+    PG_ASSERT(0);
+  }
+
+  PgWtf16StringResult res_path_os = pg_string_to_wtf16(path, allocator);
+  if (res_path_os.err) {
+    res.err = res_path_os.err;
+    return res;
+  }
+
+  HANDLE handle =
+      CreateFileW(res_path_os.value.data, desired_access,
+                  FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                  creation_disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  pg_free(allocator, res_path_os.value.data);
+
+  if (INVALID_HANDLE_VALUE == handle) {
+    res.err = (PgError)pg_os_get_last_error();
+    return res;
+  }
+
+  res.value.ptr = handle;
+  return res;
+}
+
+[[nodiscard]] static PgError pg_file_close(PgFileDescriptor file) {
+  if (0 == CloseHandle(file.ptr)) {
+    return (PgError)pg_os_get_last_error();
+  }
+
+  return 0;
+}
+
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_file_size(PgFileDescriptor file) {
+  PG_RESULT(u64, PgError) res = {0};
+
+  LARGE_INTEGER size;
+  if (0 == GetFileSizeEx(file.ptr, &size)) {
+    res.err = (PgError)pg_os_get_last_error();
+    return res;
+  }
+
+  res.value = (u64)size.QuadPart;
+  return res;
+}
+
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_file_read(PgFileDescriptor file, PgString dst) {
+  PG_RESULT(u64, PgError) res = {0};
+
+  if (0 == ReadFile(file.ptr, dst.data, (DWORD)dst.len, (LPDWORD)&res.value,
+                    nullptr)) {
+    res.err = (PgError)pg_os_get_last_error();
+    return res;
+  }
+
+  return res;
+}
+
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_file_write(PgFileDescriptor file, PgString s) {
+  PG_RESULT(u64, PgError) res = {0};
+
+  if (0 ==
+      WriteFile(file.ptr, s.data, (DWORD)s.len, (LPDWORD)&res.value, nullptr)) {
+    res.err = (PgError)pg_os_get_last_error();
+    return res;
+  }
+
+  return res;
+}
+
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_file_read_at(PgFileDescriptor file, PgString dst, u64 offset) {
+  PG_RESULT(u64, PgError) res = {0};
+
+  LARGE_INTEGER li_offset;
+  li_offset.QuadPart = (LONGLONG)offset;
+  if (!SetFilePointerEx(file.ptr, li_offset, nullptr, FILE_BEGIN)) {
+    res.err = (PgError)pg_os_get_last_error();
+    return res;
+  }
+
+  if (!SetEndOfFile(file.ptr)) {
+    res.err = (PgError)pg_os_get_last_error();
+    return res;
+  }
+
+  res = pg_file_read(file, dst);
+
+  li_offset.QuadPart = 0;
+  if (!SetFilePointerEx(file.ptr, li_offset, nullptr, FILE_BEGIN)) {
+    res.err = (PgError)pg_os_get_last_error();
+    return res;
+  }
+
+  return res;
+}
+
+#elifdef PG_OS_WASM
+#endif
+
+[[maybe_unused]]
+PgString static pg_http_method_to_string(PgHttpMethod m) {
+  switch (m) {
+  case PG_HTTP_METHOD_UNKNOWN:
+    return PG_S("UNKNOWN");
+  case PG_HTTP_METHOD_OPTIONS:
+    return PG_S("OPTIONS");
+  case PG_HTTP_METHOD_GET:
+    return PG_S("GET");
+  case PG_HTTP_METHOD_HEAD:
+    return PG_S("HEAD");
+  case PG_HTTP_METHOD_POST:
+    return PG_S("POST");
+  case PG_HTTP_METHOD_PUT:
+    return PG_S("PUT");
+  case PG_HTTP_METHOD_DELETE:
+    return PG_S("DELETE");
+  case PG_HTTP_METHOD_TRACE:
+    return PG_S("TRACE");
+  case PG_HTTP_METHOD_CONNECT:
+    return PG_S("CONNECT");
+  case PG_HTTP_METHOD_EXTENSION:
+    return PG_S("EXTENSION");
+  default:
+    PG_ASSERT(0);
+  }
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHttpResponseStatusLine,
+                                                PgError)
+    pg_http_parse_response_status_line(PgString status_line) {
+  PgHttpResponseStatusLine res = {0};
+
+  PgString remaining = status_line;
+  {
+    PG_OPTION(PgString)
+    consume_opt = pg_string_consume_string(remaining, PG_S("HTTP/"));
+    if (!consume_opt.has_value) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    }
+    remaining = consume_opt.value;
+  }
+
+  {
+    PgParseNumberResult res_major = pg_string_parse_u64(remaining, 10, true);
+    if (!res_major.present) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    }
+    if (res_major.n > 3) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    }
+    res.version_major = (u8)res_major.n;
+    remaining = res_major.remaining;
+  }
+
+  {
+    PG_OPTION(PgString) consume_opt = pg_string_consume_rune(remaining, '.');
+    if (!consume_opt.has_value) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    }
+    remaining = consume_opt.value;
+  }
+
+  {
+    PgParseNumberResult res_minor = pg_string_parse_u64(remaining, 10, true);
+    if (!res_minor.present) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    }
+    if (res_minor.n > 9) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    }
+    res.version_minor = (u8)res_minor.n;
+    remaining = res_minor.remaining;
+  }
+
+  {
+    PG_OPTION(PgString) consume_opt = pg_string_consume_rune(remaining, ' ');
+    if (!consume_opt.has_value) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    }
+    remaining = consume_opt.value;
+  }
+
+  {
+    PgParseNumberResult res_status_code =
+        pg_string_parse_u64(remaining, 10, true);
+    if (!res_status_code.present) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    }
+    if (res_status_code.n < 100 || res_status_code.n > 599) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpResponseStatusLine, PgError);
+    }
+    res.status = (u16)res_status_code.n;
+    remaining = res_status_code.remaining;
+  }
+
+  // TODO: Should we keep the human-readable status code around or validate
+  // it?
+
+  return PG_OK(res, PgHttpResponseStatusLine, PgError);
+}
+
+// Id of a well-known header name, matched case-insensitively, or
+// `PG_HTTP_HEADER_ID_NONE`.
+[[maybe_unused]] [[nodiscard]] static PgHttpHeaderId
+pg_http_header_id(PgString name) {
+  // Setting the ASCII case bit lowercases letters, see `gen_http_headers.py`.
+  u32 h = 2166136261U ^ PG_HTTP_HEADER_SEED;
+  PG_EACH_PTR(c, &name) {
+    h ^= *c | 0x20;
+    h *= 16777619U;
+  }
+
+  PgHttpHeaderId id =
+      (PgHttpHeaderId)pg_http_header_slots[h % PG_HTTP_HEADER_SLOTS_LEN];
+  if (PG_HTTP_HEADER_ID_NONE == id ||
+      !pg_string_ieq_ascii(pg_http_header_names[id], name)) {
+    return PG_HTTP_HEADER_ID_NONE;
+  }
+  return id;
+}
+
+// Canonical spelling of a well-known header name.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_http_header_name(PgHttpHeaderId id) {
+  PG_ASSERT(PG_HTTP_HEADER_ID_NONE < id && id < PG_HTTP_HEADER_ID_COUNT);
+  return pg_http_header_names[id];
+}
+
+[[maybe_unused]]
+static void pg_http_push_header(PgHttpHeaders *headers, PgString key,
+                                PgString value, PgAllocator *allocator) {
+  PgHttpHeader header = {
+      .key = key,
+      .value = value,
+      .id = pg_http_header_id(key),
+  };
+  PG_DYN_PUSH(&headers->entries, header, allocator);
+
+  if (header.id && 0 == headers->known[header.id]) {
+    PG_ASSERT(headers->entries.len <= UINT16_MAX);
+    headers->known[header.id] = (u16)headers->entries.len;
+  }
+}
+
+// Value of the first occurrence of a well-known header.
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(PgString)
+    pg_http_headers_get_by_id(PgHttpHeaders const *headers, PgHttpHeaderId id) {
+  PG_ASSERT(PG_HTTP_HEADER_ID_NONE < id && id < PG_HTTP_HEADER_ID_COUNT);
+
+  u16 idx = headers->known[id];
+  if (0 == idx) {
+    return (PG_OPTION(PgString)){0};
+  }
+  return (PG_OPTION(PgString)){
+      .value = PG_SLICE_AT(headers->entries, idx - 1).value,
+      .has_value = true,
+  };
+}
+
+// Value of the first occurrence of a header, matched case-insensitively.
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(PgString)
+    pg_http_headers_get(PgHttpHeaders const *headers, PgString key) {
+  PgHttpHeaderId id = pg_http_header_id(key);
+  if (id) {
+    return pg_http_headers_get_by_id(headers, id);
+  }
+
+  for (u64 i = 0; i < headers->entries.len; i++) {
+    PgHttpHeader h = PG_SLICE_AT(headers->entries, i);
+    if (PG_HTTP_HEADER_ID_NONE == h.id && pg_string_ieq_ascii(h.key, key)) {
+      return (PG_OPTION(PgString)){.value = h.value, .has_value = true};
+    }
+  }
+  return (PG_OPTION(PgString)){0};
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_writer_url_encode(PgWriter *w, PgString key, PgString value,
+                     PgAllocator *allocator) {
+  PgError err = 0;
+
+  PG_EACH_PTR(c, &key) {
+    if (pg_rune_ascii_is_alphanumeric(*c)) {
+      err = pg_writer_write_u8(w, *c, allocator);
+      if (err) {
+        return err;
+      }
+    } else {
+      err = pg_writer_write_u8(w, '%', allocator);
+      if (err) {
+        return err;
+      }
+
+      err = pg_writer_write_u8_hex_upper(w, *c, allocator);
+      if (err) {
+        return err;
+      }
+    }
+  }
+
+  err = pg_writer_write_u8(w, '=', allocator);
+  if (err) {
+    return err;
+  }
+
+  PG_EACH_PTR(c, &value) {
+    if (pg_rune_ascii_is_alphanumeric(*c)) {
+      err = pg_writer_write_u8(w, *c, allocator);
+      if (err) {
+        return err;
+      }
+    } else {
+      err = pg_writer_write_u8(w, '%', allocator);
+      if (err) {
+        return err;
+      }
+      err = pg_writer_write_u8_hex_upper(w, *c, allocator);
+      if (err) {
+        return err;
+      }
+    }
+  }
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_request_write_status_line(PgWriter *w, PgHttpRequest req,
+                                  PgAllocator *allocator) {
+  PgError err = 0;
+
+  err =
+      pg_writer_write_full(w, pg_http_method_to_string(req.method), allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_write_full(w, PG_S(" /"), allocator);
+  if (err) {
+    return err;
+  }
+
+  PG_EACH_PTR(path_component, &req.url.path_components) {
+    err = pg_writer_write_full(w, *path_component, allocator);
+    if (err) {
+      return err;
+    }
+
+    if (path_component != PG_SLICE_LAST_PTR(&req.url.path_components)) {
+      err = pg_writer_write_full(w, PG_S("/"), allocator);
+      if (err) {
+        return err;
+      }
+    }
+  }
+
+  if (req.url.query_parameters.len > 0) {
+    err = pg_writer_write_full(w, PG_S("?"), allocator);
+    if (err) {
+      return err;
+    }
+
+    PG_EACH_PTR(param, &req.url.query_parameters) {
+      err = pg_writer_url_encode(w, param->key, param->value, allocator);
+      if (err) {
+        return err;
+      }
+
+      if (param != PG_SLICE_LAST_PTR(&req.url.query_parameters)) {
+        err = pg_writer_write_full(w, PG_S("&"), allocator);
+        if (err) {
+          return err;
+        }
+      }
+    }
+  }
+
+  err = pg_writer_write_full(w, PG_S(" HTTP/1.1\r\n"), allocator);
+  if (err) {
+    return err;
+  }
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_response_write_status_line(PgWriter *w, PgHttpResponse res,
+                                   PgAllocator *allocator) {
+  PgError err = 0;
+
+  err = pg_writer_write_full(w, PG_S("HTTP/"), allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_write_u64_as_string(w, res.version_major, allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_write_u8(w, '.', allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_write_u64_as_string(w, res.version_minor, allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_write_u8(w, ' ', allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_write_u64_as_string(w, res.status, allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_write_full(w, PG_S("\r\n"), allocator);
+  if (err) {
+    return err;
+  }
+
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_write_header(PgWriter *w, PgHttpHeader header,
+                     PgAllocator *allocator) {
+  PgError err = 0;
+
+  if (header.id) {
+    // The canonical name is followed by `: ` in the generated table.
+    PgString prefix = pg_http_header_name(header.id);
+    prefix.len += 2;
+    err = pg_writer_write_full(w, prefix, allocator);
+    if (err) {
+      return err;
+    }
+  } else {
+    err = pg_writer_write_full(w, header.key, allocator);
+    if (err) {
+      return err;
+    }
+
+    err = pg_writer_write_full(w, PG_S(": "), allocator);
+    if (err) {
+      return err;
+    }
+  }
+
+  err = pg_writer_write_full(w, header.value, allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_write_full(w, PG_S("\r\n"), allocator);
+  if (err) {
+    return err;
+  }
+
+  return 0;
+}
+
+// NOTE: Only sanitation for including the string inside an HTML tag e.g.:
+// `<div>...ESCAPED_STRING..</div>`.
+// To include the string inside other context (e.g. JS, CSS, HTML
+// attributes, etc), more advanced sanitation is required.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_html_sanitize(PgString s, PgAllocator *allocator) {
+  PG_DYN(u8) res = {0};
+  pg_string_builder_append_escaped(&res, s, PG_ESCAPE_KIND_HTML, allocator);
+
+  return PG_DYN_TO_SLICE(PgString, res);
+}
+
+[[maybe_unused]] [[nodiscard]]
+static PgString pg_html_make_slug(PgString s, PgAllocator *allocator) {
+  PG_DYN(u8) sb = {0};
+  PG_DYN_ENSURE_CAP(&sb, s.len * 2, allocator);
+
+  PgUtf8Iterator it = pg_make_utf8_iterator(s);
+
+  for (;;) {
+    PgRuneUtf8Result res = pg_utf8_iterator_next(&it);
+    // TODO: Use REPLACEMENT CHARACTER?
+    if (res.err) {
+      return (PgString){0};
+    }
+
+    if (res.end) {
+      break;
+    }
+
+    PgRune rune = res.rune;
+
+    if (pg_rune_ascii_is_alphanumeric(rune)) {
+      PG_DYN_PUSH(&sb, pg_rune_ascii_to_lower_case(rune), allocator);
+    } else if ('+' == rune) {
+      PG_DYN_APPEND_SLICE(&sb, PG_S("plus"), allocator);
+    } else if ('#' == rune) {
+      PG_DYN_APPEND_SLICE(&sb, PG_S("sharp"), allocator);
+    } else if (PG_SLICE_LAST(sb) != '-') {
+      // Other runes are mapped to `-`, but we avoid consecutive `-`.
+      PG_DYN_PUSH(&sb, '-', allocator);
+    }
+  }
+  PgString res = PG_DYN_TO_SLICE(PgString, sb);
+
+  return pg_string_trim(res, '-');
+}
+
+[[maybe_unused]] [[nodiscard]] static PgUrlPathIterator
+pg_url_path_iterator_make(PgString path) {
+  return (PgUrlPathIterator){.remaining = path};
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(PgString)
+    pg_url_path_iterator_next(PgUrlPathIterator *it) {
+  while (!PG_SLICE_IS_EMPTY(it->remaining)) {
+    PG_OPTION(u64) slash = pg_bytes_index_of_byte(it->remaining, '/');
+    u64 end = slash.has_value ? slash.value : it->remaining.len;
+
+    PgString component = PG_SLICE_RANGE(it->remaining, 0, end);
+    it->remaining = slash.has_value
+                        ? PG_SLICE_RANGE_START(it->remaining, end + 1)
+                        : (PgString){0};
+
+    if (!PG_SLICE_IS_EMPTY(component)) {
+      return (PG_OPTION(PgString)){.value = component, .has_value = true};
+    }
+  }
+
+  return (PG_OPTION(PgString)){0};
+}
+
+[[maybe_unused]] [[nodiscard]] static PgUrlQueryIterator
+pg_url_query_iterator_make(PgString query) {
+  return (PgUrlQueryIterator){.remaining = query};
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(PgStringKeyValue)
+    pg_url_query_iterator_next(PgUrlQueryIterator *it) {
+  while (!PG_SLICE_IS_EMPTY(it->remaining)) {
+    PG_OPTION(u64) amp = pg_bytes_index_of_byte(it->remaining, '&');
+    u64 end = amp.has_value ? amp.value : it->remaining.len;
+
+    PgString kv = PG_SLICE_RANGE(it->remaining, 0, end);
+    it->remaining = amp.has_value ? PG_SLICE_RANGE_START(it->remaining, end + 1)
+                                  : (PgString){0};
+
+    PgStringKeyValue res = {.key = kv};
+    PG_OPTION(u64) eq = pg_bytes_index_of_byte(kv, '=');
+    if (eq.has_value) {
+      res.key = PG_SLICE_RANGE(kv, 0, eq.value);
+      res.value = PG_SLICE_RANGE_START(kv, eq.value + 1);
+    }
+
+    if (!PG_SLICE_IS_EMPTY(res.key)) {
+      return (PG_OPTION(PgStringKeyValue)){.value = res, .has_value = true};
+    }
+  }
+
+  return (PG_OPTION(PgStringKeyValue)){0};
+}
+
+// Index of the first `%` (and `+` if `plus_as_space`) at or after `start`, or
+// `s.len` if there is none.
+[[maybe_unused]] [[nodiscard]] static u64
+pg_url_percent_scan(PgString s, u64 start, bool plus_as_space) {
+  u64 i = start;
+  if (!plus_as_space) {
+    PG_OPTION(u64) idx =
+        pg_bytes_index_of_byte(PG_SLICE_RANGE_START(s, i), '%');
+    return idx.has_value ? i + idx.value : s.len;
+  }
+
+#if defined(__x86_64__) && defined(__AVX2__)
+  for (; i + 32 <= s.len; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(void *)(s.data + i));
+    __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('%')),
+                                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('+')));
+    u32 mask = (u32)_mm256_movemask_epi8(m);
+    if (mask) {
+      return i + (u64)__builtin_ctz(mask);
+    }
+  }
+#endif
+
+#if defined(__x86_64__) && defined(__SSE2__)
+  for (; i + 16 <= s.len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(void *)(s.data + i));
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('%')),
+                             _mm_cmpeq_epi8(v, _mm_set1_epi8('+')));
+    u32 mask = (u32)_mm_movemask_epi8(m);
+    if (mask) {
+      return i + (u64)__builtin_ctz(mask);
+    }
+  }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  for (; i + 16 <= s.len; i += 16) {
+    uint8x16_t v = vld1q_u8(s.data + i);
+    uint8x16_t m =
+        vorrq_u8(vceqq_u8(v, vdupq_n_u8('%')), vceqq_u8(v, vdupq_n_u8('+')));
+    // 4 bits per input byte.
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(m), 4);
+    u64 mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+    if (mask) {
+      return i + (u64)__builtin_ctzll(mask) / 4;
+    }
+  }
+#endif
+
+  for (; i < s.len; i++) {
+    u8 c = PG_SLICE_AT(s, i);
+    if ('%' == c || '+' == c) {
+      return i;
+    }
+  }
+
+  return s.len;
+}
+
+// Percent-decode `src` into `dst`, which may be `src.data` since decoding
+// never grows the input. Malformed escapes e.g. `%zz` are kept as is.
+// Returns the decoded length.
+[[nodiscard]] static u64 pg_url_percent_decode_to(PgString src, u8 *dst,
+                                                  bool plus_as_space) {
+  u64 r = 0;
+  u64 w = 0;
+
+  while (r < src.len) {
+    u64 end = pg_url_percent_scan(src, r, plus_as_space);
+    pg_memmove(dst + w, src.data + r, end - r);
+    w += end - r;
+    r = end;
+    if (r == src.len) {
+      break;
+    }
+
+    u8 c = PG_SLICE_AT(src, r);
+    if ('+' == c) {
+      dst[w++] = ' ';
+      r += 1;
+      continue;
+    }
+
+    u8 hi = r + 3 <= src.len ? pg_hex_digit_values[PG_SLICE_AT(src, r + 1)] : 0;
+    u8 lo = r + 3 <= src.len ? pg_hex_digit_values[PG_SLICE_AT(src, r + 2)] : 0;
+    if (hi && lo) {
+      dst[w++] = (u8)(((hi - 1) << 4) | (lo - 1));
+      r += 3;
+    } else {
+      dst[w++] = '%';
+      r += 1;
+    }
+  }
+
+  return w;
+}
+
+// Percent-decode e.g. a path component or a query parameter, with `+` meaning
+// a space in `application/x-www-form-urlencoded` query strings. Input without
+// anything to decode is returned as is, otherwise it is decoded into a new
+// string.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_url_percent_decode(PgString s, bool plus_as_space, PgAllocator *allocator) {
+  if (pg_url_percent_scan(s, 0, plus_as_space) == s.len) {
+    return s;
+  }
+
+  PgString res = pg_string_make(s.len, allocator);
+  res.len = pg_url_percent_decode_to(s, res.data, plus_as_space);
+  return res;
+}
+
+// Same as `pg_url_percent_decode` but decode in place, which never allocates.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_url_percent_decode_in_place(PG_SLICE(u8) s, bool plus_as_space) {
+  u64 start = pg_url_percent_scan(s, 0, plus_as_space);
+  if (start == s.len) {
+    return s;
+  }
+
+  PgString rest = PG_SLICE_RANGE_START(s, start);
+  u64 len = pg_url_percent_decode_to(rest, rest.data, plus_as_space);
+  return (PgString){.data = s.data, .len = start + len};
+}
+
+[[nodiscard]] static bool pg_url_path_is_valid(PgString s) {
+  if (-1 != pg_string_index_of_any_rune(s, PG_S("?#:"))) {
+    return false;
+  }
+
+  return PG_SLICE_IS_EMPTY(s) || pg_string_starts_with(s, PG_S("/"));
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_DYN(PgString), PgError)
+    pg_url_parse_path_components(PgString s, PgAllocator *allocator) {
+  if (!pg_url_path_is_valid(s)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PgString), PgError);
+  }
+
+  if (PG_SLICE_IS_EMPTY(s)) {
+    return PG_OK({}, PG_DYN(PgString), PgError);
+  }
+
+  // Count first to allocate once.
+  u64 count = 0;
+  PgUrlPathIterator it = pg_url_path_iterator_make(s);
+  while (pg_url_path_iterator_next(&it).has_value) {
+    count += 1;
+  }
+
+  PG_DYN(PgString) res = {0};
+  PG_DYN_ENSURE_CAP(&res, count, allocator);
+
+  it = pg_url_path_iterator_make(s);
+  for (;;) {
+    PG_OPTION(PgString) component = pg_url_path_iterator_next(&it);
+    if (!component.has_value) {
+      break;
+    }
+    PG_DYN_PUSH(&res, component.value, allocator);
+  }
+
+  return PG_OK(res, PG_DYN(PgString), PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_url_to_string(PgUrl u, PgAllocator *allocator) {
+  PG_DYN(u8) sb = pg_string_builder_make(256, allocator);
+  PG_DYN_APPEND_SLICE(&sb, u.scheme, allocator);
+  if (u.scheme.len) {
+    PG_DYN_APPEND_SLICE(&sb, PG_S("://"), allocator);
+  }
+
+  if (u.username.len) {
+    PG_DYN_APPEND_SLICE(&sb, u.username, allocator);
+  }
+  if (u.username.len || u.password.len) {
+    PG_DYN_APPEND_SLICE(&sb, PG_S(":"), allocator);
+  }
+
+  if (u.password.len) {
+    PG_DYN_APPEND_SLICE(&sb, u.password, allocator);
+  }
+  if (u.username.len || u.password.len) {
+    PG_DYN_APPEND_SLICE(&sb, PG_S("@"), allocator);
+  }
+
+  if (u.host.len) {
+    PG_DYN_APPEND_SLICE(&sb, u.host, allocator);
+  }
+
+  if (u.port) {
+    PG_DYN_APPEND_SLICE(&sb, PG_S(":"), allocator);
+    pg_string_builder_append_u64(&sb, u.port, allocator);
+  }
+
+  PG_EACH_PTR(it, &u.path_components) {
+    PG_DYN_APPEND_SLICE(&sb, PG_S("/"), allocator);
+    PG_DYN_APPEND_SLICE(&sb, *it, allocator);
+  }
+
+  if (u.query_parameters.len) {
+    PG_DYN_APPEND_SLICE(&sb, PG_S("?"), allocator);
+
+    PG_EACH_PTR(it, &u.query_parameters) {
+      if (it->key.len) {
+        PG_DYN_APPEND_SLICE(&sb, it->key, allocator);
+      }
+      if (it->key.len && it->value.len) {
+        PG_DYN_APPEND_SLICE(&sb, PG_S("="), allocator);
+      }
+      if (it->value.len) {
+        PG_DYN_APPEND_SLICE(&sb, it->value, allocator);
+      }
+
+      PG_DYN_APPEND_SLICE(&sb, PG_S("&"), allocator);
+    }
+  }
+
+  if (u.fragment.len) {
+    PG_DYN_APPEND_SLICE(&sb, PG_S("#"), allocator);
+    PG_DYN_APPEND_SLICE(&sb, u.fragment, allocator);
+  }
+
+  return PG_DYN_TO_SLICE(PgString, sb);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_DYN(PgStringKeyValue),
+                                                PgError)
+    pg_url_parse_query_parameters(PgString s, PgAllocator *allocator) {
+  PG_DYN(PgStringKeyValue) res = {0};
+
+  PgString remaining = s;
+  {
+    PG_OPTION(PgString) consume_question_opt = pg_string_consume_rune(s, '?');
+    if (!consume_question_opt.has_value) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PgStringKeyValue), PgError);
+    }
+    remaining = consume_question_opt.value;
+  }
+
+  // Count first to allocate once.
+  u64 count = 0;
+  PgUrlQueryIterator it = pg_url_query_iterator_make(remaining);
+  while (pg_url_query_iterator_next(&it).has_value) {
+    count += 1;
+  }
+  PG_DYN_ENSURE_CAP(&res, count, allocator);
+
+  it = pg_url_query_iterator_make(remaining);
+  for (;;) {
+    PG_OPTION(PgStringKeyValue) kv = pg_url_query_iterator_next(&it);
+    if (!kv.has_value) {
+      break;
+    }
+    PG_DYN_PUSH(&res, kv.value, allocator);
+  }
+
+  return PG_OK(res, PG_DYN(PgStringKeyValue), PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrlUserInfo, PgError)
+    pg_url_parse_user_info(PgString s) {
+  PG_RESULT(PgUrlUserInfo, PgError) res = {0};
+  // https://www.rfc-editor.org/rfc/rfc3986#section-3.2.1:
+  // Use of the format "user:password" in the userinfo field is
+  // deprecated.  Applications should not render as clear text any data
+  // after the first colon (":") character found within a userinfo
+  // subcomponent unless the data after the colon is the empty string
+  // (indicating no password).  Applications may choose to ignore or
+  // reject such data when it is received.
+
+  if (PG_SLICE_IS_EMPTY(s)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlUserInfo, PgError);
+  }
+
+  return res;
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u16, PgError)
+    pg_url_parse_port(PgString s) {
+  // Allowed.
+  if (PG_SLICE_IS_EMPTY(s)) {
+    return PG_OK(0, u16, PgError);
+  }
+
+  PgParseNumberResult port_parse = pg_string_parse_u64(s, 10, true);
+  if (!PG_SLICE_IS_EMPTY(port_parse.remaining)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, u16, PgError);
+  }
+  if (port_parse.n > UINT16_MAX) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, u16, PgError);
+  }
+
+  return PG_OK((u16)port_parse.n, u16, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrlAuthority, PgError)
+    pg_url_parse_authority(PgString s) {
+  PgUrlAuthority res = {0};
+
+  PgString remaining = s;
+  // User info, optional.
+  {
+    PgStringPairConsume user_info_and_rem =
+        pg_string_consume_until_rune_incl(remaining, '@');
+    remaining = user_info_and_rem.right;
+
+    if (user_info_and_rem.consumed) {
+      PG_RESULT(PgUrlUserInfo, PgError)
+      res_user_info = pg_url_parse_user_info(user_info_and_rem.left);
+      PG_IF_LET_ERR(err, res_user_info) {
+        return PG_ERR(err, PgUrlAuthority, PgError);
+      }
+      res.user_info = PG_UNWRAP(res_user_info);
+    }
+  }
+
+  // Host, mandatory.
+  PgStringPairConsume host_and_rem =
+      pg_string_consume_until_rune_incl(remaining, ':');
+  {
+    remaining = host_and_rem.right;
+    res.host = host_and_rem.left;
+    if (PG_SLICE_IS_EMPTY(res.host)) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlAuthority, PgError);
+    }
+  }
+
+  // Port, optional.
+  if (host_and_rem.consumed) {
+    PG_RESULT(u16, PgError) res_port = pg_url_parse_port(host_and_rem.right);
+    PG_IF_LET_ERR(err, res_port) {
+      return PG_ERR(err, PgUrlAuthority, PgError);
+    }
+    res.port = PG_UNWRAP(res_port);
+  }
+
+  return PG_OK(res, PgUrlAuthority, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static bool
+pg_url_is_scheme_valid(PgString scheme) {
+  if (PG_SLICE_IS_EMPTY(scheme)) {
+    return false;
+  }
+
+  u8 first = PG_SLICE_AT(scheme, 0);
+  if (!pg_rune_ascii_is_alphabetical(first)) {
+    return false;
+  }
+
+  PG_EACH_PTR(c, &scheme) {
+    if (!(pg_rune_ascii_is_alphanumeric(*c) || *c == '+' || *c == '-' ||
+          *c == '.')) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Split what follows the authority, or an HTTP origin-form request target,
+// into the path, query and fragment.
+[[maybe_unused]] [[nodiscard]] static PgUrlView
+pg_url_view_parse_after_authority(PgString s) {
+  PgUrlView res = {0};
+
+  u64 i = 0;
+  for (; i < s.len; i++) {
+    u8 c = PG_SLICE_AT(s, i);
+    if ('?' == c || '#' == c) {
+      break;
+    }
+  }
+  res.path = PG_SLICE_RANGE(s, 0, i);
+  if (i == s.len) {
+    return res;
+  }
+
+  PgString remaining = PG_SLICE_RANGE_START(s, i + 1);
+  if ('#' == PG_SLICE_AT(s, i)) {
+    res.fragment = remaining;
+    return res;
+  }
+
+  PG_OPTION(u64) hash = pg_bytes_index_of_byte(remaining, '#');
+  if (hash.has_value) {
+    res.query = PG_SLICE_RANGE(remaining, 0, hash.value);
+    res.fragment = PG_SLICE_RANGE_START(remaining, hash.value + 1);
+  } else {
+    res.query = remaining;
+  }
+
+  return res;
+}
+
+// Parse an absolute URL of the form
+// `scheme://[user_info@]host[:port][/path][?query][#fragment]` in one pass,
+// without allocating.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrlView, PgError)
+    pg_url_view_parse(PgString s) {
+  PgUrlView res = {0};
+
+  // Scheme, mandatory.
+  PG_OPTION(u64) colon = pg_bytes_index_of_byte(s, ':');
+  if (!colon.has_value) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlView, PgError);
+  }
+  res.scheme = PG_SLICE_RANGE(s, 0, colon.value);
+  if (!pg_url_is_scheme_valid(res.scheme)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlView, PgError);
+  }
+
+  // Assume `://` as separator between the scheme and authority.
+  PgString remaining = PG_SLICE_RANGE_START(s, colon.value + 1);
+  if (!pg_string_starts_with(remaining, PG_S("//"))) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlView, PgError);
+  }
+  remaining = PG_SLICE_RANGE_START(remaining, 2);
+
+  // Authority, mandatory.
+  u64 authority_end = 0;
+  for (; authority_end < remaining.len; authority_end++) {
+    u8 c = PG_SLICE_AT(remaining, authority_end);
+    if ('/' == c || '?' == c || '#' == c) {
+      break;
+    }
+  }
+  PgString authority = PG_SLICE_RANGE(remaining, 0, authority_end);
+  if (PG_SLICE_IS_EMPTY(authority)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlView, PgError);
+  }
+
+  // User info, optional.
+  PG_OPTION(u64) at = pg_bytes_index_of_byte(authority, '@');
+  if (at.has_value) {
+    res.user_info = PG_SLICE_RANGE(authority, 0, at.value);
+    if (PG_SLICE_IS_EMPTY(res.user_info)) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlView, PgError);
+    }
+    authority = PG_SLICE_RANGE_START(authority, at.value + 1);
+  }
+
+  // Host, mandatory. An IPv6 literal is enclosed in brackets since it
+  // contains colons.
+  PgString port = {0};
+  bool has_port = false;
+  if (pg_string_starts_with(authority, PG_S("["))) {
+    PG_OPTION(u64) bracket = pg_bytes_index_of_byte(authority, ']');
+    if (!bracket.has_value) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlView, PgError);
+    }
+    res.host = PG_SLICE_RANGE(authority, 1, bracket.value);
+
+    PgString after = PG_SLICE_RANGE_START(authority, bracket.value + 1);
+    if (!PG_SLICE_IS_EMPTY(after)) {
+      if (':' != PG_SLICE_AT(after, 0)) {
+        return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlView, PgError);
+      }
+      port = PG_SLICE_RANGE_START(after, 1);
+      has_port = true;
+    }
+  } else {
+    PG_OPTION(u64) port_colon = pg_bytes_index_of_byte(authority, ':');
+    res.host = port_colon.has_value
+                   ? PG_SLICE_RANGE(authority, 0, port_colon.value)
+                   : authority;
+    if (port_colon.has_value) {
+      port = PG_SLICE_RANGE_START(authority, port_colon.value + 1);
+      has_port = true;
+    }
+  }
+  if (PG_SLICE_IS_EMPTY(res.host)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgUrlView, PgError);
+  }
+
+  // Port, optional.
+  if (has_port) {
+    PG_RESULT(u16, PgError) res_port = pg_url_parse_port(port);
+    PG_IF_LET_ERR(err, res_port) { return PG_ERR(err, PgUrlView, PgError); }
+    res.port = PG_UNWRAP(res_port);
+  }
+
+  PgUrlView after_authority = pg_url_view_parse_after_authority(
+      PG_SLICE_RANGE_START(remaining, authority_end));
+  res.path = after_authority.path;
+  res.query = after_authority.query;
+  res.fragment = after_authority.fragment;
+
+  return PG_OK(res, PgUrlView, PgError);
+}
+
+// Materialize the path components and query parameters of `view`, each array
+// being allocated once.
+[[nodiscard]] static PgError pg_url_from_view_path_and_query(
+    PgUrlView view, PgUrl *url, PgAllocator *allocator) {
+  // Path, optional.
+  if (pg_string_starts_with(view.path, PG_S("/"))) {
+    PG_RESULT(PG_DYN(PgString), PgError)
+    res_path_components = pg_url_parse_path_components(view.path, allocator);
+    PG_IF_LET_ERR(err, res_path_components) { return err; }
+    url->path_components = PG_UNWRAP(res_path_components);
+  }
+
+  // Query parameters, optional.
+  u64 count = 0;
+  PgUrlQueryIterator it = pg_url_query_iterator_make(view.query);
+  while (pg_url_query_iterator_next(&it).has_value) {
+    count += 1;
+  }
+  PG_DYN_ENSURE_CAP(&url->query_parameters, count, allocator);
+
+  it = pg_url_query_iterator_make(view.query);
+  for (;;) {
+    PG_OPTION(PgStringKeyValue) kv = pg_url_query_iterator_next(&it);
+    if (!kv.has_value) {
+      break;
+    }
+    PG_DYN_PUSH(&url->query_parameters, kv.value, allocator);
+  }
+
+  url->fragment = view.fragment;
+
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrl, PgError)
+    pg_url_parse_after_authority(PgString s, PgAllocator *allocator) {
+  PgUrl res = {0};
+
+  PgUrlView view = pg_url_view_parse_after_authority(s);
+  PgError err = pg_url_from_view_path_and_query(view, &res, allocator);
+  if (err) {
+    return PG_ERR(err, PgUrl, PgError);
+  }
+
+  PG_ASSERT(PG_SLICE_IS_EMPTY(res.scheme));
+  PG_ASSERT(PG_SLICE_IS_EMPTY(res.username));
+  PG_ASSERT(PG_SLICE_IS_EMPTY(res.password));
+  PG_ASSERT(PG_SLICE_IS_EMPTY(res.host));
+  PG_ASSERT(0 == res.port);
+
+  return PG_OK(res, PgUrl, PgError);
+}
+
+// The path components and query parameters of a received request, for the
+// handlers that want them as arrays. The others can iterate over
+// `req.target` without allocating.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrl, PgError)
+    pg_http_request_url(PgHttpServerRequest req, PgAllocator *allocator) {
+  PgUrl res = {0};
+
+  PgError err = pg_url_from_view_path_and_query(req.target, &res, allocator);
+  if (err) {
+    return PG_ERR(err, PgUrl, PgError);
+  }
+
+  return PG_OK(res, PgUrl, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgUrl, PgError)
+    pg_url_parse(PgString s, PgAllocator *allocator) {
+  PgUrl res = {0};
+
+  PgUrlView view = PG_TRY(pg_url_view_parse(s), PgUrl, PgError);
+  res.scheme = view.scheme;
+  res.host = view.host;
+  res.port = view.port;
+
+  if (!PG_SLICE_IS_EMPTY(view.user_info)) {
+    PG_RESULT(PgUrlUserInfo, PgError)
+    res_user_info = pg_url_parse_user_info(view.user_info);
+    PG_IF_LET_ERR(err, res_user_info) { return PG_ERR(err, PgUrl, PgError); }
+    PgUrlUserInfo user_info = PG_UNWRAP(res_user_info);
+    res.username = user_info.username;
+    res.password = user_info.password;
+  }
+
+  PgError err = pg_url_from_view_path_and_query(view, &res, allocator);
+  if (err) {
+    return PG_ERR(err, PgUrl, PgError);
+  }
+
+  return PG_OK(res, PgUrl, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static bool pg_http_url_is_valid(PgUrl u) {
+  // TODO: Support https.
+  if (!pg_string_eq(u.scheme, PG_S("http"))) {
+    return false;
+  }
+
+  return true;
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHttpRequestStatusLine,
+                                                PgError)
+    pg_http_parse_request_status_line(PgString status_line) {
+  PgHttpRequestStatusLine res = {0};
+
+  PgStringCut cut = pg_string_cut_rune(status_line, ' ');
+  if (!cut.has_value) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+  }
+
+  // Method.
+  {
+    PgString method = pg_string_trim_space(cut.left);
+    if (pg_string_eq(method, PG_S("OPTIONS"))) {
+      res.method = PG_HTTP_METHOD_OPTIONS;
+    } else if (pg_string_eq(method, PG_S("GET"))) {
+      res.method = PG_HTTP_METHOD_GET;
+    } else if (pg_string_eq(method, PG_S("HEAD"))) {
+      res.method = PG_HTTP_METHOD_HEAD;
+    } else if (pg_string_eq(method, PG_S("POST"))) {
+      res.method = PG_HTTP_METHOD_POST;
+    } else if (pg_string_eq(method, PG_S("PUT"))) {
+      res.method = PG_HTTP_METHOD_PUT;
+    } else if (pg_string_eq(method, PG_S("DELETE"))) {
+      res.method = PG_HTTP_METHOD_DELETE;
+    } else if (pg_string_eq(method, PG_S("TRACE"))) {
+      res.method = PG_HTTP_METHOD_TRACE;
+    } else if (pg_string_eq(method, PG_S("CONNECT"))) {
+      res.method = PG_HTTP_METHOD_CONNECT;
+    } else {
+      res.method = PG_HTTP_METHOD_EXTENSION;
+    }
+  }
+
+  // Request target, split without allocating: the path components and query
+  // parameters are only materialized if needed.
+  cut = pg_string_cut_rune(cut.right, ' ');
+  {
+    PgString target = pg_string_trim_space(cut.left);
+    res.url = pg_url_view_parse_after_authority(target);
+    if (pg_string_starts_with(res.url.path, PG_S("/")) &&
+        !pg_url_path_is_valid(res.url.path)) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+    }
+  }
+
+  PgString remaining = pg_string_trim_space(cut.right);
+  {
+    PG_OPTION(PgString)
+    consume_opt = pg_string_consume_string(remaining, PG_S("HTTP/"));
+    if (!consume_opt.has_value) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+    }
+    remaining = consume_opt.value;
+  }
+
+  {
+    PgParseNumberResult res_major = pg_string_parse_u64(remaining, 10, true);
+    if (!res_major.present) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+    }
+    if (res_major.n > 3) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+    }
+    res.version_major = (u8)res_major.n;
+    remaining = res_major.remaining;
+  }
+
+  {
+    PG_OPTION(PgString) consume_opt = pg_string_consume_rune(remaining, '.');
+    if (!consume_opt.has_value) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+    }
+    remaining = consume_opt.value;
+  }
+
+  {
+    PgParseNumberResult res_minor = pg_string_parse_u64(remaining, 10, true);
+    if (!res_minor.present) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+    }
+    if (res_minor.n > 9) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+    }
+    res.version_minor = (u8)res_minor.n;
+    remaining = res_minor.remaining;
+  }
+
+  if (!PG_SLICE_IS_EMPTY(remaining)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpRequestStatusLine, PgError);
+  }
+
+  return PG_OK(res, PgHttpRequestStatusLine, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgStringKeyValue, PgError)
+    pg_http_parse_header(PgString s) {
+  PgStringKeyValue res = {0};
+
+  PgStringCut cut = pg_string_cut_rune(s, ':');
+  if (!cut.has_value) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgStringKeyValue, PgError);
+  }
+
+  res.key = pg_string_trim_space(cut.left);
+  if (pg_string_is_empty(res.key)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgStringKeyValue, PgError);
+  }
+
+  res.value = pg_string_trim_space(cut.right);
+  if (pg_string_is_empty(res.value)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgStringKeyValue, PgError);
+  }
+
+  return PG_OK(res, PgStringKeyValue, PgError);
+}
+
+typedef enum {
+  PG_NEWLINE_KIND_LF,
+  PG_NEWLINE_KIND_CRLF,
+} PgNewlineKind;
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_OPTION(u64), PgError)
+    pg_reader_read_until_byte_incl(PgReader *r, PG_SLICE(u8) dst, u8 needle) {
+  PG_ASSERT(dst.data);
+
+  if (0 == r->ring.data.len) { // Simple reader.
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_slice(r, dst);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(u64), PgError);
+    }
+
+    u64 read_count = PG_UNWRAP(res_read);
+
+    PG_SLICE(u8) haystack = PG_SLICE_RANGE(dst, 0, read_count);
+    PG_OPTION(u64) search_opt = pg_bytes_index_of_byte(haystack, needle);
+
+    return PG_OK(search_opt, PG_OPTION(u64), PgError);
+  } else { // Buffered reader.
+    PG_ASSERT(dst.len >= r->ring.data.len);
+
+    for (u64 _i = 0; _i <= 1; _i++) {
+      PG_RESULT(PG_OPTION(u64), PgError) res = {0};
+      PG_OPTION(u64) search_opt = pg_ring_index_of_byte(r->ring, needle);
+      if (search_opt.has_value) {
+        search_opt.value += 1; // Incl.
+        PG_ASSERT(pg_ring_read_bytes(
+                      &r->ring, PG_SLICE_RANGE(dst, 0, search_opt.value)) ==
+                  search_opt.value);
+
+        return PG_OK(search_opt, PG_OPTION(u64), PgError);
+      }
+
+      // Do not overwrite data.
+      if (pg_ring_is_full(r->ring)) {
+        return PG_ERR(PG_ERR_TOO_BIG, PG_OPTION(u64), PgError);
+      }
+
+      // TODO: Should we do multiple reads?
+      u64 ring_size_before = pg_ring_can_read_count(r->ring);
+      PgError err = pg_buf_reader_try_fill_once(r);
+      if (err) {
+        return PG_ERR(err, PG_OPTION(u64), PgError);
+      }
+
+      u64 ring_size_after = pg_ring_can_read_count(r->ring);
+      if (ring_size_before == ring_size_after) {
+        // Fill failed, stop.
+        return res;
+      }
+    }
+    PG_ASSERT(0);
+  }
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_OPTION(u64), PgError)
+    pg_reader_read_until_bytes2_incl(PgReader *r, PG_SLICE(u8) dst, u8 needle0,
+                                     u8 needle1) {
+  PG_ASSERT(dst.data);
+
+  if (0 == r->ring.data.len) { // Simple reader.
+    // TODO: Multiple reads?
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_slice(r, dst);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(u64), PgError);
+    }
+
+    u64 read_count = PG_UNWRAP(res_read);
+    u8 needle_data[2] = {needle0, needle1};
+    PG_SLICE(u8) needle = {.data = needle_data, .len = 2};
+    PG_SLICE(u8) haystack = PG_SLICE_RANGE(dst, 0, read_count);
+    PG_OPTION(u64) search_opt = pg_bytes_index_of_bytes(haystack, needle);
+
+    return PG_OK(search_opt, PG_OPTION(u64), PgError);
+  } else {
+    PG_ASSERT(dst.len >= r->ring.data.len);
+
+    for (u64 _i = 0; _i <= 1; _i++) {
+      PG_RESULT(PG_OPTION(u64), PgError) res = {0};
+      PG_OPTION(u64)
+      search_opt = pg_ring_index_of_bytes2(r->ring, needle0, needle1);
+      if (search_opt.has_value) {
+        search_opt.value += 2; // Incl.
+        PG_ASSERT(pg_ring_read_bytes(
+                      &r->ring, PG_SLICE_RANGE(dst, 0, search_opt.value)) ==
+                  search_opt.value);
+        return PG_OK(search_opt, PG_OPTION(u64), PgError);
+      }
+
+      // Do not overwrite data.
+      if (pg_ring_is_full(r->ring)) {
+        return PG_ERR(PG_ERR_TOO_BIG, PG_OPTION(u64), PgError);
+      }
+
+      // TODO: Should we do multiple reads?
+      u64 ring_size_before = pg_ring_can_read_count(r->ring);
+      PgError err = pg_buf_reader_try_fill_once(r);
+      if (err) {
+        return PG_ERR(err, PG_OPTION(u64), PgError);
+      }
+
+      u64 ring_size_after = pg_ring_can_read_count(r->ring);
+      if (ring_size_before == ring_size_after) {
+        // Fill failed, stop.
+        return res;
+      }
+    }
+    PG_ASSERT(0);
+  }
+}
+
+[[nodiscard]] static PG_RESULT(PG_OPTION(u64), PgError)
+    pg_reader_read_line(PgReader *reader, PgNewlineKind newline_kind,
+                        PgString dst) {
+  PG_OPTION(u64) read_count_opt = {0};
+
+  switch (newline_kind) {
+  case PG_NEWLINE_KIND_LF:
+    read_count_opt = PG_TRY(pg_reader_read_until_byte_incl(reader, dst, '\n'),
+                            PG_OPTION(u64), PgError);
+    break;
+  case PG_NEWLINE_KIND_CRLF:
+    read_count_opt =
+        PG_TRY(pg_reader_read_until_bytes2_incl(reader, dst, '\r', '\n'),
+               PG_OPTION(u64), PgError);
+    break;
+  default:
+    PG_ASSERT(0);
+  }
+
+  if (!read_count_opt.has_value) {
+    return PG_OK(read_count_opt, PG_OPTION(u64), PgError);
+  }
+
+  switch (newline_kind) {
+  case PG_NEWLINE_KIND_LF: {
+    PG_ASSERT(read_count_opt.value >= 1);
+    PG_ASSERT('\n' == PG_SLICE_AT(dst, read_count_opt.value - 1));
+    // Trim.
+    read_count_opt.value -= 1;
+  } break;
+  case PG_NEWLINE_KIND_CRLF: {
+    PG_ASSERT(read_count_opt.value >= 2);
+    PG_ASSERT('\r' == PG_SLICE_AT(dst, read_count_opt.value - 2));
+    PG_ASSERT('\n' == PG_SLICE_AT(dst, read_count_opt.value - 1));
+    // Trim.
+    read_count_opt.value -= 2;
+  } break;
+  default:
+    PG_ASSERT(0);
+  }
+
+  return PG_OK(read_count_opt, PG_OPTION(u64), PgError);
+}
+
+#define PG_HTTP_LINE_MAX_LEN 4096
+#define PG_HTTP_HEADERS_MAX 512
+
+// Read the header lines up to and including the empty line.
+[[nodiscard]] static PgError pg_http_read_headers(PgReader *reader,
+                                                  PgHttpHeaders *headers,
+                                                  PgAllocator *allocator) {
+  u8 recv[PG_HTTP_LINE_MAX_LEN] = {0};
+  PG_SLICE(u8)
+  recv_slice = {
+      .data = recv,
+      .len = PG_HTTP_LINE_MAX_LEN,
+  };
+
+  for (u64 i = 0; i < PG_HTTP_HEADERS_MAX; i++) {
+    recv_slice.len = PG_STATIC_ARRAY_LEN(recv);
+    PG_RESULT(PG_OPTION(u64), PgError)
+    res_read = pg_reader_read_line(reader, PG_NEWLINE_KIND_CRLF, recv_slice);
+    // A read that made no progress is reported without an error.
+    PG_IF_LET_ERR(err, res_read) { return err ? err : PG_ERR_EOF; }
+    PG_OPTION(u64) read_opt = PG_UNWRAP(res_read);
+    if (!read_opt.has_value) {
+      return PG_ERR_EOF;
+    }
+
+    PgString line = PG_SLICE_RANGE(recv_slice, 0, read_opt.value);
+
+    if (0 == line.len) { // `\r\n\r\n`.
+      return 0;
+    }
+
+    PG_RESULT(PgStringKeyValue, PgError)
+    res_kv = pg_http_parse_header(pg_string_clone(line, allocator));
+    PG_IF_LET_ERR(err, res_kv) { return err; }
+    PgStringKeyValue kv = PG_UNWRAP(res_kv);
+
+    pg_http_push_header(headers, kv.key, kv.value, allocator);
+  }
+
+  // Too many headers.
+  return PG_ERR_TOO_BIG;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgHttpRequestReadResult
+pg_http_read_request(PgReader *reader, PgAllocator *allocator) {
+  PgHttpRequestReadResult res = {0};
+
+  u8 recv[PG_HTTP_LINE_MAX_LEN] = {0};
+  PG_SLICE(u8)
+  recv_slice = {
+      .data = recv,
+      .len = PG_HTTP_LINE_MAX_LEN,
+  };
+  // Status line.
+  {
+    PG_RESULT(PG_OPTION(u64), PgError)
+    res_read = pg_reader_read_line(reader, PG_NEWLINE_KIND_CRLF, recv_slice);
+    PG_IF_LET_ERR(err, res_read) {
+      res.err = err;
+      return res;
+    }
+    PG_OPTION(u64) read_opt = PG_UNWRAP(res_read);
+    if (!read_opt.has_value) {
+      res.err = PG_ERR_EOF;
+      return res;
+    }
+
+    // The line buffer is transient: the request target is kept as slices of
+    // one copy.
+    PgString line = pg_string_clone(
+        PG_SLICE_RANGE(recv_slice, 0, read_opt.value), allocator);
+
+    PG_RESULT(PgHttpRequestStatusLine, PgError)
+    res_status_line = pg_http_parse_request_status_line(line);
+
+    PG_IF_LET_ERR(err, res_status_line) {
+      res.err = err;
+      return res;
+    }
+    PgHttpRequestStatusLine status_line = PG_UNWRAP(res_status_line);
+    res.req.method = status_line.method;
+    res.req.target = status_line.url;
+    res.req.version_major = status_line.version_major;
+    res.req.version_minor = status_line.version_minor;
+  }
+
+  PgError err = pg_http_read_headers(reader, &res.req.headers, allocator);
+  if (err) {
+    res.err = err;
+    return res;
+  }
+
+  res.done = true;
+  return res;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgHttpResponseReadResult
+pg_http_read_response(PgReader *reader, PgAllocator *allocator) {
+  PgHttpResponseReadResult res = {0};
+
+  u8 recv[PG_HTTP_LINE_MAX_LEN] = {0};
+  PG_SLICE(u8)
+  recv_slice = {
+      .data = recv,
+      .len = PG_HTTP_LINE_MAX_LEN,
+  };
+  // Status line.
+  {
+    PG_RESULT(PG_OPTION(u64), PgError)
+    res_read = pg_reader_read_line(reader, PG_NEWLINE_KIND_CRLF, recv_slice);
+    PG_IF_LET_ERR(err, res_read) {
+      res.err = err;
+      return res;
+    }
+    PG_OPTION(u64) read_opt = PG_UNWRAP(res_read);
+    if (!read_opt.has_value) {
+      res.err = PG_ERR_EOF;
+      return res;
+    }
+
+    PgString line = PG_SLICE_RANGE(recv_slice, 0, read_opt.value);
+
+    PG_RESULT(PgHttpResponseStatusLine, PgError)
+    res_status_line = pg_http_parse_response_status_line(line);
+
+    PG_IF_LET_ERR(err, res_status_line) {
+      res.err = err;
+      return res;
+    }
+    PgHttpResponseStatusLine status_line = PG_UNWRAP(res_status_line);
+    res.resp.status = status_line.status;
+    res.resp.version_major = status_line.version_major;
+    res.resp.version_minor = status_line.version_minor;
+  }
+
+  PgError err = pg_http_read_headers(reader, &res.resp.headers, allocator);
+  if (err) {
+    res.err = err;
+    return res;
+  }
+
+  res.done = true;
+  return res;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_write_request(PgWriter *w, PgHttpRequest req, PgAllocator *allocator) {
+  PgError err = 0;
+
+  err = pg_http_request_write_status_line(w, req, allocator);
+  if (err) {
+    return err;
+  }
+  PG_EACH_PTR(header, &req.headers.entries) {
+    err = pg_http_write_header(w, *header, allocator);
+    if (err) {
+      return err;
+    }
+  }
+  err = pg_writer_write_full(w, PG_S("\r\n"), allocator);
+  if (err) {
+    return err;
+  }
+
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_http_request_to_string(PgHttpRequest req, PgAllocator *allocator) {
+  u64 cap =
+      // TODO: Tweak this number?
+      128 + req.url.path_components.len * 64 +
+      req.url.query_parameters.len * 64 + req.headers.entries.len * 128;
+  PgWriter w = pg_writer_make_string_builder(cap, allocator);
+
+  PG_ASSERT(0 == pg_http_write_request(&w, req, allocator));
+
+  return PG_DYN_TO_SLICE(PgString, w.u.bytes);
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_write_response(PgWriter *w, PgHttpResponse res,
+                       PgAllocator *allocator) {
+  PgError err = 0;
+
+  err = pg_http_response_write_status_line(w, res, allocator);
+  if (err) {
+    return err;
+  }
+
+  PG_EACH_PTR(header, &res.headers.entries) {
+    err = pg_http_write_header(w, *header, allocator);
+    if (err) {
+      return err;
+    }
+  }
+  err = pg_writer_write_full(w, PG_S("\r\n"), allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_flush(w, allocator);
+  if (err) {
+    return err;
+  }
+
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_http_content_length(PgHttpHeaders const *headers) {
+  PG_RESULT(u64, PgError) res = {0};
+
+  PG_OPTION(PgString)
+  value = pg_http_headers_get_by_id(headers, PG_HTTP_HEADER_ID_CONTENT_LENGTH);
+  if (!value.has_value) {
+    return res;
+  }
+
+  PgParseNumberResult res_parse = pg_string_parse_u64(value.value, 10, true);
+  if (!res_parse.present) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+  }
+  if (!pg_string_is_empty(res_parse.remaining)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+  }
+
+  return PG_OK(res_parse.n, u64, PgError);
+}
+
+// Read a line ending with `\r\n` one byte at a time, so that nothing past it
+// is consumed from `r`. The returned line excludes the `\r\n`.
+[[nodiscard]] static PG_RESULT(PgString, PgError)
+    pg_http_read_crlf_line(PgReader *r, PgString dst) {
+  u64 len = 0;
+  for (;;) {
+    if (len == dst.len) {
+      return PG_ERR(PG_ERR_TOO_BIG, PgString, PgError);
+    }
+
+    PG_RESULT(u64, PgError)
+    res_read = pg_reader_read_slice(r, PG_SLICE_RANGE(dst, len, len + 1));
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(PG_ERR_EOF == err ? PG_ERR_IO : err, PgString, PgError);
+    }
+    if (0 == PG_UNWRAP(res_read)) {
+      return PG_ERR(PG_ERR_IO, PgString, PgError);
+    }
+    len += 1;
+
+    if (len >= 2 && '\n' == PG_SLICE_AT(dst, len - 1) &&
+        '\r' == PG_SLICE_AT(dst, len - 2)) {
+      return PG_OK(PG_SLICE_RANGE(dst, 0, len - 2), PgString, PgError);
+    }
+  }
+}
+
+// Reader of the next `len` bytes of `inner`, e.g. a `Content-Length` body.
+[[maybe_unused]] [[nodiscard]] static PgReader
+pg_http_body_reader_make(PgReader *inner, u64 len) {
+  PgReader r = {0};
+  r.kind = PG_READER_KIND_HTTP_BODY;
+  r.u.http_body.inner = inner;
+  r.u.http_body.remaining = len;
+  return r;
+}
+
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_http_body_read(PgReader *r, PG_SLICE(u8) dst) {
+  PG_ASSERT(PG_READER_KIND_HTTP_BODY == r->kind);
+
+  if (0 == r->u.http_body.remaining) {
+    return PG_ERR(PG_ERR_EOF, u64, PgError);
+  }
+
+  dst.len = PG_MIN(dst.len, r->u.http_body.remaining);
+  PG_RESULT(u64, PgError) res = pg_reader_read_slice(r->u.http_body.inner, dst);
+  PG_IF_LET_ERR(err, res) {
+    // The connection ended before the body.
+    return PG_ERR(PG_ERR_EOF == err ? PG_ERR_IO : err, u64, PgError);
+  }
+  u64 n = PG_UNWRAP(res);
+  if (0 == n && dst.len > 0) {
+    return PG_ERR(PG_ERR_IO, u64, PgError);
+  }
+
+  r->u.http_body.remaining -= n;
+  return PG_OK(n, u64, PgError);
+}
+
+// Reader of a `Transfer-Encoding: chunked` body from `inner`. Each read
+// returns data of at most one chunk, copied directly into the caller's buffer,
+// so that arbitrarily large bodies stream in bounded memory. Once the last
+// chunk is read, the trailers, if any, are added to `trailers` (optional),
+// and reads return `PG_ERR_EOF`.
+[[maybe_unused]] [[nodiscard]] static PgReader
+pg_http_chunked_reader_make(PgReader *inner, PgHttpHeaders *trailers,
+                            PgAllocator *allocator) {
+  PgReader r = {0};
+  r.kind = PG_READER_KIND_HTTP_CHUNKED;
+  r.u.http_chunked.inner = inner;
+  r.u.http_chunked.trailers = trailers;
+  r.u.http_chunked.allocator = allocator;
+  return r;
+}
+
+[[nodiscard]] static PgError
+pg_http_chunked_read_trailers(PgHttpChunkedReader *c) {
+  u8 line_data[PG_HTTP_LINE_MAX_LEN] = {0};
+  PgString line_buf = PG_SLICE_FROM_C(line_data);
+
+  for (u64 i = 0; i < PG_HTTP_HEADERS_MAX; i++) {
+    PG_RESULT(PgString, PgError)
+    res_line = pg_http_read_crlf_line(c->inner, line_buf);
+    PG_IF_LET_ERR(err, res_line) { return err; }
+    PgString line = PG_UNWRAP(res_line);
+
+    if (0 == line.len) {
+      return 0;
+    }
+
+    if (!c->trailers) {
+      continue;
+    }
+
+    PG_RESULT(PgStringKeyValue, PgError)
+    res_kv = pg_http_parse_header(pg_string_clone(line, c->allocator));
+    PG_IF_LET_ERR(err, res_kv) { return err; }
+    PgStringKeyValue kv = PG_UNWRAP(res_kv);
+    pg_http_push_header(c->trailers, kv.key, kv.value, c->allocator);
+  }
+
+  // Too many trailers.
+  return PG_ERR_TOO_BIG;
+}
+
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_http_chunked_read(PgReader *r, PG_SLICE(u8) dst) {
+  PG_ASSERT(PG_READER_KIND_HTTP_CHUNKED == r->kind);
+  PgHttpChunkedReader *c = &r->u.http_chunked;
+
+  if (PG_HTTP_CHUNKED_STATE_SIZE == c->state) {
+    // `chunk-size [ chunk-ext ] CRLF`, with the extensions ignored.
+    u8 line_data[PG_HTTP_LINE_MAX_LEN] = {0};
+    PgString line_buf = PG_SLICE_FROM_C(line_data);
+    PG_RESULT(PgString, PgError)
+    res_line = pg_http_read_crlf_line(c->inner, line_buf);
+    PG_IF_LET_ERR(err, res_line) { return PG_ERR(err, u64, PgError); }
+    PgString line = PG_UNWRAP(res_line);
+
+    PgParseNumberResult size = pg_string_parse_u64(line, 16, false);
+    if (!size.present ||
+        !(pg_string_is_empty(size.remaining) ||
+          pg_string_starts_with(size.remaining, PG_S(";")) ||
+          pg_string_starts_with(size.remaining, PG_S(" ")) ||
+          pg_string_starts_with(size.remaining, PG_S("\t")))) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+    }
+
+    if (0 == size.n) { // Last chunk.
+      PgError err = pg_http_chunked_read_trailers(c);
+      if (err) {
+        return PG_ERR(err, u64, PgError);
+      }
+      c->state = PG_HTTP_CHUNKED_STATE_DONE;
+    } else {
+      c->chunk_remaining = size.n;
+      c->state = PG_HTTP_CHUNKED_STATE_DATA;
+    }
+  }
+
+  if (PG_HTTP_CHUNKED_STATE_DONE == c->state) {
+    return PG_ERR(PG_ERR_EOF, u64, PgError);
+  }
+
+  PG_ASSERT(PG_HTTP_CHUNKED_STATE_DATA == c->state);
+  if (PG_SLICE_IS_EMPTY(dst)) {
+    return PG_OK(0, u64, PgError);
+  }
+
+  dst.len = PG_MIN(dst.len, c->chunk_remaining);
+  PG_RESULT(u64, PgError) res = pg_reader_read_slice(c->inner, dst);
+  PG_IF_LET_ERR(err, res) {
+    return PG_ERR(PG_ERR_EOF == err ? PG_ERR_IO : err, u64, PgError);
+  }
+  u64 n = PG_UNWRAP(res);
+  if (0 == n) {
+    return PG_ERR(PG_ERR_IO, u64, PgError);
+  }
+  c->chunk_remaining -= n;
+
+  if (0 == c->chunk_remaining) {
+    u8 crlf[2] = {0};
+    PgError err = pg_reader_read_full(c->inner, crlf, sizeof(crlf));
+    if (err) {
+      return PG_ERR(PG_ERR_EOF == err ? PG_ERR_IO : err, u64, PgError);
+    }
+    if (!('\r' == crlf[0] && '\n' == crlf[1])) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, u64, PgError);
+    }
+    c->state = PG_HTTP_CHUNKED_STATE_SIZE;
+  }
+
+  return PG_OK(n, u64, PgError);
+}
+
+// Reader of the body of a request, which follows its headers in `inner`,
+// per RFC 9112 section 6.3: a chunked body if `Transfer-Encoding` ends with
+// `chunked`, otherwise `Content-Length` bytes, otherwise empty.
+// See `pg_http_chunked_reader_make` for `trailers`.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgReader, PgError)
+    pg_http_request_body_reader(PgHttpHeaders const *headers, PgReader *inner,
+                                PgHttpHeaders *trailers,
+                                PgAllocator *allocator) {
+  PG_OPTION(PgString)
+  transfer_encoding = pg_http_headers_get_by_id(
+      headers, PG_HTTP_HEADER_ID_TRANSFER_ENCODING);
+  if (transfer_encoding.has_value) {
+    PgString codings = transfer_encoding.value;
+    i64 comma = pg_string_last_index_of_rune(codings, ',');
+    PgString last = pg_string_trim_space(
+        -1 == comma ? codings : PG_SLICE_RANGE_START(codings, (u64)comma + 1));
+    if (!pg_string_ieq_ascii(last, PG_S("chunked"))) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgReader, PgError);
+    }
+
+    return PG_OK(pg_http_chunked_reader_make(inner, trailers, allocator),
+                 PgReader, PgError);
+  }
+
+  u64 len = 0;
+  if (headers->known[PG_HTTP_HEADER_ID_CONTENT_LENGTH]) {
+    PG_RESULT(u64, PgError) res_len = pg_http_content_length(headers);
+    PG_IF_LET_ERR(err, res_len) { return PG_ERR(err, PgReader, PgError); }
+    len = PG_UNWRAP(res_len);
+  }
+
+  return PG_OK(pg_http_body_reader_make(inner, len), PgReader, PgError);
+}
+
+// Writer of a `Transfer-Encoding: chunked` body to `inner`, typically after
+// `pg_http_write_response` with this header. Each write, or each flush when
+// buffered (`buffer_size` > 0), sends a chunk right away so that the response
+// is streamed as it is produced. `pg_http_chunked_writer_finish` ends the body.
+[[maybe_unused]] [[nodiscard]] static PgWriter
+pg_http_chunked_writer_make(PgWriter *inner, u64 buffer_size,
+                            PgAllocator *allocator) {
+  PgWriter w = {0};
+  w.kind = PG_WRITER_KIND_HTTP_CHUNKED;
+  w.u.http_chunked = inner;
+  if (buffer_size) {
+    w.ring = pg_ring_make(buffer_size, allocator);
+  }
+  return w;
+}
+
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_http_chunked_write(PgWriter *w, PG_SLICE(u8) src,
+                          PgAllocator *allocator) {
+  PG_ASSERT(PG_WRITER_KIND_HTTP_CHUNKED == w->kind);
+
+  // An empty chunk would end the body.
+  if (PG_SLICE_IS_EMPTY(src)) {
+    return PG_OK(0, u64, PgError);
+  }
+
+  // `<size in hex>\r\n`.
+  u8 size_line[16 + 2] = {0};
+  u64 idx = PG_STATIC_ARRAY_LEN(size_line) - 2;
+  size_line[idx] = '\r';
+  size_line[idx + 1] = '\n';
+  for (u64 n = src.len; n; n >>= 4) {
+    size_line[--idx] = "0123456789abcdef"[n & 0xf];
+  }
+  PgString size_line_slice = {
+      .data = size_line + idx,
+      .len = PG_STATIC_ARRAY_LEN(size_line) - idx,
+  };
+
+  PgWriter *inner = w->u.http_chunked;
+  PgError err = pg_writer_write_full(inner, size_line_slice, allocator);
+  if (err) {
+    return PG_ERR(err, u64, PgError);
+  }
+
+  err = pg_writer_write_full(inner, src, allocator);
+  if (err) {
+    return PG_ERR(err, u64, PgError);
+  }
+
+  err = pg_writer_write_full(inner, PG_S("\r\n"), allocator);
+  if (err) {
+    return PG_ERR(err, u64, PgError);
+  }
+
+  return PG_OK(src.len, u64, PgError);
+}
+
+// Send the buffered data, the last chunk and the trailers, and flush the
+// underlying writer.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_chunked_writer_finish(PgWriter *w, PgHttpHeaders trailers,
+                              PgAllocator *allocator) {
+  PG_ASSERT(PG_WRITER_KIND_HTTP_CHUNKED == w->kind);
+
+  PgError err = pg_writer_flush(w, allocator);
+  if (err) {
+    return err;
+  }
+
+  PgWriter *inner = w->u.http_chunked;
+  err = pg_writer_write_full(inner, PG_S("0\r\n"), allocator);
+  if (err) {
+    return err;
+  }
+
+  PG_EACH_PTR(trailer, &trailers.entries) {
+    err = pg_http_write_header(inner, *trailer, allocator);
+    if (err) {
+      return err;
+    }
+  }
+
+  err = pg_writer_write_full(inner, PG_S("\r\n"), allocator);
+  if (err) {
+    return err;
+  }
+
+  return pg_writer_flush(inner, allocator);
+}
+
+// Days since the Unix epoch to a Gregorian date, from
+// https://howardhinnant.github.io/date_algorithms.html#civil_from_days.
+static void pg_date_from_unix_days(u64 days, u64 *year, u64 *month,
+                                   u64 *day) {
+  u64 z = days + 719468;
+  u64 era = z / 146097;
+  u64 doe = z - era * 146097;
+  u64 yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  u64 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  u64 mp = (5 * doy + 2) / 153;
+
+  *day = doy - (153 * mp + 2) / 5 + 1;
+  *month = mp < 10 ? mp + 3 : mp - 9;
+  *year = yoe + era * 400 + (*month <= 2);
+}
+
+// Inverse of `pg_date_from_unix_days`, for years from 1970 on.
+[[nodiscard]] static u64 pg_date_to_unix_days(u64 year, u64 month, u64 day) {
+  year -= month <= 2;
+  u64 era = year / 400;
+  u64 yoe = year - era * 400;
+  u64 doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  u64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+  return era * 146097 + doe - 719468;
+}
+
+static const char pg_http_date_week_days[] = "ThuFriSatSunMonTueWed";
+static const char pg_http_date_months[] =
+    "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+[[maybe_unused]] static void pg_http_date_format(u64 unix_seconds,
+                                                 u8 dst[PG_HTTP_DATE_LEN]) {
+  u64 days = unix_seconds / 86400;
+  u64 seconds = unix_seconds % 86400;
+  u64 year = 0, month = 0, day = 0;
+  pg_date_from_unix_days(days, &year, &month, &day);
+
+  // The epoch is a Thursday.
+  pg_memcpy(dst, pg_http_date_week_days + (days % 7) * 3, 3);
+  dst[3] = ',';
+  dst[4] = ' ';
+  dst[5] = (u8)('0' + day / 10);
+  dst[6] = (u8)('0' + day % 10);
+  dst[7] = ' ';
+  pg_memcpy(dst + 8, pg_http_date_months + (month - 1) * 3, 3);
+  dst[11] = ' ';
+  dst[12] = (u8)('0' + year / 1000 % 10);
+  dst[13] = (u8)('0' + year / 100 % 10);
+  dst[14] = (u8)('0' + year / 10 % 10);
+  dst[15] = (u8)('0' + year % 10);
+  dst[16] = ' ';
+  dst[17] = (u8)('0' + seconds / 36000);
+  dst[18] = (u8)('0' + seconds / 3600 % 10);
+  dst[19] = ':';
+  dst[20] = (u8)('0' + seconds % 3600 / 600);
+  dst[21] = (u8)('0' + seconds % 3600 / 60 % 10);
+  dst[22] = ':';
+  dst[23] = (u8)('0' + seconds % 60 / 10);
+  dst[24] = (u8)('0' + seconds % 10);
+  pg_memcpy(dst + 25, " GMT", 4);
+}
+
+[[nodiscard]] static bool pg_http_date_parse_digits(PgString s, u64 start,
+                                                    u64 len, u64 *res) {
+  *res = 0;
+  for (u64 i = start; i < start + len; i++) {
+    u8 c = PG_SLICE_AT(s, i);
+    if (!pg_rune_ascii_is_numeric(c)) {
+      return false;
+    }
+    *res = *res * 10 + (u64)(c - '0');
+  }
+  return true;
+}
+
+// Only the IMF-fixdate format is accepted: the obsolete formats are not sent
+// by current clients, and a date that fails to parse is to be ignored anyway.
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(u64)
+    pg_http_date_parse(PgString s) {
+  PG_OPTION(u64) res = {0};
+
+  if (PG_HTTP_DATE_LEN != s.len || ',' != PG_SLICE_AT(s, 3) ||
+      ' ' != PG_SLICE_AT(s, 4) || ' ' != PG_SLICE_AT(s, 7) ||
+      ' ' != PG_SLICE_AT(s, 11) || ' ' != PG_SLICE_AT(s, 16) ||
+      ':' != PG_SLICE_AT(s, 19) || ':' != PG_SLICE_AT(s, 22) ||
+      !pg_string_eq(PG_SLICE_RANGE_START(s, 25), PG_S(" GMT"))) {
+    return res;
+  }
+
+  u64 day = 0, year = 0, hours = 0, minutes = 0, seconds = 0;
+  if (!pg_http_date_parse_digits(s, 5, 2, &day) ||
+      !pg_http_date_parse_digits(s, 12, 4, &year) ||
+      !pg_http_date_parse_digits(s, 17, 2, &hours) ||
+      !pg_http_date_parse_digits(s, 20, 2, &minutes) ||
+      !pg_http_date_parse_digits(s, 23, 2, &seconds)) {
+    return res;
+  }
+
+  u64 month = 0;
+  for (; month < 12; month++) {
+    PgString name = {.data = (u8 *)pg_http_date_months + month * 3, .len = 3};
+    if (pg_string_eq(PG_SLICE_RANGE(s, 8, 11), name)) {
+      break;
+    }
+  }
+
+  if (12 == month || year < 1970 || 0 == day || day > 31 || hours > 23 ||
+      minutes > 59 || seconds > 60) {
+    return res;
+  }
+
+  res.value = pg_date_to_unix_days(year, month + 1, day) * 86400 +
+              hours * 3600 + minutes * 60 + seconds;
+  res.has_value = true;
+  return res;
+}
+
+// Parse the `Range` header for a body of `size` bytes. Multiple ranges are
+// not supported and, like invalid ranges, are ignored which means the full
+// body is sent.
+[[maybe_unused]] [[nodiscard]] static PgHttpRange
+pg_http_range_parse(PgString value, u64 size) {
+  PgHttpRange res = {0};
+
+  value = pg_string_trim_space(value);
+  PgString unit = PG_S("bytes=");
+  if (value.len < unit.len ||
+      !pg_string_ieq_ascii(PG_SLICE_RANGE(value, 0, unit.len), unit)) {
+    return res;
+  }
+  value = PG_SLICE_RANGE_START(value, unit.len);
+
+  if (pg_string_contains_rune(value, ',') || 0 == size) {
+    return res;
+  }
+
+  PgStringCut cut = pg_string_cut_rune(value, '-');
+  if (!cut.has_value) {
+    return res;
+  }
+  PgString first = pg_string_trim_space(cut.left);
+  PgString last = pg_string_trim_space(cut.right);
+
+  PgParseNumberResult res_first = pg_string_parse_u64(first, 10, false);
+  PgParseNumberResult res_last = pg_string_parse_u64(last, 10, false);
+  if ((!pg_string_is_empty(first) &&
+       (!res_first.present || !pg_string_is_empty(res_first.remaining))) ||
+      (!pg_string_is_empty(last) &&
+       (!res_last.present || !pg_string_is_empty(res_last.remaining)))) {
+    return res;
+  }
+
+  if (pg_string_is_empty(first)) { // `-500`: the last 500 bytes.
+    if (pg_string_is_empty(last)) {
+      return res;
+    }
+    if (0 == res_last.n) {
+      res.kind = PG_HTTP_RANGE_KIND_UNSATISFIABLE;
+      return res;
+    }
+    res.start = size - PG_MIN(res_last.n, size);
+    res.end = size;
+    res.kind = PG_HTTP_RANGE_KIND_SATISFIABLE;
+    return res;
+  }
+
+  if (!pg_string_is_empty(last) && res_last.n < res_first.n) {
+    return res;
+  }
+
+  if (res_first.n >= size) {
+    res.kind = PG_HTTP_RANGE_KIND_UNSATISFIABLE;
+    return res;
+  }
+
+  res.start = res_first.n;
+  // Bounded by the size, so that the `+ 1` cannot overflow.
+  res.end = pg_string_is_empty(last) ? size : PG_MIN(res_last.n, size - 1) + 1;
+  res.kind = PG_HTTP_RANGE_KIND_SATISFIABLE;
+  return res;
+}
+
+// Whether `etag` is in the comma separated `list` of the `If-None-Match`
+// header, with the weak comparison.
+[[maybe_unused]] [[nodiscard]] static bool
+pg_http_etag_list_matches(PgString list, PgString etag) {
+  PgString weak = PG_S("W/");
+  if (pg_string_starts_with(etag, weak)) {
+    etag = PG_SLICE_RANGE_START(etag, weak.len);
+  }
+
+  PgSplitIterator it = pg_string_split_string(list, PG_S(","));
+  for (;;) {
+    PG_OPTION(PgString) elem = pg_string_split_next(&it);
+    if (!elem.has_value) {
+      return false;
+    }
+
+    PgString candidate = pg_string_trim_space(elem.value);
+    if (pg_string_eq(candidate, PG_S("*"))) {
+      return true;
+    }
+    if (pg_string_starts_with(candidate, weak)) {
+      candidate = PG_SLICE_RANGE_START(candidate, weak.len);
+    }
+    if (pg_string_eq(candidate, etag)) {
+      return true;
+    }
+  }
+}
+
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_http_content_type_from_path(PgString path) {
+  static const PgStringKeyValue types[] = {
+      {PG_S("html"), PG_S("text/html; charset=utf-8")},
+      {PG_S("htm"), PG_S("text/html; charset=utf-8")},
+      {PG_S("css"), PG_S("text/css; charset=utf-8")},
+      {PG_S("js"), PG_S("text/javascript; charset=utf-8")},
+      {PG_S("mjs"), PG_S("text/javascript; charset=utf-8")},
+      {PG_S("json"), PG_S("application/json")},
+      {PG_S("txt"), PG_S("text/plain; charset=utf-8")},
+      {PG_S("xml"), PG_S("application/xml")},
+      {PG_S("svg"), PG_S("image/svg+xml")},
+      {PG_S("png"), PG_S("image/png")},
+      {PG_S("jpg"), PG_S("image/jpeg")},
+      {PG_S("jpeg"), PG_S("image/jpeg")},
+      {PG_S("gif"), PG_S("image/gif")},
+      {PG_S("webp"), PG_S("image/webp")},
+      {PG_S("ico"), PG_S("image/x-icon")},
+      {PG_S("wasm"), PG_S("application/wasm")},
+      {PG_S("pdf"), PG_S("application/pdf")},
+      {PG_S("woff2"), PG_S("font/woff2")},
+      {PG_S("mp4"), PG_S("video/mp4")},
+  };
+
+  PgString ext = pg_file_extension(path);
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(types); i++) {
+    if (pg_string_ieq_ascii(types[i].key, ext)) {
+      return types[i].value;
+    }
+  }
+  return PG_S("application/octet-stream");
+}
+
+// Whether the `Connection` header has the option `token` e.g. `close`.
+[[maybe_unused]] [[nodiscard]] static bool
+pg_http_headers_connection_has(PgHttpHeaders const *headers, PgString token) {
+  PG_OPTION(PgString)
+  value = pg_http_headers_get_by_id(headers, PG_HTTP_HEADER_ID_CONNECTION);
+  if (!value.has_value) {
+    return false;
+  }
+
+  PgSplitIterator it = pg_string_split_string(value.value, PG_S(","));
+  for (;;) {
+    PG_OPTION(PgString) elem = pg_string_split_next(&it);
+    if (!elem.has_value) {
+      return false;
+    }
+    if (pg_string_ieq_ascii(pg_string_trim_space(elem.value), token)) {
+      return true;
+    }
+  }
+}
+
+typedef enum : u8 {
+  PG_HTTP_CONTENT_ENCODING_IDENTITY,
+  PG_HTTP_CONTENT_ENCODING_GZIP,
+  // The zlib format, despite the name.
+  PG_HTTP_CONTENT_ENCODING_DEFLATE,
+} PgHttpContentEncoding;
+
+// Weight of an `Accept-Encoding` element with its parameters e.g. `;q=0.5`,
+// in thousandths. Invalid weights exclude the element.
+[[nodiscard]] static u32 pg_http_qvalue_parse(PgString params) {
+  PgSplitIterator it = pg_string_split_string(params, PG_S(";"));
+  for (;;) {
+    PG_OPTION(PgString) elem = pg_string_split_next(&it);
+    if (!elem.has_value) {
+      return 1000;
+    }
+
+    PgStringCut cut = pg_string_cut_rune(pg_string_trim_space(elem.value), '=');
+    if (!cut.has_value || !pg_string_ieq_ascii(cut.left, PG_S("q"))) {
+      continue;
+    }
+
+    // `0[.ddd]` or `1[.000]`.
+    PgString q = cut.right;
+    if (0 == q.len || q.len > 5 || (q.len > 1 && '.' != q.data[1]) ||
+        ('0' != q.data[0] && '1' != q.data[0])) {
+      return 0;
+    }
+    u32 res = ('1' == q.data[0]) ? 1000 : 0;
+    u32 scale = 100;
+    for (u64 i = 2; i < q.len; i++, scale /= 10) {
+      if (!pg_rune_ascii_is_numeric(q.data[i])) {
+        return 0;
+      }
+      res += (u32)(q.data[i] - '0') * scale;
+    }
+    return res <= 1000 ? res : 0;
+  }
+}
+
+// Content coding to compress a response with, given the `Accept-Encoding`
+// request header: the one with the highest weight, gzip on ties since it is
+// the most widely supported. Without the header or a supported coding, the
+// response is sent as is.
+[[maybe_unused]] [[nodiscard]] static PgHttpContentEncoding
+pg_http_negotiate_content_encoding(PgHttpHeaders const *headers) {
+  PG_OPTION(PgString)
+  value = pg_http_headers_get_by_id(headers, PG_HTTP_HEADER_ID_ACCEPT_ENCODING);
+  if (!value.has_value) {
+    return PG_HTTP_CONTENT_ENCODING_IDENTITY;
+  }
+
+  // Unset weights, by `PgHttpContentEncoding`, are `-1`.
+  i32 weights[3] = {-1, -1, -1};
+  i32 wildcard = -1;
+
+  PgSplitIterator it = pg_string_split_string(value.value, PG_S(","));
+  for (;;) {
+    PG_OPTION(PgString) elem = pg_string_split_next(&it);
+    if (!elem.has_value) {
+      break;
+    }
+
+    PgStringCut cut = pg_string_cut_rune(elem.value, ';');
+    PgString coding =
+        pg_string_trim_space(cut.has_value ? cut.left : elem.value);
+    i32 weight =
+        (i32)pg_http_qvalue_parse(cut.has_value ? cut.right : PG_S(""));
+
+    if (pg_string_ieq_ascii(coding, PG_S("gzip")) ||
+        pg_string_ieq_ascii(coding, PG_S("x-gzip"))) {
+      weights[PG_HTTP_CONTENT_ENCODING_GZIP] = weight;
+    } else if (pg_string_ieq_ascii(coding, PG_S("deflate"))) {
+      weights[PG_HTTP_CONTENT_ENCODING_DEFLATE] = weight;
+    } else if (pg_string_eq(coding, PG_S("*"))) {
+      wildcard = weight;
+    }
+  }
+
+  PgHttpContentEncoding res = PG_HTTP_CONTENT_ENCODING_IDENTITY;
+  i32 best = 0;
+  for (u32 i = PG_HTTP_CONTENT_ENCODING_GZIP; i < PG_STATIC_ARRAY_LEN(weights);
+       i++) {
+    i32 weight = weights[i] >= 0 ? weights[i] : wildcard;
+    if (weight > best) {
+      best = weight;
+      res = (PgHttpContentEncoding)i;
+    }
+  }
+  return res;
+}
+
+// Worth compressing: text, and binary formats that are not compressed
+// already.
+[[maybe_unused]] [[nodiscard]] static bool
+pg_http_content_type_is_compressible(PgString content_type) {
+  PgStringCut cut = pg_string_cut_rune(content_type, ';');
+  PgString type = pg_string_trim_space(cut.has_value ? cut.left : content_type);
+
+  static const PgString compressible[] = {
+      PG_S("application/json"),       PG_S("application/xml"),
+      PG_S("application/javascript"), PG_S("application/wasm"),
+      PG_S("image/svg+xml"),
+  };
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(compressible); i++) {
+    if (pg_string_ieq_ascii(type, compressible[i])) {
+      return true;
+    }
+  }
+
+  return type.len > 5 && pg_string_ieq_ascii(PG_SLICE_RANGE(type, 0, 5),
+                                             PG_S("text/"));
+}
+
+// HTTP/1.1 connections persist unless closed explicitly, HTTP/1.0 ones only
+// with `Connection: keep-alive`.
+[[maybe_unused]] [[nodiscard]] static bool
+pg_http_keep_alive(PgHttpHeaders const *headers, u8 version_major,
+                   u8 version_minor) {
+  if (pg_http_headers_connection_has(headers, PG_S("close"))) {
+    return false;
+  }
+  if (1 == version_major && 0 == version_minor) {
+    return pg_http_headers_connection_has(headers, PG_S("keep-alive"));
+  }
+  return 1 == version_major;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgLogger
+pg_log_make_logger_stdout(PgLogLevel level, PgLogFormat format,
+                          PgAllocator *allocator) {
+  PgLogger logger = {
+      .level = level,
+      .writer = pg_writer_make_from_file_descriptor(pg_os_stdout(), 4 * PG_KiB,
+                                                    allocator),
+      .format = format,
+      // TODO: Consider using `rtdsc` or such.
+      .monotonic_epoch =
+          PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)),
+      .allocator = allocator,
+  };
+
+  return logger;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_log_level_to_string(PgLogLevel level) {
+  switch (level) {
+  case PG_LOG_LEVEL_DEBUG:
+    return PG_S("debug");
+  case PG_LOG_LEVEL_INFO:
+    return PG_S("info");
+  case PG_LOG_LEVEL_ERROR:
+    return PG_S("error");
+  default:
+    PG_ASSERT(false);
+  }
+}
+
+#define pg_log_c_u8(k, v) pg_log_u8(PG_S(k), v)
+
+[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_u8(PgString k, u8 v) {
+  return (PgLogEntry){
+      .key = k,
+      .value.kind = PG_LOG_VALUE_U64,
+      .value.n64 = (u64)v,
+  };
+}
+
+#define pg_log_c_u16(k, v) pg_log_u16(PG_S(k), v)
+
+[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_u16(PgString k, u16 v) {
+  return (PgLogEntry){
+      .key = k,
+      .value.kind = PG_LOG_VALUE_U64,
+      .value.n64 = (u64)v,
+  };
+}
+
+#define pg_log_c_u32(k, v) pg_log_u32(PG_S(k), v)
+
+[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_u32(PgString k, u32 v) {
+  return (PgLogEntry){
+      .key = k,
+      .value.kind = PG_LOG_VALUE_U64,
+      .value.n64 = (u64)v,
+  };
+}
+
+#define pg_log_c_u64(k, v) pg_log_u64(PG_S(k), v)
+
+[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_u64(PgString k, u64 v) {
+  return (PgLogEntry){
+      .key = k,
+      .value.kind = PG_LOG_VALUE_U64,
+      .value.n64 = v,
+  };
+}
+
+#define pg_log_c_i32(k, v) pg_log_i32(PG_S(k), v)
+
+[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_i32(PgString k, i32 v) {
+  return (PgLogEntry){
+      .key = k,
+      .value.kind = PG_LOG_VALUE_I64,
+      .value.s64 = (i64)v,
+  };
+}
+
+#define pg_log_c_err(k, v) pg_log_i32(PG_S(k), (i32)v)
+#define pg_log_err(k, v) pg_log_i32(k, (i32)v)
+
+#define pg_log_c_i64(k, v) pg_log_i64(PG_S(k), v)
+
+[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_i64(PgString k, i64 v) {
+  return (PgLogEntry){
+      .key = k,
+      .value.kind = PG_LOG_VALUE_I64,
+      .value.s64 = v,
+  };
+}
+
+[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_s(PgString k,
+                                                          PgString v) {
+  return (PgLogEntry){
+      .key = k,
+      .value.kind = PG_LOG_VALUE_STRING,
+      .value.s = v,
+  };
+}
+
+#define pg_log_c_s(k, v) pg_log_s(PG_S(k), v)
+
+#define pg_log_c_ipv4(k, v) pg_log_ipv4(PG_S(k), v)
+
+[[maybe_unused]] [[nodiscard]] static PgLogEntry pg_log_ipv4(PgString k,
+                                                             PgIpv4Address v) {
+  return (PgLogEntry){
+      .key = k,
+      .value.kind = PG_LOG_VALUE_IPV4_ADDRESS,
+      .value.ipv4_address = v,
+  };
+}
+
+#define PG_LOG_ARGS_COUNT(...)                                                 \
+  (sizeof((PgLogEntry[]){__VA_ARGS__}) / sizeof(PgLogEntry))
+#define pg_log(logger, lvl, msg, ...)                                          \
+  do {                                                                         \
+    if (nullptr == (logger)) {                                                 \
+      break;                                                                   \
+    }                                                                          \
+    if ((logger)->level > (lvl)) {                                             \
+      break;                                                                   \
+    };                                                                         \
+    (void)pg_logger_do_log(logger, lvl, PG_S(msg), (logger)->allocator,        \
+                           PG_LOG_ARGS_COUNT(__VA_ARGS__), __VA_ARGS__);       \
+  } while (0)
+
+static PgError pg_logfmt_write_string_escaped(PgWriter *w, PgString entry,
+                                              PgAllocator *allocator) {
+  PgError err = 0;
+
+  bool has_spaces = pg_bytes_contains_any_byte(entry, PG_ASCII_SPACES);
+  if (has_spaces) {
+    err = pg_writer_write_u8(w, '"', allocator);
+    if (err) {
+      return err;
+    }
+  }
+
+  err = pg_writer_write_escaped(w, entry, PG_ESCAPE_KIND_LOGFMT, allocator);
+  if (err) {
+    return err;
+  }
+
+  if (has_spaces) {
+    err = pg_writer_write_u8(w, '"', allocator);
+    if (err) {
+      return err;
+    }
+  }
+
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgArena pg_arena_make_from_mem(u8 *data,
+                                                                     u64 len) {
+  PgArena arena = {
+      .start = data,
+      .end = data + len,
+      .start_original = data,
+  };
+
+  return arena;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_logger_do_log(PgLogger *logger, PgLogLevel level, PgString msg,
+                 PgAllocator *allocator, i32 args_count, ...) {
+  // Ignore clock errors.
+  u64 monotonic_ns =
+      PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)) -
+      logger->monotonic_epoch;
+  u64 timestamp_ns =
+      PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_REALTIME));
+
+  PgError err = 0;
+
+  err = pg_writer_write_full(&logger->writer, PG_S("level="), allocator);
+  if (err) {
+    return err;
+  }
+  err = pg_writer_write_full(&logger->writer, pg_log_level_to_string(level),
+                             allocator);
+  if (err) {
+    return err;
+  }
+
+  err =
+      pg_writer_write_full(&logger->writer, PG_S(" timestamp_ns="), allocator);
+  if (err) {
+    return err;
+  }
+  err = pg_writer_write_u64_as_string(&logger->writer, timestamp_ns, allocator);
+  if (err) {
+    return err;
+  }
+
+  err =
+      pg_writer_write_full(&logger->writer, PG_S(" monotonic_ns="), allocator);
+  if (err) {
+    return err;
+  }
+  err = pg_writer_write_u64_as_string(&logger->writer, monotonic_ns, allocator);
+  if (err) {
+    return err;
+  }
+
+  err = pg_writer_write_full(&logger->writer, PG_S(" message="), allocator);
+  if (err) {
+    return err;
+  }
+  err = pg_logfmt_write_string_escaped(&logger->writer, msg, allocator);
+  if (err) {
+    return err;
+  }
+
+  va_list argp = {0};
+  va_start(argp, args_count);
+  for (i32 i = 0; i < args_count; i++) {
+    PgLogEntry entry = va_arg(argp, PgLogEntry);
+    err = pg_writer_write_u8(&logger->writer, ' ', allocator);
+    if (err) {
+      return err;
+    }
+    err = pg_writer_write_full(&logger->writer, entry.key, allocator);
+    if (err) {
+      return err;
+    }
+    err = pg_writer_write_u8(&logger->writer, '=', allocator);
+    if (err) {
+      return err;
+    }
+
+    switch (entry.value.kind) {
+    case PG_LOG_VALUE_STRING: {
+      err = pg_logfmt_write_string_escaped(&logger->writer, entry.value.s,
+                                           allocator);
+      if (err) {
+        return err;
+      }
+      break;
+    }
+    case PG_LOG_VALUE_U64:
+      err = pg_writer_write_u64_as_string(&logger->writer, entry.value.n64,
+                                          allocator);
+      if (err) {
+        return err;
+      }
+      break;
+    case PG_LOG_VALUE_I64:
+      err = pg_writer_write_i64_as_string(&logger->writer, entry.value.s64,
+                                          allocator);
+      if (err) {
+        return err;
+      }
+      break;
+    case PG_LOG_VALUE_IPV4_ADDRESS: {
+      // Temporary: do not grow the caller's arena on each log.
+      PgArenaTemp scratch = pg_scratch_begin(allocator);
+      PgString ipv4_addr_str = pg_net_ipv4_address_to_string(
+          entry.value.ipv4_address, pg_arena_temp_allocator(&scratch));
+      err = pg_writer_write_full(&logger->writer, ipv4_addr_str, allocator);
+      pg_scratch_end(scratch);
+      if (err) {
+        return err;
+      }
+    } break;
+    default:
+      PG_ASSERT(0 && "invalid PgLogValueKind");
+    }
+  }
+  va_end(argp);
+
+  err = pg_writer_write_u8(&logger->writer, '\n', allocator);
+  if (err) {
+    return err;
+  }
+
+  return pg_writer_flush(&logger->writer, allocator);
+}
+
+typedef i32 (*PgCmpFn)(const void *a, const void *b);
+
+[[maybe_unused]] [[nodiscard]] static i32 pg_cmp_u64(const void *va,
+                                                     const void *vb) {
+  PG_ASSERT(va);
+  PG_ASSERT(vb);
+  u64 a = *(u64 *)va;
+  u64 b = *(u64 *)vb;
+
+  if (a < b) {
+    return -1;
+  } else if (a == b) {
+    return 0;
+  } else {
+    return 1;
+  }
+}
+
+static void pg_swap(void *a, void *b, u64 elem_size) {
+  u8 tmp[256] = {0};
+
+  for (u64 copied = 0; copied < elem_size;) {
+    PG_ASSERT(copied < elem_size);
+
+    u64 batch_size = PG_MIN(sizeof(tmp), elem_size);
+    if (elem_size - copied < batch_size) {
+      batch_size = elem_size - copied;
+    }
+
+    __builtin_memcpy(tmp + copied, a, batch_size);
+    __builtin_memcpy(b, tmp + copied, batch_size);
+    copied += batch_size;
+  }
+}
+
+static void pg_quicksort(void *elems, u64 elem_size, u64 elems_count,
+                         PgCmpFn cmp_fn) {
+  PG_ASSERT(elems != nullptr);
+  PG_ASSERT(elem_size != 0);
+  PG_ASSERT(cmp_fn);
+
+  if (elems_count <= 1) {
+    return;
+  }
+
+  pg_quicksort(elems, elem_size, elems_count / 2, cmp_fn);
+  pg_quicksort(pivot, elem_size, (end - pivot) / elem_size, cmp_fn);
+}
+
+[[nodiscard]]
+static u64 pg_quicksort_partition(void *elems, u64 elem_size, u64 elems_count,
+                                  PgCmpFn cmp_fn) {
+  if (elems_count <= 1) {
+    return 0;
+  }
+  u64 tmp_pivot_idx = 0; // First element.
+  void *pivot = elems + (elems_count - 1) * elem_size;
+
+  for (u64 i = 0; i < elems_count - 1; i++) {
+    void *elem = elems + i * elem_size;
+    i32 cmp = cmp_fn(elem, pivot);
+    if (cmp > 0) { // Need to swap.
+      pg_swap(elem, pivot, elem_size);
+      tmp_pivot_idx += 1;
+      PG_ASSERT(tmp_pivot_idx <= elems_count);
+    }
+  }
+
+  PG_ASSERT(tmp_pivot_idx < elems_count);
+  // Swap temporary pivot with last element.
+  pg_swap(elems + tmp_pivot_idx * elem_size,
+          elems + (elems_count - 1) * elem_size, elem_size);
+
+  return tmp_pivot_idx;
+}
+
+[[maybe_unused]] static void pg_sort_unique(void *elems, u64 elem_size,
+                                            u64 *elems_count, PgCmpFn cmp_fn) {
+  pg_quicksort(elems, *elems_count, elem_size, cmp_fn);
+
+  if (*elems_count <= 1) {
+    return;
+  }
+
+  for (u64 i = 1; i < *elems_count;) {
+    void *previous = (u8 *)elems + elem_size * (i - 1);
+    void *current = (u8 *)elems + elem_size * i;
+    if (PG_CMP_EQ == cmp_fn(previous, current)) {
+      pg_memmove(previous, current, elem_size * (*elems_count - i));
+      PG_ASSERT(*elems_count > 0);
+      *elems_count -= 1;
+    } else {
+      i += 1;
+    }
+  }
+}
+
+[[maybe_unused]] [[nodiscard]] static PgUuid pg_uuid_v5(PgUuid namespace,
+                                                        PgString name) {
+  PG_SHA1_CTX ctx = {0};
+  PG_SHA1Init(&ctx);
+  PG_SHA1Update(&ctx, namespace.value, PG_STATIC_ARRAY_LEN(namespace.value));
+  PG_SHA1Update(&ctx, name.data, name.len);
+
+  PgSha1 digest = {0};
+  PG_SHA1Final(digest.data, &ctx);
+
+  PgUuid res = {.version = 5};
+  pg_memcpy(res.value, digest.data, 16);
+
+  res.value[6] &= 0x0F;
+  res.value[6] |= 0x50;
+
+  res.value[8] &= 0x3F;
+  res.value[8] |= 0x80;
+
+  return res;
+}
+
+#define PG_UUID_STRING_LENGTH (8 + 4 + 4 + 4 + 12 + 4)
+
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_uuid_to_string(PgUuid uuid, PgAllocator *allocator) {
+  PgString res = pg_string_make(PG_UUID_STRING_LENGTH, allocator);
+  u64 i = 0;
+
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[0] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[0] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[1] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[1] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[2] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[2] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[3] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[3] & 0xF);
+  res.data[i++] = '-';
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[4] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[4] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[5] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[5] & 0xF);
+  res.data[i++] = '-';
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[6] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[6] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[7] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[7] & 0xF);
+  res.data[i++] = '-';
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[8] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[8] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[9] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[9] & 0xF);
+  res.data[i++] = '-';
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[10] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[10] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[11] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[11] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[12] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[12] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[13] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[13] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[14] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[14] & 0xF);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[15] >> 4);
+  res.data[i++] = pg_u8_to_hex_rune(uuid.value[15] & 0xF);
+
+  return res;
+}
+
+[[nodiscard]] static bool pg_html_tag_is_self_closing(PgString tag) {
+  return pg_string_eq(tag, PG_S("area")) || pg_string_eq(tag, PG_S("base")) ||
+         pg_string_eq(tag, PG_S("br")) || pg_string_eq(tag, PG_S("col")) ||
+         pg_string_eq(tag, PG_S("embed")) || pg_string_eq(tag, PG_S("hr")) ||
+         pg_string_eq(tag, PG_S("img")) || pg_string_eq(tag, PG_S("input")) ||
+         pg_string_eq(tag, PG_S("link")) || pg_string_eq(tag, PG_S("meta")) ||
+         pg_string_eq(tag, PG_S("param")) ||
+         pg_string_eq(tag, PG_S("source")) ||
+         pg_string_eq(tag, PG_S("track")) || pg_string_eq(tag, PG_S("wbr"));
+}
+
+[[nodiscard]] static bool pg_svg_tag_is_self_closing(PgString tag) {
+  return pg_string_eq(tag, PG_S("path")) || pg_string_eq(tag, PG_S("line")) ||
+         pg_string_eq(tag, PG_S("circle")) || pg_string_eq(tag, PG_S("rect")) ||
+         pg_string_eq(tag, PG_S("polygon")) ||
+         pg_string_eq(tag, PG_S("polyline")) || pg_string_eq(tag, PG_S("stop"));
+
+  // TODO: more.
+}
+
+#include "html_entities.c"
+
+#define PG_HTML_ENTITY_NAME_MAX_LEN 32
+// Longest name of the legacy entities that may omit the `;` e.g. `&eacute`.
+#define PG_HTML_ENTITY_LEGACY_NAME_MAX_LEN 6
+// Named references decode to at most 2 code points, numeric ones to 1.
+#define PG_HTML_ENTITY_DECODED_MAX_LEN 8
+
+// Numeric references to C1 controls are interpreted as Windows-1252.
+static const u16 pg_html_windows_1252_c1[32] = {
+    0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+    0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178,
+};
+
+// Must match `gen_html_entities.py`.
+[[nodiscard]] static u32 pg_html_entity_hash(PgString name, u32 seed) {
+  u32 h = 2166136261U ^ seed;
+  PG_EACH_PTR(c, &name) {
+    h ^= *c;
+    h *= 16777619U;
+  }
+  return h;
+}
+
+// Named character reference, `name` excluding the `&` and including the `;`
+// if any.
+[[maybe_unused]] [[nodiscard]] static const PgHtmlEntity *
+pg_html_entity_find(PgString name) {
+  if (pg_string_is_empty(name) || name.len > PG_HTML_ENTITY_NAME_MAX_LEN) {
+    return nullptr;
+  }
+
+  u32 bucket = pg_html_entity_hash(name, 0) % PG_HTML_ENTITY_BUCKETS_LEN;
+  u32 slot = pg_html_entity_hash(name, pg_html_entity_seeds[bucket]) %
+             PG_HTML_ENTITY_SLOTS_LEN;
+  u16 idx = pg_html_entity_slots[slot];
+  if (0 == idx) {
+    return nullptr;
+  }
+
+  const PgHtmlEntity *entity = &pg_html_entities[idx - 1];
+  PgString entity_name = {
+      .data = (u8 *)pg_html_entity_names + entity->name_offset,
+      .len = entity->name_len,
+  };
+  return pg_string_eq(name, entity_name) ? entity : nullptr;
+}
+
+// Decode the character reference at the start of `s` into `out`.
+// Returns how many bytes of `s` it spans, 0 if `s` does not start with one.
+[[nodiscard]] static u64 pg_html_entity_decode(PgString s, u8 *out,
+                                               u64 *out_len) {
+  PG_ASSERT('&' == PG_SLICE_AT(s, 0));
+
+  if (s.len >= 2 && '#' == PG_SLICE_AT(s, 1)) {
+    u64 i = 2;
+    u64 base = 10;
+    if (s.len > 2 && ('x' == PG_SLICE_AT(s, 2) || 'X' == PG_SLICE_AT(s, 2))) {
+      i = 3;
+      base = 16;
+    }
+
+    PgString digits = PG_SLICE_RANGE_START(s, i);
+    digits.len = pg_digits_run_len(digits, base);
+    if (pg_string_is_empty(digits)) {
+      return 0;
+    }
+    i += digits.len;
+    if (i < s.len && ';' == PG_SLICE_AT(s, i)) {
+      i += 1;
+    }
+
+    while (digits.len > 1 && '0' == PG_SLICE_AT(digits, 0)) {
+      digits = PG_SLICE_RANGE_START(digits, 1);
+    }
+    u64 n = 0;
+    bool ok = pg_digits_to_u64(digits, base, &n);
+    PgRune rune = (!ok || 0 == n || n > 0x10FFFF || (0xD800 <= n && n <= 0xDFFF))
+                      ? 0xFFFD
+                      : (PgRune)n;
+    if (0x80 <= rune && rune <= 0x9F) {
+      rune = pg_html_windows_1252_c1[rune - 0x80];
+    }
+
+    *out_len = pg_utf8_encode_rune(rune, out);
+    return i;
+  }
+
+  u64 name_len = 0;
+  for (; 1 + name_len < s.len && name_len < PG_HTML_ENTITY_NAME_MAX_LEN &&
+         pg_rune_ascii_is_alphanumeric(PG_SLICE_AT(s, 1 + name_len));
+       name_len++) {
+  }
+
+  const PgHtmlEntity *entity = nullptr;
+  u64 len = 0;
+  if (1 + name_len < s.len && ';' == PG_SLICE_AT(s, 1 + name_len)) {
+    len = name_len + 1;
+    entity = pg_html_entity_find(PG_SLICE_RANGE(s, 1, 1 + len));
+  }
+  // Longest legacy entity without `;` e.g. `&notit;` is `¬it;`.
+  if (!entity) {
+    for (len = PG_MIN(name_len, PG_HTML_ENTITY_LEGACY_NAME_MAX_LEN); len >= 2;
+         len--) {
+      entity = pg_html_entity_find(PG_SLICE_RANGE(s, 1, 1 + len));
+      if (entity) {
+        break;
+      }
+    }
+  }
+  if (!entity) {
+    return 0;
+  }
+
+  pg_memcpy(out, entity->value, entity->value_len);
+  *out_len = entity->value_len;
+  return 1 + len;
+}
+
+// Decode the character references of `src` into `dst`, which may be
+// `src.data` (`in_place`). In place, the decoding stops at the first
+// reference whose value is longer than itself (`&nGt;` and `&nLt;`) if it
+// would overwrite the unread input. Returns the decoded length and sets
+// `read` to how much of `src` was decoded.
+[[nodiscard]] static u64 pg_html_decode_entities_to(PgString src, u8 *dst,
+                                                    u64 dst_cap, bool in_place,
+                                                    u64 *read) {
+  u64 r = 0;
+  u64 w = 0;
+
+  while (r < src.len) {
+    PgString rest = PG_SLICE_RANGE_START(src, r);
+    PG_OPTION(u64) amp = pg_bytes_index_of_byte(rest, '&');
+    u64 run = amp.has_value ? amp.value : rest.len;
+    PG_ASSERT(w + run <= dst_cap);
+    pg_memmove(dst + w, rest.data, run);
+    w += run;
+    r += run;
+    if (r == src.len) {
+      break;
+    }
+
+    u8 value[PG_HTML_ENTITY_DECODED_MAX_LEN] = {'&'};
+    u64 value_len = 1;
+    u64 consumed =
+        pg_html_entity_decode(PG_SLICE_RANGE_START(src, r), value, &value_len);
+    if (0 == consumed) { // Literal `&`.
+      consumed = 1;
+      value_len = 1;
+      value[0] = '&';
+    }
+
+    u64 limit = in_place ? r + consumed : dst_cap;
+    if (w + value_len > limit) {
+      break;
+    }
+    pg_memcpy(dst + w, value, value_len);
+    w += value_len;
+    r += consumed;
+  }
+
+  *read = r;
+  return w;
+}
+
+// Text with its character references e.g. `&amp;` or `&#x1F34C;` decoded.
+// Text without `&` is returned as is, otherwise it is decoded into a new
+// string.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_html_decode_entities(PgString s, PgAllocator *allocator) {
+  if (!pg_bytes_index_of_byte(s, '&').has_value) {
+    return s;
+  }
+
+  // At worst, 5 bytes (`&nGt;`) decode to 6.
+  PgString res = pg_string_make(s.len + s.len / 5, allocator);
+  u64 read = 0;
+  res.len = pg_html_decode_entities_to(s, res.data, res.len, false, &read);
+  PG_ASSERT(read == s.len);
+  return res;
+}
+
+// Same as `pg_html_decode_entities` but decode in place, which only needs
+// `allocator` in the rare cases where the decoded text is longer.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_html_decode_entities_in_place(PG_SLICE(u8) s, PgAllocator *allocator) {
+  u64 read = 0;
+  u64 len = pg_html_decode_entities_to(s, s.data, s.len, true, &read);
+  if (read == s.len) {
+    return (PgString){.data = s.data, .len = len};
+  }
+
+  PgString rest = PG_SLICE_RANGE_START(s, read);
+  PgString res = pg_string_make(len + rest.len + rest.len / 5, allocator);
+  pg_memcpy(res.data, s.data, len);
+  res.len = len + pg_html_decode_entities_to(rest, res.data + len,
+                                             res.len - len, false, &read);
+  PG_ASSERT(read == rest.len);
+  return res;
+}
+
+[[nodiscard]] static PgHtmlTokenizer
+pg_html_tokenizer_make_from_string(PgString s) {
+  PgHtmlTokenizer res = {0};
+  res.buf.data = s.data;
+  res.buf.len = s.len;
+  res.buf.cap = s.len;
+  res.eof = true;
+  return res;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgHtmlTokenizer
+pg_html_tokenizer_make_from_reader(PgReader *reader, u64 chunk_size,
+                                   PgAllocator *allocator) {
+  PG_ASSERT(reader);
+  PG_ASSERT(chunk_size > 0);
+
+  PgHtmlTokenizer res = {0};
+  res.reader = reader;
+  res.allocator = allocator;
+  res.chunk_size = chunk_size;
+  return res;
+}
+
+[[maybe_unused]] static void
+pg_html_tokenizer_release(PgHtmlTokenizer *t) {
+  if (t->reader && t->buf.data) {
+    pg_free(t->allocator, t->buf.data);
+  }
+  *t = (PgHtmlTokenizer){0};
+}
+
+// Read one more chunk after the pending token, first moving it to the front
+// of the buffer. A read of 0 bytes is treated as the end of the stream.
+[[nodiscard]] static PgError pg_html_tokenizer_fill(PgHtmlTokenizer *t) {
+  PG_ASSERT(t->reader);
+  PG_ASSERT(!t->eof);
+
+  if (t->pos > 0) {
+    u64 pending = t->buf.len - t->pos;
+    pg_memmove(t->buf.data, t->buf.data + t->pos, pending);
+    t->buf.len = pending;
+    t->offset += t->pos;
+    t->pos = 0;
+  }
+
+  PG_DYN_ENSURE_CAP(&t->buf, t->buf.len + t->chunk_size, t->allocator);
+  PG_SLICE(u8) space = PG_DYN_SPACE(PG_SLICE(u8), &t->buf);
+
+  PG_RESULT(u64, PgError) res = pg_reader_read_slice(t->reader, space);
+  PG_IF_LET_ERR(err, res) {
+    if (PG_ERR_EOF == err) {
+      t->eof = true;
+      return 0;
+    }
+    return err;
+  }
+
+  u64 n = PG_UNWRAP(res);
+  t->buf.len += n;
+  t->eof = 0 == n;
+  return 0;
+}
+
+// Index of the first `<` in `rest`, or `rest.len`.
+[[nodiscard]] static u64 pg_html_tokenizer_scan_text_end(PgHtmlTokenizer *t,
+                                                         PgString rest) {
+  u64 i = t->scanned;
+  for (;;) {
+    i = pg_escape_scan(rest, i, PG_ESCAPE_KIND_HTML);
+    if (i == rest.len || '<' == PG_SLICE_AT(rest, i)) {
+      break;
+    }
+    t->text_has_ampersand |= '&' == PG_SLICE_AT(rest, i);
+    i += 1;
+  }
+
+  t->scanned = i;
+  return i;
+}
+
+// Index of the `>` ending the tag in `rest`, ignoring those in quoted
+// attribute values, or `rest.len`.
+[[nodiscard]] static u64 pg_html_tokenizer_scan_tag_end(PgHtmlTokenizer *t,
+                                                        PgString rest,
+                                                        u64 start) {
+  u64 i = PG_MAX(start, t->scanned);
+  for (;;) {
+    i = pg_escape_scan(rest, i, PG_ESCAPE_KIND_HTML);
+    if (i == rest.len) {
+      break;
+    }
+
+    u8 c = PG_SLICE_AT(rest, i);
+    if (t->quote) {
+      t->quote = (c == t->quote) ? 0 : t->quote;
+    } else if ('"' == c || '\'' == c) {
+      t->quote = c;
+    } else if ('>' == c) {
+      break;
+    }
+    i += 1;
+  }
+
+  t->scanned = i;
+  return i;
+}
+
+// Index of the `>` of the first `-->` in `rest` after the `<!--` opening, or
+// `rest.len`.
+[[nodiscard]] static u64 pg_html_tokenizer_scan_comment_end(PgHtmlTokenizer *t,
+                                                            PgString rest) {
+  u64 i = PG_MAX(PG_S("<!--").len, t->scanned);
+  for (;;) {
+    i = pg_escape_scan(rest, i, PG_ESCAPE_KIND_HTML);
+    if (i == rest.len) {
+      break;
+    }
+
+    if ('>' == PG_SLICE_AT(rest, i) && i >= PG_S("<!----").len &&
+        '-' == PG_SLICE_AT(rest, i - 1) && '-' == PG_SLICE_AT(rest, i - 2)) {
+      break;
+    }
+    i += 1;
+  }
+
+  t->scanned = i;
+  return i;
+}
+
+// Tokenize the markup (`<!...`) at the start of `rest`.
+[[nodiscard]] static PgError
+pg_html_tokenizer_try_markup(PgHtmlTokenizer *t, PgString rest,
+                             PgHtmlToken *token, u64 *consumed) {
+  PgString doctype = PG_S("<!DOCTYPE");
+  if (rest.len < doctype.len && !t->eof) {
+    return PG_ERR_EAGAIN;
+  }
+
+  u64 base = t->offset + t->pos;
+
+  if (pg_string_starts_with(rest, PG_S("<!--"))) {
+    u64 end = pg_html_tokenizer_scan_comment_end(t, rest);
+    if (end == rest.len) {
+      return t->eof ? PG_HTML_PARSE_ERROR_EOF_IN_COMMENT : PG_ERR_EAGAIN;
+    }
+
+    // FIXME: More complicated than that in the spec.
+    u64 start = PG_S("<!--").len;
+    token->kind = PG_HTML_TOKEN_KIND_COMMENT;
+    token->start = (u32)(base + start);
+    token->end = (u32)(base + end - 2);
+    token->comment =
+        pg_string_trim_space(PG_SLICE_RANGE(rest, start, end - 2));
+    *consumed = end + 1;
+    return 0;
+  }
+
+  u64 end = pg_html_tokenizer_scan_tag_end(t, rest, PG_S("<!").len);
+  bool is_doctype =
+      rest.len >= doctype.len &&
+      pg_string_ieq_ascii(PG_SLICE_RANGE(rest, 0, doctype.len), doctype);
+
+  if (end == rest.len) {
+    if (!t->eof) {
+      return PG_ERR_EAGAIN;
+    }
+    return is_doctype ? PG_HTML_PARSE_ERROR_EOF_IN_DOCTYPE
+                      : PG_HTML_PARSE_ERROR_EOF_IN_COMMENT;
+  }
+  *consumed = end + 1;
+
+  // Bogus comment e.g. `<![CDATA[...]]>`.
+  if (!is_doctype) {
+    token->kind = PG_HTML_TOKEN_KIND_COMMENT;
+    token->start = (u32)(base + PG_S("<!").len);
+    token->end = (u32)(base + end);
+    token->comment =
+        pg_string_trim_space(PG_SLICE_RANGE(rest, PG_S("<!").len, end));
+    return 0;
+  }
+
+  u64 i = doctype.len;
+  if (i == end || !pg_rune_ascii_is_space(PG_SLICE_AT(rest, i))) {
+    return PG_HTML_PARSE_ERROR_MISSING_WHITESPACE_BEFORE_DOCTYPE_NAME;
+  }
+  for (; i < end && pg_rune_ascii_is_space(PG_SLICE_AT(rest, i)); i++) {
+  }
+  if (i == end) {
+    return PG_HTML_PARSE_ERROR_MISSING_DOCTYPE_NAME;
+  }
+
+  u64 name_start = i;
+  for (; i < end && !pg_rune_ascii_is_space(PG_SLICE_AT(rest, i)); i++) {
+  }
+
+  token->kind = PG_HTML_TOKEN_KIND_DOCTYPE;
+  token->start = (u32)(base + name_start);
+  token->end = (u32)(base + i);
+  token->doctype = PG_SLICE_RANGE(rest, name_start, i);
+  return 0;
+}
+
+// Tokenize the tag at the start of `rest`.
+[[nodiscard]] static PgError pg_html_tokenizer_try_tag(PgHtmlTokenizer *t,
+                                                       PgString rest,
+                                                       PgHtmlToken *token,
+                                                       u64 *consumed) {
+  PG_ASSERT('<' == PG_SLICE_AT(rest, 0));
+
+  if (rest.len < 2 && !t->eof) {
+    return PG_ERR_EAGAIN;
+  }
+  if (rest.len >= 2 && '!' == PG_SLICE_AT(rest, 1)) {
+    return pg_html_tokenizer_try_markup(t, rest, token, consumed);
+  }
+
+  u64 name_start = 1;
+  token->kind = PG_HTML_TOKEN_KIND_TAG_OPENING;
+  if (rest.len >= 2 && '/' == PG_SLICE_AT(rest, 1)) {
+    name_start = 2;
+    token->kind = PG_HTML_TOKEN_KIND_TAG_CLOSING;
+  }
+
+  if (rest.len <= name_start) {
+    return t->eof ? PG_HTML_PARSE_ERROR_INVALID_FIRST_CHARACTER_OF_TAG_NAME
+                  : PG_ERR_EAGAIN;
+  }
+  if (!pg_rune_ascii_is_alphabetical(PG_SLICE_AT(rest, name_start))) {
+    return PG_HTML_PARSE_ERROR_INVALID_FIRST_CHARACTER_OF_TAG_NAME;
+  }
+
+  u64 end = pg_html_tokenizer_scan_tag_end(t, rest, name_start);
+  if (end == rest.len) {
+    return t->eof ? PG_HTML_PARSE_ERROR_EOF_IN_TAG : PG_ERR_EAGAIN;
+  }
+
+  u64 name_end = name_start;
+  for (; name_end < end && !pg_rune_ascii_is_space(PG_SLICE_AT(rest, name_end));
+       name_end++) {
+  }
+
+  u64 base = t->offset + t->pos;
+  token->start = (u32)(base + name_start);
+  token->end = (u32)(base + name_end);
+  token->tag = pg_string_trim_right(
+      pg_string_trim_space(PG_SLICE_RANGE(rest, name_start, name_end)), '/');
+  *consumed = end + 1;
+  return 0;
+}
+
+// Tokenize the token at the start of `rest`. Returns `PG_ERR_EAGAIN` if it is
+// not fully buffered yet. Blank text is consumed without producing a token.
+[[nodiscard]] static PgError pg_html_tokenizer_try(PgHtmlTokenizer *t,
+                                                   PgString rest,
+                                                   PgHtmlToken *token,
+                                                   u64 *consumed) {
+  if (pg_string_is_empty(rest)) {
+    return t->eof ? 0 : PG_ERR_EAGAIN;
+  }
+
+  if ('<' == PG_SLICE_AT(rest, 0)) {
+    return pg_html_tokenizer_try_tag(t, rest, token, consumed);
+  }
+
+  u64 end = pg_html_tokenizer_scan_text_end(t, rest);
+  if (end == rest.len && !t->eof) {
+    return PG_ERR_EAGAIN;
+  }
+
+  PgString text = PG_SLICE_RANGE(rest, 0, end);
+  *consumed = end;
+  if (pg_string_is_empty(pg_string_trim_space(text))) {
+    return 0;
+  }
+
+  u64 base = t->offset + t->pos;
+  token->kind = PG_HTML_TOKEN_KIND_TEXT;
+  token->start = (u32)base;
+  token->end = (u32)(base + end);
+  token->text = text;
+
+  if (t->text_has_ampersand && t->reader) { // We own the buffer.
+    token->text = pg_html_decode_entities_in_place(text, t->allocator);
+  } else if (t->text_has_ampersand && t->allocator) {
+    token->text = pg_html_decode_entities(text, t->allocator);
+  }
+  return 0;
+}
+
+// Next token, or a token of kind `PG_HTML_TOKEN_KIND_NONE` at the end of the
+// input.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHtmlToken, PgError)
+    pg_html_tokenizer_next(PgHtmlTokenizer *t) {
+  for (;;) {
+    PgHtmlToken token = {0};
+    u64 consumed = 0;
+    PgString rest =
+        PG_SLICE_RANGE_START(PG_DYN_TO_SLICE(PgString, t->buf), t->pos);
+    PgError err = pg_html_tokenizer_try(t, rest, &token, &consumed);
+
+    if (PG_ERR_EAGAIN == err) {
+      err = pg_html_tokenizer_fill(t);
+      if (err) {
+        return PG_ERR(err, PgHtmlToken, PgError);
+      }
+      continue;
+    }
+    if (err) {
+      return PG_ERR(err, PgHtmlToken, PgError);
+    }
+
+    t->pos += consumed;
+    t->scanned = 0;
+    t->quote = 0;
+    t->text_has_ampersand = false;
+
+    if (PG_HTML_TOKEN_KIND_NONE == token.kind && consumed > 0) { // Blank.
+      continue;
+    }
+    return PG_OK(token, PgHtmlToken, PgError);
+  }
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_DYN(PgHtmlToken), PgError)
+    pg_html_tokenize(PgString s, PgAllocator *allocator) {
+  PG_DYN(PgHtmlToken) res = {0};
+  PG_DYN_ENSURE_CAP(&res, s.len / 8, allocator);
+
+  PgHtmlTokenizer tokenizer = pg_html_tokenizer_make_from_string(s);
+  tokenizer.allocator = allocator;
+  for (;;) {
+    PG_RESULT(PgHtmlToken, PgError) res_token =
+        pg_html_tokenizer_next(&tokenizer);
+    PG_IF_LET_ERR(err, res_token) {
+      return PG_ERR(err, PG_DYN(PgHtmlToken), PgError);
+    }
+
+    PgHtmlToken token = PG_UNWRAP(res_token);
+    if (PG_HTML_TOKEN_KIND_NONE == token.kind) {
+      return PG_OK(res, PG_DYN(PgHtmlToken), PgError);
+    }
+    PG_DYN_PUSH(&res, token, allocator);
+  }
+}
+
+[[maybe_unused]] static void pg_linked_list_init(PgLinkedListNode *node) {
+  PG_ASSERT(node);
+  node->next = node;
+}
+
+[[nodiscard]]
+static bool pg_linked_list_is_empty(PgLinkedListNode *node) {
+  PG_ASSERT(node);
+  return node->next == node;
+}
+
+[[maybe_unused]] [[nodiscard]]
+static PgLinkedListNode *pg_linked_list_tail(PgLinkedListNode *node) {
+  PG_ASSERT(node);
+  PgLinkedListNode *it = node;
+  for (; !pg_linked_list_is_empty(it); it = it->next) {
+  }
+  PG_ASSERT(it);
+  return it;
+}
+
+[[maybe_unused]] static void pg_linked_list_append(PgLinkedListNode *head,
+                                                   PgLinkedListNode *elem) {
+  PG_ASSERT(head);
+  PG_ASSERT(elem);
+
+  pg_linked_list_tail(head)->next = elem;
+}
+
+[[nodiscard]] static PgHtmlNode *pg_html_node_get_parent(PgHtmlNode *node) {
+  PgLinkedListNode *linked_list_node = node->parent.next;
+  return PG_CONTAINER_OF(linked_list_node, PgHtmlNode, parent);
+}
+
+[[nodiscard]] static PgHtmlNode *
+pg_html_node_get_first_child(PgHtmlNode *node) {
+  PgLinkedListNode *linked_list_node = node->first_child.next;
+  return PG_CONTAINER_OF(linked_list_node, PgHtmlNode, first_child);
+}
+
+[[maybe_unused]] [[nodiscard]] static PgHtmlNode *
+pg_html_node_get_next_sibling(PgHtmlNode *node) {
+  PgLinkedListNode *linked_list_node = node->next_sibling.next;
+  return PG_CONTAINER_OF(linked_list_node, PgHtmlNode, next_sibling);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHtmlNodePtr, PgError)
+    pg_html_parse(PgString s, PgAllocator *allocator) {
+  PgHtmlNode *root =
+      pg_alloc(allocator, sizeof(PgHtmlNode), _Alignof(PgHtmlNode), 1);
+  pg_linked_list_init(&root->parent);
+  pg_linked_list_init(&root->first_child);
+  pg_linked_list_init(&root->next_sibling);
+
+  PgHtmlNode *parent = root;
+
+  PgHtmlTokenizer tokenizer = pg_html_tokenizer_make_from_string(s);
+  tokenizer.allocator = allocator;
+  for (;;) {
+    PG_RESULT(PgHtmlToken, PgError) res_token =
+        pg_html_tokenizer_next(&tokenizer);
+    PG_IF_LET_ERR(err, res_token) {
+      return PG_ERR(err, PgHtmlNodePtr, PgError);
+    }
+    PgHtmlToken token = PG_UNWRAP(res_token);
+    if (PG_HTML_TOKEN_KIND_NONE == token.kind) {
+      break;
+    }
+    PG_ASSERT(parent);
+
+    bool is_self_closing = ((PG_HTML_TOKEN_KIND_TAG_OPENING == token.kind) ||
+                            PG_HTML_TOKEN_KIND_TAG_CLOSING == token.kind) &&
+                           (pg_html_tag_is_self_closing(token.tag) ||
+                            pg_svg_tag_is_self_closing(token.tag));
+
+    if (PG_HTML_TOKEN_KIND_TEXT == token.kind ||
+        PG_HTML_TOKEN_KIND_COMMENT == token.kind ||
+        PG_HTML_TOKEN_KIND_DOCTYPE == token.kind || is_self_closing) {
+      PgHtmlNode *node =
+          pg_alloc(allocator, sizeof(PgHtmlNode), _Alignof(PgHtmlNode), 1);
+      pg_linked_list_init(&node->parent);
+      pg_linked_list_init(&node->first_child);
+      pg_linked_list_init(&node->next_sibling);
+      node->token_start = node->token_end = token;
+      node->parent.next = &parent->parent;
+
+      PgLinkedListNode *first_child_of_parent = &parent->first_child;
+      if (pg_linked_list_is_empty(first_child_of_parent)) {
+        first_child_of_parent->next = &node->first_child;
+      } else {
+        PgLinkedListNode *next_sibling_of_first_child_of_parent =
+            &pg_html_node_get_first_child(parent)->next_sibling;
+        pg_linked_list_append(next_sibling_of_first_child_of_parent,
+                              &node->next_sibling);
+      }
+    } else if (PG_HTML_TOKEN_KIND_TAG_OPENING == token.kind) {
+      PgHtmlNode *node =
+          pg_alloc(allocator, sizeof(PgHtmlNode), _Alignof(PgHtmlNode), 1);
+      pg_linked_list_init(&node->parent);
+      pg_linked_list_init(&node->first_child);
+      pg_linked_list_init(&node->next_sibling);
+      node->token_start = node->token_end = token;
+      node->parent.next = &parent->parent;
+
+      PgLinkedListNode *first_child_of_parent = &parent->first_child;
+      if (pg_linked_list_is_empty(first_child_of_parent)) {
+        first_child_of_parent->next = &node->first_child;
+      } else {
+        PgLinkedListNode *next_sibling_of_first_child_of_parent =
+            &pg_html_node_get_first_child(parent)->next_sibling;
+        pg_linked_list_append(next_sibling_of_first_child_of_parent,
+                              &node->next_sibling);
+      }
+
+      if (!is_self_closing) {
+        parent = node;
+      }
+    } else if (PG_HTML_TOKEN_KIND_TAG_CLOSING == token.kind) {
+      PG_ASSERT(PG_HTML_TOKEN_KIND_TAG_OPENING == parent->token_start.kind &&
+                pg_string_eq(parent->token_start.tag, token.tag));
+      parent->token_end = token;
+
+      parent = pg_html_node_get_parent(parent);
+    } else {
+      PG_ASSERT(0 && "todo");
+    }
+  }
+
+  // All tags correctly closed.
+  PG_ASSERT(parent == root);
+
+  PG_ASSERT(pg_linked_list_is_empty(&root->next_sibling));
+  PG_ASSERT(pg_linked_list_is_empty(&root->parent));
+  PG_ASSERT(root->parent.next == &root->parent);
+  return PG_OK(root, PgHtmlNodePtr, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static bool
+pg_html_node_is_title_opening(PgHtmlNode *node) {
+  return (PG_HTML_TOKEN_KIND_TAG_OPENING == node->token_start.kind) &&
+         (pg_string_eq(node->token_start.tag, PG_S("h1")) ||
+          pg_string_eq(node->token_start.tag, PG_S("h2")) ||
+          pg_string_eq(node->token_start.tag, PG_S("h3")) ||
+          pg_string_eq(node->token_start.tag, PG_S("h4")) ||
+          pg_string_eq(node->token_start.tag, PG_S("h5")) ||
+          pg_string_eq(node->token_start.tag, PG_S("h6")));
+}
+
+[[maybe_unused]] [[nodiscard]] static u8
+pg_html_node_get_title_level(PgHtmlNode *node) {
+  if (!pg_html_node_is_title_opening(node)) {
+    return 0;
+  }
+
+  PG_OPTION(PgRune) last_opt = pg_string_last(node->token_start.tag);
+  if (!last_opt.has_value) {
+    return 0;
+  }
+
+  PgRune last = last_opt.value;
+  PG_ASSERT(pg_rune_ascii_is_numeric(last));
+  return (u8)last - '0';
+}
+
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_html_node_get_simple_title_content(PgHtmlNode *node) {
+  if (!pg_html_node_is_title_opening(node)) {
+    return PG_S("");
+  }
+  PG_ASSERT(!pg_linked_list_is_empty(&node->first_child));
+  PgHtmlNode *child =
+      PG_CONTAINER_OF(node->first_child.next, PgHtmlNode, first_child);
+  PG_ASSERT(PG_HTML_TOKEN_KIND_TEXT == child->token_start.kind);
+  PgString res = child->token_start.text;
+
+  PG_ASSERT(!pg_string_is_empty(res));
+  return res;
+}
+
+// Find the interned tag `name`, interning it first if `allocator` is set.
+[[maybe_unused]] [[nodiscard]] static PgHtmlTag *
+pg_html_dom_tag_upsert(PgHtmlDom *dom, PgString name, PgAllocator *allocator) {
+  PgHtmlTag **htrie = &dom->tags_htrie;
+  for (u64 h = pg_hash_fnv(name); *htrie; h <<= 2) {
+    if (pg_string_eq(name, (*htrie)->name)) {
+      return *htrie;
+    }
+    htrie = &(*htrie)->child[h >> 62];
+  }
+  if (!allocator) {
+    return nullptr;
+  }
+
+  if (0 == dom->tags.len) {
+    PG_DYN_PUSH(&dom->tags, nullptr, allocator);
+  }
+
+  PgHtmlTag *tag = PG_NEW(PgHtmlTag, allocator);
+  tag->name = name;
+  tag->id = (u32)dom->tags.len;
+  tag->self_closing =
+      pg_html_tag_is_self_closing(name) || pg_svg_tag_is_self_closing(name);
+  PG_DYN_PUSH(&dom->tags, tag, allocator);
+
+  *htrie = tag;
+  return tag;
+}
+
+// Interned id of the tag `name`, or 0 if no element has this tag.
+[[maybe_unused]] [[nodiscard]] static u32 pg_html_dom_tag_id(PgHtmlDom *dom,
+                                                             PgString name) {
+  PgHtmlTag *tag = pg_html_dom_tag_upsert(dom, name, nullptr);
+  return tag ? tag->id : 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_html_dom_node_tag(PgHtmlDom *dom, u32 idx) {
+  u32 tag = PG_SLICE_AT(dom->nodes, idx).tag;
+  return tag ? PG_SLICE_AT(dom->tags, tag)->name : PG_S("");
+}
+
+// Raw source of the node's token e.g. the text, which is not trimmed.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_html_dom_node_source(PgHtmlDom *dom, u32 idx) {
+  PgHtmlDomNode node = PG_SLICE_AT(dom->nodes, idx);
+  return PG_SLICE_RANGE(dom->source, node.start, node.end);
+}
+
+// Text of a text node, with its character references decoded.
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_html_dom_node_text(PgHtmlDom *dom, u32 idx, PgAllocator *allocator) {
+  PG_ASSERT(PG_HTML_TOKEN_KIND_TEXT == PG_SLICE_AT(dom->nodes, idx).kind);
+  return pg_html_decode_entities(pg_html_dom_node_source(dom, idx), allocator);
+}
+
+// Index one past the last descendant of the node: its descendants are the
+// nodes in `[idx+1, end)`.
+[[maybe_unused]] [[nodiscard]] static u32
+pg_html_dom_subtree_end(PgHtmlDom *dom, u32 idx) {
+  for (u32 i = idx; i; i = PG_SLICE_AT(dom->nodes, i).parent) {
+    u32 next = PG_SLICE_AT(dom->nodes, i).next_sibling;
+    if (next) {
+      return next;
+    }
+  }
+  return (u32)dom->nodes.len;
+}
+
+// Index of the first element at or after `from` in document order with the
+// interned tag `tag`, or 0.
+[[maybe_unused]] [[nodiscard]] static u32
+pg_html_dom_find_tag(PgHtmlDom *dom, u32 from, u32 tag) {
+  if (0 == tag) {
+    return 0;
+  }
+
+  for (u32 i = PG_MAX(from, 1); i < dom->nodes.len; i++) {
+    if (tag == PG_SLICE_AT(dom->nodes, i).tag) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+static void pg_html_dom_append_child(PgHtmlDom *dom, u32 parent, u32 idx) {
+  PgHtmlDomNode *p = PG_SLICE_AT_PTR(&dom->nodes, parent);
+  if (p->last_child) {
+    PG_SLICE_AT_PTR(&dom->nodes, p->last_child)->next_sibling = idx;
+  } else {
+    p->first_child = idx;
+  }
+  p->last_child = idx;
+}
+
+// Build the DOM in one pass over the tokens. Unlike `pg_html_parse`, a stray
+// closing tag is ignored, and a closing tag closes all the elements opened
+// since the matching opening tag.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHtmlDom, PgError)
+    pg_html_dom_parse(PgString s, PgAllocator *allocator) {
+  PgHtmlDom dom = {.source = s};
+  PG_DYN_ENSURE_CAP(&dom.nodes, s.len / 16 + 1, allocator);
+  PG_DYN_PUSH(&dom.nodes, ((PgHtmlDomNode){0}), allocator); // Root.
+
+  u32 parent = 0;
+  PgHtmlTokenizer tokenizer = pg_html_tokenizer_make_from_string(s);
+  for (;;) {
+    PG_RESULT(PgHtmlToken, PgError) res_token =
+        pg_html_tokenizer_next(&tokenizer);
+    PG_IF_LET_ERR(err, res_token) { return PG_ERR(err, PgHtmlDom, PgError); }
+
+    PgHtmlToken token = PG_UNWRAP(res_token);
+    if (PG_HTML_TOKEN_KIND_NONE == token.kind) {
+      return PG_OK(dom, PgHtmlDom, PgError);
+    }
+
+    if (PG_HTML_TOKEN_KIND_TAG_CLOSING == token.kind) {
+      PgHtmlTag *tag = pg_html_dom_tag_upsert(&dom, token.tag, nullptr);
+      if (!tag || tag->self_closing) {
+        continue;
+      }
+
+      for (u32 i = parent; i; i = PG_SLICE_AT(dom.nodes, i).parent) {
+        if (tag->id == PG_SLICE_AT(dom.nodes, i).tag) {
+          parent = PG_SLICE_AT(dom.nodes, i).parent;
+          break;
+        }
+      }
+      continue;
+    }
+
+    PgHtmlDomNode node = {
+        .parent = parent,
+        .start = token.start,
+        .end = token.end,
+        .kind = token.kind,
+    };
+    bool is_open_element = false;
+    if (PG_HTML_TOKEN_KIND_TAG_OPENING == token.kind) {
+      PgHtmlTag *tag = pg_html_dom_tag_upsert(&dom, token.tag, allocator);
+      node.tag = tag->id;
+      is_open_element = !tag->self_closing;
+    }
+
+    u32 idx = (u32)dom.nodes.len;
+    PG_DYN_PUSH(&dom.nodes, node, allocator);
+    pg_html_dom_append_child(&dom, parent, idx);
+
+    if (is_open_element) {
+      parent = idx;
+    }
+  }
+}
+
+// Caller is responsible for proper locking.
+[[maybe_unused]] [[nodiscard]]
+static PgThreadPoolTask *pg_thread_pool_dequeue_task(PgThreadPool *pool) {
+  PG_ASSERT(pool);
+  PG_ASSERT(pool->tasks);
+  PgThreadPoolTask *res = pool->tasks;
+  pool->tasks = pool->tasks->next;
+  return res;
+}
+
+static i32 pg_pool_worker_start_fn(void *data) {
+  PG_ASSERT(data);
+  PgThreadPool *pool = data;
+
+  for (;;) {
+    PG_ASSERT(0 == pg_mtx_lock(&pool->tasks_mtx));
+    while (!pool->tasks) {
+      if (pool->done) {
+        PG_ASSERT(0 == pg_mtx_unlock(&pool->tasks_mtx));
+        return 0;
+      }
+
+      PG_ASSERT(0 == pg_cnd_wait(&pool->tasks_cnd, &pool->tasks_mtx));
+    }
+
+    PgThreadPoolTask *task = pg_thread_pool_dequeue_task(pool);
+    PG_ASSERT(0 == pg_mtx_unlock(&pool->tasks_mtx));
+
+    PG_ASSERT(task);
+    PG_ASSERT(task->fn);
+
+    (void)task->fn(task->data);
+  }
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgThreadPool, PgError)
+    pg_thread_pool_make(u32 size, PgAllocator *allocator) {
+  PgThreadPool res = {0};
+
+  if (0 != pg_mtx_init(&res.tasks_mtx, PG_MUTEX_KIND_PLAIN)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgThreadPool, PgError);
+  }
+
+  if (0 != pg_cnd_init(&res.tasks_cnd)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgThreadPool, PgError);
+  }
+
+  res.workers.len = size;
+  res.workers.data =
+      pg_alloc(allocator, sizeof(PgThread), _Alignof(PgThread), size);
+
+  PG_EACH_PTR(it, &res.workers) {
+    PG_RESULT(PgThread, PgError)
+    res_thread = pg_thread_create(pg_pool_worker_start_fn, it);
+
+    PG_IF_LET_ERR(err, res_thread) {
+      return PG_ERR(err, PgThreadPool, PgError);
+    }
+
+    *it = PG_UNWRAP(res_thread);
+  }
+
+  return PG_OK(res, PgThreadPool, PgError);
+}
+
+[[maybe_unused]]
+static void pg_thread_pool_enqueue_task(PgThreadPool *pool, PgThreadFn fn,
+                                        void *data, PgAllocator *allocator) {
+  PG_ASSERT(pool);
+  PG_ASSERT(fn);
+  PG_ASSERT(data);
+  PG_ASSERT(allocator);
+
+  PgThreadPoolTask *task = PG_NEW(PgThreadPoolTask, allocator);
+  task->data = data;
+  task->fn = fn;
+
+  PG_ASSERT(0 == pg_mtx_lock(&pool->tasks_mtx));
+  if (!pool->tasks) {
+    pool->tasks = task;
+  } else {
+    task->next = pool->tasks;
+    pool->tasks = task;
+  }
+  PG_ASSERT(0 == pg_cnd_signal(&pool->tasks_cnd));
+  PG_ASSERT(0 == pg_mtx_unlock(&pool->tasks_mtx));
+}
+
+[[maybe_unused]] static void pg_thread_pool_wait(PgThreadPool *pool) {
+  PG_ASSERT(0 == pg_mtx_lock(&pool->tasks_mtx));
+  pool->done = true;
+  PG_ASSERT(0 == pg_cnd_broadcast(&pool->tasks_cnd));
+  PG_ASSERT(0 == pg_mtx_unlock(&pool->tasks_mtx));
+
+  PG_EACH_PTR(w, &pool->workers) { (void)pg_thread_join(*w); }
+}
+
+[[maybe_unused]] [[nodiscard]] static PgElfSymbolType
+pg_elf_symbol_get_type(PgElfSymbolTableEntry sym) {
+  return sym.info & 0xf;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgElfSymbolBind
+pg_elf_symbol_get_bind(PgElfSymbolTableEntry sym) {
+  return sym.info >> 4;
+}
+
+[[nodiscard]] static PG_RESULT(PG_SLICE(u8), PgError)
+    pg_elf_get_section_header_bytes(PgElf elf, u32 section_idx) {
+  if (section_idx >= elf.section_headers.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+  }
+
+  PgElfSectionHeader section = PG_SLICE_AT(elf.section_headers, section_idx);
+
+  u64 end = 0;
+  if (__builtin_add_overflow(section.offset, section.size, &end)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+  }
+
+  if (end >= elf.bytes.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+  }
+
+  return PG_OK(PG_SLICE_RANGE(elf.bytes, section.offset, end), PG_SLICE(u8),
+               PgError);
+}
+
+[[nodiscard]] static PG_RESULT(PgString, PgError)
+    pg_elf_get_sh_string_at(PgElf elf, u32 offset) {
+  PG_SLICE(u8)
+  bytes = PG_TRY(pg_elf_get_section_header_bytes(
+                     elf, elf.header.section_header_shstrtab_index),
+                 PgString, PgError);
+
+  if (offset >= bytes.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgString, PgError);
+  }
+
+  PG_SLICE(u8) at = PG_SLICE_RANGE_START(bytes, offset);
+  PG_OPTION(PgString) s = pg_str0_to_string(at);
+
+  if (!s.has_value) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgString, PgError);
+  }
+
+  return PG_OK(s.value, PgString, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
+    pg_elf_get_string_at(PgElf elf, u32 offset) {
+  PG_SLICE(u8)
+  bytes = PG_TRY(
+      pg_elf_get_section_header_bytes(elf, elf.section_header_strtab_idx),
+      PgString, PgError);
+
+  if (offset >= bytes.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgString, PgError);
+  }
+
+  PG_SLICE(u8) at = PG_SLICE_RANGE_START(bytes, offset);
+
+  PgBytesCut cut = pg_bytes_cut_byte(at, 0);
+  if (!cut.has_value) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgString, PgError);
+  }
+
+  return PG_OK(cut.left, PgString, PgError);
+}
+
+[[nodiscard]] static PgElfSectionHeader *
+pg_elf_section_header_find_ptr_by_name_and_kind(PgElf *elf, PgString name,
+                                                PgElfSectionHeaderKind kind) {
+  PG_ASSERT(elf);
+
+  PG_EACH_PTR(section, &elf->section_headers) {
+    if (kind != section->kind) {
+      continue;
+    }
+
+    PG_RESULT(PgString, PgError)
+    res_str = pg_elf_get_sh_string_at(*elf, section->name);
+    if (PG_IS_ERR(res_str)) {
+      continue;
+    }
+
+    PgString value = PG_UNWRAP(res_str);
+    if (!pg_string_eq(value, name)) {
+      continue;
+    }
+
+    return section;
+  }
+  return nullptr;
+}
+
+[[nodiscard]] static PG_RESULT(PG_SLICE(u8), PgError)
+    pg_elf_section_header_find_bytes_by_name_and_kind(
+        PgElf elf, PgString name, PgElfSectionHeaderKind kind) {
+  PG_RESULT(PG_SLICE(u8), PgError) res = {0};
+
+  PgElfSectionHeader *section_header =
+      pg_elf_section_header_find_ptr_by_name_and_kind(&elf, name, kind);
+
+  if (!section_header) {
+    return res;
+  }
+
+  u64 section_idx = section_header - elf.section_headers.data;
+  return pg_elf_get_section_header_bytes(elf, section_idx);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgElf, PgError)
+    pg_elf_parse(PG_SLICE(u8) elf_bytes) {
+  PgElf res = {0};
+  res.bytes = elf_bytes;
+
+  if (elf_bytes.len < sizeof(PgElfHeader)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgElf, PgError);
+  }
+  pg_memcpy(&res.header, elf_bytes.data, sizeof(res.header));
+
+  // Section headers.
+  {
+    PgElfHeader h = res.header;
+    u64 section_headers_size = 0;
+    if (__builtin_mul_overflow(h.section_header_entries_count,
+                               h.section_header_entry_size,
+                               &section_headers_size)) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgElf, PgError);
+    }
+
+    u64 section_headers_end = 0;
+    if (__builtin_add_overflow(h.section_header_offset, section_headers_size,
+                               &section_headers_end)) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgElf, PgError);
+    }
+    PG_ASSERT(h.section_header_offset <= section_headers_end);
+
+    PG_SLICE(u8)
+    section_headers_bytes =
+        PG_SLICE_RANGE(elf_bytes, h.section_header_offset, section_headers_end);
+    res.section_headers = (PG_DYN(PgElfSectionHeader)){
+        .data = (void *)section_headers_bytes.data,
+        .len = h.section_header_entries_count,
+        .cap = h.section_header_entries_count,
+    };
+
+    PgElfSectionHeader *section_text =
+        pg_elf_section_header_find_ptr_by_name_and_kind(
+            &res, PG_S(".text"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
+    if (section_text) {
+      u32 idx = section_text - res.section_headers.data;
+      res.section_header_text_idx = idx;
+    }
+  }
+
+  return PG_OK(res, PgElf, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_SLICE(u8), PgError)
+    pg_elf_symbol_get_program_text(PgElf elf, PgElfSymbolTableEntry sym) {
+  if (elf.section_header_text_idx != sym.section_header_table_index) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+  }
+
+  PG_SLICE(u8)
+  bytes =
+      PG_TRY(pg_elf_get_section_header_bytes(elf, elf.section_header_text_idx),
+             PG_SLICE(u8), PgError);
+
+  if (sym.value >= bytes.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+  }
+
+  u64 end = 0;
+  if (__builtin_add_overflow(sym.value, sym.size, &end)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_SLICE(u8), PgError);
+  }
+
+  return PG_OK(PG_SLICE_RANGE(bytes, sym.value, end), PG_SLICE(u8), PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PgTimerWheel *
+pg_timer_wheel_make(u64 tick_ns, u64 now_ns, PgAllocator *allocator) {
+  PG_ASSERT(tick_ns > 0);
+
+  PgTimerWheel *wheel = PG_NEW(PgTimerWheel, allocator);
+  wheel->tick_ns = tick_ns;
+  wheel->tick = now_ns / tick_ns;
+  return wheel;
+}
+
+[[maybe_unused]] [[nodiscard]] static bool pg_timer_is_armed(PgTimer *timer) {
+  return nullptr != timer->pprev;
+}
+
+static void pg_timer_list_push(PgTimer **head, PgTimer *timer) {
+  timer->next = *head;
+  if (*head) {
+    (*head)->pprev = &timer->next;
+  }
+  timer->pprev = head;
+  *head = timer;
+}
+
+static void pg_timer_list_remove(PgTimer *timer) {
+  *timer->pprev = timer->next;
+  if (timer->next) {
+    timer->next->pprev = timer->pprev;
+  }
+  timer->next = nullptr;
+  timer->pprev = nullptr;
+}
+
+static void pg_timer_wheel_place(PgTimerWheel *wheel, PgTimer *timer) {
+  // Rounded up so that a timer never expires early.
+  u64 expires = timer->deadline_ns / wheel->tick_ns +
+                (0 != timer->deadline_ns % wheel->tick_ns);
+  expires = PG_MAX(expires, wheel->tick);
+
+  for (u64 level = 0; level < PG_TIMER_WHEEL_LEVELS; level++) {
+    u64 shift = (level + 1) * PG_TIMER_WHEEL_SLOTS_BITS;
+    if ((expires >> shift) != (wheel->tick >> shift)) {
+      continue;
+    }
+
+    u64 slot = (expires >> (level * PG_TIMER_WHEEL_SLOTS_BITS)) &
+               (PG_TIMER_WHEEL_SLOTS - 1);
+    pg_timer_list_push(&wheel->slots[level][slot], timer);
+    wheel->occupied[level][slot / 64] |= 1ULL << (slot % 64);
+    return;
+  }
+  pg_timer_list_push(&wheel->overflow, timer);
+}
+
+static void pg_timer_wheel_cancel(PgTimerWheel *wheel, PgTimer *timer) {
+  if (!pg_timer_is_armed(timer)) {
+    return;
+  }
+
+  pg_timer_list_remove(timer);
+  PG_ASSERT(wheel->count > 0);
+  wheel->count -= 1;
+}
+
+// Arm `timer`, or re-arm it if it is already armed. A deadline in the past
+// expires on the next call to `pg_timer_wheel_expire`.
+static void pg_timer_wheel_insert(PgTimerWheel *wheel, PgTimer *timer,
+                                  u64 deadline_ns, u64 user_data) {
+  pg_timer_wheel_cancel(wheel, timer);
+
+  timer->deadline_ns = deadline_ns;
+  timer->user_data = user_data;
+  pg_timer_wheel_place(wheel, timer);
+  wheel->count += 1;
+}
+
+// First non-empty slot of `level` from slot `from` onwards.
+[[nodiscard]] static PG_OPTION(u64)
+    pg_timer_wheel_next_occupied(PgTimerWheel *wheel, u64 level, u64 from) {
+  for (u64 word = from / 64; word < PG_TIMER_WHEEL_SLOTS / 64; word++) {
+    u64 bits = wheel->occupied[level][word];
+    if (word == from / 64) {
+      bits &= ~0ULL << (from % 64);
+    }
+
+    while (bits) {
+      u64 slot = word * 64 + (u64)__builtin_ctzll(bits);
+      if (wheel->slots[level][slot]) {
+        return PG_SOME(slot, u64);
+      }
+      // Emptied by cancellations.
+      wheel->occupied[level][word] &= ~(1ULL << (slot % 64));
+      bits &= bits - 1;
+    }
+  }
+  return PG_NONE(u64);
+}
+
+// Move the timers of a slot to the lower levels.
+static void pg_timer_wheel_cascade(PgTimerWheel *wheel, PgTimer **head) {
+  PgTimer *it = *head;
+  *head = nullptr;
+
+  while (it) {
+    PgTimer *next = it->next;
+    it->next = nullptr;
+    it->pprev = nullptr;
+    pg_timer_wheel_place(wheel, it);
+    it = next;
+  }
+}
+
+// The next tick at which `pg_timer_wheel_expire` has work to do, from
+// `wheel->tick` onwards. That is either the next expiry or, earlier, the
+// start of the block of the next timers of a higher level.
+[[nodiscard]] static PG_OPTION(u64)
+pg_timer_wheel_next_tick(PgTimerWheel *wheel) {
+  if (0 == wheel->count) {
+    return PG_NONE(u64);
+  }
+
+  for (u64 level = 0; level < PG_TIMER_WHEEL_LEVELS; level++) {
+    u64 shift = level * PG_TIMER_WHEEL_SLOTS_BITS;
+    u64 slot = (wheel->tick >> shift) & (PG_TIMER_WHEEL_SLOTS - 1);
+    // The current slot of a higher level has been moved down already,
+    // unless its block is just starting.
+    bool block_start = 0 == (wheel->tick & ((1ULL << shift) - 1));
+    u64 from = (0 == level || block_start) ? slot : slot + 1;
+
+    PG_OPTION(u64) next = pg_timer_wheel_next_occupied(wheel, level, from);
+    if (next.has_value) {
+      u64 block_shift = shift + PG_TIMER_WHEEL_SLOTS_BITS;
+      u64 block = (wheel->tick >> block_shift) << block_shift;
+      return PG_SOME(block + (next.value << shift), u64);
+    }
+  }
+
+  u64 top_shift = PG_TIMER_WHEEL_LEVELS * PG_TIMER_WHEEL_SLOTS_BITS;
+  return PG_SOME(((wheel->tick >> top_shift) + 1) << top_shift, u64);
+}
+
+// Lower bound of the next expiry, to sleep until then.
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(u64)
+    pg_timer_wheel_next_deadline_ns(PgTimerWheel *wheel) {
+  PG_OPTION(u64) tick = pg_timer_wheel_next_tick(wheel);
+  if (!tick.has_value) {
+    return PG_NONE(u64);
+  }
+  return PG_SOME(tick.value * wheel->tick_ns, u64);
+}
+
+// Expire the timers due at `now_ns`, at most as many as `events_out` holds,
+// the others being left for the next call.
+// Returns the number of expired timers.
+[[nodiscard]] static u64
+pg_timer_wheel_expire(PgTimerWheel *wheel, u64 now_ns,
+                      PG_SLICE(PgAioEvent) events_out) {
+  u64 now_tick = now_ns / wheel->tick_ns;
+  u64 res = 0;
+
+  while (res < events_out.len && wheel->tick <= now_tick) {
+    if (0 == wheel->count) {
+      wheel->tick = now_tick + 1;
+      break;
+    }
+
+    u64 tick = wheel->tick;
+    // A new block starts: move its timers down, from the top level.
+    if (0 == (tick & (PG_TIMER_WHEEL_SLOTS - 1))) {
+      u64 top_shift = PG_TIMER_WHEEL_LEVELS * PG_TIMER_WHEEL_SLOTS_BITS;
+      if (0 == (tick & ((1ULL << top_shift) - 1))) {
+        pg_timer_wheel_cascade(wheel, &wheel->overflow);
+      }
+      for (u64 level = PG_TIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+        u64 shift = level * PG_TIMER_WHEEL_SLOTS_BITS;
+        if (0 != (tick & ((1ULL << shift) - 1))) {
+          continue;
+        }
+        u64 slot = (tick >> shift) & (PG_TIMER_WHEEL_SLOTS - 1);
+        pg_timer_wheel_cascade(wheel, &wheel->slots[level][slot]);
+      }
+    }
+
+    PgTimer **head = &wheel->slots[0][tick & (PG_TIMER_WHEEL_SLOTS - 1)];
+    while (*head && res < events_out.len) {
+      PgTimer *timer = *head;
+      pg_timer_list_remove(timer);
+      wheel->count -= 1;
+
+      PG_SLICE_AT(events_out, res) = (PgAioEvent){
+          .kind = PG_AIO_EVENT_KIND_TIMER,
+          .user_data = timer->user_data,
+      };
+      res += 1;
+    }
+    if (*head) { // Out of room: resume from this tick.
+      break;
+    }
+
+    // Skip the ticks without work.
+    wheel->tick = tick + 1;
+    PG_OPTION(u64) next_tick = pg_timer_wheel_next_tick(wheel);
+    if (next_tick.has_value) {
+      wheel->tick = PG_MAX(wheel->tick, PG_MIN(next_tick.value, now_tick + 1));
+    }
+  }
+
+  return res;
+}
+
+// Enable timers on `aio`, with a resolution of `tick_ns`. They surface from
+// `pg_aio_wait` as `PG_AIO_EVENT_KIND_TIMER` events.
+[[maybe_unused]] static void
+pg_aio_timers_init(PgAio *aio, u64 tick_ns, PgAllocator *allocator) {
+  u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  aio->timers = pg_timer_wheel_make(tick_ns, now_ns, allocator);
+}
+
+// `deadline_ns` is on the monotonic clock.
+[[maybe_unused]] static void pg_aio_register_timer(PgAio aio, PgTimer *timer,
+                                                   u64 deadline_ns,
+                                                   u64 user_data) {
+  PG_ASSERT(aio.timers);
+  pg_timer_wheel_insert(aio.timers, timer, deadline_ns, user_data);
+}
+
+[[maybe_unused]] static void pg_aio_unregister_timer(PgAio aio,
+                                                     PgTimer *timer) {
+  PG_ASSERT(aio.timers);
+  pg_timer_wheel_cancel(aio.timers, timer);
+}
+
+[[nodiscard]] static u64 pg_aio_timers_expire(PgAio aio,
+                                              PG_SLICE(PgAioEvent) events_out) {
+  if (!aio.timers) {
+    return 0;
+  }
+
+  u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  return pg_timer_wheel_expire(aio.timers, now_ns, events_out);
+}
+
+[[nodiscard]] static u64 pg_aio_timers_expire_cqe(PgAio aio, PgRing *cqe) {
+  u64 res = 0;
+  for (;;) {
+    PgAioEvent events_data[64] = {0};
+    PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+    events.len = PG_MIN(events.len, pg_ring_can_write_count(*cqe) /
+                                        sizeof(PgAioEvent));
+
+    u64 count = pg_aio_timers_expire(aio, events);
+    for (u64 i = 0; i < count; i++) {
+      PG_SLICE(u8) ev_bytes = {
+          .data = (u8 *)PG_SLICE_AT_PTR(&events, i),
+          .len = sizeof(PgAioEvent),
+      };
+      PG_ASSERT(sizeof(PgAioEvent) == pg_ring_write_bytes(cqe, ev_bytes));
+    }
+    res += count;
+
+    if (count < events.len || 0 == count) {
+      return res;
+    }
+  }
+}
+
+// What remains of the caller's timeout counted from `start_ns`, but no
+// longer than until the next timer.
+[[nodiscard]] static PG_OPTION(u32)
+    pg_aio_timers_timeout_ms(PgAio aio, PG_OPTION(u32) timeout_ms,
+                             u64 start_ns) {
+  u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  if (timeout_ms.has_value) {
+    u64 elapsed_ms = (now_ns - start_ns) / PG_Milliseconds;
+    timeout_ms.value = elapsed_ms < timeout_ms.value
+                           ? timeout_ms.value - (u32)elapsed_ms
+                           : 0;
+  }
+
+  if (!aio.timers) {
+    return timeout_ms;
+  }
+
+  PG_OPTION(u64) deadline_ns = pg_timer_wheel_next_deadline_ns(aio.timers);
+  if (!deadline_ns.has_value) {
+    return timeout_ms;
+  }
+
+  u64 ms = deadline_ns.value > now_ns
+               ? (deadline_ns.value - now_ns + PG_Milliseconds - 1) /
+                     PG_Milliseconds
+               : 0;
+  if (timeout_ms.has_value) {
+    ms = PG_MIN(ms, timeout_ms.value);
+  }
+  return PG_SOME((u32)PG_MIN(ms, UINT32_MAX), u32);
+}
+
+// The next deadline of the wheel may only be that of a cascade, after which
+// nothing is due yet: a wait that ends there with no event is resumed.
+[[nodiscard]] static bool pg_aio_timers_wait_again(PgAio aio,
+                                                   PG_OPTION(u32) timeout_ms,
+                                                   u64 start_ns) {
+  if (!aio.timers || 0 == aio.timers->count) {
+    return false;
+  }
+  if (!timeout_ms.has_value) {
+    return true;
+  }
+
+  u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  return now_ns - start_ns < timeout_ms.value * PG_Milliseconds;
+}
+
+// One wait of the OS API, with `timeout_ms` already clamped to the timers.
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_aio_wait_once(PgAio aio, PG_SLICE(PgAioEvent) events_out,
+                     PG_OPTION(u32) timeout_ms);
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_aio_wait_cqe_once(PgAio aio, PgRing *cqe, PG_OPTION(u32) timeout_ms);
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_aio_wait(PgAio aio, PG_SLICE(PgAioEvent) events_out,
+                PG_OPTION(u32) timeout_ms) {
+  u64 start_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  for (;;) {
+    PG_RESULT(u64, PgError)
+    res = pg_aio_wait_once(aio, events_out,
+                           pg_aio_timers_timeout_ms(aio, timeout_ms, start_ns));
+    if (PG_IS_ERR(res) || 0 != PG_UNWRAP(res) ||
+        !pg_aio_timers_wait_again(aio, timeout_ms, start_ns)) {
+      return res;
+    }
+  }
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_aio_wait_cqe(PgAio aio, PgRing *cqe, PG_OPTION(u32) timeout_ms) {
+  u64 start_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  for (;;) {
+    PG_RESULT(u64, PgError)
+    res = pg_aio_wait_cqe_once(
+        aio, cqe, pg_aio_timers_timeout_ms(aio, timeout_ms, start_ns));
+    if (PG_IS_ERR(res) || 0 != PG_UNWRAP(res) ||
+        !pg_aio_timers_wait_again(aio, timeout_ms, start_ns)) {
+      return res;
+    }
+  }
+}
+
+#if defined(PG_OS_FREEBSD) || defined(PG_OS_APPLE)
+#include <sys/event.h>
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgAio, PgError) pg_aio_init() {
+  i32 ret = kqueue();
+  if (-1 == ret) {
+    return PG_ERR(errno, PgAio, PgError);
+  }
+
+  return PG_OK((PgAio){.aio.fd = ret}, PgAio, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_aio_register_interest_fs_name(PgAio *aio, PgString name,
+                                     PgAioEventKind interest,
+                                     PgAllocator *allocator) {
+  PgFileDescriptor fd =
+      PG_TRY(pg_file_open(name, PG_FILE_ACCESS_READ, 0666, false, allocator),
+             PgFileDescriptor, PgError);
+
+  PgError err = pg_aio_register_interest_fd(*aio, fd, interest);
+  if (err) {
+    (void)pg_file_close(fd);
+    return PG_ERR(err, PgFileDescriptor, PgError);
+  }
+
+  PgAioFsNode *fs_node = pg_aio_fs_node_upsert(&aio->fs_nodes, fd, allocator);
+  PG_ASSERT(fs_node);
+  fs_node->name = name;
+
+  return PG_OK(fd, PgFileDescriptor, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_aio_register_interest_fd(PgAio aio, PgFileDescriptor fd,
+                            PgAioEventKind interest) {
+  struct kevent changelist[1] = {0};
+  changelist[0].ident = (u64)fd.fd;
+  changelist[0].flags = EV_ADD;
+
+  if (interest & PG_AIO_EVENT_KIND_READABLE) {
+    changelist[0].filter |= EVFILT_READ;
+  }
+  if (interest & PG_AIO_EVENT_KIND_WRITABLE) {
+    changelist[0].filter |= EVFILT_WRITE;
+  }
+  if (interest & PG_AIO_EVENT_KIND_FILE_CREATED) {
+    // TODO
+  }
+  if (interest & PG_AIO_EVENT_KIND_FILE_MODIFIED) {
+    changelist[0].filter |= EVFILT_VNODE;
+    changelist[0].fflags |= NOTE_WRITE;
+  }
+  if (interest & PG_AIO_EVENT_KIND_FILE_DELETED) {
+    changelist[0].filter |= EVFILT_VNODE;
+    changelist[0].fflags |= NOTE_DELETE;
+  }
+
+  i32 ret = kevent(aio.aio.fd, changelist, 1, nullptr, 0, nullptr);
+  if (-1 == ret) {
+    return (PgError)errno;
+  }
+
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_aio_unregister_interest(PgAio aio, PgFileDescriptor fd,
+                           PgAioEventKind interest) {
+  struct kevent changelist[1] = {0};
+  changelist[0].ident = (u64)fd.fd;
+  changelist[0].flags = EV_DELETE;
+
+  if (PG_AIO_EVENT_KIND_FILE_MODIFIED & interest) {
+    changelist[0].filter = EVFILT_VNODE;
+    changelist[0].fflags = NOTE_WRITE;
+  }
+  if (PG_AIO_EVENT_KIND_FILE_DELETED & interest) {
+    changelist[0].filter = EVFILT_VNODE;
+    changelist[0].fflags = NOTE_DELETE;
+  }
+  if (PG_AIO_EVENT_KIND_FILE_CREATED & interest) {
+    // TODO
+  }
+  if (PG_AIO_EVENT_KIND_READABLE & interest) {
+    changelist[0].filter = EVFILT_READ;
+  }
+  if (PG_AIO_EVENT_KIND_WRITABLE & interest) {
+    changelist[0].filter = EVFILT_WRITE;
+  }
+
+  i32 ret = kevent(aio.aio.fd, changelist, 1, nullptr, 0, nullptr);
+  if (-1 == ret && ENOENT != errno) {
+    return (PgError)errno;
+  }
+
+  return 0;
+}
+
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_aio_wait_once(PgAio aio, PG_SLICE(PgAioEvent) events_out,
+                     PG_OPTION(u32) timeout_ms) {
+  PG_RESULT(u64, PgError) res = {0};
+
+  // Expired timers are reported without waiting.
+  u64 expired = pg_aio_timers_expire(aio, events_out);
+  if (expired > 0) {
+    return PG_OK(expired, u64, PgError);
+  }
+
+  struct kevent eventlist[1024] = {0};
+  u64 eventlist_len = PG_MIN(PG_STATIC_ARRAY_LEN(eventlist), events_out.len);
+  if (0 == eventlist_len) {
+    return res;
+  }
+
+  struct timespec timeout = {0};
+  if (timeout_ms.has_value) {
+    timeout.tv_sec = timeout_ms.value / 1000;
+    timeout.tv_nsec = (timeout_ms.value % 1000) * 1000 * 1000;
+  }
+
+  i32 ret = kevent(aio.aio.fd, nullptr, 0, eventlist, eventlist_len,
+                   timeout_ms.has_value ? &timeout : nullptr);
+  if (-1 == ret) {
+    return PG_ERR(errno, u64, PgError);
+  }
+
+  for (u64 i = 0; i < (u64)ret; i++) {
+    struct kevent kevent = PG_C_ARRAY_AT(eventlist, eventlist_len, i);
+    PgAioEvent *ev = PG_SLICE_AT_PTR(&events_out, i);
+    ev->fd.fd = kevent.ident;
+
+    if (EV_ERROR & kevent.flags) {
+      ev->kind |= PG_AIO_EVENT_KIND_ERROR;
+    }
+    if (EV_EOF & kevent.flags) {
+      ev->kind |= PG_AIO_EVENT_KIND_EOF;
+    }
+    if (EVFILT_READ & kevent.filter) {
+      ev->kind |= PG_AIO_EVENT_KIND_READABLE;
+    }
+    if (EVFILT_WRITE & kevent.filter) {
+      ev->kind |= PG_AIO_EVENT_KIND_WRITABLE;
+    }
+    if ((EVFILT_VNODE & kevent.filter) && (NOTE_DELETE & kevent.fflags)) {
+      ev->kind |= PG_AIO_EVENT_KIND_FILE_DELETED;
+    }
+    if ((EVFILT_VNODE & kevent.filter) && (NOTE_WRITE & kevent.fflags)) {
+      ev->kind |= PG_AIO_EVENT_KIND_FILE_MODIFIED;
+    }
+  }
+
+  u64 count = (u64)ret;
+  count += pg_aio_timers_expire(aio, PG_SLICE_RANGE_START(events_out, count));
+
+  return PG_OK(count, u64, PgError);
+};
+
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_aio_wait_cqe_once(PgAio aio, PgRing *cqe, PG_OPTION(u32) timeout_ms) {
+  // TODO: Use `pg_aio_wait` ?
+
+  // Expired timers are reported without waiting.
+  u64 expired = pg_aio_timers_expire_cqe(aio, cqe);
+  if (expired > 0) {
+    return PG_OK(expired, u64, PgError);
+  }
+
+  u64 can_write_count = pg_ring_can_write_count(*cqe) / sizeof(PgAioEvent);
+
+  struct kevent eventlist[1024] = {0};
+  u64 eventlist_len = PG_MIN(PG_STATIC_ARRAY_LEN(eventlist), can_write_count);
+  if (0 == eventlist_len) {
+    return PG_OK(0, u64, PgError);
+  }
+
+  struct timespec timeout = {0};
+  if (timeout_ms.has_value) {
+    timeout.tv_sec = timeout_ms.value / 1000;
+    timeout.tv_nsec = (timeout_ms.value % 1000) * 1000 * 1000;
+  }
+
+  i32 ret = kevent(aio.aio.fd, nullptr, 0, eventlist, eventlist_len,
+                   timeout_ms.has_value ? &timeout : nullptr);
+  if (-1 == ret) {
+    return PG_ERR(errno, u64, PgError);
+  }
+
+  for (u64 i = 0; i < (u64)ret; i++) {
+    struct kevent kevent = PG_C_ARRAY_AT(eventlist, eventlist_len, i);
+    PgAioEvent ev = {0};
+    ev.fd.fd = kevent.ident;
+
+    if (EV_ERROR & kevent.flags) {
+      ev.kind |= PG_AIO_EVENT_KIND_ERROR;
+    }
+    if (EV_EOF & kevent.flags) {
+      ev.kind |= PG_AIO_EVENT_KIND_EOF;
+    }
+    if (EVFILT_READ & kevent.filter) {
+      ev.kind |= PG_AIO_EVENT_KIND_READABLE;
+    }
+    if (EVFILT_WRITE & kevent.filter) {
+      ev.kind |= PG_AIO_EVENT_KIND_WRITABLE;
+    }
+    if ((EVFILT_VNODE & kevent.filter) && (NOTE_DELETE & kevent.fflags)) {
+      ev.kind |= PG_AIO_EVENT_KIND_FILE_DELETED;
+    }
+    if ((EVFILT_VNODE & kevent.filter) && (NOTE_WRITE & kevent.fflags)) {
+      ev.kind |= PG_AIO_EVENT_KIND_FILE_MODIFIED;
+    }
+
+    PG_SLICE(u8) ev_bytes = {.data = (u8 *)&ev, .len = sizeof(ev)};
+    PG_ASSERT(sizeof(ev) == pg_ring_write_bytes(cqe, ev_bytes));
+  }
+
+  u64 count = (u64)ret + pg_aio_timers_expire_cqe(aio, cqe);
+
+  return PG_OK(count, u64, PgError);
+}
+
+#endif
+
+[[maybe_unused]] [[nodiscard]] static bool
+pg_aio_is_fs_event_kind(PgAioEventKind kind) {
+  switch (kind) {
+  case PG_AIO_EVENT_KIND_FILE_MODIFIED:
+  case PG_AIO_EVENT_KIND_FILE_DELETED:
+  case PG_AIO_EVENT_KIND_FILE_CREATED:
+    return true;
+
+  case PG_AIO_EVENT_KIND_READABLE:
+  case PG_AIO_EVENT_KIND_WRITABLE:
+  case PG_AIO_EVENT_KIND_NONE:
+  case PG_AIO_EVENT_KIND_ERROR:
+  case PG_AIO_EVENT_KIND_EOF:
+    return false;
+
+  default:
+    PG_ASSERT(0);
+  }
+}
+
+[[nodiscard]] static PG_OPTION(PgDebugFunctionDeclaration)
+    pg_dwarf_find_function_by_addr(PG_DYN(PgDebugFunctionDeclaration) fns,
+                                   u64 addr) {
+  PG_OPTION(PgDebugFunctionDeclaration) res = {0};
+
+  PG_EACH_PTR(fn, &fns) {
+    if (fn->low_pc <= addr && addr < fn->high_pc) {
+      res.has_value = true;
+      res.value = *fn;
+      return res;
+    }
+  }
+
+  return res;
+}
+
+[[maybe_unused]] [[nodiscard]]
+static PgError pg_debug_print_function(PgWriter *w,
+                                       PgDebugFunctionDeclaration fn,
+                                       PgAllocator *allocator) {
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("inlined="), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, fn.inlined, allocator));
+  PG_ERR_RETURN(
+      pg_writer_write_full(w, PG_S(" debug_info_offset="), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_hex(w, fn.debug_info_offset, allocator));
+  PG_ERR_RETURN(
+      pg_writer_write_full(w, PG_S(" debug_info_offset_ref="), allocator));
+  PG_ERR_RETURN(
+      pg_writer_write_u64_hex(w, fn.debug_info_offset_ref, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" file="), allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, fn.file, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" name="), allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, fn.name, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" low_pc="), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_hex(w, fn.low_pc, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" high_pc="), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_hex(w, fn.high_pc, allocator));
+
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]]
+static PgError pg_debug_print_functions(PgWriter *w,
+                                        PG_DYN(PgDebugFunctionDeclaration) fns,
+                                        PgAllocator *allocator) {
+  for (u64 i = 0; i < fns.len; i++) {
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("["), allocator));
+    PG_ERR_RETURN(pg_writer_write_u64_as_string(w, i, allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("]"), allocator));
+    PG_ERR_RETURN(pg_debug_print_function(w, PG_SLICE_AT(fns, i), allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
+  }
+  PG_ERR_RETURN(pg_writer_flush(w, allocator));
+  return 0;
+}
+
+#ifdef PG_OS_UNIX
+static const PgString pg_dwarf_compilation_unit_kind_to_str[] = {
+    [PG_DWARF_COMPILATION_UNIT_NONE] = PG_S("PG_DWARF_COMPILATION_UNIT_NONE"),
+    [PG_DWARF_COMPILATION_UNIT_COMPILE] =
+        PG_S("PG_DWARF_COMPILATION_UNIT_COMPILE"),
+    [PG_DWARF_COMPILATION_UNIT_TYPE] = PG_S("PG_DWARF_COMPILATION_UNIT_TYPE"),
+    [PG_DWARF_COMPILATION_UNIT_PARTIAL] =
+        PG_S("PG_DWARF_COMPILATION_UNIT_PARTIAL"),
+    [PG_DWARF_COMPILATION_UNIT_SKELETON] =
+        PG_S("PG_DWARF_COMPILATION_UNIT_SKELETON"),
+    [PG_DWARF_COMPILATION_UNIT_SPLIT_COMPILE] =
+        PG_S("PG_DWARF_COMPILATION_UNIT_SPLIT_COMPILE"),
+    [PG_DWARF_COMPILATION_UNIT_SPLIT_TYPE] =
+        PG_S("PG_DWARF_COMPILATION_UNIT_SPLIT_TYPE"),
+    [PG_DWARF_COMPILATION_UNIT_LO_USER] =
+        PG_S("PG_DWARF_COMPILATION_UNIT_LO_USER"),
+    [PG_DWARF_COMPILATION_UNIT_HI_USER] =
+        PG_S("PG_DWARF_COMPILATION_UNIT_HI_USER"),
+};
+
+static const PgString pg_dwarf_tag_str[] = {
+    [PG_DWARF_TAG_NULL] = PG_S("PG_DWARF_TAG_NULL"),
+    [PG_DWARF_TAG_ARRAY_TYPE] = PG_S("PG_DWARF_TAG_ARRAY_TYPE"),
+    [PG_DWARF_TAG_CLASS_TYPE] = PG_S("PG_DWARF_TAG_CLASS_TYPE"),
+    [PG_DWARF_TAG_ENTRY_POINT] = PG_S("PG_DWARF_TAG_ENTRY_POINT"),
+    [PG_DWARF_TAG_ENUMERATION_TYPE] = PG_S("PG_DWARF_TAG_ENUMERATION_TYPE"),
+    [PG_DWARF_TAG_FORMAL_PARAMETER] = PG_S("PG_DWARF_TAG_FORMAL_PARAMETER"),
+    [PG_DWARF_TAG_IMPORTED_DECLARATION] =
+        PG_S("PG_DWARF_TAG_IMPORTED_DECLARATION"),
+    [PG_DWARF_TAG_LABEL] = PG_S("PG_DWARF_TAG_LABEL"),
+    [PG_DWARF_TAG_LEXICAL_BLOCK] = PG_S("PG_DWARF_TAG_LEXICAL_BLOCK"),
+    [PG_DWARF_TAG_MEMBER] = PG_S("PG_DWARF_TAG_MEMBER"),
+    [PG_DWARF_TAG_POINTER_TYPE] = PG_S("PG_DWARF_TAG_POINTER_TYPE"),
+    [PG_DWARF_TAG_REFERENCE_TYPE] = PG_S("PG_DWARF_TAG_REFERENCE_TYPE"),
+    [PG_DWARF_TAG_COMPILE_UNIT] = PG_S("PG_DWARF_TAG_COMPILE_UNIT"),
+    [PG_DWARF_TAG_STRING_TYPE] = PG_S("PG_DWARF_TAG_STRING_TYPE"),
+    [PG_DWARF_TAG_STRUCTURE_TYPE] = PG_S("PG_DWARF_TAG_STRUCTURE_TYPE"),
+    [PG_DWARF_TAG_SUBROUTINE_TYPE] = PG_S("PG_DWARF_TAG_SUBROUTINE_TYPE"),
+    [PG_DWARF_TAG_TYPEDEF] = PG_S("PG_DWARF_TAG_TYPEDEF"),
+    [PG_DWARF_TAG_UNION_TYPE] = PG_S("PG_DWARF_TAG_UNION_TYPE"),
+    [PG_DWARF_TAG_UNSPECIFIED_PARAMETERS] =
+        PG_S("PG_DWARF_TAG_UNSPECIFIED_PARAMETERS"),
+    [PG_DWARF_TAG_VARIANT] = PG_S("PG_DWARF_TAG_VARIANT"),
+    [PG_DWARF_TAG_COMMON_BLOCK] = PG_S("PG_DWARF_TAG_COMMON_BLOCK"),
+    [PG_DWARF_TAG_COMMON_INCLUSION] = PG_S("PG_DWARF_TAG_COMMON_INCLUSION"),
+    [PG_DWARF_TAG_INHERITANCE] = PG_S("PG_DWARF_TAG_INHERITANCE"),
+    [PG_DWARF_TAG_INLINED_SUBROUTINE] = PG_S("PG_DWARF_TAG_INLINED_SUBROUTINE"),
+    [PG_DWARF_TAG_MODULE] = PG_S("PG_DWARF_TAG_MODULE"),
+    [PG_DWARF_TAG_PTR_TO_MEMBER_TYPE] = PG_S("PG_DWARF_TAG_PTR_TO_MEMBER_TYPE"),
+    [PG_DWARF_TAG_SET_TYPE] = PG_S("PG_DWARF_TAG_SET_TYPE"),
+    [PG_DWARF_TAG_SUBRANGE_TYPE] = PG_S("PG_DWARF_TAG_SUBRANGE_TYPE"),
+    [PG_DWARF_TAG_WITH_STMT] = PG_S("PG_DWARF_TAG_WITH_STMT"),
+    [PG_DWARF_TAG_ACCESS_DECLARATION] = PG_S("PG_DWARF_TAG_ACCESS_DECLARATION"),
+    [PG_DWARF_TAG_BASE_TYPE] = PG_S("PG_DWARF_TAG_BASE_TYPE"),
+    [PG_DWARF_TAG_CATCH_BLOCK] = PG_S("PG_DWARF_TAG_CATCH_BLOCK"),
+    [PG_DWARF_TAG_CONST_TYPE] = PG_S("PG_DWARF_TAG_CONST_TYPE"),
+    [PG_DWARF_TAG_CONSTANT] = PG_S("PG_DWARF_TAG_CONSTANT"),
+    [PG_DWARF_TAG_ENUMERATOR] = PG_S("PG_DWARF_TAG_ENUMERATOR"),
+    [PG_DWARF_TAG_FILE_TYPE] = PG_S("PG_DWARF_TAG_FILE_TYPE"),
+    [PG_DWARF_TAG_FRIEND] = PG_S("PG_DWARF_TAG_FRIEND"),
+    [PG_DWARF_TAG_NAMELIST] = PG_S("PG_DWARF_TAG_NAMELIST"),
+    [PG_DWARF_TAG_NAMELIST_ITEM] = PG_S("PG_DWARF_TAG_NAMELIST_ITEM"),
+    [PG_DWARF_TAG_PACKED_TYPE] = PG_S("PG_DWARF_TAG_PACKED_TYPE"),
+    [PG_DWARF_TAG_SUBPROGRAM] = PG_S("PG_DWARF_TAG_SUBPROGRAM"),
+    [PG_DWARF_TAG_TEMPLATE_TYPE_PARAMETER] =
+        PG_S("PG_DWARF_TAG_TEMPLATE_TYPE_PARAMETER"),
+    [PG_DWARF_TAG_TEMPLATE_VALUE_PARAMETER] =
+        PG_S("PG_DWARF_TAG_TEMPLATE_VALUE_PARAMETER"),
+    [PG_DWARF_TAG_THROWN_TYPE] = PG_S("PG_DWARF_TAG_THROWN_TYPE"),
+    [PG_DWARF_TAG_TRY_BLOCK] = PG_S("PG_DWARF_TAG_TRY_BLOCK"),
+    [PG_DWARF_TAG_VARIANT_PART] = PG_S("PG_DWARF_TAG_VARIANT_PART"),
+    [PG_DWARF_TAG_VARIABLE] = PG_S("PG_DWARF_TAG_VARIABLE"),
+    [PG_DWARF_TAG_VOLATILE_TYPE] = PG_S("PG_DWARF_TAG_VOLATILE_TYPE"),
+    [PG_DWARF_TAG_DWARF_PROCEDURE] = PG_S("PG_DWARF_TAG_DWARF_PROCEDURE"),
+    [PG_DWARF_TAG_RESTRICT_TYPE] = PG_S("PG_DWARF_TAG_RESTRICT_TYPE"),
+    [PG_DWARF_TAG_INTERFACE_TYPE] = PG_S("PG_DWARF_TAG_INTERFACE_TYPE"),
+    [PG_DWARF_TAG_NAMESPACE] = PG_S("PG_DWARF_TAG_NAMESPACE"),
+    [PG_DWARF_TAG_IMPORTED_MODULE] = PG_S("PG_DWARF_TAG_IMPORTED_MODULE"),
+    [PG_DWARF_TAG_UNSPECIFIED_TYPE] = PG_S("PG_DWARF_TAG_UNSPECIFIED_TYPE"),
+    [PG_DWARF_TAG_PARTIAL_UNIT] = PG_S("PG_DWARF_TAG_PARTIAL_UNIT"),
+    [PG_DWARF_TAG_IMPORTED_UNIT] = PG_S("PG_DWARF_TAG_IMPORTED_UNIT"),
+    [PG_DWARF_TAG_CONDITION] = PG_S("PG_DWARF_TAG_CONDITION"),
+    [PG_DWARF_TAG_SHARED_TYPE] = PG_S("PG_DWARF_TAG_SHARED_TYPE"),
+    [PG_DWARF_TAG_TYPE_UNIT] = PG_S("PG_DWARF_TAG_TYPE_UNIT"),
     [PG_DWARF_TAG_RVALUE_REFERENCE_TYPE] =
         PG_S("PG_DWARF_TAG_RVALUE_REFERENCE_TYPE"),
     [PG_DWARF_TAG_TEMPLATE_ALIAS] = PG_S("PG_DWARF_TAG_TEMPLATE_ALIAS"),
@@ -10215,3032 +17904,6468 @@ static const PgString pg_dwarf_tag_str[] = {
     [PG_DWARF_TAG_HI_USER] = PG_S("PG_DWARF_TAG_HI_USER"),
 };
 
-static const PgString pg_dwarf_attribute_str[] = {
-    [PG_DWARF_AT_NONE] = PG_S("PG_DWARF_AT_NONE"),
-    [PG_DWARF_AT_SIBLING] = PG_S("PG_DWARF_AT_SIBLING"),
-    [PG_DWARF_AT_LOCATION] = PG_S("PG_DWARF_AT_LOCATION"),
-    [PG_DWARF_AT_NAME] = PG_S("PG_DWARF_AT_NAME"),
-    [PG_DWARF_AT_ORDERING] = PG_S("PG_DWARF_AT_ORDERING"),
-    [PG_DWARF_AT_BYTE_SIZE] = PG_S("PG_DWARF_AT_BYTE_SIZE"),
-    [PG_DWARF_AT_BIT_OFFSET] = PG_S("PG_DWARF_AT_BIT_OFFSET"),
-    [PG_DWARF_AT_BIT_SIZE] = PG_S("PG_DWARF_AT_BIT_SIZE"),
-    [PG_DWARF_AT_STMT_LIST] = PG_S("PG_DWARF_AT_STMT_LIST"),
-    [PG_DWARF_AT_LOW_PC] = PG_S("PG_DWARF_AT_LOW_PC"),
-    [PG_DWARF_AT_HIGH_PC] = PG_S("PG_DWARF_AT_HIGH_PC"),
-    [PG_DWARF_AT_LANGUAGE] = PG_S("PG_DWARF_AT_LANGUAGE"),
-    [PG_DWARF_AT_DISCR] = PG_S("PG_DWARF_AT_DISCR"),
-    [PG_DWARF_AT_DISCR_VALUE] = PG_S("PG_DWARF_AT_DISCR_VALUE"),
-    [PG_DWARF_AT_VISIBILITY] = PG_S("PG_DWARF_AT_VISIBILITY"),
-    [PG_DWARF_AT_IMPORT] = PG_S("PG_DWARF_AT_IMPORT"),
-    [PG_DWARF_AT_STRING_LENGTH] = PG_S("PG_DWARF_AT_STRING_LENGTH"),
-    [PG_DWARF_AT_COMMON_REFERENCE] = PG_S("PG_DWARF_AT_COMMON_REFERENCE"),
-    [PG_DWARF_AT_COMP_DIR] = PG_S("PG_DWARF_AT_COMP_DIR"),
-    [PG_DWARF_AT_CONST_VALUE] = PG_S("PG_DWARF_AT_CONST_VALUE"),
-    [PG_DWARF_AT_CONTAINING_TYPE] = PG_S("PG_DWARF_AT_CONTAINING_TYPE"),
-    [PG_DWARF_AT_DEFAULT_VALUE] = PG_S("PG_DWARF_AT_DEFAULT_VALUE"),
-    [PG_DWARF_AT_INLINE] = PG_S("PG_DWARF_AT_INLINE"),
-    [PG_DWARF_AT_IS_OPTIONAL] = PG_S("PG_DWARF_AT_IS_OPTIONAL"),
-    [PG_DWARF_AT_LOWER_BOUND] = PG_S("PG_DWARF_AT_LOWER_BOUND"),
-    [PG_DWARF_AT_PRODUCER] = PG_S("PG_DWARF_AT_PRODUCER"),
-    [PG_DWARF_AT_PROTOTYPED] = PG_S("PG_DWARF_AT_PROTOTYPED"),
-    [PG_DWARF_AT_RETURN_ADDR] = PG_S("PG_DWARF_AT_RETURN_ADDR"),
-    [PG_DWARF_AT_START_SCOPE] = PG_S("PG_DWARF_AT_START_SCOPE"),
-    [PG_DWARF_AT_BIT_STRIDE] = PG_S("PG_DWARF_AT_BIT_STRIDE"),
-    [PG_DWARF_AT_UPPER_BOUND] = PG_S("PG_DWARF_AT_UPPER_BOUND"),
-    [PG_DWARF_AT_ABSTRACT_ORIGIN] = PG_S("PG_DWARF_AT_ABSTRACT_ORIGIN"),
-    [PG_DWARF_AT_ACCESSIBILITY] = PG_S("PG_DWARF_AT_ACCESSIBILITY"),
-    [PG_DWARF_AT_ADDRESS_CLASS] = PG_S("PG_DWARF_AT_ADDRESS_CLASS"),
-    [PG_DWARF_AT_ARTIFICIAL] = PG_S("PG_DWARF_AT_ARTIFICIAL"),
-    [PG_DWARF_AT_BASE_TYPES] = PG_S("PG_DWARF_AT_BASE_TYPES"),
-    [PG_DWARF_AT_CALLING_CONVENTION] = PG_S("PG_DWARF_AT_CALLING_CONVENTION"),
-    [PG_DWARF_AT_COUNT] = PG_S("PG_DWARF_AT_COUNT"),
-    [PG_DWARF_AT_DATA_MEMBER_LOCATION] =
-        PG_S("PG_DWARF_AT_DATA_MEMBER_LOCATION"),
-    [PG_DWARF_AT_DECL_COLUMN] = PG_S("PG_DWARF_AT_DECL_COLUMN"),
-    [PG_DWARF_AT_DECL_FILE] = PG_S("PG_DWARF_AT_DECL_FILE"),
-    [PG_DWARF_AT_DECL_LINE] = PG_S("PG_DWARF_AT_DECL_LINE"),
-    [PG_DWARF_AT_DECLARATION] = PG_S("PG_DWARF_AT_DECLARATION"),
-    [PG_DWARF_AT_DISCR_LIST] = PG_S("PG_DWARF_AT_DISCR_LIST"),
-    [PG_DWARF_AT_ENCODING] = PG_S("PG_DWARF_AT_ENCODING"),
-    [PG_DWARF_AT_EXTERNAL] = PG_S("PG_DWARF_AT_EXTERNAL"),
-    [PG_DWARF_AT_FRAME_BASE] = PG_S("PG_DWARF_AT_FRAME_BASE"),
-    [PG_DWARF_AT_FRIEND] = PG_S("PG_DWARF_AT_FRIEND"),
-    [PG_DWARF_AT_IDENTIFIER_CASE] = PG_S("PG_DWARF_AT_IDENTIFIER_CASE"),
-    [PG_DWARF_AT_MACRO_INFO] = PG_S("PG_DWARF_AT_MACRO_INFO"),
-    [PG_DWARF_AT_NAMELIST_ITEM] = PG_S("PG_DWARF_AT_NAMELIST_ITEM"),
-    [PG_DWARF_AT_PRIORITY] = PG_S("PG_DWARF_AT_PRIORITY"),
-    [PG_DWARF_AT_SEGMENT] = PG_S("PG_DWARF_AT_SEGMENT"),
-    [PG_DWARF_AT_SPECIFICATION] = PG_S("PG_DWARF_AT_SPECIFICATION"),
-    [PG_DWARF_AT_STATIC_LINK] = PG_S("PG_DWARF_AT_STATIC_LINK"),
-    [PG_DWARF_AT_TYPE] = PG_S("PG_DWARF_AT_TYPE"),
-    [PG_DWARF_AT_USE_LOCATION] = PG_S("PG_DWARF_AT_USE_LOCATION"),
-    [PG_DWARF_AT_VARIABLE_PARAMETER] = PG_S("PG_DWARF_AT_VARIABLE_PARAMETER"),
-    [PG_DWARF_AT_VIRTUALITY] = PG_S("PG_DWARF_AT_VIRTUALITY"),
-    [PG_DWARF_AT_VTABLE_ELEM_LOCATION] =
-        PG_S("PG_DWARF_AT_VTABLE_ELEM_LOCATION"),
-    [PG_DWARF_AT_ALLOCATED] = PG_S("PG_DWARF_AT_ALLOCATED"),
-    [PG_DWARF_AT_ASSOCIATED] = PG_S("PG_DWARF_AT_ASSOCIATED"),
-    [PG_DWARF_AT_DATA_LOCATION] = PG_S("PG_DWARF_AT_DATA_LOCATION"),
-    [PG_DWARF_AT_BYTE_STRIDE] = PG_S("PG_DWARF_AT_BYTE_STRIDE"),
-    [PG_DWARF_AT_ENTRY_PC] = PG_S("PG_DWARF_AT_ENTRY_PC"),
-    [PG_DWARF_AT_USE_UTF8] = PG_S("PG_DWARF_AT_USE_UTF8"),
-    [PG_DWARF_AT_EXTENSION] = PG_S("PG_DWARF_AT_EXTENSION"),
-    [PG_DWARF_AT_RANGES] = PG_S("PG_DWARF_AT_RANGES"),
-    [PG_DWARF_AT_TRAMPOLINE] = PG_S("PG_DWARF_AT_TRAMPOLINE"),
-    [PG_DWARF_AT_CALL_COLUMN] = PG_S("PG_DWARF_AT_CALL_COLUMN"),
-    [PG_DWARF_AT_CALL_FILE] = PG_S("PG_DWARF_AT_CALL_FILE"),
-    [PG_DWARF_AT_CALL_LINE] = PG_S("PG_DWARF_AT_CALL_LINE"),
-    [PG_DWARF_AT_DESCRIPTION] = PG_S("PG_DWARF_AT_DESCRIPTION"),
-    [PG_DWARF_AT_BINARY_SCALE] = PG_S("PG_DWARF_AT_BINARY_SCALE"),
-    [PG_DWARF_AT_DECIMAL_SCALE] = PG_S("PG_DWARF_AT_DECIMAL_SCALE"),
-    [PG_DWARF_AT_SMALL] = PG_S("PG_DWARF_AT_SMALL"),
-    [PG_DWARF_AT_DECIMAL_SIGN] = PG_S("PG_DWARF_AT_DECIMAL_SIGN"),
-    [PG_DWARF_AT_DIGIT_COUNT] = PG_S("PG_DWARF_AT_DIGIT_COUNT"),
-    [PG_DWARF_AT_PICTURE_STRING] = PG_S("PG_DWARF_AT_PICTURE_STRING"),
-    [PG_DWARF_AT_MUTABLE] = PG_S("PG_DWARF_AT_MUTABLE"),
-    [PG_DWARF_AT_THREADS_SCALED] = PG_S("PG_DWARF_AT_THREADS_SCALED"),
-    [PG_DWARF_AT_EXPLICIT] = PG_S("PG_DWARF_AT_EXPLICIT"),
-    [PG_DWARF_AT_OBJECT_POINTER] = PG_S("PG_DWARF_AT_OBJECT_POINTER"),
-    [PG_DWARF_AT_ENDIANITY] = PG_S("PG_DWARF_AT_ENDIANITY"),
-    [PG_DWARF_AT_ELEMENTAL] = PG_S("PG_DWARF_AT_ELEMENTAL"),
-    [PG_DWARF_AT_PURE] = PG_S("PG_DWARF_AT_PURE"),
-    [PG_DWARF_AT_RECURSIVE] = PG_S("PG_DWARF_AT_RECURSIVE"),
-    [PG_DWARF_AT_SIGNATURE] = PG_S("PG_DWARF_AT_SIGNATURE"),
-    [PG_DWARF_AT_MAIN_SUBPROGRAM] = PG_S("PG_DWARF_AT_MAIN_SUBPROGRAM"),
-    [PG_DWARF_AT_DATA_BIT_OFFSET] = PG_S("PG_DWARF_AT_DATA_BIT_OFFSET"),
-    [PG_DWARF_AT_CONST_EXPR] = PG_S("PG_DWARF_AT_CONST_EXPR"),
-    [PG_DWARF_AT_ENUM_CLASS] = PG_S("PG_DWARF_AT_ENUM_CLASS"),
-    [PG_DWARF_AT_LINKAGE_NAME] = PG_S("PG_DWARF_AT_LINKAGE_NAME"),
-    [PG_DWARF_AT_STRING_LENGTH_BIT_SIZE] =
-        PG_S("PG_DWARF_AT_STRING_LENGTH_BIT_SIZE"),
-    [PG_DWARF_AT_STRING_LENGTH_BYTE_SIZE] =
-        PG_S("PG_DWARF_AT_STRING_LENGTH_BYTE_SIZE"),
-    [PG_DWARF_AT_RANK] = PG_S("PG_DWARF_AT_RANK"),
-    [PG_DWARF_AT_STR_OFFSETS_BASE] = PG_S("PG_DWARF_AT_STR_OFFSETS_BASE"),
-    [PG_DWARF_AT_ADDR_BASE] = PG_S("PG_DWARF_AT_ADDR_BASE"),
-    [PG_DWARF_AT_RNGLISTS_BASE] = PG_S("PG_DWARF_AT_RNGLISTS_BASE"),
-    [PG_DWARF_AT_DWO_ID] = PG_S("PG_DWARF_AT_DWO_ID"),
-    [PG_DWARF_AT_DWO_NAME] = PG_S("PG_DWARF_AT_DWO_NAME"),
-    [PG_DWARF_AT_REFERENCE] = PG_S("PG_DWARF_AT_REFERENCE"),
-    [PG_DWARF_AT_RVALUE_REFERENCE] = PG_S("PG_DWARF_AT_RVALUE_REFERENCE"),
-    [PG_DWARF_AT_MACROS] = PG_S("PG_DWARF_AT_MACROS"),
-    [PG_DWARF_AT_CALL_ALL_CALLS] = PG_S("PG_DWARF_AT_CALL_ALL_CALLS"),
-    [PG_DWARF_AT_CALL_ALL_SOURCE_CALLS] =
-        PG_S("PG_DWARF_AT_CALL_ALL_SOURCE_CALLS"),
-    [PG_DWARF_AT_CALL_ALL_TAIL_CALLS] = PG_S("PG_DWARF_AT_CALL_ALL_TAIL_CALLS"),
-    [PG_DWARF_AT_CALL_RETURN_PC] = PG_S("PG_DWARF_AT_CALL_RETURN_PC"),
-    [PG_DWARF_AT_CALL_VALUE] = PG_S("PG_DWARF_AT_CALL_VALUE"),
-    [PG_DWARF_AT_CALL_ORIGIN] = PG_S("PG_DWARF_AT_CALL_ORIGIN"),
-    [PG_DWARF_AT_CALL_PARAMETER] = PG_S("PG_DWARF_AT_CALL_PARAMETER"),
-    [PG_DWARF_AT_CALL_PC] = PG_S("PG_DWARF_AT_CALL_PC"),
-    [PG_DWARF_AT_CALL_TAIL_CALL] = PG_S("PG_DWARF_AT_CALL_TAIL_CALL"),
-    [PG_DWARF_AT_CALL_TARGET] = PG_S("PG_DWARF_AT_CALL_TARGET"),
-    [PG_DWARF_AT_CALL_TARGET_CLOBBERED] =
-        PG_S("PG_DWARF_AT_CALL_TARGET_CLOBBERED"),
-    [PG_DWARF_AT_CALL_DATA_LOCATION] = PG_S("PG_DWARF_AT_CALL_DATA_LOCATION"),
-    [PG_DWARF_AT_CALL_DATA_VALUE] = PG_S("PG_DWARF_AT_CALL_DATA_VALUE"),
-    [PG_DWARF_AT_NORETURN] = PG_S("PG_DWARF_AT_NORETURN"),
-    [PG_DWARF_AT_ALIGNMENT] = PG_S("PG_DWARF_AT_ALIGNMENT"),
-    [PG_DWARF_AT_EXPORT_SYMBOLS] = PG_S("PG_DWARF_AT_EXPORT_SYMBOLS"),
-    [PG_DWARF_AT_DELETED] = PG_S("PG_DWARF_AT_DELETED"),
-    [PG_DWARF_AT_DEFAULTED] = PG_S("PG_DWARF_AT_DEFAULTED"),
-    [PG_DWARF_AT_LOCLISTS_BASE] = PG_S("PG_DWARF_AT_LOCLISTS_BASE"),
-    [PG_DWARF_AT_MIPS_LOOP_BEGIN] = PG_S("PG_DWARF_AT_MIPS_LOOP_BEGIN"),
-    [PG_DWARF_AT_MIPS_TAIL_LOOP_BEGIN] =
-        PG_S("PG_DWARF_AT_MIPS_TAIL_LOOP_BEGIN"),
-    [PG_DWARF_AT_MIPS_EPILOG_BEGIN] = PG_S("PG_DWARF_AT_MIPS_EPILOG_BEGIN"),
-    [PG_DWARF_AT_MIPS_LOOP_UNROLL_FACTOR] =
-        PG_S("PG_DWARF_AT_MIPS_LOOP_UNROLL_FACTOR"),
-    [PG_DWARF_AT_MIPS_SOFTWARE_PIPELINE_DEPTH] =
-        PG_S("PG_DWARF_AT_MIPS_SOFTWARE_PIPELINE_DEPTH"),
-    [PG_DWARF_AT_MIPS_LINKAGE_NAME] = PG_S("PG_DWARF_AT_MIPS_LINKAGE_NAME"),
-    [PG_DWARF_AT_MIPS_STRIDE] = PG_S("PG_DWARF_AT_MIPS_STRIDE"),
-    [PG_DWARF_AT_MIPS_ABSTRACT_NAME] = PG_S("PG_DWARF_AT_MIPS_ABSTRACT_NAME"),
-    [PG_DWARF_AT_MIPS_CLONE_ORIGIN] = PG_S("PG_DWARF_AT_MIPS_CLONE_ORIGIN"),
-    [PG_DWARF_AT_MIPS_HAS_INLINES] = PG_S("PG_DWARF_AT_MIPS_HAS_INLINES"),
-    [PG_DWARF_AT_MIPS_STRIDE_BYTE] = PG_S("PG_DWARF_AT_MIPS_STRIDE_BYTE"),
-    [PG_DWARF_AT_MIPS_STRIDE_ELEM] = PG_S("PG_DWARF_AT_MIPS_STRIDE_ELEM"),
-    [PG_DWARF_AT_MIPS_PTR_DOPETYPE] = PG_S("PG_DWARF_AT_MIPS_PTR_DOPETYPE"),
-    [PG_DWARF_AT_MIPS_ALLOCATABLE_DOPETYPE] =
-        PG_S("PG_DWARF_AT_MIPS_ALLOCATABLE_DOPETYPE"),
-    [PG_DWARF_AT_MIPS_ASSUMED_SHAPE_DOPETYPE] =
-        PG_S("PG_DWARF_AT_MIPS_ASSUMED_SHAPE_DOPETYPE"),
-    [PG_DWARF_AT_MIPS_ASSUMED_SIZE] = PG_S("PG_DWARF_AT_MIPS_ASSUMED_SIZE"),
-    [PG_DWARF_AT_SF_NAMES] = PG_S("PG_DWARF_AT_SF_NAMES"),
-    [PG_DWARF_AT_SRC_INFO] = PG_S("PG_DWARF_AT_SRC_INFO"),
-    [PG_DWARF_AT_MAC_INFO] = PG_S("PG_DWARF_AT_MAC_INFO"),
-    [PG_DWARF_AT_SRC_COORDS] = PG_S("PG_DWARF_AT_SRC_COORDS"),
-    [PG_DWARF_AT_BODY_BEGIN] = PG_S("PG_DWARF_AT_BODY_BEGIN"),
-    [PG_DWARF_AT_BODY_END] = PG_S("PG_DWARF_AT_BODY_END"),
-    [PG_DWARF_AT_GNU_VECTOR] = PG_S("PG_DWARF_AT_GNU_VECTOR"),
-    [PG_DWARF_AT_GNU_TEMPLATE_NAME] = PG_S("PG_DWARF_AT_GNU_TEMPLATE_NAME"),
-    [PG_DWARF_AT_GNU_ODR_SIGNATURE] = PG_S("PG_DWARF_AT_GNU_ODR_SIGNATURE"),
-    [PG_DWARF_AT_GNU_CALL_SITE_VALUE] = PG_S("PG_DWARF_AT_GNU_CALL_SITE_VALUE"),
-    [PG_DWARF_AT_GNU_CALL_SITE_DATA_VALUE] =
-        PG_S("PG_DWARF_AT_GNU_CALL_SITE_DATA_VALUE"),
-    [PG_DWARF_AT_GNU_CALL_SITE_TARGET] =
-        PG_S("PG_DWARF_AT_GNU_CALL_SITE_TARGET"),
-    [PG_DWARF_AT_GNU_CALL_SITE_TARGET_CLOBBERED] =
-        PG_S("PG_DWARF_AT_GNU_CALL_SITE_TARGET_CLOBBERED"),
-    [PG_DWARF_AT_GNU_TAIL_CALL] = PG_S("PG_DWARF_AT_GNU_TAIL_CALL"),
-    [PG_DWARF_AT_GNU_ALL_TAIL_CALL_SITES] =
-        PG_S("PG_DWARF_AT_GNU_ALL_TAIL_CALL_SITES"),
-    [PG_DWARF_AT_GNU_ALL_CALL_SITES] = PG_S("PG_DWARF_AT_GNU_ALL_CALL_SITES"),
-    [PG_DWARF_AT_GNU_ALL_SOURCE_CALL_SITES] =
-        PG_S("PG_DWARF_AT_GNU_ALL_SOURCE_CALL_SITES"),
-    [PG_DWARF_AT_GNU_MACROS] = PG_S("PG_DWARF_AT_GNU_MACROS"),
-    [PG_DWARF_AT_GNU_DWO_NAME] = PG_S("PG_DWARF_AT_GNU_DWO_NAME"),
-    [PG_DWARF_AT_GNU_DWO_ID] = PG_S("PG_DWARF_AT_GNU_DWO_ID"),
-    [PG_DWARF_AT_GNU_RANGES_BASE] = PG_S("PG_DWARF_AT_GNU_RANGES_BASE"),
-    [PG_DWARF_AT_GNU_ADDR_BASE] = PG_S("PG_DWARF_AT_GNU_ADDR_BASE"),
-    [PG_DWARF_AT_GNU_PUBNAMES] = PG_S("PG_DWARF_AT_GNU_PUBNAMES"),
-    [PG_DWARF_AT_GNU_PUBTYPES] = PG_S("PG_DWARF_AT_GNU_PUBTYPES"),
-    [PG_DWARF_AT_GNU_DISCRIMINATOR] = PG_S("PG_DWARF_AT_GNU_DISCRIMINATOR"),
-    [PG_DWARF_AT_BORLAND_PROPERTY_READ] =
-        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_READ"),
-    [PG_DWARF_AT_BORLAND_PROPERTY_WRITE] =
-        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_WRITE"),
-    [PG_DWARF_AT_BORLAND_PROPERTY_IMPLEMENTS] =
-        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_IMPLEMENTS"),
-    [PG_DWARF_AT_BORLAND_PROPERTY_INDEX] =
-        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_INDEX"),
-    [PG_DWARF_AT_BORLAND_PROPERTY_DEFAULT] =
-        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_DEFAULT"),
-    [PG_DWARF_AT_BORLAND_DELPHI_UNIT] = PG_S("PG_DWARF_AT_BORLAND_DELPHI_UNIT"),
-    [PG_DWARF_AT_BORLAND_DELPHI_CLASS] =
-        PG_S("PG_DWARF_AT_BORLAND_DELPHI_CLASS"),
-    [PG_DWARF_AT_BORLAND_DELPHI_RECORD] =
-        PG_S("PG_DWARF_AT_BORLAND_DELPHI_RECORD"),
-    [PG_DWARF_AT_BORLAND_DELPHI_METACLASS] =
-        PG_S("PG_DWARF_AT_BORLAND_DELPHI_METACLASS"),
-    [PG_DWARF_AT_BORLAND_DELPHI_CONSTRUCTOR] =
-        PG_S("PG_DWARF_AT_BORLAND_DELPHI_CONSTRUCTOR"),
-    [PG_DWARF_AT_BORLAND_DELPHI_DESTRUCTOR] =
-        PG_S("PG_DWARF_AT_BORLAND_DELPHI_DESTRUCTOR"),
-    [PG_DWARF_AT_BORLAND_DELPHI_ANONYMOUS_METHOD] =
-        PG_S("PG_DWARF_AT_BORLAND_DELPHI_ANONYMOUS_METHOD"),
-    [PG_DWARF_AT_BORLAND_DELPHI_INTERFACE] =
-        PG_S("PG_DWARF_AT_BORLAND_DELPHI_INTERFACE"),
-    [PG_DWARF_AT_BORLAND_DELPHI_ABI] = PG_S("PG_DWARF_AT_BORLAND_DELPHI_ABI"),
-    [PG_DWARF_AT_BORLAND_DELPHI_RETURN] =
-        PG_S("PG_DWARF_AT_BORLAND_DELPHI_RETURN"),
-    [PG_DWARF_AT_BORLAND_DELPHI_FRAMEPTR] =
-        PG_S("PG_DWARF_AT_BORLAND_DELPHI_FRAMEPTR"),
-    [PG_DWARF_AT_BORLAND_CLOSURE] = PG_S("PG_DWARF_AT_BORLAND_CLOSURE"),
-    [PG_DWARF_AT_LLVM_INCLUDE_PATH] = PG_S("PG_DWARF_AT_LLVM_INCLUDE_PATH"),
-    [PG_DWARF_AT_LLVM_CONFIG_MACROS] = PG_S("PG_DWARF_AT_LLVM_CONFIG_MACROS"),
-    [PG_DWARF_AT_LLVM_SYSROOT] = PG_S("PG_DWARF_AT_LLVM_SYSROOT"),
-    [PG_DWARF_AT_LLVM_TAG_OFFSET] = PG_S("PG_DWARF_AT_LLVM_TAG_OFFSET"),
-    [PG_DWARF_AT_LLVM_APINOTES] = PG_S("PG_DWARF_AT_LLVM_APINOTES"),
-    [PG_DWARF_AT_APPLE_OPTIMIZED] = PG_S("PG_DWARF_AT_APPLE_OPTIMIZED"),
-    [PG_DWARF_AT_APPLE_FLAGS] = PG_S("PG_DWARF_AT_APPLE_FLAGS"),
-    [PG_DWARF_AT_APPLE_ISA] = PG_S("PG_DWARF_AT_APPLE_ISA"),
-    [PG_DWARF_AT_APPLE_BLOCK] = PG_S("PG_DWARF_AT_APPLE_BLOCK"),
-    [PG_DWARF_AT_APPLE_MAJOR_RUNTIME_VERS] =
-        PG_S("PG_DWARF_AT_APPLE_MAJOR_RUNTIME_VERS"),
-    [PG_DWARF_AT_APPLE_RUNTIME_CLASS] = PG_S("PG_DWARF_AT_APPLE_RUNTIME_CLASS"),
-    [PG_DWARF_AT_APPLE_OMIT_FRAME_PTR] =
-        PG_S("PG_DWARF_AT_APPLE_OMIT_FRAME_PTR"),
-    [PG_DWARF_AT_APPLE_PROPERTY_NAME] = PG_S("PG_DWARF_AT_APPLE_PROPERTY_NAME"),
-    [PG_DWARF_AT_APPLE_PROPERTY_GETTER] =
-        PG_S("PG_DWARF_AT_APPLE_PROPERTY_GETTER"),
-    [PG_DWARF_AT_APPLE_PROPERTY_SETTER] =
-        PG_S("PG_DWARF_AT_APPLE_PROPERTY_SETTER"),
-    [PG_DWARF_AT_APPLE_PROPERTY_ATTRIBUTE] =
-        PG_S("PG_DWARF_AT_APPLE_PROPERTY_ATTRIBUTE"),
-    [PG_DWARF_AT_APPLE_OBJC_COMPLETE_TYPE] =
-        PG_S("PG_DWARF_AT_APPLE_OBJC_COMPLETE_TYPE"),
-    [PG_DWARF_AT_APPLE_PROPERTY] = PG_S("PG_DWARF_AT_APPLE_PROPERTY"),
-    [PG_DWARF_AT_APPLE_OBJC_DIRECT] = PG_S("PG_DWARF_AT_APPLE_OBJC_DIRECT"),
-    [PG_DWARF_AT_APPLE_SDK] = PG_S("PG_DWARF_AT_APPLE_SDK"),
-};
+static const PgString pg_dwarf_attribute_str[] = {
+    [PG_DWARF_AT_NONE] = PG_S("PG_DWARF_AT_NONE"),
+    [PG_DWARF_AT_SIBLING] = PG_S("PG_DWARF_AT_SIBLING"),
+    [PG_DWARF_AT_LOCATION] = PG_S("PG_DWARF_AT_LOCATION"),
+    [PG_DWARF_AT_NAME] = PG_S("PG_DWARF_AT_NAME"),
+    [PG_DWARF_AT_ORDERING] = PG_S("PG_DWARF_AT_ORDERING"),
+    [PG_DWARF_AT_BYTE_SIZE] = PG_S("PG_DWARF_AT_BYTE_SIZE"),
+    [PG_DWARF_AT_BIT_OFFSET] = PG_S("PG_DWARF_AT_BIT_OFFSET"),
+    [PG_DWARF_AT_BIT_SIZE] = PG_S("PG_DWARF_AT_BIT_SIZE"),
+    [PG_DWARF_AT_STMT_LIST] = PG_S("PG_DWARF_AT_STMT_LIST"),
+    [PG_DWARF_AT_LOW_PC] = PG_S("PG_DWARF_AT_LOW_PC"),
+    [PG_DWARF_AT_HIGH_PC] = PG_S("PG_DWARF_AT_HIGH_PC"),
+    [PG_DWARF_AT_LANGUAGE] = PG_S("PG_DWARF_AT_LANGUAGE"),
+    [PG_DWARF_AT_DISCR] = PG_S("PG_DWARF_AT_DISCR"),
+    [PG_DWARF_AT_DISCR_VALUE] = PG_S("PG_DWARF_AT_DISCR_VALUE"),
+    [PG_DWARF_AT_VISIBILITY] = PG_S("PG_DWARF_AT_VISIBILITY"),
+    [PG_DWARF_AT_IMPORT] = PG_S("PG_DWARF_AT_IMPORT"),
+    [PG_DWARF_AT_STRING_LENGTH] = PG_S("PG_DWARF_AT_STRING_LENGTH"),
+    [PG_DWARF_AT_COMMON_REFERENCE] = PG_S("PG_DWARF_AT_COMMON_REFERENCE"),
+    [PG_DWARF_AT_COMP_DIR] = PG_S("PG_DWARF_AT_COMP_DIR"),
+    [PG_DWARF_AT_CONST_VALUE] = PG_S("PG_DWARF_AT_CONST_VALUE"),
+    [PG_DWARF_AT_CONTAINING_TYPE] = PG_S("PG_DWARF_AT_CONTAINING_TYPE"),
+    [PG_DWARF_AT_DEFAULT_VALUE] = PG_S("PG_DWARF_AT_DEFAULT_VALUE"),
+    [PG_DWARF_AT_INLINE] = PG_S("PG_DWARF_AT_INLINE"),
+    [PG_DWARF_AT_IS_OPTIONAL] = PG_S("PG_DWARF_AT_IS_OPTIONAL"),
+    [PG_DWARF_AT_LOWER_BOUND] = PG_S("PG_DWARF_AT_LOWER_BOUND"),
+    [PG_DWARF_AT_PRODUCER] = PG_S("PG_DWARF_AT_PRODUCER"),
+    [PG_DWARF_AT_PROTOTYPED] = PG_S("PG_DWARF_AT_PROTOTYPED"),
+    [PG_DWARF_AT_RETURN_ADDR] = PG_S("PG_DWARF_AT_RETURN_ADDR"),
+    [PG_DWARF_AT_START_SCOPE] = PG_S("PG_DWARF_AT_START_SCOPE"),
+    [PG_DWARF_AT_BIT_STRIDE] = PG_S("PG_DWARF_AT_BIT_STRIDE"),
+    [PG_DWARF_AT_UPPER_BOUND] = PG_S("PG_DWARF_AT_UPPER_BOUND"),
+    [PG_DWARF_AT_ABSTRACT_ORIGIN] = PG_S("PG_DWARF_AT_ABSTRACT_ORIGIN"),
+    [PG_DWARF_AT_ACCESSIBILITY] = PG_S("PG_DWARF_AT_ACCESSIBILITY"),
+    [PG_DWARF_AT_ADDRESS_CLASS] = PG_S("PG_DWARF_AT_ADDRESS_CLASS"),
+    [PG_DWARF_AT_ARTIFICIAL] = PG_S("PG_DWARF_AT_ARTIFICIAL"),
+    [PG_DWARF_AT_BASE_TYPES] = PG_S("PG_DWARF_AT_BASE_TYPES"),
+    [PG_DWARF_AT_CALLING_CONVENTION] = PG_S("PG_DWARF_AT_CALLING_CONVENTION"),
+    [PG_DWARF_AT_COUNT] = PG_S("PG_DWARF_AT_COUNT"),
+    [PG_DWARF_AT_DATA_MEMBER_LOCATION] =
+        PG_S("PG_DWARF_AT_DATA_MEMBER_LOCATION"),
+    [PG_DWARF_AT_DECL_COLUMN] = PG_S("PG_DWARF_AT_DECL_COLUMN"),
+    [PG_DWARF_AT_DECL_FILE] = PG_S("PG_DWARF_AT_DECL_FILE"),
+    [PG_DWARF_AT_DECL_LINE] = PG_S("PG_DWARF_AT_DECL_LINE"),
+    [PG_DWARF_AT_DECLARATION] = PG_S("PG_DWARF_AT_DECLARATION"),
+    [PG_DWARF_AT_DISCR_LIST] = PG_S("PG_DWARF_AT_DISCR_LIST"),
+    [PG_DWARF_AT_ENCODING] = PG_S("PG_DWARF_AT_ENCODING"),
+    [PG_DWARF_AT_EXTERNAL] = PG_S("PG_DWARF_AT_EXTERNAL"),
+    [PG_DWARF_AT_FRAME_BASE] = PG_S("PG_DWARF_AT_FRAME_BASE"),
+    [PG_DWARF_AT_FRIEND] = PG_S("PG_DWARF_AT_FRIEND"),
+    [PG_DWARF_AT_IDENTIFIER_CASE] = PG_S("PG_DWARF_AT_IDENTIFIER_CASE"),
+    [PG_DWARF_AT_MACRO_INFO] = PG_S("PG_DWARF_AT_MACRO_INFO"),
+    [PG_DWARF_AT_NAMELIST_ITEM] = PG_S("PG_DWARF_AT_NAMELIST_ITEM"),
+    [PG_DWARF_AT_PRIORITY] = PG_S("PG_DWARF_AT_PRIORITY"),
+    [PG_DWARF_AT_SEGMENT] = PG_S("PG_DWARF_AT_SEGMENT"),
+    [PG_DWARF_AT_SPECIFICATION] = PG_S("PG_DWARF_AT_SPECIFICATION"),
+    [PG_DWARF_AT_STATIC_LINK] = PG_S("PG_DWARF_AT_STATIC_LINK"),
+    [PG_DWARF_AT_TYPE] = PG_S("PG_DWARF_AT_TYPE"),
+    [PG_DWARF_AT_USE_LOCATION] = PG_S("PG_DWARF_AT_USE_LOCATION"),
+    [PG_DWARF_AT_VARIABLE_PARAMETER] = PG_S("PG_DWARF_AT_VARIABLE_PARAMETER"),
+    [PG_DWARF_AT_VIRTUALITY] = PG_S("PG_DWARF_AT_VIRTUALITY"),
+    [PG_DWARF_AT_VTABLE_ELEM_LOCATION] =
+        PG_S("PG_DWARF_AT_VTABLE_ELEM_LOCATION"),
+    [PG_DWARF_AT_ALLOCATED] = PG_S("PG_DWARF_AT_ALLOCATED"),
+    [PG_DWARF_AT_ASSOCIATED] = PG_S("PG_DWARF_AT_ASSOCIATED"),
+    [PG_DWARF_AT_DATA_LOCATION] = PG_S("PG_DWARF_AT_DATA_LOCATION"),
+    [PG_DWARF_AT_BYTE_STRIDE] = PG_S("PG_DWARF_AT_BYTE_STRIDE"),
+    [PG_DWARF_AT_ENTRY_PC] = PG_S("PG_DWARF_AT_ENTRY_PC"),
+    [PG_DWARF_AT_USE_UTF8] = PG_S("PG_DWARF_AT_USE_UTF8"),
+    [PG_DWARF_AT_EXTENSION] = PG_S("PG_DWARF_AT_EXTENSION"),
+    [PG_DWARF_AT_RANGES] = PG_S("PG_DWARF_AT_RANGES"),
+    [PG_DWARF_AT_TRAMPOLINE] = PG_S("PG_DWARF_AT_TRAMPOLINE"),
+    [PG_DWARF_AT_CALL_COLUMN] = PG_S("PG_DWARF_AT_CALL_COLUMN"),
+    [PG_DWARF_AT_CALL_FILE] = PG_S("PG_DWARF_AT_CALL_FILE"),
+    [PG_DWARF_AT_CALL_LINE] = PG_S("PG_DWARF_AT_CALL_LINE"),
+    [PG_DWARF_AT_DESCRIPTION] = PG_S("PG_DWARF_AT_DESCRIPTION"),
+    [PG_DWARF_AT_BINARY_SCALE] = PG_S("PG_DWARF_AT_BINARY_SCALE"),
+    [PG_DWARF_AT_DECIMAL_SCALE] = PG_S("PG_DWARF_AT_DECIMAL_SCALE"),
+    [PG_DWARF_AT_SMALL] = PG_S("PG_DWARF_AT_SMALL"),
+    [PG_DWARF_AT_DECIMAL_SIGN] = PG_S("PG_DWARF_AT_DECIMAL_SIGN"),
+    [PG_DWARF_AT_DIGIT_COUNT] = PG_S("PG_DWARF_AT_DIGIT_COUNT"),
+    [PG_DWARF_AT_PICTURE_STRING] = PG_S("PG_DWARF_AT_PICTURE_STRING"),
+    [PG_DWARF_AT_MUTABLE] = PG_S("PG_DWARF_AT_MUTABLE"),
+    [PG_DWARF_AT_THREADS_SCALED] = PG_S("PG_DWARF_AT_THREADS_SCALED"),
+    [PG_DWARF_AT_EXPLICIT] = PG_S("PG_DWARF_AT_EXPLICIT"),
+    [PG_DWARF_AT_OBJECT_POINTER] = PG_S("PG_DWARF_AT_OBJECT_POINTER"),
+    [PG_DWARF_AT_ENDIANITY] = PG_S("PG_DWARF_AT_ENDIANITY"),
+    [PG_DWARF_AT_ELEMENTAL] = PG_S("PG_DWARF_AT_ELEMENTAL"),
+    [PG_DWARF_AT_PURE] = PG_S("PG_DWARF_AT_PURE"),
+    [PG_DWARF_AT_RECURSIVE] = PG_S("PG_DWARF_AT_RECURSIVE"),
+    [PG_DWARF_AT_SIGNATURE] = PG_S("PG_DWARF_AT_SIGNATURE"),
+    [PG_DWARF_AT_MAIN_SUBPROGRAM] = PG_S("PG_DWARF_AT_MAIN_SUBPROGRAM"),
+    [PG_DWARF_AT_DATA_BIT_OFFSET] = PG_S("PG_DWARF_AT_DATA_BIT_OFFSET"),
+    [PG_DWARF_AT_CONST_EXPR] = PG_S("PG_DWARF_AT_CONST_EXPR"),
+    [PG_DWARF_AT_ENUM_CLASS] = PG_S("PG_DWARF_AT_ENUM_CLASS"),
+    [PG_DWARF_AT_LINKAGE_NAME] = PG_S("PG_DWARF_AT_LINKAGE_NAME"),
+    [PG_DWARF_AT_STRING_LENGTH_BIT_SIZE] =
+        PG_S("PG_DWARF_AT_STRING_LENGTH_BIT_SIZE"),
+    [PG_DWARF_AT_STRING_LENGTH_BYTE_SIZE] =
+        PG_S("PG_DWARF_AT_STRING_LENGTH_BYTE_SIZE"),
+    [PG_DWARF_AT_RANK] = PG_S("PG_DWARF_AT_RANK"),
+    [PG_DWARF_AT_STR_OFFSETS_BASE] = PG_S("PG_DWARF_AT_STR_OFFSETS_BASE"),
+    [PG_DWARF_AT_ADDR_BASE] = PG_S("PG_DWARF_AT_ADDR_BASE"),
+    [PG_DWARF_AT_RNGLISTS_BASE] = PG_S("PG_DWARF_AT_RNGLISTS_BASE"),
+    [PG_DWARF_AT_DWO_ID] = PG_S("PG_DWARF_AT_DWO_ID"),
+    [PG_DWARF_AT_DWO_NAME] = PG_S("PG_DWARF_AT_DWO_NAME"),
+    [PG_DWARF_AT_REFERENCE] = PG_S("PG_DWARF_AT_REFERENCE"),
+    [PG_DWARF_AT_RVALUE_REFERENCE] = PG_S("PG_DWARF_AT_RVALUE_REFERENCE"),
+    [PG_DWARF_AT_MACROS] = PG_S("PG_DWARF_AT_MACROS"),
+    [PG_DWARF_AT_CALL_ALL_CALLS] = PG_S("PG_DWARF_AT_CALL_ALL_CALLS"),
+    [PG_DWARF_AT_CALL_ALL_SOURCE_CALLS] =
+        PG_S("PG_DWARF_AT_CALL_ALL_SOURCE_CALLS"),
+    [PG_DWARF_AT_CALL_ALL_TAIL_CALLS] = PG_S("PG_DWARF_AT_CALL_ALL_TAIL_CALLS"),
+    [PG_DWARF_AT_CALL_RETURN_PC] = PG_S("PG_DWARF_AT_CALL_RETURN_PC"),
+    [PG_DWARF_AT_CALL_VALUE] = PG_S("PG_DWARF_AT_CALL_VALUE"),
+    [PG_DWARF_AT_CALL_ORIGIN] = PG_S("PG_DWARF_AT_CALL_ORIGIN"),
+    [PG_DWARF_AT_CALL_PARAMETER] = PG_S("PG_DWARF_AT_CALL_PARAMETER"),
+    [PG_DWARF_AT_CALL_PC] = PG_S("PG_DWARF_AT_CALL_PC"),
+    [PG_DWARF_AT_CALL_TAIL_CALL] = PG_S("PG_DWARF_AT_CALL_TAIL_CALL"),
+    [PG_DWARF_AT_CALL_TARGET] = PG_S("PG_DWARF_AT_CALL_TARGET"),
+    [PG_DWARF_AT_CALL_TARGET_CLOBBERED] =
+        PG_S("PG_DWARF_AT_CALL_TARGET_CLOBBERED"),
+    [PG_DWARF_AT_CALL_DATA_LOCATION] = PG_S("PG_DWARF_AT_CALL_DATA_LOCATION"),
+    [PG_DWARF_AT_CALL_DATA_VALUE] = PG_S("PG_DWARF_AT_CALL_DATA_VALUE"),
+    [PG_DWARF_AT_NORETURN] = PG_S("PG_DWARF_AT_NORETURN"),
+    [PG_DWARF_AT_ALIGNMENT] = PG_S("PG_DWARF_AT_ALIGNMENT"),
+    [PG_DWARF_AT_EXPORT_SYMBOLS] = PG_S("PG_DWARF_AT_EXPORT_SYMBOLS"),
+    [PG_DWARF_AT_DELETED] = PG_S("PG_DWARF_AT_DELETED"),
+    [PG_DWARF_AT_DEFAULTED] = PG_S("PG_DWARF_AT_DEFAULTED"),
+    [PG_DWARF_AT_LOCLISTS_BASE] = PG_S("PG_DWARF_AT_LOCLISTS_BASE"),
+    [PG_DWARF_AT_MIPS_LOOP_BEGIN] = PG_S("PG_DWARF_AT_MIPS_LOOP_BEGIN"),
+    [PG_DWARF_AT_MIPS_TAIL_LOOP_BEGIN] =
+        PG_S("PG_DWARF_AT_MIPS_TAIL_LOOP_BEGIN"),
+    [PG_DWARF_AT_MIPS_EPILOG_BEGIN] = PG_S("PG_DWARF_AT_MIPS_EPILOG_BEGIN"),
+    [PG_DWARF_AT_MIPS_LOOP_UNROLL_FACTOR] =
+        PG_S("PG_DWARF_AT_MIPS_LOOP_UNROLL_FACTOR"),
+    [PG_DWARF_AT_MIPS_SOFTWARE_PIPELINE_DEPTH] =
+        PG_S("PG_DWARF_AT_MIPS_SOFTWARE_PIPELINE_DEPTH"),
+    [PG_DWARF_AT_MIPS_LINKAGE_NAME] = PG_S("PG_DWARF_AT_MIPS_LINKAGE_NAME"),
+    [PG_DWARF_AT_MIPS_STRIDE] = PG_S("PG_DWARF_AT_MIPS_STRIDE"),
+    [PG_DWARF_AT_MIPS_ABSTRACT_NAME] = PG_S("PG_DWARF_AT_MIPS_ABSTRACT_NAME"),
+    [PG_DWARF_AT_MIPS_CLONE_ORIGIN] = PG_S("PG_DWARF_AT_MIPS_CLONE_ORIGIN"),
+    [PG_DWARF_AT_MIPS_HAS_INLINES] = PG_S("PG_DWARF_AT_MIPS_HAS_INLINES"),
+    [PG_DWARF_AT_MIPS_STRIDE_BYTE] = PG_S("PG_DWARF_AT_MIPS_STRIDE_BYTE"),
+    [PG_DWARF_AT_MIPS_STRIDE_ELEM] = PG_S("PG_DWARF_AT_MIPS_STRIDE_ELEM"),
+    [PG_DWARF_AT_MIPS_PTR_DOPETYPE] = PG_S("PG_DWARF_AT_MIPS_PTR_DOPETYPE"),
+    [PG_DWARF_AT_MIPS_ALLOCATABLE_DOPETYPE] =
+        PG_S("PG_DWARF_AT_MIPS_ALLOCATABLE_DOPETYPE"),
+    [PG_DWARF_AT_MIPS_ASSUMED_SHAPE_DOPETYPE] =
+        PG_S("PG_DWARF_AT_MIPS_ASSUMED_SHAPE_DOPETYPE"),
+    [PG_DWARF_AT_MIPS_ASSUMED_SIZE] = PG_S("PG_DWARF_AT_MIPS_ASSUMED_SIZE"),
+    [PG_DWARF_AT_SF_NAMES] = PG_S("PG_DWARF_AT_SF_NAMES"),
+    [PG_DWARF_AT_SRC_INFO] = PG_S("PG_DWARF_AT_SRC_INFO"),
+    [PG_DWARF_AT_MAC_INFO] = PG_S("PG_DWARF_AT_MAC_INFO"),
+    [PG_DWARF_AT_SRC_COORDS] = PG_S("PG_DWARF_AT_SRC_COORDS"),
+    [PG_DWARF_AT_BODY_BEGIN] = PG_S("PG_DWARF_AT_BODY_BEGIN"),
+    [PG_DWARF_AT_BODY_END] = PG_S("PG_DWARF_AT_BODY_END"),
+    [PG_DWARF_AT_GNU_VECTOR] = PG_S("PG_DWARF_AT_GNU_VECTOR"),
+    [PG_DWARF_AT_GNU_TEMPLATE_NAME] = PG_S("PG_DWARF_AT_GNU_TEMPLATE_NAME"),
+    [PG_DWARF_AT_GNU_ODR_SIGNATURE] = PG_S("PG_DWARF_AT_GNU_ODR_SIGNATURE"),
+    [PG_DWARF_AT_GNU_CALL_SITE_VALUE] = PG_S("PG_DWARF_AT_GNU_CALL_SITE_VALUE"),
+    [PG_DWARF_AT_GNU_CALL_SITE_DATA_VALUE] =
+        PG_S("PG_DWARF_AT_GNU_CALL_SITE_DATA_VALUE"),
+    [PG_DWARF_AT_GNU_CALL_SITE_TARGET] =
+        PG_S("PG_DWARF_AT_GNU_CALL_SITE_TARGET"),
+    [PG_DWARF_AT_GNU_CALL_SITE_TARGET_CLOBBERED] =
+        PG_S("PG_DWARF_AT_GNU_CALL_SITE_TARGET_CLOBBERED"),
+    [PG_DWARF_AT_GNU_TAIL_CALL] = PG_S("PG_DWARF_AT_GNU_TAIL_CALL"),
+    [PG_DWARF_AT_GNU_ALL_TAIL_CALL_SITES] =
+        PG_S("PG_DWARF_AT_GNU_ALL_TAIL_CALL_SITES"),
+    [PG_DWARF_AT_GNU_ALL_CALL_SITES] = PG_S("PG_DWARF_AT_GNU_ALL_CALL_SITES"),
+    [PG_DWARF_AT_GNU_ALL_SOURCE_CALL_SITES] =
+        PG_S("PG_DWARF_AT_GNU_ALL_SOURCE_CALL_SITES"),
+    [PG_DWARF_AT_GNU_MACROS] = PG_S("PG_DWARF_AT_GNU_MACROS"),
+    [PG_DWARF_AT_GNU_DWO_NAME] = PG_S("PG_DWARF_AT_GNU_DWO_NAME"),
+    [PG_DWARF_AT_GNU_DWO_ID] = PG_S("PG_DWARF_AT_GNU_DWO_ID"),
+    [PG_DWARF_AT_GNU_RANGES_BASE] = PG_S("PG_DWARF_AT_GNU_RANGES_BASE"),
+    [PG_DWARF_AT_GNU_ADDR_BASE] = PG_S("PG_DWARF_AT_GNU_ADDR_BASE"),
+    [PG_DWARF_AT_GNU_PUBNAMES] = PG_S("PG_DWARF_AT_GNU_PUBNAMES"),
+    [PG_DWARF_AT_GNU_PUBTYPES] = PG_S("PG_DWARF_AT_GNU_PUBTYPES"),
+    [PG_DWARF_AT_GNU_DISCRIMINATOR] = PG_S("PG_DWARF_AT_GNU_DISCRIMINATOR"),
+    [PG_DWARF_AT_BORLAND_PROPERTY_READ] =
+        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_READ"),
+    [PG_DWARF_AT_BORLAND_PROPERTY_WRITE] =
+        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_WRITE"),
+    [PG_DWARF_AT_BORLAND_PROPERTY_IMPLEMENTS] =
+        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_IMPLEMENTS"),
+    [PG_DWARF_AT_BORLAND_PROPERTY_INDEX] =
+        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_INDEX"),
+    [PG_DWARF_AT_BORLAND_PROPERTY_DEFAULT] =
+        PG_S("PG_DWARF_AT_BORLAND_PROPERTY_DEFAULT"),
+    [PG_DWARF_AT_BORLAND_DELPHI_UNIT] = PG_S("PG_DWARF_AT_BORLAND_DELPHI_UNIT"),
+    [PG_DWARF_AT_BORLAND_DELPHI_CLASS] =
+        PG_S("PG_DWARF_AT_BORLAND_DELPHI_CLASS"),
+    [PG_DWARF_AT_BORLAND_DELPHI_RECORD] =
+        PG_S("PG_DWARF_AT_BORLAND_DELPHI_RECORD"),
+    [PG_DWARF_AT_BORLAND_DELPHI_METACLASS] =
+        PG_S("PG_DWARF_AT_BORLAND_DELPHI_METACLASS"),
+    [PG_DWARF_AT_BORLAND_DELPHI_CONSTRUCTOR] =
+        PG_S("PG_DWARF_AT_BORLAND_DELPHI_CONSTRUCTOR"),
+    [PG_DWARF_AT_BORLAND_DELPHI_DESTRUCTOR] =
+        PG_S("PG_DWARF_AT_BORLAND_DELPHI_DESTRUCTOR"),
+    [PG_DWARF_AT_BORLAND_DELPHI_ANONYMOUS_METHOD] =
+        PG_S("PG_DWARF_AT_BORLAND_DELPHI_ANONYMOUS_METHOD"),
+    [PG_DWARF_AT_BORLAND_DELPHI_INTERFACE] =
+        PG_S("PG_DWARF_AT_BORLAND_DELPHI_INTERFACE"),
+    [PG_DWARF_AT_BORLAND_DELPHI_ABI] = PG_S("PG_DWARF_AT_BORLAND_DELPHI_ABI"),
+    [PG_DWARF_AT_BORLAND_DELPHI_RETURN] =
+        PG_S("PG_DWARF_AT_BORLAND_DELPHI_RETURN"),
+    [PG_DWARF_AT_BORLAND_DELPHI_FRAMEPTR] =
+        PG_S("PG_DWARF_AT_BORLAND_DELPHI_FRAMEPTR"),
+    [PG_DWARF_AT_BORLAND_CLOSURE] = PG_S("PG_DWARF_AT_BORLAND_CLOSURE"),
+    [PG_DWARF_AT_LLVM_INCLUDE_PATH] = PG_S("PG_DWARF_AT_LLVM_INCLUDE_PATH"),
+    [PG_DWARF_AT_LLVM_CONFIG_MACROS] = PG_S("PG_DWARF_AT_LLVM_CONFIG_MACROS"),
+    [PG_DWARF_AT_LLVM_SYSROOT] = PG_S("PG_DWARF_AT_LLVM_SYSROOT"),
+    [PG_DWARF_AT_LLVM_TAG_OFFSET] = PG_S("PG_DWARF_AT_LLVM_TAG_OFFSET"),
+    [PG_DWARF_AT_LLVM_APINOTES] = PG_S("PG_DWARF_AT_LLVM_APINOTES"),
+    [PG_DWARF_AT_APPLE_OPTIMIZED] = PG_S("PG_DWARF_AT_APPLE_OPTIMIZED"),
+    [PG_DWARF_AT_APPLE_FLAGS] = PG_S("PG_DWARF_AT_APPLE_FLAGS"),
+    [PG_DWARF_AT_APPLE_ISA] = PG_S("PG_DWARF_AT_APPLE_ISA"),
+    [PG_DWARF_AT_APPLE_BLOCK] = PG_S("PG_DWARF_AT_APPLE_BLOCK"),
+    [PG_DWARF_AT_APPLE_MAJOR_RUNTIME_VERS] =
+        PG_S("PG_DWARF_AT_APPLE_MAJOR_RUNTIME_VERS"),
+    [PG_DWARF_AT_APPLE_RUNTIME_CLASS] = PG_S("PG_DWARF_AT_APPLE_RUNTIME_CLASS"),
+    [PG_DWARF_AT_APPLE_OMIT_FRAME_PTR] =
+        PG_S("PG_DWARF_AT_APPLE_OMIT_FRAME_PTR"),
+    [PG_DWARF_AT_APPLE_PROPERTY_NAME] = PG_S("PG_DWARF_AT_APPLE_PROPERTY_NAME"),
+    [PG_DWARF_AT_APPLE_PROPERTY_GETTER] =
+        PG_S("PG_DWARF_AT_APPLE_PROPERTY_GETTER"),
+    [PG_DWARF_AT_APPLE_PROPERTY_SETTER] =
+        PG_S("PG_DWARF_AT_APPLE_PROPERTY_SETTER"),
+    [PG_DWARF_AT_APPLE_PROPERTY_ATTRIBUTE] =
+        PG_S("PG_DWARF_AT_APPLE_PROPERTY_ATTRIBUTE"),
+    [PG_DWARF_AT_APPLE_OBJC_COMPLETE_TYPE] =
+        PG_S("PG_DWARF_AT_APPLE_OBJC_COMPLETE_TYPE"),
+    [PG_DWARF_AT_APPLE_PROPERTY] = PG_S("PG_DWARF_AT_APPLE_PROPERTY"),
+    [PG_DWARF_AT_APPLE_OBJC_DIRECT] = PG_S("PG_DWARF_AT_APPLE_OBJC_DIRECT"),
+    [PG_DWARF_AT_APPLE_SDK] = PG_S("PG_DWARF_AT_APPLE_SDK"),
+};
+
+static const PgString pg_dwarf_form_str[] = {
+    [PG_DWARF_FORM_NONE] = PG_S("PG_DWARF_FORM_NONE"),
+    [PG_DWARF_FORM_ADDR] = PG_S("PG_DWARF_FORM_ADDR"),
+    [PG_DWARF_FORM_BLOCK2] = PG_S("PG_DWARF_FORM_BLOCK2"),
+    [PG_DWARF_FORM_BLOCK4] = PG_S("PG_DWARF_FORM_BLOCK4"),
+    [PG_DWARF_FORM_DATA2] = PG_S("PG_DWARF_FORM_DATA2"),
+    [PG_DWARF_FORM_DATA4] = PG_S("PG_DWARF_FORM_DATA4"),
+    [PG_DWARF_FORM_DATA8] = PG_S("PG_DWARF_FORM_DATA8"),
+    [PG_DWARF_FORM_STRING] = PG_S("PG_DWARF_FORM_STRING"),
+    [PG_DWARF_FORM_BLOCK] = PG_S("PG_DWARF_FORM_BLOCK"),
+    [PG_DWARF_FORM_BLOCK1] = PG_S("PG_DWARF_FORM_BLOCK1"),
+    [PG_DWARF_FORM_DATA1] = PG_S("PG_DWARF_FORM_DATA1"),
+    [PG_DWARF_FORM_FLAG] = PG_S("PG_DWARF_FORM_FLAG"),
+    [PG_DWARF_FORM_SDATA] = PG_S("PG_DWARF_FORM_SDATA"),
+    [PG_DWARF_FORM_STRP] = PG_S("PG_DWARF_FORM_STRP"),
+    [PG_DWARF_FORM_UDATA] = PG_S("PG_DWARF_FORM_UDATA"),
+    [PG_DWARF_FORM_REF_ADDR] = PG_S("PG_DWARF_FORM_REF_ADDR"),
+    [PG_DWARF_FORM_REF1] = PG_S("PG_DWARF_FORM_REF1"),
+    [PG_DWARF_FORM_REF2] = PG_S("PG_DWARF_FORM_REF2"),
+    [PG_DWARF_FORM_REF4] = PG_S("PG_DWARF_FORM_REF4"),
+    [PG_DWARF_FORM_REF8] = PG_S("PG_DWARF_FORM_REF8"),
+    [PG_DWARF_FORM_REF_UDATA] = PG_S("PG_DWARF_FORM_REF_UDATA"),
+    [PG_DWARF_FORM_INDIRECT] = PG_S("PG_DWARF_FORM_INDIRECT"),
+    [PG_DWARF_FORM_SEC_OFFSET] = PG_S("PG_DWARF_FORM_SEC_OFFSET"),
+    [PG_DWARF_FORM_EXPRLOC] = PG_S("PG_DWARF_FORM_EXPRLOC"),
+    [PG_DWARF_FORM_FLAG_PRESENT] = PG_S("PG_DWARF_FORM_FLAG_PRESENT"),
+    [PG_DWARF_FORM_STRX] = PG_S("PG_DWARF_FORM_STRX"),
+    [PG_DWARF_FORM_ADDRX] = PG_S("PG_DWARF_FORM_ADDRX"),
+    [PG_DWARF_FORM_REF_SUP4] = PG_S("PG_DWARF_FORM_REF_SUP4"),
+    [PG_DWARF_FORM_STRP_SUP] = PG_S("PG_DWARF_FORM_STRP_SUP"),
+    [PG_DWARF_FORM_DATA16] = PG_S("PG_DWARF_FORM_DATA16"),
+    [PG_DWARF_FORM_LINE_STRP] = PG_S("PG_DWARF_FORM_LINE_STRP"),
+    [PG_DWARF_FORM_REF_SIG8] = PG_S("PG_DWARF_FORM_REF_SIG8"),
+    [PG_DWARF_FORM_IMPLICIT_CONST] = PG_S("PG_DWARF_FORM_IMPLICIT_CONST"),
+    [PG_DWARF_FORM_LOCLISTX] = PG_S("PG_DWARF_FORM_LOCLISTX"),
+    [PG_DWARF_FORM_RNGLISTX] = PG_S("PG_DWARF_FORM_RNGLISTX"),
+    [PG_DWARF_FORM_REF_SUP8] = PG_S("PG_DWARF_FORM_REF_SUP8"),
+    [PG_DWARF_FORM_STRX1] = PG_S("PG_DWARF_FORM_STRX1"),
+    [PG_DWARF_FORM_STRX2] = PG_S("PG_DWARF_FORM_STRX2"),
+    [PG_DWARF_FORM_STRX3] = PG_S("PG_DWARF_FORM_STRX3"),
+    [PG_DWARF_FORM_STRX4] = PG_S("PG_DWARF_FORM_STRX4"),
+    [PG_DWARF_FORM_ADDRX1] = PG_S("PG_DWARF_FORM_ADDRX1"),
+    [PG_DWARF_FORM_ADDRX2] = PG_S("PG_DWARF_FORM_ADDRX2"),
+    [PG_DWARF_FORM_ADDRX3] = PG_S("PG_DWARF_FORM_ADDRX3"),
+    [PG_DWARF_FORM_ADDRX4] = PG_S("PG_DWARF_FORM_ADDRX4"),
+};
+
+[[nodiscard]] static PG_RESULT(PG_OPTION(PgDwarfAbbreviationEntry), PgError)
+    pg_dwarf_parse_abbreviation_entry(PgReader *r, PgAllocator *allocator) {
+  PgDwarfAbbreviationEntry entry = {0};
+
+  // Tag.
+  {
+    PG_RESULT(u64, PgError) res_type = pg_reader_read_u64_leb128(r);
+    PG_IF_LET_ERR(err, res_type) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+    }
+
+    entry.type = PG_UNWRAP(res_type);
+  }
+  // Type.
+  {
+    PG_RESULT(u64, PgError) res_tag = pg_reader_read_u64_leb128(r);
+    // The end?
+    // > The abbreviations for a given compilation unit end with an entry
+    // > consisting of a 0 byte for the abbreviation code.
+    PG_IF_LET_ERR(err, res_tag) {
+      if (PG_ERR_EOF == err && 0 == entry.type) {
+        return PG_OK({}, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+      }
+      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+    }
+
+    entry.tag = PG_UNWRAP(res_tag);
+  }
+  // Has children.
+  {
+    PG_RESULT(u8, PgError) res_has_children = pg_reader_read_u8_le(r);
+    PG_IF_LET_ERR(err, res_has_children) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+    }
+    entry.has_children = PG_UNWRAP(res_has_children);
+  }
+
+  // Attributes.
+  for (u64 _i = 0; _i < PG_DWARF_MAX_ABBREV_ATTRIBUTES; _i++) {
+    PgDwarfAttributeForm attribute_form = {0};
+
+    PG_RESULT(u64, PgError) res_name = pg_reader_read_u64_leb128(r);
+    PG_IF_LET_ERR(err, res_name) {
+      // The end.
+      if (PG_ERR_EOF == err) {
+        return PG_OK(PG_SOME(entry, PgDwarfAbbreviationEntry),
+                     PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+      }
+      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+    }
+    attribute_form.attribute = PG_UNWRAP(res_name);
+
+    PG_RESULT(u64, PgError) res_form = pg_reader_read_u64_leb128(r);
+    PG_IF_LET_ERR(err, res_form) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+    }
+    attribute_form.form = PG_UNWRAP(res_form);
+
+    // End.
+    if (0 == attribute_form.attribute && 0 == attribute_form.form) {
+      return PG_OK(PG_SOME(entry, PgDwarfAbbreviationEntry),
+                   PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+    }
+
+    // Need to read one more field?
+    if (PG_DWARF_FORM_IMPLICIT_CONST == attribute_form.form) {
+      PG_RESULT(i64, PgError) res_value = pg_reader_read_i64_leb128(r);
+      PG_IF_LET_ERR(err, res_value) {
+        return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+      }
+      attribute_form.u.value = PG_UNWRAP(res_value);
+    }
+    PG_DYN_PUSH(&entry.attribute_forms, attribute_form, allocator);
+  }
+
+  return PG_ERR(PG_ERR_TOO_BIG, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+}
+
+[[nodiscard]] static PG_RESULT(PG_DYN(PgDwarfAbbreviationEntry), PgError)
+    pg_dwarf_parse_abbreviation_entries(PgElf elf, u64 offset,
+                                        PgAllocator *allocator) {
+  PG_DYN(PgDwarfAbbreviationEntry) res = {0};
+
+  PG_RESULT(PG_SLICE(u8), PgError)
+  res_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
+      elf, PG_S(".debug_abbrev"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
+  PG_IF_LET_ERR(err, res_bytes) {
+    return PG_ERR(err, PG_DYN(PgDwarfAbbreviationEntry), PgError);
+  }
+  PG_SLICE(u8) bytes = PG_UNWRAP(res_bytes);
+
+  if (offset >= bytes.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PgDwarfAbbreviationEntry),
+                  PgError);
+  }
+  bytes = PG_SLICE_RANGE_START(bytes, offset);
+  PG_DYN_ENSURE_CAP(&res, bytes.len / 4, allocator);
+
+  PgReader r = pg_reader_make_from_bytes(bytes);
+
+  PG_OPTION(PgDwarfAbbreviationEntryIndex) parent = {0};
+
+  for (u64 _i = 0; _i < PG_DWARF_MAX_ABBREV; _i++) {
+    PG_RESULT(PG_OPTION(PgDwarfAbbreviationEntry), PgError)
+    res_abbrev = pg_dwarf_parse_abbreviation_entry(&r, allocator);
+    PG_IF_LET_ERR(err, res_abbrev) {
+      return PG_ERR(err, PG_DYN(PgDwarfAbbreviationEntry), PgError);
+    }
+    PG_OPTION(PgDwarfAbbreviationEntry) abbrev_opt = PG_UNWRAP(res_abbrev);
+    if (abbrev_opt.has_value) {
+      PgDwarfAbbreviationEntry abbrev = abbrev_opt.value;
+      abbrev.parent = parent;
+      PG_DYN_PUSH(&res, abbrev, allocator);
+
+      if (abbrev.has_children) {
+        parent =
+            PG_SOME({PG_SLICE_LAST_INDEX(res)}, PgDwarfAbbreviationEntryIndex);
+      } else {
+        parent = PG_NONE(PgDwarfAbbreviationEntryIndex);
+      }
+    } else { // The end.
+      return PG_OK(res, PG_DYN(PgDwarfAbbreviationEntry), PgError);
+    }
+  }
+
+  return PG_ERR(PG_ERR_TOO_BIG, PG_DYN(PgDwarfAbbreviationEntry), PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(
+    PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError)
+    pg_dwarf_address_ranges_parse(PG_SLICE(u8) bytes, PG_DYN(u64) addresses,
+                                  PgAllocator *allocator) {
+  PG_DYN(PG_DYN(PgDwarfRangeListEntry)) res = {0};
+
+  PgReader r = pg_reader_make_from_bytes(bytes);
+
+  PG_RESULT(u32, PgError) res_length = pg_reader_read_u32_le(&r);
+  PG_IF_LET_ERR(err, res_length) {
+    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+  }
+  u32 length = PG_UNWRAP(res_length);
+  u32 expected_length = 0;
+  if (__builtin_add_overflow(length, 4, &expected_length)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
+                  PgError);
+  }
+  if (expected_length != bytes.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
+                  PgError);
+  }
+
+  PG_RESULT(u16, PgError) res_version = pg_reader_read_u16_le(&r);
+  PG_IF_LET_ERR(err, res_version) {
+    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+  }
+  u16 version = PG_UNWRAP(res_version);
+  if (5 != version) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
+                  PgError);
+  }
+
+  PG_RESULT(u8, PgError) res_address_size = pg_reader_read_u8_le(&r);
+  PG_IF_LET_ERR(err, res_address_size) {
+    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+  }
+  u8 address_size = PG_UNWRAP(res_address_size);
+  if (8 != address_size) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
+                  PgError);
+  }
+
+  PG_RESULT(u8, PgError) res_segment_selector_size = pg_reader_read_u8_le(&r);
+  PG_IF_LET_ERR(err, res_segment_selector_size) {
+    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+  }
+
+  PG_RESULT(u32, PgError) res_offset_count = pg_reader_read_u32_le(&r);
+  PG_IF_LET_ERR(err, res_offset_count) {
+    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+  }
+  u32 offset_count = PG_UNWRAP(res_offset_count);
+
+  if (0 != offset_count) {
+    for (u32 i = 0; i < offset_count; i++) {
+      PG_RESULT(u32, PgError) res_offset = pg_reader_read_u32_le(&r);
+      PG_IF_LET_ERR(err, res_offset) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+    }
+  }
+  u64 base_address = 0;
+
+  PG_DYN(PgDwarfRangeListEntry) ranges = {0};
+
+  while (!PG_SLICE_IS_EMPTY(r.u.bytes)) {
+    PgDwarfRangeListEntry entry = {0};
+    PG_RESULT(u8, PgError) res_kind = pg_reader_read_u8_le(&r);
+    PG_IF_LET_ERR(err, res_kind) {
+      return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+    }
+    entry.kind = PG_UNWRAP(res_kind);
+
+    switch (entry.kind) {
+    case PG_DWARF_RLE_END_OF_LIST: {
+      if (!PG_SLICE_IS_EMPTY(ranges)) {
+        PG_DYN_PUSH(&res, ranges, allocator);
+      }
+      ranges = (PG_DYN(PgDwarfRangeListEntry)){0};
+      base_address = 0;
+    } break;
+
+    case PG_DWARF_RLE_BASE_ADDRESSX: {
+      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      u64 value = PG_UNWRAP(res_read);
+      base_address = PG_SLICE_AT(addresses, value);
+
+      entry.u.u64 = value;
+      PG_DYN_PUSH(&ranges, entry, allocator);
+    } break;
+
+    case PG_DWARF_RLE_STARTX_LENGTH: {
+      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+
+      entry.u.pair_u64.first = PG_UNWRAP(res_read);
+
+      res_read = pg_reader_read_u64_leb128(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      entry.u.pair_u64.second = PG_UNWRAP(res_read);
+
+      PG_DYN_PUSH(&ranges, entry, allocator);
+    } break;
+
+    case PG_DWARF_RLE_OFFSET_PAIR: {
+      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      entry.u.pair_u64.first = base_address + PG_UNWRAP(res_read);
+
+      res_read = pg_reader_read_u64_leb128(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      entry.u.pair_u64.second = base_address + PG_UNWRAP(res_read);
+
+      if (entry.u.pair_u64.first != entry.u.pair_u64.second) {
+        PG_DYN_PUSH(&ranges, entry, allocator);
+      }
+    } break;
+
+    case PG_DWARF_RLE_STARTX_ENDX: {
+      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      entry.u.pair_u64.first = base_address + PG_UNWRAP(res_read);
+
+      res_read = pg_reader_read_u64_leb128(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      entry.u.pair_u64.second = base_address + PG_UNWRAP(res_read);
+
+      if (entry.u.pair_u64.first != entry.u.pair_u64.second) {
+        PG_DYN_PUSH(&ranges, entry, allocator);
+      }
+    } break;
+
+    case PG_DWARF_RLE_BASE_ADDRESS: {
+      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      base_address = PG_UNWRAP(res_read);
+
+      entry.u.u64 = PG_UNWRAP(res_read);
+      PG_DYN_PUSH(&ranges, entry, allocator);
+    } break;
+
+    case PG_DWARF_RLE_START_END: {
+      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      entry.u.pair_u64.first = PG_UNWRAP(res_read);
+
+      res_read = pg_reader_read_u64_le(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      entry.u.pair_u64.second = PG_UNWRAP(res_read);
+
+      if (entry.u.pair_u64.first != entry.u.pair_u64.second) {
+        PG_DYN_PUSH(&ranges, entry, allocator);
+      }
+    } break;
+
+    case PG_DWARF_RLE_START_LENGTH: {
+      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      entry.u.pair_u64.first = PG_UNWRAP(res_read);
+
+      res_read = pg_reader_read_u64_leb128(&r);
+      PG_IF_LET_ERR(err, res_read) {
+        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      }
+      entry.u.pair_u64.second = PG_UNWRAP(res_read);
+
+      PG_DYN_PUSH(&ranges, entry, allocator);
+    } break;
+
+    default:
+      return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
+                    PgError);
+    }
+  }
+
+  if (!PG_SLICE_IS_EMPTY(r.u.bytes)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
+                  PgError);
+  }
+
+  if (!PG_SLICE_IS_EMPTY(ranges)) {
+    PG_DYN_PUSH(&res, ranges, allocator);
+  }
+
+  return PG_OK(res, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+}
+
+[[nodiscard]] static PG_RESULT(PG_DYN(u64), PgError)
+    pg_dwarf_addresses_parse(PG_SLICE(u8) bytes, PgAllocator *allocator) {
+  PG_DYN(u64) res = {0};
+
+  PgReader r = pg_reader_make_from_bytes(bytes);
+
+  PG_RESULT(u32, PgError) res_length = pg_reader_read_u32_le(&r);
+  PG_IF_LET_ERR(err, res_length) { return PG_ERR(err, PG_DYN(u64), PgError); }
+  u64 length = PG_UNWRAP(res_length);
+  u32 expected_length = 0;
+  if (__builtin_add_overflow(length, 4, &expected_length)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
+  }
+  if (expected_length != bytes.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
+  }
+
+  PG_RESULT(u16, PgError) res_version = pg_reader_read_u16_le(&r);
+  PG_IF_LET_ERR(err, res_version) { return PG_ERR(err, PG_DYN(u64), PgError); }
+  u16 version = PG_UNWRAP(res_version);
+  if (5 != version) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
+  }
+
+  PG_RESULT(u8, PgError) res_address_size = pg_reader_read_u8_le(&r);
+  PG_IF_LET_ERR(err, res_address_size) {
+    return PG_ERR(err, PG_DYN(u64), PgError);
+  }
+  u8 address_size = PG_UNWRAP(res_address_size);
+  if (8 != address_size) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
+  }
+
+  PG_RESULT(u8, PgError) res_segment_selector_size = pg_reader_read_u8_le(&r);
+  u8 segment_selector_size = PG_UNWRAP(res_segment_selector_size);
+  if (0 != segment_selector_size) {
+    // Need to read segment + address in the loop below.
+    PG_ASSERT(0 && "todo");
+  }
+
+  if (0 != (r.u.bytes.len % 8)) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
+  }
+  PG_DYN_ENSURE_CAP(&res, r.u.bytes.len / 8, allocator);
+
+  while (!PG_SLICE_IS_EMPTY(r.u.bytes)) {
+    PG_RESULT(u64, PgError) res_addr = pg_reader_read_u64_le(&r);
+    PG_IF_LET_ERR(err, res_addr) { return PG_ERR(err, PG_DYN(u64), PgError); }
+
+    PG_DYN_PUSH(&res, PG_UNWRAP(res_addr), allocator);
+  }
+  PG_ASSERT(0 == r.u.bytes.len);
+
+  return PG_OK(res, PG_DYN(u64), PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgDwarfDebugInfoCompilationUnit,
+                                                PgError)
+    pg_dwarf_parse_debug_info(PgElf elf, PgAllocator *allocator) {
+  PgDwarfDebugInfoCompilationUnit res = {0};
+
+  PG_RESULT(PG_SLICE(u8), PgError)
+  res_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
+      elf, PG_S(".debug_info"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
+  PG_IF_LET_ERR(err, res_bytes) {
+    return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+  }
+  PG_SLICE(u8) bytes = PG_UNWRAP(res_bytes);
+
+  PgReader r = pg_reader_make_from_bytes(bytes);
+
+  // Size.
+  PG_RESULT(u32, PgError) res_size = pg_reader_read_u32_le(&r);
+  PG_IF_LET_ERR(err, res_size) {
+    return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+  }
+  u32 size = PG_UNWRAP(res_size);
+
+  // DWARF 64 bits?
+  if (0xffff'ffff == size) {
+    // Unsupported for now.
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgDwarfDebugInfoCompilationUnit,
+                  PgError);
+  }
+
+  // Version.
+  PG_RESULT(u16, PgError) res_version = pg_reader_read_u16_le(&r);
+  PG_IF_LET_ERR(err, res_version) {
+    return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+  }
+  u16 version = PG_UNWRAP(res_version);
+  // Only expect v5.
+  if (5 != version) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgDwarfDebugInfoCompilationUnit,
+                  PgError);
+  }
+
+  PG_RESULT(u8, PgError) res_unit_kind = pg_reader_read_u8_le(&r);
+  PG_IF_LET_ERR(err, res_unit_kind) {
+    return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+  }
+  res.kind = PG_UNWRAP(res_unit_kind);
+
+  switch (res.kind) {
+  case PG_DWARF_COMPILATION_UNIT_SKELETON: {
+    PG_RESULT(u8, PgError) res_address_size = pg_reader_read_u8_le(&r);
+    PG_IF_LET_ERR(err, res_address_size) {
+      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+    }
+    u8 address_size = PG_UNWRAP(res_address_size);
+    // Only expect address size 8 (64 bits).
+    PG_ASSERT(8 == address_size);
+
+    PG_RESULT(u32, PgError) res_abbrev_offset = pg_reader_read_u32_le(&r);
+    PG_IF_LET_ERR(err, res_abbrev_offset) {
+      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+    }
+    u32 abbrev_offset = PG_UNWRAP(res_abbrev_offset);
+
+    PG_RESULT(u64, PgError) res_unit_id = pg_reader_read_u64_le(&r);
+    PG_IF_LET_ERR(err, res_unit_id) {
+      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+    }
+    res.id = PG_UNWRAP(res_unit_id);
+
+    PG_RESULT(PG_DYN(PgDwarfAbbreviationEntry), PgError)
+    res_abbrevs =
+        pg_dwarf_parse_abbreviation_entries(elf, abbrev_offset, allocator);
+    PG_IF_LET_ERR(err, res_abbrevs) {
+      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+    }
+
+    res.abbrevs = PG_UNWRAP(res_abbrevs);
+  } break;
+  case PG_DWARF_COMPILATION_UNIT_COMPILE: {
+    PG_RESULT(u8, PgError) res_address_size = pg_reader_read_u8_le(&r);
+    PG_IF_LET_ERR(err, res_address_size) {
+      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+    }
+    u8 address_size = PG_UNWRAP(res_address_size);
+    // Only expect address size 8 (64 bits).
+    PG_ASSERT(8 == address_size);
+
+    // Parse abbreviation entries.
+    {
+      PG_RESULT(u32, PgError) res_abbrev_offset = pg_reader_read_u32_le(&r);
+      PG_IF_LET_ERR(err, res_abbrev_offset) {
+        return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+      }
+      u32 abbrev_offset = PG_UNWRAP(res_abbrev_offset);
+
+      PG_RESULT(PG_DYN(PgDwarfAbbreviationEntry), PgError)
+      res_abbrevs =
+          pg_dwarf_parse_abbreviation_entries(elf, abbrev_offset, allocator);
+      PG_IF_LET_ERR(err, res_abbrevs) {
+        return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+      }
+      res.abbrevs = PG_UNWRAP(res_abbrevs);
+    }
+
+    // Parse addresses.
+    // TODO: Lazily access address with O(1) instead of storing them all?
+    {
+      PG_RESULT(PG_SLICE(u8), PgError)
+      res_addresses_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
+          elf, PG_S(".debug_addr"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
+      PG_IF_LET_ERR(err, res_bytes) {
+        return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+      }
+      PG_SLICE(u8) addresses_bytes = PG_UNWRAP(res_addresses_bytes);
+
+      PG_RESULT(PG_DYN(u64), PgError)
+      res_addresses = pg_dwarf_addresses_parse(addresses_bytes, allocator);
+      PG_IF_LET_ERR(err, res_addresses) {
+        return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+      }
+      res.addresses = PG_UNWRAP(res_addresses);
+    }
+  } break;
+  case PG_DWARF_COMPILATION_UNIT_NONE:
+  case PG_DWARF_COMPILATION_UNIT_TYPE:
+  case PG_DWARF_COMPILATION_UNIT_PARTIAL:
+  case PG_DWARF_COMPILATION_UNIT_SPLIT_COMPILE:
+  case PG_DWARF_COMPILATION_UNIT_SPLIT_TYPE:
+  case PG_DWARF_COMPILATION_UNIT_LO_USER:
+  case PG_DWARF_COMPILATION_UNIT_HI_USER:
+  default:
+    PG_ASSERT(0 && "todo");
+  }
+
+  return PG_OK(res, PgDwarfDebugInfoCompilationUnit, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static u64
+pg_dwarf_compilation_unit_get_data_offset(
+    PgDwarfDebugInfoCompilationUnit unit) {
+  switch (unit.kind) {
+  case PG_DWARF_COMPILATION_UNIT_COMPILE:
+    return 12;
+  case PG_DWARF_COMPILATION_UNIT_NONE:
+  case PG_DWARF_COMPILATION_UNIT_TYPE:
+  case PG_DWARF_COMPILATION_UNIT_PARTIAL:
+  case PG_DWARF_COMPILATION_UNIT_SKELETON:
+  case PG_DWARF_COMPILATION_UNIT_SPLIT_COMPILE:
+  case PG_DWARF_COMPILATION_UNIT_SPLIT_TYPE:
+  case PG_DWARF_COMPILATION_UNIT_LO_USER:
+  case PG_DWARF_COMPILATION_UNIT_HI_USER:
+    PG_ASSERT(0 && "todo");
+  default:
+    PG_ASSERT(0);
+  }
+}
+
+[[nodiscard]] static PgString pg_dwarf_resolve_string(PG_SLICE(u32) str_offsets,
+                                                      PG_SLICE(u8) str_bytes,
+                                                      u64 idx) {
+  u32 str_idx = PG_SLICE_AT(str_offsets, idx);
+  return pg_str0_to_string(PG_SLICE_RANGE_START(str_bytes, str_idx)).value;
+}
+
+[[maybe_unused]] [[nodiscard]]
+static PG_RESULT(PG_OPTION(PgDwarfAtom), PgError)
+    pg_dwarf_compilation_unit_debug_info_next(PgDebugInfoIterator *it) {
+  PgDwarfAtom res = {0};
+
+  // The end.
+  if (PG_SLICE_IS_EMPTY(it->r.u.bytes)) {
+    return PG_OK({}, PG_OPTION(PgDwarfAtom), PgError);
+  }
+
+  PG_ASSERT(it->r.u.bytes.data >= it->debug_info_full.data);
+
+  // New abbrev.
+  if (!it->abbrev_opt.has_value ||
+      it->abbrev_attr_form_idx >= it->abbrev_opt.value.attribute_forms.len) {
+    it->die_offset = it->r.u.bytes.data - it->debug_info_full.data;
+
+    PG_RESULT(u64, PgError) res_entry_idx = pg_reader_read_u64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_entry_idx) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+    u64 entry_idx = PG_UNWRAP(res_entry_idx);
+    if (0 == entry_idx) {
+      // Null entry (?)
+      return PG_OK(PG_SOME(res, PgDwarfAtom), PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    if (entry_idx >= it->unit.abbrevs.len + 1) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    PgDwarfAbbreviationEntry abbrev =
+        PG_SLICE_AT(it->unit.abbrevs, entry_idx - 1);
+
+    it->abbrev_opt.has_value = true;
+    it->abbrev_opt.value = abbrev;
+    it->abbrev_attr_form_idx = 0;
+  }
+
+  PG_ASSERT(it->abbrev_opt.has_value);
+  PgDwarfAbbreviationEntry abbrev = it->abbrev_opt.value;
+  res.abbrev = abbrev;
+  res.debug_info_offset = it->die_offset;
+
+  if (PG_SLICE_IS_EMPTY(abbrev.attribute_forms)) {
+    return PG_OK(PG_SOME(res, PgDwarfAtom), PG_OPTION(PgDwarfAtom), PgError);
+  }
+
+  PgDwarfAttributeForm attr_form =
+      PG_SLICE_AT(abbrev.attribute_forms, it->abbrev_attr_form_idx);
+  res.attr_form = attr_form;
+  it->abbrev_attr_form_idx += 1;
+
+  switch (attr_form.form) {
+  case PG_DWARF_FORM_STRING:
+    PG_ASSERT(0 && "todo");
+
+  case PG_DWARF_FORM_INDIRECT: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_BLOCK: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_REF_SIG8: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_REF_SUP8: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_REF_SUP4: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_FLAG: {
+    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U8;
+    res.u.u8 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_REF_ADDR: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_IMPLICIT_CONST: {
+    res.u.u64 = attr_form.u.value;
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+  } break;
+
+  case PG_DWARF_FORM_FLAG_PRESENT: {
+    res.u.u64 = true;
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+  } break;
+
+  case PG_DWARF_FORM_STRP: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_STRP_SUP: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_LINE_STRP: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_LOCLISTX: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_UDATA: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_SDATA: {
+    PG_RESULT(i64, PgError) res_read = pg_reader_read_i64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_I64;
+    res.u.i64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_EXPRLOC: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+    u64 length = PG_UNWRAP(res_read);
+
+    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
+    res.u.bytes = PG_SLICE_RANGE(it->r.u.bytes, 0, length);
+
+    PgError err = pg_reader_discard(&it->r, length);
+    if (err) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+  } break;
+
+  case PG_DWARF_FORM_ADDR: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
+
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_BLOCK1: {
+    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U8;
+    res.u.u8 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_BLOCK2: {
+    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U16;
+    res.u.u16 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_BLOCK4: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_DATA1: {
+    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U8;
+    res.u.u8 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_DATA2: {
+    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U16;
+    res.u.u16 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_DATA4: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_DATA8: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+  case PG_DWARF_FORM_DATA16: {
+    PG_SLICE(u8)
+    dst = {
+        .data = (u8 *)&res.u.u128,
+        .len = sizeof(res.u.u128),
+    };
+    PgError err = pg_reader_read_slice_full(&it->r, dst);
+    if (err) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U128;
+  } break;
+
+  case PG_DWARF_FORM_REF1: {
+    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U8;
+    res.u.u8 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_REF2: {
+    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U16;
+    res.u.u16 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_REF4: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_REF8: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_SEC_OFFSET: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_RNGLISTX: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    // TODO: Read `.debug_rnglists` or let the caller do it (as needed)?
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_STRX: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+    u64 val = PG_UNWRAP(res_read);
+    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+
+    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
+    res.u.bytes = s;
+  } break;
+
+  case PG_DWARF_FORM_STRX1: {
+    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+    u8 val = PG_UNWRAP(res_read);
+    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+
+    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
+    res.u.bytes = s;
+  } break;
+
+  case PG_DWARF_FORM_STRX2: {
+    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+    u16 val = PG_UNWRAP(res_read);
+    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+
+    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
+    res.u.bytes = s;
+  } break;
+
+  case PG_DWARF_FORM_STRX3: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u24_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+    u32 val = PG_UNWRAP(res_read);
+    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+
+    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
+    res.u.bytes = s;
+  } break;
+
+  case PG_DWARF_FORM_STRX4: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+    u32 val = PG_UNWRAP(res_read);
+    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+
+    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
+    res.u.bytes = s;
+  } break;
+
+  case PG_DWARF_FORM_ADDRX: {
+    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_ADDRX1: {
+    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U8;
+    res.u.u8 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_ADDRX2: {
+    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U16;
+    res.u.u16 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_ADDRX3: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u24_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U32;
+    res.u.u32 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_ADDRX4: {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
+    PG_IF_LET_ERR(err, res_read) {
+      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    }
+
+    res.kind = PG_DEBUG_ATOM_KIND_U64;
+    res.u.u64 = PG_UNWRAP(res_read);
+  } break;
+
+  case PG_DWARF_FORM_NONE:
+  default:
+    return PG_ERR(PG_ERR_DWARF_UNKNOWN_FORM, PG_OPTION(PgDwarfAtom), PgError);
+  }
+
+  if (PG_DWARF_TAG_NULL != res.abbrev.tag) {
+    PG_ASSERT(PG_DWARF_AT_NONE != res.attr_form.attribute);
+    PG_ASSERT(PG_DWARF_FORM_NONE != res.attr_form.form);
+  }
+  return PG_OK(PG_SOME(res, PgDwarfAtom), PG_OPTION(PgDwarfAtom), PgError);
+}
+
+[[nodiscard]] static bool
+pg_dwarf_abbreviation_entry_is_function_like(PgDwarfAbbreviationEntry abbrev) {
+  return PG_DWARF_TAG_SUBPROGRAM == abbrev.tag ||
+         PG_DWARF_TAG_INLINED_SUBROUTINE == abbrev.tag;
+}
+
+[[maybe_unused]] [[nodiscard]] static bool
+pg_dwarf_attribute_is_name_like(PgDwarfAttribute attribute) {
+  return PG_DWARF_AT_NAME == attribute ||
+         PG_DWARF_AT_ABSTRACT_ORIGIN == attribute;
+}
+
+[[maybe_unused]] [[maybe_unused]] static PgError
+pg_dwarf_atom_println(PgWriter *w, PgDwarfAtom atom, PgAllocator *allocator) {
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("type="), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, atom.abbrev.type, allocator));
+
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" tag="), allocator));
+  PgString tag_str = pg_dwarf_tag_str[atom.abbrev.tag];
+  PG_ERR_RETURN(pg_writer_write_full(w, tag_str, allocator));
+
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" attribute="), allocator));
+  PgString attr_str = pg_dwarf_attribute_str[atom.attr_form.attribute];
+  PG_ERR_RETURN(pg_writer_write_full(w, attr_str, allocator));
+
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" form="), allocator));
+  PgString form_str = pg_dwarf_form_str[atom.attr_form.form];
+  PG_ERR_RETURN(pg_writer_write_full(w, form_str, allocator));
+
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" value="), allocator));
+  switch (atom.kind) {
+  case PG_DEBUG_ATOM_KIND_NO_DATA:
+    break;
+  case PG_DEBUG_ATOM_KIND_U8:
+    PG_ERR_RETURN(pg_writer_write_u64_hex(w, (u64)atom.u.u8, allocator));
+    break;
+  case PG_DEBUG_ATOM_KIND_U16:
+    PG_ERR_RETURN(pg_writer_write_u64_hex(w, (u64)atom.u.u16, allocator));
+    break;
+  case PG_DEBUG_ATOM_KIND_U32:
+    PG_ERR_RETURN(pg_writer_write_u64_hex(w, (u64)atom.u.u32, allocator));
+    break;
+  case PG_DEBUG_ATOM_KIND_U64:
+    PG_ERR_RETURN(pg_writer_write_u64_hex(w, atom.u.u64, allocator));
+    break;
+  case PG_DEBUG_ATOM_KIND_I64:
+    PG_ERR_RETURN(pg_writer_write_i64_as_string(w, atom.u.u64, allocator));
+    break;
+  case PG_DEBUG_ATOM_KIND_BYTES:
+    PG_ERR_RETURN(pg_writer_write_full(w, atom.u.bytes, allocator));
+    break;
+  case PG_DEBUG_ATOM_KIND_U128:
+    PG_ERR_RETURN(pg_writer_write_u128_as_string(w, atom.u.u128, allocator));
+    break;
+  default:
+    PG_ASSERT(0);
+  }
+
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
+  PG_ERR_RETURN(pg_writer_flush(w, allocator));
+
+  return 0;
+}
+
+[[nodiscard]] [[maybe_unused]] PG_OPTION(u64)
+    pg_dwarf_atom_as_u64(PgDwarfAtom atom) {
+  switch (atom.kind) {
+  case PG_DEBUG_ATOM_KIND_U8:
+    return PG_SOME(atom.u.u8, u64);
+  case PG_DEBUG_ATOM_KIND_U16:
+    return PG_SOME(atom.u.u16, u64);
+  case PG_DEBUG_ATOM_KIND_U32:
+    return PG_SOME(atom.u.u32, u64);
+  case PG_DEBUG_ATOM_KIND_U64:
+    return PG_SOME(atom.u.u64, u64);
+
+  case PG_DEBUG_ATOM_KIND_NO_DATA:
+  case PG_DEBUG_ATOM_KIND_I64:
+  case PG_DEBUG_ATOM_KIND_BYTES:
+  case PG_DEBUG_ATOM_KIND_U128:
+    return PG_NONE(u64);
+  default:
+    PG_ASSERT(0);
+  }
+}
+
+[[nodiscard]] [[maybe_unused]] PG_OPTION(bool)
+    pg_dwarf_atom_as_bool(PgDwarfAtom atom) {
+  PG_OPTION(u64) val = pg_dwarf_atom_as_u64(atom);
+  if (!val.has_value) {
+    return PG_NONE(bool);
+  }
+  return PG_SOME(val.value, bool);
+}
+
+[[nodiscard]] static PG_RESULT(PG_DYN(PgDebugFunctionDeclaration), PgError)
+    pg_dwarf_collect_functions(PgDebugInfoIterator *it,
+                               PgAllocator *allocator) {
+  PG_DYN(PgDebugFunctionDeclaration) res = {0};
+
+  PgDebugFunctionDeclaration fn = {0};
+  u64 current_die_offset = 0;
+  for (;;) {
+    PG_RESULT(PG_OPTION(PgDwarfAtom), PgError)
+    res_next = pg_dwarf_compilation_unit_debug_info_next(it);
+    PG_IF_LET_ERR(err, res_next) {
+      return PG_ERR(err, PG_DYN(PgDebugFunctionDeclaration), PgError);
+    }
+    PG_OPTION(PgDwarfAtom) atom_opt = PG_UNWRAP(res_next);
+
+    // The end.
+    if (!atom_opt.has_value) {
+      PG_DYN_PUSH(&res, fn, allocator);
+      goto end;
+    }
+
+    PgDwarfAtom atom = atom_opt.value;
+
+    // Only interested in functions.
+    if (!pg_dwarf_abbreviation_entry_is_function_like(atom.abbrev)) {
+      continue;
+    }
+
+    if (0 == current_die_offset) {
+      current_die_offset = atom.debug_info_offset;
+    }
+
+    if (current_die_offset != atom.debug_info_offset) {
+      PG_DYN_PUSH(&res, fn, allocator);
+      fn = (PgDebugFunctionDeclaration){0};
+      fn.debug_info_offset = atom.debug_info_offset;
+
+      current_die_offset = atom.debug_info_offset;
+    }
+
+    if (PG_DWARF_TAG_INLINED_SUBROUTINE == atom.abbrev.tag) {
+      fn.inlined = true;
+    }
+
+    if (PG_DWARF_AT_LOW_PC == atom.attr_form.attribute) {
+      fn.low_pc = PG_SLICE_AT(it->unit.addresses, atom.u.u64);
+      //      fprintf(stderr, "[D001] low_pc=%#lx high_pc=%#lx name=%.*s
+      //      offset=%lu\n",
+      //              fn.low_pc, fn.high_pc, PG_S_FMT(fn.name),
+      //              atom.debug_info_offset);
+    } else if (PG_DWARF_AT_NAME == atom.attr_form.attribute) {
+      fn.name = pg_string_clone(atom.u.bytes, allocator);
+      //      fprintf(stderr, "[D002] low_pc=%#lx high_pc=%#lx name=%.*s
+      //      offset=%lu\n",
+      //              fn.low_pc, fn.high_pc, PG_S_FMT(fn.name),
+      //              atom.debug_info_offset);
+    } else if (PG_DWARF_AT_HIGH_PC == atom.attr_form.attribute) {
+      fn.high_pc = fn.low_pc + atom.u.u64;
+      //      fprintf(stderr, "[D003] low_pc=%#lx high_pc=%#lx name=%.*s
+      //      offset=%lu\n",
+      //              fn.low_pc, fn.high_pc, PG_S_FMT(fn.name),
+      //              atom.debug_info_offset);
+    } else if (PG_DWARF_AT_ABSTRACT_ORIGIN == atom.attr_form.attribute) {
+      // To be resolved later.
+      PG_OPTION(u64) val_opt = pg_dwarf_atom_as_u64(atom);
+      if (!val_opt.has_value) {
+        return PG_ERR(PG_ERR_DWARF_INVALID_ATTR_FORM_VALUE,
+                      PG_DYN(PgDebugFunctionDeclaration), PgError);
+      }
+      fn.debug_info_offset_ref = val_opt.value;
+    } else if (PG_DWARF_AT_INLINE == atom.attr_form.attribute) {
+      PG_OPTION(bool) val_opt = pg_dwarf_atom_as_bool(atom);
+      if (!val_opt.has_value) {
+        return PG_ERR(PG_ERR_DWARF_INVALID_ATTR_FORM_VALUE,
+                      PG_DYN(PgDebugFunctionDeclaration), PgError);
+      }
+      fn.inlined = val_opt.value;
+    }
+  }
+
+end:
+  // TODO: This is quadratic, speed up by using a hashtrie.
+  // Also, only DIEs with the attribute/form `DW_AT_inline`/true need to be
+  // resolved.
+  PG_EACH_PTR(a, &res) {
+    if (0 == a->debug_info_offset_ref) {
+      continue;
+    }
+
+    PG_EACH_PTR(b, &res) {
+      if (a->debug_info_offset_ref == b->debug_info_offset) {
+        a->name = b->name;
+        a->inlined = b->inlined;
+      }
+    }
+  }
+
+  return PG_OK(res, PG_DYN(PgDebugFunctionDeclaration), PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_dwarf_compilation_unit_print_abbreviation(PgWriter *w,
+                                             PgDwarfDebugInfoCompilationUnit cu,
+                                             PgDwarfAbbreviationEntry abbrev,
+                                             PgAllocator *allocator) {
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("type="), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, abbrev.type, allocator));
+
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" tag="), allocator));
+  PgString tag_str = pg_dwarf_tag_str[abbrev.tag];
+  PG_ERR_RETURN(pg_writer_write_full(w, tag_str, allocator));
+
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" forms_len="), allocator));
+  PG_ERR_RETURN(
+      pg_writer_write_u64_as_string(w, abbrev.attribute_forms.len, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
+
+  PG_EACH_PTR(attr_form, &abbrev.attribute_forms) {
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("  attribute="), allocator));
+    PgString attr_str = pg_dwarf_attribute_str[attr_form->attribute];
+    PG_ERR_RETURN(pg_writer_write_full(w, attr_str, allocator));
+
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" form="), allocator));
+    PgString form_str = pg_dwarf_form_str[attr_form->form];
+    PG_ERR_RETURN(pg_writer_write_full(w, form_str, allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
+  }
+
+  if (abbrev.parent.has_value) {
+    PgDwarfAbbreviationEntry parent =
+        PG_SLICE_AT(cu.abbrevs, abbrev.parent.value.value);
+    PG_ERR_RETURN(
+        pg_dwarf_compilation_unit_print_abbreviation(w, cu, parent, allocator));
+  }
+
+  PG_ERR_RETURN(pg_writer_flush(w, allocator));
+
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_dwarf_compilation_unit_print_abbreviations(
+    PgWriter *w, PgDwarfDebugInfoCompilationUnit cu, PgAllocator *allocator) {
+  PgString kind_str = pg_dwarf_compilation_unit_kind_to_str[cu.kind];
+  PG_ERR_RETURN(pg_writer_write_full(w, kind_str, allocator));
+  PG_ERR_RETURN(
+      pg_writer_write_full(w, PG_S(" abbrev_entries_len="), allocator));
+  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, cu.abbrevs.len, allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
+
+  PG_EACH_PTR(abbrev, &cu.abbrevs) {
+    PG_ERR_RETURN(pg_dwarf_compilation_unit_print_abbreviation(w, cu, *abbrev,
+                                                               allocator));
+  }
+  return 0;
+}
+
+[[maybe_unused]] static void
+pg_self_debug_info_iterator_release(PgDebugInfoIterator dbg) {
+  if (dbg.file.data.data) {
+    munmap(dbg.file.data.data, dbg.file.data.len);
+  }
+}
+
+#endif
+
+#ifdef PG_OS_LINUX
+
+[[maybe_unused]] static void pg_thread_yield() { sched_yield(); }
+
+static void pg_futex_wait(_Atomic u32 *addr, u32 expected) {
+  // EINTR, EAGAIN (value changed) and spurious wake-ups are all fine here.
+  (void)syscall(SYS_futex, (u32 *)addr, FUTEX_WAIT_PRIVATE, expected, nullptr,
+                nullptr, 0);
+}
+
+// Like `pg_futex_wait` with an absolute deadline on the realtime clock, as
+// `pthread_cond_timedwait`. Returns `ETIMEDOUT` once the deadline is passed.
+[[nodiscard]] static PgError pg_futex_wait_until(_Atomic u32 *addr,
+                                                 u32 expected,
+                                                 const PgTime *deadline) {
+  struct timespec ts = {
+      .tv_sec = (time_t)deadline->seconds,
+      .tv_nsec = (long)deadline->nanoseconds,
+  };
+  if (-1 == syscall(SYS_futex, (u32 *)addr,
+                    FUTEX_WAIT_BITSET_PRIVATE | FUTEX_CLOCK_REALTIME,
+                    expected, &ts, nullptr, FUTEX_BITSET_MATCH_ANY) &&
+      ETIMEDOUT == errno) {
+    return ETIMEDOUT;
+  }
+  return 0;
+}
+
+static void pg_futex_wake(_Atomic u32 *addr, u32 count) {
+  (void)syscall(SYS_futex, (u32 *)addr, FUTEX_WAKE_PRIVATE, count, nullptr,
+                nullptr, 0);
+}
+
+static void pg_cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ volatile("yield");
+#endif
+}
+
+// Critical sections are typically short so it is cheaper to spin a bit before
+// paying for two syscalls (park and wake).
+#define PG_FUTEX_MUTEX_SPIN_COUNT 100
+
+[[maybe_unused]] [[nodiscard]] static bool
+pg_futex_mtx_trylock(PgFutexMutex *mtx) {
+  u32 expected = 0;
+  return atomic_compare_exchange_strong_explicit(
+      &mtx->state, &expected, 1, memory_order_acquire, memory_order_relaxed);
+}
+
+static void pg_futex_mtx_lock_contended(PgFutexMutex *mtx) {
+  // Mark as contended so that the unlocker wakes us up.
+  while (0 != atomic_exchange_explicit(&mtx->state, 2, memory_order_acquire)) {
+    pg_futex_wait(&mtx->state, 2);
+  }
+}
+
+[[maybe_unused]] static void pg_futex_mtx_lock(PgFutexMutex *mtx) {
+  if (pg_futex_mtx_trylock(mtx)) {
+    return;
+  }
+
+  for (u64 i = 0; i < PG_FUTEX_MUTEX_SPIN_COUNT; i++) {
+    pg_cpu_relax();
+
+    if (0 == atomic_load_explicit(&mtx->state, memory_order_relaxed) &&
+        pg_futex_mtx_trylock(mtx)) {
+      return;
+    }
+  }
+
+  pg_futex_mtx_lock_contended(mtx);
+}
+
+[[maybe_unused]] static void pg_futex_mtx_unlock(PgFutexMutex *mtx) {
+  u32 prev = atomic_exchange_explicit(&mtx->state, 0, memory_order_release);
+  PG_ASSERT(0 != prev);
+
+  if (2 == prev) {
+    pg_futex_wake(&mtx->state, 1);
+  }
+}
+
+[[maybe_unused]] static void pg_futex_cnd_wait(PgFutexConditionVar *cnd,
+                                               PgFutexMutex *mtx) {
+  atomic_fetch_add(&cnd->waiters, 1);
+  u32 seq = atomic_load(&cnd->seq);
 
-static const PgString pg_dwarf_form_str[] = {
-    [PG_DWARF_FORM_NONE] = PG_S("PG_DWARF_FORM_NONE"),
-    [PG_DWARF_FORM_ADDR] = PG_S("PG_DWARF_FORM_ADDR"),
-    [PG_DWARF_FORM_BLOCK2] = PG_S("PG_DWARF_FORM_BLOCK2"),
-    [PG_DWARF_FORM_BLOCK4] = PG_S("PG_DWARF_FORM_BLOCK4"),
-    [PG_DWARF_FORM_DATA2] = PG_S("PG_DWARF_FORM_DATA2"),
-    [PG_DWARF_FORM_DATA4] = PG_S("PG_DWARF_FORM_DATA4"),
-    [PG_DWARF_FORM_DATA8] = PG_S("PG_DWARF_FORM_DATA8"),
-    [PG_DWARF_FORM_STRING] = PG_S("PG_DWARF_FORM_STRING"),
-    [PG_DWARF_FORM_BLOCK] = PG_S("PG_DWARF_FORM_BLOCK"),
-    [PG_DWARF_FORM_BLOCK1] = PG_S("PG_DWARF_FORM_BLOCK1"),
-    [PG_DWARF_FORM_DATA1] = PG_S("PG_DWARF_FORM_DATA1"),
-    [PG_DWARF_FORM_FLAG] = PG_S("PG_DWARF_FORM_FLAG"),
-    [PG_DWARF_FORM_SDATA] = PG_S("PG_DWARF_FORM_SDATA"),
-    [PG_DWARF_FORM_STRP] = PG_S("PG_DWARF_FORM_STRP"),
-    [PG_DWARF_FORM_UDATA] = PG_S("PG_DWARF_FORM_UDATA"),
-    [PG_DWARF_FORM_REF_ADDR] = PG_S("PG_DWARF_FORM_REF_ADDR"),
-    [PG_DWARF_FORM_REF1] = PG_S("PG_DWARF_FORM_REF1"),
-    [PG_DWARF_FORM_REF2] = PG_S("PG_DWARF_FORM_REF2"),
-    [PG_DWARF_FORM_REF4] = PG_S("PG_DWARF_FORM_REF4"),
-    [PG_DWARF_FORM_REF8] = PG_S("PG_DWARF_FORM_REF8"),
-    [PG_DWARF_FORM_REF_UDATA] = PG_S("PG_DWARF_FORM_REF_UDATA"),
-    [PG_DWARF_FORM_INDIRECT] = PG_S("PG_DWARF_FORM_INDIRECT"),
-    [PG_DWARF_FORM_SEC_OFFSET] = PG_S("PG_DWARF_FORM_SEC_OFFSET"),
-    [PG_DWARF_FORM_EXPRLOC] = PG_S("PG_DWARF_FORM_EXPRLOC"),
-    [PG_DWARF_FORM_FLAG_PRESENT] = PG_S("PG_DWARF_FORM_FLAG_PRESENT"),
-    [PG_DWARF_FORM_STRX] = PG_S("PG_DWARF_FORM_STRX"),
-    [PG_DWARF_FORM_ADDRX] = PG_S("PG_DWARF_FORM_ADDRX"),
-    [PG_DWARF_FORM_REF_SUP4] = PG_S("PG_DWARF_FORM_REF_SUP4"),
-    [PG_DWARF_FORM_STRP_SUP] = PG_S("PG_DWARF_FORM_STRP_SUP"),
-    [PG_DWARF_FORM_DATA16] = PG_S("PG_DWARF_FORM_DATA16"),
-    [PG_DWARF_FORM_LINE_STRP] = PG_S("PG_DWARF_FORM_LINE_STRP"),
-    [PG_DWARF_FORM_REF_SIG8] = PG_S("PG_DWARF_FORM_REF_SIG8"),
-    [PG_DWARF_FORM_IMPLICIT_CONST] = PG_S("PG_DWARF_FORM_IMPLICIT_CONST"),
-    [PG_DWARF_FORM_LOCLISTX] = PG_S("PG_DWARF_FORM_LOCLISTX"),
-    [PG_DWARF_FORM_RNGLISTX] = PG_S("PG_DWARF_FORM_RNGLISTX"),
-    [PG_DWARF_FORM_REF_SUP8] = PG_S("PG_DWARF_FORM_REF_SUP8"),
-    [PG_DWARF_FORM_STRX1] = PG_S("PG_DWARF_FORM_STRX1"),
-    [PG_DWARF_FORM_STRX2] = PG_S("PG_DWARF_FORM_STRX2"),
-    [PG_DWARF_FORM_STRX3] = PG_S("PG_DWARF_FORM_STRX3"),
-    [PG_DWARF_FORM_STRX4] = PG_S("PG_DWARF_FORM_STRX4"),
-    [PG_DWARF_FORM_ADDRX1] = PG_S("PG_DWARF_FORM_ADDRX1"),
-    [PG_DWARF_FORM_ADDRX2] = PG_S("PG_DWARF_FORM_ADDRX2"),
-    [PG_DWARF_FORM_ADDRX3] = PG_S("PG_DWARF_FORM_ADDRX3"),
-    [PG_DWARF_FORM_ADDRX4] = PG_S("PG_DWARF_FORM_ADDRX4"),
-};
+  pg_futex_mtx_unlock(mtx);
+  pg_futex_wait(&cnd->seq, seq);
+  atomic_fetch_sub(&cnd->waiters, 1);
+
+  // Other threads may be parked on the mutex: we cannot know, so assume
+  // contention to not miss their wake-up on unlock.
+  pg_futex_mtx_lock_contended(mtx);
+}
+
+// Returns `ETIMEDOUT` if not woken up before `deadline`. The mutex is held
+// again in both cases.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_futex_cnd_timedwait(PgFutexConditionVar *cnd, PgFutexMutex *mtx,
+                       const PgTime *deadline) {
+  atomic_fetch_add(&cnd->waiters, 1);
+  u32 seq = atomic_load(&cnd->seq);
+
+  pg_futex_mtx_unlock(mtx);
+  PgError err = pg_futex_wait_until(&cnd->seq, seq, deadline);
+  atomic_fetch_sub(&cnd->waiters, 1);
+
+  pg_futex_mtx_lock_contended(mtx);
+  return err;
+}
+
+[[maybe_unused]] static void pg_futex_cnd_signal(PgFutexConditionVar *cnd) {
+  atomic_fetch_add(&cnd->seq, 1);
+  if (atomic_load(&cnd->waiters) > 0) {
+    pg_futex_wake(&cnd->seq, 1);
+  }
+}
+
+[[maybe_unused]] static void pg_futex_cnd_broadcast(PgFutexConditionVar *cnd) {
+  atomic_fetch_add(&cnd->seq, 1);
+  if (atomic_load(&cnd->waiters) > 0) {
+    pg_futex_wake(&cnd->seq, INT32_MAX);
+  }
+}
+
+[[maybe_unused]] static void pg_futex_rwlock_read_lock(PgFutexRwLock *rw) {
+  for (;;) {
+    u32 state = atomic_load_explicit(&rw->state, memory_order_relaxed);
+    if (state < PG_FUTEX_RWLOCK_WRITE_LOCKED - 1) {
+      if (atomic_compare_exchange_weak_explicit(&rw->state, &state, state + 1,
+                                                memory_order_acquire,
+                                                memory_order_relaxed)) {
+        return;
+      }
+      continue;
+    }
+
+    atomic_fetch_add(&rw->waiters, 1);
+    pg_futex_wait(&rw->state, state);
+    atomic_fetch_sub(&rw->waiters, 1);
+  }
+}
+
+[[maybe_unused]] static void pg_futex_rwlock_read_unlock(PgFutexRwLock *rw) {
+  u32 prev = atomic_fetch_sub(&rw->state, 1);
+  PG_ASSERT(0 != prev);
+  PG_ASSERT(PG_FUTEX_RWLOCK_WRITE_LOCKED != prev);
+
+  // Last reader out: let writers in.
+  if (1 == prev && atomic_load(&rw->waiters) > 0) {
+    pg_futex_wake(&rw->state, INT32_MAX);
+  }
+}
+
+[[maybe_unused]] static void pg_futex_rwlock_write_lock(PgFutexRwLock *rw) {
+  for (;;) {
+    u32 state = 0;
+    if (atomic_compare_exchange_strong_explicit(
+            &rw->state, &state, PG_FUTEX_RWLOCK_WRITE_LOCKED,
+            memory_order_acquire, memory_order_relaxed)) {
+      return;
+    }
+
+    atomic_fetch_add(&rw->waiters, 1);
+    pg_futex_wait(&rw->state, state);
+    atomic_fetch_sub(&rw->waiters, 1);
+  }
+}
+
+[[maybe_unused]] static void pg_futex_rwlock_write_unlock(PgFutexRwLock *rw) {
+  PG_ASSERT(PG_FUTEX_RWLOCK_WRITE_LOCKED == atomic_load(&rw->state));
+
+  atomic_store(&rw->state, 0);
+  if (atomic_load(&rw->waiters) > 0) {
+    pg_futex_wake(&rw->state, INT32_MAX);
+  }
+}
+
+[[maybe_unused]] static void pg_latch_init(PgLatch *latch, u32 count) {
+  atomic_init(&latch->count, count);
+}
+
+[[maybe_unused]] static void pg_latch_count_down(PgLatch *latch) {
+  u32 prev = atomic_fetch_sub_explicit(&latch->count, 1, memory_order_release);
+  PG_ASSERT(0 != prev);
+
+  if (1 == prev) {
+    pg_futex_wake(&latch->count, INT32_MAX);
+  }
+}
+
+[[maybe_unused]] static void pg_latch_wait(PgLatch *latch) {
+  for (;;) {
+    u32 count = atomic_load_explicit(&latch->count, memory_order_acquire);
+    if (0 == count) {
+      return;
+    }
+
+    pg_futex_wait(&latch->count, count);
+  }
+}
+
+#ifdef PG_SYNC_FUTEX
+// Cached since it is needed on each lock of a recursive mutex.
+[[nodiscard]] static u32 pg_thread_id() {
+  static _Thread_local u32 id = 0;
+  if (0 == id) {
+    id = (u32)syscall(SYS_gettid);
+  }
+  return id;
+}
+
+[[maybe_unused]] [[nodiscard]] PgError pg_mtx_init(PgMutex *mutex,
+                                                   PgMutexKind type) {
+  atomic_init(&mutex->inner.state, 0);
+  atomic_init(&mutex->owner, 0);
+  mutex->depth = 0;
+  mutex->recursive = PG_MUTEX_KIND_RECURSIVE == type;
+  return 0;
+}
+
+[[maybe_unused]] void pg_mtx_destroy(PgMutex *mutex) { (void)mutex; }
+
+// Only the owner itself may observe its own id in `owner`, so relaxed loads
+// are enough.
+[[nodiscard]] static bool pg_mtx_owned(PgMutex *mutex) {
+  return mutex->recursive &&
+         pg_thread_id() ==
+             atomic_load_explicit(&mutex->owner, memory_order_relaxed);
+}
+
+static void pg_mtx_set_owner(PgMutex *mutex) {
+  if (mutex->recursive) {
+    atomic_store_explicit(&mutex->owner, pg_thread_id(), memory_order_relaxed);
+  }
+  mutex->depth = 1;
+}
+
+[[maybe_unused]] [[nodiscard]] PgError pg_mtx_lock(PgMutex *mutex) {
+  if (pg_mtx_owned(mutex)) {
+    mutex->depth += 1;
+    return 0;
+  }
+
+  pg_futex_mtx_lock(&mutex->inner);
+  pg_mtx_set_owner(mutex);
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] PgError pg_mtx_trylock(PgMutex *mutex) {
+  if (pg_mtx_owned(mutex)) {
+    mutex->depth += 1;
+    return 0;
+  }
+
+  if (!pg_futex_mtx_trylock(&mutex->inner)) {
+    return EBUSY;
+  }
+  pg_mtx_set_owner(mutex);
+  return 0;
+}
+
+// Like pthread, unlocking a recursive mutex held by another thread fails with
+// `EPERM`.
+[[maybe_unused]] [[nodiscard]] PgError pg_mtx_unlock(PgMutex *mutex) {
+  if (mutex->recursive) {
+    if (!pg_mtx_owned(mutex)) {
+      return EPERM;
+    }
+
+    mutex->depth -= 1;
+    if (mutex->depth > 0) {
+      return 0;
+    }
+    atomic_store_explicit(&mutex->owner, 0, memory_order_relaxed);
+  }
+
+  pg_futex_mtx_unlock(&mutex->inner);
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] PgError pg_cnd_init(PgConditionVar *cond) {
+  atomic_init(&cond->seq, 0);
+  atomic_init(&cond->waiters, 0);
+  return 0;
+}
+
+[[maybe_unused]] void pg_cnd_destroy(PgConditionVar *cond) { (void)cond; }
+
+// The mutex is fully released while waiting, even when locked recursively,
+// and restored to the same depth afterwards.
+[[maybe_unused]] [[nodiscard]] PgError pg_cnd_wait(PgConditionVar *cond,
+                                                   PgMutex *mutex) {
+  u32 depth = mutex->depth;
+  atomic_store_explicit(&mutex->owner, 0, memory_order_relaxed);
+
+  pg_futex_cnd_wait(cond, &mutex->inner);
+
+  pg_mtx_set_owner(mutex);
+  mutex->depth = depth;
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] PgError
+pg_cnd_timedwait(PgConditionVar *cond, PgMutex *mutex,
+                 const PgTime *time_point) {
+  u32 depth = mutex->depth;
+  atomic_store_explicit(&mutex->owner, 0, memory_order_relaxed);
+
+  PgError err = pg_futex_cnd_timedwait(cond, &mutex->inner, time_point);
+
+  pg_mtx_set_owner(mutex);
+  mutex->depth = depth;
+  return err;
+}
+
+[[maybe_unused]] [[nodiscard]] PgError pg_cnd_broadcast(PgConditionVar *cond) {
+  pg_futex_cnd_broadcast(cond);
+  return 0;
+}
+
+[[maybe_unused]] [[nodiscard]] PgError pg_cnd_signal(PgConditionVar *cond) {
+  pg_futex_cnd_signal(cond);
+  return 0;
+}
+#endif
+
+[[maybe_unused]] [[nodiscard]] static PgString pg_self_exe_get_path() {
+  static _Atomic PgOnce once = PG_ONCE_UNINITIALIZED;
+  static char path_c[PG_PATH_MAX] = {0};
+  static PgString res = {0};
+
+  if (pg_once_do(&once)) {
+    i32 ret = 0;
+    do {
+      ret = readlink("/proc/self/exe", path_c, PG_STATIC_ARRAY_LEN(path_c));
+    } while (-1 == ret && EINTR == errno);
+    if (-1 == errno) {
+      return res;
+    }
+
+    res = pg_cstr_to_string(path_c);
+
+    pg_once_mark_as_done(&once);
+  }
+
+  PG_ASSERT(!pg_string_is_empty(res));
+  return res;
+}
+
+[[nodiscard]] static u64 pg_self_pie_get_offset() {
+  static _Atomic PgOnce once = PG_ONCE_UNINITIALIZED;
+  static u64 res = 0;
+
+  if (pg_once_do(&once)) {
+    u8 mem[4096] = {0};
+    PgArena arena = pg_arena_make_from_mem(mem, PG_STATIC_ARRAY_LEN(mem));
+    PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+    PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+    PG_RESULT(PgFileDescriptor, PgError)
+    res_fd = pg_file_open(PG_S("/proc/self/maps"), PG_FILE_ACCESS_READ, 0600,
+                          false, allocator);
+    PG_IF_LET_ERR(err, res_fd) {
+      PG_UNUSED(err);
+      goto end_once;
+    }
+    PgFileDescriptor fd = PG_UNWRAP(res_fd);
+
+    PgReader r = pg_reader_make_from_file(fd, 512, allocator);
+
+    u64 max_lines = 512;
+
+    for (u64 _i = 0; _i < max_lines; _i++) {
+      u8 line[512] = {0};
+      PgString line_slice = PG_SLICE_FROM_C(line);
+      PG_RESULT(PG_OPTION(u64), PgError)
+      res_line = pg_reader_read_line(&r, PG_NEWLINE_KIND_LF, line_slice);
+      PG_IF_LET_ERR(err, res_line) {
+        PG_UNUSED(err);
+        goto end_file;
+      }
+      PG_OPTION(u64) line_opt = PG_UNWRAP(res_line);
+      if (!line_opt.has_value) {
+        goto end_file;
+      }
+      line_slice.len = line_opt.value;
+
+      PgStringCut cut_space = pg_string_cut_rune(line_slice, ' ');
+      if (!cut_space.has_value) {
+        continue;
+      }
+
+      PgString mem_range = cut_space.left;
+      PgString perms = cut_space.right;
+
+      if (!pg_string_contains_rune(perms, 'x')) {
+        continue;
+      }
+
+      PgStringCut cut_dash = pg_string_cut_rune(mem_range, '-');
+      if (!cut_dash.has_value) {
+        continue;
+      }
+
+      PgParseNumberResult res_mem_start =
+          pg_string_parse_u64(cut_dash.left, 16, false);
+      if (!res_mem_start.present) {
+        continue;
+      }
+
+      PgParseNumberResult res_mem_end =
+          pg_string_parse_u64(cut_dash.right, 16, false);
+      if (!res_mem_end.present) {
+        continue;
+      }
+
+      u64 start = res_mem_start.n;
+      u64 end = res_mem_end.n;
+      PG_ASSERT(0 == (start % pg_os_get_page_size()));
+      PG_ASSERT(0 == (end % pg_os_get_page_size()));
 
-[[nodiscard]] static PG_RESULT(PG_OPTION(PgDwarfAbbreviationEntry), PgError)
-    pg_dwarf_parse_abbreviation_entry(PgReader *r, PgAllocator *allocator) {
-  PgDwarfAbbreviationEntry entry = {0};
+      if (start <= (u64)&pg_self_pie_get_offset &&
+          (u64)&pg_self_pie_get_offset < end) {
+        res = start;
+        goto end_file;
+      }
+    }
+  end_file:
+    (void)pg_file_close(fd);
 
-  // Tag.
+  end_once:
+    pg_once_mark_as_done(&once);
+  }
+
+  return res;
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgDebugInfoIterator, PgError)
+    pg_self_debug_info_iterator_make(PgAllocator *allocator) {
+  PgDebugInfoIterator res = {0};
+  PgError err = 0;
+
+  PgString exe_path = pg_self_exe_get_path();
+  if (pg_string_is_empty(exe_path)) {
+    return PG_OK(res, PgDebugInfoIterator, PgError);
+  }
+
+  // TODO: Only read the relevant parts.
+  // Depending on the size of the executable.
+  PG_RESULT(PgVirtualMemFile, PgError)
+  res_file = pg_virtual_mem_map_file(exe_path, PG_FILE_ACCESS_READ, false);
+  PG_IF_LET_ERR(err, res_file) {
+    return PG_ERR(err, PgDebugInfoIterator, PgError);
+  }
+  res.file = PG_UNWRAP(res_file);
+
+  // TODO: Other formats.
+  // Parse ELF.
   {
-    PG_RESULT(u64, PgError) res_type = pg_reader_read_u64_leb128(r);
-    PG_IF_LET_ERR(err, res_type) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+    PG_RESULT(PgElf, PgError) res_elf = pg_elf_parse(res.file.data);
+    PG_IF_LET_ERR(_err, res_elf) {
+      err = _err;
+      goto end;
     }
+    res.elf = PG_UNWRAP(res_elf);
+  }
 
-    entry.type = PG_UNWRAP(res_type);
+  // Parse compilation unit.
+  {
+    PG_RESULT(PgDwarfDebugInfoCompilationUnit, PgError)
+    res_unit = pg_dwarf_parse_debug_info(res.elf, allocator);
+    PG_IF_LET_ERR(_err, res_unit) {
+      err = _err;
+      goto end;
+    }
+    res.unit = PG_UNWRAP(res_unit);
   }
-  // Type.
+
+  // Setup reader on `.debug_info`.
   {
-    PG_RESULT(u64, PgError) res_tag = pg_reader_read_u64_leb128(r);
-    // The end?
-    // > The abbreviations for a given compilation unit end with an entry
-    // > consisting of a 0 byte for the abbreviation code.
-    PG_IF_LET_ERR(err, res_tag) {
-      if (PG_ERR_EOF == err && 0 == entry.type) {
-        return PG_OK({}, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
-      }
-      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+    PG_RESULT(PG_SLICE(u8), PgError)
+    res_info_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
+        res.elf, PG_S(".debug_info"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
+    PG_IF_LET_ERR(_err, res_info_bytes) {
+      err = _err;
+      goto end;
     }
+    PgString info_bytes = PG_UNWRAP(res_info_bytes);
+    res.debug_info_full = info_bytes;
 
-    entry.tag = PG_UNWRAP(res_tag);
+    u64 offset = pg_dwarf_compilation_unit_get_data_offset(res.unit);
+    info_bytes = PG_SLICE_RANGE_START(info_bytes, offset);
+
+    res.r = pg_reader_make_from_bytes(info_bytes);
+  }
+
+  // Set string section.
+  {
+    PG_RESULT(PG_SLICE(u8), PgError)
+    res_str_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
+        res.elf, PG_S(".debug_str"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
+    PG_IF_LET_ERR(_err, res_str_bytes) {
+      err = _err;
+      goto end;
+    }
+    res.str_bytes = PG_UNWRAP(res_str_bytes);
+  }
+
+  // Set string offsets section.
+  {
+    PG_RESULT(PG_SLICE(u8), PgError)
+    res_str_offsets_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
+        res.elf, PG_S(".debug_str_offsets"),
+        PG_ELF_SECTION_HEADER_KIND_PROGBITS);
+    PG_IF_LET_ERR(_err, res_str_offsets_bytes) {
+      err = _err;
+      goto end;
+    }
+    PG_SLICE(u8) str_offsets_bytes = PG_UNWRAP(res_str_offsets_bytes);
+    // Check that the header is present.
+    if (str_offsets_bytes.len < 8) {
+      err = PG_ERR_INVALID_VALUE;
+      goto end;
+    }
+    str_offsets_bytes = PG_SLICE_RANGE_START(str_offsets_bytes, 8);
+    if (0 != (str_offsets_bytes.len % 4)) {
+      err = PG_ERR_INVALID_VALUE;
+      goto end;
+    }
+    // TODO: Should we check alignment (`0 != ((u64)str_offsets_bytes.data %
+    // 4`)?
+    PG_SLICE(u32)
+    str_offsets = {
+        .data = (u32 *)str_offsets_bytes.data,
+        .len = str_offsets_bytes.len / 4,
+    };
+    res.str_offsets = str_offsets;
+  }
+
+end:
+  if (err) {
+    pg_self_debug_info_iterator_release(res);
+  }
+  return PG_OK(res, PgDebugInfoIterator, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_aio_inotify_init() {
+  PgFileDescriptor res = {0};
+
+  i32 ret = 0;
+  do {
+    ret = inotify_init();
+  } while (-1 == ret && EINTR == errno);
+
+  if (-1 == ret) {
+    return PG_ERR(errno, PgFileDescriptor, PgError);
+  }
+
+  res.fd = ret;
+  return PG_OK(res, PgFileDescriptor, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_aio_inotify_register_interest(PgAio aio, PgString name,
+                                     PgAioEventKind interest) {
+  PgFileDescriptor res = {0};
+
+  if (0 == name.len) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgFileDescriptor, PgError);
+  }
+
+  u32 interest_linux = 0;
+  // A file renamed in or out of a directory is created or deleted there, which
+  // is how files are replaced atomically.
+  if (interest & PG_AIO_EVENT_KIND_FILE_CREATED) {
+    interest_linux |= IN_CREATE | IN_MOVED_TO;
+  }
+  if (interest & PG_AIO_EVENT_KIND_FILE_MODIFIED) {
+    interest_linux |= IN_MODIFY;
+  }
+  if (interest & PG_AIO_EVENT_KIND_FILE_DELETED) {
+    interest_linux |= IN_DELETE | IN_MOVED_FROM;
+  }
+
+  u8 name_c[4096] = {0};
+  PG_ASSERT(name.data);
+  PG_ASSERT(name.len < PG_STATIC_ARRAY_LEN(name_c));
+  pg_memcpy(name_c, name.data, name.len);
+
+  i32 ret = 0;
+  do {
+    ret = inotify_add_watch(aio.inotify.value.fd, (const char *)name_c,
+                            interest_linux);
+  } while (-1 == ret && EINTR == errno);
+
+  if (-1 == ret) {
+    return PG_ERR(errno, PgFileDescriptor, PgError);
+  }
+
+  res.fd = ret;
+
+  return PG_OK(res, PgFileDescriptor, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgAio, PgError) pg_aio_init() {
+  PgAio res = {0};
+
+  i32 ret = 0;
+  do {
+    ret = epoll_create(1 /*Ignored*/);
+  } while (-1 == ret && EINTR == errno);
+
+  if (-1 == ret) {
+    return PG_ERR(errno, PgAio, PgError);
+  }
+
+  res.aio.fd = ret;
+  return PG_OK(res, PgAio, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_aio_ensure_inotify(PgAio *aio) {
+  PG_ASSERT(aio);
+
+  if (aio->inotify.has_value) {
+    return 0;
+  }
+
+  PG_RESULT(PgFileDescriptor, PgError) res = pg_aio_inotify_init();
+  PG_IF_LET_ERR(err, res) { return err; }
+
+  aio->inotify.has_value = true;
+  aio->inotify.value = PG_UNWRAP(res);
+
+  return pg_aio_register_interest_fd(*aio, aio->inotify.value,
+                                     PG_AIO_EVENT_KIND_READABLE);
+}
+
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_aio_register_interest_fs_name(PgAio *aio, PgString name,
+                                     PgAioEventKind interest,
+                                     PgAllocator *allocator) {
+  PgError err = pg_aio_ensure_inotify(aio);
+  if (err) {
+    return PG_ERR(err, PgFileDescriptor, PgError);
+  }
+
+  PgFileDescriptor fd =
+      PG_TRY(pg_aio_inotify_register_interest(*aio, name, interest),
+             PgFileDescriptor, PgError);
+
+  PgAioFsNode *fs_node = pg_aio_fs_node_upsert(&aio->fs_nodes, fd, allocator);
+  PG_ASSERT(fs_node);
+  // Watching a name again returns the same watch.
+  if (!fs_node->name.data) {
+    fs_node->name = name;
+  }
+
+  return PG_OK(fd, PgFileDescriptor, PgError);
+}
+
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_aio_register_interest_fd(PgAio aio, PgFileDescriptor fd,
+                            PgAioEventKind interest) {
+  struct epoll_event event = {0};
+  event.data.fd = fd.fd;
+
+  if (interest & PG_AIO_EVENT_KIND_READABLE) {
+    event.events |= EPOLLIN;
+  }
+  if (interest & PG_AIO_EVENT_KIND_WRITABLE) {
+    event.events |= EPOLLOUT;
   }
-  // Has children.
-  {
-    PG_RESULT(u8, PgError) res_has_children = pg_reader_read_u8_le(r);
-    PG_IF_LET_ERR(err, res_has_children) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
-    }
-    entry.has_children = PG_UNWRAP(res_has_children);
+
+  i32 ret = 0;
+  do {
+    ret = epoll_ctl(aio.aio.fd, EPOLL_CTL_ADD, fd.fd, &event);
+  } while (-1 == ret && EINTR == errno);
+
+  if (-1 == ret) {
+    return (PgError)errno;
   }
 
-  // Attributes.
-  for (u64 _i = 0; _i < PG_DWARF_MAX_ABBREV_ATTRIBUTES; _i++) {
-    PgDwarfAttributeForm attribute_form = {0};
+  return 0;
+}
 
-    PG_RESULT(u64, PgError) res_name = pg_reader_read_u64_leb128(r);
-    PG_IF_LET_ERR(err, res_name) {
-      // The end.
-      if (PG_ERR_EOF == err) {
-        return PG_OK(PG_SOME(entry, PgDwarfAbbreviationEntry),
-                     PG_OPTION(PgDwarfAbbreviationEntry), PgError);
-      }
-      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
-    }
-    attribute_form.attribute = PG_UNWRAP(res_name);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_aio_unregister_interest(PgAio aio, PgFileDescriptor fd,
+                           PgAioEventKind interest) {
+  struct epoll_event event = {0};
+  event.data.fd = fd.fd;
 
-    PG_RESULT(u64, PgError) res_form = pg_reader_read_u64_leb128(r);
-    PG_IF_LET_ERR(err, res_form) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
-    }
-    attribute_form.form = PG_UNWRAP(res_form);
+  if (interest & PG_AIO_EVENT_KIND_READABLE) {
+    event.events |= EPOLLIN;
+  }
+  if (interest & PG_AIO_EVENT_KIND_WRITABLE) {
+    event.events |= EPOLLOUT;
+  }
 
-    // End.
-    if (0 == attribute_form.attribute && 0 == attribute_form.form) {
-      return PG_OK(PG_SOME(entry, PgDwarfAbbreviationEntry),
-                   PG_OPTION(PgDwarfAbbreviationEntry), PgError);
-    }
+  i32 ret = 0;
+  do {
+    ret = epoll_ctl(aio.aio.fd, EPOLL_CTL_DEL, fd.fd, &event);
+  } while (-1 == ret && EINTR == errno);
 
-    // Need to read one more field?
-    if (PG_DWARF_FORM_IMPLICIT_CONST == attribute_form.form) {
-      PG_RESULT(i64, PgError) res_value = pg_reader_read_i64_leb128(r);
-      PG_IF_LET_ERR(err, res_value) {
-        return PG_ERR(err, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
-      }
-      attribute_form.u.value = PG_UNWRAP(res_value);
-    }
-    PG_DYN_PUSH(&entry.attribute_forms, attribute_form, allocator);
+  if (-1 == ret) {
+    return (PgError)errno;
   }
 
-  return PG_ERR(PG_ERR_TOO_BIG, PG_OPTION(PgDwarfAbbreviationEntry), PgError);
+  return 0;
 }
 
-[[nodiscard]] static PG_RESULT(PG_DYN(PgDwarfAbbreviationEntry), PgError)
-    pg_dwarf_parse_abbreviation_entries(PgElf elf, u64 offset,
-                                        PgAllocator *allocator) {
-  PG_DYN(PgDwarfAbbreviationEntry) res = {0};
-
-  PG_RESULT(PG_SLICE(u8), PgError)
-  res_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
-      elf, PG_S(".debug_abbrev"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
-  PG_IF_LET_ERR(err, res_bytes) {
-    return PG_ERR(err, PG_DYN(PgDwarfAbbreviationEntry), PgError);
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_aio_wait_once(PgAio aio, PG_SLICE(PgAioEvent) events_out,
+                     PG_OPTION(u32) timeout_ms) {
+  // Expired timers are reported without waiting.
+  u64 expired = pg_aio_timers_expire(aio, events_out);
+  if (expired > 0) {
+    return PG_OK(expired, u64, PgError);
   }
-  PG_SLICE(u8) bytes = PG_UNWRAP(res_bytes);
 
-  if (offset >= bytes.len) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PgDwarfAbbreviationEntry),
-                  PgError);
+  struct epoll_event events[1024] = {0};
+  u64 events_len = PG_MIN(events_out.len, PG_STATIC_ARRAY_LEN(events));
+
+  i32 ret = 0;
+  do {
+    ret = epoll_wait(aio.aio.fd, events, (i32)events_len,
+                     timeout_ms.has_value ? (i32)timeout_ms.value : -1);
+  } while (-1 == ret && EINTR == errno);
+
+  if (-1 == ret) {
+    return PG_ERR(errno, u64, PgError);
   }
-  bytes = PG_SLICE_RANGE_START(bytes, offset);
-  PG_DYN_ENSURE_CAP(&res, bytes.len / 4, allocator);
 
-  PgReader r = pg_reader_make_from_bytes(bytes);
+  u64 res = (u64)ret;
 
-  PG_OPTION(PgDwarfAbbreviationEntryIndex) parent = {0};
+  for (u64 i = 0; i < (u64)ret; i++) {
+    struct epoll_event e =
+        PG_C_ARRAY_AT(events, PG_STATIC_ARRAY_LEN(events), i);
 
-  for (u64 _i = 0; _i < PG_DWARF_MAX_ABBREV; _i++) {
-    PG_RESULT(PG_OPTION(PgDwarfAbbreviationEntry), PgError)
-    res_abbrev = pg_dwarf_parse_abbreviation_entry(&r, allocator);
-    PG_IF_LET_ERR(err, res_abbrev) {
-      return PG_ERR(err, PG_DYN(PgDwarfAbbreviationEntry), PgError);
-    }
-    PG_OPTION(PgDwarfAbbreviationEntry) abbrev_opt = PG_UNWRAP(res_abbrev);
-    if (abbrev_opt.has_value) {
-      PgDwarfAbbreviationEntry abbrev = abbrev_opt.value;
-      abbrev.parent = parent;
-      PG_DYN_PUSH(&res, abbrev, allocator);
+    PG_SLICE_AT(events_out, i).fd.fd = e.data.fd;
 
-      if (abbrev.has_children) {
-        parent =
-            PG_SOME({PG_SLICE_LAST_INDEX(res)}, PgDwarfAbbreviationEntryIndex);
-      } else {
-        parent = PG_NONE(PgDwarfAbbreviationEntryIndex);
-      }
-    } else { // The end.
-      return PG_OK(res, PG_DYN(PgDwarfAbbreviationEntry), PgError);
+    if (e.events & EPOLLIN) {
+      PG_SLICE_AT(events_out, i).kind |= PG_AIO_EVENT_KIND_READABLE;
+    }
+    if (e.events & EPOLLOUT) {
+      PG_SLICE_AT(events_out, i).kind |= PG_AIO_EVENT_KIND_WRITABLE;
+    }
+    if (e.events & EPOLLERR) {
+      PG_SLICE_AT(events_out, i).kind |= PG_AIO_EVENT_KIND_ERROR;
+    }
+    if (e.events & EPOLLHUP) {
+      PG_SLICE_AT(events_out, i).kind |= PG_AIO_EVENT_KIND_EOF;
     }
   }
 
-  return PG_ERR(PG_ERR_TOO_BIG, PG_DYN(PgDwarfAbbreviationEntry), PgError);
-}
-
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(
-    PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError)
-    pg_dwarf_address_ranges_parse(PG_SLICE(u8) bytes, PG_DYN(u64) addresses,
-                                  PgAllocator *allocator) {
-  PG_DYN(PG_DYN(PgDwarfRangeListEntry)) res = {0};
+  res += pg_aio_timers_expire(aio, PG_SLICE_RANGE_START(events_out, res));
 
-  PgReader r = pg_reader_make_from_bytes(bytes);
+  return PG_OK(res, u64, PgError);
+}
 
-  PG_RESULT(u32, PgError) res_length = pg_reader_read_u32_le(&r);
-  PG_IF_LET_ERR(err, res_length) {
-    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-  }
-  u32 length = PG_UNWRAP(res_length);
-  u32 expected_length = 0;
-  if (__builtin_add_overflow(length, 4, &expected_length)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
-                  PgError);
-  }
-  if (expected_length != bytes.len) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
-                  PgError);
+[[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_aio_wait_cqe_once(PgAio aio, PgRing *cqe, PG_OPTION(u32) timeout_ms) {
+  // Expired timers are reported without waiting.
+  u64 expired = pg_aio_timers_expire_cqe(aio, cqe);
+  if (expired > 0) {
+    return PG_OK(expired, u64, PgError);
   }
 
-  PG_RESULT(u16, PgError) res_version = pg_reader_read_u16_le(&r);
-  PG_IF_LET_ERR(err, res_version) {
-    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-  }
-  u16 version = PG_UNWRAP(res_version);
-  if (5 != version) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
-                  PgError);
-  }
+  struct epoll_event events[1024] = {0};
+  u64 can_write_count = pg_ring_can_write_count(*cqe) / sizeof(PgAioEvent);
+  u64 events_len = PG_MIN(can_write_count, PG_STATIC_ARRAY_LEN(events));
 
-  PG_RESULT(u8, PgError) res_address_size = pg_reader_read_u8_le(&r);
-  PG_IF_LET_ERR(err, res_address_size) {
-    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-  }
-  u8 address_size = PG_UNWRAP(res_address_size);
-  if (8 != address_size) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
-                  PgError);
-  }
+  i32 ret = 0;
+  do {
+    ret = epoll_wait(aio.aio.fd, events, (i32)events_len,
+                     timeout_ms.has_value ? (i32)timeout_ms.value : -1);
+  } while (-1 == ret && EINTR == errno);
 
-  PG_RESULT(u8, PgError) res_segment_selector_size = pg_reader_read_u8_le(&r);
-  PG_IF_LET_ERR(err, res_segment_selector_size) {
-    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+  if (-1 == ret) {
+    return PG_ERR(errno, u64, PgError);
   }
 
-  PG_RESULT(u32, PgError) res_offset_count = pg_reader_read_u32_le(&r);
-  PG_IF_LET_ERR(err, res_offset_count) {
-    return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-  }
-  u32 offset_count = PG_UNWRAP(res_offset_count);
+  u64 res = (u64)ret;
 
-  if (0 != offset_count) {
-    for (u32 i = 0; i < offset_count; i++) {
-      PG_RESULT(u32, PgError) res_offset = pg_reader_read_u32_le(&r);
-      PG_IF_LET_ERR(err, res_offset) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
-    }
-  }
-  u64 base_address = 0;
+  for (u64 i = 0; i < (u64)ret; i++) {
+    struct epoll_event e =
+        PG_C_ARRAY_AT(events, PG_STATIC_ARRAY_LEN(events), i);
 
-  PG_DYN(PgDwarfRangeListEntry) ranges = {0};
+    PgAioEvent ev = {0};
+    ev.fd.fd = e.data.fd;
 
-  while (!PG_SLICE_IS_EMPTY(r.u.bytes)) {
-    PgDwarfRangeListEntry entry = {0};
-    PG_RESULT(u8, PgError) res_kind = pg_reader_read_u8_le(&r);
-    PG_IF_LET_ERR(err, res_kind) {
-      return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+    if (e.events & EPOLLIN) {
+      ev.kind |= PG_AIO_EVENT_KIND_READABLE;
+    }
+    if (e.events & EPOLLOUT) {
+      ev.kind |= PG_AIO_EVENT_KIND_WRITABLE;
+    }
+    if (e.events & EPOLLERR) {
+      ev.kind |= PG_AIO_EVENT_KIND_ERROR;
+    }
+    if (e.events & EPOLLHUP) {
+      ev.kind |= PG_AIO_EVENT_KIND_EOF;
     }
-    entry.kind = PG_UNWRAP(res_kind);
 
-    switch (entry.kind) {
-    case PG_DWARF_RLE_END_OF_LIST: {
-      if (!PG_SLICE_IS_EMPTY(ranges)) {
-        PG_DYN_PUSH(&res, ranges, allocator);
-      }
-      ranges = (PG_DYN(PgDwarfRangeListEntry)){0};
-      base_address = 0;
-    } break;
+    PG_SLICE(u8) ev_bytes = {.data = (u8 *)&ev, .len = sizeof(ev)};
+    PG_ASSERT(sizeof(ev) == pg_ring_write_bytes(cqe, ev_bytes));
+  }
 
-    case PG_DWARF_RLE_BASE_ADDRESSX: {
-      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
-      u64 value = PG_UNWRAP(res_read);
-      base_address = PG_SLICE_AT(addresses, value);
+  res += pg_aio_timers_expire_cqe(aio, cqe);
 
-      entry.u.u64 = value;
-      PG_DYN_PUSH(&ranges, entry, allocator);
-    } break;
+  return PG_OK(res, u64, PgError);
+}
+
+static void pg_aio_fs_nodes_scan(PgAio *aio, PgAioFsNode *node,
+                                 PG_DYN(PgAioEvent) * events,
+                                 PgAllocator *allocator) {
+  if (!node) {
+    return;
+  }
 
-    case PG_DWARF_RLE_STARTX_LENGTH: {
-      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(node->child); i++) {
+    pg_aio_fs_nodes_scan(aio, node->child[i], events, allocator);
+  }
 
-      entry.u.pair_u64.first = PG_UNWRAP(res_read);
+  if (node->directory) {
+    // Best effort: e.g. deleted.
+    (void)pg_aio_fs_node_scan(aio, node, events, allocator);
+  }
+}
 
-      res_read = pg_reader_read_u64_leb128(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
-      entry.u.pair_u64.second = PG_UNWRAP(res_read);
+// Wait for changes in the directories watched with
+// `pg_aio_register_watch_directory`, and append them to `events`: one per
+// changed entry, found by comparing its state to the one last recorded. All
+// the queued inotify events are read, many per read, before diffing. If the
+// kernel queue overflowed, all the directories are scanned again instead.
+// `allocator` is for `events`, their names, and temporaries.
+// Returns the number of events appended, 0 on timeout or if nothing actually
+// changed.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
+    pg_aio_fs_wait(PgAio *aio, PG_DYN(PgAioEvent) * events,
+                   PG_OPTION(u32) timeout_ms, PgAllocator *allocator) {
+  PG_ASSERT(aio->inotify.has_value);
+  u64 events_len = events->len;
+  PG_DYN(PgAioFsChange) changes = {0};
+  bool overflow = false;
+
+  for (i32 timeout = timeout_ms.has_value ? (i32)timeout_ms.value : -1;;
+       timeout = 0) {
+    struct pollfd pfd = {.fd = aio->inotify.value.fd, .events = POLLIN};
+    i32 ret = 0;
+    do {
+      ret = poll(&pfd, 1, timeout);
+    } while (-1 == ret && EINTR == errno);
+    if (-1 == ret) {
+      return PG_ERR(errno, u64, PgError);
+    }
+    if (0 == ret) {
+      break;
+    }
 
-      PG_DYN_PUSH(&ranges, entry, allocator);
-    } break;
+    alignas(struct inotify_event) u8 buf[64 * PG_KiB];
+    PgString dst = {.data = buf, .len = sizeof(buf)};
+    PG_RESULT(u64, PgError) res_read = pg_file_read(aio->inotify.value, dst);
+    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, u64, PgError); }
+    u64 read_len = PG_UNWRAP(res_read);
 
-    case PG_DWARF_RLE_OFFSET_PAIR: {
-      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
-      entry.u.pair_u64.first = base_address + PG_UNWRAP(res_read);
+    for (u64 i = 0; i + sizeof(struct inotify_event) <= read_len;) {
+      struct inotify_event *inev = (struct inotify_event *)(void *)(buf + i);
+      i += sizeof(struct inotify_event) + inev->len;
 
-      res_read = pg_reader_read_u64_leb128(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      if (inev->mask & IN_Q_OVERFLOW) {
+        overflow = true;
+        continue;
       }
-      entry.u.pair_u64.second = base_address + PG_UNWRAP(res_read);
 
-      if (entry.u.pair_u64.first != entry.u.pair_u64.second) {
-        PG_DYN_PUSH(&ranges, entry, allocator);
+      PgAioFsNode *node = pg_aio_fs_node_upsert(
+          &aio->fs_nodes, (PgFileDescriptor){.fd = inev->wd}, nullptr);
+      if (!node || !node->directory) {
+        continue;
       }
-    } break;
-
-    case PG_DWARF_RLE_STARTX_ENDX: {
-      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      // The directory was deleted, after its entries: forgotten once they
+      // are diffed.
+      if (inev->mask & IN_IGNORED) {
+        node->directory = false;
+        PgAioFsChange change = {.node = node};
+        PG_DYN_PUSH(&changes, change, allocator);
+        continue;
       }
-      entry.u.pair_u64.first = base_address + PG_UNWRAP(res_read);
-
-      res_read = pg_reader_read_u64_leb128(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+      if (0 == inev->len) {
+        continue;
       }
-      entry.u.pair_u64.second = base_address + PG_UNWRAP(res_read);
 
-      if (entry.u.pair_u64.first != entry.u.pair_u64.second) {
-        PG_DYN_PUSH(&ranges, entry, allocator);
+      PgAioFsEntry *entry =
+          pg_aio_fs_entry_upsert(node, pg_cstr_to_string(inev->name));
+      entry->written |= (inev->mask & IN_MODIFY) != 0;
+      if (!entry->pending) {
+        entry->pending = true;
+        PgAioFsChange change = {.node = node, .entry = entry};
+        PG_DYN_PUSH(&changes, change, allocator);
       }
-    } break;
+    }
+  }
 
-    case PG_DWARF_RLE_BASE_ADDRESS: {
-      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
-      base_address = PG_UNWRAP(res_read);
+  PG_EACH_PTR(change, &changes) {
+    PgAioFsNode *node = change->node;
+    PgAioFsEntry *entry = change->entry;
+    if (!entry) {
+      pg_aio_fs_node_forget(node);
+      continue;
+    }
+    bool written = entry->written;
+    entry->pending = entry->written = false;
+    if (overflow) {
+      continue;
+    }
 
-      entry.u.u64 = PG_UNWRAP(res_read);
-      PG_DYN_PUSH(&ranges, entry, allocator);
-    } break;
+    u8 path_buf[PG_PATH_MAX] = {0};
+    PG_OPTION(PgString)
+    path = pg_aio_fs_entry_path(node, entry->name, path_buf);
+    if (!path.has_value) {
+      continue;
+    }
+    PG_RESULT(PgFileStat, PgError)
+    res_stat = pg_file_stat_from_path(path.value, nullptr);
+    PgAioEventKind kind = pg_aio_fs_entry_update(
+        node, entry, PG_IS_OK(res_stat), PG_UNWRAP_OR_DEFAULT(res_stat),
+        written, events, allocator);
+    if (!entry->exists) {
+      pg_aio_fs_entry_remove(
+          node, pg_aio_fs_entry_find(&node->entries, entry->name));
+      continue;
+    }
 
-    case PG_DWARF_RLE_START_END: {
-      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
-      entry.u.pair_u64.first = PG_UNWRAP(res_read);
+    if ((node->options & PG_WALK_DIRECTORY_KIND_RECURSE) && entry->directory &&
+        (PG_AIO_EVENT_KIND_FILE_CREATED | PG_AIO_EVENT_KIND_FILE_MODIFIED) &
+            kind) {
+      // Best effort: e.g. deleted already.
+      (void)pg_aio_fs_watch_directory(aio, path.value, node->options,
+                                      node->allocator, events, allocator);
+    }
+  }
 
-      res_read = pg_reader_read_u64_le(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
-      entry.u.pair_u64.second = PG_UNWRAP(res_read);
+  if (overflow) {
+    pg_aio_fs_nodes_scan(aio, aio->fs_nodes, events, allocator);
+  }
 
-      if (entry.u.pair_u64.first != entry.u.pair_u64.second) {
-        PG_DYN_PUSH(&ranges, entry, allocator);
-      }
-    } break;
+  return PG_OK(events->len - events_len, u64, PgError);
+}
 
-    case PG_DWARF_RLE_START_LENGTH: {
-      PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
-      entry.u.pair_u64.first = PG_UNWRAP(res_read);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_send_to_socket_range(PgFileDescriptor dst, PgFileDescriptor src,
+                             u64 offset, u64 len) {
+  i64 off = (i64)offset;
 
-      res_read = pg_reader_read_u64_leb128(&r);
-      PG_IF_LET_ERR(err, res_read) {
-        return PG_ERR(err, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
-      }
-      entry.u.pair_u64.second = PG_UNWRAP(res_read);
+  while (len > 0) {
+    i64 ret = 0;
+    do {
+      ret = sendfile(dst.fd, src.fd, &off, len);
+    } while (-1 == ret && EINTR == errno);
 
-      PG_DYN_PUSH(&ranges, entry, allocator);
-    } break;
+    if (-1 == ret) {
+      // TODO: Perhaps fallback to `read(2)` + `write(2)` in case of
+      // `EINVAL` or `ENOSYS`.
+      return (PgError)errno;
+    }
 
-    default:
-      return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
-                    PgError);
+    // The file was truncated concurrently.
+    if (0 == ret) {
+      return PG_ERR_EOF;
     }
-  }
 
-  if (!PG_SLICE_IS_EMPTY(r.u.bytes)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(PG_DYN(PgDwarfRangeListEntry)),
-                  PgError);
+    len -= (u64)ret;
   }
 
-  if (!PG_SLICE_IS_EMPTY(ranges)) {
-    PG_DYN_PUSH(&res, ranges, allocator);
-  }
+  return 0;
+}
 
-  return PG_OK(res, PG_DYN(PG_DYN(PgDwarfRangeListEntry)), PgError);
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_file_send_to_socket(PgFileDescriptor dst, PgFileDescriptor src) {
+  PG_RESULT(u64, PgError) res_size = pg_file_size(src);
+  PG_IF_LET_ERR(err, res_size) { return err; }
+
+  return pg_file_send_to_socket_range(dst, src, 0, PG_UNWRAP(res_size));
 }
 
-[[nodiscard]] static PG_RESULT(PG_DYN(u64), PgError)
-    pg_dwarf_addresses_parse(PG_SLICE(u8) bytes, PgAllocator *allocator) {
-  PG_DYN(u64) res = {0};
+#endif
+
+#ifdef PG_OS_APPLE
 
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgMacho, PgError)
+    pg_macho_parse(PG_SLICE(u8) bytes) {
+  PgMacho res = {0};
   PgReader r = pg_reader_make_from_bytes(bytes);
 
-  PG_RESULT(u32, PgError) res_length = pg_reader_read_u32_le(&r);
-  PG_IF_LET_ERR(err, res_length) { return PG_ERR(err, PG_DYN(u64), PgError); }
-  u64 length = PG_UNWRAP(res_length);
-  u32 expected_length = 0;
-  if (__builtin_add_overflow(length, 4, &expected_length)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
+  // Magic.
+  {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
+    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
+    u32 magic = PG_UNWRAP(res_read);
+    if (0xfe'ed'fa'cf != magic) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgMacho, PgError);
+    }
+    res.header.magic = magic;
   }
-  if (expected_length != bytes.len) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
+  // Cpu type.
+  {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
+    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
+    res.header.cpu_type = PG_UNWRAP(res_read);
   }
-
-  PG_RESULT(u16, PgError) res_version = pg_reader_read_u16_le(&r);
-  PG_IF_LET_ERR(err, res_version) { return PG_ERR(err, PG_DYN(u64), PgError); }
-  u16 version = PG_UNWRAP(res_version);
-  if (5 != version) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
+  // Cpu sub type.
+  {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
+    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
+    res.header.cpu_subtype = PG_UNWRAP(res_read);
   }
-
-  PG_RESULT(u8, PgError) res_address_size = pg_reader_read_u8_le(&r);
-  PG_IF_LET_ERR(err, res_address_size) {
-    return PG_ERR(err, PG_DYN(u64), PgError);
+  // File type.
+  {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
+    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
+    res.header.filetype = PG_UNWRAP(res_read);
   }
-  u8 address_size = PG_UNWRAP(res_address_size);
-  if (8 != address_size) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
+  // Ncmds.
+  {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
+    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
+    res.header.cmds_count = PG_UNWRAP(res_read);
+  }
+  // Sizeof cmds.
+  {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
+    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
+    res.header.cmds_sizeof = PG_UNWRAP(res_read);
+  }
+  // Flags.
+  {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
+    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
+    res.header.flags = PG_UNWRAP(res_read);
+  }
+  // Reserved.
+  {
+    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
+    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
+    res.header.reserved = PG_UNWRAP(res_read);
+  }
+
+  {
+    for (u64 i = 0; i < res.header.cmds_count; i++) {
+      PgMachoLoadCommand load_cmd = {0};
+      PgError err = pg_reader_read_full(&r, (u8 *)&load_cmd, sizeof(load_cmd));
+      if (err) {
+        return PG_ERR(err, PgMacho, PgError);
+      }
+      if (load_cmd.cmdsize < sizeof(load_cmd)) {
+        return PG_ERR(PG_ERR_INVALID_VALUE, PgMacho, PgError);
+      }
+      u32 remaining_size = load_cmd.cmdsize - sizeof(load_cmd);
+
+      switch (load_cmd.cmd) {
+      case PG_MACHO_LC_SYMTAB: {
+        PgError err = pg_reader_discard(&r, remaining_size);
+        if (err) {
+          return PG_ERR(err, PgMacho, PgError);
+        }
+      } break;
+      case PG_MACHO_LC_SEGMENT_64: {
+        u8 name[16] = {0};
+        PgError err = pg_reader_read_full(&r, name, PG_STATIC_ARRAY_LEN(name));
+        if (err) {
+          return PG_ERR(err, PgMacho, PgError);
+        }
+        if (remaining_size < PG_STATIC_ARRAY_LEN(name)) {
+          return PG_ERR(PG_ERR_INVALID_VALUE, PgMacho, PgError);
+        }
+
+        if (!pg_string_eq(PG_S("__DWARF"), pg_cstr_to_string((char *)name))) {
+          err =
+              pg_reader_discard(&r, remaining_size - PG_STATIC_ARRAY_LEN(name));
+          if (err) {
+            return PG_ERR(err, PgMacho, PgError);
+          }
+        }
+      } break;
+      default: {
+        PgError err = pg_reader_discard(&r, remaining_size);
+        if (err) {
+          return PG_ERR(err, PgMacho, PgError);
+        }
+      }
+      }
+    }
   }
 
-  PG_RESULT(u8, PgError) res_segment_selector_size = pg_reader_read_u8_le(&r);
-  u8 segment_selector_size = PG_UNWRAP(res_segment_selector_size);
-  if (0 != segment_selector_size) {
-    // Need to read segment + address in the loop below.
-    PG_ASSERT(0 && "todo");
-  }
+  return PG_OK(res, PgMacho, PgError);
+}
 
-  if (0 != (r.u.bytes.len % 8)) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PG_DYN(u64), PgError);
-  }
-  PG_DYN_ENSURE_CAP(&res, r.u.bytes.len / 8, allocator);
+[[maybe_unused]] [[nodiscard]] static PgString pg_self_exe_get_path() {
+  static _Atomic PgOnce once = PG_ONCE_UNINITIALIZED;
+  static char path_c[PG_PATH_MAX] = {0};
+  static PgString res = {0};
 
-  while (!PG_SLICE_IS_EMPTY(r.u.bytes)) {
-    PG_RESULT(u64, PgError) res_addr = pg_reader_read_u64_le(&r);
-    PG_IF_LET_ERR(err, res_addr) { return PG_ERR(err, PG_DYN(u64), PgError); }
+  if (pg_once_do(&once)) {
+    u32 len = PG_STATIC_ARRAY_LEN(path_c);
 
-    PG_DYN_PUSH(&res, PG_UNWRAP(res_addr), allocator);
+    i32 ret = _NSGetExecutablePath(path_c, &len);
+    if (-1 == ret) {
+      return res;
+    }
+    res = pg_cstr_to_string(path_c);
+
+    pg_once_mark_as_done(&once);
   }
-  PG_ASSERT(0 == r.u.bytes.len);
 
-  return PG_OK(res, PG_DYN(u64), PgError);
+  PG_ASSERT(!pg_string_is_empty(res));
+  return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgDwarfDebugInfoCompilationUnit,
-                                                PgError)
-    pg_dwarf_parse_debug_info(PgElf elf, PgAllocator *allocator) {
-  PgDwarfDebugInfoCompilationUnit res = {0};
+[[nodiscard]] static u64 pg_self_pie_get_offset() {
+  intptr_t ret = _dyld_get_image_vmaddr_slide(0);
+  return ret;
+}
 
-  PG_RESULT(PG_SLICE(u8), PgError)
-  res_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
-      elf, PG_S(".debug_info"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
-  PG_IF_LET_ERR(err, res_bytes) {
-    return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgDebugInfoIterator, PgError)
+    pg_self_debug_info_iterator_make(PgAllocator *allocator) {
+  PgDebugInfoIterator res = {0};
+
+  PgString exe_path = pg_self_exe_get_path();
+  if (pg_string_is_empty(exe_path)) {
+    return PG_OK(res, PgDebugInfoIterator, PgError);
   }
-  PG_SLICE(u8) bytes = PG_UNWRAP(res_bytes);
 
-  PgReader r = pg_reader_make_from_bytes(bytes);
+  PgString debug_path = pg_string_concat(exe_path, PG_S(".dSYM"), allocator);
+  debug_path = pg_path_join(debug_path, PG_S("Contents"), allocator);
+  debug_path = pg_path_join(debug_path, PG_S("Resources"), allocator);
+  debug_path = pg_path_join(debug_path, PG_S("DWARF"), allocator);
+  debug_path = pg_path_join(debug_path, pg_path_base_name(exe_path), allocator);
 
-  // Size.
-  PG_RESULT(u32, PgError) res_size = pg_reader_read_u32_le(&r);
-  PG_IF_LET_ERR(err, res_size) {
-    return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+  PG_RESULT(PgVirtualMemFile, PgError)
+  res_file = pg_virtual_mem_map_file(debug_path, PG_FILE_ACCESS_READ, false);
+  PG_IF_LET_ERR(err, res_file) {
+    return PG_ERR(err, PgDebugInfoIterator, PgError);
   }
-  u32 size = PG_UNWRAP(res_size);
+  res.file = PG_UNWRAP(res_file);
 
-  // DWARF 64 bits?
-  if (0xffff'ffff == size) {
-    // Unsupported for now.
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgDwarfDebugInfoCompilationUnit,
-                  PgError);
-  }
+  // Macho.
+  {
+    PG_RESULT(PgMacho, PgError) res_macho = pg_macho_parse(res.file.data);
+    PG_IF_LET_ERR(err, res_macho) {
+      return PG_ERR(err, PgDebugInfoIterator, PgError);
+    }
 
-  // Version.
-  PG_RESULT(u16, PgError) res_version = pg_reader_read_u16_le(&r);
-  PG_IF_LET_ERR(err, res_version) {
-    return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
-  }
-  u16 version = PG_UNWRAP(res_version);
-  // Only expect v5.
-  if (5 != version) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgDwarfDebugInfoCompilationUnit,
-                  PgError);
+    res.macho = PG_UNWRAP(res_macho);
   }
 
-  PG_RESULT(u8, PgError) res_unit_kind = pg_reader_read_u8_le(&r);
-  PG_IF_LET_ERR(err, res_unit_kind) {
-    return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+  if (1) {
+    pg_self_debug_info_iterator_release(res);
   }
-  res.kind = PG_UNWRAP(res_unit_kind);
+  return PG_ERR(PG_ERR_INVALID_VALUE, PgDebugInfoIterator, PgError);
+}
 
-  switch (res.kind) {
-  case PG_DWARF_COMPILATION_UNIT_SKELETON: {
-    PG_RESULT(u8, PgError) res_address_size = pg_reader_read_u8_le(&r);
-    PG_IF_LET_ERR(err, res_address_size) {
-      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
-    }
-    u8 address_size = PG_UNWRAP(res_address_size);
-    // Only expect address size 8 (64 bits).
-    PG_ASSERT(8 == address_size);
+[[maybe_unused]] static void pg_thread_yield() { sched_yield(); }
 
-    PG_RESULT(u32, PgError) res_abbrev_offset = pg_reader_read_u32_le(&r);
-    PG_IF_LET_ERR(err, res_abbrev_offset) {
-      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+#endif
+
+// Each request gets the memory of `arena` back once answered. With
+// `keep_alive_timeout_ms`, the connection is reused for further requests, and
+// the unread part of each request body is skipped first.
+[[maybe_unused]] [[nodiscard]]
+static PgError pg_http_server_handler(PgFileDescriptor sock,
+                                      PgHttpServerOptions options,
+                                      PgLogger *logger, PgArena *arena) {
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgReader reader =
+      pg_reader_make_from_socket(sock, PG_HTTP_LINE_MAX_LEN, allocator);
+  PgWriter writer =
+      pg_writer_make_from_socket(sock, PG_HTTP_LINE_MAX_LEN, allocator);
+
+  if (options.keep_alive_timeout_ms) {
+    PgError err = pg_net_socket_set_timeout(
+        sock, options.keep_alive_timeout_ms / 1000,
+        (options.keep_alive_timeout_ms % 1000) * 1000);
+    if (err) {
+      return err;
     }
-    u32 abbrev_offset = PG_UNWRAP(res_abbrev_offset);
 
-    PG_RESULT(u64, PgError) res_unit_id = pg_reader_read_u64_le(&r);
-    PG_IF_LET_ERR(err, res_unit_id) {
-      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+    // A response written in several flushes would otherwise wait for the
+    // delayed acknowledgment of the client before the next request.
+    (void)pg_net_set_nodelay(sock, true);
+  }
+
+  for (u64 i = 0;; i++) {
+    PgArenaTemp temp = pg_arena_temp_begin(arena);
+    PgHttpRequestReadResult res_req = pg_http_read_request(&reader, allocator);
+
+    // The client closed an idle connection.
+    if (i > 0 && PG_ERR_EOF == res_req.err) {
+      pg_arena_temp_end(temp);
+      return 0;
     }
-    res.id = PG_UNWRAP(res_unit_id);
 
-    PG_RESULT(PG_DYN(PgDwarfAbbreviationEntry), PgError)
-    res_abbrevs =
-        pg_dwarf_parse_abbreviation_entries(elf, abbrev_offset, allocator);
-    PG_IF_LET_ERR(err, res_abbrevs) {
-      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+    if (res_req.err) {
+      pg_log(logger, PG_LOG_LEVEL_ERROR,
+             "http handler: failed to parse http request",
+             pg_log_c_err("err", res_req.err));
+      pg_arena_temp_end(temp);
+      return res_req.err;
     }
 
-    res.abbrevs = PG_UNWRAP(res_abbrevs);
-  } break;
-  case PG_DWARF_COMPILATION_UNIT_COMPILE: {
-    PG_RESULT(u8, PgError) res_address_size = pg_reader_read_u8_le(&r);
-    PG_IF_LET_ERR(err, res_address_size) {
-      return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+    if (!res_req.done) {
+      pg_log(logger, PG_LOG_LEVEL_ERROR,
+             "http handler: failed to read full http request",
+             pg_log_c_err("done", res_req.done));
+      pg_arena_temp_end(temp);
+      return PG_ERR_EOF;
     }
-    u8 address_size = PG_UNWRAP(res_address_size);
-    // Only expect address size 8 (64 bits).
-    PG_ASSERT(8 == address_size);
 
-    // Parse abbreviation entries.
-    {
-      PG_RESULT(u32, PgError) res_abbrev_offset = pg_reader_read_u32_le(&r);
-      PG_IF_LET_ERR(err, res_abbrev_offset) {
-        return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
-      }
-      u32 abbrev_offset = PG_UNWRAP(res_abbrev_offset);
+    PgHttpServerRequest req = res_req.req;
 
-      PG_RESULT(PG_DYN(PgDwarfAbbreviationEntry), PgError)
-      res_abbrevs =
-          pg_dwarf_parse_abbreviation_entries(elf, abbrev_offset, allocator);
-      PG_IF_LET_ERR(err, res_abbrevs) {
-        return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
-      }
-      res.abbrevs = PG_UNWRAP(res_abbrevs);
+    PG_RESULT(PgReader, PgError)
+    res_body = pg_http_request_body_reader(&req.headers, &reader, nullptr,
+                                           allocator);
+    PG_IF_LET_ERR(err, res_body) {
+      pg_log(logger, PG_LOG_LEVEL_ERROR,
+             "http handler: unsupported request body",
+             pg_log_c_err("err", err));
+      pg_arena_temp_end(temp);
+      return err;
     }
+    PgReader body = PG_UNWRAP(res_body);
 
-    // Parse addresses.
-    // TODO: Lazily access address with O(1) instead of storing them all?
-    {
-      PG_RESULT(PG_SLICE(u8), PgError)
-      res_addresses_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
-          elf, PG_S(".debug_addr"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
-      PG_IF_LET_ERR(err, res_bytes) {
-        return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
-      }
-      PG_SLICE(u8) addresses_bytes = PG_UNWRAP(res_addresses_bytes);
+    PG_ASSERT(options.handler);
+    options.handler(req, &body, &writer, logger, allocator, options.ctx);
 
-      PG_RESULT(PG_DYN(u64), PgError)
-      res_addresses = pg_dwarf_addresses_parse(addresses_bytes, allocator);
-      PG_IF_LET_ERR(err, res_addresses) {
-        return PG_ERR(err, PgDwarfDebugInfoCompilationUnit, PgError);
+    bool keep_alive =
+        options.keep_alive_timeout_ms &&
+        pg_http_keep_alive(&req.headers, req.version_major, req.version_minor);
+
+    // Skip what the handler did not read, up to the next request.
+    while (keep_alive) {
+      u8 discard[4096] = {0};
+      PG_RESULT(u64, PgError) res_read =
+          pg_reader_read(&body, discard, sizeof(discard));
+      if (PG_IS_ERR(res_read)) {
+        keep_alive = PG_ERR_EOF == PG_UNWRAP_ERR(res_read);
+        break;
       }
-      res.addresses = PG_UNWRAP(res_addresses);
     }
-  } break;
-  case PG_DWARF_COMPILATION_UNIT_NONE:
-  case PG_DWARF_COMPILATION_UNIT_TYPE:
-  case PG_DWARF_COMPILATION_UNIT_PARTIAL:
-  case PG_DWARF_COMPILATION_UNIT_SPLIT_COMPILE:
-  case PG_DWARF_COMPILATION_UNIT_SPLIT_TYPE:
-  case PG_DWARF_COMPILATION_UNIT_LO_USER:
-  case PG_DWARF_COMPILATION_UNIT_HI_USER:
-  default:
-    PG_ASSERT(0 && "todo");
-  }
 
-  return PG_OK(res, PgDwarfDebugInfoCompilationUnit, PgError);
-}
+    // Request boundary.
+    pg_scratch_reset();
+    pg_arena_temp_end(temp);
 
-[[maybe_unused]] [[nodiscard]] static u64
-pg_dwarf_compilation_unit_get_data_offset(
-    PgDwarfDebugInfoCompilationUnit unit) {
-  switch (unit.kind) {
-  case PG_DWARF_COMPILATION_UNIT_COMPILE:
-    return 12;
-  case PG_DWARF_COMPILATION_UNIT_NONE:
-  case PG_DWARF_COMPILATION_UNIT_TYPE:
-  case PG_DWARF_COMPILATION_UNIT_PARTIAL:
-  case PG_DWARF_COMPILATION_UNIT_SKELETON:
-  case PG_DWARF_COMPILATION_UNIT_SPLIT_COMPILE:
-  case PG_DWARF_COMPILATION_UNIT_SPLIT_TYPE:
-  case PG_DWARF_COMPILATION_UNIT_LO_USER:
-  case PG_DWARF_COMPILATION_UNIT_HI_USER:
-    PG_ASSERT(0 && "todo");
-  default:
-    PG_ASSERT(0);
+    if (!keep_alive) {
+      return 0;
+    }
   }
 }
 
-[[nodiscard]] static PgString pg_dwarf_resolve_string(PG_SLICE(u32) str_offsets,
-                                                      PG_SLICE(u8) str_bytes,
-                                                      u64 idx) {
-  u32 str_idx = PG_SLICE_AT(str_offsets, idx);
-  return pg_str0_to_string(PG_SLICE_RANGE_START(str_bytes, str_idx)).value;
+#ifdef PG_OS_UNIX
+[[maybe_unused]] [[nodiscard]] static PgHttpFileCache
+pg_http_file_cache_make(PgString root, u64 revalidate_after_ns,
+                        PgAllocator *allocator) {
+  return (PgHttpFileCache){
+      .root = pg_string_clone(root, allocator),
+      .revalidate_after_ns = revalidate_after_ns,
+      .allocator = allocator,
+  };
 }
 
-[[maybe_unused]] [[nodiscard]]
-static PG_RESULT(PG_OPTION(PgDwarfAtom), PgError)
-    pg_dwarf_compilation_unit_debug_info_next(PgDebugInfoIterator *it) {
-  PgDwarfAtom res = {0};
+[[nodiscard]] static u64 pg_http_file_write_hex(u8 *dst, u64 n) {
+  u8 tmp[16] = {0};
+  u64 len = 0;
+  do {
+    tmp[len++] = (u8)"0123456789abcdef"[n & 15];
+    n >>= 4;
+  } while (n);
 
-  // The end.
-  if (PG_SLICE_IS_EMPTY(it->r.u.bytes)) {
-    return PG_OK({}, PG_OPTION(PgDwarfAtom), PgError);
+  for (u64 i = 0; i < len; i++) {
+    dst[i] = tmp[len - 1 - i];
   }
+  return len;
+}
 
-  PG_ASSERT(it->r.u.bytes.data >= it->debug_info_full.data);
+// Like nginx, the ETag is made of the modification time and the size so that
+// it does not require reading the file.
+static void pg_http_file_compute_validators(PgHttpFile *file) {
+  u64 len = 0;
+  file->etag[len++] = '"';
+  len += pg_http_file_write_hex(file->etag + len,
+                                file->stat.mtime_ns / PG_Seconds);
+  file->etag[len++] = '-';
+  len += pg_http_file_write_hex(file->etag + len, file->stat.size);
+  file->etag[len++] = '"';
+  PG_ASSERT(len <= PG_STATIC_ARRAY_LEN(file->etag));
+  file->etag_len = (u8)len;
 
-  // New abbrev.
-  if (!it->abbrev_opt.has_value ||
-      it->abbrev_attr_form_idx >= it->abbrev_opt.value.attribute_forms.len) {
-    it->die_offset = it->r.u.bytes.data - it->debug_info_full.data;
+  pg_http_date_format(file->stat.mtime_ns / PG_Seconds, file->last_modified);
+}
 
-    PG_RESULT(u64, PgError) res_entry_idx = pg_reader_read_u64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_entry_idx) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
-    u64 entry_idx = PG_UNWRAP(res_entry_idx);
-    if (0 == entry_idx) {
-      // Null entry (?)
-      return PG_OK(PG_SOME(res, PgDwarfAtom), PG_OPTION(PgDwarfAtom), PgError);
-    }
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_http_file_etag(PgHttpFile *file) {
+  return (PgString){.data = file->etag, .len = file->etag_len};
+}
 
-    if (entry_idx >= it->unit.abbrevs.len + 1) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PG_OPTION(PgDwarfAtom), PgError);
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_http_file_last_modified(PgHttpFile *file) {
+  return (PgString){.data = file->last_modified, .len = PG_HTTP_DATE_LEN};
+}
+
+// Slot of `path` in the hash trie: the file if present, where to insert it
+// otherwise.
+[[nodiscard]] static PgHttpFile **pg_http_file_htrie_find(PgHttpFile **htrie,
+                                                          PgString path) {
+  for (u64 h = pg_hash_fnv(path); *htrie; h <<= 2) {
+    if (pg_string_eq(path, (*htrie)->path)) {
+      break;
     }
+    htrie = &(*htrie)->child[h >> 62];
+  }
+  return htrie;
+}
 
-    PgDwarfAbbreviationEntry abbrev =
-        PG_SLICE_AT(it->unit.abbrevs, entry_idx - 1);
+// `path` relative to the root of the cache, the root itself if empty, written
+// to `buf` of `PG_PATH_MAX` bytes. None if too long.
+[[nodiscard]] static PG_OPTION(PgString)
+    pg_http_file_cache_full_path(PgHttpFileCache *cache, PgString path,
+                                 u8 *buf) {
+  PG_OPTION(PgString) res = {0};
+  if (cache->root.len + 1 + path.len > PG_PATH_MAX - 1) {
+    return res;
+  }
 
-    it->abbrev_opt.has_value = true;
-    it->abbrev_opt.value = abbrev;
-    it->abbrev_attr_form_idx = 0;
+  res.value.data = buf;
+  pg_memcpy(res.value.data, cache->root.data, cache->root.len);
+  res.value.len += cache->root.len;
+  if (path.len) {
+    res.value.data[res.value.len++] = PG_PATH_SEPARATOR;
+    pg_memcpy(res.value.data + res.value.len, path.data, path.len);
+    res.value.len += path.len;
   }
+  res.has_value = true;
+  return res;
+}
 
-  PG_ASSERT(it->abbrev_opt.has_value);
-  PgDwarfAbbreviationEntry abbrev = it->abbrev_opt.value;
-  res.abbrev = abbrev;
-  res.debug_info_offset = it->die_offset;
+static void pg_http_file_lru_unlink(PgHttpFileCache *cache, PgHttpFile *file) {
+  if (file->lru_prev) {
+    file->lru_prev->lru_next = file->lru_next;
+  } else {
+    cache->lru_head = file->lru_next;
+  }
+  if (file->lru_next) {
+    file->lru_next->lru_prev = file->lru_prev;
+  } else {
+    cache->lru_tail = file->lru_prev;
+  }
+  file->lru_prev = file->lru_next = nullptr;
+}
 
-  if (PG_SLICE_IS_EMPTY(abbrev.attribute_forms)) {
-    return PG_OK(PG_SOME(res, PgDwarfAtom), PG_OPTION(PgDwarfAtom), PgError);
+static void pg_http_file_lru_push_front(PgHttpFileCache *cache,
+                                        PgHttpFile *file) {
+  file->lru_next = cache->lru_head;
+  if (cache->lru_head) {
+    cache->lru_head->lru_prev = file;
+  } else {
+    cache->lru_tail = file;
   }
+  cache->lru_head = file;
+}
 
-  PgDwarfAttributeForm attr_form =
-      PG_SLICE_AT(abbrev.attribute_forms, it->abbrev_attr_form_idx);
-  res.attr_form = attr_form;
-  it->abbrev_attr_form_idx += 1;
+static void pg_http_file_drop_gzip(PgHttpFileCache *cache, PgHttpFile *file) {
+  if (!file->gzip) {
+    return;
+  }
 
-  switch (attr_form.form) {
-  case PG_DWARF_FORM_STRING:
-    PG_ASSERT(0 && "todo");
+  pg_http_file_lru_unlink(cache, file);
+  (void)pg_file_close(file->gzip_fd);
+  PG_ASSERT(cache->gzip_bytes >= file->gzip_len);
+  cache->gzip_bytes -= file->gzip_len;
+  file->gzip_len = 0;
+  file->gzip = false;
+}
 
-  case PG_DWARF_FORM_INDIRECT: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+// Get the open file at `path`, relative to the root of the cache. The
+// metadata is only checked again against the file system when it is older
+// than `revalidate_after_ns`, and the file is only reopened when it changed.
+// Missing files are not cached.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHttpFilePtr, PgError)
+    pg_http_file_cache_get(PgHttpFileCache *cache, PgString path) {
+  u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
 
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
+  PgHttpFile **htrie = pg_http_file_htrie_find(&cache->htrie, path);
+  PgHttpFile *file = *htrie;
 
-  case PG_DWARF_FORM_BLOCK: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  if (file && file->open &&
+      now_ns - file->validated_at_ns < cache->revalidate_after_ns) {
+    return PG_OK(file, PgHttpFilePtr, PgError);
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
+  u8 full_path_buf[PG_PATH_MAX] = {0};
+  PG_OPTION(PgString)
+  full_path_opt = pg_http_file_cache_full_path(cache, path, full_path_buf);
+  if (!full_path_opt.has_value) {
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpFilePtr, PgError);
+  }
+  PgString full_path = full_path_opt.value;
 
-  case PG_DWARF_FORM_REF_SIG8: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+  if (file && file->open) {
+    PG_RESULT(PgFileStat, PgError)
+    res_stat = pg_file_stat_from_path(full_path, cache->allocator);
+    PgFileStat stat = PG_UNWRAP_OR_DEFAULT(res_stat);
+    if (PG_IS_OK(res_stat) && stat.ino == file->stat.ino &&
+        stat.dev == file->stat.dev && stat.mtime_ns == file->stat.mtime_ns &&
+        stat.size == file->stat.size) {
+      file->validated_at_ns = now_ns;
+      return PG_OK(file, PgHttpFilePtr, PgError);
     }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
-
-  case PG_DWARF_FORM_REF_SUP8: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+    // Modified, replaced or removed.
+    pg_http_file_drop_gzip(cache, file);
+    (void)pg_file_close(file->fd);
+    file->open = false;
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_open = pg_file_open(full_path, PG_FILE_ACCESS_READ, 0, false,
+                          cache->allocator);
+  PG_IF_LET_ERR(err, res_open) {
+    return PG_ERR(err, PgHttpFilePtr, PgError);
+  }
+  PgFileDescriptor fd = PG_UNWRAP(res_open);
 
-  case PG_DWARF_FORM_REF_SUP4: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  PG_RESULT(PgFileStat, PgError) res_stat = pg_file_stat(fd);
+  PG_IF_LET_ERR(err, res_stat) {
+    (void)pg_file_close(fd);
+    return PG_ERR(err, PgHttpFilePtr, PgError);
+  }
+  PgFileStat stat = PG_UNWRAP(res_stat);
 
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
+  if (!stat.regular) {
+    (void)pg_file_close(fd);
+    return PG_ERR(PG_ERR_INVALID_VALUE, PgHttpFilePtr, PgError);
+  }
 
-  case PG_DWARF_FORM_FLAG: {
-    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  if (!file) {
+    file = PG_NEW(PgHttpFile, cache->allocator);
+    file->path = pg_string_clone(path, cache->allocator);
+    file->content_type = pg_http_content_type_from_path(path);
+    *htrie = file;
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U8;
-    res.u.u8 = PG_UNWRAP(res_read);
-  } break;
+  file->fd = fd;
+  file->stat = stat;
+  file->validated_at_ns = now_ns;
+  file->open = true;
+  pg_http_file_compute_validators(file);
 
-  case PG_DWARF_FORM_REF_ADDR: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  return PG_OK(file, PgHttpFilePtr, PgError);
+}
 
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
+static void pg_http_file_htrie_close(PgHttpFile *file) {
+  if (!file) {
+    return;
+  }
 
-  case PG_DWARF_FORM_IMPLICIT_CONST: {
-    res.u.u64 = attr_form.u.value;
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-  } break;
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(file->child); i++) {
+    pg_http_file_htrie_close(file->child[i]);
+  }
 
-  case PG_DWARF_FORM_FLAG_PRESENT: {
-    res.u.u64 = true;
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-  } break;
+  if (file->open) {
+    (void)pg_file_close(file->fd);
+    file->open = false;
+  }
+}
 
-  case PG_DWARF_FORM_STRP: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+[[maybe_unused]] static void pg_http_file_cache_close(PgHttpFileCache *cache) {
+  while (cache->lru_head) {
+    pg_http_file_drop_gzip(cache, cache->lru_head);
+  }
+  pg_http_file_htrie_close(cache->htrie);
 
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
+#ifdef PG_OS_LINUX
+  if (cache->aio) {
+    (void)pg_file_close(cache->aio->inotify.value);
+    (void)pg_file_close(cache->aio->aio);
+    cache->aio = nullptr;
+  }
+#endif
+}
 
-  case PG_DWARF_FORM_STRP_SUP: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+// Map the URL path to a path relative to the root of the cache. Components
+// that could escape the root are rejected.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgString, PgError)
+    pg_http_file_path_from_target(PgUrlView target, PgAllocator *allocator) {
+  PgUrlPathIterator it = pg_url_path_iterator_make(target.path);
+  PG_OPTION(PgString) component = pg_url_path_iterator_next(&it);
+  if (!component.has_value) {
+    return PG_OK(PG_S("index.html"), PgString, PgError);
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
+  // Decoding only shrinks components.
+  PG_DYN(u8) sb = pg_string_builder_make(target.path.len, allocator);
 
-  case PG_DWARF_FORM_LINE_STRP: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+  for (; component.has_value; component = pg_url_path_iterator_next(&it)) {
+    PgString decoded =
+        pg_url_percent_decode(component.value, false, allocator);
+    if (pg_string_eq(decoded, PG_S(".")) || pg_string_eq(decoded, PG_S("..")) ||
+        pg_string_contains_rune(decoded, '/') ||
+        pg_string_contains_rune(decoded, '\\') ||
+        pg_bytes_index_of_byte(decoded, 0).has_value) {
+      return PG_ERR(PG_ERR_INVALID_VALUE, PgString, PgError);
     }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
-
-  case PG_DWARF_FORM_LOCLISTX: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    if (sb.len > 0) {
+      PG_DYN_APPEND_SLICE_WITHIN_CAPACITY(&sb, PG_S("/"));
     }
+    PG_DYN_APPEND_SLICE_WITHIN_CAPACITY(&sb, decoded);
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
-
-  case PG_DWARF_FORM_UDATA: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  return PG_OK(PG_DYN_TO_SLICE(PgString, sb), PgString, PgError);
+}
 
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
+// `If-None-Match` takes precedence over `If-Modified-Since`. `etag` is the
+// one of the representation sent, which depends on the content coding.
+[[nodiscard]] static bool
+pg_http_file_not_modified(PgHttpHeaders const *headers, PgHttpFile *file,
+                          PgString etag) {
+  PG_OPTION(PgString)
+  if_none_match =
+      pg_http_headers_get_by_id(headers, PG_HTTP_HEADER_ID_IF_NONE_MATCH);
+  if (if_none_match.has_value) {
+    return pg_http_etag_list_matches(if_none_match.value, etag);
+  }
+
+  PG_OPTION(PgString)
+  if_modified_since =
+      pg_http_headers_get_by_id(headers, PG_HTTP_HEADER_ID_IF_MODIFIED_SINCE);
+  if (!if_modified_since.has_value) {
+    return false;
+  }
 
-  case PG_DWARF_FORM_SDATA: {
-    PG_RESULT(i64, PgError) res_read = pg_reader_read_i64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  PG_OPTION(u64) since = pg_http_date_parse(if_modified_since.value);
+  return since.has_value && file->stat.mtime_ns / PG_Seconds <= since.value;
+}
 
-    res.kind = PG_DEBUG_ATOM_KIND_I64;
-    res.u.i64 = PG_UNWRAP(res_read);
-  } break;
+// A `Range` request conditioned by `If-Range` is only honored if the file is
+// unchanged, with the strong comparison.
+[[nodiscard]] static bool
+pg_http_file_if_range_holds(PgHttpHeaders const *headers, PgHttpFile *file) {
+  PG_OPTION(PgString)
+  if_range = pg_http_headers_get_by_id(headers, PG_HTTP_HEADER_ID_IF_RANGE);
+  if (!if_range.has_value) {
+    return true;
+  }
 
-  case PG_DWARF_FORM_EXPRLOC: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
-    u64 length = PG_UNWRAP(res_read);
+  PgString value = pg_string_trim_space(if_range.value);
+  if (pg_string_starts_with(value, PG_S("\""))) {
+    return pg_string_eq(value, pg_http_file_etag(file));
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
-    res.u.bytes = PG_SLICE_RANGE(it->r.u.bytes, 0, length);
+  PG_OPTION(u64) date = pg_http_date_parse(value);
+  return date.has_value && date.value == file->stat.mtime_ns / PG_Seconds;
+}
 
-    PgError err = pg_reader_discard(&it->r, length);
-    if (err) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
-  } break;
+[[nodiscard]] static PgError
+pg_http_file_write_body(PgWriter *w, PgFileDescriptor fd, u64 offset, u64 len,
+                        PgAllocator *allocator) {
+  u8 buf[16 * PG_KiB] = {0};
 
-  case PG_DWARF_FORM_ADDR: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
+  while (len > 0) {
+    PgString dst = {.data = buf, .len = PG_MIN(len, sizeof(buf))};
+    PG_RESULT(u64, PgError) res_read = pg_file_read_at(fd, dst, offset);
+    PG_IF_LET_ERR(err, res_read) { return err; }
 
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    u64 read_count = PG_UNWRAP(res_read);
+    // The file was truncated concurrently.
+    if (0 == read_count) {
+      return PG_ERR_EOF;
     }
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
 
-  case PG_DWARF_FORM_BLOCK1: {
-    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    dst.len = read_count;
+    PgError err = pg_writer_write_full(w, dst, allocator);
+    if (err) {
+      return err;
     }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U8;
-    res.u.u8 = PG_UNWRAP(res_read);
-  } break;
+    offset += read_count;
+    len -= read_count;
+  }
 
-  case PG_DWARF_FORM_BLOCK2: {
-    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  return pg_writer_flush(w, allocator);
+}
 
-    res.kind = PG_DEBUG_ATOM_KIND_U16;
-    res.u.u16 = PG_UNWRAP(res_read);
-  } break;
+// Smaller files barely shrink, and would be sent in more bytes with the
+// chunked framing.
+#define PG_HTTP_FILE_COMPRESS_MIN_LEN 1024
 
-  case PG_DWARF_FORM_BLOCK4: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+// Send the whole file compressed with `encoding`, as a chunked body since the
+// length is only known at the end. Like nginx, the fastest level is used:
+// it gets most of the gain, and compressing on each request must not cost
+// more than sending the difference.
+[[nodiscard]] static PgError
+pg_http_file_write_body_compressed(PgWriter *w, PgHttpFile *file,
+                                   PgHttpContentEncoding encoding,
+                                   PgAllocator *allocator) {
+  PgWriter chunked = pg_http_chunked_writer_make(w, 0, allocator);
+  PgWriter deflate = pg_deflate_writer_make(
+      &chunked,
+      PG_HTTP_CONTENT_ENCODING_GZIP == encoding ? PG_DEFLATE_FORMAT_GZIP
+                                                : PG_DEFLATE_FORMAT_ZLIB,
+      1, allocator);
+
+  PgError err = pg_http_file_write_body(&deflate, file->fd, 0, file->stat.size,
+                                        allocator);
+  if (err) {
+    return err;
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
+  err = pg_deflate_writer_finish(&deflate, allocator);
+  if (err) {
+    return err;
+  }
 
-  case PG_DWARF_FORM_DATA1: {
-    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  return pg_http_chunked_writer_finish(&chunked, (PgHttpHeaders){0},
+                                       allocator);
+}
 
-    res.kind = PG_DEBUG_ATOM_KIND_U8;
-    res.u.u8 = PG_UNWRAP(res_read);
-  } break;
+// Write the response, and then `len` bytes of `fd` from `offset` as its body.
+// On Linux, the body is sent with `sendfile(2)` straight from the page cache
+// to a socket writer, corked with the headers so that small files fit in one
+// segment. Other writers get a copy.
+[[nodiscard]] static PgError
+pg_http_file_send(PgWriter *w, PgHttpResponse res, PgFileDescriptor fd,
+                  u64 offset, u64 len, PgAllocator *allocator) {
+  PgError err = 0;
+#ifdef PG_OS_LINUX
+  if (PG_WRITER_KIND_SOCKET == w->kind) {
+    // Best effort: not supported by e.g. Unix sockets.
+    (void)pg_net_set_cork(w->u.socket, true);
 
-  case PG_DWARF_FORM_DATA2: {
-    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    err = pg_http_write_response(w, res, allocator);
+    if (!err) {
+      err = pg_file_send_to_socket_range(w->u.socket, fd, offset, len);
     }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U16;
-    res.u.u16 = PG_UNWRAP(res_read);
-  } break;
+    (void)pg_net_set_cork(w->u.socket, false);
+    return err;
+  }
+#endif
 
-  case PG_DWARF_FORM_DATA4: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  err = pg_http_write_response(w, res, allocator);
+  if (err) {
+    return err;
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
+  return pg_http_file_write_body(w, fd, offset, len, allocator);
+}
 
-  case PG_DWARF_FORM_DATA8: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+#ifdef PG_OS_LINUX
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 1U
+#endif
 
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
-  case PG_DWARF_FORM_DATA16: {
-    PG_SLICE(u8)
-    dst = {
-        .data = (u8 *)&res.u.u128,
-        .len = sizeof(res.u.u128),
-    };
-    PgError err = pg_reader_read_slice_full(&it->r, dst);
-    if (err) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+// Watch the directory `dir`, relative to the root, rather than the files, so
+// that a file replaced by a rename is seen too. Watching it again is a noop.
+[[nodiscard]] static PgError
+pg_http_file_cache_watch_directory(PgHttpFileCache *cache, PgString dir) {
+  PG_ASSERT(cache->aio);
+
+  u8 full_path_buf[PG_PATH_MAX] = {0};
+  PG_OPTION(PgString)
+  full_path = pg_http_file_cache_full_path(cache, dir, full_path_buf);
+  if (!full_path.has_value) {
+    return PG_ERR_INVALID_VALUE;
+  }
+
+  return pg_aio_register_watch_directory(cache->aio, full_path.value,
+                                         PG_WALK_DIRECTORY_KIND_FILE,
+                                         cache->allocator);
+}
+
+// Compress the whole file once, at the highest level since the cost is
+// amortized over all the requests, and keep it within `gzip_max_bytes` by
+// evicting the least recently used. It is compressed straight into an
+// anonymous file, to be sent with `sendfile(2)` like the file itself, and
+// shared with the children forked afterwards. Compressing stops as soon as
+// the output does not shrink the file or exceeds `gzip_max_bytes`, and the
+// file is then not stored.
+// Marks the file as most recently used if already stored.
+// To call in the parent only, since what a child stores is lost when it exits.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_file_cache_store(PgHttpFileCache *cache, PgHttpFile *file) {
+  PG_ASSERT(file->open);
 
-    res.kind = PG_DEBUG_ATOM_KIND_U128;
-  } break;
+  if (file->gzip) {
+    pg_http_file_lru_unlink(cache, file);
+    pg_http_file_lru_push_front(cache, file);
+    return 0;
+  }
+  if (0 == cache->gzip_max_bytes ||
+      file->stat.size < PG_HTTP_FILE_COMPRESS_MIN_LEN ||
+      !pg_http_content_type_is_compressible(file->content_type)) {
+    return 0;
+  }
+  u64 gzip_len_max = PG_MIN(file->stat.size - 1, cache->gzip_max_bytes);
 
-  case PG_DWARF_FORM_REF1: {
-    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  i32 ret = (i32)syscall(SYS_memfd_create, "pg_http_file", MFD_CLOEXEC);
+  if (-1 == ret) {
+    return (PgError)errno;
+  }
+  PgFileDescriptor gzip_fd = {.fd = ret};
 
-    res.kind = PG_DEBUG_ATOM_KIND_U8;
-    res.u.u8 = PG_UNWRAP(res_read);
-  } break;
+  // For the state of the compressor.
+  PgArenaTemp scratch = pg_scratch_begin(nullptr);
+  PgAllocator *allocator = pg_arena_temp_allocator(&scratch);
+  PgWriter w = pg_writer_make_from_file_descriptor(gzip_fd, 0, allocator);
+  PgWriter deflate =
+      pg_deflate_writer_make(&w, PG_DEFLATE_FORMAT_GZIP, 9, allocator);
 
-  case PG_DWARF_FORM_REF2: {
-    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+  PgError err = 0;
+  u64 gzip_len = 0;
+  u8 buf[16 * PG_KiB] = {0};
+  for (u64 offset = 0; offset < file->stat.size;) {
+    PgString dst = {.data = buf,
+                    .len = PG_MIN(file->stat.size - offset, sizeof(buf))};
+    PG_RESULT(u64, PgError) res_read = pg_file_read_at(file->fd, dst, offset);
+    if (PG_IS_ERR(res_read)) {
+      err = PG_UNWRAP_ERR(res_read);
+      goto end;
+    }
+    dst.len = PG_UNWRAP(res_read);
+    // The file was truncated concurrently.
+    if (0 == dst.len) {
+      err = PG_ERR_EOF;
+      goto end;
     }
+    offset += dst.len;
 
-    res.kind = PG_DEBUG_ATOM_KIND_U16;
-    res.u.u16 = PG_UNWRAP(res_read);
-  } break;
+    err = pg_writer_write_full(&deflate, dst, allocator);
+    if (err) {
+      goto end;
+    }
 
-  case PG_DWARF_FORM_REF4: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    // Output is only written by 16 KiB, see `pg_deflate_writer_make`.
+    PG_RESULT(u64, PgError) res_size = pg_file_size(gzip_fd);
+    if (PG_IS_ERR(res_size)) {
+      err = PG_UNWRAP_ERR(res_size);
+      goto end;
+    }
+    if (PG_UNWRAP(res_size) > gzip_len_max) {
+      goto end;
     }
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
+  err = pg_deflate_writer_finish(&deflate, allocator);
+  if (err) {
+    goto end;
+  }
+  PG_RESULT(u64, PgError) res_size = pg_file_size(gzip_fd);
+  if (PG_IS_ERR(res_size)) {
+    err = PG_UNWRAP_ERR(res_size);
+    goto end;
+  }
+  gzip_len = PG_UNWRAP(res_size);
+  if (gzip_len > gzip_len_max) {
+    goto end;
+  }
 
-  case PG_DWARF_FORM_REF8: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  while (cache->gzip_bytes + gzip_len > cache->gzip_max_bytes) {
+    PG_ASSERT(cache->lru_tail);
+    pg_http_file_drop_gzip(cache, cache->lru_tail);
+  }
+  file->gzip_fd = gzip_fd;
+  file->gzip_len = gzip_len;
+  file->gzip = true;
+  cache->gzip_bytes += gzip_len;
+  pg_http_file_lru_push_front(cache, file);
 
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
+  if (cache->aio) {
+    i64 idx = pg_string_last_index_of_rune(file->path, '/');
+    PgString dir =
+        -1 == idx ? PG_S("") : PG_SLICE_RANGE(file->path, 0, (u64)idx);
+    // Best effort: changes are still seen when revalidating.
+    (void)pg_http_file_cache_watch_directory(cache, dir);
+  }
 
-  case PG_DWARF_FORM_SEC_OFFSET: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+end:
+  if (!file->gzip) {
+    (void)pg_file_close(gzip_fd);
+  }
+  pg_scratch_end(scratch);
+  return err;
+}
 
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
+// Watch the files stored from now on with inotify, to drop them as soon as
+// they change on disk instead of when revalidating. The events are handled by
+// `pg_http_file_cache_refresh`.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_file_cache_watch(PgHttpFileCache *cache) {
+  PG_ASSERT(!cache->aio);
 
-  case PG_DWARF_FORM_RNGLISTX: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
+  PG_RESULT(PgAio, PgError) res_aio = pg_aio_init();
+  PG_IF_LET_ERR(err, res_aio) { return err; }
 
-    // TODO: Read `.debug_rnglists` or let the caller do it (as needed)?
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
+  PgAio *aio = PG_NEW(PgAio, cache->allocator);
+  *aio = PG_UNWRAP(res_aio);
+  PgError err = pg_aio_ensure_inotify(aio);
+  if (err) {
+    (void)pg_file_close(aio->aio);
+    return err;
+  }
 
-  case PG_DWARF_FORM_STRX: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
-    u64 val = PG_UNWRAP(res_read);
-    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+  cache->aio = aio;
+  return 0;
+}
 
-    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
-    res.u.bytes = s;
-  } break;
+// Forget the file at `path`, so that the next `pg_http_file_cache_get` opens
+// it again. Returns whether it had a gzip representation.
+static bool pg_http_file_cache_invalidate(PgHttpFileCache *cache,
+                                          PgString path) {
+  PgHttpFile *file = *pg_http_file_htrie_find(&cache->htrie, path);
+  if (!file) {
+    return false;
+  }
 
-  case PG_DWARF_FORM_STRX1: {
-    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
-    u8 val = PG_UNWRAP(res_read);
-    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+  bool gzip = file->gzip;
+  pg_http_file_drop_gzip(cache, file);
+  if (file->open) {
+    (void)pg_file_close(file->fd);
+    file->open = false;
+  }
+  return gzip;
+}
 
-    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
-    res.u.bytes = s;
-  } break;
+// Handle the pending events of the watch without blocking: the files changed
+// on disk are forgotten, and those which had a gzip representation are
+// compressed again, one per call to bound the time spent. Until then, they
+// are compressed on each request.
+// `pg_http_server_start` calls it in the parent for each connection, since
+// what a child stores is lost when it exits.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_file_cache_refresh(PgHttpFileCache *cache) {
+  if (!cache->aio) {
+    return 0;
+  }
 
-  case PG_DWARF_FORM_STRX2: {
-    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+  PgArenaTemp scratch = pg_scratch_begin(nullptr);
+  PgAllocator *allocator = pg_arena_temp_allocator(&scratch);
+  PgError err = 0;
+
+  PG_DYN(PgAioEvent) events = {0};
+  PG_RESULT(u64, PgError)
+  res_wait = pg_aio_fs_wait(cache->aio, &events, PG_SOME(0, u32), allocator);
+  if (PG_IS_ERR(res_wait)) {
+    err = PG_UNWRAP_ERR(res_wait);
+  }
+
+  PG_EACH_PTR(event, &events) {
+    PgAioFsNode *fs_node =
+        pg_aio_fs_node_upsert(&cache->aio->fs_nodes, event->fd, nullptr);
+    PG_ASSERT(fs_node);
+
+    // Watched directories are under the root.
+    PgString dir = PG_SLICE_RANGE_START(
+        fs_node->name, PG_MIN(cache->root.len + 1, fs_node->name.len));
+    PgString path =
+        0 == dir.len ? event->name : pg_path_join(dir, event->name, allocator);
+    if (pg_http_file_cache_invalidate(cache, path)) {
+      PgHttpFile *file = *pg_http_file_htrie_find(&cache->htrie, path);
+      if (!file->refresh_pending) {
+        file->refresh_pending = true;
+        PG_DYN_PUSH(&cache->refresh_pending, file, cache->allocator);
+      }
     }
-    u16 val = PG_UNWRAP(res_read);
-    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
-    res.u.bytes = s;
-  } break;
+  if (cache->refresh_pending.len) {
+    PgHttpFile *file = PG_SLICE_AT(cache->refresh_pending, 0);
+    PG_SLICE_REMOVE_AT(&cache->refresh_pending, 0);
+    file->refresh_pending = false;
 
-  case PG_DWARF_FORM_STRX3: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u24_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    PG_RESULT(PgHttpFilePtr, PgError)
+    res_file = pg_http_file_cache_get(cache, file->path);
+    // Best effort: e.g. deleted.
+    if (PG_IS_OK(res_file)) {
+      (void)pg_http_file_cache_store(cache, PG_UNWRAP(res_file));
     }
-    u32 val = PG_UNWRAP(res_read);
-    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
-    res.u.bytes = s;
-  } break;
+  pg_scratch_end(scratch);
+  return err;
+}
+#endif
 
-  case PG_DWARF_FORM_STRX4: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
-    }
-    u32 val = PG_UNWRAP(res_read);
-    PgString s = pg_dwarf_resolve_string(it->str_offsets, it->str_bytes, val);
+// Open the files under `dir`, relative to the root, and store their gzip
+// representation.
+[[nodiscard]] static PgError
+pg_http_file_cache_preload_directory(PgHttpFileCache *cache, PgString dir) {
+  u8 full_path_buf[PG_PATH_MAX] = {0};
+  PG_OPTION(PgString)
+  full_path = pg_http_file_cache_full_path(cache, dir, full_path_buf);
+  if (!full_path.has_value) {
+    return PG_ERR_INVALID_VALUE;
+  }
 
-    res.kind = PG_DEBUG_ATOM_KIND_BYTES;
-    res.u.bytes = s;
-  } break;
+  PgDirectory d = PG_TRY_ERR(pg_directory_open(full_path.value));
+  PgError err = 0;
+  u8 path_buf[PG_PATH_MAX] = {0};
 
-  case PG_DWARF_FORM_ADDRX: {
-    PG_RESULT(u64, PgError) res_read = pg_reader_read_u64_leb128(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+  for (;;) {
+    PG_RESULT(PgDirectoryEntry, PgError) res_read = pg_directory_read(&d);
+    if (PG_IS_ERR(res_read)) {
+      err = PG_UNWRAP_ERR(res_read);
+      break;
     }
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
-
-  case PG_DWARF_FORM_ADDRX1: {
-    PG_RESULT(u8, PgError) res_read = pg_reader_read_u8_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    PgDirectoryEntry dirent = PG_UNWRAP(res_read);
+    if (!dirent) {
+      break; // EOF.
     }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U8;
-    res.u.u8 = PG_UNWRAP(res_read);
-  } break;
-
-  case PG_DWARF_FORM_ADDRX2: {
-    PG_RESULT(u16, PgError) res_read = pg_reader_read_u16_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    PgString name = pg_dirent_name(dirent);
+    if (pg_string_eq(name, PG_S(".")) || pg_string_eq(name, PG_S(".."))) {
+      continue;
     }
 
-    res.kind = PG_DEBUG_ATOM_KIND_U16;
-    res.u.u16 = PG_UNWRAP(res_read);
-  } break;
-
-  case PG_DWARF_FORM_ADDRX3: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u24_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    if (dir.len + 1 + name.len > PG_PATH_MAX) {
+      continue;
     }
-
-    res.kind = PG_DEBUG_ATOM_KIND_U32;
-    res.u.u32 = PG_UNWRAP(res_read);
-  } break;
-
-  case PG_DWARF_FORM_ADDRX4: {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&it->r);
-    PG_IF_LET_ERR(err, res_read) {
-      return PG_ERR(err, PG_OPTION(PgDwarfAtom), PgError);
+    PgString path = {.data = path_buf};
+    if (dir.len) {
+      pg_memcpy(path.data, dir.data, dir.len);
+      path.len += dir.len;
+      path.data[path.len++] = '/';
+    }
+    pg_memcpy(path.data + path.len, name.data, name.len);
+    path.len += name.len;
+
+    if (pg_dirent_is_directory(dirent)) {
+      err = pg_http_file_cache_preload_directory(cache, path);
+    } else if (pg_dirent_is_file(dirent)) {
+      PG_RESULT(PgHttpFilePtr, PgError)
+      res_file = pg_http_file_cache_get(cache, path);
+      // Skipped, as when requested.
+      if (PG_IS_OK(res_file)) {
+#ifdef PG_OS_LINUX
+        err = pg_http_file_cache_store(cache, PG_UNWRAP(res_file));
+#endif
+      }
+    }
+    if (err) {
+      break;
     }
-
-    res.kind = PG_DEBUG_ATOM_KIND_U64;
-    res.u.u64 = PG_UNWRAP(res_read);
-  } break;
-
-  case PG_DWARF_FORM_NONE:
-  default:
-    return PG_ERR(PG_ERR_DWARF_UNKNOWN_FORM, PG_OPTION(PgDwarfAtom), PgError);
   }
 
-  if (PG_DWARF_TAG_NULL != res.abbrev.tag) {
-    PG_ASSERT(PG_DWARF_AT_NONE != res.attr_form.attribute);
-    PG_ASSERT(PG_DWARF_FORM_NONE != res.attr_form.form);
-  }
-  return PG_OK(PG_SOME(res, PgDwarfAtom), PG_OPTION(PgDwarfAtom), PgError);
+  (void)pg_directory_close(d);
+  return err;
 }
 
-[[nodiscard]] static bool
-pg_dwarf_abbreviation_entry_is_function_like(PgDwarfAbbreviationEntry abbrev) {
-  return PG_DWARF_TAG_SUBPROGRAM == abbrev.tag ||
-         PG_DWARF_TAG_INLINED_SUBROUTINE == abbrev.tag;
-}
+// Open all the files under the root ahead of the first request and, with
+// `gzip_max_bytes`, compress them. To call before `pg_http_server_start`:
+// children share what the parent opened and stored, while what a child
+// stores is lost when it exits. Beyond the budget, the files visited last are
+// kept.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_file_cache_preload(PgHttpFileCache *cache) {
+  return pg_http_file_cache_preload_directory(cache, PG_S(""));
+}
+
+// Answer a `GET` or `HEAD` request for a static file of `cache`, including
+// conditional (`304`) and single range (`206`) requests, see
+// `pg_http_file_send`.
+// Text files are compressed with gzip or deflate when the client accepts it,
+// unless only a range is requested, which needs about 300 KiB of `allocator`.
+// The compressed representation has its own ETag. With `gzip_max_bytes`, the
+// gzip one stored beforehand, see `pg_http_file_cache_preload`, is sent like
+// the file itself. Nothing is stored here, since requests are served by
+// forked children: other files are compressed on the fly.
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_http_file_serve(PgHttpFileCache *cache, PgHttpServerRequest req,
+                   PgWriter *w, PgAllocator *allocator) {
+  PgHttpResponse res = {.version_major = 1, .version_minor = 1};
 
-[[maybe_unused]] [[nodiscard]] static bool
-pg_dwarf_attribute_is_name_like(PgDwarfAttribute attribute) {
-  return PG_DWARF_AT_NAME == attribute ||
-         PG_DWARF_AT_ABSTRACT_ORIGIN == attribute;
-}
+  if (PG_HTTP_METHOD_GET != req.method && PG_HTTP_METHOD_HEAD != req.method) {
+    res.status = 405;
+    pg_http_push_header(&res.headers, PG_S("Allow"), PG_S("GET, HEAD"),
+                        allocator);
+    pg_http_push_header(&res.headers, PG_S("Content-Length"), PG_S("0"),
+                        allocator);
+    return pg_http_write_response(w, res, allocator);
+  }
 
-[[maybe_unused]] [[maybe_unused]] static PgError
-pg_dwarf_atom_println(PgWriter *w, PgDwarfAtom atom, PgAllocator *allocator) {
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("type="), allocator));
-  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, atom.abbrev.type, allocator));
+  PgHttpFile *file = nullptr;
+  {
+    PG_RESULT(PgString, PgError)
+    res_path = pg_http_file_path_from_target(req.target, allocator);
+    PG_RESULT(PgHttpFilePtr, PgError) res_file = {0};
+    if (PG_IS_OK(res_path)) {
+      res_file = pg_http_file_cache_get(cache, PG_UNWRAP(res_path));
+    }
+
+    if (!PG_IS_OK(res_file)) {
+      res.status = 404;
+      pg_http_push_header(&res.headers, PG_S("Content-Length"), PG_S("0"),
+                          allocator);
+      return pg_http_write_response(w, res, allocator);
+    }
+    file = PG_UNWRAP(res_file);
+  }
+
+  u64 size = file->stat.size;
+  PG_OPTION(PgString)
+  range_value =
+      pg_http_headers_get_by_id(&req.headers, PG_HTTP_HEADER_ID_RANGE);
+
+  // HTTP/1.0 has no chunked bodies.
+  bool compressible =
+      size >= PG_HTTP_FILE_COMPRESS_MIN_LEN &&
+      pg_http_content_type_is_compressible(file->content_type);
+  PgHttpContentEncoding encoding = PG_HTTP_CONTENT_ENCODING_IDENTITY;
+  if (compressible && !range_value.has_value &&
+      !(1 == req.version_major && 0 == req.version_minor)) {
+    encoding = pg_http_negotiate_content_encoding(&req.headers);
+  }
+
+  PgString etag = pg_http_file_etag(file);
+  if (PG_HTTP_CONTENT_ENCODING_IDENTITY != encoding) {
+    PgString suffix = PG_HTTP_CONTENT_ENCODING_GZIP == encoding
+                          ? PG_S("-gzip\"")
+                          : PG_S("-deflate\"");
+    etag = pg_string_concat(PG_SLICE_RANGE(etag, 0, etag.len - 1), suffix,
+                            allocator);
+  }
+
+  pg_http_push_header(&res.headers, PG_S("ETag"), etag, allocator);
+  pg_http_push_header(&res.headers, PG_S("Last-Modified"),
+                      pg_http_file_last_modified(file), allocator);
+  pg_http_push_header(&res.headers, PG_S("Accept-Ranges"), PG_S("bytes"),
+                      allocator);
+  if (compressible) {
+    pg_http_push_header(&res.headers, PG_S("Vary"), PG_S("Accept-Encoding"),
+                        allocator);
+  }
+
+  if (pg_http_file_not_modified(&req.headers, file, etag)) {
+    res.status = 304;
+    return pg_http_write_response(w, res, allocator);
+  }
+
+  if (PG_HTTP_CONTENT_ENCODING_IDENTITY != encoding) {
+    res.status = 200;
+    pg_http_push_header(&res.headers, PG_S("Content-Type"), file->content_type,
+                        allocator);
+    pg_http_push_header(&res.headers, PG_S("Content-Encoding"),
+                        PG_HTTP_CONTENT_ENCODING_GZIP == encoding
+                            ? PG_S("gzip")
+                            : PG_S("deflate"),
+                        allocator);
+
+    if (PG_HTTP_CONTENT_ENCODING_GZIP == encoding && file->gzip) {
+      pg_http_push_header(&res.headers, PG_S("Content-Length"),
+                          pg_u64_to_string(file->gzip_len, allocator),
+                          allocator);
+      if (PG_HTTP_METHOD_HEAD == req.method) {
+        return pg_http_write_response(w, res, allocator);
+      }
+      return pg_http_file_send(w, res, file->gzip_fd, 0, file->gzip_len,
+                               allocator);
+    }
 
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" tag="), allocator));
-  PgString tag_str = pg_dwarf_tag_str[atom.abbrev.tag];
-  PG_ERR_RETURN(pg_writer_write_full(w, tag_str, allocator));
+    pg_http_push_header(&res.headers, PG_S("Transfer-Encoding"),
+                        PG_S("chunked"), allocator);
 
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" attribute="), allocator));
-  PgString attr_str = pg_dwarf_attribute_str[atom.attr_form.attribute];
-  PG_ERR_RETURN(pg_writer_write_full(w, attr_str, allocator));
+    PgError err = pg_http_write_response(w, res, allocator);
+    if (err || PG_HTTP_METHOD_HEAD == req.method) {
+      return err;
+    }
+    return pg_http_file_write_body_compressed(w, file, encoding, allocator);
+  }
 
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" form="), allocator));
-  PgString form_str = pg_dwarf_form_str[atom.attr_form.form];
-  PG_ERR_RETURN(pg_writer_write_full(w, form_str, allocator));
+  PgHttpRange range = {0};
+  if (range_value.has_value &&
+      pg_http_file_if_range_holds(&req.headers, file)) {
+    range = pg_http_range_parse(range_value.value, size);
+  }
 
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" value="), allocator));
-  switch (atom.kind) {
-  case PG_DEBUG_ATOM_KIND_NO_DATA:
-    break;
-  case PG_DEBUG_ATOM_KIND_U8:
-    PG_ERR_RETURN(pg_writer_write_u64_hex(w, (u64)atom.u.u8, allocator));
-    break;
-  case PG_DEBUG_ATOM_KIND_U16:
-    PG_ERR_RETURN(pg_writer_write_u64_hex(w, (u64)atom.u.u16, allocator));
-    break;
-  case PG_DEBUG_ATOM_KIND_U32:
-    PG_ERR_RETURN(pg_writer_write_u64_hex(w, (u64)atom.u.u32, allocator));
-    break;
-  case PG_DEBUG_ATOM_KIND_U64:
-    PG_ERR_RETURN(pg_writer_write_u64_hex(w, atom.u.u64, allocator));
-    break;
-  case PG_DEBUG_ATOM_KIND_I64:
-    PG_ERR_RETURN(pg_writer_write_i64_as_string(w, atom.u.u64, allocator));
+  PgWriter content_range = pg_writer_make_string_builder(64, allocator);
+  PG_ASSERT(0 == pg_writer_write_full(&content_range, PG_S("bytes "),
+                                      allocator));
+  switch (range.kind) {
+  case PG_HTTP_RANGE_KIND_NONE:
+    res.status = 200;
+    range.start = 0;
+    range.end = size;
     break;
-  case PG_DEBUG_ATOM_KIND_BYTES:
-    PG_ERR_RETURN(pg_writer_write_full(w, atom.u.bytes, allocator));
+  case PG_HTTP_RANGE_KIND_SATISFIABLE:
+    res.status = 206;
+    PG_ASSERT(0 == pg_writer_write_u64_as_string(&content_range, range.start,
+                                                 allocator));
+    PG_ASSERT(0 == pg_writer_write_u8(&content_range, '-', allocator));
+    PG_ASSERT(0 == pg_writer_write_u64_as_string(&content_range,
+                                                 range.end - 1, allocator));
     break;
-  case PG_DEBUG_ATOM_KIND_U128:
-    PG_ERR_RETURN(pg_writer_write_u128_as_string(w, atom.u.u128, allocator));
+  case PG_HTTP_RANGE_KIND_UNSATISFIABLE:
+    res.status = 416;
+    PG_ASSERT(0 == pg_writer_write_u8(&content_range, '*', allocator));
+    range.start = range.end = 0;
     break;
   default:
     PG_ASSERT(0);
   }
 
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
-  PG_ERR_RETURN(pg_writer_flush(w, allocator));
+  if (PG_HTTP_RANGE_KIND_NONE != range.kind) {
+    PG_ASSERT(0 == pg_writer_write_u8(&content_range, '/', allocator));
+    PG_ASSERT(0 ==
+              pg_writer_write_u64_as_string(&content_range, size, allocator));
+    pg_http_push_header(&res.headers, PG_S("Content-Range"),
+                        PG_DYN_TO_SLICE(PgString, content_range.u.bytes),
+                        allocator);
+  }
 
-  return 0;
+  u64 len = range.end - range.start;
+  if (PG_HTTP_RANGE_KIND_UNSATISFIABLE != range.kind) {
+    pg_http_push_header(&res.headers, PG_S("Content-Type"), file->content_type,
+                        allocator);
+  }
+  pg_http_push_header(&res.headers, PG_S("Content-Length"),
+                      pg_u64_to_string(len, allocator), allocator);
+
+  if (PG_HTTP_METHOD_HEAD == req.method || 0 == len) {
+    return pg_http_write_response(w, res, allocator);
+  }
+
+  return pg_http_file_send(w, res, file->fd, range.start, len, allocator);
 }
 
-[[nodiscard]] [[maybe_unused]] PG_OPTION(u64)
-    pg_dwarf_atom_as_u64(PgDwarfAtom atom) {
-  switch (atom.kind) {
-  case PG_DEBUG_ATOM_KIND_U8:
-    return PG_SOME(atom.u.u8, u64);
-  case PG_DEBUG_ATOM_KIND_U16:
-    return PG_SOME(atom.u.u16, u64);
-  case PG_DEBUG_ATOM_KIND_U32:
-    return PG_SOME(atom.u.u32, u64);
-  case PG_DEBUG_ATOM_KIND_U64:
-    return PG_SOME(atom.u.u64, u64);
+// `PgHttpHandler` serving the files of the `PgHttpFileCache` passed as `ctx`.
+// Since each connection is handled in a child process, only the files opened
+// by the parent beforehand, e.g. with `pg_http_file_cache_preload`, are shared
+// by all connections: the others are opened again for each connection.
+[[maybe_unused]] static void
+pg_http_file_handler(PgHttpServerRequest req, PgReader *reader,
+                     PgWriter *writer, PgLogger *logger, PgAllocator *allocator,
+                     void *ctx) {
+  (void)reader;
+  PG_ASSERT(ctx);
 
-  case PG_DEBUG_ATOM_KIND_NO_DATA:
-  case PG_DEBUG_ATOM_KIND_I64:
-  case PG_DEBUG_ATOM_KIND_BYTES:
-  case PG_DEBUG_ATOM_KIND_U128:
-    return PG_NONE(u64);
-  default:
-    PG_ASSERT(0);
+  PgError err = pg_http_file_serve(ctx, req, writer, allocator);
+  if (err) {
+    pg_log(logger, PG_LOG_LEVEL_ERROR, "http file handler: failed to serve",
+           pg_log_c_err("err", err));
   }
 }
 
-[[nodiscard]] [[maybe_unused]] PG_OPTION(bool)
-    pg_dwarf_atom_as_bool(PgDwarfAtom atom) {
-  PG_OPTION(u64) val = pg_dwarf_atom_as_u64(atom);
-  if (!val.has_value) {
-    return PG_NONE(bool);
+// Entry of `name`, created pending if absent.
+[[nodiscard]] static PgDnsEntry *pg_dns_resolver_upsert(PgDnsResolver *r,
+                                                        PgString name) {
+  u8 lower_data[PG_DNS_NAME_MAX_LEN] = {0};
+  PG_ASSERT(name.len <= PG_DNS_NAME_MAX_LEN);
+  PgString lower = {.data = lower_data, .len = name.len};
+  for (u64 i = 0; i < name.len; i++) {
+    PG_SLICE_AT(lower, i) =
+        (u8)pg_rune_ascii_to_lower_case(PG_SLICE_AT(name, i));
   }
-  return PG_SOME(val.value, bool);
-}
 
-[[nodiscard]] static PG_RESULT(PG_DYN(PgDebugFunctionDeclaration), PgError)
-    pg_dwarf_collect_functions(PgDebugInfoIterator *it,
-                               PgAllocator *allocator) {
-  PG_DYN(PgDebugFunctionDeclaration) res = {0};
+  PgDnsEntry **htrie = &r->htrie;
+  for (u64 h = pg_hash_fnv(lower); *htrie; h <<= 2) {
+    if (pg_string_eq(lower, (*htrie)->name)) {
+      return *htrie;
+    }
+    htrie = &(*htrie)->child[h >> 62];
+  }
 
-  PgDebugFunctionDeclaration fn = {0};
-  u64 current_die_offset = 0;
+  *htrie = PG_NEW(PgDnsEntry, r->allocator);
+  (*htrie)->name = pg_string_clone(lower, r->allocator);
+  return *htrie;
+}
+
+// Add the entries of the content of a `/etc/hosts` file. They take
+// precedence over DNS and never expire. Only IPv4 addresses are kept.
+[[maybe_unused]] static void pg_dns_resolver_add_hosts(PgDnsResolver *r,
+                                                       PgString content) {
+  PgSplitIterator it_lines = pg_string_split_string(content, PG_S("\n"));
   for (;;) {
-    PG_RESULT(PG_OPTION(PgDwarfAtom), PgError)
-    res_next = pg_dwarf_compilation_unit_debug_info_next(it);
-    PG_IF_LET_ERR(err, res_next) {
-      return PG_ERR(err, PG_DYN(PgDebugFunctionDeclaration), PgError);
+    PG_OPTION(PgString) line = pg_string_split_next(&it_lines);
+    if (!line.has_value) {
+      break;
     }
-    PG_OPTION(PgDwarfAtom) atom_opt = PG_UNWRAP(res_next);
 
-    // The end.
-    if (!atom_opt.has_value) {
-      PG_DYN_PUSH(&res, fn, allocator);
-      goto end;
-    }
+    PgStringCut cut_comment = pg_string_cut_rune(line.value, '#');
+    PgString rest = cut_comment.has_value ? cut_comment.left : line.value;
 
-    PgDwarfAtom atom = atom_opt.value;
+    PG_OPTION(u32) ip = {0};
+    for (u64 i = 0;; i++) {
+      rest = pg_string_trim_space(rest);
+      if (pg_string_is_empty(rest)) {
+        break;
+      }
 
-    // Only interested in functions.
-    if (!pg_dwarf_abbreviation_entry_is_function_like(atom.abbrev)) {
-      continue;
-    }
+      u64 field_len = 0;
+      for (; field_len < rest.len &&
+             !pg_rune_ascii_is_space(PG_SLICE_AT(rest, field_len));
+           field_len++) {
+      }
+      PgString field = PG_SLICE_RANGE(rest, 0, field_len);
+      rest = PG_SLICE_RANGE_START(rest, field_len);
 
-    if (0 == current_die_offset) {
-      current_die_offset = atom.debug_info_offset;
+      if (0 == i) {
+        ip = pg_net_ipv4_parse(field);
+        if (!ip.has_value) { // E.g. IPv6.
+          break;
+        }
+        continue;
+      }
+      if (field.len > PG_DNS_NAME_MAX_LEN) {
+        continue;
+      }
+
+      PgDnsEntry *entry = pg_dns_resolver_upsert(r, field);
+      if (PG_DNS_ENTRY_STATE_RESOLVED != entry->state ||
+          0 != entry->expires_at_ns) {
+        entry->addresses.len = 0;
+      }
+      entry->state = PG_DNS_ENTRY_STATE_RESOLVED;
+      entry->expires_at_ns = 0;
+      PG_DYN_PUSH(&entry->addresses, ip.value, r->allocator);
     }
+  }
+}
 
-    if (current_die_offset != atom.debug_info_offset) {
-      PG_DYN_PUSH(&res, fn, allocator);
-      fn = (PgDebugFunctionDeclaration){0};
-      fn.debug_info_offset = atom.debug_info_offset;
+// `/etc/resolv.conf` and `/etc/hosts` are read once here.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgDnsResolver, PgError)
+    pg_dns_resolver_make(PgDnsResolverOptions options,
+                         PgAllocator *allocator) {
+  PgDnsResolver r = {.allocator = allocator, .rng = pg_rand_make()};
 
-      current_die_offset = atom.debug_info_offset;
-    }
+  if (0 == options.server.ip) {
+    PG_RESULT(PgString, PgError)
+    res_conf =
+        pg_file_read_full_from_path(PG_S("/etc/resolv.conf"), allocator);
+    PG_OPTION(u32)
+    ip = pg_dns_resolv_conf_nameserver(PG_UNWRAP_OR_DEFAULT(res_conf));
+    // Same default as the libc.
+    options.server.ip = ip.has_value ? ip.value : 0x7f000001;
+  }
+  if (0 == options.server.port) {
+    options.server.port = 53;
+  }
+  if (0 == options.timeout_ms) {
+    options.timeout_ms = 2000;
+  }
+  if (0 == options.attempts) {
+    options.attempts = 2;
+  }
+  if (0 == options.negative_ttl_ms) {
+    options.negative_ttl_ms = 5000;
+  }
+  if (0 == options.max_ttl_ms) {
+    options.max_ttl_ms = 3600 * 1000;
+  }
+  r.options = options;
 
-    if (PG_DWARF_TAG_INLINED_SUBROUTINE == atom.abbrev.tag) {
-      fn.inlined = true;
-    }
+  PG_RESULT(PgString, PgError)
+  res_hosts = pg_file_read_full_from_path(PG_S("/etc/hosts"), allocator);
+  pg_dns_resolver_add_hosts(&r, PG_UNWRAP_OR_DEFAULT(res_hosts));
 
-    if (PG_DWARF_AT_LOW_PC == atom.attr_form.attribute) {
-      fn.low_pc = PG_SLICE_AT(it->unit.addresses, atom.u.u64);
-      //      fprintf(stderr, "[D001] low_pc=%#lx high_pc=%#lx name=%.*s
-      //      offset=%lu\n",
-      //              fn.low_pc, fn.high_pc, PG_S_FMT(fn.name),
-      //              atom.debug_info_offset);
-    } else if (PG_DWARF_AT_NAME == atom.attr_form.attribute) {
-      fn.name = pg_string_clone(atom.u.bytes, allocator);
-      //      fprintf(stderr, "[D002] low_pc=%#lx high_pc=%#lx name=%.*s
-      //      offset=%lu\n",
-      //              fn.low_pc, fn.high_pc, PG_S_FMT(fn.name),
-      //              atom.debug_info_offset);
-    } else if (PG_DWARF_AT_HIGH_PC == atom.attr_form.attribute) {
-      fn.high_pc = fn.low_pc + atom.u.u64;
-      //      fprintf(stderr, "[D003] low_pc=%#lx high_pc=%#lx name=%.*s
-      //      offset=%lu\n",
-      //              fn.low_pc, fn.high_pc, PG_S_FMT(fn.name),
-      //              atom.debug_info_offset);
-    } else if (PG_DWARF_AT_ABSTRACT_ORIGIN == atom.attr_form.attribute) {
-      // To be resolved later.
-      PG_OPTION(u64) val_opt = pg_dwarf_atom_as_u64(atom);
-      if (!val_opt.has_value) {
-        return PG_ERR(PG_ERR_DWARF_INVALID_ATTR_FORM_VALUE,
-                      PG_DYN(PgDebugFunctionDeclaration), PgError);
-      }
-      fn.debug_info_offset_ref = val_opt.value;
-    } else if (PG_DWARF_AT_INLINE == atom.attr_form.attribute) {
-      PG_OPTION(bool) val_opt = pg_dwarf_atom_as_bool(atom);
-      if (!val_opt.has_value) {
-        return PG_ERR(PG_ERR_DWARF_INVALID_ATTR_FORM_VALUE,
-                      PG_DYN(PgDebugFunctionDeclaration), PgError);
-      }
-      fn.inlined = val_opt.value;
+  PG_RESULT(PgFileDescriptor, PgError) res_socket = pg_net_create_udp_socket();
+  PG_IF_LET_ERR(err, res_socket) { return PG_ERR(err, PgDnsResolver, PgError); }
+  r.socket = PG_UNWRAP(res_socket);
+
+  // Connected, so that the kernel drops datagrams from other senders.
+  PgError err = pg_net_connect_ipv4(r.socket, options.server);
+  if (err) {
+    goto fail;
+  }
+  err = pg_fd_set_blocking(r.socket, false);
+  if (err) {
+    goto fail;
+  }
+
+  PG_RESULT(PgAio, PgError) res_aio = pg_aio_init();
+  PG_IF_LET_ERR(err_aio, res_aio) {
+    err = err_aio;
+    goto fail;
+  }
+  r.aio = PG_UNWRAP(res_aio);
+
+  err = pg_aio_register_interest_fd(r.aio, r.socket,
+                                    PG_AIO_EVENT_KIND_READABLE);
+  if (err) {
+    (void)pg_file_close(r.aio.aio);
+    goto fail;
+  }
+
+  return PG_OK(r, PgDnsResolver, PgError);
+
+fail:
+  (void)pg_net_socket_close(r.socket);
+  return PG_ERR(err, PgDnsResolver, PgError);
+}
+
+[[maybe_unused]] static void pg_dns_resolver_close(PgDnsResolver *r) {
+  (void)pg_file_close(r->aio.aio);
+  (void)pg_net_socket_close(r->socket);
+}
+
+static void pg_dns_resolver_fail(PgDnsResolver *r, PgDnsEntry *entry,
+                                 PgError err, u64 ttl_ms, u64 now_ns) {
+  entry->state = PG_DNS_ENTRY_STATE_FAILED;
+  entry->err = err;
+  entry->addresses.len = 0;
+  entry->expires_at_ns = now_ns + PG_MAX(ttl_ms, 1) * PG_Milliseconds;
+
+  for (u64 i = 0; i < r->pending.len; i++) {
+    if (entry == PG_SLICE_AT(r->pending, i)) {
+      PG_SLICE_SWAP_REMOVE(&r->pending, i);
+      break;
     }
   }
+}
 
-end:
-  // TODO: This is quadratic, speed up by using a hashtrie.
-  // Also, only DIEs with the attribute/form `DW_AT_inline`/true need to be
-  // resolved.
-  PG_EACH_PTR(a, &res) {
-    if (0 == a->debug_info_offset_ref) {
-      continue;
+// (Re)send the query of a pending entry, with a new id.
+static void pg_dns_resolver_send(PgDnsResolver *r, PgDnsEntry *entry,
+                                 u64 now_ns) {
+  u16 id = 0;
+  for (bool taken = true; taken;) {
+    id = (u16)pg_rand_u32_min_incl_max_incl(&r->rng, 0, UINT16_MAX);
+    taken = false;
+    PG_EACH_PTR(it, &r->pending) {
+      taken |= (*it != entry && (*it)->query_id == id);
     }
+  }
 
-    PG_EACH_PTR(b, &res) {
-      if (a->debug_info_offset_ref == b->debug_info_offset) {
-        a->name = b->name;
-        a->inlined = b->inlined;
+  entry->query_id = id;
+  entry->sent_at_ns = now_ns;
+  entry->attempts += 1;
+
+  u8 query_data[PG_DNS_UDP_MAX_LEN] = {0};
+  PgString query = {.data = query_data, .len = sizeof(query_data)};
+  PG_RESULT(u64, PgError)
+  res_encode = pg_dns_query_encode(id, entry->name, query);
+  PG_IF_LET_ERR(err, res_encode) {
+    pg_dns_resolver_fail(r, entry, err, r->options.negative_ttl_ms, now_ns);
+    return;
+  }
+  query.len = PG_UNWRAP(res_encode);
+
+  PG_RESULT(u64, PgError) res_send = pg_net_socket_write(r->socket, query);
+  PG_IF_LET_ERR(err, res_send) {
+    pg_dns_resolver_fail(r, entry, err, r->options.negative_ttl_ms, now_ns);
+    return;
+  }
+  r->queries_sent += 1;
+}
+
+// Answer from the cache, or send a query unless one is already in flight for
+// this name. Never blocks. IP literals are answered as is.
+[[maybe_unused]] [[nodiscard]] static PgDnsLookup
+pg_dns_resolver_lookup(PgDnsResolver *r, PgString name, u64 now_ns) {
+  PgDnsLookup res = {0};
+
+  if (pg_string_ends_with(name, PG_S("."))) {
+    name = PG_SLICE_RANGE(name, 0, name.len - 1);
+  }
+  if (pg_string_is_empty(name) || name.len > PG_DNS_NAME_MAX_LEN) {
+    res.err = PG_ERR_INVALID_VALUE;
+    return res;
+  }
+
+  PgDnsEntry *entry = pg_dns_resolver_upsert(r, name);
+
+  if (PG_DNS_ENTRY_STATE_PENDING == entry->state && 0 == entry->attempts) {
+    // New.
+    PG_OPTION(u32) ip = pg_net_ipv4_parse(name);
+    if (ip.has_value) {
+      entry->state = PG_DNS_ENTRY_STATE_RESOLVED;
+      PG_DYN_PUSH(&entry->addresses, ip.value, r->allocator);
+    } else {
+      PG_DYN_PUSH(&r->pending, entry, r->allocator);
+      pg_dns_resolver_send(r, entry, now_ns);
+    }
+  } else if (PG_DNS_ENTRY_STATE_PENDING != entry->state &&
+             0 != entry->expires_at_ns && now_ns >= entry->expires_at_ns) {
+    // Expired: refresh.
+    entry->state = PG_DNS_ENTRY_STATE_PENDING;
+    entry->attempts = 0;
+    entry->err = 0;
+    PG_DYN_PUSH(&r->pending, entry, r->allocator);
+    pg_dns_resolver_send(r, entry, now_ns);
+  }
+
+  switch (entry->state) {
+  case PG_DNS_ENTRY_STATE_PENDING:
+    res.pending = true;
+    break;
+  case PG_DNS_ENTRY_STATE_RESOLVED:
+    res.addresses = PG_DYN_TO_SLICE(PG_SLICE(u32), entry->addresses);
+    break;
+  case PG_DNS_ENTRY_STATE_FAILED:
+    res.err = entry->err;
+    break;
+  default:
+    PG_ASSERT(0);
+  }
+  return res;
+}
+
+static void pg_dns_resolver_apply(PgDnsResolver *r, PgDnsEntry *entry,
+                                  PgDnsAnswer answer, u64 now_ns) {
+  if (answer.addresses.len > 0) {
+    u64 ttl_ms = PG_MIN(answer.ttl_s * 1000, r->options.max_ttl_ms);
+    // A TTL of 0 would not even last until the waiters look the name up.
+    ttl_ms = PG_MAX(ttl_ms, 1000);
+
+    entry->state = PG_DNS_ENTRY_STATE_RESOLVED;
+    entry->err = 0;
+    entry->addresses.len = 0;
+    PG_DYN_APPEND_SLICE(&entry->addresses, answer.addresses, r->allocator);
+    entry->expires_at_ns = now_ns + ttl_ms * PG_Milliseconds;
+
+    for (u64 i = 0; i < r->pending.len; i++) {
+      if (entry == PG_SLICE_AT(r->pending, i)) {
+        PG_SLICE_SWAP_REMOVE(&r->pending, i);
+        break;
       }
     }
+    return;
   }
 
-  return PG_OK(res, PG_DYN(PgDebugFunctionDeclaration), PgError);
+  bool not_found =
+      0 == answer.rcode || PG_DNS_RCODE_NXDOMAIN == answer.rcode;
+  u64 ttl_ms = (not_found && answer.ttl_present)
+                   ? PG_MIN(answer.ttl_s * 1000, r->options.max_ttl_ms)
+                   : r->options.negative_ttl_ms;
+  pg_dns_resolver_fail(
+      r, entry, not_found ? PG_ERR_DNS_NOT_FOUND : PG_ERR_DNS_SERVER_FAILURE,
+      ttl_ms, now_ns);
 }
 
+// Process the answers received so far.
 [[maybe_unused]] [[nodiscard]] static PgError
-pg_dwarf_compilation_unit_print_abbreviation(PgWriter *w,
-                                             PgDwarfDebugInfoCompilationUnit cu,
-                                             PgDwarfAbbreviationEntry abbrev,
-                                             PgAllocator *allocator) {
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("type="), allocator));
-  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, abbrev.type, allocator));
-
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" tag="), allocator));
-  PgString tag_str = pg_dwarf_tag_str[abbrev.tag];
-  PG_ERR_RETURN(pg_writer_write_full(w, tag_str, allocator));
-
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" forms_len="), allocator));
-  PG_ERR_RETURN(
-      pg_writer_write_u64_as_string(w, abbrev.attribute_forms.len, allocator));
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
+pg_dns_resolver_on_readable(PgDnsResolver *r, u64 now_ns,
+                            PgAllocator *allocator) {
+  for (;;) {
+    u8 msg_data[PG_DNS_UDP_MAX_LEN] = {0};
+    PgString msg = {.data = msg_data, .len = sizeof(msg_data)};
+    PG_RESULT(u64, PgError)
+    res_read = pg_net_socket_read_non_blocking(r->socket, msg);
+    if (PG_IS_ERR(res_read)) {
+      PgError err = PG_UNWRAP_ERR(res_read);
+      if (EAGAIN == err || EWOULDBLOCK == err) {
+        return 0;
+      }
+      // E.g. no server listening: it is the same for all the queries.
+      while (r->pending.len > 0) {
+        pg_dns_resolver_fail(r, PG_SLICE_AT(r->pending, 0), err,
+                             r->options.negative_ttl_ms, now_ns);
+      }
+      return err;
+    }
+    msg.len = PG_UNWRAP(res_read);
 
-  PG_EACH_PTR(attr_form, &abbrev.attribute_forms) {
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("  attribute="), allocator));
-    PgString attr_str = pg_dwarf_attribute_str[attr_form->attribute];
-    PG_ERR_RETURN(pg_writer_write_full(w, attr_str, allocator));
+    if (msg.len < PG_DNS_HEADER_LEN) {
+      continue;
+    }
+    u16 id = pg_dns_read_u16(msg, 0);
 
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S(" form="), allocator));
-    PgString form_str = pg_dwarf_form_str[attr_form->form];
-    PG_ERR_RETURN(pg_writer_write_full(w, form_str, allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
-  }
+    PG_EACH_PTR(it, &r->pending) {
+      PgDnsEntry *entry = *it;
+      if (id != entry->query_id) {
+        continue;
+      }
 
-  if (abbrev.parent.has_value) {
-    PgDwarfAbbreviationEntry parent =
-        PG_SLICE_AT(cu.abbrevs, abbrev.parent.value.value);
-    PG_ERR_RETURN(
-        pg_dwarf_compilation_unit_print_abbreviation(w, cu, parent, allocator));
+      PG_RESULT(PgDnsAnswer, PgError)
+      res_answer = pg_dns_response_parse(msg, id, entry->name, allocator);
+      if (PG_IS_OK(res_answer)) {
+        pg_dns_resolver_apply(r, entry, PG_UNWRAP(res_answer), now_ns);
+      }
+      break;
+    }
   }
+}
 
-  PG_ERR_RETURN(pg_writer_flush(w, allocator));
+// Resend the queries that timed out, or fail them after the last attempt.
+[[maybe_unused]] static void pg_dns_resolver_on_timer(PgDnsResolver *r,
+                                                      u64 now_ns) {
+  for (u64 i = 0; i < r->pending.len;) {
+    PgDnsEntry *entry = PG_SLICE_AT(r->pending, i);
+    if (now_ns - entry->sent_at_ns <
+        r->options.timeout_ms * PG_Milliseconds) {
+      i++;
+      continue;
+    }
 
-  return 0;
+    if (entry->attempts < r->options.attempts) {
+      pg_dns_resolver_send(r, entry, now_ns);
+      // Unless the send failed and removed it.
+      i += PG_DNS_ENTRY_STATE_PENDING == entry->state;
+    } else {
+      // Removed from `pending` at `i`.
+      pg_dns_resolver_fail(r, entry, (PgError)ETIMEDOUT,
+                           r->options.negative_ttl_ms, now_ns);
+    }
+  }
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_dwarf_compilation_unit_print_abbreviations(
-    PgWriter *w, PgDwarfDebugInfoCompilationUnit cu, PgAllocator *allocator) {
-  PgString kind_str = pg_dwarf_compilation_unit_kind_to_str[cu.kind];
-  PG_ERR_RETURN(pg_writer_write_full(w, kind_str, allocator));
-  PG_ERR_RETURN(
-      pg_writer_write_full(w, PG_S(" abbrev_entries_len="), allocator));
-  PG_ERR_RETURN(pg_writer_write_u64_as_string(w, cu.abbrevs.len, allocator));
-  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\n"), allocator));
+// Until the next query times out, for `pg_aio_wait`.
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(u32)
+    pg_dns_resolver_timeout_ms(PgDnsResolver *r, u64 now_ns) {
+  if (0 == r->pending.len) {
+    return PG_NONE(u32);
+  }
+
+  u64 deadline_ns = UINT64_MAX;
+  PG_EACH_PTR(it, &r->pending) {
+    deadline_ns = PG_MIN(deadline_ns, (*it)->sent_at_ns +
+                                          r->options.timeout_ms *
+                                              PG_Milliseconds);
+  }
+  u64 remaining_ms =
+      deadline_ns > now_ns ? (deadline_ns - now_ns + PG_Milliseconds - 1) /
+                                 PG_Milliseconds
+                           : 0;
+  return PG_SOME((u32)PG_MIN(remaining_ms, UINT32_MAX), u32);
+}
+
+// Look `name` up and wait for the answer, for callers without an event loop.
+// The addresses live in the resolver and may be replaced by a later lookup
+// once they expire.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PG_SLICE(u32), PgError)
+    pg_dns_resolver_resolve(PgDnsResolver *r, PgString name,
+                            PgAllocator *allocator) {
+  for (;;) {
+    u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    PgDnsLookup lookup = pg_dns_resolver_lookup(r, name, now_ns);
+    if (lookup.err) {
+      return PG_ERR(lookup.err, PG_SLICE(u32), PgError);
+    }
+    if (!lookup.pending) {
+      return PG_OK(lookup.addresses, PG_SLICE(u32), PgError);
+    }
 
-  PG_EACH_PTR(abbrev, &cu.abbrevs) {
-    PG_ERR_RETURN(pg_dwarf_compilation_unit_print_abbreviation(w, cu, *abbrev,
-                                                               allocator));
+    PgAioEvent events_data[1] = {0};
+    PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+    PG_RESULT(u64, PgError)
+    res_wait =
+        pg_aio_wait(r->aio, events, pg_dns_resolver_timeout_ms(r, now_ns));
+    PG_IF_LET_ERR(err, res_wait) {
+      return PG_ERR(err, PG_SLICE(u32), PgError);
+    }
+
+    now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    if (PG_UNWRAP(res_wait) > 0) {
+      (void)pg_dns_resolver_on_readable(r, now_ns, allocator);
+    }
+    pg_dns_resolver_on_timer(r, now_ns);
   }
-  return 0;
 }
 
-[[maybe_unused]] static void
-pg_self_debug_info_iterator_release(PgDebugInfoIterator dbg) {
-  if (dbg.file.data.data) {
-    munmap(dbg.file.data.data, dbg.file.data.len);
+// `allocator` holds the hosts and the pooled connections, and thus must live
+// as long as the client, unlike the one passed for each request.
+[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgHttpClient, PgError)
+    pg_http_client_make(PgHttpClientOptions options, PgAllocator *allocator) {
+  // A header line must fit in the read buffer.
+  options.buffer_size = PG_MAX(options.buffer_size, PG_HTTP_LINE_MAX_LEN);
+  if (0 == options.max_body_len) {
+    options.max_body_len = 16 * PG_MiB;
+  }
+  if (0 == options.idle_timeout_ms) {
+    options.idle_timeout_ms = 4000;
   }
-}
 
-#endif
+  PG_RESULT(PgAio, PgError) res_aio = pg_aio_init();
+  PG_IF_LET_ERR(err, res_aio) { return PG_ERR(err, PgHttpClient, PgError); }
+  PgAio aio = PG_UNWRAP(res_aio);
 
-#ifdef PG_OS_LINUX
+  PG_RESULT(PgAio, PgError) res_connect_aio = pg_aio_init();
+  PG_IF_LET_ERR(err, res_connect_aio) {
+    (void)pg_file_close(aio.aio);
+    return PG_ERR(err, PgHttpClient, PgError);
+  }
 
-[[maybe_unused]] static void pg_thread_yield() { sched_yield(); }
+  PgHttpClient client = {
+      .options = options,
+      .aio = aio,
+      .connect_aio = PG_UNWRAP(res_connect_aio),
+      .allocator = allocator,
+  };
+  return PG_OK(client, PgHttpClient, PgError);
+}
 
-[[maybe_unused]] [[nodiscard]] static PgString pg_self_exe_get_path() {
-  static _Atomic PgOnce once = PG_ONCE_UNINITIALIZED;
-  static char path_c[PG_PATH_MAX] = {0};
-  static PgString res = {0};
+[[nodiscard]] static PgHttpClientHost *
+pg_http_client_host_upsert(PgHttpClient *client, PgString host, u16 port,
+                           PgAllocator *allocator) {
+  PgWriter w = pg_writer_make_string_builder(host.len + 6, allocator);
+  PG_ASSERT(0 == pg_writer_write_full(&w, host, allocator));
+  PG_ASSERT(0 == pg_writer_write_u8(&w, ':', allocator));
+  PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, port, allocator));
+  PgString key = PG_DYN_TO_SLICE(PgString, w.u.bytes);
 
-  if (pg_once_do(&once)) {
-    i32 ret = 0;
-    do {
-      ret = readlink("/proc/self/exe", path_c, PG_STATIC_ARRAY_LEN(path_c));
-    } while (-1 == ret && EINTR == errno);
-    if (-1 == errno) {
-      return res;
+  PgHttpClientHost **htrie = &client->hosts_htrie;
+  for (u64 h = pg_hash_fnv(key); *htrie; h <<= 2) {
+    if (pg_string_eq(key, (*htrie)->key)) {
+      return *htrie;
     }
+    htrie = &(*htrie)->child[h >> 62];
+  }
 
-    res = pg_cstr_to_string(path_c);
+  *htrie = PG_NEW(PgHttpClientHost, client->allocator);
+  (*htrie)->key = pg_string_clone(key, client->allocator);
+  return *htrie;
+}
 
-    pg_once_mark_as_done(&once);
+// The buffers are kept for the next connection.
+static void pg_http_client_conn_close(PgHttpClient *client,
+                                      PgHttpClientConn conn) {
+  (void)pg_net_socket_close(conn.socket);
+  PG_DYN_PUSH(&client->spare, conn, client->allocator);
+}
+
+// Close the connections of `host` idle for longer than `idle_timeout_ms`,
+// which are the oldest ones.
+static void pg_http_client_host_evict_idle(PgHttpClient *client,
+                                           PgHttpClientHost *host,
+                                           u64 now_ns) {
+  u64 evicted = 0;
+  for (; evicted < host->idle.len; evicted++) {
+    PgHttpClientConn conn = PG_SLICE_AT(host->idle, evicted);
+    if (now_ns - conn.idle_since_ns <
+        client->options.idle_timeout_ms * PG_Milliseconds) {
+      break;
+    }
+    pg_http_client_conn_close(client, conn);
   }
 
-  PG_ASSERT(!pg_string_is_empty(res));
-  return res;
+  if (evicted > 0) {
+    pg_memmove(host->idle.data, host->idle.data + evicted,
+               (host->idle.len - evicted) * sizeof(PgHttpClientConn));
+    host->idle.len -= evicted;
+  }
 }
 
-[[nodiscard]] static u64 pg_self_pie_get_offset() {
-  static _Atomic PgOnce once = PG_ONCE_UNINITIALIZED;
-  static u64 res = 0;
-
-  if (pg_once_do(&once)) {
-    u8 mem[4096] = {0};
-    PgArena arena = pg_arena_make_from_mem(mem, PG_STATIC_ARRAY_LEN(mem));
-    PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
-    PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+static void pg_http_client_htrie_evict_idle(PgHttpClient *client,
+                                            PgHttpClientHost *host,
+                                            u64 now_ns) {
+  if (!host) {
+    return;
+  }
 
-    PG_RESULT(PgFileDescriptor, PgError)
-    res_fd = pg_file_open(PG_S("/proc/self/maps"), PG_FILE_ACCESS_READ, 0600,
-                          false, allocator);
-    PG_IF_LET_ERR(err, res_fd) {
-      PG_UNUSED(err);
-      goto end_once;
-    }
-    PgFileDescriptor fd = PG_UNWRAP(res_fd);
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(host->child); i++) {
+    pg_http_client_htrie_evict_idle(client, host->child[i], now_ns);
+  }
+  pg_http_client_host_evict_idle(client, host, now_ns);
+}
 
-    PgReader r = pg_reader_make_from_file(fd, 512, allocator);
+// Idle connections of a host are also evicted when a request is made to this
+// host. This is for the hosts that are not used anymore.
+[[maybe_unused]] static void pg_http_client_evict_idle(PgHttpClient *client) {
+  u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  pg_http_client_htrie_evict_idle(client, client->hosts_htrie, now_ns);
+}
 
-    u64 max_lines = 512;
+[[maybe_unused]] static void pg_http_client_close(PgHttpClient *client) {
+  client->options.idle_timeout_ms = 0;
+  pg_http_client_evict_idle(client);
+  (void)pg_file_close(client->aio.aio);
+  (void)pg_file_close(client->connect_aio.aio);
+}
 
-    for (u64 _i = 0; _i < max_lines; _i++) {
-      u8 line[512] = {0};
-      PgString line_slice = PG_SLICE_FROM_C(line);
-      PG_RESULT(PG_OPTION(u64), PgError)
-      res_line = pg_reader_read_line(&r, PG_NEWLINE_KIND_LF, line_slice);
-      PG_IF_LET_ERR(err, res_line) {
-        PG_UNUSED(err);
-        goto end_file;
-      }
-      PG_OPTION(u64) line_opt = PG_UNWRAP(res_line);
-      if (!line_opt.has_value) {
-        goto end_file;
-      }
-      line_slice.len = line_opt.value;
+// Race the addresses of the host with the event loop to honor
+// `connect_timeout_ms`. The socket is then switched back to blocking reads
+// bounded by `read_timeout_ms`.
+[[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
+    pg_http_client_connect(PgHttpClient *client, PgHttpClientHost *host,
+                           PgHttpClientRequest req, PgAllocator *allocator) {
+  if (client->options.resolver) {
+    // Cheap when cached, and honors the TTL of the records.
+    PG_RESULT(PG_SLICE(u32), PgError)
+    res_resolve =
+        pg_dns_resolver_resolve(client->options.resolver, req.host, allocator);
+    PG_IF_LET_ERR(err, res_resolve) {
+      return PG_ERR(err, PgFileDescriptor, PgError);
+    }
+    PG_SLICE(u32) ips = PG_UNWRAP(res_resolve);
+    host->addresses.len = 0;
+    for (u64 i = 0; i < ips.len; i++) {
+      PgIpAddress address = {
+          .ipv4 = PG_SLICE_AT(ips, i),
+          .port = req.port,
+          .family = PG_IP_FAMILY_V4,
+      };
+      PG_DYN_PUSH(&host->addresses, address, client->allocator);
+    }
+  } else if (0 == host->addresses.len) {
+    PG_RESULT(PG_SLICE(PgIpAddress), PgError)
+    res_resolve = pg_net_dns_resolve_ip(req.host, req.port, allocator);
+    PG_IF_LET_ERR(err, res_resolve) {
+      return PG_ERR(err, PgFileDescriptor, PgError);
+    }
+    PG_DYN_APPEND_SLICE(&host->addresses, PG_UNWRAP(res_resolve),
+                        client->allocator);
+  }
+
+  PG_RESULT(PgIpAddressSocket, PgError)
+  res_connect = pg_net_connect_happy_eyeballs(
+      client->connect_aio,
+      PG_DYN_TO_SLICE(PG_SLICE(PgIpAddress), host->addresses),
+      (PgNetConnectOptions){.timeout_ms = client->options.connect_timeout_ms},
+      allocator);
+  PG_IF_LET_ERR(err, res_connect) {
+    // The addresses may have changed.
+    host->addresses.len = 0;
+    return PG_ERR(err, PgFileDescriptor, PgError);
+  }
+  PgFileDescriptor socket = PG_UNWRAP(res_connect).socket;
 
-      PgStringCut cut_space = pg_string_cut_rune(line_slice, ' ');
-      if (!cut_space.has_value) {
-        continue;
-      }
+  PgError err = pg_fd_set_blocking(socket, true);
+  if (err) {
+    goto end;
+  }
 
-      PgString mem_range = cut_space.left;
-      PgString perms = cut_space.right;
+  (void)pg_net_set_nodelay(socket, true);
 
-      if (!pg_string_contains_rune(perms, 'x')) {
-        continue;
-      }
+  if (client->options.read_timeout_ms) {
+    err = pg_net_socket_set_timeout(
+        socket, client->options.read_timeout_ms / 1000,
+        (client->options.read_timeout_ms % 1000) * 1000);
+  }
 
-      PgStringCut cut_dash = pg_string_cut_rune(mem_range, '-');
-      if (!cut_dash.has_value) {
-        continue;
-      }
+end:
+  if (err) {
+    (void)pg_net_socket_close(socket);
+    return PG_ERR(err, PgFileDescriptor, PgError);
+  }
+  client->connections_opened += 1;
+  return PG_OK(socket, PgFileDescriptor, PgError);
+}
 
-      PgParseNumberResult res_mem_start =
-          pg_string_parse_u64(cut_dash.left, 16, false);
-      if (!res_mem_start.present) {
-        continue;
-      }
+PG_RESULT_DECL(PgHttpClientConn, PgError);
 
-      PgParseNumberResult res_mem_end =
-          pg_string_parse_u64(cut_dash.right, 16, false);
-      if (!res_mem_end.present) {
-        continue;
-      }
+// Reuse the most recent idle connection still open, or open a new one.
+[[nodiscard]] static PG_RESULT(PgHttpClientConn, PgError)
+    pg_http_client_acquire(PgHttpClient *client, PgHttpClientHost *host,
+                           PgHttpClientRequest req, bool allow_reuse,
+                           bool *reused, PgAllocator *allocator) {
+  *reused = false;
 
-      u64 start = res_mem_start.n;
-      u64 end = res_mem_end.n;
-      PG_ASSERT(0 == (start % pg_os_get_page_size()));
-      PG_ASSERT(0 == (end % pg_os_get_page_size()));
+  u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  pg_http_client_host_evict_idle(client, host, now_ns);
 
-      if (start <= (u64)&pg_self_pie_get_offset &&
-          (u64)&pg_self_pie_get_offset < end) {
-        res = start;
-        goto end_file;
-      }
+  while (allow_reuse && host->idle.len > 0) {
+    PgHttpClientConn conn = PG_DYN_POP(&host->idle);
+    if (pg_net_socket_is_idle(conn.socket)) {
+      PG_ASSERT(pg_ring_is_empty(conn.reader.ring));
+      *reused = true;
+      return PG_OK(conn, PgHttpClientConn, PgError);
     }
-  end_file:
-    (void)pg_file_close(fd);
+    // Closed by the server.
+    pg_http_client_conn_close(client, conn);
+  }
 
-  end_once:
-    pg_once_mark_as_done(&once);
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_connect = pg_http_client_connect(client, host, req, allocator);
+  PG_IF_LET_ERR(err, res_connect) {
+    return PG_ERR(err, PgHttpClientConn, PgError);
+  }
+  PgFileDescriptor socket = PG_UNWRAP(res_connect);
+
+  PgHttpClientConn conn = {0};
+  if (client->spare.len > 0) {
+    conn = PG_DYN_POP(&client->spare);
+    conn.reader.ring.idx_read = conn.reader.ring.idx_write = 0;
+    conn.reader.ring.count = 0;
+    conn.writer.ring.idx_read = conn.writer.ring.idx_write = 0;
+    conn.writer.ring.count = 0;
+  } else {
+    conn.reader = pg_reader_make_from_socket(
+        socket, client->options.buffer_size, client->allocator);
+    conn.writer = pg_writer_make_from_socket(
+        socket, client->options.buffer_size, client->allocator);
   }
+  conn.socket = socket;
+  conn.reader.u.file = socket;
+  conn.writer.u.file = socket;
 
-  return res;
+  return PG_OK(conn, PgHttpClientConn, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgDebugInfoIterator, PgError)
-    pg_self_debug_info_iterator_make(PgAllocator *allocator) {
-  PgDebugInfoIterator res = {0};
-  PgError err = 0;
-
-  PgString exe_path = pg_self_exe_get_path();
-  if (pg_string_is_empty(exe_path)) {
-    return PG_OK(res, PgDebugInfoIterator, PgError);
+// Bytes received after the response are unexpected, and would be taken for
+// the start of the next response: the connection is then closed.
+static void pg_http_client_release(PgHttpClient *client, PgHttpClientHost *host,
+                                   PgHttpClientConn conn, bool keep_alive) {
+  if (!keep_alive || !pg_ring_is_empty(conn.reader.ring) ||
+      host->idle.len >= client->options.max_idle_per_host) {
+    pg_http_client_conn_close(client, conn);
+    return;
   }
 
-  // TODO: Only read the relevant parts.
-  // Depending on the size of the executable.
-  PG_RESULT(PgVirtualMemFile, PgError)
-  res_file = pg_virtual_mem_map_file(exe_path, PG_FILE_ACCESS_READ, false);
-  PG_IF_LET_ERR(err, res_file) {
-    return PG_ERR(err, PgDebugInfoIterator, PgError);
+  conn.idle_since_ns =
+      PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  PG_DYN_PUSH(&host->idle, conn, client->allocator);
+}
+
+// `Host` and `Content-Length` are added unless present.
+[[nodiscard]] static PgError pg_http_client_send(PgHttpClientConn *conn,
+                                                 PgHttpClientRequest req,
+                                                 PgAllocator *allocator) {
+  PgWriter *w = &conn->writer;
+  PgHttpHeaders *headers = &req.req.headers;
+
+  PG_ERR_RETURN(pg_http_request_write_status_line(w, req.req, allocator));
+  PG_EACH_PTR(header, &headers->entries) {
+    PG_ERR_RETURN(pg_http_write_header(w, *header, allocator));
   }
-  res.file = PG_UNWRAP(res_file);
 
-  // TODO: Other formats.
-  // Parse ELF.
-  {
-    PG_RESULT(PgElf, PgError) res_elf = pg_elf_parse(res.file.data);
-    PG_IF_LET_ERR(_err, res_elf) {
-      err = _err;
-      goto end;
+  if (!headers->known[PG_HTTP_HEADER_ID_HOST]) {
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("Host: "), allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, req.host, allocator));
+    if (80 != req.port) {
+      PG_ERR_RETURN(pg_writer_write_u8(w, ':', allocator));
+      PG_ERR_RETURN(pg_writer_write_u64_as_string(w, req.port, allocator));
     }
-    res.elf = PG_UNWRAP(res_elf);
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\r\n"), allocator));
   }
 
-  // Parse compilation unit.
-  {
-    PG_RESULT(PgDwarfDebugInfoCompilationUnit, PgError)
-    res_unit = pg_dwarf_parse_debug_info(res.elf, allocator);
-    PG_IF_LET_ERR(_err, res_unit) {
-      err = _err;
-      goto end;
-    }
-    res.unit = PG_UNWRAP(res_unit);
+  bool has_body = req.body.len > 0 || PG_HTTP_METHOD_POST == req.req.method ||
+                  PG_HTTP_METHOD_PUT == req.req.method;
+  if (has_body && !headers->known[PG_HTTP_HEADER_ID_CONTENT_LENGTH] &&
+      !headers->known[PG_HTTP_HEADER_ID_TRANSFER_ENCODING]) {
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("Content-Length: "), allocator));
+    PG_ERR_RETURN(pg_writer_write_u64_as_string(w, req.body.len, allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\r\n"), allocator));
   }
 
-  // Setup reader on `.debug_info`.
-  {
-    PG_RESULT(PG_SLICE(u8), PgError)
-    res_info_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
-        res.elf, PG_S(".debug_info"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
-    PG_IF_LET_ERR(_err, res_info_bytes) {
-      err = _err;
-      goto end;
-    }
-    PgString info_bytes = PG_UNWRAP(res_info_bytes);
-    res.debug_info_full = info_bytes;
+  PG_ERR_RETURN(pg_writer_write_full(w, PG_S("\r\n"), allocator));
+  PG_ERR_RETURN(pg_writer_write_full(w, req.body, allocator));
+
+  return pg_writer_flush(w, allocator);
+}
+
+// Read the response and its body from `reader`, the connection or what was
+// received from it. `keep_alive` is set when the connection can be reused
+// i.e. the body is delimited and neither side asked to close.
+[[nodiscard]] static PgHttpClientResponse
+pg_http_client_receive(PgHttpClient *client, PgReader *reader,
+                       PgHttpRequest req, bool *keep_alive,
+                       PgAllocator *allocator) {
+  PgHttpClientResponse res = {0};
+  *keep_alive = false;
 
-    u64 offset = pg_dwarf_compilation_unit_get_data_offset(res.unit);
-    info_bytes = PG_SLICE_RANGE_START(info_bytes, offset);
+  PgHttpResponseReadResult res_read = pg_http_read_response(reader, allocator);
+  if (res_read.err || !res_read.done) {
+    res.err = res_read.err ? res_read.err : PG_ERR_EOF;
+    return res;
+  }
+  res.res = res_read.resp;
+  PgHttpHeaders const *headers = &res.res.headers;
+
+  bool no_body = PG_HTTP_METHOD_HEAD == req.method || res.res.status < 200 ||
+                 204 == res.res.status || 304 == res.res.status;
+  bool delimited = no_body ||
+                   headers->known[PG_HTTP_HEADER_ID_CONTENT_LENGTH] ||
+                   headers->known[PG_HTTP_HEADER_ID_TRANSFER_ENCODING];
+  if (no_body) {
+    *keep_alive =
+        pg_http_keep_alive(&req.headers, req.version_major,
+                           req.version_minor) &&
+        pg_http_keep_alive(headers, res.res.version_major,
+                           res.res.version_minor);
+    return res;
+  }
 
-    res.r = pg_reader_make_from_bytes(info_bytes);
+  // Without a length, the body goes on until the server closes the
+  // connection.
+  PgReader body_reader = {0};
+  PgReader *src = reader;
+  if (delimited) {
+    PG_RESULT(PgReader, PgError)
+    res_body = pg_http_request_body_reader(headers, reader, nullptr, allocator);
+    PG_IF_LET_ERR(err, res_body) {
+      res.err = err;
+      return res;
+    }
+    body_reader = PG_UNWRAP(res_body);
+    src = &body_reader;
   }
 
-  // Set string section.
-  {
-    PG_RESULT(PG_SLICE(u8), PgError)
-    res_str_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
-        res.elf, PG_S(".debug_str"), PG_ELF_SECTION_HEADER_KIND_PROGBITS);
-    PG_IF_LET_ERR(_err, res_str_bytes) {
-      err = _err;
-      goto end;
+  PG_DYN(u8) body = {0};
+  PG_RESULT(u64, PgError)
+  res_content_length = pg_http_content_length(headers);
+  if (PG_IS_OK(res_content_length)) {
+    u64 content_length = PG_UNWRAP(res_content_length);
+    if (content_length > client->options.max_body_len) {
+      res.err = PG_ERR_TOO_BIG;
+      return res;
     }
-    res.str_bytes = PG_UNWRAP(res_str_bytes);
+    PG_DYN_ENSURE_CAP(&body, content_length, allocator);
   }
 
-  // Set string offsets section.
-  {
-    PG_RESULT(PG_SLICE(u8), PgError)
-    res_str_offsets_bytes = pg_elf_section_header_find_bytes_by_name_and_kind(
-        res.elf, PG_S(".debug_str_offsets"),
-        PG_ELF_SECTION_HEADER_KIND_PROGBITS);
-    PG_IF_LET_ERR(_err, res_str_offsets_bytes) {
-      err = _err;
-      goto end;
+  for (;;) {
+    PG_DYN_ENSURE_CAP(&body, body.len + 4096, allocator);
+    PgString space = PG_DYN_SPACE(PgString, &body);
+    PG_RESULT(u64, PgError) res_body_read = pg_reader_read_slice(src, space);
+    if (PG_IS_ERR(res_body_read)) {
+      if (PG_ERR_EOF == PG_UNWRAP_ERR(res_body_read)) {
+        break;
+      }
+      res.err = PG_UNWRAP_ERR(res_body_read);
+      return res;
     }
-    PG_SLICE(u8) str_offsets_bytes = PG_UNWRAP(res_str_offsets_bytes);
-    // Check that the header is present.
-    if (str_offsets_bytes.len < 8) {
-      err = PG_ERR_INVALID_VALUE;
-      goto end;
+
+    u64 read_count = PG_UNWRAP(res_body_read);
+    if (0 == read_count) {
+      break;
     }
-    str_offsets_bytes = PG_SLICE_RANGE_START(str_offsets_bytes, 8);
-    if (0 != (str_offsets_bytes.len % 4)) {
-      err = PG_ERR_INVALID_VALUE;
-      goto end;
+    body.len += read_count;
+    if (body.len > client->options.max_body_len) {
+      res.err = PG_ERR_TOO_BIG;
+      return res;
     }
-    // TODO: Should we check alignment (`0 != ((u64)str_offsets_bytes.data %
-    // 4`)?
-    PG_SLICE(u32)
-    str_offsets = {
-        .data = (u32 *)str_offsets_bytes.data,
-        .len = str_offsets_bytes.len / 4,
-    };
-    res.str_offsets = str_offsets;
   }
+  res.body = PG_DYN_TO_SLICE(PgString, body);
 
-end:
-  if (err) {
-    pg_self_debug_info_iterator_release(res);
+  *keep_alive =
+      delimited &&
+      pg_http_keep_alive(&req.headers, req.version_major, req.version_minor) &&
+      pg_http_keep_alive(headers, res.res.version_major,
+                         res.res.version_minor);
+  return res;
+}
+
+[[nodiscard]] static bool pg_http_method_is_idempotent(PgHttpMethod method) {
+  switch (method) {
+  case PG_HTTP_METHOD_OPTIONS:
+  case PG_HTTP_METHOD_GET:
+  case PG_HTTP_METHOD_HEAD:
+  case PG_HTTP_METHOD_PUT:
+  case PG_HTTP_METHOD_DELETE:
+  case PG_HTTP_METHOD_TRACE:
+    return true;
+  default:
+    return false;
   }
-  return PG_OK(res, PgDebugInfoIterator, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
-    pg_aio_inotify_init() {
-  PgFileDescriptor res = {0};
+// HTTP/1.1 unless specified.
+[[nodiscard]] static PgHttpClientRequest
+pg_http_client_request_defaults(PgHttpClientRequest req) {
+  if (0 == req.req.version_major) {
+    req.req.version_major = 1;
+    req.req.version_minor = 1;
+  }
+  return req;
+}
 
-  i32 ret = 0;
-  do {
-    ret = inotify_init();
-  } while (-1 == ret && EINTR == errno);
+// Make a request on a pooled connection to `req.host`, or a new one.
+// The server may close an idle connection at any time: an idempotent request
+// that gets no response on a reused connection is retried once on a new one.
+[[maybe_unused]] [[nodiscard]] static PgHttpClientResponse
+pg_http_client_do(PgHttpClient *client, PgHttpClientRequest req,
+                  PgAllocator *allocator) {
+  req = pg_http_client_request_defaults(req);
+  PgHttpClientHost *host =
+      pg_http_client_host_upsert(client, req.host, req.port, allocator);
 
-  if (-1 == ret) {
-    return PG_ERR(errno, PgFileDescriptor, PgError);
+  PgHttpClientResponse res = {0};
+  for (u64 attempt = 0; attempt < 2; attempt++) {
+    bool reused = false;
+    PG_RESULT(PgHttpClientConn, PgError)
+    res_conn = pg_http_client_acquire(client, host, req, 0 == attempt, &reused,
+                                      allocator);
+    PG_IF_LET_ERR(err, res_conn) {
+      res.err = err;
+      return res;
+    }
+    PgHttpClientConn conn = PG_UNWRAP(res_conn);
+
+    bool keep_alive = false;
+    PgError err = pg_http_client_send(&conn, req, allocator);
+    if (err) {
+      res = (PgHttpClientResponse){.err = err};
+    } else {
+      res = pg_http_client_receive(client, &conn.reader, req.req, &keep_alive,
+                                   allocator);
+    }
+
+    if (res.err) {
+      pg_http_client_conn_close(client, conn);
+      if (reused && 0 == res.res.status &&
+          pg_http_method_is_idempotent(req.req.method)) {
+        continue;
+      }
+      return res;
+    }
+
+    pg_http_client_release(client, host, conn, keep_alive);
+    return res;
   }
 
-  res.fd = ret;
-  return PG_OK(res, PgFileDescriptor, PgError);
+  return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
-    pg_aio_inotify_register_interest(PgAio aio, PgString name,
-                                     PgAioEventKind interest) {
-  PgFileDescriptor res = {0};
+// Reader of what was received on a connection, buffered like the connection
+// so that lines can be read from it.
+[[nodiscard]] static PgReader
+pg_http_client_raw_reader(PgString raw, PgAllocator *allocator) {
+  PgReader reader = pg_reader_make_from_bytes(raw);
+  reader.ring = pg_ring_make(PG_HTTP_LINE_MAX_LEN, allocator);
+  return reader;
+}
 
-  if (0 == name.len) {
-    return PG_ERR(PG_ERR_INVALID_VALUE, PgFileDescriptor, PgError);
+[[nodiscard]] static u64 pg_http_client_raw_reader_unread(PgReader reader) {
+  return reader.u.bytes.len + pg_ring_can_read_count(reader.ring);
+}
+
+// Where the scan of a response received piece by piece is at.
+typedef enum : u8 {
+  PG_HTTP_CLIENT_SCAN_HEADERS,
+  PG_HTTP_CLIENT_SCAN_UNTIL_CLOSE, // No length: the body ends with the
+                                   // connection.
+  PG_HTTP_CLIENT_SCAN_LENGTH,
+  PG_HTTP_CLIENT_SCAN_CHUNK_SIZE,
+  PG_HTTP_CLIENT_SCAN_CHUNK_DATA,
+  PG_HTTP_CLIENT_SCAN_TRAILERS,
+  PG_HTTP_CLIENT_SCAN_WHOLE,
+} PgHttpClientScan;
+
+// Response of `pg_http_client_do_many` being received.
+typedef struct {
+  PgHttpClientHost *host;
+  PgHttpClientConn conn;
+  PG_DYN(u8) raw;  // Received so far.
+  u64 deadline_ns; // Monotonic clock, pushed back by each read.
+  // Only framing is scanned, each byte once: the response is parsed by
+  // `pg_http_client_receive` once whole.
+  u64 scanned;  // Start of the next element in `raw` e.g. a chunk size line.
+  u64 searched; // How far a line end was looked for.
+  u64 end;      // Of the body or of the current chunk data, in `raw`.
+  PgHttpClientScan scan;
+  bool reused;
+  bool pending;
+  PG_PAD(5);
+} PgHttpClientPending;
+
+// Once the headers are received: how the body is delimited. A malformed
+// response is whole, for `pg_http_client_receive` to report it. The headers
+// are parsed in a scratch arena not conflicting with `conflict`.
+[[nodiscard]] static PgHttpClientScan
+pg_http_client_scan_headers(PgHttpClientPending *pending, PgHttpRequest req,
+                            PgAllocator *conflict) {
+  PgArenaTemp scratch = pg_scratch_begin(conflict);
+  PgAllocator *allocator = pg_arena_temp_allocator(&scratch);
+  PgHttpClientScan scan = PG_HTTP_CLIENT_SCAN_WHOLE;
+
+  PgString headers_raw =
+      PG_SLICE_RANGE(PG_DYN_TO_SLICE(PgString, pending->raw), 0,
+                     pending->scanned);
+  PgReader reader = pg_http_client_raw_reader(headers_raw, allocator);
+  PgHttpResponseReadResult res_read = pg_http_read_response(&reader, allocator);
+  if (res_read.err || !res_read.done) {
+    goto end;
   }
+  PgHttpResponse res = res_read.resp;
+  PgHttpHeaders const *headers = &res.headers;
 
-  u32 interest_linux = 0;
-  if (interest & PG_AIO_EVENT_KIND_FILE_CREATED) {
-    interest_linux |= IN_CREATE;
+  if (PG_HTTP_METHOD_HEAD == req.method || res.status < 200 ||
+      204 == res.status || 304 == res.status) {
+    goto end;
   }
-  if (interest & PG_AIO_EVENT_KIND_FILE_MODIFIED) {
-    interest_linux |= IN_MODIFY;
+  if (!headers->known[PG_HTTP_HEADER_ID_CONTENT_LENGTH] &&
+      !headers->known[PG_HTTP_HEADER_ID_TRANSFER_ENCODING]) {
+    scan = PG_HTTP_CLIENT_SCAN_UNTIL_CLOSE;
+    goto end;
   }
-  if (interest & PG_AIO_EVENT_KIND_FILE_DELETED) {
-    interest_linux |= IN_DELETE;
+
+  PG_RESULT(PgReader, PgError)
+  res_body = pg_http_request_body_reader(headers, &reader, nullptr, allocator);
+  if (PG_IS_ERR(res_body)) {
+    goto end;
+  }
+  PgReader body = PG_UNWRAP(res_body);
+  if (PG_READER_KIND_HTTP_BODY == body.kind) {
+    pending->end = pending->scanned + body.u.http_body.remaining;
+    scan = PG_HTTP_CLIENT_SCAN_LENGTH;
+  } else {
+    PG_ASSERT(PG_READER_KIND_HTTP_CHUNKED == body.kind);
+    scan = PG_HTTP_CLIENT_SCAN_CHUNK_SIZE;
   }
 
-  u8 name_c[4096] = {0};
-  PG_ASSERT(name.data);
-  PG_ASSERT(name.len < PG_STATIC_ARRAY_LEN(name_c));
-  pg_memcpy(name_c, name.data, name.len);
+end:
+  pg_scratch_end(scratch);
+  return scan;
+}
+
+// Look for `terminator` after `pending->scanned` in what was not searched
+// yet, the previous bytes included in case it straddles two reads.
+[[nodiscard]] static i64
+pg_http_client_scan_find(PgHttpClientPending *pending, PgString terminator) {
+  PgString raw = PG_DYN_TO_SLICE(PgString, pending->raw);
+  u64 from = pending->searched >= terminator.len - 1
+                 ? pending->searched - (terminator.len - 1)
+                 : 0;
+  from = PG_MAX(from, pending->scanned);
+
+  i64 idx = pg_string_index_of_string(PG_SLICE_RANGE_START(raw, from),
+                                      terminator);
+  if (-1 == idx) {
+    pending->searched = raw.len;
+    return -1;
+  }
+  pending->searched = from + (u64)idx + terminator.len;
+  return (i64)from + idx;
+}
 
-  i32 ret = 0;
-  do {
-    ret = inotify_add_watch(aio.inotify.value.fd, (const char *)name_c,
-                            interest_linux);
-  } while (-1 == ret && EINTR == errno);
+// Scan what was received since the last call. Returns whether the response
+// is whole, before the server closes the connection.
+[[nodiscard]] static bool pg_http_client_scan(PgHttpClientPending *pending,
+                                              PgHttpRequest req,
+                                              PgAllocator *conflict) {
+  PgString raw = PG_DYN_TO_SLICE(PgString, pending->raw);
 
-  if (-1 == ret) {
-    return PG_ERR(errno, PgFileDescriptor, PgError);
-  }
+  for (;;) {
+    switch (pending->scan) {
+    case PG_HTTP_CLIENT_SCAN_HEADERS: {
+      i64 idx = pg_http_client_scan_find(pending, PG_S("\r\n\r\n"));
+      if (-1 == idx) {
+        return false;
+      }
+      pending->scanned = (u64)idx + 4;
+      pending->scan = pg_http_client_scan_headers(pending, req, conflict);
+      break;
+    }
 
-  res.fd = ret;
+    case PG_HTTP_CLIENT_SCAN_UNTIL_CLOSE:
+      return false;
 
-  return PG_OK(res, PgFileDescriptor, PgError);
-}
+    case PG_HTTP_CLIENT_SCAN_LENGTH:
+      return raw.len >= pending->end;
+
+    case PG_HTTP_CLIENT_SCAN_CHUNK_SIZE:
+    case PG_HTTP_CLIENT_SCAN_TRAILERS: {
+      i64 idx = pg_http_client_scan_find(pending, PG_S("\r\n"));
+      if (-1 == idx) {
+        // Too long: malformed.
+        if (raw.len - pending->scanned > PG_HTTP_LINE_MAX_LEN) {
+          pending->scan = PG_HTTP_CLIENT_SCAN_WHOLE;
+          break;
+        }
+        return false;
+      }
+      PgString line = PG_SLICE_RANGE(raw, pending->scanned, (u64)idx);
+      pending->scanned = (u64)idx + 2;
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgAio, PgError) pg_aio_init() {
-  PgAio res = {0};
+      if (PG_HTTP_CLIENT_SCAN_TRAILERS == pending->scan) {
+        if (0 == line.len) {
+          pending->scan = PG_HTTP_CLIENT_SCAN_WHOLE;
+        }
+        break;
+      }
 
-  i32 ret = 0;
-  do {
-    ret = epoll_create(1 /*Ignored*/);
-  } while (-1 == ret && EINTR == errno);
+      // `chunk-size [ chunk-ext ]`, checked by `pg_http_chunked_read`.
+      PgParseNumberResult size = pg_string_parse_u64(line, 16, false);
+      if (!size.present) {
+        pending->scan = PG_HTTP_CLIENT_SCAN_WHOLE;
+      } else if (0 == size.n) { // Last chunk.
+        pending->scan = PG_HTTP_CLIENT_SCAN_TRAILERS;
+      } else {
+        // Followed by CRLF.
+        pending->end = pending->scanned + size.n + 2;
+        pending->scan = PG_HTTP_CLIENT_SCAN_CHUNK_DATA;
+      }
+      break;
+    }
 
-  if (-1 == ret) {
-    return PG_ERR(errno, PgAio, PgError);
-  }
+    case PG_HTTP_CLIENT_SCAN_CHUNK_DATA:
+      if (raw.len < pending->end) {
+        return false;
+      }
+      pending->scanned = pending->searched = pending->end;
+      pending->scan = PG_HTTP_CLIENT_SCAN_CHUNK_SIZE;
+      break;
 
-  res.aio.fd = ret;
-  return PG_OK(res, PgAio, PgError);
+    case PG_HTTP_CLIENT_SCAN_WHOLE:
+      return true;
+
+    default:
+      PG_ASSERT(0);
+    }
+  }
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_aio_ensure_inotify(PgAio *aio) {
-  PG_ASSERT(aio);
+// Read what arrived for `pending` without blocking. Returns whether the
+// response is whole, or an error.
+[[nodiscard]] static PG_RESULT(bool, PgError)
+    pg_http_client_pending_read(PgHttpClient *client,
+                                PgHttpClientPending *pending, PgHttpRequest req,
+                                PgAllocator *allocator) {
+  // Headers included.
+  u64 raw_max =
+      client->options.max_body_len + PG_HTTP_HEADERS_MAX * PG_HTTP_LINE_MAX_LEN;
 
-  if (aio->inotify.has_value) {
-    return 0;
+  u64 received = 0;
+  for (;;) {
+    PG_DYN_ENSURE_CAP(&pending->raw,
+                      pending->raw.len + client->options.buffer_size,
+                      allocator);
+    PgString space = PG_DYN_SPACE(PgString, &pending->raw);
+    PG_RESULT(u64, PgError)
+    res_read = pg_net_socket_read_non_blocking(pending->conn.socket, space);
+    if (PG_IS_ERR(res_read)) {
+      PgError err = PG_UNWRAP_ERR(res_read);
+      if (EAGAIN == err || EWOULDBLOCK == err) {
+        break;
+      }
+      if (EINTR == err) {
+        continue;
+      }
+      return PG_ERR(err, bool, PgError);
+    }
+
+    u64 read_count = PG_UNWRAP(res_read);
+    if (0 == read_count) { // Closed by the server.
+      return PG_OK(true, bool, PgError);
+    }
+    pending->raw.len += read_count;
+    received += read_count;
+    if (pending->raw.len > raw_max) {
+      return PG_ERR(PG_ERR_TOO_BIG, bool, PgError);
+    }
   }
 
-  PG_RESULT(PgFileDescriptor, PgError) res = pg_aio_inotify_init();
-  PG_IF_LET_ERR(err, res) { return err; }
+  // A spurious wake-up does not count as data received.
+  if (0 == received) {
+    return PG_OK(false, bool, PgError);
+  }
 
-  aio->inotify.has_value = true;
-  aio->inotify.value = PG_UNWRAP(res);
+  if (client->options.read_timeout_ms) {
+    pending->deadline_ns =
+        PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)) +
+        client->options.read_timeout_ms * PG_Milliseconds;
+  }
 
-  return pg_aio_register_interest_fd(*aio, aio->inotify.value,
-                                     PG_AIO_EVENT_KIND_READABLE);
+  return PG_OK(pg_http_client_scan(pending, req, allocator), bool, PgError);
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgFileDescriptor, PgError)
-    pg_aio_register_interest_fs_name(PgAio *aio, PgString name,
-                                     PgAioEventKind interest,
-                                     PgAllocator *allocator) {
-  PgError err = pg_aio_ensure_inotify(aio);
+// Parse the response received for `pending`, unless `err`, and hand its
+// connection back.
+static void pg_http_client_pending_finish(PgHttpClient *client,
+                                          PgHttpClientPending *pending,
+                                          PgHttpClientRequest req,
+                                          PgHttpClientResponse *res,
+                                          PgError err, PgAllocator *allocator) {
+  PG_ASSERT(pending->pending);
+  pending->pending = false;
+  (void)pg_aio_unregister_interest(client->aio, pending->conn.socket,
+                                   PG_AIO_EVENT_KIND_READABLE);
+
   if (err) {
-    return PG_ERR(err, PgFileDescriptor, PgError);
+    *res = (PgHttpClientResponse){.err = err};
+    pg_http_client_conn_close(client, pending->conn);
+    return;
   }
 
-  PgFileDescriptor fd =
-      PG_TRY(pg_aio_inotify_register_interest(*aio, name, interest),
-             PgFileDescriptor, PgError);
-
-  PgAioFsNode *fs_node = pg_aio_fs_node_upsert(&aio->fs_nodes, fd, allocator);
-  PG_ASSERT(fs_node);
-  fs_node->name = name;
+  PgReader reader = pg_http_client_raw_reader(
+      PG_DYN_TO_SLICE(PgString, pending->raw), allocator);
+  bool keep_alive = false;
+  *res =
+      pg_http_client_receive(client, &reader, req.req, &keep_alive, allocator);
+  if (res->err) {
+    pg_http_client_conn_close(client, pending->conn);
+    if (pending->reused && 0 == res->res.status &&
+        pg_http_method_is_idempotent(req.req.method)) {
+      *res = pg_http_client_do(client, req, allocator);
+    }
+    return;
+  }
 
-  return PG_OK(fd, PgFileDescriptor, PgError);
+  // Anything after the response is unexpected.
+  keep_alive = keep_alive && 0 == pg_http_client_raw_reader_unread(reader);
+  pg_http_client_release(client, pending->host, pending->conn, keep_alive);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_aio_register_interest_fd(PgAio aio, PgFileDescriptor fd,
-                            PgAioEventKind interest) {
-  struct epoll_event event = {0};
-  event.data.fd = fd.fd;
+// Make the requests concurrently: they are all sent first, each on its own
+// connection, and the responses are read as they arrive, without blocking,
+// each within `read_timeout_ms` of the last data received.
+// Only the reads of the responses overlap: the connections are opened, with
+// `connect_timeout_ms` each, and the requests written one after the other
+// beforehand, and the retry of a request on a reused connection closed by the
+// server is a blocking `pg_http_client_do`.
+[[maybe_unused]] static void
+pg_http_client_do_many(PgHttpClient *client, PG_SLICE(PgHttpClientRequest) reqs,
+                       PG_SLICE(PgHttpClientResponse) responses,
+                       PgAllocator *allocator) {
+  PG_ASSERT(reqs.len == responses.len);
+
+  PgHttpClientPending *pendings =
+      pg_alloc(allocator, sizeof(PgHttpClientPending),
+               _Alignof(PgHttpClientPending), reqs.len);
+  u64 pending_count = 0;
+
+  for (u64 i = 0; i < reqs.len; i++) {
+    PgHttpClientRequest req =
+        pg_http_client_request_defaults(PG_SLICE_AT(reqs, i));
+    PgHttpClientResponse *res = PG_SLICE_AT_PTR(&responses, i);
+    *res = (PgHttpClientResponse){0};
+    PgHttpClientPending *pending = &pendings[i];
+    *pending = (PgHttpClientPending){.deadline_ns = UINT64_MAX};
+
+    pending->host =
+        pg_http_client_host_upsert(client, req.host, req.port, allocator);
+    PG_RESULT(PgHttpClientConn, PgError)
+    res_conn = pg_http_client_acquire(client, pending->host, req, true,
+                                      &pending->reused, allocator);
+    if (PG_IS_ERR(res_conn)) {
+      res->err = PG_UNWRAP_ERR(res_conn);
+      continue;
+    }
+    pending->conn = PG_UNWRAP(res_conn);
+
+    PgError err = pg_http_client_send(&pending->conn, req, allocator);
+    if (!err) {
+      err = pg_aio_register_interest_fd(client->aio, pending->conn.socket,
+                                        PG_AIO_EVENT_KIND_READABLE);
+    }
+    if (err) {
+      pg_http_client_conn_close(client, pending->conn);
+      res->err = err;
+      if (pending->reused && pg_http_method_is_idempotent(req.req.method)) {
+        *res = pg_http_client_do(client, req, allocator);
+      }
+      continue;
+    }
+
+    if (client->options.read_timeout_ms) {
+      pending->deadline_ns =
+          PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)) +
+          client->options.read_timeout_ms * PG_Milliseconds;
+    }
+    pending->pending = true;
+    pending_count += 1;
+  }
+
+  while (pending_count > 0) {
+    u64 now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    u64 deadline_ns = UINT64_MAX;
+    for (u64 i = 0; i < reqs.len; i++) {
+      if (pendings[i].pending) {
+        deadline_ns = PG_MIN(deadline_ns, pendings[i].deadline_ns);
+      }
+    }
+    PG_OPTION(u32) timeout_ms = {0};
+    if (UINT64_MAX != deadline_ns) {
+      u64 ms = deadline_ns > now_ns
+                   ? pg_div_ceil(deadline_ns - now_ns, PG_Milliseconds)
+                   : 0;
+      timeout_ms = PG_SOME((u32)PG_MIN(ms, UINT32_MAX), u32);
+    }
+
+    PgAioEvent events[64] = {0};
+    PG_SLICE(PgAioEvent) events_slice = PG_SLICE_FROM_C(events);
+    PG_RESULT(u64, PgError)
+    res_wait = pg_aio_wait(client->aio, events_slice, timeout_ms);
+    if (PG_IS_ERR(res_wait)) {
+      for (u64 i = 0; i < reqs.len; i++) {
+        if (pendings[i].pending) {
+          pg_http_client_pending_finish(
+              client, &pendings[i], PG_SLICE_AT(reqs, i),
+              PG_SLICE_AT_PTR(&responses, i), PG_UNWRAP_ERR(res_wait),
+              allocator);
+        }
+      }
+      return;
+    }
+
+    for (u64 j = 0; j < PG_UNWRAP(res_wait); j++) {
+      PgAioEvent event = PG_C_ARRAY_AT(events, PG_STATIC_ARRAY_LEN(events), j);
+
+      for (u64 i = 0; i < reqs.len; i++) {
+        PgHttpClientPending *pending = &pendings[i];
+        if (!pending->pending || pending->conn.socket.fd != event.fd.fd) {
+          continue;
+        }
+
+        PgHttpClientRequest req =
+            pg_http_client_request_defaults(PG_SLICE_AT(reqs, i));
+        PG_RESULT(bool, PgError)
+        res_read = pg_http_client_pending_read(client, pending, req.req,
+                                               allocator);
+        if (PG_IS_ERR(res_read) || PG_UNWRAP(res_read)) {
+          pg_http_client_pending_finish(
+              client, pending, req, PG_SLICE_AT_PTR(&responses, i),
+              PG_IS_ERR(res_read) ? PG_UNWRAP_ERR(res_read) : 0, allocator);
+          pending_count -= 1;
+        }
+        break;
+      }
+    }
 
-  if (interest & PG_AIO_EVENT_KIND_READABLE) {
-    event.events |= EPOLLIN;
-  }
-  if (interest & PG_AIO_EVENT_KIND_WRITABLE) {
-    event.events |= EPOLLOUT;
+    now_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    for (u64 i = 0; i < reqs.len; i++) {
+      PgHttpClientPending *pending = &pendings[i];
+      if (pending->pending && now_ns >= pending->deadline_ns) {
+        pg_http_client_pending_finish(
+            client, pending,
+            pg_http_client_request_defaults(PG_SLICE_AT(reqs, i)),
+            PG_SLICE_AT_PTR(&responses, i), (PgError)ETIMEDOUT, allocator);
+        pending_count -= 1;
+      }
+    }
   }
+}
+#endif
 
-  i32 ret = 0;
-  do {
-    ret = epoll_ctl(aio.aio.fd, EPOLL_CTL_ADD, fd.fd, &event);
-  } while (-1 == ret && EINTR == errno);
+#ifndef PG_OS_WASM
+// Cheapest checks first, and no token is spent on a connection turned away
+// anyway.
+[[maybe_unused]] [[nodiscard]] static PgHttpAdmission
+pg_http_server_admit(PgHttpServerOptions options, PgRateLimiter *limiter,
+                     u64 connections, PgIpv4Address client, u64 queue_ms,
+                     u64 now_ns) {
+  if (options.max_queue_ms && queue_ms > options.max_queue_ms) {
+    return PG_HTTP_ADMISSION_OVERLOADED;
+  }
+  if (options.max_connections && connections >= options.max_connections) {
+    return PG_HTTP_ADMISSION_OVERLOADED;
+  }
+  if (limiter && !pg_rate_limiter_allow(limiter, client.ip, now_ns)) {
+    return PG_HTTP_ADMISSION_RATE_LIMITED;
+  }
+  return PG_HTTP_ADMISSION_ACCEPT;
+}
+
+// Bounds of the lingering close of a rejected connection, which holds up the
+// accept loop.
+#define PG_HTTP_REJECT_LINGER_MS 50
+#define PG_HTTP_REJECT_LINGER_MAX_LEN (64 * PG_KiB)
+
+// Answer without reading the request, and close. The send buffer of a new
+// connection always has room for it. Closing with unread data resets the
+// connection, which may discard the response before the client reads it:
+// after the response, what the client sends is drained until it closes its
+// side, within `PG_HTTP_REJECT_LINGER_MS` and
+// `PG_HTTP_REJECT_LINGER_MAX_LEN`, like the lingering close of nginx.
+[[maybe_unused]] static void pg_http_server_reject(PgFileDescriptor sock,
+                                                   PgHttpAdmission admission) {
+  PgString response =
+      PG_HTTP_ADMISSION_RATE_LIMITED == admission
+          ? PG_S("HTTP/1.1 429 Too Many Requests\r\nRetry-After: 1\r\n"
+                 "Content-Length: 0\r\nConnection: close\r\n\r\n")
+          : PG_S("HTTP/1.1 503 Service Unavailable\r\nRetry-After: 1\r\n"
+                 "Content-Length: 0\r\nConnection: close\r\n\r\n");
+  (void)send(sock.fd, response.data, response.len,
+             MSG_DONTWAIT | MSG_NOSIGNAL);
+  (void)shutdown(sock.fd, SHUT_WR);
+
+  u64 start_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  for (u64 drained = 0; drained < PG_HTTP_REJECT_LINGER_MAX_LEN;) {
+    u64 elapsed_ms =
+        (PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)) -
+         start_ns) /
+        PG_Milliseconds;
+    if (elapsed_ms >= PG_HTTP_REJECT_LINGER_MS) {
+      break;
+    }
 
-  if (-1 == ret) {
-    return (PgError)errno;
+    struct pollfd pfd = {.fd = sock.fd, .events = POLLIN};
+    i32 ret = 0;
+    do {
+      ret = poll(&pfd, 1, (i32)(PG_HTTP_REJECT_LINGER_MS - elapsed_ms));
+    } while (-1 == ret && EINTR == errno);
+    if (ret <= 0) {
+      break;
+    }
+
+    u8 discard[4096];
+    i64 n = 0;
+    do {
+      n = recv(sock.fd, discard, sizeof(discard), MSG_DONTWAIT);
+    } while (-1 == n && EINTR == errno);
+    // Closed by the client, or failed.
+    if (0 == n || (-1 == n && EAGAIN != errno && EWOULDBLOCK != errno)) {
+      break;
+    }
+    drained += n > 0 ? (u64)n : 0;
   }
 
-  return 0;
+  (void)pg_net_socket_close(sock);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_aio_unregister_interest(PgAio aio, PgFileDescriptor fd,
-                           PgAioEventKind interest) {
-  struct epoll_event event = {0};
-  event.data.fd = fd.fd;
-
-  if (interest & PG_AIO_EVENT_KIND_READABLE) {
-    event.events |= EPOLLIN;
+[[maybe_unused]]
+static PgError pg_http_server_start(PgHttpServerOptions options,
+                                    PgLogger *logger) {
+  PgError err = 0;
+  // Exited children are counted when reaped, otherwise they are not waited
+  // for.
+  if (!options.max_connections) {
+    err = pg_process_avoid_child_zombies();
   }
-  if (interest & PG_AIO_EVENT_KIND_WRITABLE) {
-    event.events |= EPOLLOUT;
+  if (err) {
+    pg_log(logger, PG_LOG_LEVEL_ERROR,
+           "http server: failed to avoid child zombies",
+           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
+    return err;
   }
 
-  i32 ret = 0;
-  do {
-    ret = epoll_ctl(aio.aio.fd, EPOLL_CTL_DEL, fd.fd, &event);
-  } while (-1 == ret && EINTR == errno);
-
-  if (-1 == ret) {
-    return (PgError)errno;
+  PgRateLimiter limiter = {0};
+  PgArena limiter_arena = {0};
+  if (options.rate_limit_per_s) {
+    u64 slots_len = options.rate_limit_slots ? options.rate_limit_slots : 4096;
+    limiter_arena = pg_arena_make_from_virtual_mem(
+        slots_len * 2 * sizeof(PgRateLimiterSlot) + PG_KiB);
+    PgArenaAllocator limiter_arena_allocator =
+        pg_make_arena_allocator(&limiter_arena);
+    limiter = pg_rate_limiter_make(
+        options.rate_limit_per_s, PG_MAX(options.rate_limit_burst, 1),
+        slots_len, pg_arena_allocator_as_allocator(&limiter_arena_allocator));
   }
+  u64 connections = 0;
 
-  return 0;
-}
-
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_aio_wait(PgAio aio, PG_SLICE(PgAioEvent) events_out,
-                PG_OPTION(u32) timeout_ms) {
-  struct epoll_event events[1024] = {0};
-  u64 events_len = PG_MIN(events_out.len, PG_STATIC_ARRAY_LEN(events));
+  PG_RESULT(PgFileDescriptor, PgError) res_create = pg_net_create_tcp_socket();
+  PG_IF_LET_ERR(err, res_create) {
+    pg_log(logger, PG_LOG_LEVEL_ERROR,
+           "http server: failed to create tcp socket",
+           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
+    return err;
+  }
+  PgFileDescriptor server_socket = PG_UNWRAP(res_create);
 
-  i32 ret = 0;
-  do {
-    ret = epoll_wait(aio.aio.fd, events, (i32)events_len,
-                     timeout_ms.has_value ? (i32)timeout_ms.value : -1);
-  } while (-1 == ret && EINTR == errno);
+  err = pg_net_socket_enable_reuse(server_socket);
+  if (err) {
+    pg_log(logger, PG_LOG_LEVEL_ERROR,
+           "http server: failed to enable socket reuse",
+           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
+    goto end;
+  }
 
-  if (-1 == ret) {
-    return PG_ERR(errno, u64, PgError);
+  PgIpv4Address address = {.port = options.port};
+  err = pg_net_tcp_bind_ipv4(server_socket, address);
+  if (err) {
+    pg_log(logger, PG_LOG_LEVEL_ERROR, "http server: failed to bind tcp socket",
+           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
+    goto end;
   }
 
-  u64 res = (u64)ret;
+  err = pg_net_tcp_listen(server_socket, options.listen_backlog);
+  if (err) {
+    pg_log(logger, PG_LOG_LEVEL_ERROR,
+           "http server: failed to listen on tcp socket",
+           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
+    goto end;
+  }
 
-  for (u64 i = 0; i < (u64)ret; i++) {
-    struct epoll_event e =
-        PG_C_ARRAY_AT(events, PG_STATIC_ARRAY_LEN(events), i);
+  pg_log(logger, PG_LOG_LEVEL_INFO, "http server: listening",
+         pg_log_c_u16("port", options.port));
 
-    PG_SLICE_AT(events_out, i).fd.fd = e.data.fd;
+  for (;;) {
+    PgIpv4AddressAcceptResult res_accept = pg_net_tcp_accept(server_socket);
+    if (res_accept.err) {
+      // TODO: Some errors are retryable.
+      err = res_accept.err;
+      pg_log(logger, PG_LOG_LEVEL_ERROR,
+             "http server: failed to accept new connection",
+             pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
+      goto end;
+    }
 
-    if (e.events & EPOLLIN) {
-      PG_SLICE_AT(events_out, i).kind |= PG_AIO_EVENT_KIND_READABLE;
+#ifdef PG_OS_LINUX
+    // Before the admission checks, which account for the time it takes.
+    if (options.file_cache) {
+      err = pg_http_file_cache_refresh(options.file_cache);
+      if (err) {
+        pg_log(logger, PG_LOG_LEVEL_ERROR,
+               "http server: failed to refresh file cache",
+               pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
+        err = 0;
+      }
     }
-    if (e.events & EPOLLOUT) {
-      PG_SLICE_AT(events_out, i).kind |= PG_AIO_EVENT_KIND_WRITABLE;
+#endif
+
+    if (options.max_connections) {
+      u64 reaped = pg_process_reap_children();
+      connections -= PG_MIN(reaped, connections);
+    }
+
+    u64 queue_ms =
+        options.max_queue_ms ? pg_net_tcp_queue_time_ms(res_accept.socket) : 0;
+    PgHttpAdmission admission = pg_http_server_admit(
+        options, limiter.slots ? &limiter : nullptr, connections,
+        res_accept.address, queue_ms,
+        PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)));
+    if (PG_HTTP_ADMISSION_ACCEPT != admission) {
+      pg_log(logger, PG_LOG_LEVEL_DEBUG, "http server: connection turned away",
+             pg_log_c_u16("port", options.port),
+             pg_log_c_u64("connections", connections),
+             pg_log_c_u64("queue_ms", queue_ms),
+             pg_log_c_u64("admission", admission));
+      pg_http_server_reject(res_accept.socket, admission);
+      continue;
     }
-    if (e.events & EPOLLERR) {
-      PG_SLICE_AT(events_out, i).kind |= PG_AIO_EVENT_KIND_ERROR;
+
+    PG_RESULT(u32, PgError) res_proc_dup = pg_process_dup();
+    PG_IF_LET_ERR(err, res_proc_dup) {
+      pg_log(
+          logger, PG_LOG_LEVEL_ERROR,
+          "http server: failed to spawn new process to handle new connection",
+          pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
+      (void)pg_net_socket_close(res_accept.socket);
+      continue;
     }
-    if (e.events & EPOLLHUP) {
-      PG_SLICE_AT(events_out, i).kind |= PG_AIO_EVENT_KIND_EOF;
+
+    u32 proc = PG_UNWRAP(res_proc_dup);
+    if (0 == proc) { // Child.
+      PgArena arena =
+          pg_arena_make_from_virtual_mem(options.http_handler_arena_mem);
+
+      (void)pg_http_server_handler(res_accept.socket, options, logger, &arena);
+      exit(0);
     }
+
+    PG_ASSERT(proc); // Parent.
+    connections += 1;
+
+    (void)pg_net_socket_close(res_accept.socket);
   }
 
-  return PG_OK(res, u64, PgError);
+end:
+  (void)pg_net_socket_close(server_socket);
+  if (limiter.slots) {
+    (void)pg_arena_release(&limiter_arena);
+  }
+  return err;
 }
+#endif
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(u64, PgError)
-    pg_aio_wait_cqe(PgAio aio, PgRing *cqe, PG_OPTION(u32) timeout_ms) {
-  struct epoll_event events[1024] = {0};
-  u64 can_write_count = pg_ring_can_write_count(*cqe) / sizeof(PgAioEvent);
-  u64 events_len = PG_MIN(can_write_count, PG_STATIC_ARRAY_LEN(events));
+[[maybe_unused]] [[nodiscard]] static PG_OPTION(PgAioEvent)
+    pg_aio_cqe_dequeue(PgRing *cqe) {
+  PG_OPTION(PgAioEvent) res = {0};
+  if (pg_ring_can_read_count(*cqe) < sizeof(PgAioEvent)) {
+    return res;
+  }
 
-  i32 ret = 0;
-  do {
-    ret = epoll_wait(aio.aio.fd, events, (i32)events_len,
-                     timeout_ms.has_value ? (i32)timeout_ms.value : -1);
-  } while (-1 == ret && EINTR == errno);
+  PG_SLICE(u8) bytes = {.data = (u8 *)&res.value, .len = sizeof(PgAioEvent)};
+  PG_ASSERT(sizeof(PgAioEvent) == pg_ring_read_bytes(cqe, bytes));
 
-  if (-1 == ret) {
-    return PG_ERR(errno, u64, PgError);
-  }
+  res.has_value = true;
+  return res;
+}
 
-  u64 res = (u64)ret;
+typedef struct {
+  bool required;
+  // Name of the value e.g. `linker` for `-fuse-ld`.
+  // If non-empty: the option expects 1 or more value(s).
+  // It appears in the help message.
+  PgString value_name;
+  PgString name_short;
+  PgString name_long;
+  PgString description;
+} PgCliOptionDescription;
+PG_OPTION_DECL(PgCliOptionDescription);
+PG_DYN_DECL(PgCliOptionDescription);
+PG_SLICE_DECL(PgCliOptionDescription);
 
-  for (u64 i = 0; i < (u64)ret; i++) {
-    struct epoll_event e =
-        PG_C_ARRAY_AT(events, PG_STATIC_ARRAY_LEN(events), i);
+typedef struct {
+  PgCliOptionDescription description;
+  PG_DYN(PgString) values;
+  PgError err;
+} PgCliOption;
+PG_DYN_DECL(PgCliOption);
+PG_SLICE_DECL(PgCliOption);
+PG_RESULT_DECL(PgCliOption, PgError);
+PG_OPTION_DECL(PgCliOption);
+PG_RESULT_DECL(PG_OPTION(PgCliOption), PgError);
 
-    PgAioEvent ev = {0};
-    ev.fd.fd = e.data.fd;
+typedef struct {
+  PG_DYN(PgString) plain_arguments;
+  PG_DYN(PgCliOption) options;
 
-    if (e.events & EPOLLIN) {
-      ev.kind |= PG_AIO_EVENT_KIND_READABLE;
-    }
-    if (e.events & EPOLLOUT) {
-      ev.kind |= PG_AIO_EVENT_KIND_WRITABLE;
-    }
-    if (e.events & EPOLLERR) {
-      ev.kind |= PG_AIO_EVENT_KIND_ERROR;
-    }
-    if (e.events & EPOLLHUP) {
-      ev.kind |= PG_AIO_EVENT_KIND_EOF;
-    }
+  // Error reporting.
+  PgError err;
+  PgString err_argv;
+} PgCliParseResult;
 
-    PG_SLICE(u8) ev_bytes = {.data = (u8 *)&ev, .len = sizeof(ev)};
-    PG_ASSERT(sizeof(ev) == pg_ring_write_bytes(cqe, ev_bytes));
+[[nodiscard]] static bool pg_cli_is_short_option(PgString s) {
+  PG_OPTION(PgString) dash_opt = pg_string_consume_rune(s, '-');
+  if (!dash_opt.has_value) {
+    return false;
+  }
+
+  // Is long?
+  s = dash_opt.value;
+  dash_opt = pg_string_consume_rune(s, '-');
+  return !dash_opt.has_value;
+}
+
+[[nodiscard]] static bool pg_cli_is_no_option(PgString s) {
+  PG_OPTION(PgString) dash_opt = pg_string_consume_rune(s, '-');
+  return !dash_opt.has_value;
+}
+
+[[nodiscard]] static PG_OPTION(PgCliOptionDescription)
+    pg_cli_desc_find_by_name(PG_SLICE(PgCliOptionDescription) descs,
+                             PgString name) {
+  PG_OPTION(PgCliOptionDescription) res = {0};
+
+  PG_EACH_PTR(it, &descs) {
+    if (pg_string_eq(it->name_long, name) ||
+        pg_string_eq(it->name_short, name)) {
+      res.has_value = true;
+      res.value = *it;
+      return res;
+    }
   }
 
-  return PG_OK(res, u64, PgError);
+  return res;
 }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgAioEvent, PgError)
-    pg_aio_fs_wait_one(PgAio aio, PG_OPTION(u32) timeout_ms,
-                       PgAllocator *allocator) {
-  PgAioEvent res = {0};
+[[nodiscard]] static PgCliOption *
+pg_cli_options_find_by_name(PG_DYN(PgCliOption) options, PgString name_short,
+                            PgString name_long) {
+  PG_EACH_PTR(it, &options) {
+    if (pg_string_eq(it->description.name_long, name_long) ||
+        pg_string_eq(it->description.name_short, name_short)) {
+      return it;
+    }
+  }
 
-  PG_SLICE(PgAioEvent)
-  events_slice = {
-      .data = &res,
-      .len = 1,
-  };
+  return nullptr;
+}
 
-  PG_RESULT(u64, PgError) res_wait = pg_aio_wait(aio, events_slice, timeout_ms);
-  PG_IF_LET_ERR(err, res_wait) { return PG_ERR(err, PgAioEvent, PgError); }
-  u64 wait = PG_UNWRAP(res_wait);
-  if (0 == wait) {
-    // TODO: Should it be `PG_RESULT(PG_OPTION(PgAioEvent),PgError)`?
-    return PG_OK(res, PgAioEvent, PgError);
+[[nodiscard]] static PgError
+pg_cli_handle_short_option(PgString opt_name, bool with_opt_value_allowed,
+                           PG_DYN(PgCliOption) * options,
+                           PG_SLICE(PgCliOptionDescription) descs, char **argv,
+                           u64 *argv_idx, PgAllocator *allocator) {
+  PG_OPTION(PgCliOptionDescription)
+  desc_has_value = pg_cli_desc_find_by_name(descs, opt_name);
+  if (!desc_has_value.has_value) {
+    return PG_ERR_CLI_UNKNOWN_OPTION;
   }
-  events_slice.len = wait;
+  PgCliOptionDescription desc = desc_has_value.value;
 
-  if (res.kind & PG_AIO_EVENT_KIND_READABLE) {
-    u8 inev_data[sizeof(struct inotify_event) + 4096 + 1] = {0};
-    PG_SLICE(u8)
-    inev_slice = {
-        .data = inev_data,
-        .len = PG_STATIC_ARRAY_LEN(inev_data),
-    };
-    PG_RESULT(u64, PgError) res_read = pg_file_read(res.fd, inev_slice);
-    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgAioEvent, PgError); }
-    PG_ASSERT(PG_UNWRAP(res_read) >= sizeof(struct inotify_event));
+  if (!pg_string_is_empty(desc.value_name) && !with_opt_value_allowed) {
+    return PG_ERR_CLI_FORBIDEN_OPTION_VALUE;
+  }
 
-    struct inotify_event inev = *(struct inotify_event *)inev_data;
-    PG_ASSERT(PG_UNWRAP(res_read) == sizeof(struct inotify_event) + inev.len);
+  PgString opt_value = {0};
+  if (!pg_string_is_empty(desc.value_name)) {
+    // A value is expected in the next `argv` slot.
+    *argv_idx += 1;
+    opt_value = pg_cstr_to_string(argv[*argv_idx]);
+  }
 
-    res = (PgAioEvent){0};
-    res.fd.fd = inev.wd;
+  if (!pg_string_is_empty(desc.value_name) &&
+      (0 == opt_value.len || !pg_cli_is_no_option(opt_value))) {
+    return PG_ERR_CLI_MISSING_REQUIRED_OPTION_VALUE;
+  }
 
-    if (inev.mask & IN_CREATE) {
-      res.kind |= PG_AIO_EVENT_KIND_FILE_CREATED;
-    }
-    if (inev.mask & IN_MODIFY) {
-      res.kind |= PG_AIO_EVENT_KIND_FILE_MODIFIED;
-    }
-    if (inev.mask & IN_DELETE) {
-      res.kind |= PG_AIO_EVENT_KIND_FILE_DELETED;
+  // Find by the short name.
+  PgCliOption *opt_existing =
+      pg_cli_options_find_by_name(*options, desc.name_short, PG_S(""));
+  if (opt_existing) {
+    if (pg_string_is_empty(desc.value_name)) {
+      // Option already exists (without value), do not add it again.
+      return 0;
     }
 
-    if (0 != inev.len) {
-      char *s = (char *)inev_data + sizeof(inev);
-      u64 real_len = strlen(s);
-      res.name = pg_string_make(real_len, allocator);
-      pg_memcpy(res.name.data, s, real_len);
-    }
+    // With value.
+
+    PG_DYN_PUSH(&opt_existing->values, opt_value, allocator);
+    return 0;
   }
 
-  return PG_OK(res, PgAioEvent, PgError);
+  // Add the new option.
+  PgCliOption opt = {.description = desc};
+  if (!pg_string_is_empty(desc.value_name)) {
+    PG_DYN_PUSH(&opt.values, opt_value, allocator);
+  }
+
+  PG_DYN_PUSH(options, opt, allocator);
+  return 0;
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_file_send_to_socket(PgFileDescriptor dst, PgFileDescriptor src) {
-  PG_RESULT(u64, PgError) res_size = pg_file_size(src);
-  PG_IF_LET_ERR(err, res_size) { return err; }
-  i64 offset = 0;
-  u64 size = PG_UNWRAP(res_size);
+[[nodiscard]] static PgError
+pg_cli_handle_long_option(PgString opt_name, PG_DYN(PgCliOption) * options,
+                          PG_SLICE(PgCliOptionDescription) descs, char **argv,
+                          u64 *argv_idx, PgAllocator *allocator) {
+  PgString opt_value = {0};
+  PgStringCut cut = pg_string_cut_rune(opt_name, '=');
+  if (cut.has_value) {
+    opt_name = cut.left;
+    opt_value = cut.right;
+  }
 
-  for (u64 _i = 0; _i < size; _i++) {
-    i64 ret = 0;
-    do {
-      ret = sendfile(dst.fd, src.fd, &offset, size);
-    } while (-1 == ret && EINTR == errno);
+  PG_OPTION(PgCliOptionDescription)
+  desc_has_value = pg_cli_desc_find_by_name(descs, opt_name);
+  if (!desc_has_value.has_value) {
+    return PG_ERR_CLI_UNKNOWN_OPTION;
+  }
+  PgCliOptionDescription desc = desc_has_value.value;
 
-    if (-1 == ret) {
-      // TODO: Perhaps fallback to `read(2)` + `write(2)` in case of
-      // `EINVAL` or `ENOSYS`.
-      return (PgError)errno;
+  // Find the value if one is expected.
+  // Could be after the `=` in the same `argv` slot, or in the next argv slot,
+  // if there is no `=`.
+  // E.g.: `--foo=bar`, `--foo bar`, `--foo=--bar`.
+  // But not: `--foo=` , `--foo --bar`.
+  {
+    bool value_expected = !pg_string_is_empty(desc.value_name);
+    // Reject `--foo=`.
+    if (value_expected && cut.has_value && pg_string_is_empty(opt_value)) {
+      return PG_ERR_CLI_MISSING_REQUIRED_OPTION_VALUE;
     }
 
-    size -= (u64)ret;
-    offset += ret;
-
-    if (0 == size) {
-      break;
+    if (value_expected && pg_string_is_empty(opt_value)) {
+      // A value is expected in the next `argv` slot.
+      *argv_idx += 1;
+      opt_value = pg_cstr_to_string(argv[*argv_idx]);
+    }
+    bool is_value_suitable =
+        !pg_string_is_empty(opt_value) &&
+        (cut.has_value ? true : pg_cli_is_no_option(opt_value));
+    if (value_expected && !is_value_suitable) {
+      return PG_ERR_CLI_MISSING_REQUIRED_OPTION_VALUE;
     }
   }
-  return 0;
-}
 
-#endif
-
-#ifdef PG_OS_APPLE
+  // Find by the long name.
+  PgCliOption *opt_existing =
+      pg_cli_options_find_by_name(*options, PG_S(""), desc.name_long);
+  if (opt_existing) {
+    if (pg_string_is_empty(desc.value_name)) {
+      // Option already exists (without value), do not add it again.
+      return 0;
+    }
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgMacho, PgError)
-    pg_macho_parse(PG_SLICE(u8) bytes) {
-  PgMacho res = {0};
-  PgReader r = pg_reader_make_from_bytes(bytes);
+    // With value.
 
-  // Magic.
-  {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
-    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
-    u32 magic = PG_UNWRAP(res_read);
-    if (0xfe'ed'fa'cf != magic) {
-      return PG_ERR(PG_ERR_INVALID_VALUE, PgMacho, PgError);
-    }
-    res.header.magic = magic;
-  }
-  // Cpu type.
-  {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
-    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
-    res.header.cpu_type = PG_UNWRAP(res_read);
-  }
-  // Cpu sub type.
-  {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
-    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
-    res.header.cpu_subtype = PG_UNWRAP(res_read);
-  }
-  // File type.
-  {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
-    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
-    res.header.filetype = PG_UNWRAP(res_read);
-  }
-  // Ncmds.
-  {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
-    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
-    res.header.cmds_count = PG_UNWRAP(res_read);
-  }
-  // Sizeof cmds.
-  {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
-    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
-    res.header.cmds_sizeof = PG_UNWRAP(res_read);
-  }
-  // Flags.
-  {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
-    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
-    res.header.flags = PG_UNWRAP(res_read);
-  }
-  // Reserved.
-  {
-    PG_RESULT(u32, PgError) res_read = pg_reader_read_u32_le(&r);
-    PG_IF_LET_ERR(err, res_read) { return PG_ERR(err, PgMacho, PgError); }
-    res.header.reserved = PG_UNWRAP(res_read);
+    PG_DYN_PUSH(&opt_existing->values, opt_value, allocator);
+    return 0;
   }
 
-  {
-    for (u64 i = 0; i < res.header.cmds_count; i++) {
-      PgMachoLoadCommand load_cmd = {0};
-      PgError err = pg_reader_read_full(&r, (u8 *)&load_cmd, sizeof(load_cmd));
-      if (err) {
-        return PG_ERR(err, PgMacho, PgError);
-      }
-      if (load_cmd.cmdsize < sizeof(load_cmd)) {
-        return PG_ERR(PG_ERR_INVALID_VALUE, PgMacho, PgError);
-      }
-      u32 remaining_size = load_cmd.cmdsize - sizeof(load_cmd);
+  // Add the new option.
+  PgCliOption opt = {.description = desc};
+  if (!pg_string_is_empty(desc.value_name)) {
+    PG_DYN_PUSH(&opt.values, opt_value, allocator);
+  }
 
-      switch (load_cmd.cmd) {
-      case PG_MACHO_LC_SYMTAB: {
-        PgError err = pg_reader_discard(&r, remaining_size);
-        if (err) {
-          return PG_ERR(err, PgMacho, PgError);
-        }
-      } break;
-      case PG_MACHO_LC_SEGMENT_64: {
-        u8 name[16] = {0};
-        PgError err = pg_reader_read_full(&r, name, PG_STATIC_ARRAY_LEN(name));
-        if (err) {
-          return PG_ERR(err, PgMacho, PgError);
-        }
-        if (remaining_size < PG_STATIC_ARRAY_LEN(name)) {
-          return PG_ERR(PG_ERR_INVALID_VALUE, PgMacho, PgError);
-        }
+  PG_DYN_PUSH(options, opt, allocator);
+  return 0;
+}
 
-        if (!pg_string_eq(PG_S("__DWARF"), pg_cstr_to_string((char *)name))) {
-          err =
-              pg_reader_discard(&r, remaining_size - PG_STATIC_ARRAY_LEN(name));
-          if (err) {
-            return PG_ERR(err, PgMacho, PgError);
-          }
-        }
-      } break;
-      default: {
-        PgError err = pg_reader_discard(&r, remaining_size);
-        if (err) {
-          return PG_ERR(err, PgMacho, PgError);
-        }
-      }
-      }
-    }
-  }
+static void pg_cli_inject_help_option(PG_DYN(PgCliOptionDescription) * descs,
+                                      PgAllocator *allocator) {
+  PgCliOptionDescription desc = {
+      .name_short = PG_S("h"),
+      .name_long = PG_S("help"),
+      .description = PG_S("Print this help message"),
+  };
 
-  return PG_OK(res, PgMacho, PgError);
+  PG_DYN_PUSH(descs, desc, allocator);
 }
 
-[[maybe_unused]] [[nodiscard]] static PgString pg_self_exe_get_path() {
-  static _Atomic PgOnce once = PG_ONCE_UNINITIALIZED;
-  static char path_c[PG_PATH_MAX] = {0};
-  static PgString res = {0};
+[[maybe_unused]] [[nodiscard]] static PgCliParseResult
+pg_cli_parse(PG_DYN(PgCliOptionDescription) * descs, int argc, char *argv[],
+             PgAllocator *allocator) {
+  PgCliParseResult res = {0};
+
+  pg_cli_inject_help_option(descs, allocator);
+  PG_SLICE(PgCliOptionDescription)
+  desc_slice = PG_DYN_TO_SLICE(PG_SLICE(PgCliOptionDescription), *descs);
 
-  if (pg_once_do(&once)) {
-    u32 len = PG_STATIC_ARRAY_LEN(path_c);
+  for (u64 i = 1 /* Skip exe name */; i < (u64)argc; i++) {
+    PgString arg = pg_cstr_to_string(argv[i]);
 
-    i32 ret = _NSGetExecutablePath(path_c, &len);
-    if (-1 == ret) {
+    // Plain argument.
+    if (pg_cli_is_no_option(arg)) {
+      PG_DYN_PUSH(&res.plain_arguments, arg, allocator);
+      continue;
+    }
+
+    // Treat all remaining arguments as plain after `--`.
+    if (pg_string_eq(arg, PG_S("--"))) {
+      for (u64 j = i + 1; j < (u64)argc; j++) {
+        PgString arg = pg_cstr_to_string(argv[j]);
+        PG_DYN_PUSH(&res.plain_arguments, arg, allocator);
+      }
       return res;
     }
-    res = pg_cstr_to_string(path_c);
 
-    pg_once_mark_as_done(&once);
-  }
+    // Error if the option name starts with more than 2 `-` e.g. `---a` or it
+    // only contains `-` e.g. `-`, `--`.
+    if (pg_string_starts_with(arg, PG_S("---")) ||
+        pg_string_eq(arg, PG_S("-"))) {
+      res.err = PG_ERR_CLI_MALFORMED_OPTION;
+      res.err_argv = arg;
+      return res;
+    }
 
-  PG_ASSERT(!pg_string_is_empty(res));
-  return res;
-}
+    if (pg_cli_is_short_option(arg)) {
+      PgString opt_name = pg_string_trim_left(arg, '-');
+      PG_ASSERT(opt_name.len > 0);
 
-[[nodiscard]] static u64 pg_self_pie_get_offset() {
-  intptr_t ret = _dyld_get_image_vmaddr_slide(0);
-  return ret;
-}
+      if (1 == opt_name.len) {
+        PgError err = pg_cli_handle_short_option(
+            opt_name, true, &res.options, desc_slice, argv, &i, allocator);
+        if (0 != err) {
+          res.err = err;
+          // Best effort reporting.
+          res.err_argv = (PG_ERR_CLI_UNKNOWN_OPTION == err) ? arg : opt_name;
+          return res;
+        }
+      } else {
+        // Handle coalesced short options, forbid option values.
+        // This means that `./a.out -vH foo` will be parsed as
+        // options: `-v`, `-H`, plain arguments: `foo`.
+        // Assume ASCII.
+        for (u64 j = 1; j < arg.len; j++) {
+          PgString opt_name = {.data = PG_SLICE_AT_PTR(&arg, j), .len = 1};
+          PgError err = pg_cli_handle_short_option(
+              opt_name, false, &res.options, desc_slice, argv, &i, allocator);
+          if (0 != err) {
+            res.err = err;
+            // Best effort reporting.
 
-[[maybe_unused]] [[nodiscard]] static PG_RESULT(PgDebugInfoIterator, PgError)
-    pg_self_debug_info_iterator_make(PgAllocator *allocator) {
-  PgDebugInfoIterator res = {0};
+            if (PG_ERR_CLI_UNKNOWN_OPTION == err) {
+              PgString synth = pg_string_make(2, allocator);
+              PG_SLICE_AT(synth, 0) = '-';
+              PG_SLICE_AT(synth, 1) = PG_SLICE_AT(arg, j);
+              res.err_argv = synth;
+            } else {
+              res.err_argv = opt_name;
+            }
+            return res;
+          }
+        }
+      }
 
-  PgString exe_path = pg_self_exe_get_path();
-  if (pg_string_is_empty(exe_path)) {
-    return PG_OK(res, PgDebugInfoIterator, PgError);
-  }
+      continue;
+    }
 
-  PgString debug_path = pg_string_concat(exe_path, PG_S(".dSYM"), allocator);
-  debug_path = pg_path_join(debug_path, PG_S("Contents"), allocator);
-  debug_path = pg_path_join(debug_path, PG_S("Resources"), allocator);
-  debug_path = pg_path_join(debug_path, PG_S("DWARF"), allocator);
-  debug_path = pg_path_join(debug_path, pg_path_base_name(exe_path), allocator);
+    // Long option from there.
 
-  PG_RESULT(PgVirtualMemFile, PgError)
-  res_file = pg_virtual_mem_map_file(debug_path, PG_FILE_ACCESS_READ, false);
-  PG_IF_LET_ERR(err, res_file) {
-    return PG_ERR(err, PgDebugInfoIterator, PgError);
+    PgString opt_name = pg_string_trim_left(arg, '-');
+    PG_ASSERT(opt_name.len > 0);
+    PgError err = pg_cli_handle_long_option(opt_name, &res.options, desc_slice,
+                                            argv, &i, allocator);
+    if (0 != err) {
+      res.err = err;
+      res.err_argv = arg;
+      return res;
+    }
   }
-  res.file = PG_UNWRAP(res_file);
 
-  // Macho.
-  {
-    PG_RESULT(PgMacho, PgError) res_macho = pg_macho_parse(res.file.data);
-    PG_IF_LET_ERR(err, res_macho) {
-      return PG_ERR(err, PgDebugInfoIterator, PgError);
+  // Check that all required options are present.
+  PG_EACH_PTR(desc, &desc_slice) {
+    if (!desc->required) {
+      continue;
     }
 
-    res.macho = PG_UNWRAP(res_macho);
+    // Find by either the short or long name.
+    if (!pg_cli_options_find_by_name(res.options, desc->name_short,
+                                     desc->name_long)) {
+      res.err = PG_ERR_CLI_MISSING_REQUIRED_OPTION;
+      res.err_argv = pg_string_is_empty(desc->name_short) ? desc->name_long
+                                                          : desc->name_short;
+      return res;
+    }
   }
 
-  if (1) {
-    pg_self_debug_info_iterator_release(res);
-  }
-  return PG_ERR(PG_ERR_INVALID_VALUE, PgDebugInfoIterator, PgError);
+  return res;
 }
 
-// TODO: is pthread_yield defined on macos?
-[[maybe_unused]] static void pg_thread_yield() {}
-
-#endif
-
-[[maybe_unused]] [[nodiscard]]
-static PgError
-pg_http_server_handler(PgFileDescriptor sock, PgHttpServerOptions options,
-                       PgLogger *logger, PgAllocator *allocator) {
-  // TODO: Timeouts.
-
-  PgReader reader =
-      pg_reader_make_from_socket(sock, PG_HTTP_LINE_MAX_LEN, allocator);
-  PgHttpRequestReadResult res_req = pg_http_read_request(&reader, allocator);
-
-  if (res_req.err) {
-    pg_log(logger, PG_LOG_LEVEL_ERROR,
-           "http handler: failed to parse http request",
-           pg_log_c_err("err", res_req.err));
-    return res_req.err;
-  }
+[[maybe_unused]] [[nodiscard]] static PgString
+pg_cli_generate_help(PG_DYN(PgCliOptionDescription) descs, PgString exe_name,
+                     PgString description, PgString plain_arguments_description,
+                     PgAllocator *allocator) {
+  PG_DYN(u8) sb = {0};
+  PG_DYN_ENSURE_CAP(&sb, 1024 + exe_name.len + description.len, allocator);
 
-  if (!res_req.done) {
-    pg_log(logger, PG_LOG_LEVEL_ERROR,
-           "http handler: failed to read full http request",
-           pg_log_c_err("done", res_req.done));
-    return PG_ERR_EOF;
-  }
+  pg_string_builder_append_string(&sb, exe_name, allocator);
 
-  PgHttpRequest req = res_req.req;
+  PG_EACH_PTR(desc, &descs) {
+    pg_string_builder_append_string(&sb, PG_S(" "), allocator);
 
-  PgWriter writer =
-      pg_writer_make_from_socket(sock, PG_HTTP_LINE_MAX_LEN, allocator);
+    pg_string_builder_append_string(&sb, desc->required ? PG_S("(") : PG_S("["),
+                                    allocator);
 
-  PG_ASSERT(options.handler);
-  options.handler(req, &reader, &writer, logger, allocator, options.ctx);
+    if (!pg_string_is_empty(desc->name_short)) {
+      pg_string_builder_append_string(&sb, PG_S("-"), allocator);
+      pg_string_builder_append_string(&sb, desc->name_short, allocator);
+    }
+    if (!pg_string_is_empty(desc->name_long)) {
+      if (!pg_string_is_empty(desc->name_short)) {
+        pg_string_builder_append_string(&sb, PG_S("|"), allocator);
+      }
 
-  return 0;
-}
+      pg_string_builder_append_string(&sb, PG_S("--"), allocator);
+      pg_string_builder_append_string(&sb, desc->name_long, allocator);
+    }
 
-#ifndef PG_OS_WASM
-[[maybe_unused]]
-static PgError pg_http_server_start(PgHttpServerOptions options,
-                                    PgLogger *logger) {
-  PgError err = 0;
-  err = pg_process_avoid_child_zombies();
-  if (err) {
-    pg_log(logger, PG_LOG_LEVEL_ERROR,
-           "http server: failed to avoid child zombies",
-           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
-    return err;
-  }
+    if (!pg_string_is_empty(desc->value_name)) {
+      pg_string_builder_append_string(&sb, PG_S(" "), allocator);
+      pg_string_builder_append_string(&sb, desc->value_name, allocator);
+    }
 
-  PG_RESULT(PgFileDescriptor, PgError) res_create = pg_net_create_tcp_socket();
-  PG_IF_LET_ERR(err, res_create) {
-    pg_log(logger, PG_LOG_LEVEL_ERROR,
-           "http server: failed to create tcp socket",
-           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
-    return err;
+    pg_string_builder_append_string(&sb, desc->required ? PG_S(")") : PG_S("]"),
+                                    allocator);
   }
-  PgFileDescriptor server_socket = PG_UNWRAP(res_create);
 
-  err = pg_net_socket_enable_reuse(server_socket);
-  if (err) {
-    pg_log(logger, PG_LOG_LEVEL_ERROR,
-           "http server: failed to enable socket reuse",
-           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
-    goto end;
+  if (!pg_string_is_empty(plain_arguments_description)) {
+    pg_string_builder_append_string(&sb, PG_S(" "), allocator);
+    pg_string_builder_append_string(&sb, plain_arguments_description,
+                                    allocator);
   }
 
-  PgIpv4Address address = {.port = options.port};
-  err = pg_net_tcp_bind_ipv4(server_socket, address);
-  if (err) {
-    pg_log(logger, PG_LOG_LEVEL_ERROR, "http server: failed to bind tcp socket",
-           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
-    goto end;
+  pg_string_builder_append_string(&sb, PG_S("\n\n"), allocator);
+  pg_string_builder_append_string(&sb, description, allocator);
+  if (!pg_string_ends_with(description, PG_S("."))) {
+    pg_string_builder_append_string(&sb, PG_S("."), allocator);
   }
+  pg_string_builder_append_string(&sb, PG_S("\n"), allocator);
 
-  err = pg_net_tcp_listen(server_socket, options.listen_backlog);
-  if (err) {
-    pg_log(logger, PG_LOG_LEVEL_ERROR,
-           "http server: failed to listen on tcp socket",
-           pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
-    goto end;
-  }
+  if (!PG_SLICE_IS_EMPTY(descs)) {
+    pg_string_builder_append_string(&sb, PG_S("\nOPTIONS:\n"), allocator);
 
-  pg_log(logger, PG_LOG_LEVEL_INFO, "http server: listening",
-         pg_log_c_u16("port", options.port));
+    PG_EACH_PTR(desc, &descs) {
+      pg_string_builder_append_string(&sb, PG_S("    "), allocator);
+      if (!pg_string_is_empty(desc->name_short)) {
+        pg_string_builder_append_string(&sb, PG_S("-"), allocator);
+        pg_string_builder_append_string(&sb, desc->name_short, allocator);
+      }
+      if (!pg_string_is_empty(desc->name_long)) {
+        if (!pg_string_is_empty(desc->name_short)) {
+          pg_string_builder_append_string(&sb, PG_S(", "), allocator);
+        }
 
-  for (;;) {
-    PgIpv4AddressAcceptResult res_accept = pg_net_tcp_accept(server_socket);
-    if (res_accept.err) {
-      // TODO: Some errors are retryable.
-      err = res_accept.err;
-      pg_log(logger, PG_LOG_LEVEL_ERROR,
-             "http server: failed to accept new connection",
-             pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
-      goto end;
-    }
+        pg_string_builder_append_string(&sb, PG_S("--"), allocator);
+        pg_string_builder_append_string(&sb, desc->name_long, allocator);
+      }
+      if (!pg_string_is_empty(desc->value_name)) {
+        pg_string_builder_append_string(&sb, PG_S(" "), allocator);
+        pg_string_builder_append_string(&sb, desc->value_name, allocator);
+      }
 
-    PG_RESULT(u32, PgError) res_proc_dup = pg_process_dup();
-    PG_IF_LET_ERR(err, res_proc_dup) {
-      pg_log(
-          logger, PG_LOG_LEVEL_ERROR,
-          "http server: failed to spawn new process to handle new connection",
-          pg_log_c_u16("port", options.port), pg_log_c_err("err", err));
-      (void)pg_net_socket_close(res_accept.socket);
-      continue;
-    }
+      if (desc->required) {
+        pg_string_builder_append_string(&sb, PG_S("    [required]"), allocator);
+      }
 
-    u32 proc = PG_UNWRAP(res_proc_dup);
-    if (0 == proc) { // Child.
-      PgArena arena =
-          pg_arena_make_from_virtual_mem(options.http_handler_arena_mem);
-      PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
-      PgAllocator *allocator =
-          pg_arena_allocator_as_allocator(&arena_allocator);
+      if (!pg_string_is_empty(desc->description)) {
+        pg_string_builder_append_string(&sb, PG_S("\n        "), allocator);
+        pg_string_builder_append_string(&sb, desc->description, allocator);
+        if (!pg_string_ends_with(desc->description, PG_S("."))) {
+          pg_string_builder_append_string(&sb, PG_S("."), allocator);
+        }
+        pg_string_builder_append_string(&sb, PG_S("\n"), allocator);
+      }
 
-      (void)pg_http_server_handler(res_accept.socket, options, logger,
-                                   allocator);
-      exit(0);
+      pg_string_builder_append_string(&sb, PG_S("\n"), allocator);
     }
 
-    PG_ASSERT(proc); // Parent.
-
-    (void)pg_net_socket_close(res_accept.socket);
+    pg_string_builder_append_string(&sb, PG_S("\n"), allocator);
   }
 
-end:
-  (void)pg_net_socket_close(server_socket);
-  return err;
+  return PG_DYN_TO_SLICE(PgString, sb);
 }
-#endif
 
-[[maybe_unused]] [[nodiscard]] static PG_OPTION(PgAioEvent)
-    pg_aio_cqe_dequeue(PgRing *cqe) {
-  PG_OPTION(PgAioEvent) res = {0};
-  if (pg_ring_can_read_count(*cqe) < sizeof(PgAioEvent)) {
-    return res;
-  }
+[[maybe_unused]] [[nodiscard]] static PgError
+pg_cli_print_parse_err(PgCliParseResult res_parse, PgWriter *w,
+                       PgAllocator *allocator) {
+  switch (res_parse.err) {
+  case 0:
+    return (PgError){0};
 
-  PG_SLICE(u8) bytes = {.data = (u8 *)&res.value, .len = sizeof(PgAioEvent)};
-  PG_ASSERT(sizeof(PgAioEvent) == pg_ring_read_bytes(cqe, bytes));
+  case PG_ERR_CLI_MISSING_REQUIRED_OPTION:
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("Missing required CLI option "),
+                                       allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
+    break;
+  case PG_ERR_CLI_MISSING_REQUIRED_OPTION_VALUE:
+    PG_ERR_RETURN(pg_writer_write_full(
+        w, PG_S("Missing required value for CLI option"), allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
+    break;
+  case PG_ERR_CLI_UNKNOWN_OPTION:
+    PG_ERR_RETURN(pg_writer_write_full(
+        w, PG_S("Encountered unknown CLI option"), allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
+    break;
+  case PG_ERR_CLI_FORBIDEN_OPTION_VALUE:
+    PG_ERR_RETURN(pg_writer_write_full(
+        w, PG_S("Encountered forbidden value for CLI option"), allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
+    break;
+  case PG_ERR_CLI_MALFORMED_OPTION:
+    PG_ERR_RETURN(
+        pg_writer_write_full(w, PG_S("Malformed CLI option"), allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
+    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
+    break;
+  default:
+    PG_ERR_RETURN(pg_writer_write_full(
+        w, PG_S("Unknown CLI options parse error."), allocator));
+  }
 
-  res.has_value = true;
-  return res;
+  return pg_writer_flush(w, allocator);
 }
 
-typedef struct {
-  bool required;
-  // Name of the value e.g. `linker` for `-fuse-ld`.
-  // If non-empty: the option expects 1 or more value(s).
-  // It appears in the help message.
-  PgString value_name;
-  PgString name_short;
-  PgString name_long;
-  PgString description;
-} PgCliOptionDescription;
-PG_OPTION_DECL(PgCliOptionDescription);
-PG_DYN_DECL(PgCliOptionDescription);
-PG_SLICE_DECL(PgCliOptionDescription);
+#ifndef PG_OS_WASM
+[[maybe_unused]] static void pg_stack_trace_print_dwarf(u64 skip) {
+  static _Atomic PgOnce once = false;
+  static PgArena arena = {0};
+  static PG_DYN(PgDebugFunctionDeclaration) fns = {0};
 
-typedef struct {
-  PgCliOptionDescription description;
-  PG_DYN(PgString) values;
-  PgError err;
-} PgCliOption;
-PG_DYN_DECL(PgCliOption);
-PG_SLICE_DECL(PgCliOption);
-PG_RESULT_DECL(PgCliOption, PgError);
-PG_OPTION_DECL(PgCliOption);
-PG_RESULT_DECL(PG_OPTION(PgCliOption), PgError);
+  if (pg_once_do(&once)) {
+    arena = pg_arena_make_from_virtual_mem(512 * PG_KiB);
+    PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+    PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
 
-typedef struct {
-  PG_DYN(PgString) plain_arguments;
-  PG_DYN(PgCliOption) options;
+    PG_RESULT(PgDebugInfoIterator, PgError)
+    res_debug = pg_self_debug_info_iterator_make(allocator);
+    PG_IF_LET_ERR(err, res_debug) {
+      PG_UNUSED(err);
+      goto end;
+    }
+    PgDebugInfoIterator it = PG_UNWRAP(res_debug);
 
-  // Error reporting.
-  PgError err;
-  PgString err_argv;
-} PgCliParseResult;
+    PG_RESULT(PG_DYN(PgDebugFunctionDeclaration), PgError)
+    res_fns = pg_dwarf_collect_functions(&it, allocator);
+    PG_IF_LET_ERR(err, res_fns) {
+      PG_UNUSED(err);
+      goto end_debug;
+    }
+    fns = PG_UNWRAP(res_fns);
+    goto end;
 
-[[nodiscard]] static bool pg_cli_is_short_option(PgString s) {
-  PG_OPTION(PgString) dash_opt = pg_string_consume_rune(s, '-');
-  if (!dash_opt.has_value) {
-    return false;
+  end_debug:
+    pg_self_debug_info_iterator_release(it);
+  end:
+    pg_once_mark_as_done(&once);
   }
 
-  // Is long?
-  s = dash_opt.value;
-  dash_opt = pg_string_consume_rune(s, '-');
-  return !dash_opt.has_value;
-}
+  {
+    u64 stack_trace[PG_STACK_TRACE_MAX] = {0};
+    u64 stack_trace_len = pg_fill_stack_trace(skip, 0, stack_trace);
 
-[[nodiscard]] static bool pg_cli_is_no_option(PgString s) {
-  PG_OPTION(PgString) dash_opt = pg_string_consume_rune(s, '-');
-  return !dash_opt.has_value;
-}
+    fprintf(stderr, " Stack trace:\n");
 
-[[nodiscard]] static PG_OPTION(PgCliOptionDescription)
-    pg_cli_desc_find_by_name(PG_SLICE(PgCliOptionDescription) descs,
-                             PgString name) {
-  PG_OPTION(PgCliOptionDescription) res = {0};
+    for (u32 i = 0; i < stack_trace_len; i++) {
+      u64 addr = PG_C_ARRAY_AT(stack_trace, PG_STACK_TRACE_MAX, i);
+      PG_OPTION(PgDebugFunctionDeclaration)
+      fn_opt = pg_dwarf_find_function_by_addr(fns, addr);
 
-  PG_EACH_PTR(it, &descs) {
-    if (pg_string_eq(it->name_long, name) ||
-        pg_string_eq(it->name_short, name)) {
-      res.has_value = true;
-      res.value = *it;
-      return res;
+      fprintf(stderr, "[%u] at: %#" PRIx64, i, addr);
+      if (fn_opt.has_value) {
+        PgDebugFunctionDeclaration fn = fn_opt.value;
+        fprintf(stderr, " %.*s", (i32)fn.name.len, fn.name.data);
+        if (pg_string_eq(fn.name, PG_S("main"))) {
+          i = stack_trace_len; // End.
+        }
+      }
+      fprintf(stderr, "\n");
     }
   }
-
-  return res;
 }
+#endif
 
-[[nodiscard]] static PgCliOption *
-pg_cli_options_find_by_name(PG_DYN(PgCliOption) options, PgString name_short,
-                            PgString name_long) {
-  PG_EACH_PTR(it, &options) {
-    if (pg_string_eq(it->description.name_long, name_long) ||
-        pg_string_eq(it->description.name_short, name_short)) {
-      return it;
-    }
-  }
-
-  return nullptr;
-}
+#define PG_TEST(F)                                                             \
+  (PgTest) { .name = PG_S("" #F ""), .fn = F }
 
-[[nodiscard]] static PgError
-pg_cli_handle_short_option(PgString opt_name, bool with_opt_value_allowed,
-                           PG_DYN(PgCliOption) * options,
-                           PG_SLICE(PgCliOptionDescription) descs, char **argv,
-                           u64 *argv_idx, PgAllocator *allocator) {
-  PG_OPTION(PgCliOptionDescription)
-  desc_has_value = pg_cli_desc_find_by_name(descs, opt_name);
-  if (!desc_has_value.has_value) {
-    return PG_ERR_CLI_UNKNOWN_OPTION;
-  }
-  PgCliOptionDescription desc = desc_has_value.value;
+#ifndef PG_OS_WASM
+#ifndef PG_TEST_TIMEOUT_DEFAULT_NS
+#define PG_TEST_TIMEOUT_DEFAULT_NS (60 * PG_Seconds)
+#endif
 
-  if (!pg_string_is_empty(desc.value_name) && !with_opt_value_allowed) {
-    return PG_ERR_CLI_FORBIDEN_OPTION_VALUE;
-  }
+// How many of the slowest tests are listed in the summary (all in verbose
+// mode).
+#define PG_TEST_SUMMARY_SLOWEST_COUNT 10
 
-  PgString opt_value = {0};
-  if (!pg_string_is_empty(desc.value_name)) {
-    // A value is expected in the next `argv` slot.
-    *argv_idx += 1;
-    opt_value = pg_cstr_to_string(argv[*argv_idx]);
+static void pg_test_result_print(PgTestResult result, bool verbose) {
+  if (PG_TEST_OUTCOME_PASS == result.outcome && !verbose) {
+    return;
   }
 
-  if (!pg_string_is_empty(desc.value_name) &&
-      (0 == opt_value.len || !pg_cli_is_no_option(opt_value))) {
-    return PG_ERR_CLI_MISSING_REQUIRED_OPTION_VALUE;
+  printf("RUN\t%.*s\t", (i32)result.test.name.len, result.test.name.data);
+  switch (result.outcome) {
+  case PG_TEST_OUTCOME_PASS:
+    printf("OK ");
+    break;
+  case PG_TEST_OUTCOME_FAIL:
+    printf("FAIL (exit status %d) ", result.exit_status);
+    break;
+  case PG_TEST_OUTCOME_SIGNAL:
+    printf("FAIL (signal %d: %s) ", result.signal, strsignal(result.signal));
+    break;
+  case PG_TEST_OUTCOME_TIMEOUT:
+    printf("TIMEOUT ");
+    break;
+  default:
+    PG_ASSERT(0);
   }
+  pg_duration_print(stdout,
+                    pg_time_ns_to_human_readable_duration(result.duration_ns));
+  printf("\n");
 
-  // Find by the short name.
-  PgCliOption *opt_existing =
-      pg_cli_options_find_by_name(*options, desc.name_short, PG_S(""));
-  if (opt_existing) {
-    if (pg_string_is_empty(desc.value_name)) {
-      // Option already exists (without value), do not add it again.
-      return 0;
+  if (PG_TEST_OUTCOME_PASS != result.outcome && result.output.len > 0) {
+    printf("%.*s", (i32)result.output.len, result.output.data);
+    if (!pg_string_ends_with(result.output, PG_S("\n"))) {
+      printf("\n");
     }
-
-    // With value.
-
-    PG_DYN_PUSH(&opt_existing->values, opt_value, allocator);
-    return 0;
   }
+  fflush(stdout);
+}
 
-  // Add the new option.
-  PgCliOption opt = {.description = desc};
-  if (!pg_string_is_empty(desc.value_name)) {
-    PG_DYN_PUSH(&opt.values, opt_value, allocator);
-  }
+[[nodiscard]] static PgTestResult pg_test_run_in_process(PgTest test) {
+  u64 start = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  test.fn();
+  u64 end = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
 
-  PG_DYN_PUSH(options, opt, allocator);
-  return 0;
+  return (PgTestResult){.test = test, .duration_ns = end - start};
 }
 
-[[nodiscard]] static PgError
-pg_cli_handle_long_option(PgString opt_name, PG_DYN(PgCliOption) * options,
-                          PG_SLICE(PgCliOptionDescription) descs, char **argv,
-                          u64 *argv_idx, PgAllocator *allocator) {
-  PgString opt_value = {0};
-  PgStringCut cut = pg_string_cut_rune(opt_name, '=');
-  if (cut.has_value) {
-    opt_name = cut.left;
-    opt_value = cut.right;
-  }
-
-  PG_OPTION(PgCliOptionDescription)
-  desc_has_value = pg_cli_desc_find_by_name(descs, opt_name);
-  if (!desc_has_value.has_value) {
-    return PG_ERR_CLI_UNKNOWN_OPTION;
+#ifdef PG_OS_UNIX
+typedef struct {
+  PgProcess process;
+  // Drained while the test runs so that it never blocks on a full pipe.
+  PG_DYN(u8) output;
+  u64 start_ns;
+  u64 test_idx;
+  bool running;
+  PG_PAD(7);
+} PgTestWorker;
+
+// Run the test in a forked child, with stdout and stderr going to one pipe.
+[[nodiscard]] static PG_RESULT(PgProcess, PgError) pg_test_spawn(PgTest test) {
+  int fds[2] = {0};
+  if (-1 == pipe(fds)) {
+    return PG_ERR(errno, PgProcess, PgError);
   }
-  PgCliOptionDescription desc = desc_has_value.value;
 
-  // Find the value if one is expected.
-  // Could be after the `=` in the same `argv` slot, or in the next argv slot,
-  // if there is no `=`.
-  // E.g.: `--foo=bar`, `--foo bar`, `--foo=--bar`.
-  // But not: `--foo=` , `--foo --bar`.
-  {
-    bool value_expected = !pg_string_is_empty(desc.value_name);
-    // Reject `--foo=`.
-    if (value_expected && cut.has_value && pg_string_is_empty(opt_value)) {
-      return PG_ERR_CLI_MISSING_REQUIRED_OPTION_VALUE;
-    }
+  // Otherwise buffered output would be written by both processes.
+  fflush(stdout);
+  fflush(stderr);
 
-    if (value_expected && pg_string_is_empty(opt_value)) {
-      // A value is expected in the next `argv` slot.
-      *argv_idx += 1;
-      opt_value = pg_cstr_to_string(argv[*argv_idx]);
-    }
-    bool is_value_suitable =
-        !pg_string_is_empty(opt_value) &&
-        (cut.has_value ? true : pg_cli_is_no_option(opt_value));
-    if (value_expected && !is_value_suitable) {
-      return PG_ERR_CLI_MISSING_REQUIRED_OPTION_VALUE;
-    }
+  int pid = fork();
+  if (-1 == pid) {
+    PgError err = (PgError)errno;
+    close(fds[PG_PIPE_READ]);
+    close(fds[PG_PIPE_WRITE]);
+    return PG_ERR(err, PgProcess, PgError);
   }
 
-  // Find by the long name.
-  PgCliOption *opt_existing =
-      pg_cli_options_find_by_name(*options, PG_S(""), desc.name_long);
-  if (opt_existing) {
-    if (pg_string_is_empty(desc.value_name)) {
-      // Option already exists (without value), do not add it again.
-      return 0;
-    }
+  if (0 == pid) { // Child.
+    // Own process group, so that on timeout the processes the test started
+    // are killed along with it.
+    (void)setpgid(0, 0);
+    close(fds[PG_PIPE_READ]);
+    PG_ASSERT(-1 != dup2(fds[PG_PIPE_WRITE], STDOUT_FILENO));
+    PG_ASSERT(-1 != dup2(fds[PG_PIPE_WRITE], STDERR_FILENO));
+    close(fds[PG_PIPE_WRITE]);
 
-    // With value.
+    test.fn();
 
-    PG_DYN_PUSH(&opt_existing->values, opt_value, allocator);
-    return 0;
+    fflush(stdout);
+    fflush(stderr);
+    _exit(0);
   }
 
-  // Add the new option.
-  PgCliOption opt = {.description = desc};
-  if (!pg_string_is_empty(desc.value_name)) {
-    PG_DYN_PUSH(&opt.values, opt_value, allocator);
-  }
+  close(fds[PG_PIPE_WRITE]);
+  // Also from the parent, to not race with the child: the group must exist by
+  // the time it may be killed.
+  (void)setpgid(pid, pid);
 
-  PG_DYN_PUSH(options, opt, allocator);
-  return 0;
+  PgProcess res = {0};
+  res.pid = (u64)pid;
+  res.stdout_pipe.fd = fds[PG_PIPE_READ];
+  return PG_OK(res, PgProcess, PgError);
 }
 
-static void pg_cli_inject_help_option(PG_DYN(PgCliOptionDescription) * descs,
-                                      PgAllocator *allocator) {
-  PgCliOptionDescription desc = {
-      .name_short = PG_S("h"),
-      .name_long = PG_S("help"),
-      .description = PG_S("Print this help message"),
+[[nodiscard]] static PgTestResult
+pg_test_worker_finish(PgTestWorker *worker, PgTest test, bool timed_out,
+                      PgAllocator *allocator) {
+  PG_ASSERT(worker->running);
+
+  u64 now = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  if (timed_out) {
+    (void)kill(-(pid_t)worker->process.pid, SIGKILL);
+  }
+
+  // The output has already been drained, only reap the child.
+  close(worker->process.stdout_pipe.fd);
+  worker->process.stdout_pipe.fd = 0;
+  worker->running = false;
+
+  PgTestResult res = {
+      .test = test,
+      .output = PG_DYN_TO_SLICE(PgString, worker->output),
+      .duration_ns = now - worker->start_ns,
   };
 
-  PG_DYN_PUSH(descs, desc, allocator);
-}
+  PG_RESULT(PgProcessStatus, PgError)
+  res_wait = pg_process_wait(worker->process, 0, 0, allocator);
+  PG_IF_LET_ERR(err, res_wait) {
+    fprintf(stderr, "failed to wait for test process: %" PRIu64 "\n", err);
+    res.outcome = PG_TEST_OUTCOME_FAIL;
+    res.exit_status = -1;
+    return res;
+  }
+  PgProcessStatus status = PG_UNWRAP(res_wait);
 
-[[maybe_unused]] [[nodiscard]] static PgCliParseResult
-pg_cli_parse(PG_DYN(PgCliOptionDescription) * descs, int argc, char *argv[],
-             PgAllocator *allocator) {
-  PgCliParseResult res = {0};
+  if (timed_out) {
+    res.outcome = PG_TEST_OUTCOME_TIMEOUT;
+  } else if (status.signaled) {
+    res.outcome = PG_TEST_OUTCOME_SIGNAL;
+    res.signal = status.signal;
+  } else if (0 != status.exit_status) {
+    res.outcome = PG_TEST_OUTCOME_FAIL;
+    res.exit_status = status.exit_status;
+  }
 
-  pg_cli_inject_help_option(descs, allocator);
-  PG_SLICE(PgCliOptionDescription)
-  desc_slice = PG_DYN_TO_SLICE(PG_SLICE(PgCliOptionDescription), *descs);
+  return res;
+}
 
-  for (u64 i = 1 /* Skip exe name */; i < (u64)argc; i++) {
-    PgString arg = pg_cstr_to_string(argv[i]);
+// The output is only needed for the report, and can be big: it is released
+// right away.
+static void pg_test_result_record(PG_DYN(PgTestResult) * results,
+                                  PgTestResult result, bool verbose,
+                                  PgAllocator *output_allocator) {
+  pg_test_result_print(result, verbose);
+
+  pg_free(output_allocator, result.output.data);
+  result.output = (PgString){0};
+  *PG_DYN_PUSH_WITHIN_CAPACITY(results) = result;
+}
+
+// Run each test in its own child process, at most `jobs` at a time, so that
+// tests run in parallel and a crash only takes down its own test.
+// The output of each test is accumulated with `output_allocator`, which should
+// be able to grow as much as the most verbose test needs e.g. the heap.
+[[nodiscard]] static PG_DYN(PgTestResult)
+    pg_run_tests_forked(PG_SLICE(PgTest) tests, u64 jobs, u64 timeout_ns,
+                        bool verbose, PgAllocator *output_allocator,
+                        PgAllocator *allocator) {
+  PG_ASSERT(jobs > 0);
+
+  PG_DYN(PgTestResult) results = {0};
+  PG_DYN_ENSURE_CAP(&results, tests.len, allocator);
+
+  PgTestWorker *workers =
+      pg_alloc(allocator, sizeof(PgTestWorker), _Alignof(PgTestWorker), jobs);
+  struct pollfd *pollfds = pg_alloc(allocator, sizeof(struct pollfd),
+                                    _Alignof(struct pollfd), jobs);
+  u64 *pollfds_workers = pg_alloc(allocator, sizeof(u64), _Alignof(u64), jobs);
+  PG_ASSERT(workers);
+  PG_ASSERT(pollfds);
+  PG_ASSERT(pollfds_workers);
+
+  u64 tests_next = 0;
+  u64 running = 0;
+
+  while (tests_next < tests.len || running > 0) {
+    for (u64 i = 0; i < jobs && tests_next < tests.len; i++) {
+      PgTestWorker *worker = &workers[i];
+      if (worker->running) {
+        continue;
+      }
 
-    // Plain argument.
-    if (pg_cli_is_no_option(arg)) {
-      PG_DYN_PUSH(&res.plain_arguments, arg, allocator);
-      continue;
-    }
+      PgTest test = PG_SLICE_AT(tests, tests_next);
+      *worker = (PgTestWorker){
+          .test_idx = tests_next,
+          .start_ns =
+              PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)),
+      };
+      tests_next += 1;
 
-    // Treat all remaining arguments as plain after `--`.
-    if (pg_string_eq(arg, PG_S("--"))) {
-      for (u64 j = i + 1; j < (u64)argc; j++) {
-        PgString arg = pg_cstr_to_string(argv[j]);
-        PG_DYN_PUSH(&res.plain_arguments, arg, allocator);
+      PG_RESULT(PgProcess, PgError) res_spawn = pg_test_spawn(test);
+      PG_IF_LET_ERR(err, res_spawn) {
+        fprintf(stderr, "failed to spawn test %.*s: %" PRIu64 "\n",
+                (i32)test.name.len, test.name.data, err);
+        exit(1);
       }
-      return res;
+      worker->process = PG_UNWRAP(res_spawn);
+      worker->running = true;
+      running += 1;
     }
 
-    // Error if the option name starts with more than 2 `-` e.g. `---a` or it
-    // only contains `-` e.g. `-`, `--`.
-    if (pg_string_starts_with(arg, PG_S("---")) ||
-        pg_string_eq(arg, PG_S("-"))) {
-      res.err = PG_ERR_CLI_MALFORMED_OPTION;
-      res.err_argv = arg;
-      return res;
+    u64 now = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    nfds_t pollfds_len = 0;
+    u64 poll_timeout_ns = timeout_ns;
+    for (u64 i = 0; i < jobs; i++) {
+      PgTestWorker *worker = &workers[i];
+      if (!worker->running) {
+        continue;
+      }
+
+      u64 elapsed = now - worker->start_ns;
+      poll_timeout_ns =
+          PG_MIN(poll_timeout_ns, elapsed < timeout_ns ? timeout_ns - elapsed
+                                                        : 0);
+
+      pollfds_workers[pollfds_len] = i;
+      pollfds[pollfds_len++] = (struct pollfd){
+          .fd = worker->process.stdout_pipe.fd,
+          .events = POLLIN,
+      };
     }
 
-    if (pg_cli_is_short_option(arg)) {
-      PgString opt_name = pg_string_trim_left(arg, '-');
-      PG_ASSERT(opt_name.len > 0);
+    i32 res_poll = poll(
+        pollfds, pollfds_len,
+        (i32)PG_MIN(pg_div_ceil(poll_timeout_ns, PG_Milliseconds), INT32_MAX));
+    if (-1 == res_poll && EINTR != errno) {
+      fprintf(stderr, "failed to poll tests: %d\n", errno);
+      exit(1);
+    }
 
-      if (1 == opt_name.len) {
-        PgError err = pg_cli_handle_short_option(
-            opt_name, true, &res.options, desc_slice, argv, &i, allocator);
-        if (0 != err) {
-          res.err = err;
-          // Best effort reporting.
-          res.err_argv = (PG_ERR_CLI_UNKNOWN_OPTION == err) ? arg : opt_name;
-          return res;
-        }
-      } else {
-        // Handle coalesced short options, forbid option values.
-        // This means that `./a.out -vH foo` will be parsed as
-        // options: `-v`, `-H`, plain arguments: `foo`.
-        // Assume ASCII.
-        for (u64 j = 1; j < arg.len; j++) {
-          PgString opt_name = {.data = PG_SLICE_AT_PTR(&arg, j), .len = 1};
-          PgError err = pg_cli_handle_short_option(
-              opt_name, false, &res.options, desc_slice, argv, &i, allocator);
-          if (0 != err) {
-            res.err = err;
-            // Best effort reporting.
+    for (u64 i = 0; res_poll > 0 && i < pollfds_len; i++) {
+      struct pollfd pollfd = pollfds[i];
+      if (0 == pollfd.revents) {
+        continue;
+      }
 
-            if (PG_ERR_CLI_UNKNOWN_OPTION == err) {
-              PgString synth = pg_string_make(2, allocator);
-              PG_SLICE_AT(synth, 0) = '-';
-              PG_SLICE_AT(synth, 1) = PG_SLICE_AT(arg, j);
-              res.err_argv = synth;
-            } else {
-              res.err_argv = opt_name;
-            }
-            return res;
-          }
-        }
+      PgTestWorker *worker = &workers[pollfds_workers[i]];
+      u8 tmp[4096] = {0};
+      ssize_t read_n = 0;
+      do {
+        read_n = read(pollfd.fd, tmp, PG_STATIC_ARRAY_LEN(tmp));
+      } while (-1 == read_n && EINTR == errno);
+
+      if (read_n > 0) {
+        PgString actually_read = {.data = tmp, .len = (u64)read_n};
+        PG_DYN_APPEND_SLICE(&worker->output, actually_read, output_allocator);
+        continue;
       }
 
-      continue;
+      // EOF: the test process (and its own children) are done.
+      PgTestResult result = pg_test_worker_finish(
+          worker, PG_SLICE_AT(tests, worker->test_idx), false, allocator);
+      pg_test_result_record(&results, result, verbose, output_allocator);
+      running -= 1;
     }
 
-    // Long option from there.
+    now = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    for (u64 i = 0; i < jobs; i++) {
+      PgTestWorker *worker = &workers[i];
+      if (!worker->running || now - worker->start_ns < timeout_ns) {
+        continue;
+      }
 
-    PgString opt_name = pg_string_trim_left(arg, '-');
-    PG_ASSERT(opt_name.len > 0);
-    PgError err = pg_cli_handle_long_option(opt_name, &res.options, desc_slice,
-                                            argv, &i, allocator);
-    if (0 != err) {
-      res.err = err;
-      res.err_argv = arg;
-      return res;
+      PgTestResult result = pg_test_worker_finish(
+          worker, PG_SLICE_AT(tests, worker->test_idx), true, allocator);
+      pg_test_result_record(&results, result, verbose, output_allocator);
+      running -= 1;
     }
   }
 
-  // Check that all required options are present.
-  PG_EACH_PTR(desc, &desc_slice) {
-    if (!desc->required) {
-      continue;
-    }
+  return results;
+}
+#endif
 
-    // Find by either the short or long name.
-    if (!pg_cli_options_find_by_name(res.options, desc->name_short,
-                                     desc->name_long)) {
-      res.err = PG_ERR_CLI_MISSING_REQUIRED_OPTION;
-      res.err_argv = pg_string_is_empty(desc->name_short) ? desc->name_long
-                                                          : desc->name_short;
-      return res;
-    }
-  }
+[[maybe_unused]] static void pg_run_tests(int argc, char **argv,
+                                          PG_SLICE(PgTest) tests) {
+  PgArena arena = pg_arena_make_from_virtual_mem(1 * PG_MiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
 
-  return res;
-}
+  PG_ASSERT(argc >= 1);
+  PgString exe = pg_cstr_to_string(argv[0]);
 
-[[maybe_unused]] [[nodiscard]] static PgString
-pg_cli_generate_help(PG_DYN(PgCliOptionDescription) descs, PgString exe_name,
-                     PgString description, PgString plain_arguments_description,
-                     PgAllocator *allocator) {
-  PG_DYN(u8) sb = {0};
-  PG_DYN_ENSURE_CAP(&sb, 1024 + exe_name.len + description.len, allocator);
+  PgString description = PG_S("Run tests.");
+  PG_DYN(PgCliOptionDescription) descs = {0};
+  PG_DYN_PUSH(&descs,
+              ((PgCliOptionDescription){
+                  .name_short = PG_S("v"),
+                  .name_long = PG_S("verbose"),
+                  .description = PG_S("Verbose mode"),
+              }),
+              allocator);
+  PG_DYN_PUSH(&descs,
+              ((PgCliOptionDescription){
+                  .name_short = PG_S("r"),
+                  .name_long = PG_S("run"),
+                  .description = PG_S("Run only these tests (prefix-based)"),
+                  .value_name = PG_S("prefix"),
+              }),
+              allocator);
+  PG_DYN_PUSH(&descs,
+              ((PgCliOptionDescription){
+                  .name_short = PG_S("x"),
+                  .name_long = PG_S("exclude"),
+                  .description = PG_S(
+                      "Skip the tests whose name contains this pattern"),
+                  .value_name = PG_S("pattern"),
+              }),
+              allocator);
+  PG_DYN_PUSH(&descs,
+              ((PgCliOptionDescription){
+                  .name_short = PG_S("j"),
+                  .name_long = PG_S("jobs"),
+                  .description = PG_S("Maximum number of tests running at "
+                                      "the same time (default: CPU count)"),
+                  .value_name = PG_S("count"),
+              }),
+              allocator);
+  PG_DYN_PUSH(&descs,
+              ((PgCliOptionDescription){
+                  .name_short = PG_S("t"),
+                  .name_long = PG_S("timeout"),
+                  .description = PG_S("Per-test timeout (default: 60)"),
+                  .value_name = PG_S("seconds"),
+              }),
+              allocator);
+  PG_DYN_PUSH(&descs,
+              ((PgCliOptionDescription){
+                  .name_short = PG_S("i"),
+                  .name_long = PG_S("in-process"),
+                  .description = PG_S("Run the tests sequentially in this "
+                                      "process e.g. to use a debugger"),
+              }),
+              allocator);
 
-  pg_string_builder_append_string(&sb, exe_name, allocator);
+  PgCliParseResult res_cli_parse = pg_cli_parse(&descs, argc, argv, allocator);
+  if (res_cli_parse.err) {
+    PgWriter w = pg_writer_make_from_file_descriptor(pg_os_stderr(), 1 * PG_KiB,
+                                                     allocator);
 
-  PG_EACH_PTR(desc, &descs) {
-    pg_string_builder_append_string(&sb, PG_S(" "), allocator);
+    PG_ASSERT(0 == pg_cli_print_parse_err(res_cli_parse, &w, allocator));
+    exit(1);
+  }
+  if (res_cli_parse.plain_arguments.len > 0) {
+    fprintf(stderr, "Unexpected plain arguments\n");
+    exit(1);
+  }
+
+  bool cli_verbose = false;
+  bool cli_in_process = false;
+  PgString cli_run = {0};
+  PG_SLICE(PgString) cli_excludes = {0};
+  u64 cli_jobs = pg_os_get_cpu_count();
+  u64 cli_timeout_ns = PG_TEST_TIMEOUT_DEFAULT_NS;
+
+  PG_EACH_PTR(opt, &res_cli_parse.options) {
+    if (pg_string_eq(opt->description.name_long, PG_S("verbose"))) {
+      cli_verbose = true;
+    } else if (pg_string_eq(opt->description.name_long, PG_S("in-process"))) {
+      cli_in_process = true;
+    } else if (pg_string_eq(opt->description.name_long, PG_S("run"))) {
+      if (1 != opt->values.len) {
+        fprintf(stderr,
+                "Only one value expected for -r,--run, got %" PRIu64 "\n",
+                opt->values.len);
+      }
+      cli_run = PG_SLICE_AT(opt->values, 0);
+    } else if (pg_string_eq(opt->description.name_long, PG_S("exclude"))) {
+      cli_excludes = PG_DYN_TO_SLICE(PG_SLICE(PgString), opt->values);
+    } else if (pg_string_eq(opt->description.name_long, PG_S("jobs")) ||
+               pg_string_eq(opt->description.name_long, PG_S("timeout"))) {
+      PgParseNumberResult res_parse =
+          pg_string_parse_u64(PG_SLICE_AT(opt->values, 0), 10, true);
+      u64 timeout_ns = 0;
+      if (!res_parse.present || !pg_string_is_empty(res_parse.remaining) ||
+          0 == res_parse.n ||
+          ckd_mul(&timeout_ns, res_parse.n, PG_Seconds)) {
+        fprintf(stderr, "Invalid value for --%.*s\n",
+                (i32)opt->description.name_long.len,
+                opt->description.name_long.data);
+        exit(1);
+      }
+
+      if (pg_string_eq(opt->description.name_long, PG_S("jobs"))) {
+        cli_jobs = res_parse.n;
+      } else {
+        cli_timeout_ns = timeout_ns;
+      }
+    } else if (pg_string_eq(opt->description.name_long, PG_S("help"))) {
+      PgString help =
+          pg_cli_generate_help(descs, exe, description, PG_S(""), allocator);
+      printf("%.*s", (i32)help.len, help.data);
 
-    pg_string_builder_append_string(&sb, desc->required ? PG_S("(") : PG_S("["),
-                                    allocator);
+      exit(0);
+    }
+  }
 
-    if (!pg_string_is_empty(desc->name_short)) {
-      pg_string_builder_append_string(&sb, PG_S("-"), allocator);
-      pg_string_builder_append_string(&sb, desc->name_short, allocator);
+  PG_DYN(PgTest) selected = {0};
+  PG_EACH_PTR(t, &tests) {
+    if (!pg_string_starts_with(t->name, cli_run)) {
+      continue;
     }
-    if (!pg_string_is_empty(desc->name_long)) {
-      if (!pg_string_is_empty(desc->name_short)) {
-        pg_string_builder_append_string(&sb, PG_S("|"), allocator);
-      }
 
-      pg_string_builder_append_string(&sb, PG_S("--"), allocator);
-      pg_string_builder_append_string(&sb, desc->name_long, allocator);
+    bool excluded = false;
+    PG_EACH_PTR(pattern, &cli_excludes) {
+      excluded |= pg_string_contains(t->name, *pattern);
+    }
+    if (excluded) {
+      continue;
     }
 
-    if (!pg_string_is_empty(desc->value_name)) {
-      pg_string_builder_append_string(&sb, PG_S(" "), allocator);
-      pg_string_builder_append_string(&sb, desc->value_name, allocator);
+    PG_DYN_PUSH(&selected, *t, allocator);
+  }
+
+  PG_DYN(PgTestResult) results = {0};
+#ifdef PG_OS_UNIX
+  if (!cli_in_process) {
+    results = pg_run_tests_forked(PG_DYN_TO_SLICE(PG_SLICE(PgTest), selected),
+                                  PG_MIN(cli_jobs, PG_MAX(selected.len, 1)),
+                                  cli_timeout_ns, cli_verbose,
+                                  pg_heap_allocator(), allocator);
+  }
+#else
+  cli_in_process = true;
+#endif
+  if (cli_in_process) {
+    PG_DYN_ENSURE_CAP(&results, selected.len, allocator);
+
+    PG_EACH_PTR(t, &selected) {
+      if (cli_verbose) {
+        printf("RUN\t%.*s\t", (i32)t->name.len, t->name.data);
+        fflush(stdout);
+      }
+      // A failing test aborts the whole run.
+      PgTestResult result = pg_test_run_in_process(*t);
+      *PG_DYN_PUSH_WITHIN_CAPACITY(&results) = result;
+      if (cli_verbose) {
+        printf("OK ");
+        pg_duration_print(
+            stdout, pg_time_ns_to_human_readable_duration(result.duration_ns));
+        printf("\n");
+      }
     }
+  }
 
-    pg_string_builder_append_string(&sb, desc->required ? PG_S(")") : PG_S("]"),
-                                    allocator);
+  u64 failed = 0;
+  PG_EACH_PTR(result, &results) {
+    failed += PG_TEST_OUTCOME_PASS != result->outcome;
   }
 
-  if (!pg_string_is_empty(plain_arguments_description)) {
-    pg_string_builder_append_string(&sb, PG_S(" "), allocator);
-    pg_string_builder_append_string(&sb, plain_arguments_description,
-                                    allocator);
+  // Slowest first.
+  for (u64 i = 1; i < results.len; i++) {
+    PgTestResult x = PG_SLICE_AT(results, i);
+    u64 j = i;
+    for (; j > 0 && PG_SLICE_AT(results, j - 1).duration_ns < x.duration_ns;
+         j--) {
+      PG_SLICE_AT(results, j) = PG_SLICE_AT(results, j - 1);
+    }
+    PG_SLICE_AT(results, j) = x;
   }
 
-  pg_string_builder_append_string(&sb, PG_S("\n\n"), allocator);
-  pg_string_builder_append_string(&sb, description, allocator);
-  if (!pg_string_ends_with(description, PG_S("."))) {
-    pg_string_builder_append_string(&sb, PG_S("."), allocator);
+  u64 slowest_count = cli_verbose
+                          ? results.len
+                          : PG_MIN(results.len, PG_TEST_SUMMARY_SLOWEST_COUNT);
+  if (slowest_count > 0) {
+    printf("\nSlowest:\n");
+  }
+  for (u64 i = 0; i < slowest_count; i++) {
+    PgTestResult result = PG_SLICE_AT(results, i);
+    printf("  %.*s\t", (i32)result.test.name.len, result.test.name.data);
+    pg_duration_print(stdout,
+                      pg_time_ns_to_human_readable_duration(result.duration_ns));
+    printf("%s\n", PG_TEST_OUTCOME_PASS == result.outcome ? "" : "\tFAIL");
   }
-  pg_string_builder_append_string(&sb, PG_S("\n"), allocator);
 
-  if (!PG_SLICE_IS_EMPTY(descs)) {
-    pg_string_builder_append_string(&sb, PG_S("\nOPTIONS:\n"), allocator);
+  printf("\n%" PRIu64 " passed, %" PRIu64 " failed, %" PRIu64 " skipped\n",
+         results.len - failed, failed, tests.len - selected.len);
+  fflush(stdout);
 
-    PG_EACH_PTR(desc, &descs) {
-      pg_string_builder_append_string(&sb, PG_S("    "), allocator);
-      if (!pg_string_is_empty(desc->name_short)) {
-        pg_string_builder_append_string(&sb, PG_S("-"), allocator);
-        pg_string_builder_append_string(&sb, desc->name_short, allocator);
-      }
-      if (!pg_string_is_empty(desc->name_long)) {
-        if (!pg_string_is_empty(desc->name_short)) {
-          pg_string_builder_append_string(&sb, PG_S(", "), allocator);
-        }
+  if (failed > 0) {
+    exit(1);
+  }
+}
 
-        pg_string_builder_append_string(&sb, PG_S("--"), allocator);
-        pg_string_builder_append_string(&sb, desc->name_long, allocator);
-      }
-      if (!pg_string_is_empty(desc->value_name)) {
-        pg_string_builder_append_string(&sb, PG_S(" "), allocator);
-        pg_string_builder_append_string(&sb, desc->value_name, allocator);
-      }
+#define PG_BENCH(F)                                                            \
+  (PgBench) { .name = PG_S("" #F ""), .fn = F }
 
-      if (desc->required) {
-        pg_string_builder_append_string(&sb, PG_S("    [required]"), allocator);
-      }
+// Prevent the compiler from optimizing away a value computed by a benchmark.
+[[maybe_unused]] static void pg_bench_do_not_optimize(void *p) {
+  __asm__ volatile("" : : "r"(p) : "memory");
+}
 
-      if (!pg_string_is_empty(desc->description)) {
-        pg_string_builder_append_string(&sb, PG_S("\n        "), allocator);
-        pg_string_builder_append_string(&sb, desc->description, allocator);
-        if (!pg_string_ends_with(desc->description, PG_S("."))) {
-          pg_string_builder_append_string(&sb, PG_S("."), allocator);
-        }
-        pg_string_builder_append_string(&sb, PG_S("\n"), allocator);
+// Minimum duration of one sample, to dwarf the timer resolution and overhead.
+#ifndef PG_BENCH_SAMPLE_MIN_NS
+#define PG_BENCH_SAMPLE_MIN_NS (10 * PG_Milliseconds)
+#endif
+
+#ifndef PG_BENCH_SAMPLES_DEFAULT
+#define PG_BENCH_SAMPLES_DEFAULT 31
+#endif
+
+#define PG_BENCH_SAMPLES_MAX 1000
+
+#ifdef PG_OS_LINUX
+[[nodiscard]] static i32 pg_bench_perf_event_open(u64 config, i32 group_fd) {
+  struct perf_event_attr attr = {0};
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.disabled = -1 == group_fd;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+
+  return (i32)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+#endif
+
+[[maybe_unused]] [[nodiscard]] static PgBenchCounters pg_bench_counters_open() {
+  PgBenchCounters res = {0};
+  for (u64 i = 0; i < PG_BENCH_COUNTER_COUNT; i++) {
+    res.fds[i] = -1;
+  }
+
+#ifdef PG_OS_LINUX
+  const u64 configs[PG_BENCH_COUNTER_COUNT] = {
+      [PG_BENCH_COUNTER_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+      [PG_BENCH_COUNTER_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS,
+      [PG_BENCH_COUNTER_CACHE_MISSES] = PERF_COUNT_HW_CACHE_MISSES,
+  };
+
+  for (u64 i = 0; i < PG_BENCH_COUNTER_COUNT; i++) {
+    i32 fd = pg_bench_perf_event_open(configs[i], res.fds[0]);
+    if (-1 == fd) {
+      // All or nothing.
+      for (u64 j = 0; j < i; j++) {
+        (void)close(res.fds[j]);
+        res.fds[j] = -1;
       }
+      break;
+    }
+    res.fds[i] = fd;
+  }
+#endif
 
-      pg_string_builder_append_string(&sb, PG_S("\n"), allocator);
+  return res;
+}
+
+[[maybe_unused]] static void pg_bench_counters_close(PgBenchCounters *counters) {
+  for (u64 i = 0; i < PG_BENCH_COUNTER_COUNT; i++) {
+    if (-1 != counters->fds[i]) {
+      (void)close(counters->fds[i]);
+      counters->fds[i] = -1;
     }
+  }
+}
 
-    pg_string_builder_append_string(&sb, PG_S("\n"), allocator);
+[[maybe_unused]] [[nodiscard]] static bool
+pg_bench_counters_available(PgBenchCounters counters) {
+  return -1 != counters.fds[0];
+}
+
+[[maybe_unused]] static void pg_bench_counters_start(PgBenchCounters *counters) {
+  if (!pg_bench_counters_available(*counters)) {
+    return;
   }
 
-  return PG_DYN_TO_SLICE(PgString, sb);
+#ifdef PG_OS_LINUX
+  (void)ioctl(counters->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  (void)ioctl(counters->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
 }
 
-[[maybe_unused]] [[nodiscard]] static PgError
-pg_cli_print_parse_err(PgCliParseResult res_parse, PgWriter *w,
-                       PgAllocator *allocator) {
-  switch (res_parse.err) {
-  case 0:
-    return (PgError){0};
+// Accumulate the counts since the last `pg_bench_counters_start`.
+[[maybe_unused]] static void pg_bench_counters_stop(PgBenchCounters *counters) {
+  if (!pg_bench_counters_available(*counters)) {
+    return;
+  }
 
-  case PG_ERR_CLI_MISSING_REQUIRED_OPTION:
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("Missing required CLI option "),
-                                       allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
-    break;
-  case PG_ERR_CLI_MISSING_REQUIRED_OPTION_VALUE:
-    PG_ERR_RETURN(pg_writer_write_full(
-        w, PG_S("Missing required value for CLI option"), allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
-    break;
-  case PG_ERR_CLI_UNKNOWN_OPTION:
-    PG_ERR_RETURN(pg_writer_write_full(
-        w, PG_S("Encountered unknown CLI option"), allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
-    break;
-  case PG_ERR_CLI_FORBIDEN_OPTION_VALUE:
-    PG_ERR_RETURN(pg_writer_write_full(
-        w, PG_S("Encountered forbidden value for CLI option"), allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
-    break;
-  case PG_ERR_CLI_MALFORMED_OPTION:
-    PG_ERR_RETURN(
-        pg_writer_write_full(w, PG_S("Malformed CLI option"), allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, res_parse.err_argv, allocator));
-    PG_ERR_RETURN(pg_writer_write_full(w, PG_S("."), allocator));
-    break;
-  default:
-    PG_ERR_RETURN(pg_writer_write_full(
-        w, PG_S("Unknown CLI options parse error."), allocator));
+#ifdef PG_OS_LINUX
+  (void)ioctl(counters->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+  // Layout for `PERF_FORMAT_GROUP`.
+  struct {
+    u64 nr;
+    u64 values[PG_BENCH_COUNTER_COUNT];
+  } group = {0};
+  if ((i64)sizeof(group) != read(counters->fds[0], &group, sizeof(group))) {
+    return;
   }
+  PG_ASSERT(PG_BENCH_COUNTER_COUNT == group.nr);
 
-  return pg_writer_flush(w, allocator);
+  for (u64 i = 0; i < PG_BENCH_COUNTER_COUNT; i++) {
+    counters->values[i] += group.values[i];
+  }
+#endif
 }
 
-#ifndef PG_OS_WASM
-[[maybe_unused]] static void pg_stack_trace_print_dwarf(u64 skip) {
-  static _Atomic PgOnce once = false;
-  static PgArena arena = {0};
-  static PG_DYN(PgDebugFunctionDeclaration) fns = {0};
+[[nodiscard]] static u64 pg_bench_run_once(PgBench bench, u64 iterations,
+                                           PgBenchState *state) {
+  *state = (PgBenchState){.iterations = iterations};
 
-  if (pg_once_do(&once)) {
-    arena = pg_arena_make_from_virtual_mem(512 * PG_KiB);
-    PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
-    PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+  u64 start = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  bench.fn(state);
+  u64 end = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
 
-    PG_RESULT(PgDebugInfoIterator, PgError)
-    res_debug = pg_self_debug_info_iterator_make(allocator);
-    PG_IF_LET_ERR(err, res_debug) {
-      PG_UNUSED(err);
-      goto end;
-    }
-    PgDebugInfoIterator it = PG_UNWRAP(res_debug);
+  return end - start;
+}
 
-    PG_RESULT(PG_DYN(PgDebugFunctionDeclaration), PgError)
-    res_fns = pg_dwarf_collect_functions(&it, allocator);
-    PG_IF_LET_ERR(err, res_fns) {
-      PG_UNUSED(err);
-      goto end_debug;
+// Find an iteration count such that one sample lasts at least
+// `PG_BENCH_SAMPLE_MIN_NS`. This also serves as warmup (caches, branch
+// predictors, page faults, CPU frequency).
+[[nodiscard]] static u64 pg_bench_calibrate(PgBench bench) {
+  PgBenchState state = {0};
+  u64 iterations = 1;
+
+  for (;;) {
+    u64 elapsed = pg_bench_run_once(bench, iterations, &state);
+    if (elapsed >= PG_BENCH_SAMPLE_MIN_NS) {
+      break;
     }
-    fns = PG_UNWRAP(res_fns);
-    goto end;
 
-  end_debug:
-    pg_self_debug_info_iterator_release(it);
-  end:
-    pg_once_mark_as_done(&once);
+    // Aim a bit over the target, but grow at most 10x at a time in case the
+    // first runs were dominated by cold effects.
+    u64 next = elapsed > 0 ? iterations * PG_BENCH_SAMPLE_MIN_NS / elapsed *
+                                 12 / 10
+                           : iterations * 10;
+    iterations = PG_CLAMP(iterations + 1, next, iterations * 10);
   }
 
-  {
-    u64 stack_trace[PG_STACK_TRACE_MAX] = {0};
-    u64 stack_trace_len = pg_fill_stack_trace(skip, 0, stack_trace);
+  // One more full sample of warmup at the final iteration count.
+  (void)pg_bench_run_once(bench, iterations, &state);
 
-    fprintf(stderr, " Stack trace:\n");
+  return iterations;
+}
 
-    for (u32 i = 0; i < stack_trace_len; i++) {
-      u64 addr = PG_C_ARRAY_AT(stack_trace, PG_STACK_TRACE_MAX, i);
-      PG_OPTION(PgDebugFunctionDeclaration)
-      fn_opt = pg_dwarf_find_function_by_addr(fns, addr);
+[[nodiscard]] static u64 pg_bench_percentile(PG_SLICE(u64) sorted,
+                                             u64 percentile) {
+  PG_ASSERT(sorted.len > 0);
+  PG_ASSERT(percentile <= 100);
 
-      fprintf(stderr, "[%u] at: %#" PRIx64, i, addr);
-      if (fn_opt.has_value) {
-        PgDebugFunctionDeclaration fn = fn_opt.value;
-        fprintf(stderr, " %.*s", (i32)fn.name.len, fn.name.data);
-        if (pg_string_eq(fn.name, PG_S("main"))) {
-          i = stack_trace_len; // End.
-        }
-      }
-      fprintf(stderr, "\n");
-    }
-  }
+  u64 idx = pg_div_ceil(sorted.len * percentile, 100);
+  return PG_SLICE_AT(sorted, idx > 0 ? idx - 1 : 0);
 }
-#endif
 
-#define PG_TEST(F)                                                             \
-  (PgTest) { .name = PG_S("" #F ""), .fn = F }
-
-#ifndef PG_OS_WASM
-[[maybe_unused]] static void pg_run_tests(int argc, char **argv,
-                                          PG_SLICE(PgTest) tests) {
-  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+// Output is one logfmt line per benchmark so that runs can be diffed and
+// processed across commits. All timings are in nanoseconds per iteration.
+[[maybe_unused]] static void pg_run_benches(int argc, char **argv,
+                                            PG_SLICE(PgBench) benches) {
+  PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
   PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
   PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
 
   PG_ASSERT(argc >= 1);
   PgString exe = pg_cstr_to_string(argv[0]);
 
-  PgString description = PG_S("Run tests.");
+  PgString description = PG_S("Run benchmarks.");
   PG_DYN(PgCliOptionDescription) descs = {0};
   PG_DYN_PUSH(&descs,
               ((PgCliOptionDescription){
-                  .name_short = PG_S("v"),
-                  .name_long = PG_S("verbose"),
-                  .description = PG_S("Verbose mode"),
+                  .name_short = PG_S("r"),
+                  .name_long = PG_S("run"),
+                  .description =
+                      PG_S("Run only these benchmarks (prefix-based)"),
+                  .value_name = PG_S("prefix"),
               }),
               allocator);
   PG_DYN_PUSH(&descs,
               ((PgCliOptionDescription){
-                  .name_short = PG_S("r"),
-                  .name_long = PG_S("run"),
-                  .description = PG_S("Run only these tests (prefix-based)"),
-                  .value_name = PG_S("prefix"),
+                  .name_short = PG_S("s"),
+                  .name_long = PG_S("samples"),
+                  .description = PG_S("Number of samples per benchmark"),
+                  .value_name = PG_S("count"),
               }),
               allocator);
 
@@ -13257,19 +24382,27 @@ pg_cli_print_parse_err(PgCliParseResult res_parse, PgWriter *w,
     exit(1);
   }
 
-  bool cli_verbose = false;
   PgString cli_run = {0};
+  u64 cli_samples = PG_BENCH_SAMPLES_DEFAULT;
 
   PG_EACH_PTR(opt, &res_cli_parse.options) {
-    if (pg_string_eq(opt->description.name_long, PG_S("verbose"))) {
-      cli_verbose = true;
-    } else if (pg_string_eq(opt->description.name_long, PG_S("run"))) {
+    if (pg_string_eq(opt->description.name_long, PG_S("run"))) {
       if (1 != opt->values.len) {
         fprintf(stderr,
                 "Only one value expected for -r,--run, got %" PRIu64 "\n",
                 opt->values.len);
       }
       cli_run = PG_SLICE_AT(opt->values, 0);
+    } else if (pg_string_eq(opt->description.name_long, PG_S("samples"))) {
+      PgParseNumberResult res_parse =
+          pg_string_parse_u64(PG_SLICE_AT(opt->values, 0), 10, true);
+      if (!res_parse.present || !pg_string_is_empty(res_parse.remaining) ||
+          0 == res_parse.n || res_parse.n > PG_BENCH_SAMPLES_MAX) {
+        fprintf(stderr, "Invalid value for -s,--samples (1..%d)\n",
+                PG_BENCH_SAMPLES_MAX);
+        exit(1);
+      }
+      cli_samples = res_parse.n;
     } else if (pg_string_eq(opt->description.name_long, PG_S("help"))) {
       PgString help =
           pg_cli_generate_help(descs, exe, description, PG_S(""), allocator);
@@ -13279,28 +24412,90 @@ pg_cli_print_parse_err(PgCliParseResult res_parse, PgWriter *w,
     }
   }
 
-  PG_EACH_PTR(t, &tests) {
-    // TODO: Run each test in its own child process.
-    // TODO: Exclude pattern.
-    if (!pg_string_starts_with(t->name, cli_run)) {
+  PG_SLICE(u64) samples = {
+      .data = pg_alloc(allocator, sizeof(u64), _Alignof(u64), cli_samples),
+      .len = cli_samples,
+  };
+  PG_ASSERT(samples.data);
+
+  PgBenchCounters counters = pg_bench_counters_open();
+
+  PG_EACH_PTR(b, &benches) {
+    if (!pg_string_starts_with(b->name, cli_run)) {
       continue;
     }
 
-    u64 start = 0;
-    if (cli_verbose) {
-      printf("RUN\t%.*s\t", (i32)t->name.len, t->name.data);
-      start = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    u64 iterations = pg_bench_calibrate(*b);
+
+    for (u64 i = 0; i < PG_BENCH_COUNTER_COUNT; i++) {
+      counters.values[i] = 0;
+    }
+
+    PgBenchState state = {0};
+    u64 total_ns = 0;
+    for (u64 i = 0; i < samples.len; i++) {
+      pg_bench_counters_start(&counters);
+      u64 elapsed = pg_bench_run_once(*b, iterations, &state);
+      pg_bench_counters_stop(&counters);
+
+      PG_SLICE_AT(samples, i) = elapsed;
+      total_ns += elapsed;
     }
-    t->fn();
-    if (cli_verbose) {
-      u64 end = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
-      PgDuration duration = pg_time_ns_to_human_readable_duration(end - start);
-      printf("OK ");
-      pg_duration_print(stdout, duration);
-      printf("\n");
+
+    // Insertion sort: there are few samples and `pg_quicksort` would need a
+    // comparison callback.
+    for (u64 i = 1; i < samples.len; i++) {
+      u64 x = PG_SLICE_AT(samples, i);
+      u64 j = i;
+      for (; j > 0 && PG_SLICE_AT(samples, j - 1) > x; j--) {
+        PG_SLICE_AT(samples, j) = PG_SLICE_AT(samples, j - 1);
+      }
+      PG_SLICE_AT(samples, j) = x;
+    }
+
+    f64 iterations_f = (f64)iterations;
+    f64 total_iterations = iterations_f * (f64)samples.len;
+
+    printf("bench=%.*s iterations=%" PRIu64 " samples=%" PRIu64
+           " min_ns=%.3f median_ns=%.3f p99_ns=%.3f mean_ns=%.3f",
+           (i32)b->name.len, b->name.data, iterations, samples.len,
+           (f64)PG_SLICE_AT(samples, 0) / iterations_f,
+           (f64)pg_bench_percentile(samples, 50) / iterations_f,
+           (f64)pg_bench_percentile(samples, 99) / iterations_f,
+           (f64)total_ns / total_iterations);
+
+    if (state.bytes_per_iteration > 0) {
+      // Based on the median.
+      f64 median_s =
+          (f64)pg_bench_percentile(samples, 50) / (f64)PG_Seconds;
+      printf(" bytes_per_s=%.0f",
+             (f64)state.bytes_per_iteration * iterations_f / median_s);
+    }
+    if (state.items_per_iteration > 0) {
+      f64 median_s =
+          (f64)pg_bench_percentile(samples, 50) / (f64)PG_Seconds;
+      printf(" items_per_s=%.0f",
+             (f64)state.items_per_iteration * iterations_f / median_s);
+    }
+    if (state.ratio > 0) {
+      printf(" ratio=%.3f", state.ratio);
     }
+
+    if (pg_bench_counters_available(counters)) {
+      printf(" cycles=%.3f instructions=%.3f cache_misses=%.3f",
+             (f64)counters.values[PG_BENCH_COUNTER_CYCLES] / total_iterations,
+             (f64)counters.values[PG_BENCH_COUNTER_INSTRUCTIONS] /
+                 total_iterations,
+             (f64)counters.values[PG_BENCH_COUNTER_CACHE_MISSES] /
+                 total_iterations);
+    }
+    printf("\n");
+    fflush(stdout);
   }
+
+  pg_bench_counters_close(&counters);
 }
+
 #endif
 
 #endif
@@ -573,6 +573,84 @@ static void test_string_parse_u64() {
     PG_ASSERT(pg_string_eq(PG_S("g🍌"), num_res.remaining));
     PG_ASSERT(0x12 == num_res.n);
   }
+  // Long runs of digits, going through the 8/16 digits at a time paths.
+  {
+    PgParseNumberResult num_res =
+        pg_string_parse_u64(PG_S("18446744073709551615,"), 10, true);
+    PG_ASSERT(num_res.present);
+    PG_ASSERT(!num_res.overflow);
+    PG_ASSERT(pg_string_eq(PG_S(","), num_res.remaining));
+    PG_ASSERT(UINT64_MAX == num_res.n);
+  }
+  {
+    PgParseNumberResult num_res =
+        pg_string_parse_u64(PG_S("1234567890123"), 10, true);
+    PG_ASSERT(num_res.present);
+    PG_ASSERT(1234567890123 == num_res.n);
+  }
+  {
+    PgParseNumberResult num_res = pg_string_parse_u64(
+        PG_S("00000000000000000000000000012345678"), 10, false);
+    PG_ASSERT(num_res.present);
+    PG_ASSERT(12345678 == num_res.n);
+  }
+  {
+    PgParseNumberResult num_res =
+        pg_string_parse_u64(PG_S("7ffdEADbeef01234-"), 16, false);
+    PG_ASSERT(num_res.present);
+    PG_ASSERT(pg_string_eq(PG_S("-"), num_res.remaining));
+    PG_ASSERT(0x7ffdeadbeef01234 == num_res.n);
+  }
+  // Overflow.
+  {
+    PgParseNumberResult num_res =
+        pg_string_parse_u64(PG_S("18446744073709551616"), 10, true);
+    PG_ASSERT(!num_res.present);
+    PG_ASSERT(num_res.overflow);
+    PG_ASSERT(pg_string_eq(PG_S("18446744073709551616"), num_res.remaining));
+  }
+  {
+    PgParseNumberResult num_res =
+        pg_string_parse_u64(PG_S("99999999999999999999999"), 10, true);
+    PG_ASSERT(!num_res.present);
+    PG_ASSERT(num_res.overflow);
+  }
+  {
+    PgParseNumberResult num_res =
+        pg_string_parse_u64(PG_S("1ffffffffffffffff"), 16, true);
+    PG_ASSERT(!num_res.present);
+    PG_ASSERT(num_res.overflow);
+  }
+}
+
+static void test_string_parse_u64_many() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  {
+    PG_DYN(u64) nums = {0};
+    PgString remaining = pg_string_parse_u64_many(
+        PG_S("1 22\t333\n\n4444 12345678901234567890\n"), 10, PG_S(" \t\n"),
+        &nums, allocator);
+    PG_ASSERT(pg_string_is_empty(remaining));
+    PG_ASSERT(5 == nums.len);
+    PG_ASSERT(1 == PG_SLICE_AT(nums, 0));
+    PG_ASSERT(22 == PG_SLICE_AT(nums, 1));
+    PG_ASSERT(333 == PG_SLICE_AT(nums, 2));
+    PG_ASSERT(4444 == PG_SLICE_AT(nums, 3));
+    PG_ASSERT(12345678901234567890ULL == PG_SLICE_AT(nums, 4));
+  }
+  // Stops at the first invalid field.
+  {
+    PG_DYN(u64) nums = {0};
+    PgString remaining = pg_string_parse_u64_many(
+        PG_S("ff,10,1g,2"), 16, PG_S(","), &nums, allocator);
+    PG_ASSERT(pg_string_eq(PG_S("1g,2"), remaining));
+    PG_ASSERT(2 == nums.len);
+    PG_ASSERT(0xff == PG_SLICE_AT(nums, 0));
+    PG_ASSERT(0x10 == PG_SLICE_AT(nums, 1));
+  }
 }
 
 static void test_string_cmp() {
@@ -639,6 +717,50 @@ static void test_sha1() {
   }
 }
 
+static void test_crc32_adler32() {
+  PgString check = PG_S("123456789");
+  PG_ASSERT(0xcbf43926 == pg_crc32_update(0, check));
+  PG_ASSERT(0x091e01de == pg_adler32_update(1, check));
+  PG_ASSERT(0 == pg_crc32_update(0, PG_S("")));
+  PG_ASSERT(1 == pg_adler32_update(1, PG_S("")));
+
+  // In parts.
+  PG_ASSERT(0xcbf43926 ==
+            pg_crc32_update(pg_crc32_update(0, PG_S("1234")), PG_S("56789")));
+  PG_ASSERT(0x091e01de == pg_adler32_update(pg_adler32_update(1, PG_S("1234")),
+                                            PG_S("56789")));
+
+  // The folded computation of large inputs matches the bytewise one, at any
+  // length and alignment.
+  u8 data[1024] = {0};
+  PgRng rng = {.state = 42};
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(data); i++) {
+    data[i] = (u8)pg_rand_u32_min_incl_max_excl(&rng, 0, 256);
+  }
+  for (u64 start = 0; start < 16; start++) {
+    for (u64 len = 0; start + len <= PG_STATIC_ARRAY_LEN(data); len += 7) {
+      PgString s = {.data = data + start, .len = len};
+      PG_ASSERT(~pg_crc32_update_table(~0U, s.data, s.len) ==
+                pg_crc32_update(0, s));
+    }
+  }
+
+  // Reduced modulo 65521 across blocks: the sums only overflow past 5552
+  // bytes of 0xff.
+  u8 ones[6000] = {0};
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(ones); i++) {
+    ones[i] = 0xff;
+  }
+  u32 a = 1;
+  u32 b = 0;
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(ones); i++) {
+    a = (a + 0xff) % 65521;
+    b = (b + a) % 65521;
+  }
+  PgString s = {.data = ones, .len = sizeof(ones)};
+  PG_ASSERT((b << 16 | a) == pg_adler32_update(1, s));
+}
+
 static void test_slice_swap_remove() {
   PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
   PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
@@ -906,6 +1028,38 @@ static void test_ring_buffer_read_write() {
     PG_ASSERT(12 == pg_ring_can_read_count(rg));
     PG_ASSERT(0 == pg_ring_can_write_count(rg));
   }
+  // Search data that wraps around.
+  {
+    PgRing rg = pg_ring_make(12, allocator);
+    PG_ASSERT(8 == pg_ring_write_bytes(&rg, PG_S("xxxxxxxx")));
+    u8 tmp[8] = {0};
+    PG_SLICE(u8) tmp_slice = {.data = tmp, PG_STATIC_ARRAY_LEN(tmp)};
+    PG_ASSERT(8 == pg_ring_read_bytes(&rg, tmp_slice));
+
+    // `ab\r` at the end of the buffer and `\ncd\r\n` at the start.
+    PG_ASSERT(9 == pg_ring_write_bytes(&rg, PG_S("ab\r\ncd\r\n!")));
+    PG_ASSERT(!pg_ring_is_full(rg));
+
+    PG_OPTION(u64) idx = pg_ring_index_of_byte(rg, '\n');
+    PG_ASSERT(idx.has_value);
+    PG_ASSERT(3 == idx.value);
+
+    idx = pg_ring_index_of_byte(rg, '!');
+    PG_ASSERT(idx.has_value);
+    PG_ASSERT(8 == idx.value);
+
+    PG_ASSERT(!pg_ring_index_of_byte(rg, 'x').has_value);
+
+    idx = pg_ring_index_of_bytes2(rg, '\r', '\n');
+    PG_ASSERT(idx.has_value);
+    PG_ASSERT(2 == idx.value);
+
+    pg_ring_read_skip(&rg, 4);
+    idx = pg_ring_index_of_bytes2(rg, '\r', '\n');
+    PG_ASSERT(idx.has_value);
+    PG_ASSERT(2 == idx.value);
+    PG_ASSERT(5 == pg_ring_can_read_count(rg));
+  }
 }
 
 static void test_ring_buffer_read_write_fuzz() {
@@ -1293,6 +1447,110 @@ static void test_url_parse_relative_path() {
   }
 }
 
+static void test_url_view_parse() {
+  // Errors.
+  {
+    PG_ASSERT(PG_ERR_INVALID_VALUE ==
+              PG_UNWRAP_ERR(pg_url_view_parse(PG_S("http:/a"))));
+    PG_ASSERT(PG_ERR_INVALID_VALUE ==
+              PG_UNWRAP_ERR(pg_url_view_parse(PG_S("http:///a"))));
+    PG_ASSERT(PG_ERR_INVALID_VALUE ==
+              PG_UNWRAP_ERR(pg_url_view_parse(PG_S("http://@a"))));
+    PG_ASSERT(PG_ERR_INVALID_VALUE ==
+              PG_UNWRAP_ERR(pg_url_view_parse(PG_S("http://[::1"))));
+    PG_ASSERT(PG_ERR_INVALID_VALUE ==
+              PG_UNWRAP_ERR(pg_url_view_parse(PG_S("http://[::1]x"))));
+  }
+  // All components.
+  {
+    PG_RESULT(PgUrlView, PgError)
+    res = pg_url_view_parse(
+        PG_S("https://user:pw@a.b:8443//foo/%62ar/?x=1&&=2&y#top"));
+    PgUrlView url = PG_UNWRAP(res);
+    PG_ASSERT(pg_string_eq(PG_S("https"), url.scheme));
+    PG_ASSERT(pg_string_eq(PG_S("user:pw"), url.user_info));
+    PG_ASSERT(pg_string_eq(PG_S("a.b"), url.host));
+    PG_ASSERT(8443 == url.port);
+    PG_ASSERT(pg_string_eq(PG_S("//foo/%62ar/"), url.path));
+    PG_ASSERT(pg_string_eq(PG_S("x=1&&=2&y"), url.query));
+    PG_ASSERT(pg_string_eq(PG_S("top"), url.fragment));
+
+    PgUrlPathIterator path_it = pg_url_path_iterator_make(url.path);
+    PG_OPTION(PgString) component = pg_url_path_iterator_next(&path_it);
+    PG_ASSERT(component.has_value);
+    PG_ASSERT(pg_string_eq(PG_S("foo"), component.value));
+    component = pg_url_path_iterator_next(&path_it);
+    PG_ASSERT(component.has_value);
+    PG_ASSERT(pg_string_eq(PG_S("%62ar"), component.value));
+    PG_ASSERT(!pg_url_path_iterator_next(&path_it).has_value);
+
+    PgUrlQueryIterator query_it = pg_url_query_iterator_make(url.query);
+    PG_OPTION(PgStringKeyValue) kv = pg_url_query_iterator_next(&query_it);
+    PG_ASSERT(kv.has_value);
+    PG_ASSERT(pg_string_eq(PG_S("x"), kv.value.key));
+    PG_ASSERT(pg_string_eq(PG_S("1"), kv.value.value));
+    kv = pg_url_query_iterator_next(&query_it);
+    PG_ASSERT(kv.has_value);
+    PG_ASSERT(pg_string_eq(PG_S("y"), kv.value.key));
+    PG_ASSERT(0 == kv.value.value.len);
+    PG_ASSERT(!pg_url_query_iterator_next(&query_it).has_value);
+  }
+  // IPv6 host.
+  {
+    PG_RESULT(PgUrlView, PgError)
+    res = pg_url_view_parse(PG_S("http://[::1]:80?a"));
+    PgUrlView url = PG_UNWRAP(res);
+    PG_ASSERT(pg_string_eq(PG_S("::1"), url.host));
+    PG_ASSERT(80 == url.port);
+    PG_ASSERT(0 == url.path.len);
+    PG_ASSERT(pg_string_eq(PG_S("a"), url.query));
+    PG_ASSERT(0 == url.fragment.len);
+  }
+  // Origin form.
+  {
+    PgUrlView url = pg_url_view_parse_after_authority(PG_S("/a/b#c?d"));
+    PG_ASSERT(pg_string_eq(PG_S("/a/b"), url.path));
+    PG_ASSERT(0 == url.query.len);
+    PG_ASSERT(pg_string_eq(PG_S("c?d"), url.fragment));
+  }
+}
+
+static void test_url_percent_decode() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Nothing to decode: no copy.
+  {
+    PgString s = PG_S("hello+world");
+    PgString decoded = pg_url_percent_decode(s, false, allocator);
+    PG_ASSERT(decoded.data == s.data);
+    PG_ASSERT(decoded.len == s.len);
+  }
+  {
+    PgString decoded = pg_url_percent_decode(
+        PG_S("a%20b+c%2Fd%e2%82%ACe%zz%4"), true, allocator);
+    PG_ASSERT(pg_string_eq(PG_S("a b c/d\xe2\x82\xac"
+                                "e%zz%4"),
+                           decoded));
+  }
+  // Long enough to exercise the vectorized scan.
+  {
+    PgString s = PG_S("the_quick_brown_fox_jumps_over_the_lazy_dog_"
+                      "the_quick_brown_fox_jumps_over_the_lazy_dog+%21");
+    PgString decoded = pg_url_percent_decode(s, true, allocator);
+    PG_ASSERT(pg_string_eq(PG_S("the_quick_brown_fox_jumps_over_the_lazy_dog_"
+                                "the_quick_brown_fox_jumps_over_the_lazy_dog !"),
+                           decoded));
+  }
+  {
+    PgString s = pg_string_clone(PG_S("/caf%C3%A9+x"), allocator);
+    PgString decoded = pg_url_percent_decode_in_place(s, false);
+    PG_ASSERT(decoded.data == s.data);
+    PG_ASSERT(pg_string_eq(PG_S("/caf\xc3\xa9+x"), decoded));
+  }
+}
+
 static void test_http_request_to_string() {
   PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
   PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
@@ -1321,6 +1579,1001 @@ static void test_http_request_to_string() {
   }
 }
 
+static void test_http_headers() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Every well-known name maps back to its id, in any case.
+  for (u64 i = PG_HTTP_HEADER_ID_NONE + 1; i < PG_HTTP_HEADER_ID_COUNT; i++) {
+    PgHttpHeaderId id = (PgHttpHeaderId)i;
+    PgString name = pg_string_clone(pg_http_header_name(id), allocator);
+    PG_ASSERT(id == pg_http_header_id(name));
+
+    PG_EACH_PTR(c, &name) { *c = (u8)pg_rune_ascii_to_lower_case(*c); }
+    PG_ASSERT(id == pg_http_header_id(name));
+  }
+  PG_ASSERT(PG_HTTP_HEADER_ID_NONE == pg_http_header_id(PG_S("")));
+  PG_ASSERT(PG_HTTP_HEADER_ID_NONE == pg_http_header_id(PG_S("X-Custom")));
+  PG_ASSERT(PG_HTTP_HEADER_ID_NONE == pg_http_header_id(PG_S("Hos")));
+
+  PgHttpHeaders headers = {0};
+  pg_http_push_header(&headers, PG_S("set-cookie"), PG_S("a=1"), allocator);
+  pg_http_push_header(&headers, PG_S("X-Custom"), PG_S("foo"), allocator);
+  pg_http_push_header(&headers, PG_S("Set-Cookie"), PG_S("b=2"), allocator);
+  PG_ASSERT(3 == headers.entries.len);
+
+  // First occurrence.
+  PG_OPTION(PgString)
+  value = pg_http_headers_get_by_id(&headers, PG_HTTP_HEADER_ID_SET_COOKIE);
+  PG_ASSERT(value.has_value);
+  PG_ASSERT(pg_string_eq(PG_S("a=1"), value.value));
+
+  value = pg_http_headers_get(&headers, PG_S("x-custom"));
+  PG_ASSERT(value.has_value);
+  PG_ASSERT(pg_string_eq(PG_S("foo"), value.value));
+
+  PG_ASSERT(!pg_http_headers_get(&headers, PG_S("Host")).has_value);
+  PG_ASSERT(!pg_http_headers_get(&headers, PG_S("X-Other")).has_value);
+
+  // Well-known names are written in their canonical spelling.
+  PgWriter w = pg_writer_make_string_builder(128, allocator);
+  PG_EACH_PTR(h, &headers.entries) {
+    PG_ASSERT(0 == pg_http_write_header(&w, *h, allocator));
+  }
+  PG_ASSERT(pg_string_eq(PG_S("Set-Cookie: a=1\r\n"
+                              "X-Custom: foo\r\n"
+                              "Set-Cookie: b=2\r\n"),
+                         PG_DYN_TO_SLICE(PgString, w.u.bytes)));
+}
+
+static void test_http_chunked() {
+  PgArena arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Write.
+  PgWriter w = pg_writer_make_string_builder(256, allocator);
+  {
+    PgWriter chunked = pg_http_chunked_writer_make(&w, 0, allocator);
+    PG_ASSERT(0 == pg_writer_write_full(&chunked, PG_S("hello"), allocator));
+    PG_ASSERT(0 == pg_writer_write_full(&chunked, PG_S(""), allocator));
+    PG_ASSERT(0 == pg_writer_write_full(&chunked, PG_S(", world! 0123456789"),
+                                        allocator));
+
+    PgHttpHeaders trailers = {0};
+    pg_http_push_header(&trailers, PG_S("Server-Timing"), PG_S("db;dur=53"),
+                        allocator);
+    PG_ASSERT(0 ==
+              pg_http_chunked_writer_finish(&chunked, trailers, allocator));
+  }
+  PgString encoded = PG_DYN_TO_SLICE(PgString, w.u.bytes);
+  PG_ASSERT(pg_string_eq(PG_S("5\r\nhello\r\n"
+                              "13\r\n, world! 0123456789\r\n"
+                              "0\r\n"
+                              "Server-Timing: db;dur=53\r\n"
+                              "\r\n"),
+                         encoded));
+
+  // Buffered writes are coalesced in one chunk.
+  {
+    PgWriter w2 = pg_writer_make_string_builder(64, allocator);
+    PgWriter chunked = pg_http_chunked_writer_make(&w2, 64, allocator);
+    PG_ASSERT(0 == pg_writer_write_full(&chunked, PG_S("ab"), allocator));
+    PG_ASSERT(0 == pg_writer_write_full(&chunked, PG_S("cd"), allocator));
+    PG_ASSERT(0 ==
+              pg_http_chunked_writer_finish(&chunked, (PgHttpHeaders){0},
+                                            allocator));
+    PG_ASSERT(pg_string_eq(PG_S("4\r\nabcd\r\n0\r\n\r\n"),
+                           PG_DYN_TO_SLICE(PgString, w2.u.bytes)));
+  }
+
+  // Read back, followed by the next request on the same connection.
+  {
+    Pgu8Dyn sb = {0};
+    PG_DYN_APPEND_SLICE(&sb, encoded, allocator);
+    PG_DYN_APPEND_SLICE(&sb, PG_S("GET / HTTP/1.1\r\n"), allocator);
+    PgReader inner = pg_reader_make_from_bytes(PG_DYN_TO_SLICE(PgString, sb));
+
+    PgHttpHeaders headers = {0};
+    pg_http_push_header(&headers, PG_S("Transfer-Encoding"),
+                        PG_S("gzip, Chunked"), allocator);
+    PgHttpHeaders trailers = {0};
+    PG_RESULT(PgReader, PgError)
+    res_reader =
+        pg_http_request_body_reader(&headers, &inner, &trailers, allocator);
+    PgReader body = PG_UNWRAP(res_reader);
+    PG_ASSERT(PG_READER_KIND_HTTP_CHUNKED == body.kind);
+
+    u8 buf[4] = {0};
+    Pgu8Dyn decoded = {0};
+    for (;;) {
+      PG_RESULT(u64, PgError) res = pg_reader_read(&body, buf, sizeof(buf));
+      if (PG_IS_ERR(res)) {
+        PG_ASSERT(PG_ERR_EOF == PG_UNWRAP_ERR(res));
+        break;
+      }
+      u64 n = PG_UNWRAP(res);
+      PG_ASSERT(n <= sizeof(buf));
+      PG_DYN_APPEND_SLICE(&decoded, ((PgString){.data = buf, .len = n}),
+                          allocator);
+    }
+    PG_ASSERT(pg_string_eq(PG_S("hello, world! 0123456789"),
+                           PG_DYN_TO_SLICE(PgString, decoded)));
+
+    PG_ASSERT(1 == trailers.entries.len);
+    PG_ASSERT(pg_string_eq(
+        PG_S("db;dur=53"),
+        pg_http_headers_get(&trailers, PG_S("server-timing")).value));
+    PG_ASSERT(pg_string_eq(PG_S("GET / HTTP/1.1\r\n"), inner.u.bytes));
+  }
+
+  // Chunk extensions are ignored.
+  {
+    PgReader inner = pg_reader_make_from_bytes(
+        PG_S("3;name=value\r\nabc\r\n0\r\n\r\n"));
+    PgReader body = pg_http_chunked_reader_make(&inner, nullptr, allocator);
+    u8 buf[16] = {0};
+    PG_RESULT(u64, PgError) res = pg_reader_read(&body, buf, sizeof(buf));
+    PG_ASSERT(3 == PG_UNWRAP(res));
+    res = pg_reader_read(&body, buf, sizeof(buf));
+    PG_ASSERT(PG_ERR_EOF == PG_UNWRAP_ERR(res));
+  }
+
+  // Errors.
+  {
+    PgReader inner = pg_reader_make_from_bytes(PG_S("zz\r\n"));
+    PgReader body = pg_http_chunked_reader_make(&inner, nullptr, allocator);
+    u8 buf[16] = {0};
+    PG_RESULT(u64, PgError) res = pg_reader_read(&body, buf, sizeof(buf));
+    PG_ASSERT(PG_ERR_INVALID_VALUE == PG_UNWRAP_ERR(res));
+  }
+  {
+    PgReader inner = pg_reader_make_from_bytes(PG_S("3\r\nabcXY"));
+    PgReader body = pg_http_chunked_reader_make(&inner, nullptr, allocator);
+    u8 buf[16] = {0};
+    PG_RESULT(u64, PgError) res = pg_reader_read(&body, buf, sizeof(buf));
+    PG_ASSERT(PG_ERR_INVALID_VALUE == PG_UNWRAP_ERR(res));
+  }
+  // Truncated.
+  {
+    PgReader inner = pg_reader_make_from_bytes(PG_S("a\r\nabc"));
+    PgReader body = pg_http_chunked_reader_make(&inner, nullptr, allocator);
+    u8 buf[16] = {0};
+    PG_RESULT(u64, PgError) res = pg_reader_read(&body, buf, sizeof(buf));
+    PG_ASSERT(3 == PG_UNWRAP(res));
+    res = pg_reader_read(&body, buf, sizeof(buf));
+    PG_ASSERT(PG_ERR_IO == PG_UNWRAP_ERR(res));
+  }
+}
+
+// Compress `data` with writes of at most `write_len` bytes, then decompress
+// it with reads of at most `read_len` bytes.
+static void test_deflate_round_trip(PgString data, PgDeflateFormat format,
+                                    u8 level, u64 write_len, u64 read_len,
+                                    PgArena *arena) {
+  PgArenaTemp temp = pg_arena_temp_begin(arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&temp.allocator);
+
+  PgWriter w = pg_writer_make_string_builder(data.len / 2 + 64, allocator);
+  {
+    PgWriter deflate = pg_deflate_writer_make(&w, format, level, allocator);
+    for (u64 i = 0; i < data.len; i += write_len) {
+      PgString part =
+          PG_SLICE_RANGE(data, i, PG_MIN(data.len, i + write_len));
+      PG_ASSERT(0 == pg_writer_write_full(&deflate, part, allocator));
+    }
+    PG_ASSERT(0 == pg_deflate_writer_finish(&deflate, allocator));
+    PG_ASSERT(0 == pg_writer_close(&deflate));
+  }
+  PgString compressed = PG_DYN_TO_SLICE(PgString, w.u.bytes);
+  // Incompressible data is stored, with a few bytes of overhead.
+  PG_ASSERT(compressed.len <= data.len + data.len / 1000 + 32);
+
+  PgReader inner = pg_reader_make_from_bytes(compressed);
+  PgReader inflate = pg_inflate_reader_make(&inner, format, allocator);
+  PG_DYN(u8) decompressed = {0};
+  PG_DYN_ENSURE_CAP(&decompressed, data.len + read_len, allocator);
+  for (;;) {
+    PgString dst = {
+        .data = decompressed.data + decompressed.len,
+        .len = read_len,
+    };
+    PG_RESULT(u64, PgError) res = pg_reader_read_slice(&inflate, dst);
+    if (PG_IS_ERR(res)) {
+      PG_ASSERT(PG_ERR_EOF == PG_UNWRAP_ERR(res));
+      break;
+    }
+    PG_ASSERT(PG_UNWRAP(res) > 0);
+    decompressed.len += PG_UNWRAP(res);
+    PG_ASSERT(decompressed.len <= data.len);
+  }
+  PG_ASSERT(pg_string_eq(data, PG_DYN_TO_SLICE(PgString, decompressed)));
+  PG_ASSERT(0 == pg_reader_close(&inflate));
+
+  pg_arena_temp_end(temp);
+}
+
+// Read `compressed` whole.
+[[nodiscard]] static PG_RESULT(PgString, PgError)
+    test_inflate(PgString compressed, PgDeflateFormat format,
+                 PgAllocator *allocator) {
+  PgReader inner = pg_reader_make_from_bytes(compressed);
+  PgReader inflate = pg_inflate_reader_make(&inner, format, allocator);
+  PG_DYN(u8) sb = pg_string_builder_make(4 * PG_KiB, allocator);
+  for (;;) {
+    u8 buf[4 * PG_KiB] = {0};
+    PG_RESULT(u64, PgError)
+    res = pg_reader_read_slice(&inflate, (PgString)PG_SLICE_FROM_C(buf));
+    if (PG_IS_ERR(res)) {
+      if (PG_ERR_EOF == PG_UNWRAP_ERR(res)) {
+        return PG_OK(PG_DYN_TO_SLICE(PgString, sb), PgString, PgError);
+      }
+      return PG_ERR(PG_UNWRAP_ERR(res), PgString, PgError);
+    }
+    PG_DYN_APPEND_SLICE(&sb,
+                        ((PgString){.data = buf, .len = PG_UNWRAP(res)}),
+                        allocator);
+  }
+}
+
+static void test_deflate() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_MiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Text-like: words drawn at random, long enough to slide the window and
+  // to split blocks.
+  PgString text = {0};
+  {
+    PgString words[] = {
+        PG_S("the "),     PG_S("quick "),  PG_S("brown "),   PG_S("fox "),
+        PG_S("jumps "),   PG_S("over "),   PG_S("lazy "),    PG_S("dog "),
+        PG_S("static "),  PG_S("u64 "),    PG_S("return "),  PG_S("{\n  "),
+        PG_S("}\n"),      PG_S("PG_ASSERT"), PG_S("(0 == "), PG_S("err);\n"),
+    };
+    PgRng rng = {.state = 1};
+    PG_DYN(u8) sb = pg_string_builder_make(200 * PG_KiB, allocator);
+    while (sb.len < 200 * PG_KiB - 16) {
+      u32 i = pg_rand_u32_min_incl_max_excl(&rng, 0,
+                                            PG_STATIC_ARRAY_LEN(words));
+      PG_DYN_APPEND_SLICE_WITHIN_CAPACITY(&sb, words[i]);
+    }
+    text = PG_DYN_TO_SLICE(PgString, sb);
+  }
+  PgString random = pg_string_make(100 * PG_KiB, allocator);
+  {
+    PgRng rng = {.state = 2};
+    for (u64 i = 0; i < random.len; i++) {
+      random.data[i] = (u8)pg_rand_u32_min_incl_max_excl(&rng, 0, 256);
+    }
+  }
+  // Overlapping matches at distance 1.
+  PgString run = pg_string_make(70 * PG_KiB, allocator);
+  for (u64 i = 0; i < run.len; i++) {
+    run.data[i] = 'a';
+  }
+  // A single distance.
+  PgString cycle = pg_string_make(256 * 50, allocator);
+  for (u64 i = 0; i < cycle.len; i++) {
+    cycle.data[i] = (u8)i;
+  }
+
+  PgDeflateFormat formats[] = {
+      PG_DEFLATE_FORMAT_RAW,
+      PG_DEFLATE_FORMAT_ZLIB,
+      PG_DEFLATE_FORMAT_GZIP,
+  };
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(formats); i++) {
+    test_deflate_round_trip(PG_S(""), formats[i], 6, 1, 1, &arena);
+    test_deflate_round_trip(PG_S("a"), formats[i], 6, 1, 1, &arena);
+  }
+  for (u8 level = 0; level <= 9; level++) {
+    for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(formats); i++) {
+      test_deflate_round_trip(text, formats[i], level, 64 * PG_KiB,
+                              64 * PG_KiB, &arena);
+    }
+    test_deflate_round_trip(random, PG_DEFLATE_FORMAT_GZIP, level, 10000,
+                            4096, &arena);
+    test_deflate_round_trip(run, PG_DEFLATE_FORMAT_ZLIB, level, 70 * PG_KiB,
+                            100, &arena);
+    test_deflate_round_trip(cycle, PG_DEFLATE_FORMAT_RAW, level, cycle.len,
+                            cycle.len, &arena);
+  }
+  // Small writes and reads.
+  test_deflate_round_trip(PG_SLICE_RANGE(text, 0, 20 * PG_KiB),
+                          PG_DEFLATE_FORMAT_GZIP, 6, 7, 3, &arena);
+
+  // Compressed.
+  {
+    PgArenaTemp temp = pg_arena_temp_begin(&arena);
+    PgAllocator *temp_allocator =
+        pg_arena_allocator_as_allocator(&temp.allocator);
+    PgWriter w = pg_writer_make_string_builder(64 * PG_KiB, temp_allocator);
+    PgWriter deflate =
+        pg_deflate_writer_make(&w, PG_DEFLATE_FORMAT_GZIP, 6, temp_allocator);
+    PG_ASSERT(0 == pg_writer_write_full(&deflate, text, temp_allocator));
+    PG_ASSERT(0 == pg_deflate_writer_finish(&deflate, temp_allocator));
+    PG_ASSERT(w.u.bytes.len < text.len / 3);
+    pg_arena_temp_end(temp);
+  }
+
+  // Each sync flush makes everything written so far decodable.
+  {
+    PgArenaTemp temp = pg_arena_temp_begin(&arena);
+    PgAllocator *temp_allocator =
+        pg_arena_allocator_as_allocator(&temp.allocator);
+    PgWriter w = pg_writer_make_string_builder(256, temp_allocator);
+    PgWriter deflate =
+        pg_deflate_writer_make(&w, PG_DEFLATE_FORMAT_RAW, 6, temp_allocator);
+    PG_ASSERT(0 == pg_writer_write_full(&deflate, PG_S("hello, hello"),
+                                        temp_allocator));
+    PG_ASSERT(0 == pg_deflate_writer_flush(&deflate, temp_allocator));
+    // Ends with an empty stored block.
+    PgString flushed = PG_DYN_TO_SLICE(PgString, w.u.bytes);
+    PG_ASSERT(pg_string_ends_with(flushed, PG_S("\x00\x00\xff\xff")));
+
+    PgReader inner = pg_reader_make_from_bytes(flushed);
+    PgReader inflate =
+        pg_inflate_reader_make(&inner, PG_DEFLATE_FORMAT_RAW, temp_allocator);
+    u8 buf[64] = {0};
+    PG_RESULT(u64, PgError)
+    res = pg_reader_read_slice(&inflate, (PgString)PG_SLICE_FROM_C(buf));
+    PG_ASSERT(pg_string_eq(PG_S("hello, hello"),
+                           (PgString){.data = buf, .len = PG_UNWRAP(res)}));
+
+    PG_ASSERT(0 == pg_writer_write_full(&deflate, PG_S(" world"),
+                                        temp_allocator));
+    PG_ASSERT(0 == pg_deflate_writer_finish(&deflate, temp_allocator));
+    PG_RESULT(PgString, PgError)
+    res_all = test_inflate(PG_DYN_TO_SLICE(PgString, w.u.bytes),
+                           PG_DEFLATE_FORMAT_RAW, temp_allocator);
+    PG_ASSERT(pg_string_eq(PG_S("hello, hello world"), PG_UNWRAP(res_all)));
+    pg_arena_temp_end(temp);
+  }
+
+  // Produced by other implementations.
+  {
+    u8 gzip[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+        0x03, 0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0xc8,
+        0x40, 0xa2, 0x14, 0xca, 0xf3, 0x8b, 0x72, 0x52, 0xb8,
+        0x00, 0x87, 0x5d, 0x46, 0x2b, 0x1a, 0x00, 0x00, 0x00,
+    };
+    PG_RESULT(PgString, PgError)
+    res = test_inflate((PgString)PG_SLICE_FROM_C(gzip),
+                       PG_DEFLATE_FORMAT_GZIP, allocator);
+    PG_ASSERT(pg_string_eq(PG_S("hello, hello, hello world\n"),
+                           PG_UNWRAP(res)));
+
+    u8 zlib[] = {
+        0x78, 0x9c, 0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0xc8, 0x40, 0xa2,
+        0x14, 0xca, 0xf3, 0x8b, 0x72, 0x52, 0xb8, 0x00, 0x7d, 0xae, 0x09, 0x27,
+    };
+    res = test_inflate((PgString)PG_SLICE_FROM_C(zlib),
+                       PG_DEFLATE_FORMAT_ZLIB, allocator);
+    PG_ASSERT(pg_string_eq(PG_S("hello, hello, hello world\n"),
+                           PG_UNWRAP(res)));
+
+    // With a file name.
+    u8 gzip_name[] = {
+        0x1f, 0x8b, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff,
+        0x61, 0x2e, 0x74, 0x78, 0x74, 0x00, 0x4b, 0x4c, 0x4a, 0x06,
+        0x00, 0xc2, 0x41, 0x24, 0x35, 0x03, 0x00, 0x00, 0x00,
+    };
+    res = test_inflate((PgString)PG_SLICE_FROM_C(gzip_name),
+                       PG_DEFLATE_FORMAT_GZIP, allocator);
+    PG_ASSERT(pg_string_eq(PG_S("abc"), PG_UNWRAP(res)));
+
+    // Corrupted.
+    gzip[sizeof(gzip) - 8] ^= 1;
+    res = test_inflate((PgString)PG_SLICE_FROM_C(gzip),
+                       PG_DEFLATE_FORMAT_GZIP, allocator);
+    PG_ASSERT(PG_ERR_INVALID_VALUE == PG_UNWRAP_ERR(res));
+
+    zlib[1] ^= 1;
+    res = test_inflate((PgString)PG_SLICE_FROM_C(zlib),
+                       PG_DEFLATE_FORMAT_ZLIB, allocator);
+    PG_ASSERT(PG_ERR_INVALID_VALUE == PG_UNWRAP_ERR(res));
+
+    // Reserved block type.
+    res = test_inflate(PG_S("\x07"), PG_DEFLATE_FORMAT_RAW, allocator);
+    PG_ASSERT(PG_ERR_INVALID_VALUE == PG_UNWRAP_ERR(res));
+
+    // Truncated.
+    res = test_inflate((PgString){.data = gzip_name, .len = 20},
+                       PG_DEFLATE_FORMAT_GZIP, allocator);
+    PG_ASSERT(PG_ERR_IO == PG_UNWRAP_ERR(res));
+  }
+}
+
+[[nodiscard]] static PgHttpContentEncoding
+test_http_negotiate(PgString accept_encoding, PgAllocator *allocator) {
+  PgHttpHeaders headers = {0};
+  pg_http_push_header(&headers, PG_S("Accept-Encoding"), accept_encoding,
+                      allocator);
+  return pg_http_negotiate_content_encoding(&headers);
+}
+
+static void test_http_negotiate_content_encoding() {
+  PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_GZIP ==
+            test_http_negotiate(PG_S("gzip, deflate, br"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_GZIP ==
+            test_http_negotiate(PG_S("deflate, gzip"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_DEFLATE ==
+            test_http_negotiate(PG_S("deflate"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_DEFLATE ==
+            test_http_negotiate(PG_S("gzip;q=0.5, deflate"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_GZIP ==
+            test_http_negotiate(PG_S("GZIP ; Q=1.0"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_GZIP ==
+            test_http_negotiate(PG_S("x-gzip"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_GZIP ==
+            test_http_negotiate(PG_S("*"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_DEFLATE ==
+            test_http_negotiate(PG_S("*;q=0.1, gzip;q=0"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_IDENTITY ==
+            test_http_negotiate(PG_S("gzip;q=0"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_IDENTITY ==
+            test_http_negotiate(PG_S("gzip;q=2"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_IDENTITY ==
+            test_http_negotiate(PG_S("br, identity"), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_IDENTITY ==
+            test_http_negotiate(PG_S(""), allocator));
+  PG_ASSERT(PG_HTTP_CONTENT_ENCODING_IDENTITY ==
+            pg_http_negotiate_content_encoding(&(PgHttpHeaders){0}));
+
+  PG_ASSERT(pg_http_content_type_is_compressible(
+      PG_S("text/html; charset=utf-8")));
+  PG_ASSERT(pg_http_content_type_is_compressible(PG_S("image/svg+xml")));
+  PG_ASSERT(!pg_http_content_type_is_compressible(PG_S("image/png")));
+  PG_ASSERT(
+      !pg_http_content_type_is_compressible(PG_S("application/octet-stream")));
+}
+
+static void test_http_request_body_reader() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // `Content-Length`: the rest of the connection is left alone.
+  {
+    PgReader inner = pg_reader_make_from_bytes(PG_S("hello world"));
+    PgHttpHeaders headers = {0};
+    pg_http_push_header(&headers, PG_S("Content-Length"), PG_S("5"),
+                        allocator);
+    PG_RESULT(PgReader, PgError)
+    res_reader =
+        pg_http_request_body_reader(&headers, &inner, nullptr, allocator);
+    PgReader body = PG_UNWRAP(res_reader);
+
+    u8 buf[16] = {0};
+    PG_RESULT(u64, PgError) res = pg_reader_read(&body, buf, sizeof(buf));
+    PG_ASSERT(5 == PG_UNWRAP(res));
+    PG_ASSERT(pg_string_eq(PG_S("hello"), ((PgString){.data = buf, .len = 5})));
+    res = pg_reader_read(&body, buf, sizeof(buf));
+    PG_ASSERT(PG_ERR_EOF == PG_UNWRAP_ERR(res));
+    PG_ASSERT(pg_string_eq(PG_S(" world"), inner.u.bytes));
+  }
+  // No body.
+  {
+    PgReader inner = pg_reader_make_from_bytes(PG_S("GET"));
+    PG_RESULT(PgReader, PgError)
+    res_reader = pg_http_request_body_reader(&(PgHttpHeaders){0}, &inner,
+                                             nullptr, allocator);
+    PgReader body = PG_UNWRAP(res_reader);
+    u8 buf[16] = {0};
+    PG_RESULT(u64, PgError) res = pg_reader_read(&body, buf, sizeof(buf));
+    PG_ASSERT(PG_ERR_EOF == PG_UNWRAP_ERR(res));
+  }
+  // Unsupported transfer coding.
+  {
+    PgReader inner = pg_reader_make_from_bytes(PG_S(""));
+    PgHttpHeaders headers = {0};
+    pg_http_push_header(&headers, PG_S("Transfer-Encoding"), PG_S("gzip"),
+                        allocator);
+    PG_RESULT(PgReader, PgError)
+    res_reader =
+        pg_http_request_body_reader(&headers, &inner, nullptr, allocator);
+    PG_ASSERT(PG_ERR_INVALID_VALUE == PG_UNWRAP_ERR(res_reader));
+  }
+}
+
+static void test_http_date() {
+  u8 buf[PG_HTTP_DATE_LEN] = {0};
+  PgString s = {.data = buf, .len = PG_HTTP_DATE_LEN};
+
+  pg_http_date_format(0, buf);
+  PG_ASSERT(pg_string_eq(s, PG_S("Thu, 01 Jan 1970 00:00:00 GMT")));
+
+  pg_http_date_format(784111777, buf);
+  PG_ASSERT(pg_string_eq(s, PG_S("Sun, 06 Nov 1994 08:49:37 GMT")));
+  PG_ASSERT(784111777 == pg_http_date_parse(s).value);
+
+  // Leap day.
+  pg_http_date_format(951782400, buf);
+  PG_ASSERT(pg_string_eq(s, PG_S("Tue, 29 Feb 2000 00:00:00 GMT")));
+  PG_ASSERT(951782400 == pg_http_date_parse(s).value);
+
+  // Obsolete formats.
+  PG_ASSERT(!pg_http_date_parse(PG_S("Sunday, 06-Nov-94 08:49:37 GMT"))
+                 .has_value);
+  PG_ASSERT(
+      !pg_http_date_parse(PG_S("Sun Nov  6 08:49:37 1994")).has_value);
+  // Invalid.
+  PG_ASSERT(
+      !pg_http_date_parse(PG_S("Sun, 06 Foo 1994 08:49:37 GMT")).has_value);
+  PG_ASSERT(
+      !pg_http_date_parse(PG_S("Sun, 06 Nov 1994 24:49:37 GMT")).has_value);
+  PG_ASSERT(
+      !pg_http_date_parse(PG_S("Sun, 06 Nov 19x4 08:49:37 GMT")).has_value);
+}
+
+static void test_http_range_parse() {
+  {
+    PgHttpRange range = pg_http_range_parse(PG_S("bytes=0-4"), 10);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_SATISFIABLE == range.kind);
+    PG_ASSERT(0 == range.start);
+    PG_ASSERT(5 == range.end);
+  }
+  // Open ended.
+  {
+    PgHttpRange range = pg_http_range_parse(PG_S("bytes=3-"), 10);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_SATISFIABLE == range.kind);
+    PG_ASSERT(3 == range.start);
+    PG_ASSERT(10 == range.end);
+  }
+  // Last is clamped.
+  {
+    PgHttpRange range = pg_http_range_parse(PG_S("bytes=3-100"), 10);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_SATISFIABLE == range.kind);
+    PG_ASSERT(3 == range.start);
+    PG_ASSERT(10 == range.end);
+  }
+  // Suffix.
+  {
+    PgHttpRange range = pg_http_range_parse(PG_S("bytes=-4"), 10);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_SATISFIABLE == range.kind);
+    PG_ASSERT(6 == range.start);
+    PG_ASSERT(10 == range.end);
+
+    range = pg_http_range_parse(PG_S("bytes=-100"), 10);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_SATISFIABLE == range.kind);
+    PG_ASSERT(0 == range.start);
+    PG_ASSERT(10 == range.end);
+  }
+  // Unsatisfiable.
+  {
+    PG_ASSERT(PG_HTTP_RANGE_KIND_UNSATISFIABLE ==
+              pg_http_range_parse(PG_S("bytes=10-"), 10).kind);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_UNSATISFIABLE ==
+              pg_http_range_parse(PG_S("bytes=-0"), 10).kind);
+  }
+  // Ignored.
+  {
+    PG_ASSERT(PG_HTTP_RANGE_KIND_NONE ==
+              pg_http_range_parse(PG_S("bytes=0-1,4-5"), 10).kind);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_NONE ==
+              pg_http_range_parse(PG_S("bytes=4-1"), 10).kind);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_NONE ==
+              pg_http_range_parse(PG_S("items=0-1"), 10).kind);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_NONE ==
+              pg_http_range_parse(PG_S("bytes=a-1"), 10).kind);
+    PG_ASSERT(PG_HTTP_RANGE_KIND_NONE ==
+              pg_http_range_parse(PG_S("bytes=-"), 10).kind);
+  }
+}
+
+[[nodiscard]] static PgString
+test_http_file_serve_request(PgHttpFileCache *cache, PgHttpMethod method,
+                             PgString path, PgString header_key,
+                             PgString header_value, PgAllocator *allocator) {
+  PgHttpServerRequest req = {.method = method};
+  req.target.path = path;
+  if (!pg_string_is_empty(header_key)) {
+    pg_http_push_header(&req.headers, header_key, header_value, allocator);
+  }
+
+  PgWriter w = pg_writer_make_string_builder(512, allocator);
+  PG_ASSERT(0 == pg_http_file_serve(cache, req, &w, allocator));
+  return PG_DYN_TO_SLICE(PgString, w.u.bytes);
+}
+
+static void test_http_file_serve() {
+  PgArena arena = pg_arena_make_from_virtual_mem(1 * PG_MiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgString path = PG_S(".test_static.txt");
+  PG_ASSERT(0 ==
+            pg_file_write_full(path, PG_S("hello world"), 0600, allocator));
+
+  PgHttpFileCache cache = pg_http_file_cache_make(PG_S("."), PG_Seconds * 3600,
+                                                  allocator);
+
+  // Cached.
+  PG_RESULT(PgHttpFilePtr, PgError)
+  res_file = pg_http_file_cache_get(&cache, path);
+  PgHttpFile *file = PG_UNWRAP(res_file);
+  res_file = pg_http_file_cache_get(&cache, path);
+  PG_ASSERT(file == PG_UNWRAP(res_file));
+  PG_ASSERT(11 == file->stat.size);
+  // Copied since revalidating updates them in place.
+  PgString etag = pg_string_clone(pg_http_file_etag(file), allocator);
+  PgString last_modified =
+      pg_string_clone(pg_http_file_last_modified(file), allocator);
+
+  {
+    PgString res = test_http_file_serve_request(
+        &cache, PG_HTTP_METHOD_GET, path, PG_S(""), PG_S(""), allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 200\r\n")));
+    PG_ASSERT(pg_string_contains(res, PG_S("Content-Length: 11\r\n")));
+    PG_ASSERT(pg_string_contains(
+        res, PG_S("Content-Type: text/plain; charset=utf-8\r\n")));
+    PG_ASSERT(pg_string_contains(res, etag));
+    PG_ASSERT(pg_string_contains(res, last_modified));
+    PG_ASSERT(pg_string_ends_with(res, PG_S("\r\n\r\nhello world")));
+  }
+  {
+    PgString res = test_http_file_serve_request(
+        &cache, PG_HTTP_METHOD_HEAD, path, PG_S(""), PG_S(""), allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 200\r\n")));
+    PG_ASSERT(pg_string_contains(res, PG_S("Content-Length: 11\r\n")));
+    PG_ASSERT(pg_string_ends_with(res, PG_S("\r\n\r\n")));
+  }
+  // Conditional.
+  {
+    PgString res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET,
+                                                path, PG_S("If-None-Match"),
+                                                etag, allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 304\r\n")));
+    PG_ASSERT(pg_string_ends_with(res, PG_S("\r\n\r\n")));
+
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET, path,
+                                       PG_S("If-None-Match"),
+                                       PG_S("\"foo\", W/\"bar\""), allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 200\r\n")));
+
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET, path,
+                                       PG_S("If-Modified-Since"),
+                                       last_modified, allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 304\r\n")));
+
+    res = test_http_file_serve_request(
+        &cache, PG_HTTP_METHOD_GET, path, PG_S("If-Modified-Since"),
+        PG_S("Thu, 01 Jan 1970 00:00:00 GMT"), allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 200\r\n")));
+  }
+  // Range.
+  {
+    PgString res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET,
+                                                path, PG_S("Range"),
+                                                PG_S("bytes=-5"), allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 206\r\n")));
+    PG_ASSERT(
+        pg_string_contains(res, PG_S("Content-Range: bytes 6-10/11\r\n")));
+    PG_ASSERT(pg_string_contains(res, PG_S("Content-Length: 5\r\n")));
+    PG_ASSERT(pg_string_ends_with(res, PG_S("\r\n\r\nworld")));
+
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET, path,
+                                       PG_S("Range"), PG_S("bytes=20-"),
+                                       allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 416\r\n")));
+    PG_ASSERT(pg_string_contains(res, PG_S("Content-Range: bytes */11\r\n")));
+    PG_ASSERT(pg_string_ends_with(res, PG_S("\r\n\r\n")));
+  }
+  // Errors.
+  {
+    PgString res = test_http_file_serve_request(
+        &cache, PG_HTTP_METHOD_GET, PG_S(".."), PG_S(""), PG_S(""), allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 404\r\n")));
+
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET,
+                                       PG_S("%2E%2E"), PG_S(""), PG_S(""),
+                                       allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 404\r\n")));
+
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET,
+                                       PG_S(".test_static_missing"), PG_S(""),
+                                       PG_S(""), allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 404\r\n")));
+
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_POST, path,
+                                       PG_S(""), PG_S(""), allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 405\r\n")));
+  }
+  // Modified: picked up once revalidated.
+  {
+    PG_ASSERT(0 ==
+              pg_file_write_full(path, PG_S("hello, world"), 0600, allocator));
+    cache.revalidate_after_ns = 0;
+
+    res_file = pg_http_file_cache_get(&cache, path);
+    PG_ASSERT(file == PG_UNWRAP(res_file));
+    PG_ASSERT(12 == file->stat.size);
+    PG_ASSERT(!pg_string_eq(etag, pg_http_file_etag(file)));
+  }
+
+#ifdef PG_OS_LINUX
+  // `sendfile(2)` to a socket.
+  {
+    int fds[2] = {0};
+    PG_ASSERT(0 == socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+    PgHttpServerRequest req = {.method = PG_HTTP_METHOD_GET};
+    req.target.path = path;
+    pg_http_push_header(&req.headers, PG_S("Range"), PG_S("bytes=7-"),
+                        allocator);
+
+    PgFileDescriptor sock = {.fd = fds[0]};
+    PgWriter w = pg_writer_make_from_socket(sock, 512, allocator);
+    PG_ASSERT(0 == pg_http_file_serve(&cache, req, &w, allocator));
+    PG_ASSERT(0 == pg_net_socket_close(sock));
+
+    PgFileDescriptor peer = {.fd = fds[1]};
+    PG_RESULT(PgString, PgError)
+    res_read =
+        pg_file_read_full_from_descriptor_until_eof(peer, 512, allocator);
+    PgString res = PG_UNWRAP(res_read);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 206\r\n")));
+    PG_ASSERT(pg_string_ends_with(res, PG_S("\r\n\r\nworld")));
+    PG_ASSERT(0 == pg_net_socket_close(peer));
+  }
+#endif
+
+  // Compressed when accepted.
+  {
+    PgString html_path = PG_S(".test_static.html");
+    PG_DYN(u8) sb = pg_string_builder_make(4 * PG_KiB, allocator);
+    for (u64 i = 0; i < 100; i++) {
+      PG_DYN_APPEND_SLICE(&sb, PG_S("<p>hello world</p>\n"), allocator);
+    }
+    PgString html = PG_DYN_TO_SLICE(PgString, sb);
+    PG_ASSERT(0 == pg_file_write_full(html_path, html, 0600, allocator));
+
+    PgString res = test_http_file_serve_request(
+        &cache, PG_HTTP_METHOD_GET, html_path, PG_S("Accept-Encoding"),
+        PG_S("gzip, deflate"), allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 200\r\n")));
+    PG_ASSERT(pg_string_contains(res, PG_S("Content-Encoding: gzip\r\n")));
+    PG_ASSERT(pg_string_contains(res, PG_S("Vary: Accept-Encoding\r\n")));
+    PG_ASSERT(pg_string_contains(res, PG_S("-gzip\"\r\n")));
+    PG_ASSERT(!pg_string_contains(res, PG_S("Content-Length")));
+
+    PgStringCut cut = pg_string_cut_string(res, PG_S("\r\n\r\n"));
+    PG_ASSERT(cut.has_value);
+    PG_ASSERT(cut.right.len < html.len / 4);
+    PgReader inner = pg_reader_make_from_bytes(cut.right);
+    PgReader chunked = pg_http_chunked_reader_make(&inner, nullptr, allocator);
+    PgReader inflate =
+        pg_inflate_reader_make(&chunked, PG_DEFLATE_FORMAT_GZIP, allocator);
+    PgString body = pg_string_make(html.len, allocator);
+    PG_ASSERT(0 == pg_reader_read_slice_full(&inflate, body));
+    PG_ASSERT(pg_string_eq(html, body));
+
+    // Revalidated with the ETag of the compressed representation.
+    PgStringCut etag_cut = pg_string_cut_string(res, PG_S("ETag: "));
+    PG_ASSERT(etag_cut.has_value);
+    PgString gzip_etag =
+        pg_string_cut_string(etag_cut.right, PG_S("\r\n")).left;
+    PgHttpServerRequest req = {.method = PG_HTTP_METHOD_GET};
+    req.target.path = html_path;
+    pg_http_push_header(&req.headers, PG_S("Accept-Encoding"), PG_S("gzip"),
+                        allocator);
+    pg_http_push_header(&req.headers, PG_S("If-None-Match"), gzip_etag,
+                        allocator);
+    PgWriter w = pg_writer_make_string_builder(512, allocator);
+    PG_ASSERT(0 == pg_http_file_serve(&cache, req, &w, allocator));
+    PG_ASSERT(pg_string_starts_with(PG_DYN_TO_SLICE(PgString, w.u.bytes),
+                                    PG_S("HTTP/1.1 304\r\n")));
+
+    // Ranges are served as is.
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET, html_path,
+                                       PG_S("Range"), PG_S("bytes=0-2"),
+                                       allocator);
+    PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 206\r\n")));
+    PG_ASSERT(!pg_string_contains(res, PG_S("Content-Encoding")));
+    PG_ASSERT(pg_string_ends_with(res, PG_S("\r\n\r\n<p>")));
+
+    PG_ASSERT(0 == unlink(".test_static.html"));
+  }
+
+  pg_http_file_cache_close(&cache);
+  PG_ASSERT(0 == unlink(".test_static.txt"));
+}
+
+#ifdef PG_OS_LINUX
+[[nodiscard]] static PgString test_http_file_cache_html(u64 paragraphs,
+                                                       PgString text,
+                                                       PgAllocator *allocator) {
+  PG_DYN(u8) sb = pg_string_builder_make(4 * PG_KiB, allocator);
+  for (u64 i = 0; i < paragraphs; i++) {
+    PG_DYN_APPEND_SLICE(&sb, PG_S("<p>"), allocator);
+    PG_DYN_APPEND_SLICE(&sb, text, allocator);
+    PG_DYN_APPEND_SLICE(&sb, PG_S("</p>\n"), allocator);
+  }
+  return PG_DYN_TO_SLICE(PgString, sb);
+}
+
+// A gzip response with a length, of `expected` once decompressed.
+static void test_http_file_cache_check_gzip(PgString res, PgString expected,
+                                            PgAllocator *allocator) {
+  PG_ASSERT(pg_string_starts_with(res, PG_S("HTTP/1.1 200\r\n")));
+  PG_ASSERT(pg_string_contains(res, PG_S("Content-Encoding: gzip\r\n")));
+  PG_ASSERT(!pg_string_contains(res, PG_S("Transfer-Encoding")));
+
+  PgStringCut cut = pg_string_cut_string(res, PG_S("\r\n\r\n"));
+  PG_ASSERT(cut.has_value);
+  PgString content_length = pg_string_concat(
+      PG_S("Content-Length: "), pg_u64_to_string(cut.right.len, allocator),
+      allocator);
+  PG_ASSERT(pg_string_contains(cut.left, content_length));
+
+  PgReader inner = pg_reader_make_from_bytes(cut.right);
+  PgReader inflate =
+      pg_inflate_reader_make(&inner, PG_DEFLATE_FORMAT_GZIP, allocator);
+  PgString body = pg_string_make(expected.len, allocator);
+  PG_ASSERT(0 == pg_reader_read_slice_full(&inflate, body));
+  PG_ASSERT(pg_string_eq(expected, body));
+}
+
+static void test_http_file_cache_gzip() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_MiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PG_ASSERT(0 == mkdir(".test_static_gzip", 0700));
+  PG_ASSERT(0 == mkdir(".test_static_gzip/sub", 0700));
+  PgString a = test_http_file_cache_html(100, PG_S("hello world"), allocator);
+  PgString b = test_http_file_cache_html(200, PG_S("foo bar"), allocator);
+  PG_ASSERT(0 == pg_file_write_full(PG_S(".test_static_gzip/a.html"), a,
+                                    0600, allocator));
+  PG_ASSERT(0 == pg_file_write_full(PG_S(".test_static_gzip/sub/b.html"), b,
+                                    0600, allocator));
+  PG_ASSERT(0 == pg_file_write_full(PG_S(".test_static_gzip/small.txt"),
+                                    PG_S("hello"), 0600, allocator));
+
+  PgHttpFileCache cache = pg_http_file_cache_make(
+      PG_S(".test_static_gzip"), PG_Seconds * 3600, allocator);
+  cache.gzip_max_bytes = 1 * PG_MiB;
+  PG_ASSERT(0 == pg_http_file_cache_watch(&cache));
+  PG_ASSERT(0 == pg_http_file_cache_preload(&cache));
+
+  PgHttpFile *file_a =
+      PG_UNWRAP(pg_http_file_cache_get(&cache, PG_S("a.html")));
+  PgHttpFile *file_b =
+      PG_UNWRAP(pg_http_file_cache_get(&cache, PG_S("sub/b.html")));
+  PgHttpFile *file_small =
+      PG_UNWRAP(pg_http_file_cache_get(&cache, PG_S("small.txt")));
+  PG_ASSERT(file_a->gzip);
+  PG_ASSERT(file_b->gzip);
+  PG_ASSERT(!file_small->gzip);
+  PG_ASSERT(cache.gzip_bytes == file_a->gzip_len + file_b->gzip_len);
+  PG_ASSERT(file_a->gzip_len < a.len / 4);
+
+  // Sent with its length.
+  {
+    PgString res = test_http_file_serve_request(
+        &cache, PG_HTTP_METHOD_GET, PG_S("a.html"), PG_S("Accept-Encoding"),
+        PG_S("gzip"), allocator);
+    PG_ASSERT(pg_string_contains(res, PG_S("-gzip\"\r\n")));
+    test_http_file_cache_check_gzip(res, a, allocator);
+
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_HEAD,
+                                       PG_S("a.html"), PG_S("Accept-Encoding"),
+                                       PG_S("gzip"), allocator);
+    PgString content_length = pg_string_concat(
+        PG_S("Content-Length: "),
+        pg_u64_to_string(file_a->gzip_len, allocator), allocator);
+    PG_ASSERT(pg_string_contains(res, content_length));
+    PG_ASSERT(pg_string_ends_with(res, PG_S("\r\n\r\n")));
+
+    // Other codings are still compressed on the fly.
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET,
+                                       PG_S("a.html"), PG_S("Accept-Encoding"),
+                                       PG_S("deflate"), allocator);
+    PG_ASSERT(pg_string_contains(res, PG_S("Transfer-Encoding: chunked\r\n")));
+  }
+  // `sendfile(2)` to a socket.
+  {
+    int fds[2] = {0};
+    PG_ASSERT(0 == socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+    PgHttpServerRequest req = {.method = PG_HTTP_METHOD_GET};
+    req.target.path = PG_S("/sub/b.html");
+    pg_http_push_header(&req.headers, PG_S("Accept-Encoding"), PG_S("gzip"),
+                        allocator);
+
+    PgFileDescriptor sock = {.fd = fds[0]};
+    PgWriter w = pg_writer_make_from_socket(sock, 512, allocator);
+    PG_ASSERT(0 == pg_http_file_serve(&cache, req, &w, allocator));
+    PG_ASSERT(0 == pg_net_socket_close(sock));
+
+    PgFileDescriptor peer = {.fd = fds[1]};
+    PG_RESULT(PgString, PgError)
+    res_read =
+        pg_file_read_full_from_descriptor_until_eof(peer, 512, allocator);
+    PgString res = PG_UNWRAP(res_read);
+    test_http_file_cache_check_gzip(res, b, allocator);
+    PG_ASSERT(0 == pg_net_socket_close(peer));
+  }
+  // Modified, and replaced by a rename: compressed again once refreshed.
+  {
+    a = test_http_file_cache_html(120, PG_S("hello, world"), allocator);
+    PG_ASSERT(0 == pg_file_write_full(PG_S(".test_static_gzip/a.html"), a,
+                                      0600, allocator));
+    b = test_http_file_cache_html(150, PG_S("foo, bar"), allocator);
+    PG_ASSERT(0 == pg_file_write_full(PG_S(".test_static_gzip/sub/b.tmp"), b,
+                                      0600, allocator));
+    PG_ASSERT(0 == rename(".test_static_gzip/sub/b.tmp",
+                          ".test_static_gzip/sub/b.html"));
+
+    // One file compressed again per call, in the order of the changes.
+    PG_ASSERT(0 == pg_http_file_cache_refresh(&cache));
+    PG_ASSERT(file_a->open && file_a->gzip);
+    PG_ASSERT(file_a->stat.size == a.len);
+    PG_ASSERT(!file_b->gzip);
+    PG_ASSERT(1 == cache.refresh_pending.len);
+
+    // Meanwhile, compressed on the fly.
+    PgString res = test_http_file_serve_request(
+        &cache, PG_HTTP_METHOD_GET, PG_S("sub/b.html"),
+        PG_S("Accept-Encoding"), PG_S("gzip"), allocator);
+    PG_ASSERT(pg_string_contains(res, PG_S("Transfer-Encoding: chunked\r\n")));
+    PG_ASSERT(!file_b->gzip);
+
+    PG_ASSERT(0 == pg_http_file_cache_refresh(&cache));
+    PG_ASSERT(file_b->open && file_b->gzip);
+    PG_ASSERT(file_b->stat.size == b.len);
+    PG_ASSERT(0 == cache.refresh_pending.len);
+
+    res = test_http_file_serve_request(&cache, PG_HTTP_METHOD_GET,
+                                       PG_S("a.html"), PG_S("Accept-Encoding"),
+                                       PG_S("gzip"), allocator);
+    test_http_file_cache_check_gzip(res, a, allocator);
+
+    // Nothing pending.
+    PG_ASSERT(0 == pg_http_file_cache_refresh(&cache));
+    PG_ASSERT(file_a->gzip && file_b->gzip);
+  }
+  // Least recently used evicted first.
+  {
+    cache.gzip_max_bytes = cache.gzip_bytes - 1;
+    PG_ASSERT(0 == pg_file_write_full(PG_S(".test_static_gzip/a.html"), a,
+                                      0600, allocator));
+    PG_ASSERT(0 == pg_http_file_cache_refresh(&cache));
+    PG_ASSERT(file_a->gzip);
+    PG_ASSERT(!file_b->gzip);
+    PG_ASSERT(cache.gzip_bytes == file_a->gzip_len);
+
+    PG_ASSERT(0 == pg_http_file_cache_store(&cache, file_b));
+    PG_ASSERT(!file_a->gzip);
+    PG_ASSERT(file_b->gzip);
+    PG_ASSERT(cache.gzip_bytes == file_b->gzip_len);
+  }
+  // Given up as soon as the output exceeds the budget.
+  {
+    u64 gzip_max_bytes = cache.gzip_max_bytes;
+    cache.gzip_max_bytes = 16;
+    PG_ASSERT(0 == pg_http_file_cache_store(&cache, file_a));
+    PG_ASSERT(!file_a->gzip);
+    PG_ASSERT(file_b->gzip);
+    cache.gzip_max_bytes = gzip_max_bytes;
+  }
+
+  pg_http_file_cache_close(&cache);
+  PG_ASSERT(0 == unlink(".test_static_gzip/a.html"));
+  PG_ASSERT(0 == unlink(".test_static_gzip/sub/b.html"));
+  PG_ASSERT(0 == unlink(".test_static_gzip/small.txt"));
+  PG_ASSERT(0 == rmdir(".test_static_gzip/sub"));
+  PG_ASSERT(0 == rmdir(".test_static_gzip"));
+}
+#endif
+
 static void test_http_parse_response_status_line() {
   // Empty.
   {
@@ -1420,118 +2673,109 @@ static void test_http_parse_response_status_line() {
 }
 
 static void test_http_parse_request_status_line() {
-  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
-  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
-  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
-
   // Empty.
   {
-    PG_ASSERT(
-        PG_ERR_INVALID_VALUE ==
-        PG_UNWRAP_ERR(pg_http_parse_request_status_line(PG_S(""), allocator)));
+    PG_ASSERT(PG_ERR_INVALID_VALUE ==
+              PG_UNWRAP_ERR(pg_http_parse_request_status_line(PG_S(""))));
   }
   // Missing prefix.
   {
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
-              PG_UNWRAP_ERR(
-                  pg_http_parse_request_status_line(PG_S("GE"), allocator)));
+              PG_UNWRAP_ERR(pg_http_parse_request_status_line(PG_S("GE"))));
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
-              PG_UNWRAP_ERR(
-                  pg_http_parse_request_status_line(PG_S("abc"), allocator)));
+              PG_UNWRAP_ERR(pg_http_parse_request_status_line(PG_S("abc"))));
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
-              PG_UNWRAP_ERR(
-                  pg_http_parse_request_status_line(PG_S("123 "), allocator)));
+              PG_UNWRAP_ERR(pg_http_parse_request_status_line(PG_S("123 "))));
   }
   // Missing slash.
   {
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
-              PG_UNWRAP_ERR(pg_http_parse_request_status_line(
-                  PG_S("GET HTTP1.1"), allocator)));
+              PG_UNWRAP_ERR(
+                  pg_http_parse_request_status_line(PG_S("GET HTTP1.1"))));
   }
   // Missing major version.
   {
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
-              PG_UNWRAP_ERR(pg_http_parse_request_status_line(
-                  PG_S("GET / HTTP/.1"), allocator)));
+              PG_UNWRAP_ERR(
+                  pg_http_parse_request_status_line(PG_S("GET / HTTP/.1"))));
   }
   // Missing `.`.
   {
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
-              PG_UNWRAP_ERR(pg_http_parse_request_status_line(
-                  PG_S("GET / HTTP/11"), allocator)));
+              PG_UNWRAP_ERR(
+                  pg_http_parse_request_status_line(PG_S("GET / HTTP/11"))));
   }
   // Missing minor version.
   {
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
-              PG_UNWRAP_ERR(pg_http_parse_request_status_line(
-                  PG_S("GET / HTTP/1."), allocator)));
+              PG_UNWRAP_ERR(
+                  pg_http_parse_request_status_line(PG_S("GET / HTTP/1."))));
   }
   // Invalid major version.
   {
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
-              PG_UNWRAP_ERR(pg_http_parse_request_status_line(
-                  PG_S("GET / HTTP/abc.1"), allocator)));
+              PG_UNWRAP_ERR(
+                  pg_http_parse_request_status_line(PG_S("GET / HTTP/abc.1"))));
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
-              PG_UNWRAP_ERR(pg_http_parse_request_status_line(
-                  PG_S("GET / HTTP/4.1"), allocator)));
+              PG_UNWRAP_ERR(
+                  pg_http_parse_request_status_line(PG_S("GET / HTTP/4.1"))));
   }
   // Invalid minor version.
+  {
+    PG_ASSERT(PG_ERR_INVALID_VALUE ==
+              PG_UNWRAP_ERR(
+                  pg_http_parse_request_status_line(PG_S("GET / HTTP/1.10"))));
+  }
+  // Invalid path.
   {
     PG_ASSERT(PG_ERR_INVALID_VALUE ==
               PG_UNWRAP_ERR(pg_http_parse_request_status_line(
-                  PG_S("GET / HTTP/1.10"), allocator)));
+                  PG_S("GET /a:b HTTP/1.1"))));
   }
   // Valid, short.
   {
     PG_RESULT(PgHttpRequestStatusLine, PgError)
-    res = pg_http_parse_request_status_line(PG_S("GET / HTTP/2.0"), allocator);
+    res = pg_http_parse_request_status_line(PG_S("GET / HTTP/2.0"));
     PgHttpRequestStatusLine status_line = PG_UNWRAP(res);
     PG_ASSERT(PG_HTTP_METHOD_GET == status_line.method);
     PG_ASSERT(2 == status_line.version_major);
     PG_ASSERT(0 == status_line.version_minor);
-    PG_ASSERT(0 == status_line.url.path_components.len);
-    PG_ASSERT(0 == status_line.url.query_parameters.len);
+    PG_ASSERT(pg_string_eq(status_line.url.path, PG_S("/")));
+    PG_ASSERT(pg_string_is_empty(status_line.url.query));
   }
   // Valid, short with query parameters.
   {
     PG_RESULT(PgHttpRequestStatusLine, PgError)
-    res = pg_http_parse_request_status_line(PG_S("GET /?foo=bar& HTTP/2.0"),
-                                            allocator);
+    res = pg_http_parse_request_status_line(PG_S("GET /?foo=bar& HTTP/2.0"));
     PgHttpRequestStatusLine status_line = PG_UNWRAP(res);
     PG_ASSERT(PG_HTTP_METHOD_GET == status_line.method);
     PG_ASSERT(2 == status_line.version_major);
     PG_ASSERT(0 == status_line.version_minor);
-    PG_ASSERT(0 == status_line.url.path_components.len);
-    PG_ASSERT(1 == status_line.url.query_parameters.len);
-    PgStringKeyValue kv0 = PG_SLICE_AT(status_line.url.query_parameters, 0);
-    PG_ASSERT(pg_string_eq(kv0.key, PG_S("foo")));
-    PG_ASSERT(pg_string_eq(kv0.value, PG_S("bar")));
+    PG_ASSERT(pg_string_eq(status_line.url.path, PG_S("/")));
+    PG_ASSERT(pg_string_eq(status_line.url.query, PG_S("foo=bar&")));
   }
   // Valid, short, 0.9.
   {
     PG_RESULT(PgHttpRequestStatusLine, PgError)
-    res = pg_http_parse_request_status_line(PG_S("GET / HTTP/0.9"), allocator);
+    res = pg_http_parse_request_status_line(PG_S("GET / HTTP/0.9"));
     PgHttpRequestStatusLine status_line = PG_UNWRAP(res);
     PG_ASSERT(PG_HTTP_METHOD_GET == status_line.method);
     PG_ASSERT(0 == status_line.version_major);
     PG_ASSERT(9 == status_line.version_minor);
-    PG_ASSERT(0 == status_line.url.path_components.len);
-    PG_ASSERT(0 == status_line.url.query_parameters.len);
+    PG_ASSERT(pg_string_eq(status_line.url.path, PG_S("/")));
+    PG_ASSERT(pg_string_is_empty(status_line.url.query));
   }
   // Valid, long.
   {
     PG_RESULT(PgHttpRequestStatusLine, PgError)
     res = pg_http_parse_request_status_line(
-        PG_S("GET /foo/bar/baz?hey HTTP/1.1"), allocator);
+        PG_S("GET /foo/bar/baz?hey HTTP/1.1"));
     PgHttpRequestStatusLine status_line = PG_UNWRAP(res);
     PG_ASSERT(PG_HTTP_METHOD_GET == status_line.method);
     PG_ASSERT(1 == status_line.version_major);
     PG_ASSERT(1 == status_line.version_minor);
-    PG_ASSERT(3 == status_line.url.path_components.len);
-    PG_ASSERT(1 == status_line.url.query_parameters.len);
-    PgStringKeyValue kv0 = PG_SLICE_AT(status_line.url.query_parameters, 0);
-    PG_ASSERT(pg_string_eq(kv0.key, PG_S("hey")));
-    PG_ASSERT(pg_string_eq(kv0.value, PG_S("")));
+    PG_ASSERT(pg_string_eq(status_line.url.path, PG_S("/foo/bar/baz")));
+    PG_ASSERT(pg_string_eq(status_line.url.query, PG_S("hey")));
   }
 }
 
@@ -1613,35 +2857,40 @@ static void test_http_read_request_full_no_content_length() {
   PG_ASSERT(!res_req.err);
   PG_ASSERT(res_req.done);
 
-  PgHttpRequest req = res_req.req;
+  PgHttpServerRequest req = res_req.req;
+  PG_RESULT(PgUrl, PgError) res_url = pg_http_request_url(req, allocator);
+  PgUrl url = PG_UNWRAP(res_url);
   PG_ASSERT(PG_HTTP_METHOD_PUT == req.method);
-  PG_ASSERT(!req.url.scheme.len);
-  PG_ASSERT(!req.url.username.len);
-  PG_ASSERT(!req.url.password.len);
-  PG_ASSERT(!req.url.host.len);
-  PG_ASSERT(!req.url.port);
+  PG_ASSERT(!url.scheme.len);
+  PG_ASSERT(!url.username.len);
+  PG_ASSERT(!url.password.len);
+  PG_ASSERT(!url.host.len);
+  PG_ASSERT(!url.port);
   PG_ASSERT(1 == req.version_major);
   PG_ASSERT(1 == req.version_minor);
-  PG_ASSERT(2 == req.headers.len);
-  PG_ASSERT(3 == req.url.path_components.len);
-  PG_ASSERT(2 == req.url.query_parameters.len);
+  PG_ASSERT(2 == req.headers.entries.len);
+  PG_ASSERT(3 == url.path_components.len);
+  PG_ASSERT(2 == url.query_parameters.len);
 
-  PgStringKeyValue header0 = PG_SLICE_AT(req.headers, 0);
-  PgStringKeyValue header1 = PG_SLICE_AT(req.headers, 1);
+  PgHttpHeader header0 = PG_SLICE_AT(req.headers.entries, 0);
+  PgHttpHeader header1 = PG_SLICE_AT(req.headers.entries, 1);
   PG_ASSERT(pg_string_eq(PG_S("Accept"), header0.key));
   PG_ASSERT(pg_string_eq(PG_S("application/json"), header0.value));
   PG_ASSERT(pg_string_eq(PG_S("Content-Type"), header1.key));
   PG_ASSERT(pg_string_eq(PG_S("text/html"), header1.value));
+  PG_ASSERT(PG_HTTP_HEADER_ID_CONTENT_TYPE == header1.id);
+  PG_ASSERT(pg_string_eq(
+      PG_S("text/html"),
+      pg_http_headers_get(&req.headers, PG_S("content-type")).value));
 
+  PG_ASSERT(pg_string_eq(PG_S("info"), PG_SLICE_AT(url.path_components, 0)));
   PG_ASSERT(
-      pg_string_eq(PG_S("info"), PG_SLICE_AT(req.url.path_components, 0)));
-  PG_ASSERT(
-      pg_string_eq(PG_S("download"), PG_SLICE_AT(req.url.path_components, 1)));
+      pg_string_eq(PG_S("download"), PG_SLICE_AT(url.path_components, 1)));
   PG_ASSERT(
-      pg_string_eq(PG_S("index.mp3"), PG_SLICE_AT(req.url.path_components, 2)));
+      pg_string_eq(PG_S("index.mp3"), PG_SLICE_AT(url.path_components, 2)));
 
-  PgStringKeyValue query_param0 = PG_SLICE_AT(req.url.query_parameters, 0);
-  PgStringKeyValue query_param1 = PG_SLICE_AT(req.url.query_parameters, 1);
+  PgStringKeyValue query_param0 = PG_SLICE_AT(url.query_parameters, 0);
+  PgStringKeyValue query_param1 = PG_SLICE_AT(url.query_parameters, 1);
   PG_ASSERT(pg_string_eq(PG_S("foo"), query_param0.key));
   PG_ASSERT(pg_string_eq(PG_S("bar"), query_param0.value));
   PG_ASSERT(pg_string_eq(PG_S("baz"), query_param1.key));
@@ -1681,28 +2930,29 @@ static void test_http_read_request_full_without_headers() {
   PG_ASSERT(!res_req.err);
   PG_ASSERT(res_req.done);
 
-  PgHttpRequest req = res_req.req;
+  PgHttpServerRequest req = res_req.req;
+  PG_RESULT(PgUrl, PgError) res_url = pg_http_request_url(req, allocator);
+  PgUrl url = PG_UNWRAP(res_url);
   PG_ASSERT(PG_HTTP_METHOD_PUT == req.method);
-  PG_ASSERT(!req.url.scheme.len);
-  PG_ASSERT(!req.url.username.len);
-  PG_ASSERT(!req.url.password.len);
-  PG_ASSERT(!req.url.host.len);
-  PG_ASSERT(!req.url.port);
+  PG_ASSERT(!url.scheme.len);
+  PG_ASSERT(!url.username.len);
+  PG_ASSERT(!url.password.len);
+  PG_ASSERT(!url.host.len);
+  PG_ASSERT(!url.port);
   PG_ASSERT(1 == req.version_major);
   PG_ASSERT(1 == req.version_minor);
-  PG_ASSERT(0 == req.headers.len);
-  PG_ASSERT(3 == req.url.path_components.len);
-  PG_ASSERT(2 == req.url.query_parameters.len);
+  PG_ASSERT(0 == req.headers.entries.len);
+  PG_ASSERT(3 == url.path_components.len);
+  PG_ASSERT(2 == url.query_parameters.len);
 
+  PG_ASSERT(pg_string_eq(PG_S("info"), PG_SLICE_AT(url.path_components, 0)));
   PG_ASSERT(
-      pg_string_eq(PG_S("info"), PG_SLICE_AT(req.url.path_components, 0)));
+      pg_string_eq(PG_S("download"), PG_SLICE_AT(url.path_components, 1)));
   PG_ASSERT(
-      pg_string_eq(PG_S("download"), PG_SLICE_AT(req.url.path_components, 1)));
-  PG_ASSERT(
-      pg_string_eq(PG_S("index.mp3"), PG_SLICE_AT(req.url.path_components, 2)));
+      pg_string_eq(PG_S("index.mp3"), PG_SLICE_AT(url.path_components, 2)));
 
-  PgStringKeyValue query_param0 = PG_SLICE_AT(req.url.query_parameters, 0);
-  PgStringKeyValue query_param1 = PG_SLICE_AT(req.url.query_parameters, 1);
+  PgStringKeyValue query_param0 = PG_SLICE_AT(url.query_parameters, 0);
+  PgStringKeyValue query_param1 = PG_SLICE_AT(url.query_parameters, 1);
   PG_ASSERT(pg_string_eq(PG_S("foo"), query_param0.key));
   PG_ASSERT(pg_string_eq(PG_S("bar"), query_param0.value));
   PG_ASSERT(pg_string_eq(PG_S("baz"), query_param1.key));
@@ -1750,28 +3000,29 @@ static void test_http_read_request_full_without_body() {
   PG_ASSERT(!res_req.err);
   PG_ASSERT(res_req.done);
 
-  PgHttpRequest req = res_req.req;
+  PgHttpServerRequest req = res_req.req;
+  PG_RESULT(PgUrl, PgError) res_url = pg_http_request_url(req, allocator);
+  PgUrl url = PG_UNWRAP(res_url);
   PG_ASSERT(PG_HTTP_METHOD_PUT == req.method);
-  PG_ASSERT(!req.url.scheme.len);
-  PG_ASSERT(!req.url.username.len);
-  PG_ASSERT(!req.url.password.len);
-  PG_ASSERT(!req.url.host.len);
-  PG_ASSERT(!req.url.port);
+  PG_ASSERT(!url.scheme.len);
+  PG_ASSERT(!url.username.len);
+  PG_ASSERT(!url.password.len);
+  PG_ASSERT(!url.host.len);
+  PG_ASSERT(!url.port);
   PG_ASSERT(1 == req.version_major);
   PG_ASSERT(1 == req.version_minor);
-  PG_ASSERT(0 == req.headers.len);
-  PG_ASSERT(3 == req.url.path_components.len);
-  PG_ASSERT(2 == req.url.query_parameters.len);
+  PG_ASSERT(0 == req.headers.entries.len);
+  PG_ASSERT(3 == url.path_components.len);
+  PG_ASSERT(2 == url.query_parameters.len);
 
+  PG_ASSERT(pg_string_eq(PG_S("info"), PG_SLICE_AT(url.path_components, 0)));
   PG_ASSERT(
-      pg_string_eq(PG_S("info"), PG_SLICE_AT(req.url.path_components, 0)));
-  PG_ASSERT(
-      pg_string_eq(PG_S("download"), PG_SLICE_AT(req.url.path_components, 1)));
+      pg_string_eq(PG_S("download"), PG_SLICE_AT(url.path_components, 1)));
   PG_ASSERT(
-      pg_string_eq(PG_S("index.mp3"), PG_SLICE_AT(req.url.path_components, 2)));
+      pg_string_eq(PG_S("index.mp3"), PG_SLICE_AT(url.path_components, 2)));
 
-  PgStringKeyValue query_param0 = PG_SLICE_AT(req.url.query_parameters, 0);
-  PgStringKeyValue query_param1 = PG_SLICE_AT(req.url.query_parameters, 1);
+  PgStringKeyValue query_param0 = PG_SLICE_AT(url.query_parameters, 0);
+  PgStringKeyValue query_param1 = PG_SLICE_AT(url.query_parameters, 1);
   PG_ASSERT(pg_string_eq(PG_S("foo"), query_param0.key));
   PG_ASSERT(pg_string_eq(PG_S("bar"), query_param0.value));
   PG_ASSERT(pg_string_eq(PG_S("baz"), query_param1.key));
@@ -2605,6 +3856,176 @@ static void test_html_tokenize_with_comment() {
   }
 }
 
+static void test_html_tokenizer_streaming() {
+  PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgString s = PG_S("hello <!DOCTYPE html><html lang='en'>"
+                    "<a title=\"a > b\" href=x>link</a> <br/>"
+                    "<!-- a -- comment --><![CDATA[x]]>🍌 tail");
+
+  PG_RESULT(PG_DYN(PgHtmlToken), PgError) res = pg_html_tokenize(s, allocator);
+  PG_DYN(PgHtmlToken) expected = PG_UNWRAP(res);
+  PG_ASSERT(10 == expected.len);
+
+  {
+    PgHtmlToken token = PG_SLICE_AT(expected, 0);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_TEXT == token.kind);
+    PG_ASSERT(pg_string_eq(PG_S("hello "), token.text));
+  }
+  {
+    PgHtmlToken token = PG_SLICE_AT(expected, 1);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_DOCTYPE == token.kind);
+    PG_ASSERT(pg_string_eq(PG_S("html"), token.doctype));
+  }
+  {
+    PgHtmlToken token = PG_SLICE_AT(expected, 3);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_TAG_OPENING == token.kind);
+    PG_ASSERT(pg_string_eq(PG_S("a"), token.tag));
+  }
+  {
+    PgHtmlToken token = PG_SLICE_AT(expected, 6);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_TAG_OPENING == token.kind);
+    PG_ASSERT(pg_string_eq(PG_S("br"), token.tag));
+  }
+  {
+    PgHtmlToken token = PG_SLICE_AT(expected, 7);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_COMMENT == token.kind);
+    PG_ASSERT(pg_string_eq(PG_S("a -- comment"), token.comment));
+  }
+  {
+    PgHtmlToken token = PG_SLICE_AT(expected, 8);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_COMMENT == token.kind);
+    PG_ASSERT(pg_string_eq(PG_S("[CDATA[x]]"), token.comment));
+  }
+  {
+    PgHtmlToken token = PG_SLICE_AT(expected, 9);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_TEXT == token.kind);
+    PG_ASSERT(pg_string_eq(PG_S("🍌 tail"), token.text));
+    PG_ASSERT(s.len == token.end);
+  }
+
+  // Same tokens when fed in chunks of any size.
+  for (u64 chunk_size = 1; chunk_size < 16; chunk_size++) {
+    PgReader reader = pg_reader_make_from_bytes(s);
+    PgHtmlTokenizer tokenizer =
+        pg_html_tokenizer_make_from_reader(&reader, chunk_size, allocator);
+
+    PG_EACH_PTR(exp, &expected) {
+      PG_RESULT(PgHtmlToken, PgError) res_token =
+          pg_html_tokenizer_next(&tokenizer);
+      PgHtmlToken token = PG_UNWRAP(res_token);
+      PG_ASSERT(exp->kind == token.kind);
+      PG_ASSERT(exp->start == token.start);
+      PG_ASSERT(exp->end == token.end);
+      PG_ASSERT(pg_string_eq(exp->text, token.text));
+    }
+
+    PG_RESULT(PgHtmlToken, PgError) res_token =
+        pg_html_tokenizer_next(&tokenizer);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_NONE == PG_UNWRAP(res_token).kind);
+    pg_html_tokenizer_release(&tokenizer);
+  }
+
+  // Errors are reported at the end of the input.
+  {
+    PgReader reader = pg_reader_make_from_bytes(PG_S("<p>foo</p"));
+    PgHtmlTokenizer tokenizer =
+        pg_html_tokenizer_make_from_reader(&reader, 4, allocator);
+    PG_RESULT(PgHtmlToken, PgError) res_token =
+        pg_html_tokenizer_next(&tokenizer);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_TAG_OPENING == PG_UNWRAP(res_token).kind);
+
+    res_token = pg_html_tokenizer_next(&tokenizer);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_TEXT == PG_UNWRAP(res_token).kind);
+
+    res_token = pg_html_tokenizer_next(&tokenizer);
+    PG_ASSERT(PG_HTML_PARSE_ERROR_EOF_IN_TAG == PG_UNWRAP_ERR(res_token));
+    pg_html_tokenizer_release(&tokenizer);
+  }
+}
+
+static void test_html_decode_entities() {
+  PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Every entity is found through the perfect hash.
+  for (u64 i = 0; i < PG_HTML_ENTITIES_LEN; i++) {
+    const PgHtmlEntity *entity = &pg_html_entities[i];
+    PgString name = {
+        .data = (u8 *)pg_html_entity_names + entity->name_offset,
+        .len = entity->name_len,
+    };
+    PG_ASSERT(entity == pg_html_entity_find(name));
+  }
+  PG_ASSERT(nullptr == pg_html_entity_find(PG_S("foo;")));
+  PG_ASSERT(nullptr == pg_html_entity_find(PG_S("amp;;")));
+
+  // No `&`: returned as is.
+  {
+    PgString s = PG_S("hello world");
+    PG_ASSERT(s.data == pg_html_decode_entities(s, allocator).data);
+  }
+
+  // Named.
+  PG_ASSERT(pg_string_eq(
+      PG_S("a & b < c é ≂̸"),
+      pg_html_decode_entities(PG_S("a &amp; b &lt; c &eacute; &NotEqualTilde;"),
+                              allocator)));
+  // Legacy names without `;`.
+  PG_ASSERT(pg_string_eq(
+      PG_S("© 2024 ¬it; ¬in"),
+      pg_html_decode_entities(PG_S("&copy 2024 &notit; &notin"), allocator)));
+  // Numeric.
+  PG_ASSERT(pg_string_eq(
+      PG_S("A A 🍌 € \xef\xbf\xbd \xef\xbf\xbd \xef\xbf\xbd x"),
+      pg_html_decode_entities(PG_S("&#65; &#x00041 &#x1F34C; &#128; &#0; "
+                                   "&#xD800; &#99999999999999999999999; x"),
+                              allocator)));
+  // Not references.
+  PG_ASSERT(pg_string_eq(
+      PG_S("& &foo; &# &#x; AT&T &"),
+      pg_html_decode_entities(PG_S("& &foo; &# &#x; AT&T &"), allocator)));
+
+  // In place, including when the value is longer than the reference.
+  {
+    PgString s = pg_string_clone(PG_S("&lt;&gt;"), allocator);
+    PgString decoded = pg_html_decode_entities_in_place(s, allocator);
+    PG_ASSERT(s.data == decoded.data);
+    PG_ASSERT(pg_string_eq(PG_S("<>"), decoded));
+
+    s = pg_string_clone(PG_S("&nGt;&amp;&nLt;"), allocator);
+    decoded = pg_html_decode_entities_in_place(s, allocator);
+    PG_ASSERT(pg_string_eq(PG_S("≫⃒&≪⃒"), decoded));
+  }
+
+  // Tokenizer text.
+  PgString html = PG_S("<p>Tom &amp; Jerry&nbsp;&#x21;</p>");
+  {
+    PG_RESULT(PG_DYN(PgHtmlToken), PgError)
+    res = pg_html_tokenize(html, allocator);
+    PG_DYN(PgHtmlToken) tokens = PG_UNWRAP(res);
+    PG_ASSERT(3 == tokens.len);
+    PgHtmlToken token = PG_SLICE_AT(tokens, 1);
+    PG_ASSERT(pg_string_eq(PG_S("Tom & Jerry\u00a0!"), token.text));
+    PG_ASSERT(3 == token.start);
+    PG_ASSERT(html.len - 4 == token.end);
+  }
+  {
+    PgReader reader = pg_reader_make_from_bytes(html);
+    PgHtmlTokenizer tokenizer =
+        pg_html_tokenizer_make_from_reader(&reader, 5, allocator);
+    PG_RESULT(PgHtmlToken, PgError) res = pg_html_tokenizer_next(&tokenizer);
+    PG_ASSERT(PG_HTML_TOKEN_KIND_TAG_OPENING == PG_UNWRAP(res).kind);
+
+    res = pg_html_tokenizer_next(&tokenizer);
+    PG_ASSERT(pg_string_eq(PG_S("Tom & Jerry\u00a0!"), PG_UNWRAP(res).text));
+    pg_html_tokenizer_release(&tokenizer);
+  }
+}
+
 static void test_html_parse() {
   PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
   PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
@@ -2744,6 +4165,85 @@ static void test_html_parse_title_with_html_content() {
   PG_ASSERT(node_code_text->token_end.end < node_h2->token_end.start);
 }
 
+static void test_html_dom_parse() {
+  PgArena arena = pg_arena_make_from_virtual_mem(8 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgString s = PG_S("<html>"
+                    "  <body>"
+                    "    <div><p>Hello</p><br><p>world <b>!</b></p></div>"
+                    "    <img src=\"a.png\" />"
+                    "    </span>"
+                    "    <ul><li>one<li>two</ul>"
+                    "  </body>"
+                    "</html>");
+  PG_RESULT(PgHtmlDom, PgError) res_parse = pg_html_dom_parse(s, allocator);
+  PgHtmlDom dom = PG_UNWRAP(res_parse);
+
+  // Preorder: html, body, div, p, "Hello", br, p, "world ", b, "!", img, ul,
+  // li, "one", li, "two".
+  PG_ASSERT(17 == dom.nodes.len);
+
+  u32 p = pg_html_dom_tag_id(&dom, PG_S("p"));
+  PG_ASSERT(0 != p);
+  PG_ASSERT(0 == pg_html_dom_tag_id(&dom, PG_S("span")));
+  PG_ASSERT(0 == pg_html_dom_tag_id(&dom, PG_S("table")));
+
+  u32 html = PG_SLICE_AT(dom.nodes, 0).first_child;
+  PG_ASSERT(1 == html);
+  PG_ASSERT(pg_string_eq(PG_S("html"), pg_html_dom_node_tag(&dom, html)));
+  PG_ASSERT(0 == PG_SLICE_AT(dom.nodes, html).next_sibling);
+
+  u32 body = PG_SLICE_AT(dom.nodes, html).first_child;
+  PG_ASSERT(pg_string_eq(PG_S("body"), pg_html_dom_node_tag(&dom, body)));
+  PG_ASSERT(html == PG_SLICE_AT(dom.nodes, body).parent);
+
+  u32 div = PG_SLICE_AT(dom.nodes, body).first_child;
+  PG_ASSERT(pg_string_eq(PG_S("div"), pg_html_dom_node_tag(&dom, div)));
+
+  // Query by tag.
+  u32 p1 = pg_html_dom_find_tag(&dom, 0, p);
+  PG_ASSERT(div == PG_SLICE_AT(dom.nodes, p1).parent);
+  PG_ASSERT(p1 == PG_SLICE_AT(dom.nodes, div).first_child);
+  {
+    u32 text = PG_SLICE_AT(dom.nodes, p1).first_child;
+    PG_ASSERT(PG_HTML_TOKEN_KIND_TEXT == PG_SLICE_AT(dom.nodes, text).kind);
+    PG_ASSERT(pg_string_eq(PG_S("Hello"), pg_html_dom_node_source(&dom, text)));
+  }
+
+  // Void element: no children, next sibling is the second `p`.
+  u32 br = PG_SLICE_AT(dom.nodes, p1).next_sibling;
+  PG_ASSERT(pg_string_eq(PG_S("br"), pg_html_dom_node_tag(&dom, br)));
+  PG_ASSERT(0 == PG_SLICE_AT(dom.nodes, br).first_child);
+
+  u32 p2 = pg_html_dom_find_tag(&dom, p1 + 1, p);
+  PG_ASSERT(p2 == PG_SLICE_AT(dom.nodes, br).next_sibling);
+  PG_ASSERT(p2 == PG_SLICE_AT(dom.nodes, div).last_child);
+  PG_ASSERT(0 == pg_html_dom_find_tag(&dom, p2 + 1, p));
+
+  // Subtree of the second `p`: "world ", b, "!".
+  PG_ASSERT(p2 + 4 == pg_html_dom_subtree_end(&dom, p2));
+  PG_ASSERT(dom.nodes.len == pg_html_dom_subtree_end(&dom, html));
+
+  // The stray `</span>` is ignored: `img` and `ul` are still in `body`.
+  u32 img = pg_html_dom_subtree_end(&dom, div);
+  PG_ASSERT(pg_string_eq(PG_S("img"), pg_html_dom_node_tag(&dom, img)));
+  PG_ASSERT(body == PG_SLICE_AT(dom.nodes, img).parent);
+  u32 ul = PG_SLICE_AT(dom.nodes, img).next_sibling;
+  PG_ASSERT(pg_string_eq(PG_S("ul"), pg_html_dom_node_tag(&dom, ul)));
+  PG_ASSERT(body == PG_SLICE_AT(dom.nodes, ul).parent);
+  PG_ASSERT(ul == PG_SLICE_AT(dom.nodes, body).last_child);
+
+  // Unclosed `li` elements nest, and `</ul>` closes them all.
+  u32 li = pg_html_dom_tag_id(&dom, PG_S("li"));
+  u32 li1 = pg_html_dom_find_tag(&dom, ul, li);
+  u32 li2 = pg_html_dom_find_tag(&dom, li1 + 1, li);
+  PG_ASSERT(ul == PG_SLICE_AT(dom.nodes, li1).parent);
+  PG_ASSERT(li1 == PG_SLICE_AT(dom.nodes, li2).parent);
+  PG_ASSERT(dom.nodes.len == pg_html_dom_subtree_end(&dom, ul));
+}
+
 static void test_string_escape_js() {
   PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
   PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
@@ -2758,141 +4258,2361 @@ static void test_string_escape_js() {
 
     PG_ASSERT(pg_string_eq(out, expected));
   }
-}
+}
+
+static void test_string_escape() {
+  PgArena arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // HTML, with the escapes straddling the SIMD blocks.
+  {
+    PgString s = PG_S("<div class=\"a\">Tom & Jerry's 'cartoon' episode is "
+                      "over > 30 minutes long</div>");
+    PgString out = pg_html_sanitize(s, allocator);
+    PgString expected =
+        PG_S("&lt;div class=&quot;a&quot;&gt;Tom &amp; Jerry&#39;s "
+             "&#39;cartoon&#39; episode is over &gt; 30 minutes "
+             "long&lt;/div&gt;");
+    PG_ASSERT(pg_string_eq(out, expected));
+    PG_ASSERT(expected.len == pg_escaped_len(s, PG_ESCAPE_KIND_HTML));
+  }
+
+  // Nothing to escape.
+  {
+    PgString s = PG_S("the quick brown fox jumps over the lazy dog, twice");
+    PgString out = pg_html_sanitize(s, allocator);
+    PG_ASSERT(pg_string_eq(out, s));
+    PG_ASSERT(pg_string_is_empty(pg_html_sanitize(PG_S(""), allocator)));
+  }
+
+  // JS: stops at NUL, non-ASCII runes after a long ASCII run.
+  {
+    PgString s = PG_S("0123456789abcdef0123456789abcdef\xc3\xa9\x01\\"
+                      "\0ignored");
+    Pgu8Dyn sb = {0};
+    PG_DYN_APPEND_SLICE(&sb, PG_S("x="), allocator);
+    pg_string_builder_append_js_string_escaped(&sb, s, allocator);
+    PgString out = PG_DYN_TO_SLICE(PgString, sb);
+    PgString expected =
+        PG_S("x=0123456789abcdef0123456789abcdef\\u{e9}\x01\\\\");
+    PG_ASSERT(pg_string_eq(out, expected));
+  }
+
+  // Logfmt through a writer.
+  {
+    PgWriter w = pg_writer_make_string_builder(256, allocator);
+    PgString s = PG_S("some \"quoted\" value\nwith a newline and a \\");
+    PG_ASSERT(0 ==
+              pg_writer_write_escaped(&w, s, PG_ESCAPE_KIND_LOGFMT, allocator));
+    PgString out = PG_DYN_TO_SLICE(PgString, w.u.bytes);
+    PgString expected = PG_S(
+        "some \\\"quoted\\\" value\\\nwith a newline and a \\\\");
+    PG_ASSERT(pg_string_eq(out, expected));
+  }
+
+  // Random ASCII against a byte-per-byte reference.
+  {
+    PgRng rng = pg_rand_make();
+    for (u64 n = 0; n < 64; n++) {
+      u32 len = pg_rand_u32_min_incl_max_incl(&rng, 0, 200);
+      PgString s = pg_string_make(len, allocator);
+      for (u64 i = 0; i < s.len; i++) {
+        s.data[i] = (u8)pg_rand_u32_min_incl_max_incl(&rng, 1, 127);
+      }
+
+      Pgu8Dyn expected = {0};
+      PG_EACH_PTR(c, &s) {
+        if (*c < ' ' || '\\' == *c || '"' == *c) {
+          PG_DYN_PUSH(&expected, '\\', allocator);
+        }
+        PG_DYN_PUSH(&expected, *c, allocator);
+      }
+
+      PgWriter w = pg_writer_make_string_builder(len, allocator);
+      PG_ASSERT(
+          0 == pg_writer_write_escaped(&w, s, PG_ESCAPE_KIND_LOGFMT, allocator));
+      PG_ASSERT(pg_string_eq(PG_DYN_TO_SLICE(PgString, w.u.bytes),
+                             PG_DYN_TO_SLICE(PgString, expected)));
+      PG_ASSERT(expected.len == pg_escaped_len(s, PG_ESCAPE_KIND_LOGFMT));
+    }
+  }
+}
+
+static void test_string_builder_append_u64() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Zero.
+  {
+    Pgu8Dyn sb = {0};
+    pg_string_builder_append_u64(&sb, 0, allocator);
+    PgString out = PG_DYN_TO_SLICE(PgString, sb);
+    PgString expected = PG_S("0");
+
+    PG_ASSERT(pg_string_eq(out, expected));
+  }
+
+  // Other numbers.
+  {
+    Pgu8Dyn sb = {0};
+    pg_string_builder_append_u64(&sb, 4'056'123'789, allocator);
+    PgString out = PG_DYN_TO_SLICE(PgString, sb);
+    PgString expected = PG_S("4056123789");
+
+    PG_ASSERT(pg_string_eq(out, expected));
+  }
+}
+
+static void test_writer_write_integers() {
+  PgArena arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Around every power of 10, against `snprintf`.
+  {
+    for (u64 i = 0; i < 20; i++) {
+      u64 p = pg_u64_powers_of_10[i];
+      u64 nums[] = {p - 1, p, p + 1, p * 9 / 7, UINT64_MAX - i};
+
+      for (u64 j = 0; j < PG_STATIC_ARRAY_LEN(nums); j++) {
+        u64 n = nums[j];
+        char expected[32] = {0};
+        i32 expected_len = snprintf(expected, sizeof(expected), "%" PRIu64, n);
+
+        PgWriter w = pg_writer_make_string_builder(0, allocator);
+        PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, n, allocator));
+        PG_ASSERT(pg_string_eq(PG_DYN_TO_SLICE(PgString, w.u.bytes),
+                               (PgString){.data = (u8 *)expected,
+                                          .len = (u64)expected_len}));
+        PG_ASSERT((u64)expected_len == pg_u64_decimal_digits_count(n));
+      }
+    }
+  }
+
+  // i64.
+  {
+    i64 nums[] = {0, 7, -7, 10, -10, INT64_MAX, INT64_MIN, INT64_MIN + 1};
+    for (u64 j = 0; j < PG_STATIC_ARRAY_LEN(nums); j++) {
+      i64 n = nums[j];
+      char expected[32] = {0};
+      i32 expected_len = snprintf(expected, sizeof(expected), "%" PRIi64, n);
+
+      PgWriter w = pg_writer_make_string_builder(0, allocator);
+      PG_ASSERT(0 == pg_writer_write_i64_as_string(&w, n, allocator));
+      PG_ASSERT(pg_string_eq(
+          PG_DYN_TO_SLICE(PgString, w.u.bytes),
+          (PgString){.data = (u8 *)expected, .len = (u64)expected_len}));
+    }
+  }
+
+  // u128.
+  {
+    PgWriter w = pg_writer_make_string_builder(0, allocator);
+    PG_ASSERT(0 == pg_writer_write_u128_as_string(&w, 0, allocator));
+    PG_ASSERT(0 == pg_writer_write_u8(&w, ' ', allocator));
+    PG_ASSERT(
+        0 == pg_writer_write_u128_as_string(&w, (u128)UINT64_MAX + 1, allocator));
+    PG_ASSERT(0 == pg_writer_write_u8(&w, ' ', allocator));
+    PG_ASSERT(0 == pg_writer_write_u128_as_string(&w, ~(u128)0, allocator));
+    PG_ASSERT(pg_string_eq(
+        PG_DYN_TO_SLICE(PgString, w.u.bytes),
+        PG_S("0 18446744073709551616 "
+             "340282366920938463463374607431768211455")));
+  }
+
+  // Buffered writer: digits are formatted in place in the ring, which gets
+  // flushed when there is not enough contiguous room.
+  {
+    PgWriter w = pg_writer_make_string_builder(0, allocator);
+    w.ring = pg_ring_make(8, allocator);
+
+    PG_ASSERT(0 == pg_writer_write_u64_as_string(&w, 12345, allocator));
+    PG_ASSERT(5 == w.ring.count);
+    PG_ASSERT(0 == w.u.bytes.len);
+
+    PG_ASSERT(0 == pg_writer_write_i64_as_string(&w, -678, allocator));
+    PG_ASSERT(4 == w.ring.count);
+    PG_ASSERT(pg_string_eq(PG_DYN_TO_SLICE(PgString, w.u.bytes),
+                           PG_S("12345")));
+
+    // Does not fit in the ring at all.
+    PG_ASSERT(
+        0 == pg_writer_write_u64_as_string(&w, 1234567890123, allocator));
+    PG_ASSERT(0 == pg_writer_flush(&w, allocator));
+    PG_ASSERT(pg_string_eq(PG_DYN_TO_SLICE(PgString, w.u.bytes),
+                           PG_S("12345-6781234567890123")));
+  }
+}
+
+static void test_string_buillder_append_u64_hex() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  Pgu8Dyn sb = {0};
+  pg_string_builder_append_u64_hex(&sb, 0x1f34c /* 🍌 */, allocator);
+  PgString out = PG_DYN_TO_SLICE(PgString, sb);
+  PgString expected = PG_S("1f34c");
+
+  PG_ASSERT(pg_string_eq(out, expected));
+}
+
+static void test_adjacency_matrix() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgAdjacencyMatrix matrix = pg_adjacency_matrix_make(6, allocator);
+  PG_ASSERT(pg_adjacency_matrix_is_empty(matrix));
+
+  pg_adjacency_matrix_add_edge(&matrix, 2, 0);
+  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 2, 0));
+  pg_adjacency_matrix_add_edge(&matrix, 3, 1);
+  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 3, 1));
+  pg_adjacency_matrix_add_edge(&matrix, 3, 2);
+  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 3, 2));
+  pg_adjacency_matrix_add_edge(&matrix, 5, 0);
+  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 0));
+  pg_adjacency_matrix_add_edge(&matrix, 5, 1);
+  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 1));
+  pg_adjacency_matrix_add_edge(&matrix, 5, 2);
+  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 2));
+  pg_adjacency_matrix_add_edge(&matrix, 5, 3);
+  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 3));
+  pg_adjacency_matrix_add_edge(&matrix, 5, 4);
+  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 4));
+
+  PG_ASSERT(!pg_adjacency_matrix_is_empty(matrix));
+
+  PG_ASSERT(2 == pg_adjacency_matrix_count_neighbors(matrix, 0));
+  PG_ASSERT(2 == pg_adjacency_matrix_count_neighbors(matrix, 1));
+  PG_ASSERT(3 == pg_adjacency_matrix_count_neighbors(matrix, 2));
+  PG_ASSERT(3 == pg_adjacency_matrix_count_neighbors(matrix, 3));
+  PG_ASSERT(1 == pg_adjacency_matrix_count_neighbors(matrix, 4));
+  PG_ASSERT(5 == pg_adjacency_matrix_count_neighbors(matrix, 5));
+}
+
+static i32 test_thread_fn(void *data) {
+  PG_ASSERT(data);
+
+  u64 *n = data;
+  *n = 42;
+
+  return 0;
+}
+
+static void test_thread() {
+  u64 n = 1;
+  PG_RESULT(PgThread, PgError)
+  res_thread = pg_thread_create(test_thread_fn, &n);
+
+  PgThread thread = PG_UNWRAP(res_thread);
+
+  PG_ASSERT(0 == pg_thread_join(thread));
+  PG_ASSERT(42 == n);
+}
+
+#define TEST_SPSC_RING_BYTES_COUNT (4 * PG_MiB)
+
+static i32 test_spsc_ring_producer_fn(void *data) {
+  PgSpscRing *rg = data;
+
+  u8 buf[97] = {0};
+  u64 written = 0;
+  while (written < TEST_SPSC_RING_BYTES_COUNT) {
+    u64 len = PG_MIN(PG_STATIC_ARRAY_LEN(buf),
+                     TEST_SPSC_RING_BYTES_COUNT - written);
+    for (u64 i = 0; i < len; i++) {
+      buf[i] = (u8)(written + i);
+    }
+
+    PG_SLICE(u8) src = {.data = buf, .len = len};
+    while (src.len > 0) {
+      u64 n = pg_spsc_ring_write_bytes(rg, src);
+      if (0 == n) {
+        pg_thread_yield();
+      }
+      src = PG_SLICE_RANGE_START(src, n);
+    }
+    written += len;
+  }
+
+  return 0;
+}
+
+static void test_spsc_ring() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Single thread, same semantics as `PgRing`.
+  {
+    PgSpscRing rg = pg_spsc_ring_make(8, allocator);
+    PG_ASSERT(0 == pg_spsc_ring_can_read_count(&rg));
+    PG_ASSERT(8 == pg_spsc_ring_can_write_count(&rg));
+
+    PG_ASSERT(5 == pg_spsc_ring_write_bytes(&rg, PG_S("hello")));
+    PG_ASSERT(5 == pg_spsc_ring_can_read_count(&rg));
+    PG_ASSERT(3 == pg_spsc_ring_can_write_count(&rg));
+
+    // Partial write.
+    PG_ASSERT(3 == pg_spsc_ring_write_bytes(&rg, PG_S(" world")));
+    PG_ASSERT(0 == pg_spsc_ring_can_write_count(&rg));
+    PG_ASSERT(0 == pg_spsc_ring_write_bytes(&rg, PG_S("!")));
+    PG_ASSERT(!pg_spsc_ring_write_full(&rg, PG_S("!")));
+
+    u8 tmp[6] = {0};
+    PG_SLICE(u8) tmp_slice = {.data = tmp, .len = PG_STATIC_ARRAY_LEN(tmp)};
+    PG_ASSERT(6 == pg_spsc_ring_read_bytes(&rg, tmp_slice));
+    PG_ASSERT(pg_bytes_eq(PG_S("hello "), tmp_slice));
+    PG_ASSERT(2 == pg_spsc_ring_can_read_count(&rg));
+
+    // Wrap around.
+    PG_ASSERT(pg_spsc_ring_write_full(&rg, PG_S("abcdef")));
+    PG_ASSERT(8 == pg_spsc_ring_can_read_count(&rg));
+    PG_ASSERT(!pg_spsc_ring_read_full(
+        &rg, (PG_SLICE(u8)){.data = tmp, .len = 9}));
+
+    PG_ASSERT(pg_spsc_ring_read_full(&rg, tmp_slice));
+    PG_ASSERT(pg_bytes_eq(PG_S("woabcd"), tmp_slice));
+    PG_ASSERT(2 == pg_spsc_ring_read_bytes(&rg, tmp_slice));
+    PG_ASSERT(pg_bytes_eq(PG_S("ef"), PG_SLICE_RANGE(tmp_slice, 0, 2)));
+    PG_ASSERT(0 == pg_spsc_ring_can_read_count(&rg));
+    PG_ASSERT(0 == pg_spsc_ring_read_bytes(&rg, tmp_slice));
+  }
+
+  // Concurrent producer and consumer.
+  {
+    PgSpscRing rg = pg_spsc_ring_make(256, allocator);
+
+    PG_RESULT(PgThread, PgError)
+    res_thread = pg_thread_create(test_spsc_ring_producer_fn, &rg);
+    PgThread thread = PG_UNWRAP(res_thread);
+
+    u8 buf[61] = {0};
+    PG_SLICE(u8) buf_slice = {.data = buf, .len = PG_STATIC_ARRAY_LEN(buf)};
+    u64 read = 0;
+    while (read < TEST_SPSC_RING_BYTES_COUNT) {
+      u64 n = pg_spsc_ring_read_bytes(&rg, buf_slice);
+      if (0 == n) {
+        pg_thread_yield();
+      }
+
+      for (u64 i = 0; i < n; i++) {
+        PG_ASSERT((u8)(read + i) == buf[i]);
+      }
+      read += n;
+    }
+
+    PG_ASSERT(0 == pg_thread_join(thread));
+    PG_ASSERT(0 == pg_spsc_ring_can_read_count(&rg));
+  }
+}
+
+static void test_rate_limiter() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  u64 now_ns = 1000 * PG_Seconds;
+
+  // Burst, then the refill rate.
+  {
+    PgRateLimiter limiter = pg_rate_limiter_make(10, 3, 16, allocator);
+    for (u64 i = 0; i < 3; i++) {
+      PG_ASSERT(pg_rate_limiter_allow(&limiter, 1, now_ns));
+    }
+    PG_ASSERT(!pg_rate_limiter_allow(&limiter, 1, now_ns));
+    PG_ASSERT(pg_rate_limiter_allow(&limiter, 2, now_ns));
+
+    PG_ASSERT(!pg_rate_limiter_allow(&limiter, 1,
+                                     now_ns + 99 * PG_Milliseconds));
+    PG_ASSERT(pg_rate_limiter_allow(&limiter, 1,
+                                    now_ns + 100 * PG_Milliseconds));
+    PG_ASSERT(!pg_rate_limiter_allow(&limiter, 1,
+                                     now_ns + 100 * PG_Milliseconds));
+
+    // Never more than the burst, however long the wait.
+    u64 later_ns = now_ns + 100 * PG_Seconds;
+    for (u64 i = 0; i < 3; i++) {
+      PG_ASSERT(pg_rate_limiter_allow(&limiter, 1, later_ns));
+    }
+    PG_ASSERT(!pg_rate_limiter_allow(&limiter, 1, later_ns));
+  }
+
+  // A single slot: a second key is let through until the bucket of the first
+  // one is full again, and then takes over the slot.
+  {
+    PgRateLimiter limiter = pg_rate_limiter_make(10, 1, 1, allocator);
+    PG_ASSERT(pg_rate_limiter_allow(&limiter, 1, now_ns));
+    PG_ASSERT(!pg_rate_limiter_allow(&limiter, 1, now_ns));
+    PG_ASSERT(pg_rate_limiter_allow(&limiter, 2, now_ns));
+    PG_ASSERT(pg_rate_limiter_allow(&limiter, 2, now_ns));
+
+    u64 later_ns = now_ns + PG_Seconds;
+    PG_ASSERT(pg_rate_limiter_allow(&limiter, 2, later_ns));
+    PG_ASSERT(!pg_rate_limiter_allow(&limiter, 2, later_ns));
+  }
+}
+
+#define TEST_RATE_LIMITER_THREADS_COUNT 4
+#define TEST_RATE_LIMITER_BURST 1000
+
+typedef struct {
+  PgRateLimiter *limiter;
+  _Atomic u64 allowed;
+} TestRateLimiterShared;
+
+static i32 test_rate_limiter_fn(void *data) {
+  TestRateLimiterShared *shared = data;
+
+  for (u64 i = 0; i < TEST_RATE_LIMITER_BURST; i++) {
+    // The clock stands still: the tokens of the burst are all there is.
+    if (pg_rate_limiter_allow(shared->limiter, 42, PG_Seconds)) {
+      atomic_fetch_add(&shared->allowed, 1);
+    }
+  }
+  return 0;
+}
+
+static void test_rate_limiter_threads() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgRateLimiter limiter =
+      pg_rate_limiter_make(1, TEST_RATE_LIMITER_BURST, 16, allocator);
+  TestRateLimiterShared shared = {.limiter = &limiter};
+
+  PgThread threads[TEST_RATE_LIMITER_THREADS_COUNT] = {0};
+  for (u64 i = 0; i < TEST_RATE_LIMITER_THREADS_COUNT; i++) {
+    PG_RESULT(PgThread, PgError)
+    res_thread = pg_thread_create(test_rate_limiter_fn, &shared);
+    threads[i] = PG_UNWRAP(res_thread);
+  }
+  for (u64 i = 0; i < TEST_RATE_LIMITER_THREADS_COUNT; i++) {
+    PG_ASSERT(0 == pg_thread_join(threads[i]));
+  }
+
+  PG_ASSERT(TEST_RATE_LIMITER_BURST == shared.allowed);
+}
+
+#ifdef PG_OS_LINUX
+#define TEST_FUTEX_ITERATIONS_COUNT 100'000
+
+typedef struct {
+  PgMutex *mtx;
+  u64 counter;
+  PgFutexMutex futex_mtx;
+  PgFutexRwLock rwlock;
+  bool use_futex;
+  PG_PAD(3);
+} TestFutexShared;
+
+static i32 test_futex_mutex_fn(void *data) {
+  TestFutexShared *shared = data;
+
+  for (u64 i = 0; i < TEST_FUTEX_ITERATIONS_COUNT; i++) {
+    if (shared->use_futex) {
+      pg_futex_mtx_lock(&shared->futex_mtx);
+      shared->counter += 1;
+      pg_futex_mtx_unlock(&shared->futex_mtx);
+    } else {
+      PG_ASSERT(0 == pg_mtx_lock(shared->mtx));
+      shared->counter += 1;
+      PG_ASSERT(0 == pg_mtx_unlock(shared->mtx));
+    }
+  }
+
+  return 0;
+}
+
+static void test_futex_mutex() {
+  // Contention, against the pthread version as reference.
+  u64 threads_counts[] = {1, 2, 4, 8};
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(threads_counts); i++) {
+    for (u64 use_futex = 0; use_futex <= 1; use_futex++) {
+      PgMutex mtx = {0};
+      PG_ASSERT(0 == pg_mtx_init(&mtx, PG_MUTEX_KIND_PLAIN));
+      TestFutexShared shared = {.mtx = &mtx, .use_futex = use_futex};
+
+      PgThread threads[8] = {0};
+      for (u64 j = 0; j < threads_counts[i]; j++) {
+        PG_RESULT(PgThread, PgError)
+        res_thread = pg_thread_create(test_futex_mutex_fn, &shared);
+        threads[j] = PG_UNWRAP(res_thread);
+      }
+      for (u64 j = 0; j < threads_counts[i]; j++) {
+        PG_ASSERT(0 == pg_thread_join(threads[j]));
+      }
+
+      PG_ASSERT(threads_counts[i] * TEST_FUTEX_ITERATIONS_COUNT ==
+                shared.counter);
+      PG_ASSERT(0 == atomic_load(&shared.futex_mtx.state));
+      pg_mtx_destroy(&mtx);
+    }
+  }
+
+  // Trylock.
+  {
+    PgFutexMutex mtx = {0};
+    PG_ASSERT(pg_futex_mtx_trylock(&mtx));
+    PG_ASSERT(!pg_futex_mtx_trylock(&mtx));
+    pg_futex_mtx_unlock(&mtx);
+    PG_ASSERT(pg_futex_mtx_trylock(&mtx));
+    pg_futex_mtx_unlock(&mtx);
+  }
+}
+
+static i32 test_futex_rwlock_writer_fn(void *data) {
+  TestFutexShared *shared = data;
+
+  for (u64 i = 0; i < TEST_FUTEX_ITERATIONS_COUNT / 10; i++) {
+    pg_futex_rwlock_write_lock(&shared->rwlock);
+    // Readers must never observe an odd value.
+    shared->counter += 1;
+    shared->counter += 1;
+    pg_futex_rwlock_write_unlock(&shared->rwlock);
+  }
+
+  return 0;
+}
+
+static i32 test_futex_rwlock_reader_fn(void *data) {
+  TestFutexShared *shared = data;
+
+  for (u64 i = 0; i < TEST_FUTEX_ITERATIONS_COUNT / 10; i++) {
+    pg_futex_rwlock_read_lock(&shared->rwlock);
+    PG_ASSERT(0 == shared->counter % 2);
+    pg_futex_rwlock_read_unlock(&shared->rwlock);
+  }
+
+  return 0;
+}
+
+static void test_futex_rwlock() {
+  TestFutexShared shared = {0};
+
+  PgThread threads[6] = {0};
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(threads); i++) {
+    PG_RESULT(PgThread, PgError)
+    res_thread =
+        pg_thread_create(0 == i % 3 ? test_futex_rwlock_writer_fn
+                                    : test_futex_rwlock_reader_fn,
+                         &shared);
+    threads[i] = PG_UNWRAP(res_thread);
+  }
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(threads); i++) {
+    PG_ASSERT(0 == pg_thread_join(threads[i]));
+  }
+
+  PG_ASSERT(2 * 2 * TEST_FUTEX_ITERATIONS_COUNT / 10 == shared.counter);
+  PG_ASSERT(0 == atomic_load(&shared.rwlock.state));
+}
+
+typedef struct {
+  u64 items;
+  u64 consumed;
+  PgFutexMutex mtx;
+  PgFutexConditionVar cnd;
+  PgLatch started;
+  PgLatch done;
+  PG_PAD(4);
+} TestFutexCondition;
+
+static i32 test_futex_condition_consumer_fn(void *data) {
+  TestFutexCondition *shared = data;
+
+  pg_latch_count_down(&shared->started);
+
+  for (;;) {
+    pg_futex_mtx_lock(&shared->mtx);
+    while (0 == shared->items && shared->consumed < 1'000) {
+      pg_futex_cnd_wait(&shared->cnd, &shared->mtx);
+    }
+
+    if (shared->consumed == 1'000) {
+      pg_futex_mtx_unlock(&shared->mtx);
+      break;
+    }
+    shared->items -= 1;
+    shared->consumed += 1;
+    if (shared->consumed == 1'000) {
+      pg_futex_cnd_broadcast(&shared->cnd);
+    }
+    pg_futex_mtx_unlock(&shared->mtx);
+  }
+
+  pg_latch_count_down(&shared->done);
+  return 0;
+}
+
+static _Atomic PgOnce test_futex_once = PG_ONCE_UNINITIALIZED;
+static _Atomic u64 test_futex_once_count = 0;
+
+static i32 test_futex_once_fn(void *data) {
+  PgLatch *latch = data;
+  pg_latch_wait(latch);
+
+  if (pg_once_do(&test_futex_once)) {
+    // Make the other threads park.
+    pg_thread_yield();
+    atomic_fetch_add(&test_futex_once_count, 1);
+    pg_once_mark_as_done(&test_futex_once);
+  }
+  PG_ASSERT(1 == atomic_load(&test_futex_once_count));
+
+  return 0;
+}
+
+static void test_futex_condition_latch_once() {
+  // Condition variable and latches.
+  {
+    TestFutexCondition shared = {0};
+    pg_latch_init(&shared.started, 4);
+    pg_latch_init(&shared.done, 4);
+
+    PgThread threads[4] = {0};
+    for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(threads); i++) {
+      PG_RESULT(PgThread, PgError)
+      res_thread = pg_thread_create(test_futex_condition_consumer_fn, &shared);
+      threads[i] = PG_UNWRAP(res_thread);
+    }
+    pg_latch_wait(&shared.started);
+
+    for (u64 i = 0; i < 1'000; i++) {
+      pg_futex_mtx_lock(&shared.mtx);
+      shared.items += 1;
+      pg_futex_cnd_signal(&shared.cnd);
+      pg_futex_mtx_unlock(&shared.mtx);
+    }
+
+    pg_latch_wait(&shared.done);
+    PG_ASSERT(1'000 == shared.consumed);
+    PG_ASSERT(0 == shared.items);
+
+    for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(threads); i++) {
+      PG_ASSERT(0 == pg_thread_join(threads[i]));
+    }
+  }
+
+  // Once with parked waiters.
+  {
+    PgLatch latch = {0};
+    pg_latch_init(&latch, 1);
+
+    PgThread threads[8] = {0};
+    for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(threads); i++) {
+      PG_RESULT(PgThread, PgError)
+      res_thread = pg_thread_create(test_futex_once_fn, &latch);
+      threads[i] = PG_UNWRAP(res_thread);
+    }
+    // Event: release all threads at once.
+    pg_latch_count_down(&latch);
+
+    for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(threads); i++) {
+      PG_ASSERT(0 == pg_thread_join(threads[i]));
+    }
+    PG_ASSERT(1 == atomic_load(&test_futex_once_count));
+  }
+}
+#endif
+
+#ifdef PG_OS_UNIX
+typedef struct {
+  PgMutex mtx;
+  PgConditionVar cnd;
+  bool ready;
+  PG_PAD(7);
+} TestMutexShared;
+
+static i32 test_mutex_other_thread_fn(void *data) {
+  TestMutexShared *shared = data;
+
+  // Held by the main thread.
+  PG_ASSERT(EBUSY == pg_mtx_trylock(&shared->mtx));
+  PG_ASSERT(EPERM == pg_mtx_unlock(&shared->mtx));
+  return 0;
+}
+
+static i32 test_mutex_signal_fn(void *data) {
+  TestMutexShared *shared = data;
+
+  PG_ASSERT(0 == pg_mtx_lock(&shared->mtx));
+  shared->ready = true;
+  PG_ASSERT(0 == pg_cnd_signal(&shared->cnd));
+  PG_ASSERT(0 == pg_mtx_unlock(&shared->mtx));
+  return 0;
+}
+
+[[nodiscard]] static PgTime test_mutex_deadline(u64 delay_ns) {
+  PG_RESULT(u64, PgError) res_now = pg_time_ns_now(PG_CLOCK_KIND_REALTIME);
+  u64 deadline_ns = PG_UNWRAP(res_now) + delay_ns;
+  return (PgTime){
+      .seconds = deadline_ns / PG_Seconds,
+      .nanoseconds = deadline_ns % PG_Seconds,
+  };
+}
+
+static void test_mutex_recursive_cnd_timedwait() {
+  TestMutexShared shared = {0};
+  PG_ASSERT(0 == pg_mtx_init(&shared.mtx, PG_MUTEX_KIND_RECURSIVE));
+  PG_ASSERT(0 == pg_cnd_init(&shared.cnd));
+
+  // Nested locks, only by the owner.
+  {
+    PG_ASSERT(0 == pg_mtx_lock(&shared.mtx));
+    PG_ASSERT(0 == pg_mtx_lock(&shared.mtx));
+    PG_ASSERT(0 == pg_mtx_trylock(&shared.mtx));
+
+    PG_RESULT(PgThread, PgError)
+    res_thread = pg_thread_create(test_mutex_other_thread_fn, &shared);
+    PG_ASSERT(0 == pg_thread_join(PG_UNWRAP(res_thread)));
+
+    PG_ASSERT(0 == pg_mtx_unlock(&shared.mtx));
+    PG_ASSERT(0 == pg_mtx_unlock(&shared.mtx));
+  }
+
+  // Timed out, with the mutex still held twice afterwards.
+  {
+    PG_ASSERT(0 == pg_mtx_lock(&shared.mtx));
+    PgTime deadline = test_mutex_deadline(10 * PG_Milliseconds);
+    PgError err = 0;
+    while (0 == err) {
+      err = pg_cnd_timedwait(&shared.cnd, &shared.mtx, &deadline);
+    }
+    PG_ASSERT(ETIMEDOUT == err);
+    PG_ASSERT(0 == pg_mtx_unlock(&shared.mtx));
+  }
+  PG_ASSERT(0 == pg_mtx_unlock(&shared.mtx));
+  PG_ASSERT(EPERM == pg_mtx_unlock(&shared.mtx));
+
+  // Signaled before the deadline.
+  {
+    PG_ASSERT(0 == pg_mtx_lock(&shared.mtx));
+    PG_RESULT(PgThread, PgError)
+    res_thread = pg_thread_create(test_mutex_signal_fn, &shared);
+
+    PgTime deadline = test_mutex_deadline(60 * PG_Seconds);
+    while (!shared.ready) {
+      PG_ASSERT(0 == pg_cnd_timedwait(&shared.cnd, &shared.mtx, &deadline));
+    }
+    PG_ASSERT(0 == pg_mtx_unlock(&shared.mtx));
+    PG_ASSERT(0 == pg_thread_join(PG_UNWRAP(res_thread)));
+  }
+
+  pg_cnd_destroy(&shared.cnd);
+  pg_mtx_destroy(&shared.mtx);
+}
+#endif
+
+typedef struct {
+  PgMpmcQueue *queue;
+  u64 items_count;
+  _Atomic u64 *consumed_count;
+  _Atomic u64 *consumed_sum;
+  u64 items_total;
+  u64 batch_size;
+} TestMpmcQueueWorker;
+
+static i32 test_mpmc_queue_producer_fn(void *data) {
+  TestMpmcQueueWorker *worker = data;
+
+  u64 batch[8] = {0};
+  PG_ASSERT(worker->batch_size <= PG_STATIC_ARRAY_LEN(batch));
+
+  for (u64 i = 0; i < worker->items_count;) {
+    u64 batch_len = PG_MIN(worker->batch_size, worker->items_count - i);
+    for (u64 j = 0; j < batch_len; j++) {
+      batch[j] = i + j + 1;
+    }
+
+    u64 n = pg_mpmc_queue_enqueue_batch(worker->queue, batch, batch_len);
+    if (0 == n) {
+      pg_thread_yield();
+    }
+    i += n;
+  }
+
+  return 0;
+}
+
+static i32 test_mpmc_queue_consumer_fn(void *data) {
+  TestMpmcQueueWorker *worker = data;
+
+  u64 batch[8] = {0};
+  PG_ASSERT(worker->batch_size <= PG_STATIC_ARRAY_LEN(batch));
+
+  while (atomic_load(worker->consumed_count) < worker->items_total) {
+    u64 n =
+        pg_mpmc_queue_dequeue_batch(worker->queue, batch, worker->batch_size);
+    if (0 == n) {
+      pg_thread_yield();
+      continue;
+    }
+
+    u64 sum = 0;
+    for (u64 i = 0; i < n; i++) {
+      sum += batch[i];
+    }
+    atomic_fetch_add(worker->consumed_sum, sum);
+    atomic_fetch_add(worker->consumed_count, n);
+  }
+
+  return 0;
+}
+
+static void test_mpmc_queue() {
+  PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Single thread.
+  {
+    PgMpmcQueue queue = PG_MPMC_QUEUE_MAKE(u32, 4, allocator);
+
+    u32 elem = 0;
+    PG_ASSERT(!pg_mpmc_queue_try_dequeue(&queue, &elem));
+
+    u32 elems[5] = {1, 2, 3, 4, 5};
+    PG_ASSERT(3 == pg_mpmc_queue_enqueue_batch(&queue, elems, 3));
+    PG_ASSERT(1 == pg_mpmc_queue_enqueue_batch(&queue, elems + 3, 2));
+    // Full.
+    PG_ASSERT(!pg_mpmc_queue_try_enqueue(&queue, elems + 4));
+
+    PG_ASSERT(pg_mpmc_queue_try_dequeue(&queue, &elem));
+    PG_ASSERT(1 == elem);
+
+    // Wrap around.
+    PG_ASSERT(pg_mpmc_queue_try_enqueue(&queue, elems + 4));
+
+    u32 out[8] = {0};
+    PG_ASSERT(4 == pg_mpmc_queue_dequeue_batch(&queue, out, 8));
+    PG_ASSERT(2 == out[0]);
+    PG_ASSERT(3 == out[1]);
+    PG_ASSERT(4 == out[2]);
+    PG_ASSERT(5 == out[3]);
+    PG_ASSERT(!pg_mpmc_queue_try_dequeue(&queue, &elem));
+  }
+
+  // Contention with a varying count of producers and consumers.
+  u64 threads_counts[] = {1, 2, 4};
+  u64 batch_sizes[] = {1, 8};
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(threads_counts); i++) {
+    for (u64 j = 0; j < PG_STATIC_ARRAY_LEN(batch_sizes); j++) {
+      u64 threads_count = threads_counts[i];
+      u64 items_per_producer = 100'000;
+
+      PgMpmcQueue queue = PG_MPMC_QUEUE_MAKE(u64, 64, allocator);
+      _Atomic u64 consumed_count = 0;
+      _Atomic u64 consumed_sum = 0;
+
+      TestMpmcQueueWorker worker = {
+          .queue = &queue,
+          .items_count = items_per_producer,
+          .consumed_count = &consumed_count,
+          .consumed_sum = &consumed_sum,
+          .items_total = items_per_producer * threads_count,
+          .batch_size = batch_sizes[j],
+      };
+
+      PgThread producers[4] = {0};
+      PgThread consumers[4] = {0};
+      for (u64 k = 0; k < threads_count; k++) {
+        PG_RESULT(PgThread, PgError)
+        res_thread = pg_thread_create(test_mpmc_queue_producer_fn, &worker);
+        producers[k] = PG_UNWRAP(res_thread);
+
+        res_thread = pg_thread_create(test_mpmc_queue_consumer_fn, &worker);
+        consumers[k] = PG_UNWRAP(res_thread);
+      }
+
+      for (u64 k = 0; k < threads_count; k++) {
+        PG_ASSERT(0 == pg_thread_join(producers[k]));
+        PG_ASSERT(0 == pg_thread_join(consumers[k]));
+      }
+
+      PG_ASSERT(worker.items_total == atomic_load(&consumed_count));
+      PG_ASSERT(threads_count * items_per_producer * (items_per_producer + 1) /
+                    2 ==
+                atomic_load(&consumed_sum));
+    }
+  }
+}
+
+typedef enum {
+  AIO_PEER_STATE_INITIAL,
+  AIO_PEER_STATE_SENT_HELLO,
+  AIO_PEER_STATE_DONE,
+} AioPeerState;
+
+static void test_aio_peer(PgAio aio, PgWriter *w, PgReader *r,
+                          AioPeerState *state, PgFileDescriptor fd,
+                          PgAllocator *allocator) {
+  switch (*state) {
+  case AIO_PEER_STATE_INITIAL: {
+    PG_ASSERT(0 == pg_writer_write_full(w, PG_S("hello world"), allocator));
+    PG_ASSERT(0 == pg_writer_flush(w, allocator));
+    PG_ASSERT(0 ==
+              pg_aio_unregister_interest(aio, fd, PG_AIO_EVENT_KIND_WRITABLE));
+    PG_ASSERT(0 ==
+              pg_aio_register_interest_fd(aio, fd, PG_AIO_EVENT_KIND_READABLE));
+
+    *state = AIO_PEER_STATE_SENT_HELLO;
+  } break;
+  case AIO_PEER_STATE_SENT_HELLO: {
+    u8 recv[1024] = {0};
+    PG_SLICE(u8)
+    recv_slice = {
+        .data = recv,
+        .len = PG_STATIC_ARRAY_LEN(recv),
+    };
+    PG_RESULT(u64, PgError) res = pg_reader_read_slice(r, recv_slice);
+
+    recv_slice.len = PG_UNWRAP(res);
+    PG_ASSERT(pg_bytes_eq(recv_slice, PG_S("hello world")));
+
+    *state = AIO_PEER_STATE_DONE;
+  } break;
+  default:
+    PG_ASSERT(0);
+  }
+}
+
+static void test_http_client_handler(PgHttpServerRequest req,
+                                     PgReader *reader, PgWriter *writer,
+                                     PgLogger *logger, PgAllocator *allocator,
+                                     void *ctx) {
+  (void)reader;
+  (void)logger;
+  (void)ctx;
+
+  PgHttpResponse res = {.version_major = 1, .version_minor = 1, .status = 200};
+
+  // Never answered in time.
+  if (pg_string_eq(req.target.path, PG_S("/hang"))) {
+    (void)nanosleep(&(struct timespec){.tv_nsec = 500 * 1000 * 1000}, nullptr);
+    return;
+  }
+  // Sent in pieces, the body chunked.
+  if (pg_string_eq(req.target.path, PG_S("/slow"))) {
+    pg_http_push_header(&res.headers, PG_S("Transfer-Encoding"),
+                        PG_S("chunked"), allocator);
+    PG_ASSERT(0 == pg_http_write_response(writer, res, allocator));
+    PG_ASSERT(0 == pg_writer_flush(writer, allocator));
+
+    PgWriter chunked = pg_http_chunked_writer_make(writer, 0, allocator);
+    PgString pieces[] = {PG_S("hel"), PG_S("lo")};
+    for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(pieces); i++) {
+      (void)nanosleep(&(struct timespec){.tv_nsec = 100 * 1000 * 1000},
+                      nullptr);
+      PG_ASSERT(0 == pg_writer_write_full(&chunked, pieces[i], allocator));
+      PG_ASSERT(0 == pg_writer_flush(writer, allocator));
+    }
+    PG_ASSERT(0 == pg_http_chunked_writer_finish(&chunked, (PgHttpHeaders){0},
+                                                 allocator));
+    PG_ASSERT(0 == pg_writer_flush(writer, allocator));
+    return;
+  }
+
+  PgString body = PG_HTTP_METHOD_HEAD == req.method ? PG_S("") : PG_S("hello");
+  pg_http_push_header(&res.headers, PG_S("Content-Length"), PG_S("5"),
+                      allocator);
+  PG_ASSERT(0 == pg_http_write_response(writer, res, allocator));
+  PG_ASSERT(0 == pg_writer_write_full(writer, body, allocator));
+  // Bytes after the response, like a misbehaving server.
+  if (pg_string_eq(req.target.path, PG_S("/extra"))) {
+    PG_ASSERT(0 == pg_writer_write_full(writer, PG_S("junk"), allocator));
+  }
+  PG_ASSERT(0 == pg_writer_flush(writer, allocator));
+}
+
+typedef struct {
+  PgFileDescriptor socket;
+  PgHttpServerOptions options;
+} TestHttpClientConn;
+
+static i32 test_http_client_conn_fn(void *data) {
+  TestHttpClientConn *conn = data;
+
+  PgArena arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+  (void)pg_http_server_handler(conn->socket, conn->options, nullptr, &arena);
+  (void)pg_net_socket_close(conn->socket);
+  PG_ASSERT(0 == pg_arena_release(&arena));
+
+  return 0;
+}
+
+typedef struct {
+  PgFileDescriptor listener;
+  PgHttpServerOptions options;
+  _Atomic bool stop;
+  PG_PAD(7);
+} TestHttpClientServer;
+
+// One thread per connection, until `stop` is set and a last connection is
+// made to wake up `accept`.
+static i32 test_http_client_server_fn(void *data) {
+  TestHttpClientServer *server = data;
+
+  PgArena arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PG_DYN(PgThread) threads = {0};
+  for (;;) {
+    PgIpv4AddressAcceptResult res_accept = pg_net_tcp_accept(server->listener);
+    PG_ASSERT(0 == res_accept.err);
+    if (server->stop) {
+      (void)pg_net_socket_close(res_accept.socket);
+      break;
+    }
+
+    TestHttpClientConn *conn = PG_NEW(TestHttpClientConn, allocator);
+    conn->socket = res_accept.socket;
+    conn->options = server->options;
+
+    PG_RESULT(PgThread, PgError)
+    res_thread = pg_thread_create(test_http_client_conn_fn, conn);
+    PG_DYN_PUSH(&threads, PG_UNWRAP(res_thread), allocator);
+  }
+
+  PG_EACH_PTR(thread, &threads) { PG_ASSERT(0 == pg_thread_join(*thread)); }
+  PG_ASSERT(0 == pg_arena_release(&arena));
+
+  return 0;
+}
+
+// Fed one byte at a time, a response is whole with its last byte only.
+static void test_http_client_scan() {
+  PgArena arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgHttpRequest req = {.method = PG_HTTP_METHOD_GET};
+  PgString responses[] = {
+      PG_S("HTTP/1.1 200\r\nContent-Length: 5\r\n\r\nhello"),
+      PG_S("HTTP/1.1 200\r\nTransfer-Encoding: chunked\r\n\r\n"
+           "3;a=b\r\nhel\r\n2\r\nlo\r\n0\r\nX-Trailer: 1\r\n\r\n"),
+      PG_S("HTTP/1.1 204\r\n\r\n"),
+  };
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(responses); i++) {
+    PgString response = responses[i];
+    PgHttpClientPending pending = {0};
+    for (u64 j = 0; j < response.len; j++) {
+      PG_DYN_PUSH(&pending.raw, PG_SLICE_AT(response, j), allocator);
+      bool whole = pg_http_client_scan(&pending, req, allocator);
+      PG_ASSERT((j + 1 == response.len) == whole);
+    }
+  }
+
+  // Without a length, the body ends with the connection.
+  {
+    PgString response = PG_S("HTTP/1.1 200\r\n\r\nhello");
+    PgHttpClientPending pending = {0};
+    PG_DYN_APPEND_SLICE(&pending.raw, response, allocator);
+    PG_ASSERT(!pg_http_client_scan(&pending, req, allocator));
+    PG_ASSERT(PG_HTTP_CLIENT_SCAN_UNTIL_CLOSE == pending.scan);
+  }
+
+  // Malformed: whole, for the parsing to report it.
+  {
+    PgString response = PG_S("HTTP/1.1 200\r\nTransfer-Encoding: chunked\r\n"
+                             "\r\nzz\r\n");
+    PgHttpClientPending pending = {0};
+    PG_DYN_APPEND_SLICE(&pending.raw, response, allocator);
+    PG_ASSERT(pg_http_client_scan(&pending, req, allocator));
+  }
+
+  PG_ASSERT(0 == pg_arena_release(&arena));
+}
+
+static void test_http_client() {
+  PgArena arena = pg_arena_make_from_virtual_mem(512 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  TestHttpClientServer server = {
+      .options =
+          {
+              .handler = test_http_client_handler,
+              .keep_alive_timeout_ms = 5000,
+          },
+  };
+  u16 port = 0;
+  {
+    PG_RESULT(PgFileDescriptor, PgError)
+    res_socket = pg_net_create_tcp_socket();
+    server.listener = PG_UNWRAP(res_socket);
+    PgIpv4Address address = {.ip = 0x7f000001};
+    PG_ASSERT(0 == pg_net_tcp_bind_ipv4(server.listener, address));
+    PG_ASSERT(0 == pg_net_tcp_listen(server.listener, 16));
+
+    PG_RESULT(PgIpv4Address, PgError)
+    res_address = pg_net_socket_local_address(server.listener);
+    port = PG_UNWRAP(res_address).port;
+    PG_ASSERT(port);
+  }
+  PG_RESULT(PgThread, PgError)
+  res_thread = pg_thread_create(test_http_client_server_fn, &server);
+  PgThread server_thread = PG_UNWRAP(res_thread);
+
+  PgHttpClientRequest req = {
+      .host = PG_S("127.0.0.1"),
+      .port = port,
+      .req = {.method = PG_HTTP_METHOD_GET},
+  };
+
+  // Pooled.
+  {
+    PG_RESULT(PgHttpClient, PgError)
+    res_client = pg_http_client_make(
+        (PgHttpClientOptions){
+            .connect_timeout_ms = 1000,
+            .read_timeout_ms = 1000,
+            .idle_timeout_ms = 1000,
+            .max_idle_per_host = 4,
+            .max_body_len = 1024,
+        },
+        allocator);
+    PgHttpClient client = PG_UNWRAP(res_client);
+
+    for (u64 i = 0; i < 5; i++) {
+      PgHttpClientResponse res = pg_http_client_do(&client, req, allocator);
+      PG_ASSERT(0 == res.err);
+      PG_ASSERT(200 == res.res.status);
+      PG_ASSERT(pg_string_eq(res.body, PG_S("hello")));
+    }
+    PG_ASSERT(1 == client.connections_opened);
+
+    // No body.
+    {
+      PgHttpClientRequest req_head = req;
+      req_head.req.method = PG_HTTP_METHOD_HEAD;
+      PgHttpClientResponse res =
+          pg_http_client_do(&client, req_head, allocator);
+      PG_ASSERT(0 == res.err);
+      PG_ASSERT(200 == res.res.status);
+      PG_ASSERT(pg_string_is_empty(res.body));
+      PG_ASSERT(1 == client.connections_opened);
+    }
+
+    // Concurrent: one connection per request, kept for later.
+    {
+      PgHttpClientRequest reqs[3] = {req, req, req};
+      PgHttpClientResponse responses[3] = {0};
+      pg_http_client_do_many(
+          &client,
+          (PG_SLICE(PgHttpClientRequest)){.data = reqs,
+                                          .len = PG_STATIC_ARRAY_LEN(reqs)},
+          (PG_SLICE(PgHttpClientResponse)){
+              .data = responses, .len = PG_STATIC_ARRAY_LEN(responses)},
+          allocator);
+      for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(responses); i++) {
+        PgHttpClientResponse res = responses[i];
+        PG_ASSERT(0 == res.err);
+        PG_ASSERT(200 == res.res.status);
+        PG_ASSERT(pg_string_eq(res.body, PG_S("hello")));
+      }
+      PG_ASSERT(3 == client.connections_opened);
+
+      PgHttpClientResponse res = pg_http_client_do(&client, req, allocator);
+      PG_ASSERT(0 == res.err);
+      PG_ASSERT(3 == client.connections_opened);
+    }
+
+    // Concurrent: a response arriving in pieces, each within the read
+    // timeout, does not hold up the others: the request without a response
+    // times out meanwhile.
+    {
+      PgHttpClientRequest req_slow = req;
+      req_slow.req.url.path_components = (PG_DYN(PgString)){0};
+      PG_DYN_PUSH(&req_slow.req.url.path_components, PG_S("slow"), allocator);
+      PgHttpClientRequest req_hang = req;
+      req_hang.req.url.path_components = (PG_DYN(PgString)){0};
+      PG_DYN_PUSH(&req_hang.req.url.path_components, PG_S("hang"), allocator);
+
+      client.options.read_timeout_ms = 200;
+      PgHttpClientRequest reqs[3] = {req_slow, req_hang, req};
+      PgHttpClientResponse responses[3] = {0};
+      u64 start = PG_UNWRAP(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+      pg_http_client_do_many(
+          &client,
+          (PG_SLICE(PgHttpClientRequest)){.data = reqs,
+                                          .len = PG_STATIC_ARRAY_LEN(reqs)},
+          (PG_SLICE(PgHttpClientResponse)){
+              .data = responses, .len = PG_STATIC_ARRAY_LEN(responses)},
+          allocator);
+      u64 elapsed =
+          PG_UNWRAP(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC)) - start;
+      client.options.read_timeout_ms = 1000;
+
+      PG_ASSERT(0 == responses[0].err);
+      PG_ASSERT(200 == responses[0].res.status);
+      PG_ASSERT(pg_string_eq(responses[0].body, PG_S("hello")));
+      PG_ASSERT(ETIMEDOUT == responses[1].err);
+      PG_ASSERT(0 == responses[2].err);
+      PG_ASSERT(pg_string_eq(responses[2].body, PG_S("hello")));
+      // Not the time of the slow response plus the read timeout.
+      PG_ASSERT(elapsed < 300 * PG_Milliseconds);
+    }
+
+    // The server closes the connection after the response.
+    {
+      PgHttpClientRequest req_close = req;
+      pg_http_push_header(&req_close.req.headers, PG_S("Connection"),
+                          PG_S("close"), allocator);
+      PgHttpClientResponse res =
+          pg_http_client_do(&client, req_close, allocator);
+      PG_ASSERT(0 == res.err);
+      PG_ASSERT(pg_string_eq(res.body, PG_S("hello")));
+    }
+
+    // Idle connections expire.
+    client.options.idle_timeout_ms = 0;
+    pg_http_client_evict_idle(&client);
+    u64 opened = client.connections_opened;
+    PgHttpClientResponse res = pg_http_client_do(&client, req, allocator);
+    PG_ASSERT(0 == res.err);
+    PG_ASSERT(opened + 1 == client.connections_opened);
+
+    pg_http_client_close(&client);
+  }
+
+  // Not pooled, with the default body limit.
+  {
+    PG_RESULT(PgHttpClient, PgError)
+    res_client = pg_http_client_make(
+        (PgHttpClientOptions){
+            .connect_timeout_ms = 1000,
+            .read_timeout_ms = 1000,
+        },
+        allocator);
+    PgHttpClient client = PG_UNWRAP(res_client);
+    PG_ASSERT(16 * PG_MiB == client.options.max_body_len);
+
+    for (u64 i = 0; i < 3; i++) {
+      PgHttpClientResponse res = pg_http_client_do(&client, req, allocator);
+      PG_ASSERT(0 == res.err);
+      PG_ASSERT(pg_string_eq(res.body, PG_S("hello")));
+    }
+    PG_ASSERT(3 == client.connections_opened);
+
+    // Body too big.
+    client.options.max_body_len = 4;
+    PgHttpClientResponse res = pg_http_client_do(&client, req, allocator);
+    PG_ASSERT(PG_ERR_TOO_BIG == res.err);
+
+    pg_http_client_close(&client);
+  }
+
+  // Pooled, with the default idle timeout: the connection is reused.
+  {
+    PG_RESULT(PgHttpClient, PgError)
+    res_client = pg_http_client_make(
+        (PgHttpClientOptions){.max_idle_per_host = 1}, allocator);
+    PgHttpClient client = PG_UNWRAP(res_client);
+    PG_ASSERT(client.options.idle_timeout_ms > 0);
+
+    for (u64 i = 0; i < 2; i++) {
+      PgHttpClientResponse res = pg_http_client_do(&client, req, allocator);
+      PG_ASSERT(0 == res.err);
+      PG_ASSERT(pg_string_eq(res.body, PG_S("hello")));
+    }
+    PG_ASSERT(1 == client.connections_opened);
+
+    // Bytes after the response: the connection is not reused, which a
+    // request not retried on failure shows.
+    {
+      PgHttpClientRequest req_extra = req;
+      req_extra.req.url.path_components = (PG_DYN(PgString)){0};
+      PG_DYN_PUSH(&req_extra.req.url.path_components, PG_S("extra"),
+                  allocator);
+      PgHttpClientResponse res =
+          pg_http_client_do(&client, req_extra, allocator);
+      PG_ASSERT(0 == res.err);
+      PG_ASSERT(pg_string_eq(res.body, PG_S("hello")));
+
+      PgHttpClientRequest req_post = req;
+      req_post.req.method = PG_HTTP_METHOD_POST;
+      res = pg_http_client_do(&client, req_post, allocator);
+      PG_ASSERT(0 == res.err);
+      PG_ASSERT(pg_string_eq(res.body, PG_S("hello")));
+      PG_ASSERT(2 == client.connections_opened);
+    }
+
+    pg_http_client_close(&client);
+  }
+
+  server.stop = true;
+  {
+    PG_RESULT(PgFileDescriptor, PgError)
+    res_socket = pg_net_create_tcp_socket();
+    PgFileDescriptor socket = PG_UNWRAP(res_socket);
+    PG_ASSERT(0 == pg_net_connect_ipv4(socket, (PgIpv4Address){
+                                                   .ip = 0x7f000001,
+                                                   .port = port,
+                                               }));
+    (void)pg_net_socket_close(socket);
+  }
+  PG_ASSERT(0 == pg_thread_join(server_thread));
+  (void)pg_net_socket_close(server.listener);
+}
+
+static void test_net_ipv4_parse() {
+  {
+    PG_OPTION(u32) ip = pg_net_ipv4_parse(PG_S("127.0.0.1"));
+    PG_ASSERT(ip.has_value);
+    PG_ASSERT(0x7f000001 == ip.value);
+  }
+  {
+    PG_OPTION(u32) ip = pg_net_ipv4_parse(PG_S("255.255.255.255"));
+    PG_ASSERT(ip.has_value);
+    PG_ASSERT(UINT32_MAX == ip.value);
+  }
+  PG_ASSERT(!pg_net_ipv4_parse(PG_S("")).has_value);
+  PG_ASSERT(!pg_net_ipv4_parse(PG_S("1.2.3")).has_value);
+  PG_ASSERT(!pg_net_ipv4_parse(PG_S("1.2.3.4.5")).has_value);
+  PG_ASSERT(!pg_net_ipv4_parse(PG_S("256.0.0.1")).has_value);
+  PG_ASSERT(!pg_net_ipv4_parse(PG_S("0001.2.3.4")).has_value);
+  PG_ASSERT(!pg_net_ipv4_parse(PG_S("1.2.3.4 ")).has_value);
+  PG_ASSERT(!pg_net_ipv4_parse(PG_S("example.com")).has_value);
+
+  {
+    PG_OPTION(u32)
+    ip = pg_dns_resolv_conf_nameserver(PG_S("# Generated\n"
+                                            "search lan\n"
+                                            "nameserver ::1\n"
+                                            " nameserver 192.168.1.1\n"
+                                            "nameserver 10.0.0.1\n"));
+    PG_ASSERT(ip.has_value);
+    PG_ASSERT(0xc0a80101 == ip.value);
+  }
+  PG_ASSERT(!pg_dns_resolv_conf_nameserver(PG_S("search lan\n")).has_value);
+}
+
+static void test_net_ipv6_parse() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  {
+    PG_OPTION(PgIpAddress) ip = pg_net_ipv6_parse(PG_S("::1"));
+    PG_ASSERT(ip.has_value);
+    PG_ASSERT(PG_IP_FAMILY_V6 == ip.value.family);
+    for (u64 i = 0; i < 15; i++) {
+      PG_ASSERT(0 == ip.value.ipv6[i]);
+    }
+    PG_ASSERT(1 == ip.value.ipv6[15]);
+
+    ip.value.port = 80;
+    PG_ASSERT(pg_string_eq(PG_S("[::1]:80"),
+                           pg_net_ip_address_to_string(ip.value, allocator)));
+  }
+  {
+    PG_OPTION(PgIpAddress) ip = pg_net_ipv6_parse(PG_S("::ffff:1.2.3.4"));
+    PG_ASSERT(ip.has_value);
+    PG_ASSERT(0xff == ip.value.ipv6[10]);
+    PG_ASSERT(0xff == ip.value.ipv6[11]);
+    PG_ASSERT(1 == ip.value.ipv6[12]);
+    PG_ASSERT(4 == ip.value.ipv6[15]);
+  }
+
+  // Round trips to the canonical form.
+  PgString cases[][2] = {
+      {PG_S("::"), PG_S("[::]:0")},
+      {PG_S("2001:DB8::8:800:200C:417A"),
+       PG_S("[2001:db8::8:800:200c:417a]:0")},
+      {PG_S("2001:0db8:0000:0000:0000:0000:0000:0001"),
+       PG_S("[2001:db8::1]:0")},
+      {PG_S("2001:db8:0:1:1:1:1:1"), PG_S("[2001:db8:0:1:1:1:1:1]:0")},
+      {PG_S("1:0:0:2:0:0:0:3"), PG_S("[1:0:0:2::3]:0")},
+      {PG_S("1:0:0:2:0:0:3:4"), PG_S("[1::2:0:0:3:4]:0")},
+      {PG_S("1::"), PG_S("[1::]:0")},
+  };
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(cases); i++) {
+    PG_OPTION(PgIpAddress) ip = pg_net_ipv6_parse(cases[i][0]);
+    PG_ASSERT(ip.has_value);
+    PG_ASSERT(pg_string_eq(cases[i][1],
+                           pg_net_ip_address_to_string(ip.value, allocator)));
+  }
+
+  PgString invalid[] = {
+      PG_S(""),
+      PG_S(":"),
+      PG_S(":::"),
+      PG_S(":1"),
+      PG_S("1:"),
+      PG_S("1::2::3"),
+      PG_S("12345::"),
+      PG_S("g::"),
+      PG_S("1:2:3:4:5:6:7"),
+      PG_S("1:2:3:4:5:6:7:8:9"),
+      PG_S("1:2:3:4:5:6:7:8::"),
+      PG_S("1:2:3:4:5:6:7:1.2.3.4"),
+      PG_S("::1.2.3"),
+  };
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(invalid); i++) {
+    PG_ASSERT(!pg_net_ipv6_parse(invalid[i]).has_value);
+  }
+
+  {
+    PG_OPTION(PgIpAddress) ip = pg_net_ip_parse(PG_S("10.0.0.1"));
+    PG_ASSERT(ip.has_value);
+    PG_ASSERT(PG_IP_FAMILY_V4 == ip.value.family);
+    PG_ASSERT(0x0a000001 == ip.value.ipv4);
+    PG_ASSERT(pg_string_eq(PG_S("10.0.0.1:0"),
+                           pg_net_ip_address_to_string(ip.value, allocator)));
+  }
+}
+
+static void test_net_ip_addresses_interleave() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgIpAddress addresses[] = {
+      {.port = 1, .family = PG_IP_FAMILY_V6},
+      {.port = 2, .family = PG_IP_FAMILY_V6},
+      {.port = 3, .family = PG_IP_FAMILY_V4},
+      {.port = 4, .family = PG_IP_FAMILY_V4},
+      {.port = 5, .family = PG_IP_FAMILY_V6},
+  };
+  PG_SLICE(PgIpAddress)
+  res = pg_net_ip_addresses_interleave(
+      (PG_SLICE(PgIpAddress))PG_SLICE_FROM_C(addresses), allocator);
+
+  u16 expected[] = {1, 3, 2, 4, 5};
+  PG_ASSERT(PG_STATIC_ARRAY_LEN(expected) == res.len);
+  for (u64 i = 0; i < res.len; i++) {
+    PG_ASSERT(expected[i] == PG_SLICE_AT(res, i).port);
+  }
+}
+
+// Listening socket on the loopback, on a random port.
+static PgFileDescriptor test_net_listen(PgIpAddress address, u64 backlog) {
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_socket = pg_net_create_tcp_socket_ip(address.family);
+  PgFileDescriptor socket = PG_UNWRAP(res_socket);
+  PG_ASSERT(0 == pg_net_tcp_bind_ip(socket, address));
+  if (backlog) {
+    PG_ASSERT(0 == pg_net_tcp_listen(socket, backlog));
+  }
+  return socket;
+}
+
+static void test_net_connect_happy_eyeballs() {
+  PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PG_RESULT(PgAio, PgError) res_aio = pg_aio_init();
+  PgAio aio = PG_UNWRAP(res_aio);
+
+  PgIpAddress loopback = {.ipv4 = 0x7f000001, .family = PG_IP_FAMILY_V4};
+
+  PgFileDescriptor good = test_net_listen(loopback, 16);
+  PG_RESULT(PgIpAddress, PgError)
+  res_good_address = pg_net_socket_local_address_ip(good);
+  PgIpAddress good_address = PG_UNWRAP(res_good_address);
+  PG_ASSERT(PG_IP_FAMILY_V4 == good_address.family);
+  PG_ASSERT(0 != good_address.port);
+
+  // Bound but not listening: the connection is refused right away.
+  PgFileDescriptor refused = test_net_listen(loopback, 0);
+  PG_RESULT(PgIpAddress, PgError)
+  res_refused_address = pg_net_socket_local_address_ip(refused);
+  PgIpAddress refused_address = PG_UNWRAP(res_refused_address);
+
+  // A failure starts the next attempt without waiting.
+  {
+    PgIpAddress addresses[] = {refused_address, good_address};
+    u64 start_ns =
+        PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    PG_RESULT(PgIpAddressSocket, PgError)
+    res_connect = pg_net_connect_happy_eyeballs(
+        aio, (PG_SLICE(PgIpAddress))PG_SLICE_FROM_C(addresses),
+        (PgNetConnectOptions){.timeout_ms = 5000, .attempt_delay_ms = 5000},
+        allocator);
+    u64 end_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    PgIpAddressSocket conn = PG_UNWRAP(res_connect);
+    PG_ASSERT(good_address.port == conn.address.port);
+    PG_ASSERT(end_ns - start_ns < 1000 * PG_Milliseconds);
+
+    PgIpAddressAcceptResult res_accept = pg_net_tcp_accept_ip(good);
+    PG_ASSERT(0 == res_accept.err);
+    PG_ASSERT(PG_IP_FAMILY_V4 == res_accept.address.family);
+    PG_ASSERT(0x7f000001 == res_accept.address.ipv4);
+    (void)pg_net_socket_close(res_accept.socket);
+    (void)pg_net_socket_close(conn.socket);
+  }
+
+  // All fail.
+  {
+    PgIpAddress addresses[] = {refused_address};
+    PG_RESULT(PgIpAddressSocket, PgError)
+    res_connect = pg_net_connect_happy_eyeballs(
+        aio, (PG_SLICE(PgIpAddress))PG_SLICE_FROM_C(addresses),
+        (PgNetConnectOptions){0}, allocator);
+    PG_ASSERT(ECONNREFUSED == PG_UNWRAP_ERR(res_connect));
+  }
+
+  // An address that does not answer: its accept queue is full so the
+  // handshakes are dropped.
+  PgFileDescriptor stuck = test_net_listen(loopback, 1);
+  PG_RESULT(PgIpAddress, PgError)
+  res_stuck_address = pg_net_socket_local_address_ip(stuck);
+  PgIpAddress stuck_address = PG_UNWRAP(res_stuck_address);
+  PgFileDescriptor fillers[4] = {0};
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(fillers); i++) {
+    PG_RESULT(PgFileDescriptor, PgError)
+    res_filler = pg_net_create_tcp_socket_ip(PG_IP_FAMILY_V4);
+    fillers[i] = PG_UNWRAP(res_filler);
+    PG_ASSERT(0 == pg_fd_set_blocking(fillers[i], false));
+    PG_ASSERT(0 == pg_net_connect_ip(fillers[i], stuck_address));
+  }
+  // Let the handshakes of the fillers happen.
+  {
+    PgAioEvent events[1] = {0};
+    PG_RESULT(u64, PgError)
+    res_wait = pg_aio_wait(aio, (PG_SLICE(PgAioEvent))PG_SLICE_FROM_C(events),
+                           PG_SOME(50, u32));
+    PG_ASSERT(0 == PG_UNWRAP(res_wait));
+  }
+
+  // The next address races the stuck one after the attempt delay, and wins.
+  {
+    PgIpAddress addresses[] = {stuck_address, good_address};
+    u64 start_ns =
+        PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    PG_RESULT(PgIpAddressSocket, PgError)
+    res_connect = pg_net_connect_happy_eyeballs(
+        aio, (PG_SLICE(PgIpAddress))PG_SLICE_FROM_C(addresses),
+        (PgNetConnectOptions){.timeout_ms = 5000, .attempt_delay_ms = 50},
+        allocator);
+    u64 end_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+    PgIpAddressSocket conn = PG_UNWRAP(res_connect);
+    PG_ASSERT(good_address.port == conn.address.port);
+    PG_ASSERT(end_ns - start_ns >= 50 * PG_Milliseconds);
+    PG_ASSERT(end_ns - start_ns < 1000 * PG_Milliseconds);
+    (void)pg_net_socket_close(conn.socket);
+  }
+
+  // Timeout.
+  {
+    PgIpAddress addresses[] = {stuck_address};
+    PG_RESULT(PgIpAddressSocket, PgError)
+    res_connect = pg_net_connect_happy_eyeballs(
+        aio, (PG_SLICE(PgIpAddress))PG_SLICE_FROM_C(addresses),
+        (PgNetConnectOptions){.timeout_ms = 50}, allocator);
+    PG_ASSERT(ETIMEDOUT == PG_UNWRAP_ERR(res_connect));
+  }
+
+  // IPv6, when the loopback has an IPv6 address.
+  PgIpAddress loopback6 = {.family = PG_IP_FAMILY_V6};
+  loopback6.ipv6[15] = 1;
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_good6 = pg_net_create_tcp_socket_ip(PG_IP_FAMILY_V6);
+  PgFileDescriptor good6 = PG_UNWRAP(res_good6);
+  if (0 == pg_net_tcp_bind_ip(good6, loopback6)) {
+    PG_ASSERT(0 == pg_net_tcp_listen(good6, 16));
+    PG_RESULT(PgIpAddress, PgError)
+    res_good6_address = pg_net_socket_local_address_ip(good6);
+    PgIpAddress good6_address = PG_UNWRAP(res_good6_address);
+    PG_ASSERT(PG_IP_FAMILY_V6 == good6_address.family);
+
+    PgIpAddress addresses[] = {good6_address, good_address};
+    PG_RESULT(PgIpAddressSocket, PgError)
+    res_connect = pg_net_connect_happy_eyeballs(
+        aio, (PG_SLICE(PgIpAddress))PG_SLICE_FROM_C(addresses),
+        (PgNetConnectOptions){.timeout_ms = 5000}, allocator);
+    PgIpAddressSocket conn = PG_UNWRAP(res_connect);
+    PG_ASSERT(PG_IP_FAMILY_V6 == conn.address.family);
+
+    PgIpAddressAcceptResult res_accept = pg_net_tcp_accept_ip(good6);
+    PG_ASSERT(0 == res_accept.err);
+    PG_ASSERT(PG_IP_FAMILY_V6 == res_accept.address.family);
+    PG_ASSERT(1 == res_accept.address.ipv6[15]);
+    (void)pg_net_socket_close(res_accept.socket);
+    (void)pg_net_socket_close(conn.socket);
+  }
+  (void)pg_net_socket_close(good6);
+
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(fillers); i++) {
+    (void)pg_net_socket_close(fillers[i]);
+  }
+  (void)pg_net_socket_close(stuck);
+  (void)pg_net_socket_close(refused);
+  (void)pg_net_socket_close(good);
+  (void)pg_file_close(aio.aio);
+}
+
+static PgFileDescriptor test_net_udp_socket(PgIpAddress *address) {
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_socket = pg_net_create_udp_socket_ip(address->family);
+  PgFileDescriptor socket = PG_UNWRAP(res_socket);
+  PG_ASSERT(0 == pg_net_udp_bind_ip(socket, *address));
+  PG_ASSERT(0 == pg_fd_set_blocking(socket, false));
+
+  PG_RESULT(PgIpAddress, PgError)
+  res_address = pg_net_socket_local_address_ip(socket);
+  *address = PG_UNWRAP(res_address);
+  return socket;
+}
+
+static void test_net_udp_batch() {
+  PG_RESULT(PgAio, PgError) res_aio = pg_aio_init();
+  PgAio aio = PG_UNWRAP(res_aio);
+
+  PgIpAddress sender_address = {.ipv4 = 0x7f000001,
+                                .family = PG_IP_FAMILY_V4};
+  PgIpAddress receiver_address = sender_address;
+  PgFileDescriptor sender = test_net_udp_socket(&sender_address);
+  PgFileDescriptor receiver = test_net_udp_socket(&receiver_address);
+  PG_ASSERT(0 == pg_aio_register_interest_fd(aio, receiver,
+                                             PG_AIO_EVENT_KIND_READABLE));
+
+  u8 bufs[4][16] = {0};
+  PgUdpDatagram datagrams_data[4] = {0};
+  PG_SLICE(PgUdpDatagram) datagrams = PG_SLICE_FROM_C(datagrams_data);
+  for (u64 i = 0; i < datagrams.len; i++) {
+    PG_SLICE_AT(datagrams, i).data = (PgString){bufs[i], sizeof(bufs[i])};
+  }
+
+  // Nothing yet.
+  {
+    PG_RESULT(u64, PgError)
+    res_recv = pg_net_udp_recv_batch(receiver, datagrams);
+    PG_ASSERT(EAGAIN == PG_UNWRAP_ERR(res_recv));
+  }
+
+  // Batched send, readiness, batched receive.
+  {
+    PgUdpDatagram sent_data[] = {
+        {.data = PG_S("foo"), .address = receiver_address},
+        {.data = PG_S("hello"), .address = receiver_address},
+        {.data = PG_S("0123456789abcdefXYZ"), .address = receiver_address},
+    };
+    PG_SLICE(PgUdpDatagram) sent = PG_SLICE_FROM_C(sent_data);
+    PG_RESULT(u64, PgError) res_send = pg_net_udp_send_batch(sender, sent);
+    PG_ASSERT(3 == PG_UNWRAP(res_send));
+
+    PgAioEvent events_data[1] = {0};
+    PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+    PG_RESULT(u64, PgError)
+    res_wait = pg_aio_wait(aio, events, PG_SOME(1000, u32));
+    PG_ASSERT(1 == PG_UNWRAP(res_wait));
+    PG_ASSERT(receiver.fd == PG_SLICE_AT(events, 0).fd.fd);
+
+    PG_RESULT(u64, PgError)
+    res_recv = pg_net_udp_recv_batch(receiver, datagrams);
+    PG_ASSERT(3 == PG_UNWRAP(res_recv));
+    for (u64 i = 0; i < 3; i++) {
+      PgUdpDatagram datagram = PG_SLICE_AT(datagrams, i);
+      PG_ASSERT(PG_IP_FAMILY_V4 == datagram.address.family);
+      PG_ASSERT(sender_address.ipv4 == datagram.address.ipv4);
+      PG_ASSERT(sender_address.port == datagram.address.port);
+      PG_ASSERT(0 == datagram.segment_len);
+    }
+    PG_ASSERT(pg_string_eq(PG_S("foo"), PG_SLICE_AT(datagrams, 0).data));
+    PG_ASSERT(pg_string_eq(PG_S("hello"), PG_SLICE_AT(datagrams, 1).data));
+    PG_ASSERT(!PG_SLICE_AT(datagrams, 1).truncated);
+    PG_ASSERT(pg_string_eq(PG_S("0123456789abcdef"),
+                           PG_SLICE_AT(datagrams, 2).data));
+    PG_ASSERT(PG_SLICE_AT(datagrams, 2).truncated);
+  }
+
+  // Connected: no address needed.
+  {
+    PG_ASSERT(0 == pg_net_udp_connect_ip(sender, receiver_address));
+    PgUdpDatagram sent_data[] = {{.data = PG_S("bar")}};
+    PG_SLICE(PgUdpDatagram) sent = PG_SLICE_FROM_C(sent_data);
+    PG_RESULT(u64, PgError) res_send = pg_net_udp_send_batch(sender, sent);
+    PG_ASSERT(1 == PG_UNWRAP(res_send));
+
+    PgAioEvent events_data[1] = {0};
+    PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+    PG_RESULT(u64, PgError)
+    res_wait = pg_aio_wait(aio, events, PG_SOME(1000, u32));
+    PG_ASSERT(1 == PG_UNWRAP(res_wait));
+
+    for (u64 i = 0; i < datagrams.len; i++) {
+      PG_SLICE_AT(datagrams, i).data = (PgString){bufs[i], sizeof(bufs[i])};
+    }
+    PG_RESULT(u64, PgError)
+    res_recv = pg_net_udp_recv_batch(receiver, datagrams);
+    PG_ASSERT(1 == PG_UNWRAP(res_recv));
+    PG_ASSERT(pg_string_eq(PG_S("bar"), PG_SLICE_AT(datagrams, 0).data));
+  }
+
+#ifdef PG_OS_LINUX
+  // Segmentation offload: one buffer goes out as 3 datagrams...
+  PgUdpDatagram gso_data[] = {{.data = PG_S("aaaabbbbcc"), .segment_len = 4}};
+  PG_SLICE(PgUdpDatagram) gso = PG_SLICE_FROM_C(gso_data);
+  {
+    PG_RESULT(u64, PgError) res_send = pg_net_udp_send_batch(sender, gso);
+    PG_ASSERT(1 == PG_UNWRAP(res_send));
+
+    PgAioEvent events_data[1] = {0};
+    PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+    PG_RESULT(u64, PgError)
+    res_wait = pg_aio_wait(aio, events, PG_SOME(1000, u32));
+    PG_ASSERT(1 == PG_UNWRAP(res_wait));
+
+    for (u64 i = 0; i < datagrams.len; i++) {
+      PG_SLICE_AT(datagrams, i).data = (PgString){bufs[i], sizeof(bufs[i])};
+    }
+    PG_RESULT(u64, PgError)
+    res_recv = pg_net_udp_recv_batch(receiver, datagrams);
+    PG_ASSERT(3 == PG_UNWRAP(res_recv));
+    PG_ASSERT(pg_string_eq(PG_S("aaaa"), PG_SLICE_AT(datagrams, 0).data));
+    PG_ASSERT(pg_string_eq(PG_S("bbbb"), PG_SLICE_AT(datagrams, 1).data));
+    PG_ASSERT(pg_string_eq(PG_S("cc"), PG_SLICE_AT(datagrams, 2).data));
+  }
+
+  // ... and with receive offload, comes back as one.
+  {
+    PG_ASSERT(0 == pg_net_udp_set_gro(receiver, true));
+    PG_RESULT(u64, PgError) res_send = pg_net_udp_send_batch(sender, gso);
+    PG_ASSERT(1 == PG_UNWRAP(res_send));
+
+    PgAioEvent events_data[1] = {0};
+    PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+    PG_RESULT(u64, PgError)
+    res_wait = pg_aio_wait(aio, events, PG_SOME(1000, u32));
+    PG_ASSERT(1 == PG_UNWRAP(res_wait));
+
+    for (u64 i = 0; i < datagrams.len; i++) {
+      PG_SLICE_AT(datagrams, i).data = (PgString){bufs[i], sizeof(bufs[i])};
+    }
+    PG_RESULT(u64, PgError)
+    res_recv = pg_net_udp_recv_batch(receiver, datagrams);
+    PG_ASSERT(1 == PG_UNWRAP(res_recv));
+    PG_ASSERT(pg_string_eq(PG_S("aaaabbbbcc"), PG_SLICE_AT(datagrams, 0).data));
+    PG_ASSERT(4 == PG_SLICE_AT(datagrams, 0).segment_len);
+  }
+#endif
+
+  PG_ASSERT(0 == pg_net_socket_close(sender));
+  PG_ASSERT(0 == pg_net_socket_close(receiver));
+  (void)pg_file_close(aio.aio);
+}
+
+static void test_http_server_admit() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgHttpServerOptions options = {
+      .max_connections = 2,
+      .max_queue_ms = 50,
+  };
+  PgRateLimiter limiter = pg_rate_limiter_make(1, 1, 16, allocator);
+  PgIpv4Address client = {.ip = 0x7f000001};
+  PgIpv4Address other = {.ip = 0x7f000002};
+  u64 now_ns = 1000 * PG_Seconds;
+
+  PG_ASSERT(PG_HTTP_ADMISSION_OVERLOADED ==
+            pg_http_server_admit(options, &limiter, 0, client, 51, now_ns));
+  PG_ASSERT(PG_HTTP_ADMISSION_OVERLOADED ==
+            pg_http_server_admit(options, &limiter, 2, client, 0, now_ns));
+
+  // No token was spent on the connections turned away.
+  PG_ASSERT(PG_HTTP_ADMISSION_ACCEPT ==
+            pg_http_server_admit(options, &limiter, 1, client, 50, now_ns));
+  PG_ASSERT(PG_HTTP_ADMISSION_RATE_LIMITED ==
+            pg_http_server_admit(options, &limiter, 1, client, 0, now_ns));
+  PG_ASSERT(PG_HTTP_ADMISSION_ACCEPT ==
+            pg_http_server_admit(options, &limiter, 1, other, 0, now_ns));
+
+  // All disabled.
+  PG_ASSERT(PG_HTTP_ADMISSION_ACCEPT ==
+            pg_http_server_admit((PgHttpServerOptions){0}, nullptr, 1000,
+                                 client, 1000, now_ns));
+}
+
+static void test_http_server_reject() {
+  PgArena arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgIpAddress loopback = {.ipv4 = 0x7f000001, .family = PG_IP_FAMILY_V4};
+  PgFileDescriptor listener = test_net_listen(loopback, 16);
+  PG_RESULT(PgIpAddress, PgError)
+  res_address = pg_net_socket_local_address_ip(listener);
+  PgIpAddress address = PG_UNWRAP(res_address);
+
+  PG_RESULT(PgFileDescriptor, PgError)
+  res_client = pg_net_create_tcp_socket_ip(PG_IP_FAMILY_V4);
+  PgFileDescriptor client = PG_UNWRAP(res_client);
+  PG_ASSERT(0 == pg_net_connect_ip(client, address));
+
+  // More than one read of the request is unread when the response is sent.
+  PgWriter writer = pg_writer_make_from_socket(client, 64, allocator);
+  PG_ASSERT(0 == pg_writer_write_full(&writer,
+                                      PG_S("POST / HTTP/1.1\r\nHost: a\r\n"
+                                           "Content-Length: 32768\r\n\r\n"),
+                                      allocator));
+  PgString body = pg_string_make(32 * PG_KiB, allocator);
+  PG_ASSERT(0 == pg_writer_write_full(&writer, body, allocator));
+  PG_ASSERT(0 == pg_writer_flush(&writer, allocator));
+
+  // Let the connection sit in the accept queue.
+  {
+    PG_RESULT(PgAio, PgError) res_aio = pg_aio_init();
+    PgAio aio = PG_UNWRAP(res_aio);
+    PgAioEvent events_data[1] = {0};
+    PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+    PG_RESULT(u64, PgError)
+    res_wait = pg_aio_wait(aio, events, PG_SOME(30, u32));
+    PG_ASSERT(0 == PG_UNWRAP(res_wait));
+    (void)pg_file_close(aio.aio);
+  }
+
+  PgIpv4AddressAcceptResult res_accept = pg_net_tcp_accept(listener);
+  PG_ASSERT(0 == res_accept.err);
+#ifdef PG_OS_LINUX
+  PG_ASSERT(pg_net_tcp_queue_time_ms(res_accept.socket) >= 20);
+#endif
+  pg_http_server_reject(res_accept.socket, PG_HTTP_ADMISSION_OVERLOADED);
+
+  PgReader reader = pg_reader_make_from_socket(client, 256, allocator);
+  PgHttpResponseReadResult res_response =
+      pg_http_read_response(&reader, allocator);
+  PG_ASSERT(0 == res_response.err);
+  PG_ASSERT(res_response.done);
+  PG_ASSERT(503 == res_response.resp.status);
+  // Closed, not reset: the client can still write, e.g. the rest of its
+  // request.
+  PG_ASSERT(1 == send(client.fd, "x", 1, MSG_NOSIGNAL));
+
+  PG_ASSERT(0 == pg_net_socket_close(client));
+  PG_ASSERT(0 == pg_net_socket_close(listener));
+}
+
+static void test_dns_query_encode() {
+  u8 dst_data[PG_DNS_UDP_MAX_LEN] = {0};
+  PgString dst = {.data = dst_data, .len = sizeof(dst_data)};
+
+  PG_RESULT(u64, PgError)
+  res = pg_dns_query_encode(0xabcd, PG_S("Example.com."), dst);
+  u64 len = PG_UNWRAP(res);
+
+  u8 expected[] = {
+      0xab, 0xcd, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      7,    'E',  'x',  'a',  'm',  'p',  'l',  'e',  3,    'c',  'o',  'm',
+      0,    0x00, 0x01, 0x00, 0x01,
+  };
+  PG_ASSERT(sizeof(expected) == len);
+  PG_ASSERT(pg_string_eq(PG_SLICE_RANGE(dst, 0, len),
+                         (PgString){.data = expected, .len = len}));
+
+  PG_ASSERT(PG_IS_ERR(pg_dns_query_encode(1, PG_S(""), dst)));
+  PG_ASSERT(PG_IS_ERR(pg_dns_query_encode(1, PG_S("a..b"), dst)));
+  // Label longer than 63 bytes.
+  PG_ASSERT(PG_IS_ERR(pg_dns_query_encode(
+      1,
+      PG_S("a123456789012345678901234567890"
+           "123456789012345678901234567890123"),
+      dst)));
+}
+
+static void test_dns_response_parse() {
+  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // `www.example.com` is a CNAME for `example.com` which has 2 addresses.
+  {
+    u8 msg_data[] = {
+        // Header.
+        0x12, 0x34, 0x81, 0x80, 0, 1, 0, 3, 0, 0, 0, 0,
+        // Question.
+        3, 'w', 'w', 'w', 7, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 3, 'c', 'o',
+        'm', 0, 0, 1, 0, 1,
+        // CNAME to `example.com` at offset 16, TTL 300.
+        0xc0, 0x0c, 0, 5, 0, 1, 0, 0, 0x01, 0x2c, 0, 2, 0xc0, 0x10,
+        // A 1.2.3.4, TTL 60.
+        0xc0, 0x10, 0, 1, 0, 1, 0, 0, 0, 60, 0, 4, 1, 2, 3, 4,
+        // A 5.6.7.8, TTL 120.
+        0xc0, 0x10, 0, 1, 0, 1, 0, 0, 0, 120, 0, 4, 5, 6, 7, 8,
+    };
+    PgString msg = {.data = msg_data, .len = sizeof(msg_data)};
+
+    PG_RESULT(PgDnsAnswer, PgError)
+    res = pg_dns_response_parse(msg, 0x1234, PG_S("WWW.example.com"),
+                                allocator);
+    PgDnsAnswer answer = PG_UNWRAP(res);
+    PG_ASSERT(0 == answer.rcode);
+    PG_ASSERT(answer.ttl_present);
+    PG_ASSERT(60 == answer.ttl_s);
+    PG_ASSERT(2 == answer.addresses.len);
+    PG_ASSERT(0x01020304 == PG_SLICE_AT(answer.addresses, 0));
+    PG_ASSERT(0x05060708 == PG_SLICE_AT(answer.addresses, 1));
+
+    // Another query.
+    PG_ASSERT(PG_IS_ERR(pg_dns_response_parse(msg, 0x1235,
+                                              PG_S("www.example.com"),
+                                              allocator)));
+    PG_ASSERT(PG_IS_ERR(
+        pg_dns_response_parse(msg, 0x1234, PG_S("example.com"), allocator)));
+
+    // Truncated.
+    PG_ASSERT(PG_IS_ERR(pg_dns_response_parse(PG_SLICE_RANGE(msg, 0, 50),
+                                              0x1234, PG_S("www.example.com"),
+                                              allocator)));
+  }
+
+  // NXDOMAIN with the SOA record of the zone.
+  {
+    u8 msg_data[] = {
+        // Header.
+        0xab, 0xcd, 0x81, 0x83, 0, 1, 0, 0, 0, 1, 0, 0,
+        // Question.
+        3, 'f', 'o', 'o', 7, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 3, 'c', 'o',
+        'm', 0, 0, 1, 0, 1,
+        // SOA of `example.com`, TTL 900.
+        0xc0, 0x10, 0, 6, 0, 1, 0, 0, 0x03, 0x84, 0, 24,
+        // MNAME, RNAME.
+        0xc0, 0x10, 0xc0, 0x10,
+        // SERIAL, REFRESH, RETRY, EXPIRE, MINIMUM (30).
+        0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0, 30,
+    };
+    PgString msg = {.data = msg_data, .len = sizeof(msg_data)};
+
+    PG_RESULT(PgDnsAnswer, PgError)
+    res = pg_dns_response_parse(msg, 0xabcd, PG_S("foo.example.com"),
+                                allocator);
+    PgDnsAnswer answer = PG_UNWRAP(res);
+    PG_ASSERT(PG_DNS_RCODE_NXDOMAIN == answer.rcode);
+    PG_ASSERT(0 == answer.addresses.len);
+    PG_ASSERT(answer.ttl_present);
+    PG_ASSERT(30 == answer.ttl_s);
+  }
+}
+
+// Reply to `query` as a DNS server would, with one A record, or with a SOA
+// record for a negative answer.
+static PgString test_dns_reply(PgString query, u8 rcode, u32 ip, u32 ttl,
+                               PgString dst) {
+  pg_memcpy(dst.data, query.data, query.len);
+  u64 len = query.len;
+
+  pg_dns_write_u16(dst, 2, (u16)(0x8180 | rcode));
+  pg_dns_write_u16(dst, 6, ip ? 1 : 0);
+  pg_dns_write_u16(dst, 8, ip ? 0 : 1);
+
+  pg_dns_write_u16(dst, len, 0xc00c);
+  pg_dns_write_u16(dst, len + 2, ip ? PG_DNS_TYPE_A : PG_DNS_TYPE_SOA);
+  pg_dns_write_u16(dst, len + 4, PG_DNS_CLASS_IN);
+  pg_dns_write_u16(dst, len + 6, (u16)(ttl >> 16));
+  pg_dns_write_u16(dst, len + 8, (u16)ttl);
+  len += 10;
+
+  if (ip) {
+    pg_dns_write_u16(dst, len, 4);
+    pg_dns_write_u16(dst, len + 2, (u16)(ip >> 16));
+    pg_dns_write_u16(dst, len + 4, (u16)ip);
+    len += 6;
+  } else {
+    // Root MNAME and RNAME, then SERIAL etc. MINIMUM is `ttl` as well.
+    pg_dns_write_u16(dst, len, 22);
+    for (u64 i = 0; i < 22; i++) {
+      PG_SLICE_AT(dst, len + 2 + i) = 0;
+    }
+    pg_dns_write_u16(dst, len + 2 + 18, (u16)(ttl >> 16));
+    pg_dns_write_u16(dst, len + 2 + 20, (u16)ttl);
+    len += 2 + 22;
+  }
+
+  return PG_SLICE_RANGE(dst, 0, len);
+}
+
+// Receive the next query on the stub server socket and reply to it.
+static void test_dns_stub_serve(PgFileDescriptor server, PgDnsResolver *r,
+                                u16 id_delta, u8 rcode, u32 ip, u32 ttl) {
+  u8 query_data[PG_DNS_UDP_MAX_LEN] = {0};
+  PgString query = {.data = query_data, .len = sizeof(query_data)};
+  PgIpv4AddressRecvResult res_recv = pg_net_udp_recv_from(server, query);
+  PG_ASSERT(0 == res_recv.err);
+  query.len = res_recv.len;
+  PG_ASSERT(query.len > PG_DNS_HEADER_LEN);
+  pg_dns_write_u16(query, 0, (u16)(pg_dns_read_u16(query, 0) + id_delta));
+
+  u8 reply_data[PG_DNS_UDP_MAX_LEN] = {0};
+  PgString reply =
+      test_dns_reply(query, rcode, ip, ttl,
+                     (PgString){.data = reply_data, .len = sizeof(reply_data)});
+  PG_RESULT(u64, PgError)
+  res_send = pg_net_udp_send_to(server, reply, res_recv.address);
+  PG_ASSERT(reply.len == PG_UNWRAP(res_send));
+
+  PgAioEvent events[1] = {0};
+  PG_RESULT(u64, PgError)
+  res_wait = pg_aio_wait(r->aio, (PG_SLICE(PgAioEvent))PG_SLICE_FROM_C(events),
+                         PG_SOME(1000, u32));
+  PG_ASSERT(1 == PG_UNWRAP(res_wait));
+}
+
+static void test_dns_resolver() {
+  PgArena arena = pg_arena_make_from_virtual_mem(256 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  // Stub DNS server.
+  PG_RESULT(PgFileDescriptor, PgError) res_server = pg_net_create_udp_socket();
+  PgFileDescriptor server = PG_UNWRAP(res_server);
+  PG_ASSERT(0 == pg_net_tcp_bind_ipv4(server, (PgIpv4Address){
+                                                  .ip = 0x7f000001,
+                                              }));
+  PG_ASSERT(0 == pg_net_socket_set_timeout(server, 1, 0));
+  PG_RESULT(PgIpv4Address, PgError)
+  res_server_address = pg_net_socket_local_address(server);
+  PgIpv4Address server_address = PG_UNWRAP(res_server_address);
+
+  PG_RESULT(PgDnsResolver, PgError)
+  res_resolver = pg_dns_resolver_make(
+      (PgDnsResolverOptions){
+          .server = server_address,
+          .timeout_ms = 1000,
+          .attempts = 1,
+      },
+      allocator);
+  PgDnsResolver r = PG_UNWRAP(res_resolver);
+
+  u64 now_ns = 1000 * PG_Seconds;
+
+  // Concurrent lookups share one query.
+  {
+    PgDnsLookup lookup =
+        pg_dns_resolver_lookup(&r, PG_S("Example.com"), now_ns);
+    PG_ASSERT(lookup.pending);
+    PG_ASSERT(0 == lookup.err);
+
+    lookup = pg_dns_resolver_lookup(&r, PG_S("example.com."), now_ns);
+    PG_ASSERT(lookup.pending);
+    PG_ASSERT(1 == r.queries_sent);
+
+    PG_OPTION(u32) timeout_ms = pg_dns_resolver_timeout_ms(&r, now_ns);
+    PG_ASSERT(timeout_ms.has_value);
+    PG_ASSERT(1000 == timeout_ms.value);
+  }
 
-static void test_string_builder_append_u64() {
-  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
-  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
-  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+  // A reply to another query is ignored, and the query times out.
+  {
+    test_dns_stub_serve(server, &r, 1, 0, 0x01020304, 10);
+    PG_ASSERT(0 == pg_dns_resolver_on_readable(&r, now_ns, allocator));
+    PG_ASSERT(pg_dns_resolver_lookup(&r, PG_S("example.com"), now_ns).pending);
+    PG_ASSERT(1 == r.queries_sent);
 
-  // Zero.
+    now_ns += 1000 * PG_Milliseconds;
+    pg_dns_resolver_on_timer(&r, now_ns);
+    PG_ASSERT(1 == r.queries_sent); // Single attempt.
+    PgDnsLookup lookup =
+        pg_dns_resolver_lookup(&r, PG_S("example.com"), now_ns);
+    PG_ASSERT(ETIMEDOUT == lookup.err);
+  }
+
+  // The failure is cached, then the name is queried again.
   {
-    Pgu8Dyn sb = {0};
-    pg_string_builder_append_u64(&sb, 0, allocator);
-    PgString out = PG_DYN_TO_SLICE(PgString, sb);
-    PgString expected = PG_S("0");
+    now_ns += 1 * PG_Seconds;
+    PG_ASSERT(ETIMEDOUT ==
+              pg_dns_resolver_lookup(&r, PG_S("example.com"), now_ns).err);
+    PG_ASSERT(1 == r.queries_sent);
 
-    PG_ASSERT(pg_string_eq(out, expected));
+    now_ns += r.options.negative_ttl_ms * PG_Milliseconds;
+    PG_ASSERT(pg_dns_resolver_lookup(&r, PG_S("example.com"), now_ns).pending);
+    PG_ASSERT(2 == r.queries_sent);
+
+    test_dns_stub_serve(server, &r, 0, 0, 0x01020304, 10);
+    PG_ASSERT(0 == pg_dns_resolver_on_readable(&r, now_ns, allocator));
+    PG_ASSERT(!pg_dns_resolver_timeout_ms(&r, now_ns).has_value);
+
+    PgDnsLookup lookup =
+        pg_dns_resolver_lookup(&r, PG_S("EXAMPLE.com"), now_ns);
+    PG_ASSERT(!lookup.pending);
+    PG_ASSERT(0 == lookup.err);
+    PG_ASSERT(1 == lookup.addresses.len);
+    PG_ASSERT(0x01020304 == PG_SLICE_AT(lookup.addresses, 0));
   }
 
-  // Other numbers.
+  // Cached for the TTL of the record.
   {
-    Pgu8Dyn sb = {0};
-    pg_string_builder_append_u64(&sb, 4'056'123'789, allocator);
-    PgString out = PG_DYN_TO_SLICE(PgString, sb);
-    PgString expected = PG_S("4056123789");
+    now_ns += 9 * PG_Seconds;
+    PgDnsLookup lookup =
+        pg_dns_resolver_lookup(&r, PG_S("example.com"), now_ns);
+    PG_ASSERT(1 == lookup.addresses.len);
+    PG_ASSERT(2 == r.queries_sent);
 
-    PG_ASSERT(pg_string_eq(out, expected));
+    now_ns += 1 * PG_Seconds;
+    lookup = pg_dns_resolver_lookup(&r, PG_S("example.com"), now_ns);
+    PG_ASSERT(lookup.pending);
+    PG_ASSERT(3 == r.queries_sent);
   }
-}
 
-static void test_string_buillder_append_u64_hex() {
-  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
-  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
-  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+  // Negative answer, cached for the TTL of the SOA record.
+  {
+    test_dns_stub_serve(server, &r, 0, PG_DNS_RCODE_NXDOMAIN, 0, 30);
+    PG_ASSERT(0 == pg_dns_resolver_on_readable(&r, now_ns, allocator));
 
-  Pgu8Dyn sb = {0};
-  pg_string_builder_append_u64_hex(&sb, 0x1f34c /* 🍌 */, allocator);
-  PgString out = PG_DYN_TO_SLICE(PgString, sb);
-  PgString expected = PG_S("1f34c");
+    PgDnsLookup lookup =
+        pg_dns_resolver_lookup(&r, PG_S("example.com"), now_ns);
+    PG_ASSERT(PG_ERR_DNS_NOT_FOUND == lookup.err);
 
-  PG_ASSERT(pg_string_eq(out, expected));
-}
+    now_ns += 29 * PG_Seconds;
+    lookup = pg_dns_resolver_lookup(&r, PG_S("example.com"), now_ns);
+    PG_ASSERT(PG_ERR_DNS_NOT_FOUND == lookup.err);
+    PG_ASSERT(3 == r.queries_sent);
+  }
 
-static void test_adjacency_matrix() {
-  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
-  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
-  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+  // Hosts and IP literals are answered without a query.
+  {
+    pg_dns_resolver_add_hosts(&r, PG_S("# Comment\n"
+                                       "10.0.0.1 myhost  other # Comment\n"
+                                       "::1 ip6-localhost\n"));
+    PgDnsLookup lookup = pg_dns_resolver_lookup(&r, PG_S("MyHost"), now_ns);
+    PG_ASSERT(1 == lookup.addresses.len);
+    PG_ASSERT(0x0a000001 == PG_SLICE_AT(lookup.addresses, 0));
 
-  PgAdjacencyMatrix matrix = pg_adjacency_matrix_make(6, allocator);
-  PG_ASSERT(pg_adjacency_matrix_is_empty(matrix));
+    now_ns += 3600 * PG_Seconds;
+    lookup = pg_dns_resolver_lookup(&r, PG_S("other"), now_ns);
+    PG_ASSERT(1 == lookup.addresses.len);
+    PG_ASSERT(0x0a000001 == PG_SLICE_AT(lookup.addresses, 0));
 
-  pg_adjacency_matrix_add_edge(&matrix, 2, 0);
-  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 2, 0));
-  pg_adjacency_matrix_add_edge(&matrix, 3, 1);
-  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 3, 1));
-  pg_adjacency_matrix_add_edge(&matrix, 3, 2);
-  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 3, 2));
-  pg_adjacency_matrix_add_edge(&matrix, 5, 0);
-  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 0));
-  pg_adjacency_matrix_add_edge(&matrix, 5, 1);
-  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 1));
-  pg_adjacency_matrix_add_edge(&matrix, 5, 2);
-  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 2));
-  pg_adjacency_matrix_add_edge(&matrix, 5, 3);
-  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 3));
-  pg_adjacency_matrix_add_edge(&matrix, 5, 4);
-  PG_ASSERT(pg_adjacency_matrix_has_edge(matrix, 5, 4));
+    PG_RESULT(PG_SLICE(u32), PgError)
+    res_resolve = pg_dns_resolver_resolve(&r, PG_S("192.168.0.1"), allocator);
+    PG_SLICE(u32) addresses = PG_UNWRAP(res_resolve);
+    PG_ASSERT(1 == addresses.len);
+    PG_ASSERT(0xc0a80001 == PG_SLICE_AT(addresses, 0));
 
-  PG_ASSERT(!pg_adjacency_matrix_is_empty(matrix));
+    PG_ASSERT(3 == r.queries_sent);
+  }
 
-  PG_ASSERT(2 == pg_adjacency_matrix_count_neighbors(matrix, 0));
-  PG_ASSERT(2 == pg_adjacency_matrix_count_neighbors(matrix, 1));
-  PG_ASSERT(3 == pg_adjacency_matrix_count_neighbors(matrix, 2));
-  PG_ASSERT(3 == pg_adjacency_matrix_count_neighbors(matrix, 3));
-  PG_ASSERT(1 == pg_adjacency_matrix_count_neighbors(matrix, 4));
-  PG_ASSERT(5 == pg_adjacency_matrix_count_neighbors(matrix, 5));
+  pg_dns_resolver_close(&r);
+  (void)pg_net_socket_close(server);
 }
 
-static i32 test_thread_fn(void *data) {
-  PG_ASSERT(data);
-
-  u64 *n = data;
-  *n = 42;
+static void test_timer_wheel() {
+  PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
 
-  return 0;
+  u64 start_ns = 1000 * PG_Seconds;
+  PgTimerWheel *wheel =
+      pg_timer_wheel_make(PG_Milliseconds, start_ns, allocator);
+  PG_ASSERT(!pg_timer_wheel_next_deadline_ns(wheel).has_value);
+
+  // One per level, plus one in the past and one beyond the top level.
+  u64 delays_ns[] = {
+      0,
+      5 * PG_Milliseconds + 1, // Rounded up.
+      300 * PG_Milliseconds,
+      70 * PG_Seconds,
+      5 * 3600 * PG_Seconds,
+      60 * 24 * 3600 * PG_Seconds,
+  };
+  PgTimer timers[PG_STATIC_ARRAY_LEN(delays_ns)] = {0};
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(timers); i++) {
+    pg_timer_wheel_insert(wheel, &timers[i], start_ns + delays_ns[i], i);
+    PG_ASSERT(pg_timer_is_armed(&timers[i]));
+  }
+  PG_ASSERT(PG_STATIC_ARRAY_LEN(timers) == wheel->count);
+
+  PgAioEvent events_data[4] = {0};
+  PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+
+  PG_ASSERT(start_ns == pg_timer_wheel_next_deadline_ns(wheel).value);
+  PG_ASSERT(1 == pg_timer_wheel_expire(wheel, start_ns, events));
+  PG_ASSERT(PG_AIO_EVENT_KIND_TIMER == PG_SLICE_AT(events, 0).kind);
+  PG_ASSERT(0 == PG_SLICE_AT(events, 0).user_data);
+  PG_ASSERT(!pg_timer_is_armed(&timers[0]));
+
+  // Each timer expires on time, never early, however far the wheel jumps.
+  for (u64 i = 1; i < PG_STATIC_ARRAY_LEN(timers); i++) {
+    u64 deadline_ns = start_ns + delays_ns[i];
+    PG_OPTION(u64) next_ns = pg_timer_wheel_next_deadline_ns(wheel);
+    PG_ASSERT(next_ns.has_value);
+    PG_ASSERT(next_ns.value <= deadline_ns + PG_Milliseconds);
+
+    PG_ASSERT(0 == pg_timer_wheel_expire(wheel, deadline_ns - 1, events));
+    PG_ASSERT(pg_timer_is_armed(&timers[i]));
+
+    PG_ASSERT(1 == pg_timer_wheel_expire(wheel, deadline_ns +
+                                                    PG_Milliseconds - 1,
+                                         events));
+    PG_ASSERT(i == PG_SLICE_AT(events, 0).user_data);
+    PG_ASSERT(!pg_timer_is_armed(&timers[i]));
+  }
+  PG_ASSERT(0 == wheel->count);
+  PG_ASSERT(!pg_timer_wheel_next_deadline_ns(wheel).has_value);
 }
 
-static void test_thread() {
-  u64 n = 1;
-  PG_RESULT(PgThread, PgError)
-  res_thread = pg_thread_create(test_thread_fn, &n);
+static void test_timer_wheel_cancel() {
+  PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
 
-  PgThread thread = PG_UNWRAP(res_thread);
+  u64 now_ns = 0;
+  PgTimerWheel *wheel = pg_timer_wheel_make(PG_Milliseconds, now_ns, allocator);
+
+  PgTimer timers[10] = {0};
+  for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(timers); i++) {
+    pg_timer_wheel_insert(wheel, &timers[i], 500 * PG_Milliseconds, i);
+  }
+  pg_timer_wheel_cancel(wheel, &timers[3]);
+  pg_timer_wheel_cancel(wheel, &timers[3]); // No-op.
+  // Re-armed later.
+  pg_timer_wheel_insert(wheel, &timers[4], 2 * PG_Seconds, 4);
+  PG_ASSERT(9 == wheel->count);
+
+  // More expired timers than room for them.
+  PgAioEvent events_data[4] = {0};
+  PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+  now_ns = PG_Seconds;
+  u64 seen = 0;
+  for (u64 round = 0; round < 2; round++) {
+    PG_ASSERT(4 == pg_timer_wheel_expire(wheel, now_ns, events));
+    for (u64 i = 0; i < 4; i++) {
+      u64 idx = PG_SLICE_AT(events, i).user_data;
+      PG_ASSERT(3 != idx);
+      PG_ASSERT(4 != idx);
+      PG_ASSERT(0 == (seen & (1ULL << idx)));
+      seen |= 1ULL << idx;
+    }
+  }
+  PG_ASSERT(0 == pg_timer_wheel_expire(wheel, now_ns, events));
 
-  PG_ASSERT(0 == pg_thread_join(thread));
-  PG_ASSERT(42 == n);
+  pg_timer_wheel_cancel(wheel, &timers[4]);
+  PG_ASSERT(0 == wheel->count);
+  PG_ASSERT(0 == pg_timer_wheel_expire(wheel, 10 * PG_Seconds, events));
 }
 
-typedef enum {
-  AIO_PEER_STATE_INITIAL,
-  AIO_PEER_STATE_SENT_HELLO,
-  AIO_PEER_STATE_DONE,
-} AioPeerState;
-
-static void test_aio_peer(PgAio aio, PgWriter *w, PgReader *r,
-                          AioPeerState *state, PgFileDescriptor fd,
-                          PgAllocator *allocator) {
-  switch (*state) {
-  case AIO_PEER_STATE_INITIAL: {
-    PG_ASSERT(0 == pg_writer_write_full(w, PG_S("hello world"), allocator));
-    PG_ASSERT(0 == pg_writer_flush(w, allocator));
-    PG_ASSERT(0 ==
-              pg_aio_unregister_interest(aio, fd, PG_AIO_EVENT_KIND_WRITABLE));
-    PG_ASSERT(0 ==
-              pg_aio_register_interest_fd(aio, fd, PG_AIO_EVENT_KIND_READABLE));
+// Random deadlines and clock steps, against the expected expiry of each
+// timer.
+static void test_timer_wheel_random() {
+  PgArena arena = pg_arena_make_from_virtual_mem(256 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
 
-    *state = AIO_PEER_STATE_SENT_HELLO;
-  } break;
-  case AIO_PEER_STATE_SENT_HELLO: {
-    u8 recv[1024] = {0};
-    PG_SLICE(u8)
-    recv_slice = {
-        .data = recv,
-        .len = PG_STATIC_ARRAY_LEN(recv),
-    };
-    PG_RESULT(u64, PgError) res = pg_reader_read_slice(r, recv_slice);
+  PgRng rng = pg_rand_make();
+  u64 now_ns = 123 * PG_Seconds + 456;
+  PgTimerWheel *wheel = pg_timer_wheel_make(PG_Milliseconds, now_ns, allocator);
+
+  u64 timers_len = 2000;
+  PgTimer *timers = pg_alloc(allocator, sizeof(PgTimer), _Alignof(PgTimer),
+                             timers_len);
+  bool *fired = pg_alloc(allocator, sizeof(bool), _Alignof(bool), timers_len);
+  for (u64 i = 0; i < timers_len; i++) {
+    // Up to ~70s i.e. over 3 levels.
+    u64 delay_ns =
+        (u64)pg_rand_u32_min_incl_max_incl(&rng, 0, 70'000) * PG_Milliseconds +
+        pg_rand_u32_min_incl_max_incl(&rng, 0, 999'999);
+    pg_timer_wheel_insert(wheel, &timers[i], now_ns + delay_ns, i);
+  }
+  // Cancel some.
+  for (u64 i = 0; i < timers_len; i += 7) {
+    pg_timer_wheel_cancel(wheel, &timers[i]);
+  }
+
+  PgAioEvent events_data[16] = {0};
+  PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+  while (wheel->count > 0) {
+    now_ns += (u64)pg_rand_u32_min_incl_max_incl(&rng, 0, 30000) *
+              PG_Microseconds;
+
+    for (;;) {
+      u64 count = pg_timer_wheel_expire(wheel, now_ns, events);
+      for (u64 i = 0; i < count; i++) {
+        u64 idx = PG_SLICE_AT(events, i).user_data;
+        PG_ASSERT(0 != idx % 7);
+        PG_ASSERT(!fired[idx]);
+        fired[idx] = true;
+        PG_ASSERT(timers[idx].deadline_ns <= now_ns);
+      }
+      if (count < events.len) {
+        break;
+      }
+    }
 
-    recv_slice.len = PG_UNWRAP(res);
-    PG_ASSERT(pg_bytes_eq(recv_slice, PG_S("hello world")));
+    // Nothing due is left behind.
+    for (u64 i = 0; i < timers_len; i++) {
+      if (pg_timer_is_armed(&timers[i])) {
+        PG_ASSERT(timers[i].deadline_ns / PG_Milliseconds +
+                      (0 != timers[i].deadline_ns % PG_Milliseconds) >
+                  now_ns / PG_Milliseconds);
+      }
+    }
+  }
 
-    *state = AIO_PEER_STATE_DONE;
-  } break;
-  default:
-    PG_ASSERT(0);
+  for (u64 i = 0; i < timers_len; i++) {
+    PG_ASSERT(fired[i] == (0 != i % 7));
   }
 }
 
+static void test_aio_timers() {
+  PgArena arena = pg_arena_make_from_virtual_mem(32 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PG_RESULT(PgAio, PgError) res_aio = pg_aio_init();
+  PgAio aio = PG_UNWRAP(res_aio);
+  pg_aio_timers_init(&aio, PG_Milliseconds, allocator);
+
+  PgAioEvent events_data[4] = {0};
+  PG_SLICE(PgAioEvent) events = PG_SLICE_FROM_C(events_data);
+
+  u64 start_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  PgTimer timer = {0};
+  PgTimer cancelled = {0};
+  pg_aio_register_timer(aio, &timer, start_ns + 20 * PG_Milliseconds, 42);
+  pg_aio_register_timer(aio, &cancelled, start_ns + 10 * PG_Milliseconds, 1);
+  pg_aio_unregister_timer(aio, &cancelled);
+
+  // No timeout: the wait ends with the timer.
+  PG_RESULT(u64, PgError) res_wait = pg_aio_wait(aio, events, PG_NONE(u32));
+  u64 end_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  PG_ASSERT(1 == PG_UNWRAP(res_wait));
+  PG_ASSERT(PG_AIO_EVENT_KIND_TIMER == PG_SLICE_AT(events, 0).kind);
+  PG_ASSERT(42 == PG_SLICE_AT(events, 0).user_data);
+  PG_ASSERT(end_ns - start_ns >= 20 * PG_Milliseconds);
+
+  // Through the completion queue.
+  PgRing cqe = pg_ring_make(sizeof(PgAioEvent) * 4, allocator);
+  pg_aio_register_timer(aio, &timer, end_ns + 5 * PG_Milliseconds, 43);
+  res_wait = pg_aio_wait_cqe(aio, &cqe, PG_SOME(1000, u32));
+  PG_ASSERT(1 == PG_UNWRAP(res_wait));
+  PG_OPTION(PgAioEvent) event = pg_aio_cqe_dequeue(&cqe);
+  PG_ASSERT(event.has_value);
+  PG_ASSERT(PG_AIO_EVENT_KIND_TIMER == event.value.kind);
+  PG_ASSERT(43 == event.value.user_data);
+
+  // The timeout of the caller still applies.
+  pg_aio_register_timer(aio, &timer, end_ns + 10 * PG_Seconds, 44);
+  res_wait = pg_aio_wait(aio, events, PG_SOME(1, u32));
+  PG_ASSERT(0 == PG_UNWRAP(res_wait));
+  pg_aio_unregister_timer(aio, &timer);
+
+  (void)pg_file_close(aio.aio);
+
+  // With short ticks, the timer is on an upper level of the wheel and
+  // cascades down before it is due: the wait goes on until then.
+  res_aio = pg_aio_init();
+  aio = PG_UNWRAP(res_aio);
+  pg_aio_timers_init(&aio, 10 * PG_Microseconds, allocator);
+
+  start_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  pg_aio_register_timer(aio, &timer, start_ns + 10 * PG_Milliseconds, 45);
+  res_wait = pg_aio_wait(aio, events, PG_NONE(u32));
+  end_ns = PG_UNWRAP_OR_DEFAULT(pg_time_ns_now(PG_CLOCK_KIND_MONOTONIC));
+  PG_ASSERT(1 == PG_UNWRAP(res_wait));
+  PG_ASSERT(45 == PG_SLICE_AT(events, 0).user_data);
+  PG_ASSERT(end_ns - start_ns >= 10 * PG_Milliseconds);
+
+  (void)pg_file_close(aio.aio);
+}
+
 static void test_aio_tcp_sockets() {
   PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
   PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
@@ -2953,83 +6673,235 @@ static void test_aio_tcp_sockets() {
   PG_ASSERT(0);
 }
 
+#ifdef PG_OS_LINUX
+[[nodiscard]] static PgString
+test_watch_directory_event(PgAio *aio, PgAioEvent event,
+                           PgAllocator *allocator) {
+  PgAioFsNode *fs_node =
+      pg_aio_fs_node_upsert(&aio->fs_nodes, event.fd, nullptr);
+  PG_ASSERT(fs_node);
+  return pg_path_join(fs_node->name, event.name, allocator);
+}
+
+// The events of the changes made since the last call, sorted by path.
+[[nodiscard]] static PG_DYN(PgAioEvent)
+    test_watch_directory_wait(PgAio *aio, PgAllocator *allocator) {
+  PG_DYN(PgAioEvent) events = {0};
+  PG_RESULT(u64, PgError)
+  res_wait = pg_aio_fs_wait(aio, &events, PG_SOME(0, u32), allocator);
+  PG_ASSERT(PG_UNWRAP(res_wait) == events.len);
+
+  PG_EACH_PTR(event, &events) {
+    event->name = test_watch_directory_event(aio, *event, allocator);
+  }
+  for (u64 i = 1; i < events.len; i++) {
+    for (u64 j = i; j > 0 && PG_CMP_GREATER ==
+                                 pg_string_cmp(PG_SLICE_AT(events, j - 1).name,
+                                               PG_SLICE_AT(events, j).name);
+         j--) {
+      PgAioEvent tmp = PG_SLICE_AT(events, j);
+      PG_SLICE_AT(events, j) = PG_SLICE_AT(events, j - 1);
+      PG_SLICE_AT(events, j - 1) = tmp;
+    }
+  }
+  return events;
+}
+
 static void test_watch_directory() {
-  PgArena arena = pg_arena_make_from_virtual_mem(4 * PG_KiB);
+  PgArena arena = pg_arena_make_from_virtual_mem(256 * PG_KiB);
   PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
   PgAllocator *allocator = pg_arena_allocator_as_allocator(&arena_allocator);
 
-  PG_RESULT(PgFileDescriptor, PgError)
-  res_file_write =
-      pg_file_open(PG_S(".test"), PG_FILE_ACCESS_WRITE, 0600, true, allocator);
-  PgFileDescriptor file_write = PG_UNWRAP(res_file_write);
+  PG_ASSERT(0 == mkdir(".test_watch", 0700));
+  PG_ASSERT(0 == mkdir(".test_watch/sub", 0700));
+  PG_ASSERT(0 == pg_file_write_full(PG_S(".test_watch/a"), PG_S("a"), 0600,
+                                    allocator));
+  PG_ASSERT(0 == pg_file_write_full(PG_S(".test_watch/sub/b"), PG_S("b"),
+                                    0600, allocator));
+
+  PgAio aio = PG_UNWRAP(pg_aio_init());
+  PG_ASSERT(0 == pg_aio_register_watch_directory(
+                     &aio, PG_S(".test_watch"),
+                     PG_WALK_DIRECTORY_KIND_FILE |
+                         PG_WALK_DIRECTORY_KIND_DIRECTORY |
+                         PG_WALK_DIRECTORY_KIND_RECURSE,
+                     allocator));
+  // Again: noop.
+  PG_ASSERT(0 == pg_aio_register_watch_directory(
+                     &aio, PG_S(".test_watch"), PG_WALK_DIRECTORY_KIND_FILE,
+                     allocator));
+
+  // Nothing yet.
+  {
+    PG_DYN(PgAioEvent) events = test_watch_directory_wait(&aio, allocator);
+    PG_ASSERT(0 == events.len);
+  }
+  // Many writes to the same file are one event.
+  {
+    for (u64 i = 0; i < 3; i++) {
+      PG_ASSERT(0 == pg_file_write_full(PG_S(".test_watch/a"), PG_S("aa"),
+                                        0600, allocator));
+    }
+    PG_ASSERT(0 == pg_file_write_full(PG_S(".test_watch/sub/c"), PG_S("c"),
+                                      0600, allocator));
 
-  PG_RESULT(PgAio, PgError) res_aio = pg_aio_init();
-  PgAio aio = PG_UNWRAP(res_aio);
+    PG_DYN(PgAioEvent) events = test_watch_directory_wait(&aio, allocator);
+    PG_ASSERT(2 == events.len);
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_MODIFIED == PG_SLICE_AT(events, 0).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 0).name, PG_S(".test_watch/a")));
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_CREATED == PG_SLICE_AT(events, 1).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 1).name, PG_S(".test_watch/sub/c")));
+  }
+  // Created then deleted in between: nothing changed.
+  {
+    PG_ASSERT(0 == pg_file_write_full(PG_S(".test_watch/tmp"), PG_S("x"),
+                                      0600, allocator));
+    PG_ASSERT(0 == unlink(".test_watch/tmp"));
 
-  PgError err = pg_aio_register_watch_directory(
-      &aio, PG_S("."),
-      PG_WALK_DIRECTORY_KIND_FILE | PG_WALK_DIRECTORY_KIND_DIRECTORY,
-      allocator);
-  PG_ASSERT(0 == err);
+    PG_DYN(PgAioEvent) events = test_watch_directory_wait(&aio, allocator);
+    PG_ASSERT(0 == events.len);
+  }
+  // Renamed over, and deleted.
+  {
+    PG_ASSERT(0 == rename(".test_watch/sub/c", ".test_watch/sub/b"));
+    PG_ASSERT(0 == unlink(".test_watch/a"));
+
+    PG_DYN(PgAioEvent) events = test_watch_directory_wait(&aio, allocator);
+    PG_ASSERT(3 == events.len);
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_DELETED == PG_SLICE_AT(events, 0).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 0).name, PG_S(".test_watch/a")));
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_MODIFIED == PG_SLICE_AT(events, 1).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 1).name, PG_S(".test_watch/sub/b")));
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_DELETED == PG_SLICE_AT(events, 2).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 2).name, PG_S(".test_watch/sub/c")));
+  }
+  // A new directory is watched, with its entries reported.
+  {
+    PG_ASSERT(0 == mkdir(".test_watch/new", 0700));
+    PG_ASSERT(0 == pg_file_write_full(PG_S(".test_watch/new/d"), PG_S("d"),
+                                      0600, allocator));
 
-  PgRing cqe = pg_ring_make(16 * sizeof(PgAioEvent), allocator);
+    PG_DYN(PgAioEvent) events = test_watch_directory_wait(&aio, allocator);
+    PG_ASSERT(2 == events.len);
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_CREATED == PG_SLICE_AT(events, 0).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 0).name, PG_S(".test_watch/new")));
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_CREATED == PG_SLICE_AT(events, 1).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 1).name, PG_S(".test_watch/new/d")));
 
-  u64 event_seen = 0;
+    PG_ASSERT(0 == pg_file_write_full(PG_S(".test_watch/new/d"), PG_S("dd"),
+                                      0600, allocator));
+    events = test_watch_directory_wait(&aio, allocator);
+    PG_ASSERT(1 == events.len);
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_MODIFIED == PG_SLICE_AT(events, 0).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 0).name, PG_S(".test_watch/new/d")));
+  }
+  // Deleted directory.
+  {
+    PG_ASSERT(0 == unlink(".test_watch/new/d"));
+    PG_ASSERT(0 == rmdir(".test_watch/new"));
 
-  for (u64 i = 0; i < 4; i++) {
-    Pgu32Option timeout_opt = PG_SOME(1, u32);
-    PG_RESULT(u64, PgError)
-    res_wait = pg_aio_wait_cqe(aio, &cqe, timeout_opt);
+    PG_DYN(PgAioEvent) events = test_watch_directory_wait(&aio, allocator);
+    PG_ASSERT(2 == events.len);
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_DELETED == PG_SLICE_AT(events, 0).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 0).name, PG_S(".test_watch/new")));
+    PG_ASSERT(PG_AIO_EVENT_KIND_FILE_DELETED == PG_SLICE_AT(events, 1).kind);
+    PG_ASSERT(
+        pg_string_eq(PG_SLICE_AT(events, 1).name, PG_S(".test_watch/new/d")));
 
-    u64 count = PG_UNWRAP(res_wait);
+    // Its state is gone with its watch.
+    PgAioFsNode *node = pg_aio_fs_node_upsert(
+        &aio.fs_nodes, PG_SLICE_AT(events, 1).fd, nullptr);
+    PG_ASSERT(node);
+    PG_ASSERT(!node->directory);
+    PG_ASSERT(!node->entries);
+    PG_ASSERT(!node->entries_free);
+  }
 
-    // First, no event and we reach the timeout.
-    // We write to a watched file to trigger an event.
-    if (0 == i) {
-      PG_ASSERT(0 == count);
-      PG_ASSERT(0 ==
-                pg_file_write_full_with_descriptor(file_write, PG_S("hello")));
-      continue;
-    }
+  // The name of an event outlives its entry, reused for another name.
+  {
+    PG_ASSERT(0 == pg_file_write_full(PG_S(".test_watch/held"), PG_S("x"),
+                                      0600, allocator));
+    PG_DYN(PgAioEvent) events = {0};
+    PG_RESULT(u64, PgError)
+    res_wait = pg_aio_fs_wait(&aio, &events, PG_SOME(0, u32), allocator);
+    PG_ASSERT(1 == PG_UNWRAP(res_wait));
+    PgString held = PG_SLICE_AT(events, 0).name;
+    PG_ASSERT(pg_string_eq(held, PG_S("held")));
+
+    PG_ASSERT(0 == unlink(".test_watch/held"));
+    res_wait = pg_aio_fs_wait(&aio, &events, PG_SOME(0, u32), allocator);
+    PG_ASSERT(1 == PG_UNWRAP(res_wait));
+    PG_ASSERT(0 == pg_file_write_full(PG_S(".test_watch/xxxx"), PG_S("x"),
+                                      0600, allocator));
+    res_wait = pg_aio_fs_wait(&aio, &events, PG_SOME(0, u32), allocator);
+    PG_ASSERT(1 == PG_UNWRAP(res_wait));
+    PG_ASSERT(pg_string_eq(held, PG_S("held")));
+
+    PG_ASSERT(0 == unlink(".test_watch/xxxx"));
+    res_wait = pg_aio_fs_wait(&aio, &events, PG_SOME(0, u32), allocator);
+    PG_ASSERT(1 == PG_UNWRAP(res_wait));
+  }
+
+  // Deleted entries are reused: temporary files do not take more memory.
+  {
+    PgArena events_arena = pg_arena_make_from_virtual_mem(64 * PG_KiB);
+    u8 *arena_start = nullptr;
+
+    for (u64 round = 0; round < 8; round++) {
+      PgArenaAllocator events_arena_allocator =
+          pg_make_arena_allocator(&events_arena);
+      PgAllocator *events_allocator =
+          pg_arena_allocator_as_allocator(&events_arena_allocator);
+
+      u8 path_buf[] = ".test_watch/tmp-0-0";
+      for (u64 i = 0; i < 8; i++) {
+        path_buf[PG_STATIC_ARRAY_LEN(path_buf) - 4] = (u8)('0' + round);
+        path_buf[PG_STATIC_ARRAY_LEN(path_buf) - 2] = (u8)('0' + i);
+        PG_ASSERT(0 == pg_file_write_full(pg_cstr_to_string((char *)path_buf),
+                                          PG_S("x"), 0600, events_allocator));
+      }
+      PG_DYN(PgAioEvent)
+      events = test_watch_directory_wait(&aio, events_allocator);
+      PG_ASSERT(8 == events.len);
+
+      for (u64 i = 0; i < 8; i++) {
+        path_buf[PG_STATIC_ARRAY_LEN(path_buf) - 2] = (u8)('0' + i);
+        PG_ASSERT(0 == unlink((char *)path_buf));
+      }
+      events = test_watch_directory_wait(&aio, events_allocator);
+      PG_ASSERT(8 == events.len);
+      PG_EACH_PTR(event, &events) {
+        PG_ASSERT(PG_AIO_EVENT_KIND_FILE_DELETED == event->kind);
+        PG_ASSERT(pg_string_starts_with(event->name, PG_S(".test_watch/tmp-")));
+      }
 
-    for (u64 j = 0; j < count; j++) {
-      PgAioEvent event = pg_aio_cqe_dequeue(&cqe).value;
-      event_seen += 1;
-
-      if (1 == event_seen) {
-        // We get the write event from the last iteration.
-        PG_ASSERT(event.kind & PG_AIO_EVENT_KIND_FILE_MODIFIED);
-        PgAioFsNode *fs_node =
-            pg_aio_fs_node_upsert(&aio.fs_nodes, event.fd, nullptr);
-        PG_ASSERT(fs_node);
-        PG_ASSERT(pg_string_eq(fs_node->name, PG_S(".test")));
-
-        // Now we create a new file which will trigger an event.
-        PG_RESULT(PgFileDescriptor, PgError)
-        res_file_new = pg_file_open(PG_S(".test_new"), PG_FILE_ACCESS_WRITE,
-                                    0600, true, allocator);
-        PgFileDescriptor file_new = PG_UNWRAP(res_file_new);
-        (void)pg_file_close(file_new);
-      } else if (2 == event_seen) {
-        // We get the create event from the last iteration.
-        PG_ASSERT(event.kind & (PG_AIO_EVENT_KIND_FILE_CREATED |
-                                PG_AIO_EVENT_KIND_FILE_MODIFIED));
-        PG_ASSERT(pg_string_eq(event.name, PG_S(".test_new")));
-
-        PgAioFsNode *fs_node =
-            pg_aio_fs_node_upsert(&aio.fs_nodes, event.fd, nullptr);
-        PG_ASSERT(fs_node);
-        PG_ASSERT(pg_string_eq(fs_node->name, PG_S(".")));
-
-        // End of test.
-        goto end;
+      if (0 == round) {
+        arena_start = arena.start;
       }
+      PG_ASSERT(arena_start == arena.start);
+      events_arena.start = events_arena.start_original;
     }
+
+    PG_ASSERT(0 == pg_arena_release(&events_arena));
   }
 
-end:
-  PG_ASSERT(2 == event_seen);
+  PG_ASSERT(0 == pg_file_close(aio.inotify.value));
+  PG_ASSERT(0 == pg_file_close(aio.aio));
+  PG_ASSERT(0 == unlink(".test_watch/sub/b"));
+  PG_ASSERT(0 == rmdir(".test_watch/sub"));
+  PG_ASSERT(0 == rmdir(".test_watch"));
+  PG_ASSERT(0 == pg_arena_release(&arena));
 }
+#endif
 
 static void test_cli_options_parse() {
   PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
@@ -4108,6 +7980,236 @@ static void test_arena() {
   }
 }
 
+static i32 test_scratch_arena_thread_fn(void *data) {
+  PgArena **arena = data;
+
+  PgArenaTemp scratch = pg_scratch_begin(nullptr);
+  *arena = scratch.arena;
+  pg_scratch_end(scratch);
+
+  return 0;
+}
+
+static void test_scratch_arena() {
+  PgArenaTemp outer = pg_scratch_begin(nullptr);
+  PgAllocator *outer_allocator = pg_arena_temp_allocator(&outer);
+  u8 *outer_start = outer.arena->start;
+
+  PgString s = pg_string_clone(PG_S("hello"), outer_allocator);
+
+  // Conflict avoidance: the callee gets the other scratch arena.
+  {
+    PgArenaTemp inner = pg_scratch_begin(outer_allocator);
+    PG_ASSERT(inner.arena != outer.arena);
+
+    PgString tmp = pg_string_make(4 * PG_KiB, pg_arena_temp_allocator(&inner));
+    PG_ASSERT(tmp.data);
+    PG_ASSERT(pg_string_eq(s, PG_S("hello")));
+
+    pg_scratch_end(inner);
+    PG_ASSERT(inner.start == inner.arena->start);
+  }
+
+  // Nested save/restore of the same arena.
+  {
+    PgArenaTemp nested = pg_arena_temp_begin(outer.arena);
+    PG_ASSERT(pg_string_make(64, pg_arena_temp_allocator(&nested)).data);
+    PG_ASSERT(outer.arena->start > nested.start);
+    pg_arena_temp_end(nested);
+    PG_ASSERT(outer.arena->start == nested.start);
+  }
+
+  pg_scratch_end(outer);
+  PG_ASSERT(outer_start == outer.arena->start);
+
+  // Reset.
+  {
+    PgArenaTemp scratch = pg_scratch_begin(nullptr);
+    PG_ASSERT(pg_string_make(64, pg_arena_temp_allocator(&scratch)).data);
+    pg_scratch_reset();
+    PG_ASSERT(scratch.arena->start == scratch.arena->start_original);
+  }
+
+  // Each thread has its own scratch arenas.
+  {
+    PgArena *other_arena = nullptr;
+    PG_RESULT(PgThread, PgError)
+    res_thread = pg_thread_create(test_scratch_arena_thread_fn, &other_arena);
+    PgThread thread = PG_UNWRAP(res_thread);
+    PG_ASSERT(0 == pg_thread_join(thread));
+
+    PG_ASSERT(nullptr != other_arena);
+    PG_ASSERT(outer.arena != other_arena);
+  }
+}
+
+typedef struct {
+  void *ptr;
+  u64 stack[PG_STACK_TRACE_MAX];
+  u64 stack_len;
+} TestTrackingAllocation;
+
+// Also captures the stack, as seen from here, for comparison.
+[[nodiscard]] static TestTrackingAllocation
+test_tracking_allocator_alloc(PgAllocator *allocator) {
+  TestTrackingAllocation res = {0};
+  res.stack_len = pg_fill_stack_trace(0, 0, res.stack);
+  res.ptr = pg_alloc(allocator, sizeof(u64), _Alignof(u64), 1);
+  return res;
+}
+
+static void test_tracking_allocator() {
+  PgArena arena = pg_arena_make_from_virtual_mem(16 * PG_KiB);
+  PgArenaAllocator arena_allocator = pg_make_arena_allocator(&arena);
+  PgAllocator *backing = pg_arena_allocator_as_allocator(&arena_allocator);
+
+  PgArena arena_meta = pg_arena_make_from_virtual_mem(1 * PG_MiB);
+  PgArenaAllocator arena_allocator_meta = pg_make_arena_allocator(&arena_meta);
+  PgAllocator *meta = pg_arena_allocator_as_allocator(&arena_allocator_meta);
+
+  // Record everything.
+  {
+    PgTrackingAllocator tracking =
+        pg_make_tracking_allocator(backing, meta, 1, true);
+    PgAllocator *allocator = pg_tracking_allocator_as_allocator(&tracking);
+
+    u64 *ptrs[3] = {0};
+    for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(ptrs); i++) {
+      ptrs[i] = pg_alloc(allocator, sizeof(u64), _Alignof(u64), 2);
+      PG_ASSERT(ptrs[i]);
+    }
+    PG_ASSERT(1 == tracking.sites_count);
+
+    u8 *other = pg_alloc(allocator, sizeof(u8), _Alignof(u8), 100);
+    PG_ASSERT(other);
+    PG_ASSERT(2 == tracking.sites_count);
+
+    pg_free(allocator, ptrs[0]);
+    pg_free(allocator, ptrs[0]); // Double free is ignored.
+
+    // Most recent site first.
+    PgAllocSite *site_other = tracking.sites;
+    PG_ASSERT(1 == site_other->alloc_count);
+    PG_ASSERT(100 == site_other->alloc_bytes);
+    PG_ASSERT(1 == site_other->live_count);
+
+    PgAllocSite *site_loop = site_other->next;
+    PG_ASSERT(3 == site_loop->alloc_count);
+    PG_ASSERT(3 * 2 * sizeof(u64) == site_loop->alloc_bytes);
+    PG_ASSERT(2 == site_loop->live_count);
+    PG_ASSERT(2 * 2 * sizeof(u64) == site_loop->live_bytes);
+    PG_ASSERT(site_loop->stack.len > 0);
+
+    // Decode the trace.
+    {
+      u64 events[4] = {0};
+      PgReader r =
+          pg_reader_make_from_bytes(PG_DYN_TO_SLICE(PgString, tracking.trace));
+      while (!PG_SLICE_IS_EMPTY(r.u.bytes)) {
+        PG_RESULT(u8, PgError) res_kind = pg_reader_read_u8_le(&r);
+        u8 kind = PG_UNWRAP(res_kind);
+        PG_ASSERT(kind < PG_STATIC_ARRAY_LEN(events));
+        events[kind] += 1;
+
+        u64 fields_count = 0;
+        switch (kind) {
+        case PG_ALLOC_TRACE_EVENT_SITE: {
+          PG_RESULT(u64, PgError) res_id = pg_reader_read_u64_leb128(&r);
+          PG_ASSERT(!PG_IS_ERR(res_id));
+          PG_RESULT(u64, PgError) res_len = pg_reader_read_u64_leb128(&r);
+          fields_count = PG_UNWRAP(res_len);
+        } break;
+        case PG_ALLOC_TRACE_EVENT_ALLOC:
+          fields_count = 5;
+          break;
+        case PG_ALLOC_TRACE_EVENT_FREE:
+          fields_count = 3;
+          break;
+        default:
+          PG_ASSERT(0);
+        }
+
+        for (u64 i = 0; i < fields_count; i++) {
+          PG_RESULT(u64, PgError) res_field = pg_reader_read_u64_leb128(&r);
+          PG_ASSERT(!PG_IS_ERR(res_field));
+        }
+      }
+      PG_ASSERT(2 == events[PG_ALLOC_TRACE_EVENT_SITE]);
+      PG_ASSERT(4 == events[PG_ALLOC_TRACE_EVENT_ALLOC]);
+      PG_ASSERT(1 == events[PG_ALLOC_TRACE_EVENT_FREE]);
+    }
+
+    PgWriter w = pg_writer_make_string_builder(4 * PG_KiB, meta);
+    PG_ASSERT(0 == pg_tracking_allocator_write_heap_profile(&tracking, &w, meta));
+    PgString profile = PG_DYN_TO_SLICE(PgString, w.u.bytes);
+    PG_ASSERT(pg_string_starts_with(
+        profile, PG_S("heap profile: 3: 132 [4: 148] @ heapprofile\n1: 100 "
+                      "[1: 100] @ 0x")));
+  }
+
+  // Sampling.
+  {
+    PgTrackingAllocator tracking =
+        pg_make_tracking_allocator(backing, meta, 2, false);
+    PgAllocator *allocator = pg_tracking_allocator_as_allocator(&tracking);
+
+    for (u64 i = 0; i < 4; i++) {
+      PG_ASSERT(pg_alloc(allocator, sizeof(u8), _Alignof(u8), 1));
+    }
+    PG_ASSERT(1 == tracking.sites_count);
+    PG_ASSERT(2 == tracking.sites->alloc_count);
+    PG_ASSERT(0 == tracking.trace.len);
+  }
+
+  // The site starts at the caller of `pg_alloc`, without the frames of the
+  // tracking itself.
+  {
+    PgTrackingAllocator tracking =
+        pg_make_tracking_allocator(backing, meta, 1, false);
+    PgAllocator *allocator = pg_tracking_allocator_as_allocator(&tracking);
+
+    TestTrackingAllocation allocation =
+        test_tracking_allocator_alloc(allocator);
+    PG_ASSERT(allocation.ptr);
+    PG_SLICE(u64) stack = tracking.sites->stack;
+
+    // At most `pg_alloc` itself, unless inlined, on top of the same frames.
+    PG_ASSERT(stack.len <= allocation.stack_len + 1);
+    PG_ASSERT(stack.len >= allocation.stack_len);
+    for (u64 i = 1; i < allocation.stack_len; i++) {
+      PG_ASSERT(PG_SLICE_AT(stack, stack.len - i) ==
+                allocation.stack[allocation.stack_len - i]);
+    }
+  }
+
+  // An address handed out again after the backing arena was reset replaces
+  // the stale live allocation.
+  {
+    PgTrackingAllocator tracking =
+        pg_make_tracking_allocator(backing, meta, 1, false);
+    PgAllocator *allocator = pg_tracking_allocator_as_allocator(&tracking);
+
+    u8 *ptrs[2] = {0};
+    for (u64 i = 0; i < PG_STATIC_ARRAY_LEN(ptrs); i++) {
+      PgArenaTemp temp = pg_arena_temp_begin(&arena);
+      ptrs[i] = pg_alloc(allocator, sizeof(u8), _Alignof(u8), 10);
+      pg_arena_temp_end(temp);
+    }
+    PG_ASSERT(ptrs[0] == ptrs[1]);
+
+    // The loop may be unrolled into several sites.
+    u64 alloc_count = 0, live_count = 0, live_bytes = 0;
+    for (PgAllocSite *site = tracking.sites; site; site = site->next) {
+      alloc_count += site->alloc_count;
+      live_count += site->live_count;
+      live_bytes += site->live_bytes;
+    }
+    PG_ASSERT(2 == alloc_count);
+    PG_ASSERT(1 == live_count);
+    PG_ASSERT(10 == live_bytes);
+  }
+}
+
 static void test_sort() {
   u64 nums[] = {5, 66, 7, 3, 6, 9, 1, 3};
   u64 count = PG_STATIC_ARRAY_LEN(nums);
@@ -4121,10 +8223,12 @@ static void test_sort() {
 
 int main(int argc, char *argv[]) {
   PgTest tests[] = {
-#if 0
+#ifdef PG_OS_LINUX
     PG_TEST(test_watch_directory),
 #endif
     PG_TEST(test_arena),
+    PG_TEST(test_scratch_arena),
+    PG_TEST(test_tracking_allocator),
     PG_TEST(test_u64_leb128),
     PG_TEST(test_write_u64_hex),
     PG_TEST(test_self),
@@ -4148,8 +8252,10 @@ int main(int argc, char *argv[]) {
     PG_TEST(test_path_stem),
     PG_TEST(test_string_consume),
     PG_TEST(test_string_parse_u64),
+    PG_TEST(test_string_parse_u64_many),
     PG_TEST(test_string_cmp),
     PG_TEST(test_sha1),
+    PG_TEST(test_crc32_adler32),
     PG_TEST(test_slice_swap_remove),
     PG_TEST(test_dynu8_append_u8_hex_upper),
     PG_TEST(test_ipv4_address_to_string),
@@ -4161,7 +8267,20 @@ int main(int argc, char *argv[]) {
     PG_TEST(test_ring_buffer_read_write_fuzz),
     PG_TEST(test_url_parse_relative_path),
     PG_TEST(test_url_parse),
+    PG_TEST(test_url_view_parse),
+    PG_TEST(test_url_percent_decode),
     PG_TEST(test_http_request_to_string),
+    PG_TEST(test_http_headers),
+    PG_TEST(test_http_chunked),
+    PG_TEST(test_deflate),
+    PG_TEST(test_http_negotiate_content_encoding),
+    PG_TEST(test_http_request_body_reader),
+    PG_TEST(test_http_date),
+    PG_TEST(test_http_range_parse),
+    PG_TEST(test_http_file_serve),
+#ifdef PG_OS_LINUX
+    PG_TEST(test_http_file_cache_gzip),
+#endif
     PG_TEST(test_http_parse_response_status_line),
     PG_TEST(test_http_parse_request_status_line),
     PG_TEST(test_http_parse_header),
@@ -4187,14 +8306,47 @@ int main(int argc, char *argv[]) {
     PG_TEST(test_html_tokenize_nested),
     PG_TEST(test_html_tokenize_with_doctype),
     PG_TEST(test_html_tokenize_with_comment),
+    PG_TEST(test_html_tokenizer_streaming),
+    PG_TEST(test_html_decode_entities),
     PG_TEST(test_html_parse),
     PG_TEST(test_html_parse_title_with_html_content),
+    PG_TEST(test_html_dom_parse),
     PG_TEST(test_string_escape_js),
+    PG_TEST(test_string_escape),
     PG_TEST(test_string_builder_append_u64),
+    PG_TEST(test_writer_write_integers),
     PG_TEST(test_string_buillder_append_u64_hex),
     PG_TEST(test_adjacency_matrix),
     PG_TEST(test_thread),
+    PG_TEST(test_spsc_ring),
+    PG_TEST(test_mpmc_queue),
+    PG_TEST(test_rate_limiter),
+    PG_TEST(test_rate_limiter_threads),
+#ifdef PG_OS_LINUX
+    PG_TEST(test_futex_mutex),
+    PG_TEST(test_futex_rwlock),
+    PG_TEST(test_futex_condition_latch_once),
+#endif
+#ifdef PG_OS_UNIX
+    PG_TEST(test_mutex_recursive_cnd_timedwait),
+#endif
+    PG_TEST(test_timer_wheel),
+    PG_TEST(test_timer_wheel_cancel),
+    PG_TEST(test_timer_wheel_random),
+    PG_TEST(test_aio_timers),
     PG_TEST(test_aio_tcp_sockets),
+    PG_TEST(test_net_ipv4_parse),
+    PG_TEST(test_net_ipv6_parse),
+    PG_TEST(test_net_ip_addresses_interleave),
+    PG_TEST(test_net_connect_happy_eyeballs),
+    PG_TEST(test_net_udp_batch),
+    PG_TEST(test_dns_query_encode),
+    PG_TEST(test_dns_response_parse),
+    PG_TEST(test_dns_resolver),
+    PG_TEST(test_http_client_scan),
+    PG_TEST(test_http_client),
+    PG_TEST(test_http_server_admit),
+    PG_TEST(test_http_server_reject),
     PG_TEST(test_cli_options_parse),
     PG_TEST(test_cli_options_help),
     PG_TEST(test_sort),